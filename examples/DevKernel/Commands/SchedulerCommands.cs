@@ -1,5 +1,7 @@
 using System;
+using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Runtime;
 using Cosmos.Kernel.Core.Scheduler;
 using Cosmos.Kernel.System.Timer;
 using DevKernel.Diagnostics;
@@ -11,7 +13,7 @@ using SysThread = System.Threading.Thread;
 namespace DevKernel.Commands;
 
 /// <summary>
-/// Scheduler introspection, plus the managed-thread smoke tests.
+/// Scheduler introspection, the sampling profiler, plus the managed-thread smoke tests.
 /// </summary>
 internal static class SchedulerCommands
 {
@@ -66,9 +68,54 @@ internal static class SchedulerCommands
                 Usage = "cpustat",
                 Description = "Live CPU% + thread monitor with stress wave",
                 Execute = static (context, args) => CpuStat.Run(),
+            },
+            new ShellCommand
+            {
+                Name = "profile",
+                Usage = "profile <start|stop|dump>",
+                Description = "Sampling profiler; dump streams samples to serial for 'cosmos profile'",
+                MinArgs = 1,
+                MaxArgs = 1,
+                Execute = static (context, args) => RunProfiler(args),
             });
     }
 
+    private static void RunProfiler(CommandArgs args)
+    {
+        if (!CosmosFeatures.ProfilerEnabled)
+        {
+            Terminal.Error("Profiler not compiled in. Build with <CosmosEnableProfiler>true</CosmosEnableProfiler>.");
+            return;
+        }
+
+        switch (args.GetLower(0))
+        {
+            case "start":
+                if (SamplingProfiler.Start())
+                {
+                    Terminal.Success("Sampling started");
+                }
+                else
+                {
+                    Terminal.Error("Cannot allocate the sample buffers");
+                }
+
+                break;
+            case "stop":
+                SamplingProfiler.Stop();
+                Terminal.Success("Sampling stopped; samples kept for 'profile dump'");
+                break;
+            case "dump":
+                Terminal.Info("Streaming samples to serial...");
+                SamplingProfiler.Dump();
+                Terminal.Success("Done. Symbolize the capture with 'cosmos profile <serial.log> --elf <kernel.elf>'.");
+                break;
+            default:
+                args.PrintUsage();
+                break;
+        }
+    }
+
     private static void ShowSchedulerInfo()
     {
         Terminal.Header("Scheduler Information:");
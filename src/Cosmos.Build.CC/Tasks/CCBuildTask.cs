@@ -18,6 +18,12 @@ public sealed class CCBuildTask : ToolTask
     // ILC path for linking
     public string? IlcPath { get; set; }
 
+    // Concurrent clang processes; 0 means one per logical processor
+    public int MaxParallelism { get; set; }
+
+    // Emit LLVM bitcode (-flto=thin) so ld.lld optimizes the C layer as a whole at link time
+    public bool EmitBitcode { get; set; }
+
     protected override MessageImportance StandardErrorLoggingImportance => MessageImportance.Normal;
 
     protected override string GenerateFullPathToTool() => CCPath!;
@@ -61,72 +67,102 @@ public sealed class CCBuildTask : ToolTask
             return false;
         }
 
-        // Execute the compiler command for each C file (with incremental support via content-hash filenames)
-        using SHA1? hasher = SHA1.Create();
-        var validOutputFiles = new System.Collections.Generic.HashSet<string>(StringComparer.OrdinalIgnoreCase);
-
         // Produce Windows-friendly .obj extension so the linker (which currently searches for *.obj) can pick them up
         string objExt = Path.DirectorySeparatorChar == '\\' ? ".obj" : ".o";
 
-        foreach (string file in SourceFiles)
-        {
-            // Compute hash of file contents for a deterministic output filename
-            using FileStream stream = File.OpenRead(file);
-            byte[] fileHash = hasher.ComputeHash(stream);
-            string fileHashString = BitConverter.ToString(fileHash).Replace("-", "").ToLower();
+        // Flags shared by every file. They are part of each object's cache key,
+        // so changing them (log level, EmitBitcode, ...) rebuilds everything.
+        StringBuilder common = new();
+        // Compile to object file, not a shared library
+        common.Append(" -c ");
 
-            // Set file-specific output name (full SHA1 hex — matches AsmBuildTask's filename convention)
-            string baseName = Path.GetFileNameWithoutExtension(file);
-            string outputName = $"{baseName}-{fileHashString}{objExt}";
-            string outputPath = Path.GetFullPath(Path.Combine(OutputPath!, outputName));
+        // Add any user-provided compiler flags
+        if (!string.IsNullOrEmpty(CompilerFlags))
+        {
+            common.Append($" {CompilerFlags} ");
+        }
 
-            validOutputFiles.Add(outputPath);
+        if (EmitBitcode)
+        {
+            common.Append(" -flto=thin ");
+        }
 
-            // Skip if output already exists (content-hash filename = up-to-date)
-            if (File.Exists(outputPath))
-            {
-                Log.LogMessage(MessageImportance.Normal, $"Skipping {file} (up to date: {outputName})");
-                continue;
-            }
+        // Add compiler's freestanding include directory for standard headers (stdint.h, stddef.h, etc.)
+        if (includePath != null)
+        {
+            common.Append($" -I\"{includePath}\" ");
+        }
 
-            // Build and execute the command for this file
-            StringBuilder sb = new();
-            // Compile to object file, not a shared library
-            sb.Append(" -c ");
-            // Add output flag
-            sb.Append($" -o \"{outputPath}\" ");
+        string commonArguments = common.ToString();
 
-            // Add any user-provided compiler flags
-            if (!string.IsNullOrEmpty(CompilerFlags))
-            {
-                sb.Append($" {CompilerFlags} ");
-            }
+        // Work out which files need compiling (incremental support via content-hash filenames).
+        // An object is named by the hash of its source and command line; the depfile
+        // clang writes next to it lists the headers it included, and any of them
+        // being newer than the object makes it stale.
+        var validOutputFiles = new System.Collections.Generic.HashSet<string>(StringComparer.OrdinalIgnoreCase);
+        var jobs = new System.Collections.Generic.List<(string File, string Arguments)>();
 
-            // Add compiler's freestanding include directory for standard headers (stdint.h, stddef.h, etc.)
-            if (includePath != null)
+        using (SHA1 hasher = SHA1.Create())
+        {
+            foreach (string file in SourceFiles)
             {
-                sb.Append($" -I\"{includePath}\" ");
+                // Per-file include path: the directory containing this source file
+                string fileDir = Path.GetDirectoryName(file)!;
+                string fileArguments = $"{commonArguments} -I\"{fileDir}\" ";
+
+                byte[] source = File.ReadAllBytes(file);
+                byte[] arguments = Encoding.UTF8.GetBytes(fileArguments);
+                hasher.TransformBlock(source, 0, source.Length, null, 0);
+                hasher.TransformFinalBlock(arguments, 0, arguments.Length);
+                string fileHashString = BitConverter.ToString(hasher.Hash!).Replace("-", "").ToLower();
+
+                // Set file-specific output name (full SHA1 hex — matches AsmBuildTask's filename convention)
+                string baseName = Path.GetFileNameWithoutExtension(file);
+                string outputName = $"{baseName}-{fileHashString}{objExt}";
+                string outputPath = Path.GetFullPath(Path.Combine(OutputPath!, outputName));
+                string depPath = Path.ChangeExtension(outputPath, ".d");
+
+                validOutputFiles.Add(outputPath);
+                validOutputFiles.Add(depPath);
+
+                if (IsUpToDate(outputPath, depPath))
+                {
+                    Log.LogMessage(MessageImportance.Normal, $"Skipping {file} (up to date: {outputName})");
+                    continue;
+                }
+
+                // Fixed depfile target so the dependency list parses the same on every OS
+                string commandLineArguments =
+                    $"{fileArguments} -MD -MF \"{depPath}\" -MT obj -o \"{outputPath}\" \"{file}\" ";
+                jobs.Add((file, commandLineArguments));
             }
+        }
 
-            // Per-file include path: the directory containing this source file
-            string fileDir = Path.GetDirectoryName(file)!;
-            sb.Append($" -I\"{fileDir}\" ");
+        int parallelism = MaxParallelism > 0 ? MaxParallelism : Environment.ProcessorCount;
+        Log.LogMessage(MessageImportance.Normal, $"Compiling {jobs.Count} C files, up to {parallelism} at a time");
 
-            // Add the source file
-            sb.Append($" \"{file}\" ");
-            string commandLineArguments = sb.ToString();
-            Log.LogMessage(MessageImportance.Normal, $"Compiling {file} with args: {commandLineArguments}");
+        int failures = 0;
+        Parallel.ForEach(jobs, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, job =>
+        {
+            Log.LogMessage(MessageImportance.Normal, $"Compiling {job.File} with args: {job.Arguments}");
 
-            if (!ExecuteCommand(toolPath, commandLineArguments))
+            if (!ExecuteCommand(toolPath, job.Arguments))
             {
-                Log.LogError($"Failed to compile {file}");
-                Log.LogError($"Command: {GenerateFullPathToTool()} {commandLineArguments}");
-                return false;
+                Log.LogError($"Failed to compile {job.File}");
+                Log.LogError($"Command: {toolPath} {job.Arguments}");
+                Interlocked.Increment(ref failures);
             }
+        });
+
+        if (failures > 0)
+        {
+            return false;
         }
 
-        // Remove orphan object files (from renamed/deleted source files)
-        foreach (string existing in Directory.GetFiles(OutputPath!, "*" + objExt))
+        // Remove orphan object files and depfiles (from renamed/deleted source files)
+        IEnumerable<string> outputs = Directory.GetFiles(OutputPath!, "*" + objExt)
+            .Concat(Directory.GetFiles(OutputPath!, "*.d"));
+        foreach (string existing in outputs)
         {
             string normalizedExisting = Path.GetFullPath(existing);
             if (!validOutputFiles.Contains(normalizedExisting))
@@ -201,6 +237,74 @@ public sealed class CCBuildTask : ToolTask
         }
     }
 
+    private static bool IsUpToDate(string outputPath, string depPath)
+    {
+        if (!File.Exists(outputPath) || !File.Exists(depPath))
+        {
+            return false;
+        }
+
+        DateTime built = File.GetLastWriteTimeUtc(outputPath);
+        foreach (string dependency in ReadDepFile(depPath))
+        {
+            if (!File.Exists(dependency) || File.GetLastWriteTimeUtc(dependency) > built)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Dependencies from a Makefile-style depfile written with -MT obj
+    // ("obj: a.c b.h \<newline> c.h"). Backslash-newline continues the list
+    // and "\ " is a space inside a path.
+    private static IEnumerable<string> ReadDepFile(string depPath)
+    {
+        string text = File.ReadAllText(depPath);
+        int start = text.IndexOf(':');
+        if (start < 0)
+        {
+            yield break;
+        }
+
+        StringBuilder current = new();
+        for (int i = start + 1; i < text.Length; i++)
+        {
+            char c = text[i];
+            char next = i + 1 < text.Length ? text[i + 1] : '\0';
+
+            if (c == '\\' && (next == '\n' || next == '\r'))
+            {
+                continue;
+            }
+
+            if (c == '\\' && next == ' ')
+            {
+                current.Append(' ');
+                i++;
+                continue;
+            }
+
+            if (char.IsWhiteSpace(c))
+            {
+                if (current.Length > 0)
+                {
+                    yield return current.ToString();
+                    current.Clear();
+                }
+                continue;
+            }
+
+            current.Append(c);
+        }
+
+        if (current.Length > 0)
+        {
+            yield return current.ToString();
+        }
+    }
+
     private bool ExecuteCommand(string toolPath, string arguments)
     {
         var psi = new System.Diagnostics.ProcessStartInfo
@@ -213,20 +317,30 @@ public sealed class CCBuildTask : ToolTask
             RedirectStandardError = true
         };
 
+        // Several files compile at once: collect this one's output and log it
+        // after the process exits so diagnostics from different files don't interleave.
+        var output = new System.Collections.Generic.List<(bool IsError, string Line)>();
+
         using var process = new System.Diagnostics.Process();
         process.StartInfo = psi;
         process.OutputDataReceived += (sender, e) =>
                 {
                     if (!string.IsNullOrEmpty(e.Data))
                     {
-                        Log.LogMessage(MessageImportance.Normal, e.Data);
+                        lock (output)
+                        {
+                            output.Add((false, e.Data!));
+                        }
                     }
                 };
         process.ErrorDataReceived += (sender, e) =>
                 {
                     if (!string.IsNullOrEmpty(e.Data))
                     {
-                        Log.LogError(e.Data);
+                        lock (output)
+                        {
+                            output.Add((true, e.Data!));
+                        }
                     }
                 };
 
@@ -235,6 +349,21 @@ public sealed class CCBuildTask : ToolTask
         process.BeginErrorReadLine();
         process.WaitForExit();
 
+        lock (output)
+        {
+            foreach ((bool isError, string line) in output)
+            {
+                if (isError)
+                {
+                    Log.LogError(line);
+                }
+                else
+                {
+                    Log.LogMessage(MessageImportance.Normal, line);
+                }
+            }
+        }
+
         return process.ExitCode == 0;
     }
 }
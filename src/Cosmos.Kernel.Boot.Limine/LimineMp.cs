@@ -0,0 +1,20 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Boot.Limine;
+
+/// <summary>
+/// Limine MP (multiprocessor) request.
+/// With this request present Limine starts every application processor and
+/// parks it polling its <c>goto_address</c>; the native SMP bring-up
+/// (Bootstrap/smp.c) releases them. The response and per-CPU info layouts
+/// differ between x86-64 and AArch64, so only native code parses them.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly unsafe struct LimineMpRequest()
+{
+    public readonly LimineID ID = new(0x95a67b819a1b857e, 0xa0b61b723b6a73e0);
+    public readonly ulong Revision = 0;
+    public readonly void* Response;
+    /// <summary>Bit 0 (x86-64): enable x2APIC. Left clear; LocalApic drives the xAPIC through MMIO.</summary>
+    public readonly ulong Flags = 0;
+}
@@ -43,3 +43,130 @@ public static unsafe class AcpiGic
         return (GicInfo*)AcpiGicNative.GetGicInfo();
     }
 }
+
+/// <summary>
+/// C# view of the IORT ID mappings flattened by native <c>parse_iort</c>.
+/// Each range maps a run of PCI requester IDs on one segment straight to
+/// ITS DeviceIDs, sorted by (segment, RID base), so resolving every
+/// function of a device is a single search plus a walk over the table.
+/// Native import lives in Cosmos.Kernel.Core.ARM64/Bridge/Import/AcpiIortNative.cs.
+/// </summary>
+public static unsafe class AcpiIort
+{
+    /// <summary>Maximum number of ranges in the native table (IORT_MAX_ID_RANGES).</summary>
+    public const int MaxRanges = 64;
+
+    /// <summary>Number of functions behind one PCI slot.</summary>
+    public const int FunctionsPerSlot = 8;
+
+    /// <summary>
+    /// Mirrors the C struct acpi_iort_id_range_t from ACPI/acpi_wrapper.c.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct IdRange
+    {
+        public uint Segment;
+        public uint RidBase;
+        public uint Count;
+        public uint DeviceIdBase;
+        public uint ItsId;
+    }
+
+    /// <summary>
+    /// Mirrors the C struct acpi_iort_map_t from ACPI/acpi_wrapper.c.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct IortMap
+    {
+        public uint Count;
+        public uint Dropped;
+        private fixed byte _ranges[MaxRanges * 20];
+
+        public IdRange* GetRange(int index)
+        {
+            fixed (byte* p = _ranges)
+            {
+                return (IdRange*)p + index;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the flattened IORT table, or null when ACPI was not initialized.
+    /// An empty table (Count == 0) means the firmware has no IORT.
+    /// </summary>
+    public static IortMap* GetMap()
+    {
+        return (IortMap*)AcpiIortNative.GetIortMap();
+    }
+
+    /// <summary>
+    /// Resolve the ITS DeviceID of every function of (segment, bus, slot)
+    /// into <paramref name="deviceIds"/> (indexed by function number, at most
+    /// <see cref="FunctionsPerSlot"/> entries). Functions no range covers get
+    /// DeviceID = BDF. Returns the number of functions an IORT range covered.
+    /// </summary>
+    public static int ResolveDeviceIds(uint segment, uint bus, uint slot, Span<uint> deviceIds)
+    {
+        uint firstRid = (bus << 8) | (slot << 3);
+        int functions = deviceIds.Length < FunctionsPerSlot ? deviceIds.Length : FunctionsPerSlot;
+        for (int fn = 0; fn < functions; fn++)
+        {
+            deviceIds[fn] = firstRid + (uint)fn;
+        }
+
+        IortMap* map = GetMap();
+        if (map == null || map->Count == 0)
+        {
+            return 0;
+        }
+
+        // Binary search for the last range starting at or before firstRid;
+        // the functions of a slot then lie in it or in the ranges after it.
+        int lo = 0;
+        int hi = (int)map->Count;
+        while (lo < hi)
+        {
+            int mid = lo + ((hi - lo) / 2);
+            IdRange* r = map->GetRange(mid);
+            if (r->Segment < segment || (r->Segment == segment && r->RidBase <= firstRid))
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        int resolved = 0;
+        for (int i = lo > 0 ? lo - 1 : 0; i < (int)map->Count; i++)
+        {
+            IdRange* r = map->GetRange(i);
+            if (r->Segment != segment)
+            {
+                if (r->Segment > segment)
+                {
+                    break;
+                }
+                continue;
+            }
+            if (r->RidBase >= firstRid + (uint)functions)
+            {
+                break;
+            }
+
+            for (int fn = 0; fn < functions; fn++)
+            {
+                uint rid = firstRid + (uint)fn;
+                if (rid - r->RidBase < r->Count)
+                {
+                    deviceIds[fn] = r->DeviceIdBase + (rid - r->RidBase);
+                    resolved++;
+                }
+            }
+        }
+
+        return resolved;
+    }
+}
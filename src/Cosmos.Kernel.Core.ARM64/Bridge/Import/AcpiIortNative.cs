@@ -20,4 +20,12 @@ public static unsafe partial class AcpiIortNative
     [LibraryImport("*", EntryPoint = "acpi_iort_resolve_device_id")]
     [SuppressGCTransition]
     public static partial int ResolveDeviceId(uint segment, uint bdf, out uint deviceId);
+
+    /// <summary>
+    /// Returns a pointer to the flattened RID -> DeviceID table built by
+    /// <c>parse_iort</c> (<c>acpi_iort_map_t</c>), or null before ACPI init.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "acpi_get_iort_map")]
+    [SuppressGCTransition]
+    public static partial void* GetIortMap();
 }
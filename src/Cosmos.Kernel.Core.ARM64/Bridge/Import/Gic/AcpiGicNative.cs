@@ -10,4 +10,15 @@ public static unsafe partial class AcpiGicNative
     [LibraryImport("*", EntryPoint = "acpi_get_gic_info")]
     [SuppressGCTransition]
     public static partial void* GetGicInfo();
+
+    /// <summary>Returned by <see cref="GetGiccUid"/> when the MADT lists no GICC for the MPIDR.</summary>
+    public const uint NoGiccUid = 0xFFFFFFFF;
+
+    /// <summary>
+    /// ACPI processor UID of the enabled MADT GICC entry with this MPIDR affinity.
+    /// The first call allocates the GICC table on the heap, so this import keeps
+    /// the GC transition.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "acpi_get_gicc_uid")]
+    public static partial uint GetGiccUid(ulong mpidr);
 }
@@ -29,23 +29,35 @@ internal sealed class Arm64MsiBinder : IMsiBinder
         public int EntryCount;
     }
 
+    // DeviceIDs of every function of the most recently prepared slot. PCI
+    // enumeration brings up the functions of a device back to back, so one
+    // batched IORT lookup serves all of them.
+    private readonly uint[] _slotDeviceIds = new uint[AcpiIort.FunctionsPerSlot];
+    private uint _slotSegment;
+    private uint _slotBus;
+    private uint _slotSlot;
+    private bool _slotValid;
+
     public bool IsAvailable => GICv3Its.IsInitialized && GICv3Lpi.IsInitialized;
 
-    public object? PrepareDevice(uint bus, uint slot, uint function, int entryCount)
+    public object? PrepareDevice(uint segment, uint bus, uint slot, uint function, int entryCount)
     {
-        uint bdf = (bus << BdfBusShift) | (slot << BdfSlotShift) | function;
-        // Resolve PCI requester ID -> ITS DeviceID via IORT. Fall back to
-        // identity (DeviceID == BDF) if no IORT is present.
-        //
-        // Segment is hardcoded to 0: Cosmos's PCI scan today uses a single
-        // ECAM region (one segment). When multi-segment support lands on
-        // PciDevice, plumb the device's segment through MsiRouting.PrepareDevice
-        // instead of assuming 0 here.
-        if (AcpiIortNative.ResolveDeviceId(0, bdf, out uint devId) != 0)
+        // Resolve PCI requester ID -> ITS DeviceID via IORT. Functions no
+        // IORT range covers (or every function, without an IORT) fall back
+        // to identity (DeviceID == BDF).
+        if (!_slotValid || _slotSegment != segment || _slotBus != bus || _slotSlot != slot)
         {
-            devId = bdf;
+            AcpiIort.ResolveDeviceIds(segment, bus, slot, _slotDeviceIds);
+            _slotSegment = segment;
+            _slotBus = bus;
+            _slotSlot = slot;
+            _slotValid = true;
         }
 
+        uint devId = function < AcpiIort.FunctionsPerSlot
+            ? _slotDeviceIds[function]
+            : (bus << BdfBusShift) | (slot << BdfSlotShift) | function;
+
         GICv3Its.MapDevice(devId, (uint)entryCount);
         return new Arm64DevCtx { DeviceId = devId, EntryCount = entryCount };
     }
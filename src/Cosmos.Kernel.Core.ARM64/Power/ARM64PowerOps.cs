@@ -30,4 +30,9 @@ public class ARM64PowerOps : IPowerOps
             InternalCpu.Halt();
         }
     }
+
+    public void Prepare()
+    {
+        // PSCI needs no preparation.
+    }
 }
@@ -8,14 +8,17 @@ using Cosmos.Kernel.Core.X64.Bridge;
 namespace Cosmos.Kernel.Core.X64;
 
 /// <summary>
-/// CPU information from MADT
+/// CPU information from MADT (Processor Local APIC or Local x2APIC entries).
 /// </summary>
 [StructLayout(LayoutKind.Sequential)]
 public struct CpuInfo
 {
-    public byte ProcessorId;
-    public byte ApicId;
+    public uint ProcessorUid;
+    public uint ApicId;      // 32-bit x2APIC ID
     public uint Flags;
+    public uint PackageId;
+    public uint CoreId;      // core within the package
+    public uint SmtId;       // hardware thread within the core
 
     public readonly bool IsEnabled => (Flags & 1) != 0;
 }
@@ -46,61 +49,61 @@ public struct IrqOverride
 }
 
 /// <summary>
-/// Complete MADT information
+/// Local APIC NMI source from MADT (Local APIC NMI or Local x2APIC NMI entries).
 /// </summary>
 [StructLayout(LayoutKind.Sequential)]
-public unsafe struct MadtInfo
+public struct LocalNmiInfo
 {
-    private const int MaxCpus = 256;
-    private const int MaxIoApics = 16;
-    private const int MaxIsos = 32;
+    public uint ProcessorUid;   // 0xFFFFFFFF = all processors
+    public ushort Flags;
+    public byte Lint;           // LINT0 or LINT1
+
+    public readonly bool AppliesToAll => ProcessorUid == 0xFFFFFFFF;
+}
 
+/// <summary>
+/// APIC ID bit layout: the low SmtBits select the thread within a core, the
+/// next CoreBits the core within a package, the rest the package.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct CpuTopologyInfo
+{
+    public uint SmtBits;
+    public uint CoreBits;
+    public uint PackageCount;
+}
+
+/// <summary>
+/// Complete MADT information. Mirrors acpi_madt_info_t in acpi_wrapper.c:
+/// the entry arrays live on the Cosmos heap and are sized from the MADT.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct MadtInfo
+{
     public uint LocalApicAddress;
     public uint Flags;
 
     public uint CpuCount;
-    private fixed byte _cpusData[MaxCpus * 8];
-
     public uint IoApicCount;
-    private fixed byte _ioapicsData[MaxIoApics * 12];
-
     public uint IsoCount;
-    private fixed byte _isosData[MaxIsos * 8];
+    public uint NmiCount;
+
+    private CpuInfo* _cpus;
+    private IoApicInfo* _ioapics;
+    private IrqOverride* _isos;
+    private LocalNmiInfo* _nmis;
+
+    public CpuTopologyInfo Topology;
 
     public readonly bool HasPic8259 => (Flags & 1) != 0;
 
-    public readonly ReadOnlySpan<CpuInfo> Cpus
-    {
-        get
-        {
-            fixed (byte* ptr = _cpusData)
-            {
-                return new ReadOnlySpan<CpuInfo>(ptr, (int)CpuCount);
-            }
-        }
-    }
+    public readonly ReadOnlySpan<CpuInfo> Cpus => new(_cpus, _cpus == null ? 0 : (int)CpuCount);
 
-    public readonly ReadOnlySpan<IoApicInfo> IoApics
-    {
-        get
-        {
-            fixed (byte* ptr = _ioapicsData)
-            {
-                return new ReadOnlySpan<IoApicInfo>(ptr, (int)IoApicCount);
-            }
-        }
-    }
+    public readonly ReadOnlySpan<IoApicInfo> IoApics => new(_ioapics, _ioapics == null ? 0 : (int)IoApicCount);
 
-    public readonly ReadOnlySpan<IrqOverride> Overrides
-    {
-        get
-        {
-            fixed (byte* ptr = _isosData)
-            {
-                return new ReadOnlySpan<IrqOverride>(ptr, (int)IsoCount);
-            }
-        }
-    }
+    public readonly ReadOnlySpan<IrqOverride> Overrides => new(_isos, _isos == null ? 0 : (int)IsoCount);
+
+    public readonly ReadOnlySpan<LocalNmiInfo> LocalNmis => new(_nmis, _nmis == null ? 0 : (int)NmiCount);
 }
 
 /// <summary>
@@ -137,11 +140,12 @@ public static unsafe class AcpiMadt
 
         // Log discovered information
         Serial.Write("[ACPI] Local APIC at 0x", info.LocalApicAddress.ToString("X8"), "\n");
-        Serial.Write("[ACPI] Found ", info.CpuCount, " CPU(s)\n");
+        Serial.Write("[ACPI] Found ", info.CpuCount, " CPU(s) in ", info.Topology.PackageCount, " package(s)\n");
 
         foreach (var cpu in info.Cpus)
         {
-            Serial.Write("[ACPI]   CPU ", cpu.ProcessorId, " -> APIC ID ", cpu.ApicId,
+            Serial.Write("[ACPI]   CPU ", cpu.ProcessorUid, " -> APIC ID ", cpu.ApicId,
+                        " (package ", cpu.PackageId, ", core ", cpu.CoreId, ", thread ", cpu.SmtId, ")",
                         (cpu.IsEnabled ? " (enabled)" : " (disabled)"), "\n");
         }
 
@@ -174,5 +178,39 @@ public static unsafe class AcpiMadt
 
         return true;
     }
+}
 
+/// <summary>
+/// HPET event timer block. Mirrors the C struct acpi_hpet_info_t from ACPI/acpi_wrapper.c.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct HpetInfo
+{
+    public byte Found;
+    public byte ComparatorCount;
+    public byte Counter64Bit;
+    public byte LegacyReplacement;
+    public ushort VendorId;
+    public ushort MinTick;
+    public byte HpetNumber;
+    public byte PageProtection;
+    private ushort _pad;
+    public ulong BaseAddress;
+
+    public readonly bool Is64Bit => Counter64Bit != 0;
+}
+
+/// <summary>
+/// HPET table view. The table is parsed in acpi_early_init(); the event timer
+/// block is driven by <see cref="Cpu.Hpet"/>.
+/// </summary>
+public static unsafe class AcpiHpet
+{
+    /// <summary>
+    /// The first HPET described by firmware, or null when there is none.
+    /// </summary>
+    public static HpetInfo* GetHpetInfoPtr()
+    {
+        return (HpetInfo*)AcpiHpetNative.GetHpetInfo();
+    }
 }
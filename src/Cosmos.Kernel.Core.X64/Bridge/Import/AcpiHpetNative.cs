@@ -0,0 +1,13 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.X64.Bridge;
+
+/// <summary>
+/// x64-specific ACPI HPET import (event timer block discovery).
+/// </summary>
+public static unsafe partial class AcpiHpetNative
+{
+    [LibraryImport("*", EntryPoint = "acpi_get_hpet_info")]
+    [SuppressGCTransition]
+    public static partial void* GetHpetInfo();
+}
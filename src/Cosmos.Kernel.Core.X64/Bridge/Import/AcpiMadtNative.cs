@@ -4,10 +4,11 @@ namespace Cosmos.Kernel.Core.X64.Bridge;
 
 /// <summary>
 /// x64-specific ACPI MADT import (APIC / I/O APIC / ISO discovery).
+/// No SuppressGCTransition: the first call allocates the MADT arrays on the
+/// Cosmos heap, which calls back into managed code.
 /// </summary>
 public static unsafe partial class AcpiMadtNative
 {
     [LibraryImport("*", EntryPoint = "acpi_get_madt_info")]
-    [SuppressGCTransition]
     public static partial void* GetMadtInfo();
 }
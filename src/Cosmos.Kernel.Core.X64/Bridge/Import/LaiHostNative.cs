@@ -0,0 +1,17 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.X64.Bridge;
+
+/// <summary>
+/// x64-specific LAI host import (Cosmos.Kernel.Native.MultiArch/ACPI/lai_host.c).
+/// </summary>
+public static partial class LaiHostNative
+{
+    /// <summary>
+    /// Hands the calibrated TSC frequency to laihost_timer / laihost_sleep so AML
+    /// timing does not fall back to its own PIT measurement.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "cosmos_lai_set_clock_frequency")]
+    [SuppressGCTransition]
+    public static partial void SetClockFrequency(ulong hz);
+}
@@ -15,4 +15,8 @@ public static partial class X64CpuNative
     [LibraryImport("*", EntryPoint = "_native_cpu_invlpg")]
     [SuppressGCTransition]
     public static partial void InvalidatePage(ulong virtualAddress);
+
+    [LibraryImport("*", EntryPoint = "_native_cpu_wrmsr")]
+    [SuppressGCTransition]
+    public static partial void WriteMsr(uint msr, ulong value);
 }
@@ -0,0 +1,194 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using System.Runtime.Intrinsics.X86;
+using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.X64.Bridge;
+
+namespace Cosmos.Kernel.Core.X64.Cpu;
+
+/// <summary>
+/// Hardware clocks a <see cref="ClockSource"/> can be backed by.
+/// </summary>
+public enum ClockSourceKind
+{
+    Pit,
+    Hpet,
+    Tsc,
+}
+
+/// <summary>
+/// Picks the x64 reference and timestamp clocks. Preference order is the
+/// invariant TSC (with the Local APIC TSC-deadline timer when the CPU has
+/// it), then the HPET, with the PIT only as the calibration reference of
+/// last resort. <see cref="Initialize"/> must run before the LAPIC timer is
+/// calibrated and before anything reads <c>Stopwatch.Frequency</c>.
+/// </summary>
+public static class ClockSource
+{
+    // CPUID feature bits (Intel SDM Vol 2A, CPUID)
+    /// <summary>CPUID.01H:ECX bit 24 - Local APIC timer supports TSC-deadline mode.</summary>
+    private const int Cpuid1EcxTscDeadline = 1 << 24;
+    /// <summary>CPUID.80000007H:EDX bit 8 - TSC runs at a constant rate in all P/C-states.</summary>
+    private const int CpuidPowerEdxInvariantTsc = 1 << 8;
+    private const int CpuidLeafTscCrystal = 0x15;
+    private const int CpuidLeafExtendedMax = unchecked((int)0x80000000);
+    private const int CpuidLeafPower = unchecked((int)0x80000007);
+
+    // PIT polling reference
+    private const ushort PIT_CHANNEL0_DATA = 0x40;
+    private const ushort PIT_COMMAND = 0x43;
+    private const uint PIT_FREQUENCY = 1193182;   // PIT base frequency in Hz
+    /// <summary>PIT command byte: channel 0, lobyte/hibyte access, mode 0 (one-shot), binary counting.</summary>
+    private const byte PIT_CMD_CHANNEL0_ONESHOT = 0x30;
+    /// <summary>PIT command byte: latch the current count of channel 0 for read-back.</summary>
+    private const byte PIT_CMD_LATCH_CHANNEL0 = 0x00;
+    /// <summary>Largest one-shot count channel 0 accepts (~54 ms).</summary>
+    private const uint PitMaxCount = 0xFFFF;
+    /// <summary>Mask selecting the low byte of a 16-bit PIT count.</summary>
+    private const int LowByteMask = 0xFF;
+    /// <summary>Shift between the low and high bytes of a 16-bit PIT count.</summary>
+    private const int ByteShift = 8;
+
+    private static bool _initialized;
+    private static bool _invariantTsc;
+    private static bool _tscDeadline;
+    private static long _cpuidTscFrequency;
+    private static ClockSourceKind _reference = ClockSourceKind.Pit;
+    private static ClockSourceKind _timestamp = ClockSourceKind.Tsc;
+
+    /// <summary>
+    /// Gets whether the TSC is invariant (constant rate, not stopped in deep C-states).
+    /// </summary>
+    public static bool HasInvariantTsc => _invariantTsc;
+
+    /// <summary>
+    /// Gets whether the Local APIC timer supports TSC-deadline mode.
+    /// </summary>
+    public static bool HasTscDeadline => _tscDeadline;
+
+    /// <summary>
+    /// Gets the TSC frequency enumerated by CPUID leaf 0x15, or 0 when the
+    /// CPU does not report it and it has to be measured.
+    /// </summary>
+    public static long CpuidTscFrequency => _cpuidTscFrequency;
+
+    /// <summary>
+    /// Gets the clock calibration windows are timed against.
+    /// </summary>
+    public static ClockSourceKind Reference => _reference;
+
+    /// <summary>
+    /// Gets the clock behind <see cref="ReadTimestamp"/>.
+    /// </summary>
+    public static ClockSourceKind Timestamp => _timestamp;
+
+    /// <summary>
+    /// Gets the <see cref="ReadTimestamp"/> frequency in Hz.
+    /// </summary>
+    public static long TimestampFrequency =>
+        _timestamp == ClockSourceKind.Hpet ? Hpet.Frequency : X64CpuOps.TscFrequency;
+
+    /// <summary>
+    /// Detects the TSC features and the HPET and selects the clocks.
+    /// </summary>
+    public static void Initialize()
+    {
+        if (_initialized)
+        {
+            return;
+        }
+
+        if (X86Base.IsSupported)
+        {
+            (_, _, int ecx, _) = X86Base.CpuId(1, 0);
+            _tscDeadline = (ecx & Cpuid1EcxTscDeadline) != 0;
+
+            (int maxExtended, _, _, _) = X86Base.CpuId(CpuidLeafExtendedMax, 0);
+            if ((uint)maxExtended >= (uint)CpuidLeafPower)
+            {
+                (_, _, _, int edx) = X86Base.CpuId(CpuidLeafPower, 0);
+                _invariantTsc = (edx & CpuidPowerEdxInvariantTsc) != 0;
+            }
+
+            (int maxBasic, _, _, _) = X86Base.CpuId(0, 0);
+            if (maxBasic >= CpuidLeafTscCrystal)
+            {
+                // EBX/EAX = TSC / crystal ratio, ECX = crystal Hz (0 = not enumerated).
+                (int denominator, int numerator, int crystalHz, _) = X86Base.CpuId(CpuidLeafTscCrystal, 0);
+                if (denominator != 0 && numerator != 0 && crystalHz != 0)
+                {
+                    _cpuidTscFrequency = (long)((ulong)(uint)crystalHz * (uint)numerator / (uint)denominator);
+                }
+            }
+        }
+
+        if (Hpet.Initialize())
+        {
+            _reference = ClockSourceKind.Hpet;
+            if (!_invariantTsc && Hpet.Is64Bit)
+            {
+                _timestamp = ClockSourceKind.Hpet;
+            }
+        }
+
+        _initialized = true;
+
+        Serial.Write("[ClockSource] Reference: ", ReferenceName(_reference),
+                     ", timestamps: ", ReferenceName(_timestamp),
+                     _invariantTsc ? " (invariant TSC" : " (TSC not invariant",
+                     _tscDeadline ? ", TSC-deadline)\n" : ")\n");
+    }
+
+    /// <summary>
+    /// Reads the timestamp clock (<see cref="Timestamp"/>).
+    /// </summary>
+    public static ulong ReadTimestamp()
+    {
+        return _timestamp == ClockSourceKind.Hpet ? Hpet.ReadCounter() : X64CpuNative.ReadTsc();
+    }
+
+    /// <summary>
+    /// Busy-waits for <paramref name="ms"/> milliseconds of reference clock
+    /// time. Interrupt-free, so it is usable before the IDT routes anything;
+    /// the PIT fallback is limited to one channel-0 period (~54 ms).
+    /// </summary>
+    public static void WaitReference(uint ms)
+    {
+        if (_reference == ClockSourceKind.Hpet)
+        {
+            Hpet.Wait(ms);
+            return;
+        }
+
+        uint count = PIT_FREQUENCY * ms / 1000;
+        ushort pitCount = (ushort)(count > PitMaxCount ? PitMaxCount : count);
+
+        Native.IO.Write8(PIT_COMMAND, PIT_CMD_CHANNEL0_ONESHOT);
+        Native.IO.Write8(PIT_CHANNEL0_DATA, (byte)(pitCount & LowByteMask));
+        Native.IO.Write8(PIT_CHANNEL0_DATA, (byte)(pitCount >> ByteShift));
+
+        // PIT counts down; stop once it wraps or reaches zero.
+        ushort lastCount = pitCount;
+        while (true)
+        {
+            Native.IO.Write8(PIT_COMMAND, PIT_CMD_LATCH_CHANNEL0);
+            byte lo = Native.IO.Read8(PIT_CHANNEL0_DATA);
+            byte hi = Native.IO.Read8(PIT_CHANNEL0_DATA);
+            ushort currentCount = (ushort)(lo | (hi << ByteShift));
+
+            if (currentCount > lastCount || currentCount == 0)
+            {
+                break;
+            }
+
+            lastCount = currentCount;
+        }
+    }
+
+    private static string ReferenceName(ClockSourceKind kind) => kind switch
+    {
+        ClockSourceKind.Hpet => "HPET",
+        ClockSourceKind.Tsc => "TSC",
+        _ => "PIT",
+    };
+}
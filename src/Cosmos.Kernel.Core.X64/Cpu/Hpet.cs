@@ -0,0 +1,125 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using Cosmos.Kernel.Boot.Limine;
+using Cosmos.Kernel.Core.IO;
+
+namespace Cosmos.Kernel.Core.X64.Cpu;
+
+/// <summary>
+/// HPET main counter, used as a free-running reference clock (calibration
+/// and, without an invariant TSC, timestamps). The comparators are left
+/// untouched: the periodic tick comes from the Local APIC timer and the
+/// legacy IRQ0 tick from the PIT, so legacy replacement routing stays off.
+/// </summary>
+public static unsafe class Hpet
+{
+    // Register offsets (IA-PC HPET specification 1.0a §2.3)
+    private const ulong HPET_GCAP_ID = 0x00;        // General Capabilities and ID
+    private const ulong HPET_GEN_CONF = 0x10;       // General Configuration
+    private const ulong HPET_MAIN_COUNTER = 0xF0;   // Main Counter Value
+
+    /// <summary>GCAP_ID bits 63:32: main counter period in femtoseconds.</summary>
+    private const int PeriodShift = 32;
+    /// <summary>GCAP_ID COUNT_SIZE_CAP (bit 13): the main counter is 64 bits wide.</summary>
+    private const ulong CapCounter64 = 1UL << 13;
+    /// <summary>GEN_CONF ENABLE_CNF (bit 0): the main counter runs.</summary>
+    private const ulong ConfEnable = 1UL << 0;
+    /// <summary>Largest period the specification allows (100 ns); anything above is a broken table.</summary>
+    private const ulong MaxPeriodFs = 100_000_000;
+
+    private const ulong FemtosecondsPerSecond = 1_000_000_000_000_000;
+
+    private static ulong _base;
+    private static ulong _periodFs;
+    private static bool _counter64;
+    private static bool _initialized;
+
+    /// <summary>
+    /// Gets whether an HPET was found and its main counter is running.
+    /// </summary>
+    public static bool IsAvailable => _initialized;
+
+    /// <summary>
+    /// Gets whether the main counter is 64 bits wide. A 32-bit counter wraps
+    /// in about five minutes at 14.318 MHz, too soon for timestamps.
+    /// </summary>
+    public static bool Is64Bit => _counter64;
+
+    /// <summary>
+    /// Gets the main counter frequency in Hz (0 when unavailable).
+    /// </summary>
+    public static long Frequency => _initialized ? (long)(FemtosecondsPerSecond / _periodFs) : 0;
+
+    /// <summary>
+    /// Maps the HPET described by the ACPI HPET table and starts its main
+    /// counter. Returns false when there is no usable HPET.
+    /// </summary>
+    public static bool Initialize()
+    {
+        if (_initialized)
+        {
+            return true;
+        }
+
+        HpetInfo* info = AcpiHpet.GetHpetInfoPtr();
+        if (info == null || Limine.HHDM.Response == null)
+        {
+            return false;
+        }
+
+        DeviceMapper.EnsureMapped(info->BaseAddress);
+        _base = info->BaseAddress + Limine.HHDM.Response->Offset;
+
+        ulong caps = Native.MMIO.Read64(_base + HPET_GCAP_ID);
+        _periodFs = caps >> PeriodShift;
+        if (_periodFs == 0 || _periodFs > MaxPeriodFs)
+        {
+            Serial.Write("[HPET] Invalid counter period ", _periodFs, " fs, ignoring\n");
+            return false;
+        }
+
+        _counter64 = (caps & CapCounter64) != 0;
+
+        ulong conf = Native.MMIO.Read64(_base + HPET_GEN_CONF);
+        if ((conf & ConfEnable) == 0)
+        {
+            Native.MMIO.Write64(_base + HPET_GEN_CONF, conf | ConfEnable);
+        }
+
+        _initialized = true;
+        Serial.Write("[HPET] ", (ulong)Frequency, " Hz, ", _counter64 ? "64" : "32", "-bit main counter\n");
+        return true;
+    }
+
+    /// <summary>
+    /// Reads the main counter. Only the low 32 bits are meaningful on a
+    /// 32-bit counter.
+    /// </summary>
+    public static ulong ReadCounter()
+    {
+        return _counter64
+            ? Native.MMIO.Read64(_base + HPET_MAIN_COUNTER)
+            : Native.MMIO.Read32(_base + HPET_MAIN_COUNTER);
+    }
+
+    /// <summary>
+    /// Busy-waits for <paramref name="ms"/> milliseconds of main counter time.
+    /// </summary>
+    public static void Wait(uint ms)
+    {
+        ulong ticks = (ulong)Frequency * ms / 1000;
+        ulong start = ReadCounter();
+        if (_counter64)
+        {
+            while (ReadCounter() - start < ticks)
+            {
+            }
+        }
+        else
+        {
+            while ((uint)((uint)ReadCounter() - (uint)start) < ticks)
+            {
+            }
+        }
+    }
+}
@@ -1,11 +1,14 @@
 // This code is licensed under MIT license (see LICENSE for details)
 
 using System.Runtime.CompilerServices;
+using System.Threading;
 using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.Core.Runtime;
 using Cosmos.Kernel.Core.Scheduler;
+using Cosmos.Kernel.Core.X64.Bridge;
 
 namespace Cosmos.Kernel.Core.X64.Cpu;
 
@@ -45,6 +48,10 @@ public static class LocalApic
     private const uint LVT_MASKED = 0x10000;
     /// <summary>Timer LVT periodic mode bit (bit 17) - periodic vs one-shot.</summary>
     private const uint TIMER_PERIODIC = 0x20000;
+    /// <summary>Timer LVT TSC-deadline mode (bits 18:17 = 10b, Intel SDM Vol 3 §10.5.4.1).</summary>
+    private const uint TIMER_TSC_DEADLINE = 0x40000;
+    /// <summary>IA32_TSC_DEADLINE MSR: the timer fires when the TSC reaches this value; 0 disarms it.</summary>
+    private const uint IA32_TSC_DEADLINE = 0x6E0;
     /// <summary>SVR APIC Software Enable bit (bit 8).</summary>
     private const uint SVR_ENABLE = 0x100;
 
@@ -59,21 +66,8 @@ public static class LocalApic
     private const uint TIMER_DIVIDE_BY_1 = 0xB;
     private const uint TIMER_DIVIDE_BY_16 = 0x3;
 
-    // PIT calibration interface
-    private const ushort PIT_CHANNEL0_DATA = 0x40;
-    private const ushort PIT_COMMAND = 0x43;
-    private const uint PIT_FREQUENCY = 1193182;   // PIT base frequency in Hz
-    /// <summary>PIT command byte: channel 0, lobyte/hibyte access, mode 0 (one-shot), binary counting.</summary>
-    private const byte PIT_CMD_CHANNEL0_ONESHOT = 0x30;
-    /// <summary>PIT command byte: latch the current count of channel 0 for read-back.</summary>
-    private const byte PIT_CMD_LATCH_CHANNEL0 = 0x00;
-
     // Software policy
-    /// <summary>Mask selecting the low byte of a 16-bit PIT count.</summary>
-    private const int LowByteMask = 0xFF;
-    /// <summary>Shift between the low and high bytes of a 16-bit PIT count.</summary>
-    private const int ByteShift = 8;
-    /// <summary>Duration of the PIT-referenced calibration window in milliseconds.</summary>
+    /// <summary>Duration of the reference-clock calibration window in milliseconds.</summary>
     private const uint CalibrationDurationMs = 10;
     /// <summary>Maximum LAPIC timer initial count (32-bit register, all bits set) used during calibration.</summary>
     private const uint TimerMaxInitialCount = 0xFFFFFFFF;
@@ -88,6 +82,10 @@ public static class LocalApic
     private static bool _timerCalibrated;
     private static uint _timerIntervalMs;
     private static ulong _timerIntervalNs;
+    private static long _measuredTscFrequency;
+    private static bool _tscDeadlineMode;
+    private static ulong _tscDeadlineInterval;
+    private static ulong _nextDeadline;
 
     /// <summary>
     /// Gets the base address of the Local APIC.
@@ -237,7 +235,20 @@ public static class LocalApic
     public static ulong TimerIntervalNs => _timerIntervalNs;
 
     /// <summary>
-    /// Calibrates the LAPIC timer using the PIT as a reference.
+    /// Gets the TSC frequency in Hz measured over the calibration window
+    /// (0 before <see cref="CalibrateTimer"/>).
+    /// </summary>
+    public static long MeasuredTscFrequency => _measuredTscFrequency;
+
+    /// <summary>
+    /// Gets whether the scheduler tick runs in TSC-deadline mode.
+    /// </summary>
+    public static bool IsTscDeadlineMode => _tscDeadlineMode;
+
+    /// <summary>
+    /// Calibrates the LAPIC timer (and measures the TSC) against the
+    /// <see cref="ClockSource"/> reference clock: the HPET when present,
+    /// otherwise PIT channel 0.
     /// Must be called after Initialize() and before using timer functions.
     /// </summary>
     public static void CalibrateTimer()
@@ -248,46 +259,24 @@ public static class LocalApic
             return;
         }
 
-        Serial.Write("[LocalAPIC] Calibrating timer using PIT...\n");
+        ClockSource.Initialize();
+        Serial.Write("[LocalAPIC] Calibrating timer using ",
+                     ClockSource.Reference == ClockSourceKind.Hpet ? "HPET" : "PIT", "...\n");
 
         // Set timer divide to 16
         Write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
 
-        // Configure PIT channel 0 for one-shot mode, ~10ms delay
-        // 10ms = 11932 ticks at 1193182 Hz
-        const ushort pitCount = 11932;
-
-        // PIT command: channel 0, lobyte/hibyte, one-shot mode, binary
-        Native.IO.Write8(PIT_COMMAND, PIT_CMD_CHANNEL0_ONESHOT);
-        Native.IO.Write8(PIT_CHANNEL0_DATA, (byte)(pitCount & LowByteMask));
-        Native.IO.Write8(PIT_CHANNEL0_DATA, (byte)(pitCount >> ByteShift));
-
         // Set LAPIC timer to max initial count (one-shot, masked)
         Write(LAPIC_TIMER_LVT, LVT_MASKED);
         Write(LAPIC_TIMER_INIT, TimerMaxInitialCount);
+        ulong tscStart = X64CpuNative.ReadTsc();
 
-        // Wait for PIT to count down by polling
-        // Read back current count until it wraps or reaches near zero
-        ushort lastCount = pitCount;
-        while (true)
-        {
-            // Latch count for channel 0
-            Native.IO.Write8(PIT_COMMAND, PIT_CMD_LATCH_CHANNEL0);
-            byte lo = Native.IO.Read8(PIT_CHANNEL0_DATA);
-            byte hi = Native.IO.Read8(PIT_CHANNEL0_DATA);
-            ushort currentCount = (ushort)(lo | (hi << ByteShift));
-
-            // PIT counts down, check if we've passed our target
-            if (currentCount > lastCount || currentCount == 0)
-            {
-                break;
-            }
-
-            lastCount = currentCount;
-        }
+        ClockSource.WaitReference(CalibrationDurationMs);
 
-        // Read how many LAPIC ticks elapsed
+        // Read how many LAPIC ticks and TSC cycles elapsed
         uint lapicTicksElapsed = TimerMaxInitialCount - Read(LAPIC_TIMER_CURRENT);
+        ulong tscElapsed = X64CpuNative.ReadTsc() - tscStart;
+        _measuredTscFrequency = (long)(tscElapsed / CalibrationDurationMs * 1000);
 
         // Stop the timer
         Write(LAPIC_TIMER_INIT, 0);
@@ -301,7 +290,9 @@ public static class LocalApic
     }
 
     /// <summary>
-    /// Blocks for the specified number of milliseconds using the LAPIC timer.
+    /// Blocks for the specified number of milliseconds. Spins on the TSC once
+    /// it is calibrated, leaving the timer LVT (and the scheduler tick) alone;
+    /// before that it runs the LAPIC timer one-shot and polls it.
     /// </summary>
     /// <param name="ms">Number of milliseconds to wait.</param>
     public static void Wait(uint ms)
@@ -317,6 +308,18 @@ public static class LocalApic
             return;
         }
 
+        if (X64CpuOps.IsTscCalibrated)
+        {
+            ulong cycles = (ulong)X64CpuOps.TscFrequency / 1000 * ms;
+            ulong start = X64CpuNative.ReadTsc();
+            while (X64CpuNative.ReadTsc() - start < cycles)
+            {
+                // Busy wait
+            }
+
+            return;
+        }
+
         // Set timer divide to 16 (same as calibration)
         Write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
 
@@ -344,8 +347,10 @@ public static class LocalApic
     }
 
     /// <summary>
-    /// Starts the LAPIC timer in periodic mode with the given interval.
-    /// Will fire interrupt on TIMER_VECTOR (0xEF = 239).
+    /// Starts the LAPIC timer with the given interval, firing TIMER_VECTOR
+    /// (0xEF = 239). Uses TSC-deadline mode when the CPU supports it and the
+    /// TSC is invariant and calibrated (each tick re-arms the next deadline
+    /// in HandleTimerInterrupt); periodic mode otherwise.
     /// </summary>
     /// <param name="intervalMs">Interval in milliseconds between interrupts.</param>
     public static void StartPeriodicTimer(uint intervalMs)
@@ -366,6 +371,22 @@ public static class LocalApic
         Serial.Write("[LocalAPIC]   Ticks: ", ticks, "\n");
         Serial.Write("[LocalAPIC]   Vector: 0x", TIMER_VECTOR.ToString("X"), "\n");
 
+        if (ClockSource.HasTscDeadline && ClockSource.HasInvariantTsc && X64CpuOps.IsTscCalibrated)
+        {
+            _tscDeadlineInterval = (ulong)X64CpuOps.TscFrequency / 1000 * intervalMs;
+            _tscDeadlineMode = true;
+            Serial.Write("[LocalAPIC]   Mode: TSC-deadline (", _tscDeadlineInterval, " TSC cycles)\n");
+
+            Write(LAPIC_TIMER_LVT, TIMER_TSC_DEADLINE | TIMER_VECTOR);
+            // SDM §10.5.4.1: the LVT write (MMIO) and the deadline WRMSR are
+            // not ordered against each other; fence so the MSR write is not
+            // seen while the timer is still in its old mode.
+            Thread.MemoryBarrier();
+            _nextDeadline = X64CpuNative.ReadTsc() + _tscDeadlineInterval;
+            X64CpuNative.WriteMsr(IA32_TSC_DEADLINE, _nextDeadline);
+            return;
+        }
+
         // Set timer divide to 16
         Write(LAPIC_TIMER_DIVIDE, TIMER_DIVIDE_BY_16);
 
@@ -382,6 +403,12 @@ public static class LocalApic
     public static void StopTimer()
     {
         // Mask the timer and set count to 0
+        if (_tscDeadlineMode)
+        {
+            X64CpuNative.WriteMsr(IA32_TSC_DEADLINE, 0);
+            _tscDeadlineMode = false;
+        }
+
         Write(LAPIC_TIMER_LVT, LVT_MASKED);
         Write(LAPIC_TIMER_INIT, 0);
     }
@@ -404,6 +431,20 @@ public static class LocalApic
     {
         _timerTickCount++;
 
+        if (_tscDeadlineMode)
+        {
+            // Deadline mode is one-shot: schedule the next tick on the fixed
+            // cadence, skipping ahead if this one was delivered late.
+            ulong now = X64CpuNative.ReadTsc();
+            _nextDeadline += _tscDeadlineInterval;
+            if ((long)(_nextDeadline - now) <= 0)
+            {
+                _nextDeadline = now + _tscDeadlineInterval;
+            }
+
+            X64CpuNative.WriteMsr(IA32_TSC_DEADLINE, _nextDeadline);
+        }
+
         // Get current CPU ID from APIC
         uint cpuId = (uint)GetId();
 
@@ -428,6 +469,9 @@ public static class LocalApic
             Serial.Write("\n");
         }
 
+        // Sample before scheduling: a context switch would replace the interrupted frame
+        SamplingProfiler.Sample(cpuId, ref context);
+
         // Call scheduler with elapsed time
         SchedulerManager.OnTimerInterrupt(cpuId, currentRsp, _timerIntervalNs);
 
@@ -15,7 +15,7 @@ public class X64CpuOps : ICpuOps
     /// <summary>
     /// TSC (Time Stamp Counter) frequency in Hz.
     /// Default is 1 GHz as a reasonable estimate for modern CPUs.
-    /// Calibrated during kernel initialization using PIT as reference.
+    /// Calibrated during kernel initialization (see <see cref="CalibrateTsc"/>).
     /// </summary>
     public static long TscFrequency { get; private set; } = 1_000_000_000;
 
@@ -30,10 +30,13 @@ public class X64CpuOps : ICpuOps
     /// </summary>
     public static ulong ReadTSC() => X64CpuNative.ReadTsc();
 
-    // Native import lives in Cosmos.Kernel.Core.X64/Bridge/Import/X64CpuNative.cs.
+    // Native imports live in Cosmos.Kernel.Core.X64/Bridge/Import/X64CpuNative.cs
+    // and LaiHostNative.cs.
 
     /// <summary>
-    /// Calibrates the TSC frequency using LAPIC timer as a reference.
+    /// Sets the TSC frequency: the value CPUID leaf 0x15 enumerates when the
+    /// CPU reports one, otherwise the rate measured against the reference
+    /// clock while the LAPIC timer was calibrated.
     /// Must be called after LAPIC timer is calibrated.
     /// Must be called before any code accesses Stopwatch.Frequency.
     /// </summary>
@@ -45,21 +48,21 @@ public class X64CpuOps : ICpuOps
             return;
         }
 
-        const uint calibrationMs = 10;
-
-        // Read TSC before
-        ulong tscStart = X64CpuNative.ReadTsc();
-
-        // Wait using calibrated LAPIC timer
-        Cpu.LocalApic.Wait(calibrationMs);
-
-        // Read TSC after
-        ulong tscEnd = X64CpuNative.ReadTsc();
+        long frequency = ClockSource.CpuidTscFrequency;
+        if (frequency == 0)
+        {
+            frequency = Cpu.LocalApic.MeasuredTscFrequency;
+        }
 
-        ulong tscElapsed = tscEnd - tscStart;
-        ulong ticksPerMs = tscElapsed / calibrationMs;
+        if (frequency <= 0)
+        {
+            Serial.Write("[TSC] ERROR: TSC frequency could not be determined\n");
+            return;
+        }
 
-        TscFrequency = (long)(ticksPerMs * 1000);
+        TscFrequency = frequency;
         IsTscCalibrated = true;
+
+        LaiHostNative.SetClockFrequency((ulong)TscFrequency);
     }
 }
@@ -24,7 +24,7 @@ internal sealed class X64MsiBinder : IMsiBinder
     /// x64 MSI delivery is per-vector, not per-device — the LAPIC has no
     /// device-side state to allocate. Returns null.
     /// </summary>
-    public object? PrepareDevice(uint bus, uint slot, uint function, int entryCount) => null;
+    public object? PrepareDevice(uint segment, uint bus, uint slot, uint function, int entryCount) => null;
 
     public void BindEntry(object? deviceCtx, int entryIndex, InterruptManager.IrqDelegate handler,
                           uint targetCpu, out ulong address, out uint data)
@@ -20,6 +20,13 @@ public class X64PowerOps : IPowerOps
     private const ushort Bochs_ShutdownPort = 0xB004;
     private const ushort Vbox_ShutdownPort = 0x4004;
 
+    // RFLAGS.IF.
+    private const ulong Rflags_InterruptEnable = 1UL << 9;
+
+    // Interrupts (about 10 ms apart with the scheduler timer) Shutdown waits
+    // for a background namespace build to finish before giving up on S5.
+    private const int NamespaceWaitInterrupts = 500;
+
     [DoesNotReturn]
     public void Reboot()
     {
@@ -56,10 +63,12 @@ public class X64PowerOps : IPowerOps
     [DoesNotReturn]
     public void Shutdown()
     {
+        WaitForBackgroundPrepare();
         InternalCpu.DisableInterrupts();
 
-        // 1. ACPI S5 via LAI (real-hardware path; also works on QEMU/KVM with
-        //    the firmware-provided DSDT). Builds the AML namespace on first call.
+        // 1. ACPI S5 from the cached \_S5_ sleep types (real-hardware path; also
+        //    works on QEMU/KVM with the firmware-provided DSDT). Builds the AML
+        //    namespace on first call unless Prepare() already did.
         AcpiPmNative.Shutdown();
 
         // 2. Emulator-specific ACPI shutdown ports for environments where
@@ -74,4 +83,27 @@ public class X64PowerOps : IPowerOps
             InternalCpu.Halt();
         }
     }
+
+    public void Prepare()
+    {
+        AcpiPmNative.PrepareNamespace();
+    }
+
+    // A Prepare() still running on a background thread cannot finish once
+    // interrupts are off, and cosmos_acpi_shutdown then gives up on S5.
+    // Halting with interrupts on lets the scheduler run it to completion first.
+    private static void WaitForBackgroundPrepare()
+    {
+        ulong flags = CpuNative.SaveIrqAndDisable();
+        CpuNative.RestoreIrq(flags);
+        if ((flags & Rflags_InterruptEnable) == 0)
+        {
+            return;
+        }
+
+        for (int i = 0; i < NamespaceWaitInterrupts && AcpiPmNative.GetNamespaceState() == AcpiPmNative.NamespaceBuilding; i++)
+        {
+            InternalCpu.Halt();
+        }
+    }
 }
@@ -0,0 +1,31 @@
+using Cosmos.Kernel.Core.Bridge;
+
+namespace Cosmos.Kernel.Core;
+
+/// <summary>
+/// Records boot sub-phases into the native kmain boot profile, which is dumped
+/// as <c>[BOOTPROF]</c> serial lines right before <c>Main</c> runs.
+/// </summary>
+public static unsafe class BootProfile
+{
+    /// <summary>
+    /// Opens a phase and returns its slot for <see cref="End"/>.
+    /// <paramref name="name"/> must be a UTF-8 literal (<c>"heap"u8</c>): the
+    /// native table keeps the pointer, so it needs static, null-terminated data.
+    /// </summary>
+    public static uint Begin(ReadOnlySpan<byte> name)
+    {
+        fixed (byte* ptr = name)
+        {
+            return BootProfileNative.Begin(ptr);
+        }
+    }
+
+    /// <summary>
+    /// Closes a phase opened with <see cref="Begin"/>.
+    /// </summary>
+    public static void End(uint phase)
+    {
+        BootProfileNative.End(phase);
+    }
+}
@@ -25,4 +25,22 @@ public static unsafe class HeapNative
     {
         MemoryOp.Free(ptr);
     }
+
+    /// <summary>
+    /// Resize memory from Cosmos heap, in place when the size class allows
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_heap_realloc")]
+    public static void* Realloc(void* ptr, nuint size)
+    {
+        return MemoryOp.Realloc(ptr, (uint)size);
+    }
+
+    /// <summary>
+    /// Free memory from Cosmos heap, given the size the caller allocated
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_heap_free_sized")]
+    public static void FreeSized(void* ptr, nuint size)
+    {
+        MemoryOp.Free(ptr, (uint)size);
+    }
 }
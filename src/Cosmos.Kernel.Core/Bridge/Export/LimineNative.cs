@@ -37,6 +37,25 @@ public static unsafe class LimineNative
         return 0;
     }
 
+    /// <summary>
+    /// Expose the Limine MP response to the native SMP bring-up (Bootstrap/smp.c).
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__get_limine_mp_response")]
+    public static void* GetMpResponse()
+    {
+        return Limine.Mp.Response;
+    }
+
+    /// <summary>
+    /// Expose the Limine memory map response to the native SMP bring-up, which carves
+    /// the AP stacks out of a usable entry before the heap is initialized.
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__get_limine_memmap_response")]
+    public static void* GetMemmapResponse()
+    {
+        return Limine.MemoryMap.Response;
+    }
+
     /// <summary>
     /// Wrapper to expose Limine cmdline pointer.
     /// </summary>
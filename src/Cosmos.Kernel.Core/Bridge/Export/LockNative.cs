@@ -0,0 +1,115 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.Core.Scheduler;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Lock entry points for C library code (LAI host locks). Each lock is an
+/// IRQ-safe <see cref="TicketLock"/>: acquire disables interrupts on the
+/// calling CPU before taking a ticket and release restores them after
+/// handing the lock on, so an SCI or GPE handler on the holding CPU cannot
+/// deadlock against it while other CPUs keep running.
+/// </summary>
+public static unsafe class LockNative
+{
+    [StructLayout(LayoutKind.Sequential)]
+    private struct HostLock
+    {
+        public TicketLock Lock;
+        public ulong SavedIrq;       // interrupt state of the holder before acquire
+        public long AcquiredAt;      // Stopwatch ticks when the holder got the lock
+    }
+
+    private static ulong s_acquisitions;
+    private static ulong s_contended;
+    private static ulong s_totalHoldTicks;
+    private static ulong s_maxHoldTicks;
+
+    /// <summary>Number of host lock acquisitions since boot.</summary>
+    public static ulong Acquisitions => s_acquisitions;
+
+    /// <summary>Acquisitions that found the lock held and had to wait.</summary>
+    public static ulong Contended => s_contended;
+
+    /// <summary>Total time host locks were held, in Stopwatch ticks.</summary>
+    public static ulong TotalHoldTicks => s_totalHoldTicks;
+
+    /// <summary>Longest single hold of any host lock, in Stopwatch ticks.</summary>
+    public static ulong MaxHoldTicks => s_maxHoldTicks;
+
+    /// <summary>
+    /// Allocate and initialize a lock. Returns null when the heap is exhausted.
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_lock_alloc")]
+    public static void* Alloc()
+    {
+        HostLock* hostLock = (HostLock*)MemoryOp.Alloc((uint)sizeof(HostLock));
+        if (hostLock != null)
+        {
+            *hostLock = default;
+        }
+        return hostLock;
+    }
+
+    /// <summary>
+    /// Free a lock returned by <see cref="Alloc"/>. The lock must not be held.
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_lock_free")]
+    public static void Free(void* hostLock)
+    {
+        if (hostLock != null)
+        {
+            MemoryOp.Free(hostLock, (uint)sizeof(HostLock));
+        }
+    }
+
+    /// <summary>
+    /// Disable interrupts and acquire the lock. Not recursive.
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_lock_acquire")]
+    public static void Acquire(void* hostLock)
+    {
+        HostLock* l = (HostLock*)hostLock;
+        ulong flags = CpuNative.SaveIrqAndDisable();
+
+        if (!l->Lock.TryAcquire())
+        {
+            Interlocked.Increment(ref s_contended);
+            l->Lock.Acquire();
+        }
+
+        l->SavedIrq = flags;
+        l->AcquiredAt = Stopwatch.GetTimestamp();
+        Interlocked.Increment(ref s_acquisitions);
+    }
+
+    /// <summary>
+    /// Release the lock, record its hold time, then restore the interrupt
+    /// state saved by <see cref="Acquire"/>.
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_lock_release")]
+    public static void Release(void* hostLock)
+    {
+        HostLock* l = (HostLock*)hostLock;
+        ulong held = (ulong)(Stopwatch.GetTimestamp() - l->AcquiredAt);
+        ulong flags = l->SavedIrq;
+
+        Interlocked.Add(ref s_totalHoldTicks, held);
+        ulong max = Volatile.Read(ref s_maxHoldTicks);
+        while (held > max)
+        {
+            ulong seen = Interlocked.CompareExchange(ref s_maxHoldTicks, held, max);
+            if (seen == max)
+            {
+                break;
+            }
+            max = seen;
+        }
+
+        // Release before restoring interrupts (see IrqLockScope.Dispose).
+        l->Lock.Release();
+        CpuNative.RestoreIrq(flags);
+    }
+}
@@ -0,0 +1,22 @@
+using System.Runtime.InteropServices;
+using Cosmos.Kernel.Core.Memory;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Device-memory mapping entry point for C library code (LAI SystemMemory
+/// OperationRegions through <c>laihost_map</c>).
+/// </summary>
+public static class MmioNative
+{
+    /// <summary>
+    /// Ensures [<paramref name="physBase"/>, +<paramref name="length"/>) is
+    /// mapped at its HHDM alias. Returns 1 when the platform mapper ran,
+    /// 0 when none is registered yet (only the boot-time HHDM is usable).
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_mmio_map")]
+    public static int Map(ulong physBase, ulong length)
+    {
+        return MmioMapping.EnsureMapped(physBase, length) ? 1 : 0;
+    }
+}
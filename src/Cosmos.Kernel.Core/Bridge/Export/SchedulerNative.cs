@@ -0,0 +1,35 @@
+using System.Runtime.InteropServices;
+using Cosmos.Kernel.Core.Scheduler;
+using SchedThread = Cosmos.Kernel.Core.Scheduler.Thread;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Scheduler entry points for C library code (LAI host sleeps).
+/// </summary>
+public static class SchedulerNative
+{
+    /// <summary>
+    /// Parks the calling thread for <paramref name="milliseconds"/>.
+    /// Returns 1 if the scheduler slept the thread, 0 if the caller must wait by itself
+    /// (scheduler not running, or the caller is the idle thread, which cannot block —
+    /// see <see cref="InterruptEvent"/>).
+    /// </summary>
+    [UnmanagedCallersOnly(EntryPoint = "__cosmos_scheduler_sleep")]
+    public static int Sleep(uint milliseconds)
+    {
+        if (!SchedulerManager.IsReady || !SchedulerManager.Enabled)
+        {
+            return 0;
+        }
+
+        SchedThread? current = SchedulerManager.GetCpuState(SchedulerManager.GetCurrentCpuId())?.CurrentThread;
+        if (current == null || (current.Flags & ThreadFlags.IdleThread) != 0)
+        {
+            return 0;
+        }
+
+        SchedulerManager.Sleep(current.CpuId, current, milliseconds);
+        return 1;
+    }
+}
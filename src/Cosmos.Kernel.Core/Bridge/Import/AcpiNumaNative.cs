@@ -0,0 +1,21 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// ACPI SRAT / SLIT import (parsed by acpi_early_init in acpi_wrapper.c).
+/// The managed view lives in Cosmos.Kernel.Core/Memory/NumaTopology.cs.
+/// </summary>
+public static unsafe partial class AcpiNumaNative
+{
+    [LibraryImport("*", EntryPoint = "acpi_get_numa_info")]
+    [SuppressGCTransition]
+    public static partial void* GetNumaInfo();
+
+    /// <summary>
+    /// SRAT CPU affinity entries (<c>acpi_numa_cpu_t</c>), <paramref name="count"/> of them.
+    /// The first call allocates them on the heap, so this import keeps the GC transition.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "acpi_get_numa_cpus")]
+    public static partial void* GetNumaCpus(uint* count);
+}
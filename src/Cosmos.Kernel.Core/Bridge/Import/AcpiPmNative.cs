@@ -2,8 +2,35 @@ using System.Runtime.InteropServices;
 
 namespace Cosmos.Kernel.Core.Bridge;
 
-public static partial class AcpiPmNative
+public static unsafe partial class AcpiPmNative
 {
+    /// <summary>
+    /// <see cref="GetNamespaceState"/> while <see cref="PrepareNamespace"/> is building it.
+    /// </summary>
+    public const uint NamespaceBuilding = 1;
+
+    /// <summary>
+    /// Builds the AML namespace and the cached power / _PRT table
+    /// (<c>acpi_pm_cache_t</c>). Returns 0 once the namespace is ready.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "cosmos_acpi_prepare_namespace")]
+    public static partial int PrepareNamespace();
+
+    /// <summary>
+    /// 0 = namespace not built, 1 = being built, 2 = ready.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "cosmos_acpi_namespace_state")]
+    [SuppressGCTransition]
+    public static partial uint GetNamespaceState();
+
+    /// <summary>
+    /// Returns the cached power / _PRT table, or null until
+    /// <see cref="PrepareNamespace"/> has completed.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "acpi_get_pm_cache")]
+    [SuppressGCTransition]
+    public static partial void* GetPmCache();
+
     [LibraryImport("*", EntryPoint = "cosmos_acpi_shutdown")]
     public static partial int Shutdown();
 
@@ -0,0 +1,18 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Native imports for the kmain boot profile table (Cosmos.Kernel/Bootstrap/boot_profile.c).
+/// Lets managed Startup record its sub-phases next to the native kmain phases.
+/// </summary>
+public static unsafe partial class BootProfileNative
+{
+    [LibraryImport("*", EntryPoint = "cosmos_boot_phase_begin")]
+    [SuppressGCTransition]
+    public static partial uint Begin(byte* name);
+
+    [LibraryImport("*", EntryPoint = "cosmos_boot_phase_end")]
+    [SuppressGCTransition]
+    public static partial void End(uint slot);
+}
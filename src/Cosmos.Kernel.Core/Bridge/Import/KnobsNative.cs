@@ -3,12 +3,21 @@ using System.Runtime.InteropServices;
 namespace Cosmos.Kernel.Core.Bridge;
 
 /// <summary>
-/// Native import for the runtime-provided knob values table.
-/// Consumed by the AppContext plug.
+/// Native import for the runtime-provided knob values table: the ILC-embedded
+/// knobs merged with kernel cmdline <c>knob:Name=Value</c> overrides during
+/// kmain Phase 2. Consumed by the AppContext plug.
 /// </summary>
 public static unsafe partial class KnobsNative
 {
     [LibraryImport("*", EntryPoint = "RhGetKnobValues")]
     [SuppressGCTransition]
     public static partial uint GetKnobValues(out byte** keys, out byte** values);
+
+    /// <summary>
+    /// Hashed lookup of a single knob. <paramref name="key"/> is a NUL-terminated
+    /// UTF-8 name; returns its NUL-terminated value, or null when it is not set.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "cosmos_knob_get")]
+    [SuppressGCTransition]
+    public static partial byte* GetKnobValue(byte* key);
 }
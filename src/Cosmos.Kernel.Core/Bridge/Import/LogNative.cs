@@ -0,0 +1,17 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Native log rings (Cosmos.Kernel.Native.MultiArch/Log/cosmos_log.c).
+/// </summary>
+public static unsafe partial class LogNative
+{
+    /// <summary>
+    /// Copies up to <paramref name="maxRecords"/> queued C-side log messages (0 = all that fit)
+    /// into <paramref name="destination"/>. Returns the byte count; 0 when empty or another drain is running.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "cosmos_log_drain")]
+    [SuppressGCTransition]
+    public static partial nuint Drain(byte* destination, nuint capacity, uint maxRecords);
+}
@@ -0,0 +1,32 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Span variants of the native libm rounding family (Native.MultiArch/C/math.c).
+/// Each computes <c>dst[i] = op(src[i])</c> for <c>i &lt; count</c>, two lanes
+/// per instruction where the CPU allows; <c>dst</c> may equal <c>src</c>.
+/// </summary>
+public static unsafe partial class MathNative
+{
+    [LibraryImport("*", EntryPoint = "cosmos_math_floor_span")]
+    [SuppressGCTransition]
+    public static partial void FloorSpan(double* dst, double* src, ulong count);
+
+    [LibraryImport("*", EntryPoint = "cosmos_math_ceil_span")]
+    [SuppressGCTransition]
+    public static partial void CeilingSpan(double* dst, double* src, ulong count);
+
+    [LibraryImport("*", EntryPoint = "cosmos_math_trunc_span")]
+    [SuppressGCTransition]
+    public static partial void TruncateSpan(double* dst, double* src, ulong count);
+
+    /// <summary>Rounds halves away from zero (C <c>round</c>, <c>MidpointRounding.AwayFromZero</c>).</summary>
+    [LibraryImport("*", EntryPoint = "cosmos_math_round_span")]
+    [SuppressGCTransition]
+    public static partial void RoundSpan(double* dst, double* src, ulong count);
+
+    [LibraryImport("*", EntryPoint = "cosmos_math_sqrt_span")]
+    [SuppressGCTransition]
+    public static partial void SqrtSpan(double* dst, double* src, ulong count);
+}
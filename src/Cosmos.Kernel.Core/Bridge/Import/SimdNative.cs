@@ -31,4 +31,22 @@ public static unsafe partial class SimdNative
     [LibraryImport("*", EntryPoint = "_simd_fill_16_blocks")]
     [SuppressGCTransition]
     public static partial void Fill16Blocks(byte* dest, int value, int blockCount);
+
+    // Freestanding libc primitives from Memory/MemoryCopy.s (shared with the C objects).
+
+    [LibraryImport("*", EntryPoint = "memcpy")]
+    [SuppressGCTransition]
+    public static partial void* MemCopy(byte* dest, byte* src, nuint count);
+
+    [LibraryImport("*", EntryPoint = "memmove")]
+    [SuppressGCTransition]
+    public static partial void* MemMove(byte* dest, byte* src, nuint count);
+
+    [LibraryImport("*", EntryPoint = "memset")]
+    [SuppressGCTransition]
+    public static partial void* MemSet(byte* dest, int value, nuint count);
+
+    [LibraryImport("*", EntryPoint = "memcmp")]
+    [SuppressGCTransition]
+    public static partial int MemCmp(byte* s1, byte* s2, nuint count);
 }
@@ -0,0 +1,31 @@
+using System.Runtime.InteropServices;
+
+namespace Cosmos.Kernel.Core.Bridge;
+
+/// <summary>
+/// Application processors brought up and parked by kmain Phase 2.5
+/// (Bootstrap/smp.c). CPU indices match SchedulerManager's: 0 is the BSP.
+/// The APs stay parked: SchedulerManager does not adopt them yet, so only
+/// the BSP runs managed code.
+/// </summary>
+public static partial class SmpNative
+{
+    /// <summary>CPU slots, BSP included.</summary>
+    [LibraryImport("*", EntryPoint = "cosmos_smp_cpu_count")]
+    [SuppressGCTransition]
+    public static partial uint CpuCount();
+
+    /// <summary>Index of the executing CPU, from its per-CPU register (GS base / TPIDR_EL1).</summary>
+    [LibraryImport("*", EntryPoint = "cosmos_smp_current_cpu")]
+    [SuppressGCTransition]
+    public static partial uint CurrentCpu();
+
+    /// <summary>
+    /// Hardware ID of CPU <paramref name="cpuIndex"/> (x64: LAPIC ID, ARM64: MPIDR_EL1),
+    /// or <see cref="ulong.MaxValue"/> past the last slot. The BSP's is 0 when
+    /// Limine gave no MP response.
+    /// </summary>
+    [LibraryImport("*", EntryPoint = "cosmos_smp_hw_id")]
+    [SuppressGCTransition]
+    public static partial ulong HardwareId(uint cpuIndex);
+}
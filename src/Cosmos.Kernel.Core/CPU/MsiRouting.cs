@@ -23,7 +23,7 @@ namespace Cosmos.Kernel.Core.CPU;
 /// per MSI-X table entry. The binder owns vector / LPI allocation and any
 /// device-specific bookkeeping (ITT allocation, MAPD, MAPTI on ARM64).
 ///
-/// PCI device identity is passed in raw (bus, slot, function) form to keep
+/// PCI device identity is passed in raw (segment, bus, slot, function) form to keep
 /// this file free of <c>HAL/Pci</c> dependencies — Core can't reference
 /// HAL upstream.
 /// </summary>
@@ -50,13 +50,13 @@ public static class MsiRouting
     /// <see cref="BindEntry"/>; may be null on platforms that don't need
     /// per-device state (x64).
     /// </summary>
-    public static object? PrepareDevice(uint bus, uint slot, uint function, int entryCount)
+    public static object? PrepareDevice(uint segment, uint bus, uint slot, uint function, int entryCount)
     {
         if (s_binder == null)
         {
             throw new System.PlatformNotSupportedException("MSI binder not registered");
         }
-        return s_binder.PrepareDevice(bus, slot, function, entryCount);
+        return s_binder.PrepareDevice(segment, bus, slot, function, entryCount);
     }
 
     /// <summary>
@@ -90,7 +90,7 @@ public interface IMsiBinder
     /// Return an opaque object the binder will receive in
     /// <see cref="BindEntry"/>, or null if no state is needed (x64).
     /// </summary>
-    object? PrepareDevice(uint bus, uint slot, uint function, int entryCount);
+    object? PrepareDevice(uint segment, uint bus, uint slot, uint function, int entryCount);
 
     /// <summary>
     /// Allocate a routing slot for <paramref name="handler"/> and produce
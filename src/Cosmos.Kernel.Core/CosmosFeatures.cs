@@ -99,4 +99,25 @@ public static class CosmosFeatures
     [FeatureSwitchDefinition("Cosmos.Kernel.System.Filesystems.Fat.Enabled")]
     public static bool FatEnabled =>
         AppContext.TryGetSwitch("Cosmos.Kernel.System.Filesystems.Fat.Enabled", out bool enabled) ? enabled : true;
+
+    /// <summary>
+    /// Builds the ACPI AML namespace (and the cached \_S5_ / _PRT table) on a
+    /// background thread after boot instead of on the first shutdown call.
+    /// Off by default. Requires Scheduler; the MSBuild cascade in Sdk.targets
+    /// disables this when Scheduler is off.
+    /// Set via CosmosEnableAcpiEagerNamespace property in csproj.
+    /// </summary>
+    [FeatureSwitchDefinition("Cosmos.Kernel.HAL.Acpi.EagerNamespace.Enabled")]
+    public static bool AcpiEagerNamespaceEnabled =>
+        AppContext.TryGetSwitch("Cosmos.Kernel.HAL.Acpi.EagerNamespace.Enabled", out bool enabled) ? enabled : false;
+
+    /// <summary>
+    /// Compiles in the timer-driven sampling profiler (<c>Runtime.SamplingProfiler</c>).
+    /// Off by default. Requires Timer; the MSBuild cascade in Sdk.targets
+    /// disables this when Timer is off.
+    /// Set via CosmosEnableProfiler property in csproj.
+    /// </summary>
+    [FeatureSwitchDefinition("Cosmos.Kernel.Core.Profiler.Enabled")]
+    public static bool ProfilerEnabled =>
+        AppContext.TryGetSwitch("Cosmos.Kernel.Core.Profiler.Enabled", out bool enabled) ? enabled : false;
 }
@@ -0,0 +1,47 @@
+using Cosmos.Kernel.Core.Bridge;
+
+namespace Cosmos.Kernel.Core.IO;
+
+/// <summary>
+/// Writes out messages the native C layer queued in its log rings
+/// (COSMOS_LOG_* in cosmos_log.h). Native code only formats into the rings;
+/// the UART time is paid here, on the timer IRQ, before idling, and on panic.
+/// </summary>
+public static unsafe class NativeLog
+{
+    /// <summary>Messages written per timer tick, so a burst cannot stretch one IRQ.</summary>
+    public const uint TickRecordBudget = 8;
+
+    private const int ChunkSize = 256;
+
+    /// <summary>
+    /// Writes at most <paramref name="maxRecords"/> queued messages.
+    /// </summary>
+    public static void Pump(uint maxRecords)
+    {
+        byte* chunk = stackalloc byte[ChunkSize];
+        Write(chunk, LogNative.Drain(chunk, ChunkSize, maxRecords));
+    }
+
+    /// <summary>
+    /// Writes every queued message.
+    /// </summary>
+    public static void Flush()
+    {
+        byte* chunk = stackalloc byte[ChunkSize];
+        nuint count;
+        while ((count = LogNative.Drain(chunk, ChunkSize, 0)) != 0)
+        {
+            Write(chunk, count);
+        }
+    }
+
+    private static void Write(byte* chunk, nuint count)
+    {
+        for (nuint i = 0; i < count; i++)
+        {
+            EarlyGop.PutChar((char)chunk[i]);
+            Serial.ComWrite(chunk[i]);
+        }
+    }
+}
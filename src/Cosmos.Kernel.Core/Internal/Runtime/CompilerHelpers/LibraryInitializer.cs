@@ -1,3 +1,4 @@
+using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Memory;
 using Cosmos.Kernel.Core.Memory.GarbageCollector;
@@ -17,15 +18,21 @@ namespace Internal.Runtime.CompilerHelpers
         {
             // Initialize heap for memory allocations
             Serial.WriteString("[KERNEL]   - Initializing heap...\n");
+            uint phase = BootProfile.Begin("startup.heap"u8);
             MemoryOp.InitializeHeap(0, 0);
+            BootProfile.End(phase);
 
             // Initialize garbage collector
             Serial.WriteString("[KERNEL]   - Initializing garbage collector...\n");
+            phase = BootProfile.Begin("startup.gc"u8);
             GarbageCollector.Initialize();
+            BootProfile.End(phase);
 
             // Initialize managed modules
             Serial.WriteString("[KERNEL]   - Initializing managed modules...\n");
+            phase = BootProfile.Begin("startup.modules"u8);
             ManagedModule.InitializeModules();
+            BootProfile.End(phase);
         }
     }
 }
@@ -14,14 +14,20 @@ public static unsafe partial class GarbageCollector
     /// Allocates a new GC segment backed by page-allocated memory.
     /// </summary>
     /// <param name="requestedSize">Minimum usable size in bytes.</param>
+    /// <param name="node">
+    /// NUMA node the pages must come from, or <see cref="PageAllocator.AnyNode"/>
+    /// to prefer the calling CPU's node and fall back to any other.
+    /// </param>
     /// <returns>Pointer to the initialized segment, or <c>null</c> if page allocation fails.</returns>
-    private static GCSegment* AllocateSegment(uint requestedSize)
+    private static GCSegment* AllocateSegment(uint requestedSize, int node = PageAllocator.AnyNode)
     {
         uint size = requestedSize < s_maxSegmentSize ? s_maxSegmentSize : requestedSize;
         uint totalSize = size + (uint)sizeof(GCSegment) + ReservedHeaderSlotSize;
         ulong pageCount = (totalSize + PageAllocator.PageSize - 1) / PageAllocator.PageSize;
 
-        var memory = (byte*)PageAllocator.AllocPages(PageType.GCHeap, pageCount, true);
+        var memory = node == PageAllocator.AnyNode
+            ? (byte*)PageAllocator.AllocPages(PageType.GCHeap, pageCount, true)
+            : (byte*)PageAllocator.AllocPagesOnNode(PageType.GCHeap, pageCount, true, node);
         if (memory == null)
         {
             return null;
@@ -30,12 +36,13 @@ public static unsafe partial class GarbageCollector
         var segment = (GCSegment*)memory;
         segment->Next = null;
         // Pad Start so the first object's runtime header write (objRef-4) lands in
-        // zeroed filler instead of the segment struct's last field (UsedSize).
+        // zeroed filler instead of the segment struct's last field (Node).
         segment->Start = memory + Align((uint)sizeof(GCSegment)) + ReservedHeaderSlotSize;
         segment->End = memory + (pageCount * PageAllocator.PageSize);
         segment->Bump = segment->Start;
         segment->TotalSize = (uint)(segment->End - segment->Start);
         segment->UsedSize = 0;
+        segment->Node = PageAllocator.GetPageNode(memory);
 
         return segment;
     }
@@ -404,9 +411,32 @@ public static unsafe partial class GarbageCollector
         return null;
     }
 
+    /// <summary>
+    /// Bump allocation in the first segment on NUMA node <paramref name="node"/>
+    /// with room for <paramref name="size"/> bytes. Used by TLAB refill.
+    /// </summary>
+    private static void* BumpAllocInNodeSegmentRaw(int node, uint size)
+    {
+        for (GCSegment* seg = s_segments; seg != null; seg = seg->Next)
+        {
+            if (seg->Node == node)
+            {
+                void* result = BumpAllocInSegmentRaw(seg, size);
+                if (result != null)
+                {
+                    return result;
+                }
+            }
+        }
+
+        return null;
+    }
+
     /// <summary>
     /// Slow allocation path without incrementing <see cref="s_totalAllocatedBytes"/>.
     /// Walks segments and allocates a new one if needed. Used by TLAB refill.
+    /// On a NUMA machine, a new segment on the calling CPU's node is preferred
+    /// over bump space left in remote segments.
     /// </summary>
     private static void* AllocateObjectSlowRaw(uint size)
     {
@@ -415,6 +445,27 @@ public static unsafe partial class GarbageCollector
             return null;
         }
 
+        int node = PageAllocator.CurrentNode;
+        if (node != PageAllocator.AnyNode)
+        {
+            void* local = BumpAllocInNodeSegmentRaw(node, size);
+            if (local != null)
+            {
+                return local;
+            }
+
+            // Only take pages from this node here; when it is full, reuse
+            // remote bump space before adding another remote segment.
+            GCSegment* localSegment = AllocateSegment(size, node);
+            if (localSegment != null)
+            {
+                AppendSegment(localSegment);
+                s_lastSegment = localSegment;
+                s_currentSegment = localSegment;
+                return BumpAllocInSegmentRaw(localSegment, size);
+            }
+        }
+
         if (s_lastSegment == null)
         {
             s_lastSegment = s_segments;
@@ -2,6 +2,7 @@
 
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics.X86;
 using Cosmos.Kernel.Core.Bridge;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Scheduler;
@@ -16,6 +17,12 @@ namespace Cosmos.Kernel.Core.Memory.GarbageCollector;
 /// </summary>
 public static unsafe partial class GarbageCollector
 {
+    /// <summary>
+    /// Objects popped from the mark stack and prefetched, but not yet scanned. Scanning
+    /// the oldest while the newer ones load hides most of the cache miss on each header.
+    /// </summary>
+    private const int MarkPrefetchDepth = 8;
+
     /// <summary>
     /// Executes the mark phase: scans roots (stack, GC handles) and marks all reachable objects.
     /// Static roots need no separate pass: <c>ManagedModule.InitializeStatics</c> holds every
@@ -280,38 +287,102 @@ public static unsafe partial class GarbageCollector
         }
 
         PushMarkStack(value);
+        DrainMarkStack();
+    }
 
-        while (s_markStackCount > 0)
-        {
-            nint ptr = PopMarkStack();
-            var obj = (GCObject*)ptr;
+    /// <summary>
+    /// Marks everything reachable from the mark stack. Popped entries pass through a
+    /// <see cref="MarkPrefetchDepth"/>-deep FIFO: each one is prefetched when it enters and
+    /// scanned when it leaves, so its header is usually cached by the time it is read.
+    /// The drain runs on the collecting CPU alone; splitting it across CPUs waits on
+    /// the scheduler adopting the parked application processors.
+    /// </summary>
+    private static void DrainMarkStack()
+    {
+        nint* pending = stackalloc nint[MarkPrefetchDepth];
+        int head = 0;
+        int count = 0;
 
-            // Validate MethodTable - must point outside heap (to kernel code)
-            nuint mtPtr = (nuint)obj->MethodTable & ~(nuint)1;
-            if (mtPtr == 0 || IsInGCHeap((nint)mtPtr))
+        while (true)
+        {
+            nint ptr;
+            if (s_markStackCount > 0)
             {
-                continue;
-            }
+                nint next = PopMarkStack();
+                PrefetchObject(next);
 
-            // MethodTable must be in kernel address space (higher-half).
-            // Reject pointers in userspace range — they're garbage from conservative scanning.
-            if (mtPtr < AddressSpace.KernelSpaceStart)
+                if (count < MarkPrefetchDepth)
+                {
+                    pending[(head + count) % MarkPrefetchDepth] = next;
+                    count++;
+                    continue;
+                }
+
+                ptr = pending[head];
+                pending[head] = next;
+                head = (head + 1) % MarkPrefetchDepth;
+            }
+            else if (count > 0)
             {
-                continue;
+                ptr = pending[head];
+                head = (head + 1) % MarkPrefetchDepth;
+                count--;
             }
-
-            if (obj->IsMarked)
+            else
             {
-                continue;
+                return;
             }
 
-            obj->Mark();
+            MarkObject((GCObject*)ptr);
+        }
+    }
 
-            MethodTable* mt = obj->GetMethodTable();
-            if (mt->ContainsGCPointers)
-            {
-                EnumerateReferences(obj, mt);
-            }
+    /// <summary>
+    /// Marks one mark-stack entry and pushes its references, unless it is already marked or
+    /// its header is not a plausible MethodTable (garbage from conservative scanning).
+    /// </summary>
+    /// <param name="obj">Candidate object; known to lie inside the GC heap.</param>
+    private static void MarkObject(GCObject* obj)
+    {
+        // Validate MethodTable - must point outside heap (to kernel code)
+        nuint mtPtr = (nuint)obj->MethodTable & ~(nuint)1;
+        if (mtPtr == 0 || IsInGCHeap((nint)mtPtr))
+        {
+            return;
+        }
+
+        // MethodTable must be in kernel address space (higher-half).
+        // Reject pointers in userspace range — they're garbage from conservative scanning.
+        if (mtPtr < AddressSpace.KernelSpaceStart)
+        {
+            return;
+        }
+
+        if (obj->IsMarked)
+        {
+            return;
+        }
+
+        obj->Mark();
+
+        MethodTable* mt = obj->GetMethodTable();
+        if (mt->ContainsGCPointers)
+        {
+            EnumerateReferences(obj, mt);
+        }
+    }
+
+    /// <summary>
+    /// Hints the object header at <paramref name="ptr"/> into the cache. A prefetch never
+    /// faults, so conservative-scan garbage is harmless. No-op where there is no managed
+    /// prefetch intrinsic (arm64).
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static void PrefetchObject(nint ptr)
+    {
+        if (Sse.IsSupported)
+        {
+            Sse.Prefetch0((void*)ptr);
         }
     }
 
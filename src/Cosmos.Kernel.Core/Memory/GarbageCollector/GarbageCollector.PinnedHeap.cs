@@ -90,12 +90,13 @@ public static unsafe partial class GarbageCollector
         var segment = (GCSegment*)memory;
         segment->Next = null;
         // Pad Start so the first object's runtime header write (objRef-4) lands in
-        // zeroed filler instead of the segment struct's last field (UsedSize).
+        // zeroed filler instead of the segment struct's last field (Node).
         segment->Start = memory + Align((uint)sizeof(GCSegment)) + ReservedHeaderSlotSize;
         segment->End = memory + (pageCount * PageAllocator.PageSize);
         segment->Bump = segment->Start;
         segment->TotalSize = (uint)(segment->End - segment->Start);
         segment->UsedSize = 0;
+        segment->Node = PageAllocator.GetPageNode(memory);
 
         return segment;
     }
@@ -64,8 +64,13 @@ public static unsafe partial class GarbageCollector
                 return SetupTlab(ref ac, buffer, requestSize);
             }
 
-            // Try bump allocation from segments (raw variant — must zero)
-            buffer = BumpAllocInSegmentRaw(s_lastSegment, requestSize);
+            // Try bump allocation from segments (raw variant — must zero).
+            // On a NUMA machine stay out of a remote s_lastSegment: the slow
+            // path below looks for (or maps) a segment on this CPU's node.
+            int node = PageAllocator.CurrentNode;
+            buffer = node == PageAllocator.AnyNode || (s_lastSegment != null && s_lastSegment->Node == node)
+                ? BumpAllocInSegmentRaw(s_lastSegment, requestSize)
+                : null;
             if (buffer != null)
             {
                 MemoryOp.MemSet((byte*)buffer, 0, (int)requestSize);
@@ -83,6 +83,12 @@ public static unsafe partial class GarbageCollector
         /// Bytes currently in use (live + dead objects before sweep).
         /// </summary>
         public uint UsedSize;
+
+        /// <summary>
+        /// NUMA node backing the segment's pages, or <see cref="PageAllocator.AnyNode"/>
+        /// when the page allocator is flat.
+        /// </summary>
+        public int Node;
     }
 
     /// <summary>
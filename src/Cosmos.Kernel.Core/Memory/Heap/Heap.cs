@@ -6,84 +6,108 @@ namespace Cosmos.Kernel.Core.Memory.Heap;
 /// <summary>
 /// a basic Heap that uses PageAllocator
 /// </summary>
+/// <remarks>
+/// Small blocks up to 512 bytes go through per-CPU <see cref="HeapMagazines"/>;
+/// everything else, and magazine refills and drains, takes <see cref="SharedLock"/>.
+/// Entry points still disable interrupts, which only guards the current CPU.
+/// </remarks>
 public static unsafe class Heap
 {
+    /// <summary>
+    /// Serializes the shared SmallHeap, MediumHeap and LargeHeap across CPUs.
+    /// Only taken with interrupts disabled.
+    /// </summary>
+    internal static Scheduler.SpinLock SharedLock;
+
     /// <summary>
     /// Re-allocates or "re-sizes" data asigned to a pointer.
     /// The pointer specified must be the start of an allocated block in the heap.
     /// This shouldn't be used with objects as a new address is given when realocating memory.
+    /// Blocks are resized in place when the new size stays in the same size class
+    /// (and, for small blocks, the same SMT slot size); otherwise the data moves.
     /// </summary>
-    /// <param name="aPtr">Existing pointer</param>
-    /// <param name="newSize">Size to extend to</param>
+    /// <param name="aPtr">Existing pointer, or null to allocate.</param>
+    /// <param name="newSize">Size to extend to; 0 frees the block.</param>
     /// <returns>New pointer with specified size while maintaining old data.</returns>
     public static byte* Realloc(byte* aPtr, uint newSize)
     {
-        using (InternalCpu.DisableInterruptsScope())
+        if (aPtr == null)
         {
-            PageType currentType = PageAllocator.GetPageType(aPtr);
+            return Alloc(newSize);
+        }
 
-#if COSMOSDEBUG
-            if (currentType != PageType.HeapSmall && currentType != PageType.HeapMedium &&
-                currentType != PageType.HeapLarge)
-            {
-                Debugger.DoSendNumber(newSize);
-                Debugger.DoSendNumber((uint)aPtr);
-                Debugger.SendKernelPanic(Panics.NonManagedPage);
-            }
-#endif
+        if (newSize == 0)
+        {
+            Free(aPtr);
+            return null;
+        }
 
-            byte* result;
+        using (InternalCpu.DisableInterruptsScope())
+        {
+            PageType currentType = PageAllocator.GetPageType(aPtr);
+            PageType newType = GetSizeClass(newSize);
+            uint oldSize;
 
-            if (newSize > MediumHeap.MinSize && newSize <= MediumHeap.MaxSize)
+            switch (currentType)
             {
-                if (currentType == PageType.HeapMedium)
-                {
-                    result = MediumHeap.Realloc(aPtr, newSize);
-                    return result;
-                }
-
-                int oldSize = 0;
-                if (currentType == PageType.HeapLarge)
-                {
-                    LargeHeapHeader* header = LargeHeap.GetHeader(aPtr);
-                    oldSize = (int)header->Size;
-                }
-                else if (currentType == PageType.HeapSmall)
-                {
-                    SmallHeapHeader* header = SmallHeap.GetHeader(aPtr);
-                    oldSize = (int)header->Size;
-                }
-                else
-                {
-                    throw new Exception();
-                }
+                case PageType.HeapSmall:
+                    // The block is owned by its caller, so resizing it in place
+                    // only reads the shared SMT (GetRoundedSize).
+                    if (newType == PageType.HeapSmall && SmallHeap.TryResize(aPtr, newSize))
+                    {
+                        return aPtr;
+                    }
 
-                byte* newPtr = MediumHeap.Alloc(newSize);
-                // Copy the smaller of oldSize and newSize to avoid buffer overread
-                int copySize = oldSize < (int)newSize ? oldSize : (int)newSize;
-                MemoryOp.MemCopy(newPtr, aPtr, copySize);
+                    oldSize = SmallHeap.GetHeader(aPtr)->Size;
+                    break;
+                case PageType.HeapMedium:
+                    if (newType == PageType.HeapMedium)
+                    {
+                        SharedLock.Acquire();
+                        byte* resized = MediumHeap.Realloc(aPtr, newSize);
+                        SharedLock.Release();
+                        return resized;
+                    }
 
-                // Free the old allocation
-                if (currentType == PageType.HeapLarge)
-                {
-                    LargeHeap.Free(aPtr);
-                }
-                else if (currentType == PageType.HeapSmall)
-                {
-                    SmallHeap.Free(aPtr);
-                }
+                    oldSize = MediumHeap.GetHeader(aPtr)->Size;
+                    break;
+                case PageType.HeapLarge:
+                    if (newType == PageType.HeapLarge)
+                    {
+                        SharedLock.Acquire();
+                        byte* resized = LargeHeap.Realloc(aPtr, newSize);
+                        SharedLock.Release();
+                        return resized;
+                    }
 
-                return newPtr;
+                    oldSize = LargeHeap.GetHeader(aPtr)->Size;
+                    break;
+                default:
+                    Debugger.DoSendNumber(newSize);
+                    Debugger.DoSendNumber((uint)aPtr);
+                    Debugger.SendKernelPanic(Panics.NonManagedPage);
+                    throw new NotSupportedException("This is not a managed page");
             }
 
-            if (newSize >= LargeHeap.MinSize)
-            {
-                result = LargeHeap.Alloc(newSize);
-                return result;
-            }
+            // Size class changes: move to a block of the new class.
+            byte* newPtr = Alloc(newSize);
+            MemoryOp.MemCopy(newPtr, aPtr, (int)(oldSize < newSize ? oldSize : newSize));
+            Free(aPtr);
+            return newPtr;
         }
+    }
 
-        return (byte*)0;
+    /// <summary>
+    /// Heap a block of <paramref name="aSize"/> bytes is allocated from (see <see cref="Alloc"/>).
+    /// </summary>
+    private static PageType GetSizeClass(uint aSize)
+    {
+        if (aSize > MediumHeap.MinSize && aSize <= MediumHeap.MaxSize)
+        {
+            return PageType.HeapMedium;
+        }
+
+        return aSize > LargeHeap.MinSize ? PageType.HeapLarge : PageType.HeapSmall;
     }
 
     /// <summary>
@@ -97,18 +121,30 @@ public static unsafe class Heap
 
         using (InternalCpu.DisableInterruptsScope())
         {
-            if (aSize > MediumHeap.MinSize && aSize <= MediumHeap.MaxSize)
+            PageType sizeClass = GetSizeClass(aSize);
+            if (sizeClass == PageType.HeapSmall)
             {
-                result = MediumHeap.Alloc(aSize);
-            }
-            else if (aSize > LargeHeap.MinSize)
-            {
-                result = LargeHeap.Alloc(aSize);
+                result = HeapMagazines.TryAlloc(aSize);
+                if (result != null)
+                {
+                    return result;
+                }
             }
-            else
+
+            SharedLock.Acquire();
+            switch (sizeClass)
             {
-                result = SmallHeap.Alloc(aSize);
+                case PageType.HeapMedium:
+                    result = MediumHeap.Alloc(aSize);
+                    break;
+                case PageType.HeapLarge:
+                    result = LargeHeap.Alloc(aSize);
+                    break;
+                default:
+                    result = SmallHeap.Alloc(aSize);
+                    break;
             }
+            SharedLock.Release();
         }
 
         return result;
@@ -132,6 +168,12 @@ public static unsafe class Heap
         {
             PageType currentType = PageAllocator.GetPageType(aPtr);
 
+            if (currentType == PageType.HeapSmall && HeapMagazines.TryFree(aPtr))
+            {
+                return;
+            }
+
+            SharedLock.Acquire();
             switch (currentType)
             {
                 case PageType.HeapLarge:
@@ -144,9 +186,52 @@ public static unsafe class Heap
                     SmallHeap.Free(aPtr);
                     break;
                 default:
+                    SharedLock.Release();
                     Debugger.SendKernelPanic(Panics.NonManagedPage);
                     throw new NotSupportedException("This is not a managed page");
             }
+            SharedLock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Free a heap item whose size the caller tracks (C allocators such as LAI).
+    /// With COSMOSDEBUG the size is checked against the block header, which
+    /// catches callers whose bookkeeping disagrees with in-place <see cref="Realloc"/>.
+    /// </summary>
+    /// <param name="aPtr">A pointer to the heap item to be freed.</param>
+    /// <param name="aSize">Size the caller allocated or last resized the block to; 0 if unknown.</param>
+    public static void Free(void* aPtr, uint aSize)
+    {
+#if COSMOSDEBUG
+        if (aSize != 0 && aSize != GetSize(aPtr))
+        {
+            Debugger.DoSendNumber(aSize);
+            Debugger.DoSendNumber((uint)aPtr);
+            Debugger.SendKernelPanic(Panics.NonManagedPage);
+        }
+#endif
+
+        Free(aPtr);
+    }
+
+    /// <summary>
+    /// Size a heap item was allocated or last resized to.
+    /// </summary>
+    /// <param name="aPtr">Start of an allocated heap block.</param>
+    /// <returns>Size in bytes, or 0 if the pointer is not on a heap page.</returns>
+    public static uint GetSize(void* aPtr)
+    {
+        switch (PageAllocator.GetPageType(aPtr))
+        {
+            case PageType.HeapSmall:
+                return SmallHeap.GetHeader((byte*)aPtr)->Size;
+            case PageType.HeapMedium:
+                return MediumHeap.GetHeader((byte*)aPtr)->Size;
+            case PageType.HeapLarge:
+                return LargeHeap.GetHeader((byte*)aPtr)->Size;
+            default:
+                return 0;
         }
     }
 
@@ -164,8 +249,11 @@ public static unsafe class Heap
             // Run GC to identify and free unreachable objects
             result = GarbageCollector.GarbageCollector.Collect();
 
-            // Also prune empty SMT pages
+            // Also prune empty SMT pages; cached blocks would keep theirs alive
+            HeapMagazines.FlushAllCpus();
+            SharedLock.Acquire();
             result += SmallHeap.PruneSMT();
+            SharedLock.Release();
         }
 
         return result;
@@ -0,0 +1,311 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using System.Runtime.InteropServices;
+using Cosmos.Kernel.Core.Bridge;
+using Cosmos.Kernel.Debug;
+
+namespace Cosmos.Kernel.Core.Memory.Heap;
+
+/// <summary>
+/// Hit/miss counters of one magazine size class, summed over all CPUs.
+/// </summary>
+public struct HeapMagazineStats
+{
+    /// <summary>Allocations served straight from a magazine.</summary>
+    public ulong Hits;
+
+    /// <summary>Allocations that found their magazine empty.</summary>
+    public ulong Misses;
+
+    /// <summary>Batches taken from <see cref="SmallHeap"/> to refill an empty magazine.</summary>
+    public ulong Refills;
+
+    /// <summary>Batches returned to <see cref="SmallHeap"/> from a full magazine.</summary>
+    public ulong Drains;
+
+    /// <summary>Free blocks currently sitting in magazines.</summary>
+    public ulong Cached;
+}
+
+/// <summary>
+/// Per-CPU, per-size-class magazines in front of <see cref="SmallHeap"/>.
+/// Each magazine is a bounded LIFO of free blocks of one SMT slot size:
+/// <see cref="Heap.Alloc"/> pops from it and <see cref="Heap.Free"/> pushes to
+/// it, touching only the current CPU's state. The shared SMT (and
+/// <see cref="Heap.SharedLock"/>) is only entered to refill an empty magazine or
+/// drain a full one, <see cref="Batch"/> blocks at a time. Magazines are keyed on
+/// the executing CPU's index from its per-CPU register
+/// (<see cref="SmpNative.CurrentCpu"/>), not on scheduler state, so they are
+/// usable before the scheduler starts.
+///
+/// A cached block keeps a non-zero header (<see cref="CachedMarker"/>), so
+/// SmallHeap still counts it as allocated (<see cref="SmallHeap.GetAllocatedObjectCount"/>)
+/// and will not hand it out; <see cref="Heap.Collect"/> flushes every CPU's
+/// magazines before pruning empty SMT pages. Blocks are zeroed when they enter a
+/// magazine, so allocations stay zero-filled as with SmallHeap.
+/// Callers run with interrupts disabled.
+/// </summary>
+public static unsafe class HeapMagazines
+{
+    /// <summary>
+    /// Size classes with a magazine: the SMT root sizes 16..512
+    /// (<see cref="SmallHeap"/> InitSMTPage). Larger small blocks are rare
+    /// enough to go straight to the SMT.
+    /// </summary>
+    public const int ClassCount = 7;
+
+    /// <summary>Blocks a magazine holds.</summary>
+    public const int Capacity = 32;
+
+    /// <summary>Blocks moved per refill or drain.</summary>
+    public const int Batch = Capacity / 2;
+
+    /// <summary>CPUs with magazines; CPUs past it allocate from the shared heap directly.</summary>
+    public const int MaxCpus = 32;
+
+    // Header size of a block parked in a magazine; real small sizes are < 2048.
+    private const ushort CachedMarker = 0xFFFF;
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct Magazine
+    {
+        public uint Count;
+        public uint Reserved;
+        public ulong Hits;
+        public ulong Misses;
+        public ulong Refills;
+        public ulong Drains;
+        public fixed ulong Slots[Capacity];
+    }
+
+    // One page per CPU, allocated on the CPU's first small allocation.
+    // ClassCount * sizeof(Magazine) = 2072 bytes.
+    private struct CpuTable
+    {
+        public fixed ulong Magazines[MaxCpus];
+    }
+
+    private static CpuTable s_cpus;
+
+    /// <summary>
+    /// SMT slot size of magazine class <paramref name="sizeClass"/>.
+    /// </summary>
+    public static uint ClassSize(int sizeClass) => sizeClass switch
+    {
+        0 => 16,
+        1 => 24,
+        2 => 48,
+        3 => 64,
+        4 => 128,
+        5 => 256,
+        6 => 512,
+        _ => 0
+    };
+
+    /// <summary>
+    /// Magazine class for a block of <paramref name="aSize"/> bytes, or -1 when it bypasses the magazines.
+    /// </summary>
+    public static int ClassOf(uint aSize)
+    {
+        if (aSize == 0 || aSize > 512)
+        {
+            return -1;
+        }
+
+        if (aSize <= 16)
+        {
+            return 0;
+        }
+
+        if (aSize <= 24)
+        {
+            return 1;
+        }
+
+        if (aSize <= 48)
+        {
+            return 2;
+        }
+
+        if (aSize <= 64)
+        {
+            return 3;
+        }
+
+        return aSize <= 128 ? 4 : aSize <= 256 ? 5 : 6;
+    }
+
+    /// <summary>
+    /// Counters of one size class, summed over all CPUs.
+    /// </summary>
+    public static HeapMagazineStats GetStats(int sizeClass)
+    {
+        HeapMagazineStats stats = default;
+        if (sizeClass < 0 || sizeClass >= ClassCount)
+        {
+            return stats;
+        }
+
+        for (int cpu = 0; cpu < MaxCpus; cpu++)
+        {
+            Magazine* magazines = (Magazine*)s_cpus.Magazines[cpu];
+            if (magazines == null)
+            {
+                continue;
+            }
+
+            Magazine* magazine = &magazines[sizeClass];
+            stats.Hits += magazine->Hits;
+            stats.Misses += magazine->Misses;
+            stats.Refills += magazine->Refills;
+            stats.Drains += magazine->Drains;
+            stats.Cached += magazine->Count;
+        }
+
+        return stats;
+    }
+
+    /// <summary>
+    /// Allocate from the current CPU's magazine, refilling it if empty.
+    /// </summary>
+    /// <returns>The block, or null when <paramref name="aSize"/> has no magazine.</returns>
+    internal static byte* TryAlloc(uint aSize)
+    {
+        int sizeClass = ClassOf(aSize);
+        Magazine* magazine = sizeClass < 0 ? null : GetMagazine(sizeClass);
+        if (magazine == null)
+        {
+            return null;
+        }
+
+        if (magazine->Count == 0)
+        {
+            magazine->Misses++;
+            Refill(magazine, sizeClass);
+        }
+        else
+        {
+            magazine->Hits++;
+        }
+
+        byte* block = (byte*)magazine->Slots[--magazine->Count];
+        SmallHeap.GetHeader(block)->Size = (ushort)aSize;
+        return block;
+    }
+
+    /// <summary>
+    /// Park a small block in the current CPU's magazine, draining it first if full.
+    /// </summary>
+    /// <returns>false when the block's size has no magazine; the caller frees it to SmallHeap.</returns>
+    internal static bool TryFree(void* aPtr)
+    {
+        SmallHeapHeader* header = SmallHeap.GetHeader((byte*)aPtr);
+        ushort size = header->Size;
+        if (size == CachedMarker)
+        {
+            // double free, this block is already in a magazine
+            Debugger.DoSendNumber((uint)aPtr);
+            Debugger.SendKernelPanic(Panics.SmallHeap.DoubleFree);
+        }
+
+        int sizeClass = ClassOf(size);
+        Magazine* magazine = sizeClass < 0 ? null : GetMagazine(sizeClass);
+        if (magazine == null)
+        {
+            return false;
+        }
+
+        if (magazine->Count == Capacity)
+        {
+            Drain(magazine, sizeClass, Batch);
+        }
+
+        MemoryOp.MemSet((byte*)aPtr, 0, size);
+        header->Size = CachedMarker;
+        magazine->Slots[magazine->Count++] = (ulong)aPtr;
+        return true;
+    }
+
+    /// <summary>
+    /// Return every block cached by every CPU to SmallHeap. Only safe while no
+    /// other CPU can touch its magazines: <see cref="Heap.Collect"/> calls it with
+    /// the world stopped (today only the BSP runs managed code at all).
+    /// </summary>
+    internal static void FlushAllCpus()
+    {
+        for (int cpu = 0; cpu < MaxCpus; cpu++)
+        {
+            Magazine* magazines = (Magazine*)s_cpus.Magazines[cpu];
+            if (magazines == null)
+            {
+                continue;
+            }
+
+            for (int sizeClass = 0; sizeClass < ClassCount; sizeClass++)
+            {
+                Magazine* magazine = &magazines[sizeClass];
+                if (magazine->Count != 0)
+                {
+                    Drain(magazine, sizeClass, (int)magazine->Count);
+                }
+            }
+        }
+    }
+
+    private static Magazine* GetMagazine(int sizeClass)
+    {
+        uint cpu = SmpNative.CurrentCpu();
+        if (cpu >= MaxCpus)
+        {
+            return null;
+        }
+
+        Magazine* magazines = (Magazine*)s_cpus.Magazines[cpu];
+        if (magazines == null)
+        {
+            magazines = (Magazine*)PageAllocator.AllocPages(PageType.Unmanaged, 1, zero: true);
+            if (magazines == null)
+            {
+                return null;
+            }
+
+            s_cpus.Magazines[cpu] = (ulong)magazines;
+        }
+
+        return &magazines[sizeClass];
+    }
+
+    private static void Refill(Magazine* magazine, int sizeClass)
+    {
+        uint classSize = ClassSize(sizeClass);
+
+        Heap.SharedLock.Acquire();
+        for (int i = 0; i < Batch; i++)
+        {
+            byte* block = SmallHeap.Alloc(classSize);
+            SmallHeap.GetHeader(block)->Size = CachedMarker;
+            magazine->Slots[magazine->Count++] = (ulong)block;
+        }
+        Heap.SharedLock.Release();
+
+        magazine->Refills++;
+    }
+
+    private static void Drain(Magazine* magazine, int sizeClass, int count)
+    {
+        // SmallHeap.Free finds the SMT root from the header size and zeroes that
+        // many bytes, so give the slot its class size back first.
+        ushort classSize = (ushort)ClassSize(sizeClass);
+
+        Heap.SharedLock.Acquire();
+        for (int i = 0; i < count; i++)
+        {
+            byte* block = (byte*)magazine->Slots[--magazine->Count];
+            SmallHeap.GetHeader(block)->Size = classSize;
+            SmallHeap.Free(block);
+        }
+        Heap.SharedLock.Release();
+
+        magazine->Drains++;
+    }
+}
@@ -22,17 +22,14 @@ public static unsafe class LargeHeap
     public static byte* Realloc(byte* ptr, uint newSize)
     {
         LargeHeapHeader* header = (LargeHeapHeader*)(ptr - PrefixBytes);
-        if (header->Used > newSize)
+        if (header->Used >= newSize)
         {
             header->Size = newSize; // there is space
         }
         else
         {
             byte* newPtr = Alloc(newSize);
-            MemoryOp.MemCopy(newPtr, ptr, (int)header->Used);
-            // {!} Span
-            // Span<byte> span = new(ptr, (int)header->Size);
-            // span.CopyTo(new Span<byte>(newPtr, (int)newSize));
+            MemoryOp.MemCopy(newPtr, ptr, (int)header->Size);
             Free(ptr);
             return newPtr;
         }
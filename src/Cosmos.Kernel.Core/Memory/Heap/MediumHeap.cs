@@ -23,12 +23,12 @@ public static unsafe class MediumHeap
     public static byte* Realloc(byte* ptr, uint newSize)
     {
         MediumHeapHeader* header = (MediumHeapHeader*)(ptr - PrefixBytes);
-        // Note: MediumHeap doesn't have a 'Used' field, just 'Size'
-        // The 'Size' represents both allocated and usable space
-        // So we always need to allocate new memory if size changes
-        if (header->Size >= newSize)
+        // Note: MediumHeap doesn't have a 'Used' field, just 'Size'.
+        // Alloc always reserves at least one full page, so any size up to
+        // MaxSize fits the existing block.
+        if (newSize <= MaxSize)
         {
-            // Current allocation is already large enough
+            header->Size = (ushort)newSize;
             return ptr;
         }
         else
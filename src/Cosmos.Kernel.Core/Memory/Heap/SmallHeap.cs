@@ -108,6 +108,31 @@ public static unsafe class SmallHeap
 
     public static SmallHeapHeader* GetHeader(byte* ptr) => (SmallHeapHeader*)(ptr - PrefixBytes);
 
+    /// <summary>
+    /// Resize a block in place when the new size rounds to the same SMT slot size.
+    /// Bytes released by a shrink are zeroed, as Free would, so the slot stays clean.
+    /// </summary>
+    /// <param name="aPtr">Start of an allocated small heap block.</param>
+    /// <param name="newSize">New size, at most <see cref="MaxSize"/>.</param>
+    /// <returns>true if the block was resized, false if it has to move.</returns>
+    public static bool TryResize(byte* aPtr, uint newSize)
+    {
+        SmallHeapHeader* header = GetHeader(aPtr);
+        uint oldSize = header->Size;
+        if (GetRoundedSize(newSize) != GetRoundedSize(oldSize))
+        {
+            return false;
+        }
+
+        if (newSize < oldSize)
+        {
+            MemoryOp.MemSet(aPtr + newSize, 0, (int)(oldSize - newSize));
+        }
+
+        header->Size = (ushort)newSize;
+        return true;
+    }
+
     /// <summary>
     /// Gets the root block in the SMT for objects of this size
     /// </summary>
@@ -574,7 +599,6 @@ public static unsafe class SmallHeap
                 if (blockPtr->PagePtr == allocatedOnPage)
                 {
                     blockPtr->SpacesLeft++;
-                    InternalCpu.EnableInterrupts();
                     return;
                 }
 
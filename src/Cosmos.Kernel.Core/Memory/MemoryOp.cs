@@ -3,7 +3,10 @@ using Cosmos.Kernel.Core.Bridge;
 namespace Cosmos.Kernel.Core.Memory;
 
 /// <summary>
-/// Native SIMD imports live in Bridge/Import/SimdNative.cs.
+/// Byte copies, moves, fills and compares go straight to the native
+/// memcpy/memmove/memset/memcmp in Memory/MemoryCopy.s, the same routines the
+/// C objects and ILC-generated block copies use. Native SIMD imports live in
+/// Bridge/Import/SimdNative.cs.
 /// </summary>
 public static unsafe class MemoryOp
 {
@@ -12,8 +15,12 @@ public static unsafe class MemoryOp
 
     public static void* Alloc(uint size) => Heap.Heap.Alloc(size);
 
+    public static void* Realloc(void* ptr, uint size) => Heap.Heap.Realloc((byte*)ptr, size);
+
     public static void Free(void* ptr) => Heap.Heap.Free(ptr);
 
+    public static void Free(void* ptr, uint size) => Heap.Heap.Free(ptr, size);
+
 
     #region MemSet
 
@@ -24,20 +31,7 @@ public static unsafe class MemoryOp
             return;
         }
 
-        if (count >= 16)
-        {
-            // SIMD path - broadcast byte to 32-bit value for SIMD fill
-            uint fillValue = (uint)(value | (value << 8) | (value << 16) | (value << 24));
-            FillWithSimd(dest, fillValue, count);
-        }
-        else
-        {
-            // Scalar path for small fills
-            for (int i = 0; i < count; i++)
-            {
-                dest[i] = value;
-            }
-        }
+        SimdNative.MemSet(dest, value, (nuint)count);
     }
 
     public static void MemSet(uint* dest, uint value, int count)
@@ -100,78 +94,7 @@ public static unsafe class MemoryOp
             return;
         }
 
-        if (count >= 16)
-        {
-            // SIMD path
-            CopyWithSimd(dest, src, count);
-        }
-        else
-        {
-            // Scalar path for small copies
-            CopyScalar(dest, src, count);
-        }
-    }
-
-    private static void CopyScalar(byte* dest, byte* src, int count)
-    {
-        // Use 64-bit copies where possible for better performance
-        int i = 0;
-
-        // Copy 8 bytes at a time
-        while (i + 8 <= count)
-        {
-            *(ulong*)(dest + i) = *(ulong*)(src + i);
-            i += 8;
-        }
-
-        // Copy remaining bytes
-        while (i < count)
-        {
-            dest[i] = src[i];
-            i++;
-        }
-    }
-
-    private static void CopyWithSimd(byte* dest, byte* src, int count)
-    {
-        int offset = 0;
-
-        // Copy 128-byte blocks in a single native call: the stub loops internally,
-        // one P/Invoke per block would dominate large copies (e.g. framebuffer swaps).
-        int blockCount = count / 128;
-        if (blockCount > 0)
-        {
-            SimdNative.Copy128Blocks(dest, src, blockCount);
-            offset = blockCount * 128;
-        }
-
-        // Copy 64-byte chunk
-        if (count - offset >= 64)
-        {
-            SimdNative.Copy64(dest + offset, src + offset);
-            offset += 64;
-        }
-
-        // Copy 32-byte chunk
-        if (count - offset >= 32)
-        {
-            SimdNative.Copy32(dest + offset, src + offset);
-            offset += 32;
-        }
-
-        // Copy 16-byte chunk
-        if (count - offset >= 16)
-        {
-            SimdNative.Copy16(dest + offset, src + offset);
-            offset += 16;
-        }
-
-        // Copy remaining bytes using scalar
-        while (offset < count)
-        {
-            dest[offset] = src[offset];
-            offset++;
-        }
+        SimdNative.MemCopy(dest, src, (nuint)count);
     }
 
     public static void MemCopy(uint* dest, uint* src, int count)
@@ -212,59 +135,40 @@ public static unsafe class MemoryOp
     /// </summary>
     public static void MemMove(byte* dest, byte* src, int count)
     {
-        if (dest == src || count == 0)
+        if (dest == src || count <= 0)
         {
             return;
         }
 
-        // Check for overlap
-        if (dest < src || dest >= src + count)
-        {
-            // No overlap - safe to use forward copy (with SIMD)
-            MemCopy(dest, src, count);
-        }
-        else
-        {
-            // Overlap detected - use backward copy
-            CopyBackward(dest, src, count);
-        }
+        SimdNative.MemMove(dest, src, (nuint)count);
     }
 
-    private static void CopyBackward(byte* dest, byte* src, int count)
-    {
-        // Use 64-bit copies where possible for better performance
-        int i = count;
+    #endregion
 
-        // Copy 8 bytes at a time from the end
-        while (i >= 8)
-        {
-            i -= 8;
-            *(ulong*)(dest + i) = *(ulong*)(src + i);
-        }
+    #region MemCmp
 
-        // Copy remaining bytes
-        while (i > 0)
+    public static bool MemCmp(uint* dest, uint* src, int count)
+    {
+        if (count <= 0)
         {
-            i--;
-            dest[i] = src[i];
+            return true;
         }
-    }
-
-    #endregion
 
-    #region MemCmp
+        return SimdNative.MemCmp((byte*)dest, (byte*)src, (nuint)count * sizeof(uint)) == 0;
+    }
 
-    public static bool MemCmp(uint* dest, uint* src, int count)
+    /// <summary>
+    /// Compares <paramref name="count"/> bytes. Returns &lt;0, 0 or &gt;0 by the
+    /// first differing byte, like C memcmp.
+    /// </summary>
+    public static int MemCmp(byte* s1, byte* s2, int count)
     {
-        for (int i = 0; i < count; i++)
+        if (count <= 0)
         {
-            if (dest[i] != src[i])
-            {
-                return false;
-            }
+            return 0;
         }
 
-        return true;
+        return SimdNative.MemCmp(s1, s2, (nuint)count);
     }
 
     #endregion
@@ -0,0 +1,52 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+namespace Cosmos.Kernel.Core.Memory;
+
+/// <summary>
+/// Makes device memory reachable at its HHDM alias (phys + HHDM offset) for
+/// code below the HAL. The page-table work is architecture-specific
+/// (<c>DeviceMapper</c> in Core.X64 / Core.ARM64) and Core cannot reference
+/// it, so the HAL registers the platform's mapper at
+/// <c>PlatformHAL.Initialize</c>. Until then <see cref="EnsureMapped"/> only
+/// reports that nothing was mapped and callers rely on the boot-time HHDM.
+/// </summary>
+public static unsafe class MmioMapping
+{
+    /// <summary>Granularity of the platform mappers: one 2 MiB block per call.</summary>
+    public const ulong BlockSize = 0x200000;
+
+    private static delegate*<ulong, void> s_ensureBlock;
+
+    /// <summary>True once a platform mapper has been registered.</summary>
+    public static bool IsAvailable => s_ensureBlock != null;
+
+    /// <summary>
+    /// Registers the platform routine that maps the 2 MiB block containing
+    /// a physical address (no-op when already mapped).
+    /// </summary>
+    public static void Register(delegate*<ulong, void> ensureBlock)
+    {
+        s_ensureBlock = ensureBlock;
+    }
+
+    /// <summary>
+    /// Map every block overlapping [<paramref name="physBase"/>,
+    /// <paramref name="physBase"/> + <paramref name="length"/>). Returns false
+    /// when no mapper is registered yet.
+    /// </summary>
+    public static bool EnsureMapped(ulong physBase, ulong length)
+    {
+        if (s_ensureBlock == null)
+        {
+            return false;
+        }
+
+        ulong block = physBase & ~(BlockSize - 1);
+        ulong end = physBase + (length == 0 ? 1 : length);
+        for (; block < end; block += BlockSize)
+        {
+            s_ensureBlock(block);
+        }
+        return true;
+    }
+}
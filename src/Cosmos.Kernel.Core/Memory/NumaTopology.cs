@@ -0,0 +1,172 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using System.Runtime.InteropServices;
+using Cosmos.Kernel.Core.Bridge;
+
+namespace Cosmos.Kernel.Core.Memory;
+
+/// <summary>
+/// C# view of the NUMA layout acpi_early_init (acpi_wrapper.c in MultiArch)
+/// reads from the SRAT and SLIT. Node indices are dense (0 .. NodeCount - 1);
+/// distances use SLIT units, where 10 is local. Without an SRAT the machine
+/// is reported as a single node.
+/// Native import lives in Cosmos.Kernel.Core/Bridge/Import/AcpiNumaNative.cs.
+/// </summary>
+public static unsafe class NumaTopology
+{
+    /// <summary>
+    /// Capacity of the native node table (ACPI_NUMA_MAX_NODES).
+    /// </summary>
+    public const int MaxNodes = 16;
+
+    /// <summary>
+    /// Capacity of the native memory range table (ACPI_NUMA_MAX_RANGES).
+    /// </summary>
+    public const int MaxRanges = 64;
+
+    /// <summary>
+    /// SLIT distance of a node to itself.
+    /// </summary>
+    public const byte LocalDistance = 10;
+
+    /// <summary>
+    /// Mirrors the C struct acpi_numa_range_t from ACPI/acpi_wrapper.c.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct MemoryRange
+    {
+        public ulong Base;      // physical
+        public ulong Length;
+        public uint Node;
+        public uint Flags;      // SRAT memory affinity flags
+    }
+
+    /// <summary>
+    /// Mirrors the C struct acpi_numa_cpu_t from ACPI/acpi_wrapper.c.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct CpuAffinity
+    {
+        public uint Id;         // x64: APIC ID; ARM64: ACPI processor UID
+        public uint Node;
+    }
+
+    /// <summary>
+    /// Mirrors the C struct acpi_numa_info_t from ACPI/acpi_wrapper.c.
+    /// Must match the native layout exactly.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NumaInfo
+    {
+        public byte SratFound;
+        public byte SlitFound;
+        public ushort NodeCount;
+        public ushort RangeCount;
+        public ushort CpuCount;                         // SRAT CPU entries; see GetCpuNode
+        public fixed uint ProximityDomains[MaxNodes];
+        public fixed byte Ranges[MaxRanges * 24];       // MemoryRange[MaxRanges]; see GetRange
+        public fixed byte Distances[MaxNodes * MaxNodes];
+    }
+
+    private static NumaInfo* s_info;
+    private static bool s_queried;
+
+    private static CpuAffinity* s_cpus;
+    private static uint s_cpuCount;
+    private static bool s_cpusQueried;
+
+    /// <summary>
+    /// Gets the native NUMA info, or null if ACPI was not available at boot.
+    /// </summary>
+    public static NumaInfo* GetInfo()
+    {
+        if (!s_queried)
+        {
+            s_info = (NumaInfo*)AcpiNumaNative.GetNumaInfo();
+            s_queried = true;
+        }
+
+        return s_info;
+    }
+
+    /// <summary>
+    /// Number of NUMA nodes; 1 when the firmware has no SRAT.
+    /// </summary>
+    public static uint NodeCount
+    {
+        get
+        {
+            NumaInfo* info = GetInfo();
+            return info == null || info->NodeCount == 0 ? 1u : info->NodeCount;
+        }
+    }
+
+    /// <summary>
+    /// Number of SRAT memory affinity ranges.
+    /// </summary>
+    public static int RangeCount
+    {
+        get
+        {
+            NumaInfo* info = GetInfo();
+            return info == null ? 0 : info->RangeCount;
+        }
+    }
+
+    /// <summary>
+    /// Gets the <paramref name="i"/>-th SRAT memory range, or null if out of range.
+    /// </summary>
+    public static MemoryRange* GetRange(int i)
+    {
+        NumaInfo* info = GetInfo();
+        if (info == null || i < 0 || i >= info->RangeCount)
+        {
+            return null;
+        }
+
+        return (MemoryRange*)info->Ranges + i;
+    }
+
+    /// <summary>
+    /// SLIT distance from node <paramref name="from"/> to node <paramref name="to"/>.
+    /// </summary>
+    public static byte GetDistance(uint from, uint to)
+    {
+        NumaInfo* info = GetInfo();
+        if (info == null || from >= info->NodeCount || to >= info->NodeCount)
+        {
+            return from == to ? LocalDistance : (byte)(LocalDistance * 2);
+        }
+
+        return info->Distances[from * MaxNodes + to];
+    }
+
+    /// <summary>
+    /// Node of the CPU with hardware ID <paramref name="id"/> (APIC ID on x64,
+    /// ACPI processor UID on ARM64); 0 if the SRAT does not list it.
+    /// </summary>
+    /// <remarks>
+    /// The native side sizes the CPU table from the SRAT on the first call, on the
+    /// heap, so this must not run before the heap is up.
+    /// </remarks>
+    public static uint GetCpuNode(uint id)
+    {
+        if (!s_cpusQueried)
+        {
+            uint count;
+            s_cpus = (CpuAffinity*)AcpiNumaNative.GetNumaCpus(&count);
+            s_cpuCount = count;
+            s_cpusQueried = true;
+        }
+
+        for (uint i = 0; i < s_cpuCount; i++)
+        {
+            if (s_cpus[i].Id == id)
+            {
+                return s_cpus[i].Node;
+            }
+        }
+
+        return 0;
+    }
+}
@@ -1,6 +1,7 @@
 using Cosmos.Kernel.Boot.Limine;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Memory.Heap;
+using Cosmos.Kernel.Core.Scheduler;
 
 namespace Cosmos.Kernel.Core.Memory;
 
@@ -71,6 +72,39 @@ public static unsafe class PageAllocator
     /// </summary>
     public static ulong RamSize;
 
+    /// <summary>
+    /// Node argument for <see cref="AllocPages(PageType, ulong, bool, int)"/> that skips the NUMA preference.
+    /// </summary>
+    public const int AnyNode = -1;
+
+    /// <summary>Most contiguous same-node page spans tracked (one per SRAT range overlapping the heap).</summary>
+    private const int MaxNodeSpans = NumaTopology.MaxRanges;
+
+    /// <summary>Most NUMA nodes tracked; matches the native SRAT table.</summary>
+    private const int MaxNodes = NumaTopology.MaxNodes;
+
+    /// <summary>
+    /// Which RAT pages belong to which NUMA node, plus each node's fallback
+    /// order by SLIT distance. Fixed-size because it is built in
+    /// <see cref="InitializeHeap"/>, before the managed heap exists.
+    /// </summary>
+    private struct NodeLayout
+    {
+        public int SpanCount;
+        public int NodeCount;
+        public fixed ulong SpanFirst[MaxNodeSpans];     // first RAT index of the span
+        public fixed ulong SpanEnd[MaxNodeSpans];       // one past the last RAT index
+        public fixed byte SpanNode[MaxNodeSpans];
+        public fixed byte Fallback[MaxNodes * MaxNodes]; // row n: nodes nearest to n first, n itself leading
+    }
+
+    private static NodeLayout s_nodes;
+
+    /// <summary>
+    /// True when the heap spans more than one NUMA node and allocations are steered.
+    /// </summary>
+    public static bool IsNumaAware => s_nodes.SpanCount > 0;
+
     /// <summary>
     /// Convert virtual address to physical address for Higher Half Kernel mapping.
     /// Subtracts the Limine HHDM offset when the address is an HHDM alias;
@@ -515,19 +549,173 @@ public static unsafe class PageAllocator
         mRAT[0] = testValue; // Restore
         Serial.WriteString("[PageAllocator] RAT write test passed\n");
 
+        InitializeNodes(ratStartPage);
+
         // Initialize small heap
         Serial.WriteString("[PageAllocator] Initializing SmallHeap...\n");
         SmallHeap.Init();
     }
 
     /// <summary>
-    /// Alloc a given number of pages, all of the same type.
+    /// Maps the SRAT memory ranges onto RAT page indices and orders, for every
+    /// node, the other nodes by SLIT distance. Leaves the allocator flat when
+    /// the heap region lies within a single node.
+    /// </summary>
+    /// <param name="pageLimit">First RAT index past the allocatable pages.</param>
+    private static void InitializeNodes(ulong pageLimit)
+    {
+        s_nodes.SpanCount = 0;
+        s_nodes.NodeCount = 0;
+
+        uint nodeCount = NumaTopology.NodeCount;
+        if (nodeCount <= 1)
+        {
+            return;
+        }
+
+        ulong physStart = VirtualToPhysical((ulong)RamStart);
+        ulong physEnd = physStart + pageLimit * PageSize;
+        int spans = 0;
+        uint firstNode = uint.MaxValue;
+        bool multiNode = false;
+
+        for (int i = 0; i < NumaTopology.RangeCount && spans < MaxNodeSpans; i++)
+        {
+            NumaTopology.MemoryRange* range = NumaTopology.GetRange(i);
+            ulong start = range->Base > physStart ? range->Base : physStart;
+            ulong end = range->Base + range->Length < physEnd ? range->Base + range->Length : physEnd;
+            if (start >= end || range->Node >= MaxNodes)
+            {
+                continue;
+            }
+
+            ulong first = (start - physStart + PageSize - 1) / PageSize;
+            ulong last = (end - physStart) / PageSize;
+            if (first >= last)
+            {
+                continue;
+            }
+
+            s_nodes.SpanFirst[spans] = first;
+            s_nodes.SpanEnd[spans] = last;
+            s_nodes.SpanNode[spans] = (byte)range->Node;
+            spans++;
+
+            if (firstNode == uint.MaxValue)
+            {
+                firstNode = range->Node;
+            }
+            else if (range->Node != firstNode)
+            {
+                multiNode = true;
+            }
+        }
+
+        if (!multiNode)
+        {
+            Serial.WriteString("[PageAllocator] Heap lies within one NUMA node, allocation stays flat\n");
+            return;
+        }
+
+        // Fallback row for node n: all nodes sorted by distance from n, which puts
+        // n itself (distance 10) first.
+        for (uint n = 0; n < nodeCount; n++)
+        {
+            uint row = n * MaxNodes;
+            for (uint m = 0; m < nodeCount; m++)
+            {
+                s_nodes.Fallback[row + m] = (byte)m;
+            }
+
+            for (uint a = 0; a + 1 < nodeCount; a++)
+            {
+                uint best = a;
+                for (uint b = a + 1; b < nodeCount; b++)
+                {
+                    if (NumaTopology.GetDistance(n, s_nodes.Fallback[row + b]) <
+                        NumaTopology.GetDistance(n, s_nodes.Fallback[row + best]))
+                    {
+                        best = b;
+                    }
+                }
+
+                byte nearest = s_nodes.Fallback[row + best];
+                s_nodes.Fallback[row + best] = s_nodes.Fallback[row + a];
+                s_nodes.Fallback[row + a] = nearest;
+            }
+        }
+
+        s_nodes.NodeCount = (int)nodeCount;
+        s_nodes.SpanCount = spans;
+
+        Serial.WriteString("[PageAllocator] NUMA: ");
+        Serial.WriteNumber(nodeCount);
+        Serial.WriteString(" node(s), ");
+        Serial.WriteNumber((ulong)spans);
+        Serial.WriteString(" heap span(s)\n");
+    }
+
+    /// <summary>
+    /// NUMA node of the calling CPU, or <see cref="AnyNode"/> when allocations
+    /// are not steered (single node, or the scheduler has not placed CPUs yet).
+    /// </summary>
+    public static int CurrentNode
+    {
+        get
+        {
+            if (s_nodes.SpanCount == 0 || !SchedulerManager.IsReady)
+            {
+                return AnyNode;
+            }
+
+            PerCpuState? state = SchedulerManager.GetCpuState(SchedulerManager.GetCurrentCpuId());
+            return state == null ? AnyNode : (int)state.NodeId;
+        }
+    }
+
+    /// <summary>
+    /// NUMA node backing the page that contains <paramref name="aPtr"/>, or
+    /// <see cref="AnyNode"/> when unknown (flat allocator, or outside every SRAT range).
+    /// </summary>
+    public static int GetPageNode(void* aPtr)
+    {
+        if (s_nodes.SpanCount == 0 || aPtr < RamStart || aPtr >= HeapEnd)
+        {
+            return AnyNode;
+        }
+
+        ulong index = (ulong)((byte*)aPtr - RamStart) / PageSize;
+        for (int i = 0; i < s_nodes.SpanCount; i++)
+        {
+            if (index >= s_nodes.SpanFirst[i] && index < s_nodes.SpanEnd[i])
+            {
+                return s_nodes.SpanNode[i];
+            }
+        }
+
+        return AnyNode;
+    }
+
+    /// <summary>
+    /// Alloc a given number of pages, all of the same type, preferring the calling CPU's NUMA node.
     /// </summary>
     /// <param name="aType">A type of pages to alloc.</param>
     /// <param name="aPageCount">Number of pages to alloc. (default = 1)</param>
     /// <param name="zero"></param>
     /// <returns>A pointer to the first page on success, null on failure.</returns>
-    public static void* AllocPages(PageType aType, ulong aPageCount = 1, bool zero = false)
+    public static void* AllocPages(PageType aType, ulong aPageCount = 1, bool zero = false) =>
+        AllocPages(aType, aPageCount, zero, CurrentNode);
+
+    /// <summary>
+    /// Alloc a given number of pages, all of the same type, from <paramref name="preferredNode"/>
+    /// if it has room, then from the other nodes in SLIT distance order, then from anywhere.
+    /// </summary>
+    /// <param name="aType">A type of pages to alloc.</param>
+    /// <param name="aPageCount">Number of pages to alloc.</param>
+    /// <param name="zero"></param>
+    /// <param name="preferredNode">NUMA node to allocate from, or <see cref="AnyNode"/>.</param>
+    /// <returns>A pointer to the first page on success, null on failure.</returns>
+    public static void* AllocPages(PageType aType, ulong aPageCount, bool zero, int preferredNode)
     {
         Serial.WriteString("[PageAllocator] AllocPages - Type: ");
         Serial.WriteNumber((uint)aType);
@@ -537,35 +725,163 @@ public static unsafe class PageAllocator
         Serial.WriteNumber(FreePageCount);
         Serial.WriteString("\n");
 
-        byte* startPage = null;
+        if (aPageCount == 0 || aPageCount > FreePageCount)
+        {
+            return null;
+        }
+
+        ulong offset = ulong.MaxValue;
+        if (preferredNode >= 0 && preferredNode < s_nodes.NodeCount)
+        {
+            offset = FindPagesNear((uint)preferredNode, aPageCount);
+        }
+
+        if (offset == ulong.MaxValue)
+        {
+            offset = FindPages(0, TotalPageCount, aPageCount);
+        }
+
+        // If we found enough space, mark it as used.
+        if (offset == ulong.MaxValue)
+        {
+            return null;
+        }
+
+        return ClaimPages(offset, aType, aPageCount, zero);
+    }
+
+    /// <summary>
+    /// Alloc a given number of pages, all of the same type, from <paramref name="node"/>
+    /// only. Unlike <see cref="AllocPages(PageType, ulong, bool, int)"/> this never falls
+    /// back to another node, so callers that would rather reuse memory they already
+    /// hold than take remote pages can ask without allocating and freeing.
+    /// </summary>
+    /// <param name="aType">A type of pages to alloc.</param>
+    /// <param name="aPageCount">Number of pages to alloc.</param>
+    /// <param name="zero"></param>
+    /// <param name="node">NUMA node to allocate from.</param>
+    /// <returns>A pointer to the first page on success, null when the node has no room.</returns>
+    public static void* AllocPagesOnNode(PageType aType, ulong aPageCount, bool zero, int node)
+    {
+        if (aPageCount == 0 || aPageCount > FreePageCount || node < 0 || node >= s_nodes.NodeCount)
+        {
+            return null;
+        }
+
+        for (int i = 0; i < s_nodes.SpanCount; i++)
+        {
+            if (s_nodes.SpanNode[i] != node)
+            {
+                continue;
+            }
+
+            ulong offset = FindPages(s_nodes.SpanFirst[i], s_nodes.SpanEnd[i], aPageCount);
+            if (offset != ulong.MaxValue)
+            {
+                return ClaimPages(offset, aType, aPageCount, zero);
+            }
+        }
+
+        return null;
+    }
+
+    /// <summary>
+    /// Marks the free run at RAT index <paramref name="offset"/> as used and optionally zeroes it.
+    /// </summary>
+    private static void* ClaimPages(ulong offset, PageType aType, ulong aPageCount, bool zero)
+    {
+        byte* pageAddress = RamStart + offset * PageSize;
+
+        mRAT[offset] = (byte)aType;
+
+        for (ulong i = 1; i < aPageCount; i++)
+        {
+            mRAT[offset + i] = (byte)PageType.Extension;
+        }
+
+        if (zero)
+        {
+            ulong* ptr = (ulong*)pageAddress;
+            ulong count = (PageSize * aPageCount) / sizeof(ulong);
+            for (ulong i = 0; i < count; i++)
+            {
+                ptr[i] = 0;
+            }
+        }
+
+        FreePageCount -= aPageCount;
+
+        return pageAddress;
+    }
+
+    /// <summary>
+    /// Searches the spans of <paramref name="node"/>, then of the other nodes
+    /// nearest first, for <paramref name="aPageCount"/> free pages.
+    /// </summary>
+    /// <returns>First RAT index of the run, or <see cref="ulong.MaxValue"/>.</returns>
+    private static ulong FindPagesNear(uint node, ulong aPageCount)
+    {
+        for (int k = 0; k < s_nodes.NodeCount; k++)
+        {
+            byte candidate = s_nodes.Fallback[node * MaxNodes + k];
+            for (int i = 0; i < s_nodes.SpanCount; i++)
+            {
+                if (s_nodes.SpanNode[i] != candidate)
+                {
+                    continue;
+                }
 
+                ulong offset = FindPages(s_nodes.SpanFirst[i], s_nodes.SpanEnd[i], aPageCount);
+                if (offset != ulong.MaxValue)
+                {
+                    return offset;
+                }
+            }
+        }
+
+        return ulong.MaxValue;
+    }
+
+    /// <summary>
+    /// Finds <paramref name="aPageCount"/> contiguous free pages between RAT
+    /// indices <paramref name="first"/> and <paramref name="end"/> (exclusive).
+    /// </summary>
+    /// <returns>First RAT index of the run, or <see cref="ulong.MaxValue"/>.</returns>
+    private static ulong FindPages(ulong first, ulong end, ulong aPageCount)
+    {
         // Could combine with an external method or delegate, but will slow things down
         // unless we can force it to be inlined.
         // Alloc single blocks at bottom, larger blocks at top to help reduce fragmentation.
-        uint xCount = 0;
+        if (end > TotalPageCount)
+        {
+            end = TotalPageCount;
+        }
+
+        if (first >= end || end - first < aPageCount)
+        {
+            return ulong.MaxValue;
+        }
+
         if (aPageCount == 1)
         {
-            for (byte* ptr = mRAT; ptr < mRAT + TotalPageCount; ptr++)
+            for (byte* ptr = mRAT + first; ptr < mRAT + end; ptr++)
             {
                 if ((PageType)(*ptr) == PageType.Empty)
                 {
-                    startPage = ptr;
-                    break;
+                    return (ulong)(ptr - mRAT);
                 }
             }
         }
         else
         {
-            // This loop will FAIL if mRAT is ever 0. This should be impossible though
-            // so we don't bother to account for such a case. xPos would also have issues.
-            for (byte* ptr = mRAT + TotalPageCount - 1; ptr >= mRAT; ptr--)
+            ulong xCount = 0;
+            for (byte* ptr = mRAT + end - 1; ptr >= mRAT + first; ptr--)
             {
                 if (*ptr == (byte)PageType.Empty)
                 {
                     if (++xCount == aPageCount)
                     {
-                        startPage = ptr;
-                        break;
+                        return (ulong)(ptr - mRAT);
                     }
                 }
                 else
@@ -575,40 +891,7 @@ public static unsafe class PageAllocator
             }
         }
 
-        // If we found enough space, mark it as used.
-        if (startPage != null)
-        {
-            long offset = startPage - mRAT;
-            byte* pageAddress = RamStart + (ulong)offset * PageSize;
-
-            if ((ulong)offset >= TotalPageCount)
-            {
-                return null;
-            }
-
-            mRAT[offset] = (byte)aType;
-
-            for (ulong i = 1; i < aPageCount; i++)
-            {
-                mRAT[(ulong)offset + i] = (byte)PageType.Extension;
-            }
-
-            if (zero)
-            {
-                ulong* ptr = (ulong*)pageAddress;
-                ulong count = (PageSize * aPageCount) / sizeof(ulong);
-                for (ulong i = 0; i < count; i++)
-                {
-                    ptr[i] = 0;
-                }
-            }
-
-            FreePageCount -= aPageCount;
-
-            return pageAddress;
-        }
-
-        return null;
+        return ulong.MaxValue;
     }
 
     /// <summary>
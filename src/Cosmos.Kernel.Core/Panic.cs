@@ -18,6 +18,7 @@ public static class Panic
     public static void Halt(string message)
     {
         InternalCpu.DisableInterrupts();
+        NativeLog.Flush();
 
         Serial.WriteString("\n");
         Serial.WriteString("========================================\n");
@@ -46,6 +47,7 @@ public static class Panic
         [System.Runtime.CompilerServices.CallerLineNumber] int line = 0)
     {
         InternalCpu.DisableInterrupts();
+        NativeLog.Flush();
 
         Serial.WriteString("\n");
         Serial.WriteString("========================================\n");
@@ -20,4 +20,12 @@ public interface IPowerOps
     /// </summary>
     [DoesNotReturn]
     void Shutdown();
+
+    /// <summary>
+    /// Front-load the firmware work <see cref="Reboot"/> / <see cref="Shutdown"/>
+    /// would otherwise do on the way down (building the ACPI AML namespace
+    /// on x64). Safe to call from a background thread; no-op where nothing
+    /// needs preparing.
+    /// </summary>
+    void Prepare();
 }
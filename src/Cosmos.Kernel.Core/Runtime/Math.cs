@@ -14,9 +14,12 @@
 //   x64 uses x87 FPU assembly in Cosmos.Kernel.Native.X64/Runtime/Runtime.s.
 // Derived functions (asin, acos, atan2, pow, log2, log10): shared C# on both arches,
 //   ported from fdlibm via Cosmos Gen2 (Cosmos/source/Cosmos.System2_Plugs/System/MathImpl.cs).
+// Rounding and square root (floor, ceil, trunc, round, sqrt): native C in
+//   Cosmos.Kernel.Native.MultiArch/C/math.c (roundsd/frint*, sqrtsd/fsqrt).
 
 using System.Runtime;
 using System.Runtime.CompilerServices;
+using SysMath = global::System.Math;
 
 namespace Cosmos.Kernel.Core.Runtime;
 
@@ -102,106 +105,6 @@ internal static class Math
     // Unconditional functions (both arches use C#)
     // =========================================================================
 
-    [RuntimeExport("ceil")]
-    internal static double ceil(double x)
-    {
-        if (x == (long)x)
-        {
-            return x;
-        }
-
-        if (double.IsNaN(x))
-        {
-            return double.NaN;
-        }
-
-        if (double.IsPositiveInfinity(x))
-        {
-            return double.PositiveInfinity;
-        }
-
-        if (double.IsNegativeInfinity(x))
-        {
-            return double.NegativeInfinity;
-        }
-
-        if (x > 0)
-        {
-            return (long)x + 1;
-        }
-
-        return (long)x;
-    }
-
-    [RuntimeExport("ceilf")]
-    internal static float ceilf(float x)
-    {
-        return (float)ceil(x);
-    }
-
-    [RuntimeExport("sqrt")]
-    internal static double sqrt(double x)
-    {
-        if (double.IsNaN(x) || x < 0)
-        {
-            return double.NaN;
-        }
-
-        if (double.IsPositiveInfinity(x))
-        {
-            return double.PositiveInfinity;
-        }
-
-        if (x == 0)
-        {
-            return 0;
-        }
-
-        double guess = x;
-        double epsilon = 1e-10;
-
-        for (int i = 0; i < 50; i++)
-        {
-            double nextGuess = (guess + x / guess) / 2.0;
-            if (Abs(nextGuess - guess) < epsilon)
-            {
-                break;
-            }
-
-            guess = nextGuess;
-        }
-
-        return guess;
-    }
-
-    [RuntimeExport("sqrtf")]
-    internal static float sqrtf(float x)
-    {
-        return (float)sqrt(x);
-    }
-
-    [RuntimeExport("trunc")]
-    internal static double trunc(double x)
-    {
-        if (double.IsNaN(x))
-        {
-            return double.NaN;
-        }
-
-        if (double.IsInfinity(x))
-        {
-            return x;
-        }
-
-        return (long)x;
-    }
-
-    [RuntimeExport("truncf")]
-    internal static float truncf(float x)
-    {
-        return (float)trunc(x);
-    }
-
     [RuntimeExport("modf")]
     internal static unsafe double ModF(double x, double* intptr)
     {
@@ -1107,7 +1010,7 @@ internal static class Math
         t = w * 0.5;
         p = t * (pS0 + t * (pS1 + t * (pS2 + t * (pS3 + t * (pS4 + t * pS5)))));
         q = 1 + t * (qS1 + t * (qS2 + t * (qS3 + t * qS4)));
-        s = sqrt(t);
+        s = SysMath.Sqrt(t);
 
         if (ix >= 0x3FEF3333)
         {
@@ -1175,7 +1078,7 @@ internal static class Math
             z = (1 + x) * 0.5;
             p = z * (pS0 + z * (pS1 + z * (pS2 + z * (pS3 + z * (pS4 + z * pS5)))));
             q = 1 + z * (qS1 + z * (qS2 + z * (qS3 + z * qS4)));
-            s = sqrt(z);
+            s = SysMath.Sqrt(z);
             r = p / q;
             w = r * s - PI_OVER_2_LO;
             return PI - 2.0 * (s + w);
@@ -1183,7 +1086,7 @@ internal static class Math
         else
         {
             z = (1 - x) * 0.5;
-            s = sqrt(z);
+            s = SysMath.Sqrt(z);
             df = s;
             df = SetLowWord(df, 0);
             c = (z - df * df) / (s + df);
@@ -1260,7 +1163,7 @@ internal static class Math
         }
 
         /* Integer exponent fast path — exact results for small n */
-        if (y == trunc(y) && y >= -64 && y <= 64)
+        if (y == SysMath.Truncate(y) && y >= -64 && y <= 64)
         {
             double absX = x < 0 ? -x : x;
             long n = (long)y;
@@ -1299,7 +1202,7 @@ internal static class Math
 
         if (x < 0)
         {
-            if (y != trunc(y))
+            if (y != SysMath.Truncate(y))
             {
                 return double.NaN;
             }
@@ -124,18 +124,6 @@ public static unsafe class Memory
         MemoryOp.MemCopy(dest, src, (int)len);
     }
 
-    [RuntimeExport("memmove")]
-    internal static unsafe void memmove(byte* dest, byte* src, UIntPtr len)
-    {
-        MemoryOp.MemMove(dest, src, (int)len);
-    }
-
-    [RuntimeExport("memset")]
-    internal static unsafe void memset(byte* dest, int value, UIntPtr len)
-    {
-        MemoryOp.MemSet(dest, (byte)value, (int)len);
-    }
-
     [RuntimeExport("RhNewString")]
     internal static unsafe void* RhNewString(MethodTable* pEEType, int length)
     {
@@ -0,0 +1,329 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using System.Runtime.CompilerServices;
+using Cosmos.Kernel.Core.CPU;
+using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.Core.Scheduler;
+
+namespace Cosmos.Kernel.Core.Runtime;
+
+/// <summary>
+/// Timer-driven sampling profiler. While running, every timer tick records the
+/// interrupted IP plus up to <see cref="MaxDepth"/> - 1 return addresses from the
+/// frame-pointer chain into a per-CPU ring. Only the owning CPU writes its ring
+/// (from its timer interrupt), so recording takes no lock. <see cref="Dump"/>
+/// streams all rings to serial for <c>cosmos profile</c> on the host, which
+/// symbolizes them against the kernel ELF.
+///
+/// Opt-in: compiled out unless <see cref="CosmosFeatures.ProfilerEnabled"/>
+/// (CosmosEnableProfiler) is set, and idle until <see cref="Start"/>.
+///
+/// Stream layout (little-endian), preceded by a "[PROFILER]" text line:
+///   0:  u32 magic = 0xC05D0F01
+///   4:  u16 version = 2
+///   6:  u16 arch             (1 = x64, 2 = arm64)
+///   8:  u64 address base     (subtracted from every frame below)
+///  16:  u32 sample count
+///  20:  u32 dropped samples  (rings were full)
+///  24:  samples[count] of { u8 cpu, u8 depth, uleb128 thread id, zigzag uleb128 frame[depth] }
+///       u32 trailer = 0xC05D0FFF
+/// frame[0] is the interrupted IP, frame[depth - 1] the outermost caller. Frames
+/// are signed offsets from the base, zigzag-encoded ((d &lt;&lt; 1) ^ (d &gt;&gt; 63)), so an
+/// IP below the kernel image is sent as a small negative offset rather than a
+/// wrapped 64-bit delta.
+/// </summary>
+public static unsafe class SamplingProfiler
+{
+    /// <summary>CPUs with a sample ring; CPUs past it are not sampled.</summary>
+    public const int MaxCpus = 32;
+
+    /// <summary>Frames recorded per sample, the interrupted IP included.</summary>
+    public const int MaxDepth = 15;
+
+    /// <summary>Samples a CPU buffers between dumps; later ticks are counted as dropped.</summary>
+    public const int SlotsPerCpu = 2048;
+
+    private const uint StreamMagic = 0xC05D0F01u;
+    private const uint StreamTrailer = 0xC05D0FFFu;
+    private const ushort StreamVersion = 2;
+    private const ushort ArchX64 = 1;
+    private const ushort ArchArm64 = 2;
+
+    // Slot: one header word (depth | thread id << 32), then the frames.
+    private const int SlotWords = MaxDepth + 1;
+    private const ulong RingBytes = 32 + (ulong)SlotsPerCpu * SlotWords * sizeof(ulong);
+
+    private struct Ring
+    {
+        public ulong Head;      // written by the owning CPU's timer interrupt
+        public ulong Tail;      // written by Dump
+        public ulong Dropped;
+        public ulong Reserved;
+    }
+
+    private struct RingTable
+    {
+        public fixed ulong Rings[MaxCpus];
+    }
+
+    private static RingTable s_rings;
+    private static volatile bool s_running;
+
+    /// <summary>
+    /// Whether timer ticks are currently being sampled.
+    /// </summary>
+    public static bool IsRunning => s_running;
+
+    /// <summary>
+    /// Allocates the sample rings (first call only) and starts sampling on every CPU.
+    /// </summary>
+    /// <returns>false when the profiler is compiled out or the rings could not be allocated.</returns>
+    public static bool Start()
+    {
+        if (!CosmosFeatures.ProfilerEnabled)
+        {
+            return false;
+        }
+
+        uint cpus = SchedulerManager.CpuCount;
+        if (cpus == 0)
+        {
+            cpus = 1;
+        }
+        else if (cpus > MaxCpus)
+        {
+            cpus = MaxCpus;
+        }
+
+        ulong pages = (RingBytes + PageAllocator.PageSize - 1) / PageAllocator.PageSize;
+        for (uint cpu = 0; cpu < cpus; cpu++)
+        {
+            if (s_rings.Rings[cpu] != 0)
+            {
+                continue;
+            }
+
+            void* ring = PageAllocator.AllocPages(PageType.Unmanaged, pages, zero: true);
+            if (ring == null)
+            {
+                Serial.WriteString("[PROFILER] ERROR: cannot allocate sample ring\n");
+                return false;
+            }
+
+            s_rings.Rings[cpu] = (ulong)ring;
+        }
+
+        s_running = true;
+        Serial.WriteString("[PROFILER] Sampling started\n");
+        return true;
+    }
+
+    /// <summary>
+    /// Stops sampling. Buffered samples are kept for <see cref="Dump"/>.
+    /// </summary>
+    public static void Stop()
+    {
+        s_running = false;
+    }
+
+    /// <summary>
+    /// Records one sample for <paramref name="cpuId"/>. Called from the timer
+    /// interrupt handler with the interrupted context; allocation-free.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static void Sample(uint cpuId, ref IRQContext context)
+    {
+        if (!CosmosFeatures.ProfilerEnabled || !s_running || cpuId >= MaxCpus)
+        {
+            return;
+        }
+
+        Ring* ring = (Ring*)s_rings.Rings[cpuId];
+        if (ring != null)
+        {
+            Record(ring, cpuId, ref context);
+        }
+    }
+
+    /// <summary>
+    /// Streams every buffered sample to serial and empties the rings. Sampling is
+    /// paused for the duration so the stream (slow at 115200 baud) does not profile itself.
+    /// The whole stream is written with interrupts disabled: the timer interrupt and
+    /// other threads also write to COM1, and a text line landing inside the binary
+    /// stream corrupts it for the host reader. A full set of rings takes a few
+    /// seconds at 115200 baud, during which this CPU takes no interrupts.
+    /// </summary>
+    public static void Dump()
+    {
+        if (!CosmosFeatures.ProfilerEnabled)
+        {
+            return;
+        }
+
+        using (InternalCpu.DisableInterruptsScope())
+        {
+            DumpRings();
+        }
+    }
+
+    private static void DumpRings()
+    {
+        bool wasRunning = s_running;
+        s_running = false;
+
+        ulong* heads = stackalloc ulong[MaxCpus];
+        ulong total = 0;
+        ulong dropped = 0;
+        for (int cpu = 0; cpu < MaxCpus; cpu++)
+        {
+            Ring* ring = (Ring*)s_rings.Rings[cpu];
+            heads[cpu] = ring != null ? Volatile.Read(ref ring->Head) : 0;
+            if (ring != null)
+            {
+                total += heads[cpu] - ring->Tail;
+                dropped += ring->Dropped;
+            }
+        }
+
+        Serial.WriteString("[PROFILER] Streaming ");
+        Serial.WriteNumber(total);
+        Serial.WriteString(" samples\n");
+
+        WriteUInt32(StreamMagic);
+        WriteUInt16(StreamVersion);
+#if ARCH_ARM64
+        WriteUInt16(ArchArm64);
+#else
+        WriteUInt16(ArchX64);
+#endif
+        WriteUInt64(AddressSpace.KernelImageWindow);
+        WriteUInt32((uint)total);
+        WriteUInt32((uint)dropped);
+
+        for (int cpu = 0; cpu < MaxCpus; cpu++)
+        {
+            Ring* ring = (Ring*)s_rings.Rings[cpu];
+            if (ring == null)
+            {
+                continue;
+            }
+
+            ulong* slots = (ulong*)(ring + 1);
+            for (ulong index = ring->Tail; index < heads[cpu]; index++)
+            {
+                ulong* slot = slots + (index % SlotsPerCpu) * SlotWords;
+                int depth = (int)(slot[0] & 0xFF);
+
+                Serial.ComWrite((byte)cpu);
+                Serial.ComWrite((byte)depth);
+                WriteVarint(slot[0] >> 32);
+                for (int i = 1; i <= depth; i++)
+                {
+                    long offset = (long)(slot[i] - AddressSpace.KernelImageWindow);
+                    WriteVarint((ulong)((offset << 1) ^ (offset >> 63)));
+                }
+            }
+
+            Volatile.Write(ref ring->Tail, heads[cpu]);
+            ring->Dropped = 0;
+        }
+
+        WriteUInt32(StreamTrailer);
+        Serial.WriteString("\n[PROFILER] Stream end\n");
+
+        s_running = wasRunning;
+    }
+
+    private static void Record(Ring* ring, uint cpuId, ref IRQContext context)
+    {
+        ulong head = ring->Head;
+        if (head - Volatile.Read(ref ring->Tail) >= SlotsPerCpu)
+        {
+            ring->Dropped++;
+            return;
+        }
+
+#if ARCH_ARM64
+        ulong ip = context.elr;
+        ulong sp = context.sp;
+        ulong fp = context.x29;
+#else
+        ulong ip = context.rip;
+        ulong sp = context.rsp;
+        ulong fp = context.rbp;
+#endif
+
+        ulong* slot = (ulong*)(ring + 1) + (head % SlotsPerCpu) * SlotWords;
+        slot[1] = ip;
+        int depth = 1;
+
+        // Walk the frame-pointer chain ([fp] = caller fp, [fp+8] = return address on
+        // both SysV x64 and AAPCS64) only when the interrupted SP is on the current
+        // thread's own stack: that bounds every read, so a frameless function that
+        // uses rbp as a scratch register can at worst cut the stack short, never fault.
+        uint threadId = 0;
+        Scheduler.Thread? thread = cpuId < SchedulerManager.CpuCount
+            ? SchedulerManager.GetCpuState(cpuId)?.CurrentThread
+            : null;
+        if (thread != null)
+        {
+            threadId = thread.Id;
+            ulong stackLow = thread.StackBase;
+            ulong stackHigh = stackLow + thread.StackSize;
+            if (stackLow != 0 && sp >= stackLow && sp < stackHigh)
+            {
+                while (depth < MaxDepth && fp >= sp && fp + 2 * sizeof(ulong) <= stackHigh && (fp & 7) == 0)
+                {
+                    ulong ret = *((ulong*)fp + 1);
+                    if (ret < AddressSpace.KernelImageWindow)
+                    {
+                        break;
+                    }
+
+                    slot[1 + depth++] = ret;
+
+                    ulong next = *(ulong*)fp;
+                    if (next <= fp)
+                    {
+                        break;
+                    }
+
+                    fp = next;
+                }
+            }
+        }
+
+        slot[0] = (ulong)depth | ((ulong)threadId << 32);
+        Volatile.Write(ref ring->Head, head + 1);
+    }
+
+    private static void WriteVarint(ulong value)
+    {
+        while (value >= 0x80)
+        {
+            Serial.ComWrite((byte)(value | 0x80));
+            value >>= 7;
+        }
+
+        Serial.ComWrite((byte)value);
+    }
+
+    private static void WriteUInt16(ushort value)
+    {
+        Serial.ComWrite((byte)value);
+        Serial.ComWrite((byte)(value >> 8));
+    }
+
+    private static void WriteUInt32(uint value)
+    {
+        WriteUInt16((ushort)value);
+        WriteUInt16((ushort)(value >> 16));
+    }
+
+    private static void WriteUInt64(ulong value)
+    {
+        WriteUInt32((uint)value);
+        WriteUInt32((uint)(value >> 32));
+    }
+}
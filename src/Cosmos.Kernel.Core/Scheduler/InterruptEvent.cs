@@ -184,8 +184,8 @@ public class InterruptEvent
     }
 
     // ReferenceEquals scan on purpose: List<T>.Remove routes through
-    // EqualityComparer<T>.Default, which this runtime's scheduler avoids
-    // (see StrideScheduler.RemoveThreadFromQueue). Caller holds the lock.
+    // EqualityComparer<T>.Default, which this runtime's scheduler avoids.
+    // Caller holds the lock.
     private void RemoveWaiterLocked(SchedThread thread)
     {
         for (int i = 0; i < _waiters.Count; i++)
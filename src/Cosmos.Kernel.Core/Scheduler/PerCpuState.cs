@@ -8,6 +8,14 @@ public class PerCpuState : SchedulerExtensible
     // ===== Identity =====
     public uint CpuId { get; set; }
 
+    // ===== Topology =====
+    // Set by SchedulerManager.SetCpuTopology from the platform (MADT on x64,
+    // SRAT for the NUMA node; PageAllocator prefers pages from NodeId).
+    public uint NodeId { get; internal set; }
+    public uint PackageId { get; internal set; }
+    public uint CoreId { get; internal set; }
+    public uint ThreadId { get; internal set; }
+
     // ===== Current Execution =====
     public Thread? CurrentThread { get; internal set; }
     public Thread? IdleThread { get; internal set; }
@@ -23,4 +31,18 @@ public class PerCpuState : SchedulerExtensible
 
     // ===== Synchronization =====
     public SpinLock Lock;
+
+    /// <summary>
+    /// Cache distance to another CPU: 0 = same core (SMT sibling, shares L1/L2),
+    /// 1 = same package (shares the last-level cache), 2 = different package.
+    /// </summary>
+    public uint TopologyDistance(PerCpuState other)
+    {
+        if (PackageId != other.PackageId)
+        {
+            return 2;
+        }
+
+        return CoreId == other.CoreId ? 0u : 1u;
+    }
 }
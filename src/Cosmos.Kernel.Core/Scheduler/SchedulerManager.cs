@@ -100,6 +100,22 @@ public static class SchedulerManager
         Cosmos.Kernel.Core.Runtime.DebugLiveMemorySnapshot.Initialize();
     }
 
+    /// <summary>
+    /// Records where a CPU sits in the package / core / thread hierarchy so
+    /// schedulers can keep migrations cache-local (see PerCpuState.TopologyDistance),
+    /// and which NUMA node its page allocations should come from.
+    /// </summary>
+    public static void SetCpuTopology(uint cpuId, uint nodeId, uint packageId, uint coreId, uint threadId)
+    {
+        ThrowIfCpuStateNotInitialized();
+
+        PerCpuState state = _cpuStates[cpuId];
+        state.NodeId = nodeId;
+        state.PackageId = packageId;
+        state.CoreId = coreId;
+        state.ThreadId = threadId;
+    }
+
     public static void SetScheduler(IScheduler scheduler)
     {
         ThrowIfCpuStateNotInitialized();
@@ -272,11 +288,11 @@ public static class SchedulerManager
     public static int ThreadCount => _allThreadCount;
 
     /// <summary>
-    /// Returns the CPU ID currently executing this code path. Single-CPU today.
-    /// TODO(SMP): replace with x86_64 GS-relative per-CPU storage or ARM64 MPIDR_EL1
-    /// affinity read once application processors are brought online.
+    /// Returns the CPU ID currently executing this code path, read from the
+    /// per-CPU register smp.c sets on every CPU (GS base / TPIDR_EL1). Only the
+    /// BSP (0) runs managed code until application processors are adopted.
     /// </summary>
-    public static uint GetCurrentCpuId() => 0;
+    public static uint GetCurrentCpuId() => SmpNative.CurrentCpu();
 
     /// <summary>
     /// Sum of TotalRuntime across all non-idle threads, in nanoseconds.
@@ -549,6 +565,10 @@ public static class SchedulerManager
     {
         MarkSleeping(cpuId, thread, timeoutMs);
 
+        // The CPU is about to idle; drain the native log first. Done ahead of the
+        // state check below so a wake landing mid-flush is still seen.
+        NativeLog.Flush();
+
         // Only park the CPU while still Sleeping: if a wake already landed between
         // scope-dispose and this point, halting would sleep past it.
         if (thread.State == ThreadState.Sleeping)
@@ -620,7 +640,7 @@ public static class SchedulerManager
         state.Lock.Acquire();
 
         var prev = state.CurrentThread;
-        var next = _currentScheduler.PickNext(state) ?? state.IdleThread;
+        var next = PickNextOrSteal(state) ?? state.IdleThread;
 
         if (next == null)
         {
@@ -681,8 +701,33 @@ public static class SchedulerManager
         ThrowIfCpuStateNotInitialized();
         ThrowIfSchedulerNotSet();
 
+        // The scheduler only try-acquires the victim's lock, so holding this
+        // CPU's own lock cannot deadlock against a CPU stealing from us.
         var state = _cpuStates[cpuId];
-        _currentScheduler.Balance(state, _cpuStates);
+        state.Lock.Acquire();
+        try
+        {
+            _currentScheduler.Balance(state, _cpuStates);
+        }
+        finally
+        {
+            state.Lock.Release();
+        }
+    }
+
+    // Idle path: with nothing runnable on this CPU, try to pull a thread from
+    // a busier one before falling back to the idle thread. Callers hold this
+    // CPU's lock or run with interrupts off, as Balance requires.
+    private static Thread? PickNextOrSteal(PerCpuState state)
+    {
+        var next = _currentScheduler!.PickNext(state);
+        if (next == null && _cpuCount > 1)
+        {
+            _currentScheduler.Balance(state, _cpuStates!);
+            next = _currentScheduler.PickNext(state);
+        }
+
+        return next;
     }
 
     // ========== Timer Interrupt Handling ==========
@@ -701,6 +746,9 @@ public static class SchedulerManager
     {
         _tickCount++;
 
+        // Put out what the native layer logged since the last tick.
+        NativeLog.Pump(NativeLog.TickRecordBudget);
+
         // Refresh the debug-live snapshot every 10 ticks (~100ms at 100Hz)
         // so the host-side QMP poller sees fresh thread state without
         // pausing the kernel.
@@ -835,7 +883,7 @@ public static class SchedulerManager
 
         // No lock needed - interrupts are already disabled in interrupt context
         var prev = state.CurrentThread;
-        var next = _currentScheduler.PickNext(state) ?? state.IdleThread;
+        var next = PickNextOrSteal(state) ?? state.IdleThread;
 
         if (next == null)
         {
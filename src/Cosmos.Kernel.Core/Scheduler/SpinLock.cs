@@ -53,6 +53,44 @@ public struct SpinLock
     public readonly bool IsLocked => _locked != 0;
 }
 
+/// <summary>
+/// FIFO ticket spinlock: waiters take a ticket and are served in arrival
+/// order, so a CPU hammering the lock cannot starve the others. Used where
+/// hold times are long enough for fairness to matter (LAI host locks, see
+/// <see cref="Bridge.LockNative"/>). Same interrupt caveat as
+/// <see cref="SpinLock"/>: disable interrupts around it when an ISR can
+/// take the same lock.
+/// </summary>
+public struct TicketLock
+{
+    private int _next;
+    private int _serving;
+
+    public void Acquire()
+    {
+        int ticket = Interlocked.Increment(ref _next) - 1;
+        while (Volatile.Read(ref _serving) != ticket)
+        {
+            // Spin until our ticket is served
+        }
+    }
+
+    public bool TryAcquire()
+    {
+        int serving = Volatile.Read(ref _serving);
+        return Interlocked.CompareExchange(ref _next, serving + 1, serving) == serving;
+    }
+
+    public void Release()
+    {
+        // Only the holder writes _serving, so a plain increment published
+        // with a release store is enough.
+        Volatile.Write(ref _serving, _serving + 1);
+    }
+
+    public readonly bool IsLocked => _next != _serving;
+}
+
 /// <summary>
 /// RAII scope returned by <see cref="SpinLock.AcquireIrqSafe"/>. Disables
 /// interrupts and acquires the lock on creation; on dispose, releases the
@@ -21,7 +21,7 @@ public class StrideCpuData
     public ulong LastPassUpdate { get; internal set; }
 
     /// <summary>
-    /// Run queue sorted by Pass value (ascending).
+    /// Ready threads, ordered by Pass value (lowest first).
     /// </summary>
-    public List<Thread> RunQueue { get; } = new();
+    public StrideRunQueue RunQueue { get; } = new();
 }
@@ -0,0 +1,223 @@
+namespace Cosmos.Kernel.Core.Scheduler.Stride;
+
+/// <summary>
+/// Per-CPU run queue: an intrusive pairing heap keyed on <see cref="StrideThreadData.Pass"/>.
+/// Insert and peek are O(1); PopMin and Remove are amortized O(log n). The links
+/// live in <see cref="StrideThreadData"/>, so queue operations never allocate.
+/// Not synchronized: callers hold the owning CPU's lock or run with interrupts off.
+/// </summary>
+public sealed class StrideRunQueue
+{
+    private StrideThreadData? _root;
+
+    /// <summary>
+    /// Number of queued threads.
+    /// </summary>
+    public int Count { get; private set; }
+
+    /// <summary>
+    /// Lowest-pass thread, or null when empty.
+    /// </summary>
+    public Thread? Min => _root?.Owner;
+
+    public bool Contains(StrideThreadData data) => data.Queue == this;
+
+    /// <summary>
+    /// Queues a thread. A thread that is already queued here is re-keyed
+    /// instead of being queued twice.
+    /// </summary>
+    public void Insert(StrideThreadData data)
+    {
+        if (data.Queue != null)
+        {
+            data.Queue.Remove(data);
+        }
+
+        data.HeapChild = null;
+        data.HeapNext = null;
+        data.HeapPrev = null;
+        data.Queue = this;
+
+        _root = Meld(_root, data);
+        Count++;
+    }
+
+    /// <summary>
+    /// Dequeues the lowest-pass thread, or returns null when empty.
+    /// </summary>
+    public Thread? PopMin()
+    {
+        StrideThreadData? min = _root;
+        if (min == null)
+        {
+            return null;
+        }
+
+        _root = MergePairs(min.HeapChild);
+        Detach(min);
+        return min.Owner;
+    }
+
+    /// <summary>
+    /// Dequeues a thread from anywhere in the heap. Returns false when it is not queued here.
+    /// </summary>
+    public bool Remove(StrideThreadData data)
+    {
+        if (data.Queue != this)
+        {
+            return false;
+        }
+
+        if (data == _root)
+        {
+            PopMin();
+            return true;
+        }
+
+        // HeapPrev is the parent for a leftmost child and the left sibling otherwise.
+        StrideThreadData prev = data.HeapPrev!;
+        if (prev.HeapChild == data)
+        {
+            prev.HeapChild = data.HeapNext;
+        }
+        else
+        {
+            prev.HeapNext = data.HeapNext;
+        }
+
+        if (data.HeapNext != null)
+        {
+            data.HeapNext.HeapPrev = prev;
+        }
+
+        _root = Meld(_root, MergePairs(data.HeapChild));
+        Detach(data);
+        return true;
+    }
+
+    /// <summary>
+    /// Thread at a pre-order position (0 is the lowest pass). O(n); diagnostics only.
+    /// </summary>
+    public Thread? At(int index)
+    {
+        if (index < 0 || index >= Count)
+        {
+            return null;
+        }
+
+        StrideThreadData? node = _root;
+        while (node != null && index > 0)
+        {
+            node = PreOrderNext(node);
+            index--;
+        }
+
+        return node?.Owner;
+    }
+
+    private void Detach(StrideThreadData data)
+    {
+        data.HeapChild = null;
+        data.HeapNext = null;
+        data.HeapPrev = null;
+        data.Queue = null;
+        Count--;
+    }
+
+    // Links two detached roots; the larger pass becomes the leftmost child.
+    // Ties keep the existing root, so equal-pass threads run in arrival order.
+    private static StrideThreadData? Meld(StrideThreadData? a, StrideThreadData? b)
+    {
+        if (a == null)
+        {
+            return b;
+        }
+
+        if (b == null)
+        {
+            return a;
+        }
+
+        if (b.Pass < a.Pass)
+        {
+            (a, b) = (b, a);
+        }
+
+        b.HeapPrev = a;
+        b.HeapNext = a.HeapChild;
+        if (a.HeapChild != null)
+        {
+            a.HeapChild.HeapPrev = b;
+        }
+        a.HeapChild = b;
+
+        return a;
+    }
+
+    // Standard two-pass merge of a sibling list, iterative so a long list
+    // cannot overflow the kernel stack: meld neighbours left to right, then
+    // fold the pairs right to left.
+    private static StrideThreadData? MergePairs(StrideThreadData? first)
+    {
+        StrideThreadData? pairs = null;
+
+        while (first != null)
+        {
+            StrideThreadData a = first;
+            StrideThreadData? b = a.HeapNext;
+            first = b?.HeapNext;
+
+            a.HeapNext = null;
+            a.HeapPrev = null;
+            if (b != null)
+            {
+                b.HeapNext = null;
+                b.HeapPrev = null;
+            }
+
+            StrideThreadData pair = Meld(a, b)!;
+            pair.HeapNext = pairs;
+            pairs = pair;
+        }
+
+        StrideThreadData? result = null;
+        while (pairs != null)
+        {
+            StrideThreadData? next = pairs.HeapNext;
+            pairs.HeapNext = null;
+            result = Meld(result, pairs);
+            pairs = next;
+        }
+
+        return result;
+    }
+
+    private static StrideThreadData? PreOrderNext(StrideThreadData node)
+    {
+        if (node.HeapChild != null)
+        {
+            return node.HeapChild;
+        }
+
+        StrideThreadData? current = node;
+        while (current != null)
+        {
+            if (current.HeapNext != null)
+            {
+                return current.HeapNext;
+            }
+
+            // Climb to the parent: walk left to the leftmost sibling, whose HeapPrev is the parent.
+            StrideThreadData? prev = current.HeapPrev;
+            while (prev != null && prev.HeapChild != current)
+            {
+                current = prev;
+                prev = current.HeapPrev;
+            }
+
+            current = prev;
+        }
+
+        return null;
+    }
+}
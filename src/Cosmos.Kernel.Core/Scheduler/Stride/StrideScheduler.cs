@@ -30,6 +30,11 @@ public class StrideScheduler : IScheduler
     /// </summary>
     private const ulong WakeupBoostDecayNs = 5_000_000;
 
+    /// <summary>
+    /// Largest <see cref="PerCpuState.TopologyDistance"/> (different package).
+    /// </summary>
+    private const uint MaxTopologyDistance = 2;
+
     // ========== Lifecycle ==========
 
     public void InitializeCpu(PerCpuState cpuState)
@@ -51,7 +56,8 @@ public class StrideScheduler : IScheduler
             Tickets = DefaultTickets,
             Stride = Stride1 / DefaultTickets,
             Pass = 0,
-            Remain = 0
+            Remain = 0,
+            Owner = thread
         };
         thread.SchedulerData = data;
     }
@@ -125,7 +131,7 @@ public class StrideScheduler : IScheduler
         threadData.Remain = threadData.Pass - (long)cpuData.GlobalPass;
         threadData.SleepCount++;
 
-        RemoveThreadFromQueue(cpuData.RunQueue, thread);
+        RemoveThreadFromQueue(cpuData.RunQueue, threadData);
         cpuData.TotalTickets -= threadData.Tickets;
     }
 
@@ -139,12 +145,9 @@ public class StrideScheduler : IScheduler
 
         var threadData = thread.GetSchedulerData<StrideThreadData>();
 
-        // Remove from run queue using ReferenceEquals + RemoveAt
-        // Note: List<T>.Remove/Contains crash due to EqualityComparer<T>.Default requiring broken runtime helpers
-        RemoveThreadFromQueue(cpuData.RunQueue, thread);
-
         if (threadData != null)
         {
+            RemoveThreadFromQueue(cpuData.RunQueue, threadData);
             cpuData.TotalTickets -= threadData.Tickets;
         }
 
@@ -183,10 +186,7 @@ public class StrideScheduler : IScheduler
             return null;
         }
 
-        var selected = cpuData.RunQueue[0];
-        cpuData.RunQueue.RemoveAt(0);
-
-        return selected;
+        return cpuData.RunQueue.PopMin();
     }
 
     public void OnPickFailed(PerCpuState cpuState, Thread thread)
@@ -254,9 +254,9 @@ public class StrideScheduler : IScheduler
         }
 
         // Check for preemption
-        if (cpuData.RunQueue.Count > 0)
+        if (cpuData.RunQueue.Min != null)
         {
-            var nextData = cpuData.RunQueue[0].GetSchedulerData<StrideThreadData>();
+            var nextData = cpuData.RunQueue.Min.GetSchedulerData<StrideThreadData>();
             if (nextData != null && nextData.Pass < threadData.Pass)
             {
                 return true;
@@ -277,6 +277,7 @@ public class StrideScheduler : IScheduler
 
         uint best = currentCpu;
         ulong bestLoad = GetCpuLoad(currentCpu);
+        PerCpuState? current = SchedulerManager.GetCpuState(currentCpu);
 
         for (uint cpu = 0; cpu < cpuCount; cpu++)
         {
@@ -285,8 +286,14 @@ public class StrideScheduler : IScheduler
                 continue;
             }
 
+            // Leaving the package loses the shared last-level cache, so it
+            // takes a larger imbalance to justify than a move within it.
+            PerCpuState? candidate = SchedulerManager.GetCpuState(cpu);
+            uint distance = current != null && candidate != null ? current.TopologyDistance(candidate) : 1;
+            ulong threshold = distance >= 2 ? bestLoad * 50 / 100 : bestLoad * 80 / 100;
+
             ulong load = GetCpuLoad(cpu);
-            if (load < bestLoad * 80 / 100)
+            if (load < threshold)
             {
                 best = cpu;
                 bestLoad = load;
@@ -307,7 +314,7 @@ public class StrideScheduler : IScheduler
             return;
         }
 
-        RemoveThreadFromQueue(fromData.RunQueue, thread);
+        RemoveThreadFromQueue(fromData.RunQueue, threadData);
         fromData.TotalTickets -= threadData.Tickets;
 
         threadData.Pass = (long)toData.GlobalPass + threadData.Remain;
@@ -316,6 +323,13 @@ public class StrideScheduler : IScheduler
         toData.TotalTickets += threadData.Tickets;
     }
 
+    /// <summary>
+    /// Work stealing for an idle CPU: take the lowest-pass thread of the most
+    /// loaded CPU at the nearest topology distance (SMT sibling, then the same
+    /// package, then other packages). Victims are chosen from unlocked reads of
+    /// their queue lengths, and a victim's lock is only ever try-acquired, so a
+    /// thief never spins on another CPU and never holds two locks for long.
+    /// </summary>
     public void Balance(PerCpuState cpuState, PerCpuState[] allCpuStates)
     {
         var cpuData = cpuState.GetSchedulerData<StrideCpuData>();
@@ -324,40 +338,63 @@ public class StrideScheduler : IScheduler
             return;
         }
 
-        PerCpuState? busiest = null;
-        int maxCount = 0;
-
-        foreach (var state in allCpuStates)
+        for (uint distance = 0; distance <= MaxTopologyDistance; distance++)
         {
-            if (state == cpuState)
+            PerCpuState? victim = null;
+            int victimCount = 1;
+
+            foreach (var state in allCpuStates)
             {
-                continue;
+                if (state == cpuState || cpuState.TopologyDistance(state) != distance)
+                {
+                    continue;
+                }
+
+                var data = state.GetSchedulerData<StrideCpuData>();
+                if (data != null && data.RunQueue.Count > victimCount)
+                {
+                    victimCount = data.RunQueue.Count;
+                    victim = state;
+                }
             }
 
-            var data = state.GetSchedulerData<StrideCpuData>();
-            if (data != null && data.RunQueue.Count > maxCount)
+            if (victim != null && TrySteal(cpuState, victim))
             {
-                maxCount = data.RunQueue.Count;
-                busiest = state;
+                return;
             }
         }
+    }
 
-        if (busiest == null || maxCount <= 1)
+    private bool TrySteal(PerCpuState thief, PerCpuState victim)
+    {
+        if (!victim.Lock.TryAcquire())
         {
-            return;
+            return false;
         }
 
-        var busiestData = busiest.GetSchedulerData<StrideCpuData>();
-        if (busiestData == null || busiestData.RunQueue.Count == 0)
+        try
         {
-            return;
-        }
+            var victimData = victim.GetSchedulerData<StrideCpuData>();
 
-        var victim = busiestData.RunQueue[busiestData.RunQueue.Count - 1];
+            // Recheck under the lock: leave a CPU its last ready thread.
+            if (victimData == null || victimData.RunQueue.Count <= 1)
+            {
+                return false;
+            }
 
-        if ((victim.Flags & ThreadFlags.Pinned) == 0)
+            Thread? thread = victimData.RunQueue.Min;
+            if (thread == null || (thread.Flags & ThreadFlags.Pinned) != 0)
+            {
+                return false;
+            }
+
+            OnThreadMigrate(thread, victim, thief);
+            thread.CpuId = thief.CpuId;
+            return true;
+        }
+        finally
         {
-            OnThreadMigrate(victim, busiest, cpuState);
+            victim.Lock.Release();
         }
     }
 
@@ -392,9 +429,9 @@ public class StrideScheduler : IScheduler
         threadData.Tickets = newTickets;
         threadData.Stride = newStride;
 
-        if (thread.State == ThreadState.Ready)
+        // Re-key a queued thread under its new pass.
+        if (cpuData.RunQueue.Contains(threadData))
         {
-            RemoveThreadFromQueue(cpuData.RunQueue, thread);
             InsertByPass(cpuData, thread);
         }
     }
@@ -429,23 +466,7 @@ public class StrideScheduler : IScheduler
             return;
         }
 
-        int index = 0;
-
-        for (; index < cpuData.RunQueue.Count; index++)
-        {
-            var otherData = cpuData.RunQueue[index].GetSchedulerData<StrideThreadData>();
-            if (otherData == null)
-            {
-                continue;
-            }
-
-            if (threadData.Pass <= otherData.Pass)
-            {
-                break;
-            }
-        }
-
-        cpuData.RunQueue.Insert(index, thread);
+        cpuData.RunQueue.Insert(threadData);
     }
 
     private ulong GetCpuLoad(uint cpuId)
@@ -460,22 +481,11 @@ public class StrideScheduler : IScheduler
         return (ulong)Stopwatch.GetTimestamp();
     }
 
-    /// <summary>
-    /// Removes a thread from the queue using ReferenceEquals + RemoveAt.
-    /// TODO: List.Remove/Contains crash due to EqualityComparer requiring broken runtime helpers.
-    /// </summary>
-    private void RemoveThreadFromQueue(System.Collections.Generic.List<Thread> queue, Thread thread)
+    private void RemoveThreadFromQueue(StrideRunQueue queue, StrideThreadData threadData)
     {
         using (InternalCpu.DisableInterruptsScope())
         {
-            for (int i = 0; i < queue.Count; i++)
-            {
-                if (object.ReferenceEquals(queue[i], thread))
-                {
-                    queue.RemoveAt(i);
-                    return;
-                }
-            }
+            queue.Remove(threadData);
         }
     }
 
@@ -497,12 +507,7 @@ public class StrideScheduler : IScheduler
         using (InternalCpu.DisableInterruptsScope())
         {
             var cpuData = cpuState.GetSchedulerData<StrideCpuData>();
-            if (cpuData == null || index < 0 || index >= cpuData.RunQueue.Count)
-            {
-                return null;
-            }
-
-            return cpuData.RunQueue[index];
+            return cpuData?.RunQueue.At(index);
         }
     }
 }
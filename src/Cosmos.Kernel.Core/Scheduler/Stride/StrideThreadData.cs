@@ -44,4 +44,17 @@ public class StrideThreadData
     /// Whether thread currently has priority boost.
     /// </summary>
     public bool IsBoosted { get; internal set; }
+
+    /// <summary>
+    /// Thread this data belongs to.
+    /// </summary>
+    public Thread Owner { get; internal set; } = null!;
+
+    // Intrusive StrideRunQueue links. HeapPrev is the parent for a leftmost
+    // child and the left sibling otherwise; Queue is the run queue holding
+    // the thread, or null while it runs or blocks.
+    internal StrideThreadData? HeapChild;
+    internal StrideThreadData? HeapNext;
+    internal StrideThreadData? HeapPrev;
+    internal StrideRunQueue? Queue;
 }
@@ -41,5 +41,11 @@ public enum ThreadFlags : ushort
     /// to call the managed thread start.
     /// </summary>
     Managed = 1 << 3,
+    /// <summary>
+    /// Latency-sensitive I/O: block drivers spin on the completion queue
+    /// for this thread's commands before falling back to sleeping on the
+    /// device interrupt
+    /// </summary>
+    PolledIo = 1 << 4,
     // Bits 8-15 reserved for scheduler-specific flags
 }
@@ -2,11 +2,14 @@
 
 using Cosmos.Build.API.Enum;
 using Cosmos.Kernel.Core;
+using Cosmos.Kernel.Core.ARM64.Bridge;
 using Cosmos.Kernel.Core.ARM64.Cpu;
 using Cosmos.Kernel.Core.ARM64.IO;
 using Cosmos.Kernel.Core.ARM64.Power;
+using Cosmos.Kernel.Core.Bridge;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
 using Cosmos.Kernel.Core.Power;
 using Cosmos.Kernel.HAL.ARM64.Devices.Clock;
 using Cosmos.Kernel.HAL.ARM64.Devices.Timer;
@@ -35,6 +38,9 @@ public class ARM64PlatformInitializer : IPlatformInitializer
     private const uint VirtioMmioSlotCount = 32;
     private const uint VirtioMmioIrqBase = 48;
 
+    /// <summary>MPIDR_EL1.MT (bit 24): affinity level 0 numbers hardware threads of one core.</summary>
+    private const ulong MpidrMultithreaded = 1ul << 24;
+
     private GenericTimer? _timer;
 
     public string PlatformName => "ARM64";
@@ -185,6 +191,57 @@ public class ARM64PlatformInitializer : IPlatformInitializer
         return 1;
     }
 
+    public void GetCpuTopology(uint cpuIndex, out uint packageId, out uint coreId, out uint threadId)
+    {
+        ulong mpidr = GetCpuMpidr(cpuIndex);
+        if (mpidr == ulong.MaxValue)
+        {
+            packageId = 0;
+            coreId = cpuIndex;
+            threadId = 0;
+            return;
+        }
+
+        // MPIDR_EL1 affinity: Aff0 [7:0], Aff1 [15:8], Aff2 [23:16], Aff3 [39:32].
+        // With MT set, Aff0 numbers the hardware threads of one core; without
+        // it, Aff0 numbers cores. The levels above hold the cluster, which is
+        // what shares the last-level cache, so it becomes the package.
+        uint aff0 = (uint)(mpidr & 0xFF);
+        uint aff1 = (uint)((mpidr >> 8) & 0xFF);
+        uint aff2 = (uint)((mpidr >> 16) & 0xFF);
+        uint aff3 = (uint)((mpidr >> 32) & 0xFF);
+        if ((mpidr & MpidrMultithreaded) != 0)
+        {
+            threadId = aff0;
+            coreId = aff1;
+            packageId = aff2 | (aff3 << 8);
+        }
+        else
+        {
+            threadId = 0;
+            coreId = aff0;
+            packageId = aff1 | (aff2 << 8) | (aff3 << 16);
+        }
+    }
+
+    public uint GetCpuNode(uint cpuIndex)
+    {
+        // The SRAT keys GICC affinity by ACPI processor UID; the MADT GICC
+        // entry with this CPU's MPIDR gives the UID.
+        uint uid = AcpiGicNative.GetGiccUid(GetCpuMpidr(cpuIndex));
+        return uid == AcpiGicNative.NoGiccUid ? 0 : NumaTopology.GetCpuNode(uid);
+    }
+
+    /// <summary>
+    /// MPIDR_EL1 of CPU <paramref name="cpuIndex"/>. The BSP reads its own
+    /// register, which is valid even without a Limine MP response; APs use
+    /// the MPIDR Limine reported when they were brought up.
+    /// </summary>
+    private static ulong GetCpuMpidr(uint cpuIndex)
+    {
+        return cpuIndex == 0 ? GICv3Native.ReadMpidr() : SmpNative.HardwareId(cpuIndex);
+    }
+
     public void StartSchedulerTimer(uint quantumMs)
     {
         // Start the timer for preemptive scheduling
@@ -5,6 +5,7 @@ using Cosmos.Kernel.Core.ARM64.Bridge;
 using Cosmos.Kernel.Core.ARM64.Cpu;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Runtime;
 using Cosmos.Kernel.Core.Scheduler;
 using Cosmos.Kernel.HAL.Devices.Timer;
 
@@ -213,6 +214,9 @@ public class GenericTimer : TimerDevice
             Serial.Write("\n");
         }
 
+        // Sample before scheduling: a context switch would replace the interrupted frame
+        SamplingProfiler.Sample(cpuId, ref ctx);
+
         // Call scheduler with elapsed time
         SchedulerManager.OnTimerInterrupt(cpuId, currentSp, Instance._periodNs);
 
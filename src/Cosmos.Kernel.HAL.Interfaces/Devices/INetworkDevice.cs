@@ -7,7 +7,11 @@ namespace Cosmos.Kernel.HAL.Interfaces.Devices;
 /// <summary>
 /// Delegate for handling packet received events.
 /// </summary>
-/// <param name="data">The received packet data.</param>
+/// <param name="data">
+/// The received packet data. The handler owns the array and may keep it.
+/// Drivers that receive in place may pass their DMA buffer, which can be
+/// longer than the frame; bytes past <paramref name="length"/> are zero.
+/// </param>
 /// <param name="length">The length of the packet.</param>
 public delegate void PacketReceivedHandler(byte[] data, int length);
 
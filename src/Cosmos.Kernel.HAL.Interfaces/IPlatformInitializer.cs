@@ -27,7 +27,8 @@ public interface IPlatformInitializer
 
     /// <summary>
     /// Maps PCI configuration space memory before device enumeration.
-    /// ARM64 maps ECAM as device memory; x64 uses port I/O (no mapping needed).
+    /// ARM64 maps the first ECAM block as device memory; x64 needs nothing here.
+    /// Further ECAM bus windows are mapped on demand through <see cref="EnsureMmioMapped"/>.
     /// </summary>
     /// <param name="ecamBase">Physical ECAM base address from ACPI MCFG.</param>
     void PreparePciMapping(ulong ecamBase);
@@ -92,6 +93,19 @@ public interface IPlatformInitializer
     /// </summary>
     uint GetCpuCount();
 
+    /// <summary>
+    /// Gets where CPU <paramref name="cpuIndex"/> (0 .. GetCpuCount() - 1) sits in the
+    /// package / core / hardware-thread hierarchy. CPUs with the same package share a
+    /// last-level cache; CPUs with the same package and core are SMT siblings.
+    /// </summary>
+    void GetCpuTopology(uint cpuIndex, out uint packageId, out uint coreId, out uint threadId);
+
+    /// <summary>
+    /// Gets the NUMA node (dense index from the ACPI SRAT) that CPU <paramref name="cpuIndex"/>
+    /// belongs to; 0 on single-node machines.
+    /// </summary>
+    uint GetCpuNode(uint cpuIndex);
+
     /// <summary>
     /// Starts the platform timer for preemptive scheduling.
     /// Called after all initialization is complete.
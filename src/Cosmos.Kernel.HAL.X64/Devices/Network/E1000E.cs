@@ -6,9 +6,12 @@ using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.Core.Scheduler;
 using Cosmos.Kernel.HAL.Devices.Network;
 using Cosmos.Kernel.HAL.Interfaces.Devices;
 using Cosmos.Kernel.HAL.Pci;
+using SchedSpinLock = Cosmos.Kernel.Core.Scheduler.SpinLock;
+using SysThread = System.Threading.Thread;
 
 namespace Cosmos.Kernel.HAL.X64.Devices.Network;
 
@@ -16,6 +19,15 @@ namespace Cosmos.Kernel.HAL.X64.Devices.Network;
 /// Intel 82574 (E1000E) Gigabit Ethernet Controller Driver.
 /// Supports MSI-X interrupts.
 /// </summary>
+/// <remarks>
+/// RX is zero-copy for full-size frames: the ring DMAs into pinned arrays
+/// from a <see cref="PacketBufferArena"/>, and a completed buffer is handed
+/// to <see cref="OnPacketReceived"/> as-is while the descriptor is re-armed
+/// with a spare. Interrupts are moderated through ITR (EITR with MSI-X), at
+/// a rate adapted to the frames found per interrupt; when one interrupt finds
+/// more than <see cref="RxIrqBudget"/> frames, RX interrupts are masked and
+/// a poll thread drains the ring until it runs dry (NAPI-style).
+/// </remarks>
 public class E1000E : PciDevice, INetworkDevice
 {
     // E1000E Register Offsets
@@ -45,6 +57,7 @@ public class E1000E : PciDevice, INetworkDevice
     private const uint REG_TIPG = 0x0410;        // Transmit Inter Packet Gap
     private const uint REG_RAL0 = 0x5400;        // Receive Address Low
     private const uint REG_RAH0 = 0x5404;        // Receive Address High
+    private const uint REG_EITR0 = 0x00E8;       // Extended Interrupt Throttle (MSI-X vector 0)
 
     // Control Register Bits
     private const uint CTRL_FD = 1 << 0;         // Full Duplex
@@ -95,10 +108,34 @@ public class E1000E : PciDevice, INetworkDevice
     private const byte RX_STATUS_EOP = 1 << 1;   // End of Packet
 
     // Ring geometry (descriptor counts must be a multiple of 8)
-    private const int RxDescCount = 32;
-    private const int TxDescCount = 32;
+    private const int RxDescCount = 64;
+    private const int TxDescCount = 64;
     private const int RxBufferSize = 2048;
 
+    // Frames up to this size are copied into an exact-size array and the
+    // ring buffer reused in place: cheaper than giving away a 2 KiB pinned
+    // buffer for an ARP or a bare ACK.
+    private const int RxCopyBreak = 256;
+
+    // Spare RX buffers kept ready to re-arm descriptors whose buffer went to
+    // the stack; below the low-water mark the poll thread refills them.
+    private const int RxArenaSpares = 32;
+    private const int RxArenaLowWater = 8;
+
+    // Frames one interrupt may deliver before RX switches to polling, and
+    // frames per poll pass before the ring is re-checked.
+    private const int RxIrqBudget = 32;
+    private const int RxPollBudget = 64;
+
+    private const uint RxInterruptMask = ICR_RXT0 | ICR_RXDMT0;
+
+    // Interrupt throttling intervals, in the ITR's 256 ns units.
+    private const uint ItrLowLatencyInterval = 195;   // ~20000 interrupts/s
+    private const uint ItrBulkInterval = 976;         // ~4000 interrupts/s
+    private const int ItrBulkFrames = 16;             // frames per interrupt that count as bulk traffic
+    private const int ItrLatencyFrames = 2;           // frames per interrupt that count as interactive
+    private const int EitrCount = 5;                  // 82574 MSI-X vectors: RxQ0, RxQ1, TxQ0, TxQ1, other
+
     // PCI Capability IDs
     private const byte MsiCapabilityId = 0x05;
 
@@ -120,10 +157,25 @@ public class E1000E : PciDevice, INetworkDevice
     // Descriptor rings
     private unsafe RxDescriptor* _rxDescriptors;
     private unsafe TxDescriptor* _txDescriptors;
-    private unsafe byte** _rxBuffers;
+    private byte[][]? _rxBuffers;
     private unsafe byte** _txBuffers;
+    private PacketBufferArena? _rxArena;
     private uint _rxTail;
     private uint _txTail;
+    private uint _txClean;
+
+    // RX ring state is touched from the IRQ handler and the poll thread, TX
+    // state from any thread and from the IRQ handler (the stack answers ARP
+    // and ICMP from OnPacketReceived). Neither lock is held across
+    // OnPacketReceived, or such a reply would self-deadlock.
+    private SchedSpinLock _rxLock;
+    private SchedSpinLock _txLock;
+
+    // Interrupt moderation and polling
+    private uint _itrInterval;
+    private volatile bool _polling;
+    private InterruptEvent? _pollEvent;
+    private SysThread? _pollThread;
 
     // MSI-X support
     private bool _hasMsix;
@@ -169,7 +221,18 @@ public class E1000E : PciDevice, INetworkDevice
     /// <param name="bus">PCI bus number.</param>
     /// <param name="slot">PCI slot number.</param>
     /// <param name="function">PCI function number.</param>
-    public E1000E(uint bus, uint slot, uint function) : base(bus, slot, function)
+    public E1000E(uint bus, uint slot, uint function) : this(0, bus, slot, function)
+    {
+    }
+
+    /// <summary>
+    /// Creates an E1000E driver for the function at (segment, bus, slot, function).
+    /// </summary>
+    /// <param name="segment">PCI segment group.</param>
+    /// <param name="bus">PCI bus number.</param>
+    /// <param name="slot">PCI slot number.</param>
+    /// <param name="function">PCI function number.</param>
+    public E1000E(uint segment, uint bus, uint slot, uint function) : base(segment, bus, slot, function)
     {
         // Get MMIO base address from BAR0
         if (BaseAddressBar is { Length: > 0 })
@@ -192,45 +255,45 @@ public class E1000E : PciDevice, INetworkDevice
         device = PciManager.GetDevice(Pci.Enums.VendorId.Intel, Pci.Enums.DeviceId.E82574L);
         if (device != null && !device.Claimed)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         device = PciManager.GetDevice(Pci.Enums.VendorId.Intel, Pci.Enums.DeviceId.E82574IT);
         if (device != null && !device.Claimed)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         device = PciManager.GetDevice(Pci.Enums.VendorId.Intel, Pci.Enums.DeviceId.E82574);
         if (device != null && !device.Claimed)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         // Additional E1000E device IDs
         device = PciManager.GetDevice(Pci.Enums.VendorId.Intel, Pci.Enums.DeviceId.Pch82577Lm);
         if (device != null && !device.Claimed)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         device = PciManager.GetDevice(Pci.Enums.VendorId.Intel, Pci.Enums.DeviceId.Pch82577Lc);
         if (device != null && !device.Claimed)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         device = PciManager.GetDevice(Pci.Enums.VendorId.Intel, Pci.Enums.DeviceId.Pch82578Dm);
         if (device != null && !device.Claimed)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         // Also check by class (Network Controller = 0x02, Ethernet = 0x00)
         device = PciManager.GetDeviceClass(Pci.Enums.ClassId.NetworkController, (Pci.Enums.SubclassId)0x00, (Pci.Enums.ProgramIf)0x00);
         if (device != null && !device.Claimed && device.VendorId == (ushort)Pci.Enums.VendorId.Intel)
         {
-            return new E1000E(device.Bus, device.Slot, device.Function);
+            return new E1000E(device.Segment, device.Bus, device.Slot, device.Function);
         }
 
         return null;
@@ -463,17 +526,19 @@ public class E1000E : PciDevice, INetworkDevice
         _rxDescriptors = (RxDescriptor*)aligned;
         MemoryOp.MemSet((byte*)_rxDescriptors, 0, descSize);
 
-        // Allocate buffer pointers array
-        _rxBuffers = (byte**)MemoryOp.Alloc((uint)(RxDescCount * sizeof(byte*)));
+        // Ring buffers are pinned arrays so a completed one can be handed to
+        // the stack without copying; the arena holds the spares that replace them.
+        _rxArena = new PacketBufferArena(RxBufferSize, RxArenaSpares);
+        _rxBuffers = new byte[RxDescCount][];
 
-        // Allocate buffers and set up descriptors
         for (int i = 0; i < RxDescCount; i++)
         {
-            _rxBuffers[i] = (byte*)MemoryOp.Alloc(RxBufferSize);
+            _rxBuffers[i] = _rxArena.Rent();
             // E1000 needs physical addresses for DMA
-            _rxDescriptors[i].BufferAddress = VirtToPhys((ulong)_rxBuffers[i]);
+            _rxDescriptors[i].BufferAddress = VirtToPhys(PacketBufferArena.DataAddress(_rxBuffers[i]));
             _rxDescriptors[i].Status = 0;
         }
+        _rxArena.Refill();
 
         // Set descriptor base address (physical)
         ulong descPhysAddr = VirtToPhys((ulong)_rxDescriptors);
@@ -532,6 +597,7 @@ public class E1000E : PciDevice, INetworkDevice
         WriteMmio(REG_TDH, 0);
         WriteMmio(REG_TDT, 0);
         _txTail = 0;
+        _txClean = 0;
 
         // Set Transmit Inter Packet Gap (required for E1000)
         // IPGT = 10, IPGR1 = 8, IPGR2 = 6 (default values for IEEE 802.3)
@@ -551,11 +617,56 @@ public class E1000E : PciDevice, INetworkDevice
     /// </summary>
     private void EnableInterrupts()
     {
+        // Start in low-latency moderation; AdaptInterruptRate moves it once
+        // traffic shows up.
+        SetInterruptInterval(ItrLowLatencyInterval);
+
         // Enable RX and link change interrupts
-        uint ims = ICR_RXT0 | ICR_LSC | ICR_RXDMT0;
+        uint ims = RxInterruptMask | ICR_LSC;
         WriteMmio(REG_IMS, ims);
     }
 
+    /// <summary>
+    /// Program the interrupt throttling interval. ITR governs legacy and MSI
+    /// delivery; with MSI-X each vector is throttled by its own EITR.
+    /// </summary>
+    private void SetInterruptInterval(uint interval)
+    {
+        _itrInterval = interval;
+        WriteMmio(REG_ITR, interval);
+
+        if (_hasMsix)
+        {
+            for (uint i = 0; i < EitrCount; i++)
+            {
+                WriteMmio(REG_EITR0 + i * 4, interval);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Pick the moderation interval from how many frames the last interrupt
+    /// found: bulk traffic trades latency for fewer interrupts, sparse
+    /// traffic gets them back promptly.
+    /// </summary>
+    private void AdaptInterruptRate(int frames)
+    {
+        uint interval = _itrInterval;
+        if (frames >= ItrBulkFrames)
+        {
+            interval = ItrBulkInterval;
+        }
+        else if (frames <= ItrLatencyFrames)
+        {
+            interval = ItrLowLatencyInterval;
+        }
+
+        if (interval != _itrInterval)
+        {
+            SetInterruptInterval(interval);
+        }
+    }
+
     /// <summary>
     /// Register the IRQ handler for the E1000E.
     /// </summary>
@@ -571,6 +682,22 @@ public class E1000E : PciDevice, INetworkDevice
         Serial.Write("[E1000E] IRQ handler registered\n");
     }
 
+    /// <summary>
+    /// Start the RX poll thread. Until it runs, every frame is delivered from
+    /// the IRQ handler; call once the scheduler can run kernel threads.
+    /// </summary>
+    public void StartPollThread()
+    {
+        if (_pollThread != null || !_networkInitialized || !SchedulerManager.IsReady)
+        {
+            return;
+        }
+
+        _pollEvent = new InterruptEvent();
+        _pollThread = new SysThread(PollLoop);
+        _pollThread.Start();
+    }
+
     /// <summary>
     /// IRQ handler.
     /// </summary>
@@ -594,95 +721,254 @@ public class E1000E : PciDevice, INetworkDevice
             Serial.Write("\n");
         }
 
-        if ((icr & (ICR_RXT0 | ICR_RXDMT0)) != 0)
+        if ((icr & RxInterruptMask) != 0 && !Instance._polling)
         {
-            // Packet received
-            Instance.ProcessReceivedPackets();
+            Instance.HandleRxInterrupt();
         }
     }
 
     /// <summary>
-    /// Process received packets.
+    /// Deliver what the ring holds, or hand the ring to the poll thread if it
+    /// holds more than one interrupt's budget.
     /// </summary>
-    private unsafe void ProcessReceivedPackets()
+    private void HandleRxInterrupt()
     {
+        InterruptEvent? pollEvent = _pollEvent;
+        int frames = ProcessReceivedPackets(pollEvent != null ? RxIrqBudget : int.MaxValue);
+        AdaptInterruptRate(frames);
+
+        if (pollEvent == null)
+        {
+            return;
+        }
+
+        if (frames >= RxIrqBudget)
+        {
+            // Heavy traffic: stop taking an interrupt per batch and poll
+            // until the ring runs dry.
+            _polling = true;
+            WriteMmio(REG_IMC, RxInterruptMask);
+            pollEvent.Signal();
+        }
+        else if (_rxArena!.Available < RxArenaLowWater)
+        {
+            // Let the poll thread top the spares up outside interrupt context.
+            pollEvent.Signal();
+        }
+    }
+
+    /// <summary>
+    /// Poll thread: woken by the IRQ handler, drains the ring in budgeted
+    /// passes, then re-arms RX interrupts.
+    /// </summary>
+    private void PollLoop()
+    {
+        Serial.Write("[E1000E] RX poll thread started\n");
+
         while (true)
         {
-            uint head = ReadMmio(REG_RDH);
-            uint next = (_rxTail + 1) % RxDescCount;
+            _pollEvent!.Wait();
+            _rxArena!.Refill();
 
-            if (next == head)
+            if (!_polling)
             {
-                break;
+                continue;
+            }
+
+            while (ProcessReceivedPackets(RxPollBudget) == RxPollBudget)
+            {
+                _rxArena.Refill();
             }
 
-            RxDescriptor* desc = &_rxDescriptors[next];
+            _polling = false;
+            WriteMmio(REG_IMS, RxInterruptMask);
 
-            if ((desc->Status & RX_STATUS_DD) == 0)
+            // Reading ICR for a link change while masked also clears a latched
+            // RX cause; re-raise it if a frame landed after the last pass.
+            if (RxFramePending())
             {
-                break;
+                WriteMmio(REG_ICS, ICR_RXT0);
             }
+        }
+    }
+
+    private unsafe bool RxFramePending()
+    {
+        using IrqLockScope scope = _rxLock.AcquireIrqSafe();
+        uint next = (_rxTail + 1) % RxDescCount;
+        return (_rxDescriptors[next].Status & RX_STATUS_DD) != 0;
+    }
 
-            if ((desc->Status & RX_STATUS_EOP) != 0 && desc->Errors == 0)
+    /// <summary>
+    /// Process up to <paramref name="budget"/> received frames.
+    /// </summary>
+    /// <returns>Number of descriptors consumed.</returns>
+    private unsafe int ProcessReceivedPackets(int budget)
+    {
+        int frames = 0;
+        while (frames < budget)
+        {
+            // Take one frame off the ring and re-arm its descriptor under the
+            // lock, but deliver it outside: the stack sends replies from
+            // OnPacketReceived, and Send takes the TX lock.
+            byte[]? packet = null;
+            int length = 0;
+            using (IrqLockScope scope = _rxLock.AcquireIrqSafe())
             {
-                // Valid packet received
-                int length = desc->Length;
-                byte[] data = new byte[length];
+                uint next = (_rxTail + 1) % RxDescCount;
+                RxDescriptor* desc = &_rxDescriptors[next];
 
-                byte* src = _rxBuffers[next];
-                for (int i = 0; i < length; i++)
+                if ((desc->Status & RX_STATUS_DD) == 0)
                 {
-                    data[i] = src[i];
+                    break;
                 }
 
-                // Invoke callback
-                OnPacketReceived?.Invoke(data, length);
+                if ((desc->Status & RX_STATUS_EOP) != 0 && desc->Errors == 0)
+                {
+                    length = desc->Length;
+                    byte[] buffer = _rxBuffers![next];
+
+                    if (length <= RxCopyBreak)
+                    {
+                        packet = new byte[length];
+                        fixed (byte* dst = packet, src = buffer)
+                        {
+                            MemoryOp.MemCopy(dst, src, length);
+                        }
+                    }
+                    else
+                    {
+                        // Zero-copy: the stack keeps this buffer, the ring takes a spare.
+                        // Only copybreak-sized frames, all shorter than this one, can
+                        // have landed in it before, so the bytes past length are zero.
+                        packet = buffer;
+                        byte[] spare = _rxArena!.Rent();
+                        _rxBuffers[next] = spare;
+                        desc->BufferAddress = VirtToPhys(PacketBufferArena.DataAddress(spare));
+                    }
+                }
+
+                // Clear status and give the descriptor back to hardware
+                desc->Status = 0;
+                _rxTail = next;
+                frames++;
+
+                // One tail write per batch rather than per frame
+                if (frames == budget || (_rxDescriptors[(next + 1) % RxDescCount].Status & RX_STATUS_DD) == 0)
+                {
+                    WriteMmio(REG_RDT, _rxTail);
+                }
             }
 
-            // Clear status and give buffer back to hardware
-            desc->Status = 0;
-            _rxTail = next;
-            WriteMmio(REG_RDT, _rxTail);
+            if (packet != null)
+            {
+                OnPacketReceived?.Invoke(packet, length);
+            }
         }
+
+        return frames;
     }
 
     /// <summary>
     /// Send a packet.
     /// </summary>
-    public unsafe bool Send(byte[] data, int length)
+    public bool Send(byte[] data, int length)
     {
         if (!_networkInitialized || data == null || length <= 0 || length > RxBufferSize)
         {
             return false;
         }
 
-        uint next = (_txTail + 1) % TxDescCount;
-        uint head = ReadMmio(REG_TDH);
+        using IrqLockScope scope = _txLock.AcquireIrqSafe();
 
-        // Check if ring is full
-        if (next == head)
+        if (!QueueTxLocked(data, length, TX_CMD_EOP | TX_CMD_IFCS | TX_CMD_RS))
         {
             return false;
         }
 
+        WriteMmio(REG_TDT, _txTail);
+        return true;
+    }
+
+    /// <summary>
+    /// Queue several packets and publish them to the NIC with one tail
+    /// register write. Stops at the first packet that does not fit in the
+    /// ring or is not a valid frame.
+    /// </summary>
+    /// <param name="packets">Frames to send; each array is sent whole.</param>
+    /// <returns>Number of packets queued, from the front of <paramref name="packets"/>.</returns>
+    public unsafe int SendBatch(ReadOnlySpan<byte[]> packets)
+    {
+        if (!_networkInitialized)
+        {
+            return 0;
+        }
+
+        using IrqLockScope scope = _txLock.AcquireIrqSafe();
+
+        int queued = 0;
+        while (queued < packets.Length)
+        {
+            byte[] data = packets[queued];
+            if (data == null || data.Length == 0 || data.Length > RxBufferSize)
+            {
+                break;
+            }
+
+            // Status write-back is only needed once per batch; RS is set on
+            // the last descriptor below.
+            if (!QueueTxLocked(data, data.Length, TX_CMD_EOP | TX_CMD_IFCS))
+            {
+                break;
+            }
+            queued++;
+        }
+
+        if (queued > 0)
+        {
+            uint last = (_txTail + TxDescCount - 1) % TxDescCount;
+            _txDescriptors[last].CMD |= TX_CMD_RS;
+            WriteMmio(REG_TDT, _txTail);
+        }
+
+        return queued;
+    }
+
+    /// <summary>
+    /// Copy one frame into the next TX slot and fill its descriptor without
+    /// publishing it. Caller must hold <see cref="_txLock"/>.
+    /// </summary>
+    private unsafe bool QueueTxLocked(byte[] data, int length, byte cmd)
+    {
+        uint next = (_txTail + 1) % TxDescCount;
+
+        // Check if ring is full against the last head we saw; only go to the
+        // device for a fresh TDH when that says there is no room.
+        if (next == _txClean)
+        {
+            _txClean = ReadMmio(REG_TDH);
+            if (next == _txClean)
+            {
+                return false;
+            }
+        }
+
         // Copy data to buffer
         byte* dst = _txBuffers[_txTail];
-        for (int i = 0; i < length; i++)
+        fixed (byte* src = data)
         {
-            dst[i] = data[i];
+            MemoryOp.MemCopy(dst, src, length);
         }
 
         // Set up descriptor (use physical address for DMA)
         TxDescriptor* desc = &_txDescriptors[_txTail];
         desc->BufferAddress = VirtToPhys((ulong)dst);
         desc->Length = (ushort)length;
-        desc->CMD = TX_CMD_EOP | TX_CMD_IFCS | TX_CMD_RS;
+        desc->CMD = cmd;
         desc->Status = 0;
 
         // Advance tail
         _txTail = next;
-        WriteMmio(REG_TDT, _txTail);
-
         return true;
     }
 
@@ -4,6 +4,7 @@ using Cosmos.Build.API.Enum;
 using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
 using Cosmos.Kernel.Core.Power;
 using Cosmos.Kernel.Core.X64;
 using Cosmos.Kernel.Core.X64.Cpu;
@@ -40,8 +41,9 @@ public class X64PlatformInitializer : IPlatformInitializer
 
     public void PreparePciMapping(ulong ecamBase)
     {
-        // x64 uses legacy port I/O (0xCF8/0xCFC) for PCI config access,
-        // which bypasses the MMU — no memory mapping needed.
+        // ECAM below 4 GiB is already covered by Limine's map; windows above
+        // it are mapped bus by bus (PciDevice.MapBus -> EnsureMmioMapped).
+        // Without an MCFG, config access uses port I/O (0xCF8/0xCFC).
     }
 
     public void EnsureMmioMapped(ulong physBase)
@@ -205,7 +207,35 @@ public class X64PlatformInitializer : IPlatformInitializer
     public unsafe uint GetCpuCount()
     {
         var madtInfo = AcpiMadt.GetMadtInfoPtr();
-        return madtInfo != null ? madtInfo->CpuCount : 1;
+        return madtInfo != null && madtInfo->CpuCount != 0 ? madtInfo->CpuCount : 1;
+    }
+
+    public unsafe void GetCpuTopology(uint cpuIndex, out uint packageId, out uint coreId, out uint threadId)
+    {
+        var madtInfo = AcpiMadt.GetMadtInfoPtr();
+        if (madtInfo != null && cpuIndex < madtInfo->CpuCount)
+        {
+            CpuInfo cpu = madtInfo->Cpus[(int)cpuIndex];
+            packageId = cpu.PackageId;
+            coreId = cpu.CoreId;
+            threadId = cpu.SmtId;
+            return;
+        }
+
+        packageId = 0;
+        coreId = cpuIndex;
+        threadId = 0;
+    }
+
+    public unsafe uint GetCpuNode(uint cpuIndex)
+    {
+        var madtInfo = AcpiMadt.GetMadtInfoPtr();
+        if (madtInfo != null && cpuIndex < madtInfo->CpuCount)
+        {
+            return NumaTopology.GetCpuNode(madtInfo->Cpus[(int)cpuIndex].ApicId);
+        }
+
+        return 0;
     }
 
     public void StartSchedulerTimer(uint quantumMs)
@@ -217,5 +247,9 @@ public class X64PlatformInitializer : IPlatformInitializer
         // Start LAPIC timer for preemptive scheduling
         Serial.WriteString("[X64HAL] Starting LAPIC timer for scheduling...\n");
         LocalApic.StartPeriodicTimer(quantumMs);
+
+        // First point at which kernel threads can run: hand E1000E RX
+        // polling its thread now that the scheduler is live.
+        _networkDevice?.StartPollThread();
     }
 }
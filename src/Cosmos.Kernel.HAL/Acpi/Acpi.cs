@@ -7,12 +7,31 @@ namespace Cosmos.Kernel.HAL;
 
 /// <summary>
 /// C# bridge to native ACPI MCFG discovery (acpi_wrapper.c in MultiArch).
-/// The native code is called during early boot (kmain) and parses the MCFG
-/// table to extract the PCI ECAM base address. This class just retrieves the result.
-/// Native import lives in Cosmos.Kernel.Core/Bridge/Import/AcpiNative.cs.
+/// The native code is called during early boot (kmain) and parses every MCFG
+/// configuration space allocation (one per PCI segment / bus range). This class
+/// just retrieves the result.
+/// Native import lives in Cosmos.Kernel.Core/Bridge/Import/AcpiMcfgNative.cs.
 /// </summary>
 public static unsafe class AcpiMcfg
 {
+    /// <summary>
+    /// Capacity of the native allocation table (ACPI_MCFG_MAX_ALLOCS).
+    /// </summary>
+    public const int MaxAllocations = 16;
+
+    /// <summary>
+    /// Mirrors the C struct acpi_mcfg_alloc_t from ACPI/acpi_wrapper.c.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct McfgAllocation
+    {
+        public ulong BaseAddress;  // ECAM physical base; bus N lives at BaseAddress + (N << 20)
+        public ushort Segment;
+        public byte StartBus;
+        public byte EndBus;
+        private uint _reserved;
+    }
+
     /// <summary>
     /// Mirrors the C struct acpi_mcfg_info_t from ACPI/acpi_wrapper.c.
     /// Must match the native layout exactly.
@@ -21,12 +40,15 @@ public static unsafe class AcpiMcfg
     public struct McfgInfo
     {
         public byte Found;
-        public byte StartBus;
+        public byte StartBus;      // first allocation
         public byte EndBus;
         private byte _pad1;
         public ushort Segment;
         private ushort _pad2;
         public ulong BaseAddress;  // ECAM physical base
+        public uint Count;
+        public uint Dropped;
+        public fixed byte Allocations[MaxAllocations * 16];   // McfgAllocation[MaxAllocations]; see GetAllocation
     }
 
     /// <summary>
@@ -39,7 +61,33 @@ public static unsafe class AcpiMcfg
     }
 
     /// <summary>
-    /// Gets the PCI ECAM physical base address from ACPI MCFG.
+    /// Number of MCFG allocations (0 when the firmware has no MCFG).
+    /// </summary>
+    public static int AllocationCount
+    {
+        get
+        {
+            McfgInfo* mcfg = GetMcfgInfo();
+            return mcfg == null ? 0 : (int)mcfg->Count;
+        }
+    }
+
+    /// <summary>
+    /// Gets the <paramref name="i"/>-th MCFG allocation in table order, or null if out of range.
+    /// </summary>
+    public static McfgAllocation* GetAllocation(int i)
+    {
+        McfgInfo* mcfg = GetMcfgInfo();
+        if (mcfg == null || i < 0 || i >= (int)mcfg->Count)
+        {
+            return null;
+        }
+
+        return (McfgAllocation*)mcfg->Allocations + i;
+    }
+
+    /// <summary>
+    /// Gets the PCI ECAM physical base address of the first MCFG allocation.
     /// Returns 0 if MCFG table was not found.
     /// </summary>
     public static ulong GetEcamBase()
@@ -53,3 +101,71 @@ public static unsafe class AcpiMcfg
         return 0;
     }
 }
+
+/// <summary>
+/// C# view of the power / interrupt-routing objects the native side resolves
+/// once the AML namespace is built (cosmos_acpi_prepare_namespace in
+/// acpi_wrapper.c): the \_S5_ sleep types, whether \_PTS exists, and the
+/// root-bus _PRT routes. Lookups are table reads, no AML is evaluated.
+/// x64 only; on ARM64 the table is never available.
+/// Native import lives in Cosmos.Kernel.Core/Bridge/Import/AcpiPmNative.cs.
+/// </summary>
+public static unsafe class AcpiPm
+{
+    /// <summary>
+    /// Capacity of the native route table (ACPI_PM_MAX_PRT_ROUTES).
+    /// </summary>
+    public const int MaxPrtRoutes = 128;
+
+    /// <summary>
+    /// Mirrors the C struct acpi_prt_route_t from ACPI/acpi_wrapper.c.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PrtRoute
+    {
+        public byte Slot;
+        public byte Pin;           // 1 = INTA# .. 4 = INTD#
+        public byte IrqFlags;      // LAI trigger / polarity flags
+        private byte _reserved;
+        public uint Gsi;
+    }
+
+    /// <summary>
+    /// Mirrors the C struct acpi_pm_cache_t from ACPI/acpi_wrapper.c.
+    /// Must match the native layout exactly.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct PmCache
+    {
+        public byte NamespaceReady;
+        public byte S5Valid;
+        public byte SlpTypA;
+        public byte SlpTypB;
+        public byte PtsPresent;
+        private byte _reserved;
+        public ushort PrtCount;
+        public fixed byte PrtRoutes[MaxPrtRoutes * 8];   // PrtRoute[MaxPrtRoutes]; see GetRoute
+    }
+
+    /// <summary>
+    /// Gets the cached table, or null until the namespace has been built.
+    /// </summary>
+    public static PmCache* GetPmCache()
+    {
+        return (PmCache*)AcpiPmNative.GetPmCache();
+    }
+
+    /// <summary>
+    /// Gets route <paramref name="index"/>, or null if out of range.
+    /// </summary>
+    public static PrtRoute* GetRoute(int index)
+    {
+        PmCache* cache = GetPmCache();
+        if (cache == null || index < 0 || index >= cache->PrtCount)
+        {
+            return null;
+        }
+
+        return (PrtRoute*)cache->PrtRoutes + index;
+    }
+}
@@ -0,0 +1,116 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using Cosmos.Kernel.Core.Scheduler;
+using SchedSpinLock = Cosmos.Kernel.Core.Scheduler.SpinLock;
+
+namespace Cosmos.Kernel.HAL.Devices.Network;
+
+/// <summary>
+/// Pool of fixed-size packet buffers on the pinned object heap, for NICs that
+/// DMA straight into managed arrays. A received frame can then be handed to
+/// <see cref="Interfaces.Devices.PacketReceivedHandler"/> as the very array
+/// the device wrote, and the descriptor re-armed with a buffer rented from
+/// here instead of copying the frame out.
+/// </summary>
+/// <remarks>
+/// <see cref="Rent"/> and <see cref="Return"/> are safe from interrupt
+/// context. <see cref="Rent"/> falls back to a fresh allocation when the pool
+/// is empty, so it never fails short of running out of memory; call
+/// <see cref="Refill"/> from thread context to keep that off the IRQ path.
+/// Buffers are zeroed when allocated, which matters to parsers that bound
+/// themselves by <c>data.Length</c> rather than the frame length.
+/// </remarks>
+public sealed unsafe class PacketBufferArena
+{
+    private readonly byte[]?[] _free;
+    private int _freeCount;
+
+    // Guards _free/_freeCount. Taken from the RX interrupt path, so
+    // interrupts stay off while it is held.
+    private SchedSpinLock _lock;
+
+    /// <summary>Size in bytes of every buffer in the arena.</summary>
+    public int BufferSize { get; }
+
+    /// <summary>Maximum number of idle buffers kept for reuse.</summary>
+    public int Capacity => _free.Length;
+
+    /// <summary>Number of idle buffers ready to be rented without allocating.</summary>
+    public int Available => _freeCount;
+
+    /// <summary>
+    /// Creates an arena and pre-allocates <paramref name="capacity"/> buffers.
+    /// </summary>
+    /// <param name="bufferSize">Size of each buffer in bytes.</param>
+    /// <param name="capacity">Number of idle buffers to keep.</param>
+    public PacketBufferArena(int bufferSize, int capacity)
+    {
+        BufferSize = bufferSize;
+        _free = new byte[capacity][];
+        Refill();
+    }
+
+    /// <summary>
+    /// Takes a buffer from the pool, allocating one if the pool is empty.
+    /// </summary>
+    public byte[] Rent()
+    {
+        using (IrqLockScope scope = _lock.AcquireIrqSafe())
+        {
+            if (_freeCount > 0)
+            {
+                byte[] buffer = _free[--_freeCount]!;
+                _free[_freeCount] = null;
+                return buffer;
+            }
+        }
+
+        return Allocate();
+    }
+
+    /// <summary>
+    /// Gives a buffer back for reuse. Buffers of the wrong size, or beyond
+    /// <see cref="Capacity"/>, are dropped and left to the GC.
+    /// </summary>
+    public void Return(byte[] buffer)
+    {
+        if (buffer.Length != BufferSize)
+        {
+            return;
+        }
+
+        using IrqLockScope scope = _lock.AcquireIrqSafe();
+        if (_freeCount < _free.Length)
+        {
+            _free[_freeCount++] = buffer;
+        }
+    }
+
+    /// <summary>
+    /// Tops the pool up to <see cref="Capacity"/>. Allocates, so call it from
+    /// thread context.
+    /// </summary>
+    public void Refill()
+    {
+        while (_freeCount < _free.Length)
+        {
+            Return(Allocate());
+        }
+    }
+
+    /// <summary>
+    /// Virtual address of a buffer's first byte. Stable for the buffer's
+    /// lifetime because it lives on the pinned heap.
+    /// </summary>
+    public static ulong DataAddress(byte[] buffer)
+    {
+        return (ulong)Unsafe.AsPointer(ref MemoryMarshal.GetArrayDataReference(buffer));
+    }
+
+    private byte[] Allocate()
+    {
+        return GC.AllocateArray<byte>(BufferSize, pinned: true);
+    }
+}
@@ -13,6 +13,13 @@ namespace Cosmos.Kernel.HAL.Devices.Network;
 /// VirtIO network device driver. Transport-agnostic: works over virtio MMIO
 /// (QEMU virt virtio-net-device) and virtio PCI (virtio-net-pci) alike.
 /// </summary>
+/// <remarks>
+/// With VIRTIO_NET_F_MQ the driver runs one RX/TX queue pair per CPU (up to
+/// <see cref="MaxQueuePairs"/>), each pair under its own lock; a sender uses
+/// its CPU's pair. On PCI every queue gets its own MSI-X vector, so an RX
+/// interrupt only drains the ring that signaled. Doorbells are rung once per
+/// batch and, with VIRTIO_F_RING_EVENT_IDX, only when the device asked.
+/// </remarks>
 public unsafe class VirtioNet : INetworkDevice
 {
     // --- Constants ---
@@ -20,9 +27,18 @@ public unsafe class VirtioNet : INetworkDevice
     // Virtio-net feature bits
     private const uint VIRTIO_NET_F_MAC = 1 << 5;
     private const uint VIRTIO_NET_F_STATUS = 1 << 16;
+    private const uint VIRTIO_NET_F_CTRL_VQ = 1 << 17;
+    private const uint VIRTIO_NET_F_MQ = 1 << 22;
     private const uint VIRTIO_NET_S_LINK_UP = 1;
 
-    // Queue indices
+    // Control queue command (spec 5.1.6.5.5): class MQ, VQ_PAIRS_SET, and
+    // the ack byte the device writes back on success.
+    private const byte VIRTIO_NET_CTRL_MQ = 4;
+    private const byte VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET = 0;
+    private const byte VIRTIO_NET_OK = 0;
+
+    // Queue indices: receiveqN = 2N, transmitqN = 2N + 1, and with MQ the
+    // control queue follows the last pair the device supports.
     private const ushort RX_QUEUE = 0;
     private const ushort TX_QUEUE = 1;
 
@@ -34,37 +50,45 @@ public unsafe class VirtioNet : INetworkDevice
     private const uint QUEUE_SIZE = 128;
     private const int RX_BUFFER_SIZE = 2048;
 
-    // Device config space layout: u8 mac[6], u16 status (spec 5.1.4).
+    /// <summary>Upper bound on queue pairs, whatever the device and CPU count allow.</summary>
+    private const int MaxQueuePairs = 4;
+
+    // Control commands are tiny and issued one at a time during init.
+    private const uint CtrlQueueSize = 8;
+    private const int CtrlBufferSize = 16;
+    private const int CtrlTimeoutSpinCount = 10_000_000;
+
+    // Device config space layout: u8 mac[6], u16 status, u16
+    // max_virtqueue_pairs (spec 5.1.4).
     private const uint MacConfigOffset = 0;
     private const uint StatusConfigOffset = 6;
+    private const uint MaxQueuePairsConfigOffset = 8;
 
     // --- Private fields ---
 
     private readonly VirtioTransport _transport;
     private int _headerSize = LegacyHeaderSize;
 
-    // Guards the virtqueue free lists and used-ring cursors, which are
-    // touched from both thread context (Send) and interrupt context
-    // (OnDeviceInterrupt). Never held across OnPacketReceived — the network
-    // stack sends replies from that callback, which would self-deadlock.
-    private SchedSpinLock _queueLock;
-
     private MACAddress _macAddress;
     private bool _networkInitialized;
     private bool _linkUp;
     private bool _enabled;
 
-    private Virtqueue? _rxQueue;
-    private Virtqueue? _txQueue;
+    private QueuePair[] _pairs = new QueuePair[0];
+    private int _pairCount;
 
-    private byte** _rxBuffers;
-    private byte** _txBuffers;
+    private Virtqueue? _ctrlQueue;
+    private ushort _ctrlQueueIndex;
+    private byte* _ctrlBuffer;
 
     // --- Properties ---
 
     /// <summary>The transport this device was bound over (MMIO or PCI).</summary>
     public VirtioTransport Transport => _transport;
 
+    /// <summary>Number of RX/TX queue pairs in use.</summary>
+    public int QueuePairCount => _pairCount;
+
     public PacketReceivedHandler? OnPacketReceived { get; set; }
     string INetworkDevice.Name => "VirtioNet";
     public MACAddress MacAddress => _macAddress;
@@ -91,48 +115,56 @@ public unsafe class VirtioNet : INetworkDevice
 
     public bool Send(byte[] data, int length)
     {
-        if (!_networkInitialized || !_enabled || _txQueue == null || _txBuffers == null || data == null)
+        if (!_networkInitialized || !_enabled || data == null)
         {
             return false;
         }
 
-        using IrqLockScope scope = _queueLock.AcquireIrqSafe();
-
-        ReclaimTxLocked();
+        QueuePair pair = CurrentPair();
+        using IrqLockScope scope = pair.Lock.AcquireIrqSafe();
 
-        int descIdx = _txQueue.AllocDescriptor();
-        if (descIdx < 0)
+        if (!QueueTxLocked(pair, data, length))
         {
-            Serial.Write("[VirtioNet] No TX descriptors available\n");
             return false;
         }
 
-        if (length > RX_BUFFER_SIZE - _headerSize)
+        KickTxLocked(pair);
+        return true;
+    }
+
+    /// <summary>
+    /// Queue several packets on the current CPU's TX queue and notify the
+    /// device once. Stops at the first packet that does not fit in the ring.
+    /// </summary>
+    /// <param name="packets">Frames to send; each array is sent whole.</param>
+    /// <returns>Number of packets queued, from the front of <paramref name="packets"/>.</returns>
+    public int SendBatch(ReadOnlySpan<byte[]> packets)
+    {
+        if (!_networkInitialized || !_enabled)
         {
-            length = RX_BUFFER_SIZE - _headerSize;
+            return 0;
         }
 
-        byte* buf = _txBuffers[descIdx];
+        QueuePair pair = CurrentPair();
+        using IrqLockScope scope = pair.Lock.AcquireIrqSafe();
 
-        // Clear virtio-net header
-        for (int i = 0; i < _headerSize; i++)
+        int queued = 0;
+        while (queued < packets.Length)
         {
-            buf[i] = 0;
+            byte[] data = packets[queued];
+            if (data == null || !QueueTxLocked(pair, data, data.Length))
+            {
+                break;
+            }
+            queued++;
         }
 
-        // Copy packet data
-        for (int i = 0; i < length; i++)
+        if (queued > 0)
         {
-            buf[_headerSize + i] = data[i];
+            KickTxLocked(pair);
         }
 
-        _txQueue.SetupDescriptor(descIdx, VirtioDma.VirtToPhys((ulong)buf), (uint)(_headerSize + length), 0, 0);
-        _txQueue.AddAvailable((ushort)descIdx);
-
-        // Notify device
-        _transport.NotifyQueue(TX_QUEUE);
-
-        return true;
+        return queued;
     }
 
     public void Enable() => _enabled = true;
@@ -153,7 +185,9 @@ public unsafe class VirtioNet : INetworkDevice
 
         _transport.BeginInit();
 
-        if (!_transport.NegotiateFeatures(VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS, out uint features))
+        uint requested = VIRTIO_NET_F_MAC | VIRTIO_NET_F_STATUS | VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ
+            | VirtioTransport.FeatureRingEventIdx;
+        if (!_transport.NegotiateFeatures(requested, out uint features))
         {
             Serial.Write("[VirtioNet] ERROR: Feature negotiation failed\n");
             _transport.Fail();
@@ -166,19 +200,41 @@ public unsafe class VirtioNet : INetworkDevice
         Serial.WriteHex(features);
         Serial.Write("\n");
 
-        // Setup RX and TX queues
-        _rxQueue = _transport.CreateQueue(RX_QUEUE, QUEUE_SIZE);
-        _txQueue = _transport.CreateQueue(TX_QUEUE, QUEUE_SIZE);
-        if (_rxQueue == null || _txQueue == null)
+        int wantedPairs = 1;
+        if ((features & VIRTIO_NET_F_MQ) != 0 && (features & VIRTIO_NET_F_CTRL_VQ) != 0)
+        {
+            // The control queue sits after the last pair the device offers,
+            // not the last one the driver uses.
+            ushort maxPairs = _transport.ReadDeviceConfig16(MaxQueuePairsConfigOffset);
+            _ctrlQueueIndex = (ushort)(2 * maxPairs);
+            _ctrlQueue = _transport.CreateQueue(_ctrlQueueIndex, CtrlQueueSize);
+            if (_ctrlQueue != null)
+            {
+                uint cpus = PlatformHAL.Initializer?.GetCpuCount() ?? 1;
+                wantedPairs = Math.Min(Math.Min(maxPairs, (int)cpus), MaxQueuePairs);
+                _ctrlBuffer = (byte*)MemoryOp.Alloc(CtrlBufferSize);
+            }
+        }
+
+        _pairs = new QueuePair[Math.Max(wantedPairs, 1)];
+        for (int i = 0; i < _pairs.Length; i++)
+        {
+            QueuePair? pair = CreatePair(i);
+            if (pair == null)
+            {
+                break;
+            }
+            _pairs[i] = pair;
+            _pairCount++;
+        }
+
+        if (_pairCount == 0)
         {
             Serial.Write("[VirtioNet] ERROR: Failed to setup queues\n");
             _transport.Fail();
             return;
         }
 
-        InitializeRxBuffers();
-        InitializeTxBuffers();
-
         // Read MAC address from device config space
         if ((features & VIRTIO_NET_F_MAC) != 0)
         {
@@ -196,6 +252,18 @@ public unsafe class VirtioNet : INetworkDevice
         // Set DRIVER_OK to complete initialization
         _transport.FinishInit();
 
+        // The device starts on one pair; the others only carry traffic once
+        // it has accepted VQ_PAIRS_SET, which needs DRIVER_OK.
+        if (_pairCount > 1 && !SetQueuePairs((ushort)_pairCount))
+        {
+            Serial.Write("[VirtioNet] Device refused multiqueue, using one queue pair\n");
+            _pairCount = 1;
+        }
+
+        Serial.Write("[VirtioNet] Queue pairs: ");
+        Serial.WriteNumber((uint)_pairCount);
+        Serial.Write("\n");
+
         // Check link status
         if ((features & VIRTIO_NET_F_STATUS) != 0)
         {
@@ -231,55 +299,194 @@ public unsafe class VirtioNet : INetworkDevice
             return;
         }
 
+        _transport.EnableQueueInterrupts(OnQueueInterrupt);
+
+        // A frame that completed before the handlers were in place raised an
+        // interrupt nobody saw, and under EVENT_IDX the device will not raise
+        // another until used_event moves. Drain once to re-arm every ring.
+        for (int i = 0; i < _pairCount; i++)
+        {
+            ProcessRx(_pairs[i]);
+        }
+
         Serial.Write("[VirtioNet] Initialization complete\n");
     }
 
-    private void InitializeRxBuffers()
+    private QueuePair? CreatePair(int index)
     {
-        if (_rxQueue == null)
+        ushort rxIndex = (ushort)(RX_QUEUE + 2 * index);
+        ushort txIndex = (ushort)(TX_QUEUE + 2 * index);
+        Virtqueue? rx = _transport.CreateQueue(rxIndex, QUEUE_SIZE);
+        Virtqueue? tx = rx != null ? _transport.CreateQueue(txIndex, QUEUE_SIZE) : null;
+        if (rx == null || tx == null)
         {
-            return;
+            return null;
         }
 
+        QueuePair pair = new QueuePair(rx, rxIndex, tx, txIndex);
+        InitializeRxBuffers(pair);
+        InitializeTxBuffers(pair);
+        return pair;
+    }
+
+    private void InitializeRxBuffers(QueuePair pair)
+    {
         Serial.Write("[VirtioNet] Initializing RX buffers...\n");
 
-        _rxBuffers = (byte**)MemoryOp.Alloc((uint)(_rxQueue.QueueSize * sizeof(byte*)));
-        for (int i = 0; i < _rxQueue.QueueSize; i++)
+        Virtqueue rx = pair.Rx;
+        pair.RxBuffers = (byte**)MemoryOp.Alloc((uint)(rx.QueueSize * sizeof(byte*)));
+        for (int i = 0; i < rx.QueueSize; i++)
         {
-            _rxBuffers[i] = (byte*)MemoryOp.Alloc(RX_BUFFER_SIZE);
-            int descIdx = _rxQueue.AllocDescriptor();
+            pair.RxBuffers[i] = (byte*)MemoryOp.Alloc(RX_BUFFER_SIZE);
+            int descIdx = rx.AllocDescriptor();
             if (descIdx < 0)
             {
                 break;
             }
 
-            _rxQueue.SetupDescriptor(descIdx, VirtioDma.VirtToPhys((ulong)_rxBuffers[i]), RX_BUFFER_SIZE,
+            rx.SetupDescriptor(descIdx, VirtioDma.VirtToPhys((ulong)pair.RxBuffers[i]), RX_BUFFER_SIZE,
                 Virtqueue.VRING_DESC_F_WRITE, 0);
-            _rxQueue.AddAvailable((ushort)descIdx);
+            rx.AddAvailable((ushort)descIdx);
         }
 
         // Notify device that RX buffers are available
-        _transport.NotifyQueue(RX_QUEUE);
+        if (rx.KickPrepare())
+        {
+            _transport.NotifyQueue(pair.RxIndex);
+        }
 
         Serial.Write("[VirtioNet] RX buffers initialized\n");
     }
 
-    private void InitializeTxBuffers()
+    private void InitializeTxBuffers(QueuePair pair)
     {
-        if (_txQueue == null)
+        Serial.Write("[VirtioNet] Initializing TX buffers...\n");
+
+        Virtqueue tx = pair.Tx;
+        pair.TxBuffers = (byte**)MemoryOp.Alloc((uint)(tx.QueueSize * sizeof(byte*)));
+        for (int i = 0; i < tx.QueueSize; i++)
         {
-            return;
+            pair.TxBuffers[i] = (byte*)MemoryOp.Alloc(RX_BUFFER_SIZE);
         }
 
-        Serial.Write("[VirtioNet] Initializing TX buffers...\n");
+        // Completed TX descriptors are reclaimed by the next Send, so TX
+        // completions need not interrupt.
+        tx.DisableInterrupts();
+
+        Serial.Write("[VirtioNet] TX buffers initialized\n");
+    }
 
-        _txBuffers = (byte**)MemoryOp.Alloc((uint)(_txQueue.QueueSize * sizeof(byte*)));
-        for (int i = 0; i < _txQueue.QueueSize; i++)
+    /// <summary>
+    /// Issues VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET on the control queue and spins
+    /// for the device's ack. Only called during initialization.
+    /// </summary>
+    private bool SetQueuePairs(ushort pairs)
+    {
+        Virtqueue? ctrl = _ctrlQueue;
+        if (ctrl == null || _ctrlBuffer == null)
         {
-            _txBuffers[i] = (byte*)MemoryOp.Alloc(RX_BUFFER_SIZE);
+            return false;
         }
 
-        Serial.Write("[VirtioNet] TX buffers initialized\n");
+        // Legacy devices want header, payload and ack in separate
+        // descriptors: class/command (2 bytes), virtqueue_pairs (2), ack (1).
+        byte* header = _ctrlBuffer;
+        byte* payload = _ctrlBuffer + 2;
+        byte* ack = _ctrlBuffer + 4;
+        header[0] = VIRTIO_NET_CTRL_MQ;
+        header[1] = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+        *(ushort*)payload = pairs;
+        *ack = 0xFF;
+
+        int d0 = ctrl.AllocDescriptor();
+        int d1 = ctrl.AllocDescriptor();
+        int d2 = ctrl.AllocDescriptor();
+        if (d0 < 0 || d1 < 0 || d2 < 0)
+        {
+            return false;
+        }
+
+        ctrl.SetupDescriptor(d0, VirtioDma.VirtToPhys((ulong)header), 2, Virtqueue.VRING_DESC_F_NEXT, (ushort)d1);
+        ctrl.SetupDescriptor(d1, VirtioDma.VirtToPhys((ulong)payload), 2, Virtqueue.VRING_DESC_F_NEXT, (ushort)d2);
+        ctrl.SetupDescriptor(d2, VirtioDma.VirtToPhys((ulong)ack), 1, Virtqueue.VRING_DESC_F_WRITE, 0);
+        ctrl.DisableInterrupts();
+        ctrl.AddAvailable((ushort)d0);
+        if (ctrl.KickPrepare())
+        {
+            _transport.NotifyQueue(_ctrlQueueIndex);
+        }
+
+        bool done = false;
+        for (int spin = 0; spin < CtrlTimeoutSpinCount; spin++)
+        {
+            if (ctrl.GetUsedBuffer(out _, out _))
+            {
+                done = true;
+                break;
+            }
+        }
+
+        ctrl.FreeDescriptor(d2);
+        ctrl.FreeDescriptor(d1);
+        ctrl.FreeDescriptor(d0);
+
+        return done && *ack == VIRTIO_NET_OK;
+    }
+
+    private QueuePair CurrentPair()
+    {
+        return _pairs[(int)(SchedulerManager.GetCurrentCpuId() % (uint)_pairCount)];
+    }
+
+    /// <summary>
+    /// Copies one frame into a free TX descriptor and adds it to the ring
+    /// without notifying. Caller must hold the pair's lock.
+    /// </summary>
+    private bool QueueTxLocked(QueuePair pair, byte[] data, int length)
+    {
+        Virtqueue tx = pair.Tx;
+        if (tx.FreeCount == 0)
+        {
+            ReclaimTxLocked(pair);
+        }
+
+        int descIdx = tx.AllocDescriptor();
+        if (descIdx < 0)
+        {
+            Serial.Write("[VirtioNet] No TX descriptors available\n");
+            return false;
+        }
+
+        if (length > data.Length)
+        {
+            length = data.Length;
+        }
+        if (length > RX_BUFFER_SIZE - _headerSize)
+        {
+            length = RX_BUFFER_SIZE - _headerSize;
+        }
+
+        byte* buf = pair.TxBuffers[descIdx];
+
+        // Clear virtio-net header, then copy packet data
+        MemoryOp.MemSet(buf, 0, _headerSize);
+        fixed (byte* src = data)
+        {
+            MemoryOp.MemCopy(buf + _headerSize, src, length);
+        }
+
+        tx.SetupDescriptor(descIdx, VirtioDma.VirtToPhys((ulong)buf), (uint)(_headerSize + length), 0, 0);
+        tx.AddAvailable((ushort)descIdx);
+        return true;
+    }
+
+    /// <summary>Notifies the device of queued TX chains if it wants to hear. Caller must hold the pair's lock.</summary>
+    private void KickTxLocked(QueuePair pair)
+    {
+        if (pair.Tx.KickPrepare())
+        {
+            _transport.NotifyQueue(pair.TxIndex);
+        }
     }
 
     private void OnDeviceInterrupt(uint isrStatus)
@@ -289,57 +496,81 @@ public unsafe class VirtioNet : INetworkDevice
             return;
         }
 
-        // Process used buffers
+        // The shared vector (MMIO, or PCI queues without a vector of their
+        // own) does not say which ring moved: service them all.
         if ((isrStatus & VirtioTransport.IsrQueue) != 0)
         {
-            ProcessRx();
+            for (int i = 0; i < _pairCount; i++)
+            {
+                QueuePair pair = _pairs[i];
+                ProcessRx(pair);
 
-            using IrqLockScope scope = _queueLock.AcquireIrqSafe();
-            ReclaimTxLocked();
+                using IrqLockScope scope = pair.Lock.AcquireIrqSafe();
+                ReclaimTxLocked(pair);
+            }
         }
     }
 
-    private void ProcessRx()
+    private void OnQueueInterrupt(ushort queueIndex)
     {
-        if (_rxQueue == null || _rxBuffers == null)
+        int pairIndex = queueIndex / 2;
+        if (!_networkInitialized || pairIndex >= _pairCount)
         {
             return;
         }
 
-        bool received = false;
+        QueuePair pair = _pairs[pairIndex];
+        if (queueIndex == pair.RxIndex)
+        {
+            ProcessRx(pair);
+        }
+        else
+        {
+            using IrqLockScope scope = pair.Lock.AcquireIrqSafe();
+            ReclaimTxLocked(pair);
+        }
+    }
+
+    private void ProcessRx(QueuePair pair)
+    {
+        Virtqueue rx = pair.Rx;
         while (true)
         {
             // Pop and recycle one used buffer under the queue lock, but
             // deliver the packet outside it: the network stack sends replies
             // (ARP, TCP ACKs) from OnPacketReceived, and Send takes the lock.
             byte[]? packet = null;
-            using (IrqLockScope scope = _queueLock.AcquireIrqSafe())
+            using (IrqLockScope scope = pair.Lock.AcquireIrqSafe())
             {
-                if (!_rxQueue.GetUsedBuffer(out uint id, out uint len))
+                if (!rx.GetUsedBuffer(out uint id, out uint len))
                 {
-                    break;
+                    // Re-arm the used-ring interrupt; if more buffers landed
+                    // meanwhile their interrupt may be suppressed, so go on.
+                    if (rx.EnableInterrupts())
+                    {
+                        break;
+                    }
+                    continue;
                 }
 
-                if (id < _rxQueue.QueueSize && len > _headerSize)
+                if (id < rx.QueueSize && len > _headerSize)
                 {
-                    uint dataLen = len - (uint)_headerSize;
+                    int dataLen = (int)len - _headerSize;
                     packet = new byte[dataLen];
-                    byte* src = _rxBuffers[id] + _headerSize;
-                    for (int i = 0; i < dataLen; i++)
+                    fixed (byte* dst = packet)
                     {
-                        packet[i] = src[i];
+                        MemoryOp.MemCopy(dst, pair.RxBuffers[id] + _headerSize, dataLen);
                     }
                 }
 
-                // Return buffer to available ring
-                if (id < _rxQueue.QueueSize)
+                // Return buffer to available ring; the device is notified
+                // once for the whole batch below.
+                if (id < rx.QueueSize)
                 {
-                    _rxQueue.SetupDescriptor((int)id, VirtioDma.VirtToPhys((ulong)_rxBuffers[id]), RX_BUFFER_SIZE,
+                    rx.SetupDescriptor((int)id, VirtioDma.VirtToPhys((ulong)pair.RxBuffers[id]), RX_BUFFER_SIZE,
                         Virtqueue.VRING_DESC_F_WRITE, 0);
-                    _rxQueue.AddAvailable((ushort)id);
+                    rx.AddAvailable((ushort)id);
                 }
-
-                received = true;
             }
 
             if (packet != null)
@@ -348,27 +579,54 @@ public unsafe class VirtioNet : INetworkDevice
             }
         }
 
-        if (received)
+        bool kick;
+        using (IrqLockScope scope = pair.Lock.AcquireIrqSafe())
+        {
+            kick = rx.KickPrepare();
+        }
+
+        if (kick)
         {
             // Notify device that new RX buffers are available
-            _transport.NotifyQueue(RX_QUEUE);
+            _transport.NotifyQueue(pair.RxIndex);
         }
     }
 
-    /// <summary>Reclaims completed TX descriptors. Caller must hold _queueLock.</summary>
-    private void ReclaimTxLocked()
+    /// <summary>Reclaims completed TX descriptors. Caller must hold the pair's lock.</summary>
+    private static void ReclaimTxLocked(QueuePair pair)
     {
-        if (_txQueue == null)
+        Virtqueue tx = pair.Tx;
+        while (tx.GetUsedBuffer(out uint id, out uint len))
         {
-            return;
+            if (id < tx.QueueSize)
+            {
+                tx.FreeDescriptor((int)id);
+            }
         }
+    }
 
-        while (_txQueue.GetUsedBuffer(out uint id, out uint len))
+    /// <summary>One receiveq/transmitq pair and the buffers behind it.</summary>
+    private sealed class QueuePair
+    {
+        public readonly Virtqueue Rx;
+        public readonly Virtqueue Tx;
+        public readonly ushort RxIndex;
+        public readonly ushort TxIndex;
+        public byte** RxBuffers;
+        public byte** TxBuffers;
+
+        // Guards both rings' free lists and used-ring cursors, which are
+        // touched from both thread context (Send) and interrupt context.
+        // Never held across OnPacketReceived — the network stack sends
+        // replies from that callback, which would self-deadlock.
+        public SchedSpinLock Lock;
+
+        public QueuePair(Virtqueue rx, ushort rxIndex, Virtqueue tx, ushort txIndex)
         {
-            if (id < _txQueue.QueueSize)
-            {
-                _txQueue.FreeDescriptor((int)id);
-            }
+            Rx = rx;
+            RxIndex = rxIndex;
+            Tx = tx;
+            TxIndex = txIndex;
         }
     }
 }
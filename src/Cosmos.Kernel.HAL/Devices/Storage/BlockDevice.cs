@@ -30,6 +30,53 @@ public abstract class BlockDevice : Device, IBlockDevice
     {
     }
 
+    /// <summary>
+    /// Executes a scatter-gather list of reads and writes and returns once
+    /// every request has completed. Devices with a hardware queue keep
+    /// several commands in flight; the order requests complete in is not
+    /// defined, so a batch must not read and write the same blocks. Throws
+    /// on the first failure, like <see cref="ReadBlock"/>.
+    /// </summary>
+    /// <remarks>The default runs the requests one at a time through <see cref="ReadBlock"/> / <see cref="WriteBlock"/>.</remarks>
+    public virtual void SubmitBatch(ReadOnlySpan<BlockRequest> requests)
+    {
+        for (int i = 0; i < requests.Length; i++)
+        {
+            BlockRequest request = requests[i];
+            Span<byte> data = RequestData(request);
+            if (request.Operation == BlockOperation.Read)
+            {
+                ReadBlock(request.BlockNo, request.BlockCount, data);
+            }
+            else
+            {
+                WriteBlock(request.BlockNo, request.BlockCount, data);
+            }
+        }
+    }
+
+    /// <summary>
+    /// The part of <paramref name="request"/>'s buffer the transfer covers.
+    /// Throws if the buffer cannot hold <see cref="BlockRequest.BlockCount"/> blocks.
+    /// </summary>
+    protected Span<byte> RequestData(in BlockRequest request)
+    {
+        byte[] buffer = request.Buffer ?? throw new ArgumentNullException(nameof(request));
+        if (request.Offset < 0 || request.Offset > buffer.Length)
+        {
+            throw new ArgumentOutOfRangeException(nameof(request), "Request offset outside its buffer.");
+        }
+
+        // Divide form, as in NvmeNamespace: blockCount * BlockSize can overflow.
+        ulong room = (ulong)(buffer.Length - request.Offset);
+        if (request.BlockCount > room / BlockSize)
+        {
+            throw new ArgumentOutOfRangeException(nameof(request), "Buffer shorter than the requested transfer.");
+        }
+
+        return buffer.AsSpan(request.Offset, (int)(request.BlockCount * BlockSize));
+    }
+
     // Device ctors run during early kernel init (before exception handlers
     // and the late module initializers), where CoreLib int formatting
     // (ToString / "" + int / $"") reproducibly triple-faults even though it
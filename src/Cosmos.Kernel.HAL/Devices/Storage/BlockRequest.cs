@@ -0,0 +1,44 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+namespace Cosmos.Kernel.HAL.Devices.Storage;
+
+/// <summary>Direction of a <see cref="BlockRequest"/>.</summary>
+public enum BlockOperation : byte
+{
+    Read,
+    Write
+}
+
+/// <summary>
+/// One element of a <see cref="BlockDevice.SubmitBatch"/> scatter-gather
+/// list: <see cref="BlockCount"/> blocks starting at <see cref="BlockNo"/>,
+/// moved to or from <see cref="Buffer"/> at <see cref="Offset"/>.
+/// </summary>
+public readonly struct BlockRequest
+{
+    public BlockOperation Operation { get; }
+    public ulong BlockNo { get; }
+    public ulong BlockCount { get; }
+    public byte[] Buffer { get; }
+    public int Offset { get; }
+
+    public BlockRequest(BlockOperation operation, ulong blockNo, ulong blockCount, byte[] buffer, int offset)
+    {
+        Operation = operation;
+        BlockNo = blockNo;
+        BlockCount = blockCount;
+        Buffer = buffer;
+        Offset = offset;
+    }
+
+    /// <summary>Request to read <paramref name="blockCount"/> blocks into <paramref name="buffer"/>.</summary>
+    public static BlockRequest Read(ulong blockNo, ulong blockCount, byte[] buffer, int offset = 0) =>
+        new(BlockOperation.Read, blockNo, blockCount, buffer, offset);
+
+    /// <summary>Request to write <paramref name="blockCount"/> blocks from <paramref name="buffer"/>.</summary>
+    public static BlockRequest Write(ulong blockNo, ulong blockCount, byte[] buffer, int offset = 0) =>
+        new(BlockOperation.Write, blockNo, blockCount, buffer, offset);
+
+    /// <summary>The same request moved to <paramref name="blockNo"/>, for devices that remap LBAs (partitions).</summary>
+    public BlockRequest WithBlockNo(ulong blockNo) => new(Operation, blockNo, BlockCount, Buffer, Offset);
+}
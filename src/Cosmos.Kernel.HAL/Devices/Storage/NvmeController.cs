@@ -7,32 +7,55 @@ using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Memory;
 using Cosmos.Kernel.Core.Scheduler;
 using Cosmos.Kernel.HAL.Pci;
-using SchedMutex = Cosmos.Kernel.Core.Scheduler.Mutex;
 using SchedSpinLock = Cosmos.Kernel.Core.Scheduler.SpinLock;
 using SchedThread = Cosmos.Kernel.Core.Scheduler.Thread;
 
 namespace Cosmos.Kernel.HAL.Devices.Storage;
 
 /// <summary>
-/// One initialized NVMe controller. Owns its admin and a single IO
-/// queue pair, and the namespaces it discovered. The admin queue is
-/// polled (it only runs once at init); the I/O queue is interrupt-driven
-/// via MSI-X so callers of <see cref="Read"/> / <see cref="Write"/> can
-/// yield instead of burning a CPU on a spinloop, and up to
-/// <see cref="IoQueueDepth"/>-1 commands can be in flight concurrently
-/// because every slot owns its own 4 KiB DMA bounce buffer.
+/// One single-block transfer of a <see cref="NvmeController.Transfer"/>
+/// batch. <see cref="Data"/> must stay valid until the batch returns.
+/// </summary>
+internal readonly unsafe struct NvmeBlockTransfer
+{
+    public readonly ulong Lba;
+    public readonly byte* Data;
+    public readonly bool Write;
+
+    public NvmeBlockTransfer(ulong lba, byte* data, bool write)
+    {
+        Lba = lba;
+        Data = data;
+        Write = write;
+    }
+}
+
+/// <summary>
+/// One initialized NVMe controller. Owns its admin queue, one I/O queue
+/// pair per CPU (as many as the controller grants and MSI-X has vectors
+/// for), and the namespaces it discovered. The admin queue is polled (it
+/// only runs once at init); each I/O completion queue is interrupt-driven
+/// via its own MSI-X entry, so callers of <see cref="Read"/> /
+/// <see cref="Write"/> can yield instead of burning a CPU on a spinloop, and
+/// up to depth-1 commands per queue can be in flight concurrently because
+/// every slot owns its own 4 KiB DMA bounce buffer. A caller submits on its
+/// own CPU's queue, so CPUs do not contend on a doorbell.
+///
+/// <para>Threads flagged <see cref="ThreadFlags.PolledIo"/> spin on the CQ
+/// phase bit for a while before sleeping on the interrupt (hybrid polling),
+/// trading CPU time for the interrupt and wakeup latency.</para>
 ///
 /// <para>If MSI-X is unavailable (e.g. ARM64 today, or a pathological
 /// PCI device with no MSI-X capability) the controller falls back to
-/// polled completion, but in that mode commands are serialized through
-/// an internal mutex.</para>
+/// polled completion: a waiter drains the CQ itself until its command
+/// completes.</para>
 ///
 /// Limitations:
 /// <list type="bullet">
-/// <item>One IO submission and one IO completion queue (qid=1), depth 8.
-/// At most depth-1 commands are in flight (NVMe queue-full rule: a
-/// depth-N SQ holds N-1 entries, or the wrapped tail is indistinguishable
-/// from an empty queue).</item>
+/// <item>Queue depth is CAP.MQES capped at <see cref="MaxIoQueueDepth"/>.
+/// At most depth-1 commands are in flight per queue (NVMe queue-full rule:
+/// a depth-N SQ holds N-1 entries, or the wrapped tail is
+/// indistinguishable from an empty queue).</item>
 /// <item>Single-PRP transfers — every command moves at most one 4 KiB
 /// page through the slot's bounce buffer, so PRP2 is always 0. Namespaces
 /// whose LBA format exceeds one page (or carries metadata) are skipped at
@@ -42,8 +65,13 @@ namespace Cosmos.Kernel.HAL.Devices.Storage;
 public unsafe class NvmeController
 {
     private const uint AdminQueueDepth = 8;
-    private const uint IoQueueDepth = 8;
-    private const uint IoQueueId = 1;
+
+    /// <summary>Deepest I/O queue the driver creates: each slot pins a 4 KiB bounce page, so depth bounds memory per queue.</summary>
+    private const uint MaxIoQueueDepth = 32;
+    /// <summary>Shallowest usable I/O queue: depth 2 holds one command (queue-full rule).</summary>
+    private const uint MinIoQueueDepth = 2;
+    /// <summary>Upper bound on I/O queue pairs, whatever the CPU count and controller allow.</summary>
+    private const int MaxIoQueues = 8;
 
     /// <summary>Size of one Submission Queue Entry in bytes (NVMe 1.4 §4.2, fixed 64-byte SQE).</summary>
     private const int SqeSizeBytes = 64;
@@ -75,6 +103,8 @@ public unsafe class NvmeController
     private const uint MicrosecondsPerMillisecond = 1000;
     /// <summary>Spin/wait budget (iterations) before a command completion is declared timed out.</summary>
     private const int CommandTimeoutSpinCount = 50_000_000;
+    /// <summary>CQ phase checks a <see cref="ThreadFlags.PolledIo"/> thread makes before sleeping on the interrupt.</summary>
+    private const int HybridPollSpinCount = 200_000;
 
     /// <summary>Mask selecting the low 32 bits of the starting LBA for CDW10 (NVMe 1.4 §6.9, SLBA[31:0]).</summary>
     private const uint LbaLowDwordMask = 0xFFFFFFFF;
@@ -90,9 +120,16 @@ public unsafe class NvmeController
     private const uint Cdw11PhysicallyContiguous = 1u;
     /// <summary>Bit position of the completion queue ID field in Create IO SQ CDW11 (CQID, bits [31:16]).</summary>
     private const int Cdw11CqidShift = 16;
-    /// <summary>Minimum MSI-X table size needed to park the I/O CQ on entry 1, away from admin IV 0.</summary>
+    /// <summary>Minimum MSI-X table size needed to park the I/O CQs on entries 1.., away from admin IV 0.</summary>
     private const int MsiXMinEntriesForDedicatedIoVector = 2;
 
+    /// <summary>Feature Identifier of Number of Queues for Set Features (NVMe 1.4 §5.21.1.7).</summary>
+    private const uint FeatureNumberOfQueues = 0x07;
+    /// <summary>Bit position of NCQR in the Number of Queues CDW11 / NCQA in its completion DW0 (bits [31:16]).</summary>
+    private const int NumberOfQueuesCqShift = 16;
+    /// <summary>Mask of NSQR / NSQA (bits [15:0], 0's-based).</summary>
+    private const uint NumberOfQueuesMask = 0xFFFF;
+
     /// <summary>Maximum NSIDs returned by Identify Active Namespace List (one 4 KiB page of 32-bit NSIDs).</summary>
     private const int MaxActiveNamespaceIds = 1024;
     /// <summary>Byte offset of FLBAS in the Identify Namespace data structure (NVMe 1.4 §5.15.2).</summary>
@@ -122,6 +159,59 @@ public unsafe class NvmeController
         public ulong DmaBufferPhys;
     }
 
+    /// <summary>
+    /// One I/O submission/completion queue pair (same qid for both) and the
+    /// slots whose CIDs it hands out.
+    /// </summary>
+    private sealed class IoQueue
+    {
+        private readonly NvmeController _controller;
+
+        public readonly ushort Qid;
+        public readonly uint Depth;
+        public readonly IoSlot[] Slots;
+        public readonly List<SchedThread> SlotWaiters = [];
+
+        public ulong SqVirt;
+        public ulong CqVirt;
+        public ulong SqPhys;
+        public ulong CqPhys;
+        public uint SqTail;
+        public uint CqHead;
+        public bool CqPhase;
+        public int MsiXEntry = -1;
+
+        // SlotLock guards the slot in-use bits and SlotWaiters. SqLock
+        // guards SqTail + the doorbell so concurrent submits don't clobber
+        // it. CqLock guards CqHead/CqPhase, shared by the MSI-X handler and
+        // waiters that poll; IRQ-safe because the handler takes it.
+        public SchedSpinLock SlotLock;
+        public SchedSpinLock SqLock;
+        public SchedSpinLock CqLock;
+
+        public IoQueue(NvmeController controller, ushort qid, uint depth)
+        {
+            _controller = controller;
+            Qid = qid;
+            Depth = depth;
+
+            // Depth-1 slots: a depth-N submission queue holds at most N-1
+            // outstanding entries (NVMe 1.4 §4.1) — with N in flight the
+            // wrapped tail equals the head and the controller reads the queue
+            // as empty, silently losing a command.
+            Slots = new IoSlot[depth - 1];
+            for (int i = 0; i < Slots.Length; i++)
+            {
+                IoSlot slot = new();
+                slot.DmaBufferVirt = (ulong)PageAllocator.AllocPages(PageType.Unmanaged, 1, true);
+                slot.DmaBufferPhys = PageAllocator.VirtualToPhysical(slot.DmaBufferVirt);
+                Slots[i] = slot;
+            }
+        }
+
+        public void OnInterrupt(ref IRQContext context) => _controller.OnIoCompletion(this);
+    }
+
     private readonly PciDevice _pci;
     private readonly NvmeRegisters _regs;
 
@@ -135,32 +225,12 @@ public unsafe class NvmeController
     private bool _adminCqPhase;
     private ushort _adminCmdId;
 
-    // IO queue
-    private ulong _ioSqVirt;
-    private ulong _ioCqVirt;
-    private ulong _ioSqPhys;
-    private ulong _ioCqPhys;
-    private uint _ioSqTail;
-    private uint _ioCqHead;
-    private bool _ioCqPhase;
-
-    // I/O completion plumbing (MSI-X driven when possible).
+    // I/O queues, indexed by CPU modulo their count. Completions are MSI-X
+    // driven when possible.
+    private IoQueue[] _ioQueues = [];
     private MsiXContext _msiX;
     private bool _msiXEnabled;
-    private int _ioMsiXEntry;
-    private IoSlot[]? _ioSlots;
-
-    // Slot allocation. SpinLock guards both the slot in-use bits and the
-    // _slotWaiters queue. SubmitSqLock guards the SQ tail + doorbell
-    // critical section so concurrent submits don't clobber _ioSqTail.
-    private SchedSpinLock _slotLock;
-    private SchedSpinLock _submitSqLock;
-    private readonly List<SchedThread> _slotWaiters = [];
-
-    // Polled-completion fallback path: serializes the entire submit/wait
-    // sequence so concurrent callers don't race on _ioCqHead / _ioCqPhase.
-    // Unused once MSI-X is enabled.
-    private readonly SchedMutex _polledIoMutex = new();
+    private ulong _polledCompletions;
 
     public List<NvmeNamespace> Namespaces { get; } = new();
 
@@ -173,6 +243,18 @@ public unsafe class NvmeController
     /// </summary>
     public bool IsMsiXEnabled => _msiXEnabled;
 
+    /// <summary>Number of I/O queue pairs created (at most one per CPU).</summary>
+    public int IoQueueCount => _ioQueues.Length;
+
+    /// <summary>Entries per I/O queue; depth-1 commands fit in flight on each.</summary>
+    public uint IoQueueDepth => _ioQueues.Length > 0 ? _ioQueues[0].Depth : 0;
+
+    /// <summary>
+    /// Commands whose completion a hybrid-polling waiter reaped off the CQ
+    /// before the interrupt did. Diagnostics only; updated without locking.
+    /// </summary>
+    public ulong PolledCompletions => _polledCompletions;
+
     /// <summary>
     /// Zero-based index of this controller in PCI discovery order. Used to
     /// build unique namespace device names ("nvme0n1" style).
@@ -214,19 +296,18 @@ public unsafe class NvmeController
 
     /// <summary>
     /// Bring the controller up: reset, set up admin queues, identify
-    /// controller and namespaces, create one IO queue pair, register
+    /// controller and namespaces, create the IO queue pairs, register
     /// each namespace as a BlockDevice.
     /// </summary>
     public void Initialize()
     {
-        // NVMe 1.4: a queue may not exceed CAP.MQES+1 entries. Our fixed
-        // depth is tiny (8), but a controller reporting less would silently
-        // get an out-of-spec queue size (Invalid Queue Size on create, or
-        // worse) — fail init cleanly instead; Nvme.Initialize's per-
-        // controller catch skips the device.
-        if (_regs.MQES < IoQueueDepth)
+        // NVMe 1.4: a queue may not exceed CAP.MQES+1 entries. The I/O
+        // depth is taken from MQES, but a controller that cannot hold even
+        // one command per queue is unusable — fail init cleanly;
+        // Nvme.Initialize's per-controller catch skips the device.
+        if (_regs.MQES < MinIoQueueDepth)
         {
-            throw new Exception("[NVMe] Controller MQES below the driver's queue depth");
+            throw new Exception("[NVMe] Controller MQES below the driver's minimum queue depth");
         }
 
         DisableController();
@@ -249,48 +330,89 @@ public unsafe class NvmeController
     }
 
     /// <summary>
-    /// Allocate per-slot DMA buffers + InterruptEvent, enable MSI-X on
-    /// the device, allocate an interrupt vector, and program the MSI-X
-    /// table to deliver to it. Falls back to polled mode if the device
-    /// has no MSI-X cap or the platform has no MSI routing backend.
+    /// Decide how many I/O queue pairs to run, enable MSI-X on the device,
+    /// and allocate each queue with its slots' DMA buffers + InterruptEvent
+    /// and its own MSI-X entry. Falls back to polled mode if the device has
+    /// no MSI-X cap or the platform has no MSI routing backend.
     /// </summary>
     private void SetupIoCompletionPlumbing()
     {
-        // Depth-1 slots: a depth-N submission queue holds at most N-1
-        // outstanding entries (NVMe 1.4 §4.1) — with N in flight the
-        // wrapped tail equals the head and the controller reads the queue
-        // as empty, silently losing a command.
-        _ioSlots = new IoSlot[IoQueueDepth - 1];
-        for (int i = 0; i < _ioSlots.Length; i++)
-        {
-            IoSlot slot = new();
-            slot.DmaBufferVirt = (ulong)PageAllocator.AllocPages(PageType.Unmanaged, 1, true);
-            slot.DmaBufferPhys = PageAllocator.VirtualToPhysical(slot.DmaBufferVirt);
-            _ioSlots[i] = slot;
-        }
+        uint depth = Math.Min(_regs.MQES, MaxIoQueueDepth);
+        uint cpus = PlatformHAL.Initializer?.GetCpuCount() ?? 1;
+        int wanted = (int)Math.Min(cpus, (uint)MaxIoQueues);
 
         MsiXContext? ctx = MsiX.Enable(_pci);
         if (ctx == null)
         {
             Serial.WriteString("[NVMe] MSI-X unavailable, falling back to polled I/O\n");
-            return;
+        }
+        else
+        {
+            _msiX = ctx.Value;
+            _msiXEnabled = true;
+            // The admin CQ is hardwired to IV 0, so parking an IO CQ there
+            // means every admin completion after MSI-X enable fires its
+            // handler spuriously. IO CQs take entries 1.. while the table
+            // has them; entry 0 stays masked (admin commands are polled).
+            if (_msiX.EntryCount >= MsiXMinEntriesForDedicatedIoVector)
+            {
+                wanted = Math.Min(wanted, _msiX.EntryCount - 1);
+            }
+            else
+            {
+                wanted = 1;
+            }
         }
 
-        _msiX = ctx.Value;
-        // The binder allocates the underlying vector / LPI itself (x64 IDT
-        // vector or ARM64 LPI INTID) and wires it to OnIoCompletion. Use
-        // entry 1 when the table has one: the admin CQ is hardwired to
-        // IV 0, so parking the IO CQ there means every admin completion
-        // after MSI-X enable fires OnIoCompletion spuriously. Entry 0
-        // stays masked (admin commands are polled), so admin completions
-        // interrupt nobody.
-        _ioMsiXEntry = _msiX.EntryCount >= MsiXMinEntriesForDedicatedIoVector ? 1 : 0;
-        MsiX.SetEntry(_msiX, _ioMsiXEntry, OnIoCompletion);
-        _msiXEnabled = true;
-
-        Serial.WriteString("[NVMe] I/O CQ -> MSI-X entry ");
-        Serial.WriteNumber((uint)_ioMsiXEntry);
-        Serial.WriteString("\n");
+        if (wanted > 1)
+        {
+            wanted = NegotiateQueueCount(wanted);
+        }
+
+        _ioQueues = new IoQueue[wanted];
+        for (int i = 0; i < wanted; i++)
+        {
+            IoQueue queue = new(this, (ushort)(i + 1), depth);
+            if (_msiXEnabled)
+            {
+                // The binder allocates the underlying vector / LPI itself
+                // (x64 IDT vector or ARM64 LPI INTID) and wires it to the
+                // queue's handler.
+                queue.MsiXEntry = _msiX.EntryCount >= MsiXMinEntriesForDedicatedIoVector ? i + 1 : 0;
+                MsiX.SetEntry(_msiX, queue.MsiXEntry, queue.OnInterrupt);
+
+                Serial.WriteString("[NVMe] I/O CQ ");
+                Serial.WriteNumber(queue.Qid);
+                Serial.WriteString(" -> MSI-X entry ");
+                Serial.WriteNumber((uint)queue.MsiXEntry);
+                Serial.WriteString("\n");
+            }
+            _ioQueues[i] = queue;
+        }
+    }
+
+    /// <summary>
+    /// Set Features (Number of Queues): ask for <paramref name="wanted"/>
+    /// SQ/CQ pairs and return how many the controller granted, or 1 if the
+    /// command fails — every controller supports at least one.
+    /// </summary>
+    private int NegotiateQueueCount(int wanted)
+    {
+        uint requested = (uint)(wanted - 1);
+        uint cdw11 = (requested << NumberOfQueuesCqShift) | requested;
+        uint sc = SubmitAdmin(NvmeAdminOp.SetFeatures, nsid: 0, prp1: 0, cdw10: FeatureNumberOfQueues, cdw11: cdw11, cdw12: 0, out uint result);
+        if (sc != 0)
+        {
+            Serial.WriteString("[NVMe] Set Features (Number of Queues) failed, status=0x");
+            Serial.WriteHex(sc);
+            Serial.WriteString("\n");
+            return 1;
+        }
+
+        uint sqAllocated = (result & NumberOfQueuesMask) + 1;
+        uint cqAllocated = ((result >> NumberOfQueuesCqShift) & NumberOfQueuesMask) + 1;
+        uint granted = Math.Min(sqAllocated, cqAllocated);
+        return granted < (uint)wanted ? (int)granted : wanted;
     }
 
     private void DisableController()
@@ -357,7 +479,15 @@ public unsafe class NvmeController
     /// Submit an admin command and poll for its completion.
     /// Returns the CQE status code (0 = success).
     /// </summary>
-    private uint SubmitAdmin(byte opcode, uint nsid, ulong prp1, uint cdw10, uint cdw11, uint cdw12)
+    private uint SubmitAdmin(byte opcode, uint nsid, ulong prp1, uint cdw10, uint cdw11, uint cdw12) =>
+        SubmitAdmin(opcode, nsid, prp1, cdw10, cdw11, cdw12, out _);
+
+    /// <summary>
+    /// <see cref="SubmitAdmin(byte, uint, ulong, uint, uint, uint)"/> that
+    /// also hands back the command-specific CQE DW0 (e.g. the queue counts
+    /// granted by Set Features).
+    /// </summary>
+    private uint SubmitAdmin(byte opcode, uint nsid, ulong prp1, uint cdw10, uint cdw11, uint cdw12, out uint result)
     {
         ushort cid = _adminCmdId++;
 
@@ -377,34 +507,36 @@ public unsafe class NvmeController
         PlatformHAL.Initializer?.DmaBarrier();
         Native.MMIO.Write32(_regs.SubmissionDoorbell(0), _adminSqTail);
 
-        return WaitCompletion(_adminCqVirt, ref _adminCqHead, ref _adminCqPhase, AdminQueueDepth, qid: 0, expectCid: cid);
+        return WaitCompletion(_adminCqVirt, ref _adminCqHead, ref _adminCqPhase, AdminQueueDepth, qid: 0, expectCid: cid, out result);
     }
 
     /// <summary>
     /// Read <paramref name="dst"/>.Length bytes (must equal block size *
     /// (numLogicalBlocksMinusOne+1)) starting at LBA <paramref name="lba"/>
-    /// from namespace <paramref name="nsid"/>. Thread-safe — multiple
-    /// callers run on independent slots up to <see cref="IoQueueDepth"/>-1.
+    /// from namespace <paramref name="nsid"/>. Thread-safe — callers on one
+    /// CPU run on independent slots of that CPU's queue, up to
+    /// <see cref="IoQueueDepth"/>-1.
     /// </summary>
     public uint Read(uint nsid, ulong lba, Span<byte> dst, ushort numLogicalBlocksMinusOne)
     {
         ValidateTransfer(dst.Length, numLogicalBlocksMinusOne);
-        int slotIndex = AcquireSlot();
+        IoQueue queue = CurrentQueue();
+        int slotIndex = AcquireSlot(queue);
         try
         {
-            IoSlot slot = _ioSlots![slotIndex];
-            uint sc = SubmitOnSlot(NvmeIoOp.Read, nsid, slotIndex, lba, numLogicalBlocksMinusOne);
+            IoSlot slot = queue.Slots[slotIndex];
+            uint sc = SubmitOnSlot(queue, NvmeIoOp.Read, nsid, slotIndex, lba, numLogicalBlocksMinusOne);
             if (sc == 0)
             {
                 CopyOut(slot.DmaBufferVirt, dst);
             }
 
-            ReleaseSlot(slotIndex);
+            ReleaseSlot(queue, slotIndex);
             return sc;
         }
         catch
         {
-            QuarantineSlot(slotIndex);
+            QuarantineSlot(queue, slotIndex);
             throw;
         }
     }
@@ -416,10 +548,11 @@ public unsafe class NvmeController
     public uint Write(uint nsid, ulong lba, ReadOnlySpan<byte> src, ushort numLogicalBlocksMinusOne)
     {
         ValidateTransfer(src.Length, numLogicalBlocksMinusOne);
-        int slotIndex = AcquireSlot();
+        IoQueue queue = CurrentQueue();
+        int slotIndex = AcquireSlot(queue);
         try
         {
-            IoSlot slot = _ioSlots![slotIndex];
+            IoSlot slot = queue.Slots[slotIndex];
             CopyIn(src, slot.DmaBufferVirt);
             if ((ulong)src.Length < PageAllocator.PageSize)
             {
@@ -429,14 +562,14 @@ public unsafe class NvmeController
                 // disk — zero the tail so short writes are deterministic.
                 MemoryOp.MemSet((byte*)(slot.DmaBufferVirt + (ulong)src.Length), 0, (int)(PageAllocator.PageSize - (ulong)src.Length));
             }
-            uint sc = SubmitOnSlot(NvmeIoOp.Write, nsid, slotIndex, lba, numLogicalBlocksMinusOne);
+            uint sc = SubmitOnSlot(queue, NvmeIoOp.Write, nsid, slotIndex, lba, numLogicalBlocksMinusOne);
 
-            ReleaseSlot(slotIndex);
+            ReleaseSlot(queue, slotIndex);
             return sc;
         }
         catch
         {
-            QuarantineSlot(slotIndex);
+            QuarantineSlot(queue, slotIndex);
             throw;
         }
     }
@@ -444,21 +577,122 @@ public unsafe class NvmeController
     /// <summary>Flush volatile write cache for namespace <paramref name="nsid"/>.</summary>
     public uint Flush(uint nsid)
     {
-        int slotIndex = AcquireSlot();
+        IoQueue queue = CurrentQueue();
+        int slotIndex = AcquireSlot(queue);
         try
         {
-            uint sc = SubmitOnSlot(NvmeIoOp.Flush, nsid, slotIndex, 0, 0);
+            uint sc = SubmitOnSlot(queue, NvmeIoOp.Flush, nsid, slotIndex, 0, 0);
 
-            ReleaseSlot(slotIndex);
+            ReleaseSlot(queue, slotIndex);
             return sc;
         }
         catch
         {
-            QuarantineSlot(slotIndex);
+            QuarantineSlot(queue, slotIndex);
             throw;
         }
     }
 
+    /// <summary>
+    /// Run a list of single-block reads/writes at queue depth &gt; 1: as many
+    /// transfers as the current CPU's queue has free slots are written to
+    /// its SQ behind one doorbell, then reaped together, until the list is
+    /// done. Returns 0, or the status of the first failed transfer with its
+    /// index in <paramref name="failedIndex"/> (later transfers are not
+    /// issued once a group reports a failure).
+    /// </summary>
+    internal uint Transfer(uint nsid, ReadOnlySpan<NvmeBlockTransfer> transfers, int blockSize, out int failedIndex)
+    {
+        ValidateTransfer(blockSize, 0);
+        failedIndex = -1;
+
+        IoQueue queue = CurrentQueue();
+        Span<int> slots = stackalloc int[queue.Slots.Length];
+        int done = 0;
+        while (done < transfers.Length)
+        {
+            // Block for the first slot only; take whatever else is free
+            // right now rather than waiting for a full group.
+            int count = 0;
+            slots[count++] = AcquireSlot(queue);
+            while (count < slots.Length && done + count < transfers.Length)
+            {
+                int next = TryAcquireSlot(queue);
+                if (next < 0)
+                {
+                    break;
+                }
+                slots[count++] = next;
+            }
+
+            for (int i = 0; i < count; i++)
+            {
+                NvmeBlockTransfer transfer = transfers[done + i];
+                if (transfer.Write)
+                {
+                    MemoryOp.MemCopy((byte*)queue.Slots[slots[i]].DmaBufferVirt, transfer.Data, blockSize);
+                }
+            }
+
+            queue.SqLock.Acquire();
+            try
+            {
+                for (int i = 0; i < count; i++)
+                {
+                    NvmeBlockTransfer transfer = transfers[done + i];
+                    WriteSqe(queue, transfer.Write ? NvmeIoOp.Write : NvmeIoOp.Read, nsid, slots[i], transfer.Lba, 0);
+                }
+                RingSubmissionDoorbell(queue);
+            }
+            finally
+            {
+                queue.SqLock.Release();
+            }
+
+            uint status = 0;
+            for (int i = 0; i < count; i++)
+            {
+                IoSlot slot = queue.Slots[slots[i]];
+                try
+                {
+                    WaitSlot(queue, slot);
+                }
+                catch
+                {
+                    for (int j = i; j < count; j++)
+                    {
+                        QuarantineSlot(queue, slots[j]);
+                    }
+                    throw;
+                }
+
+                NvmeBlockTransfer transfer = transfers[done + i];
+                if (slot.Status != 0)
+                {
+                    if (status == 0)
+                    {
+                        status = slot.Status;
+                        failedIndex = done + i;
+                    }
+                }
+                else if (!transfer.Write)
+                {
+                    MemoryOp.MemCopy(transfer.Data, (byte*)slot.DmaBufferVirt, blockSize);
+                }
+
+                ReleaseSlot(queue, slots[i]);
+            }
+
+            if (status != 0)
+            {
+                return status;
+            }
+            done += count;
+        }
+
+        return 0;
+    }
+
     /// <summary>
     /// The single-PRP data path moves at most one 4 KiB page per command;
     /// larger transfers would make the device chase PRP2 (always 0 here),
@@ -490,38 +724,48 @@ public unsafe class NvmeController
     /// DMA into a recycled buffer. The (rare) slot leak is the price of
     /// containment.
     /// </summary>
-    private void QuarantineSlot(int index)
+    private static void QuarantineSlot(IoQueue queue, int index)
     {
         Serial.WriteString("[NVMe] Quarantined I/O slot ");
         Serial.WriteNumber((uint)index);
+        Serial.WriteString(" on queue ");
+        Serial.WriteNumber(queue.Qid);
         Serial.WriteString(" (command may still be outstanding)\n");
     }
 
     /// <summary>
-    /// Find a free slot, mark it in-use, and return its index. If every
-    /// slot is in flight, blocks the caller on the slot waiter queue
-    /// until <see cref="ReleaseSlot"/> wakes one. Without a scheduler
-    /// thread context (scheduler feature off, or pre-scheduler boot code)
-    /// there is a single execution context, so a free slot always exists
-    /// and no waiting is ever needed.
+    /// The I/O queue owned by the calling CPU. Queues are created per CPU
+    /// up to what the controller grants, so CPUs beyond that share them
+    /// round-robin.
+    /// </summary>
+    private IoQueue CurrentQueue()
+    {
+        uint cpu = SchedulerManager.IsReady ? SchedulerManager.GetCurrentCpuId() : 0;
+        return _ioQueues[(int)(cpu % (uint)_ioQueues.Length)];
+    }
+
+    /// <summary>
+    /// Find a free slot on <paramref name="queue"/>, mark it in-use, and
+    /// return its index. If every slot is in flight, blocks the caller on
+    /// the queue's slot waiter list until <see cref="ReleaseSlot"/> wakes
+    /// one. Without a scheduler thread context (scheduler feature off, or
+    /// pre-scheduler boot code) there is a single execution context, so a
+    /// free slot always exists and no waiting is ever needed.
     /// </summary>
-    private int AcquireSlot()
+    private static int AcquireSlot(IoQueue queue)
     {
         SchedThread? current = SchedulerManager.IsReady
             ? SchedulerManager.GetCpuState(SchedulerManager.GetCurrentCpuId()).CurrentThread
             : null;
         if (current == null)
         {
-            for (int i = 0; i < _ioSlots!.Length; i++)
+            int index = TryAcquireSlot(queue);
+            if (index < 0)
             {
-                if (!_ioSlots[i].InUse)
-                {
-                    _ioSlots[i].InUse = true;
-                    return i;
-                }
+                throw new InvalidOperationException("NVMe I/O slots exhausted without a scheduler context.");
             }
 
-            throw new InvalidOperationException("NVMe I/O slots exhausted without a scheduler context.");
+            return index;
         }
 
         while (true)
@@ -531,20 +775,17 @@ public unsafe class NvmeController
             // lost-wakeup window — a ReleaseSlot racing in between would
             // ready a still-Running thread and the subsequent BlockThread
             // would bury the wakeup forever.
-            using (_slotLock.AcquireIrqSafe())
+            using (queue.SlotLock.AcquireIrqSafe())
             {
-                for (int i = 0; i < _ioSlots!.Length; i++)
+                int index = FindFreeSlotLocked(queue);
+                if (index >= 0)
                 {
-                    if (!_ioSlots[i].InUse)
-                    {
-                        _ioSlots[i].InUse = true;
-                        return i;
-                    }
+                    return index;
                 }
 
-                if (!_slotWaiters.Contains(current))
+                if (!queue.SlotWaiters.Contains(current))
                 {
-                    _slotWaiters.Add(current);
+                    queue.SlotWaiters.Add(current);
                 }
 
                 SchedulerManager.BlockThread(current.CpuId, current);
@@ -554,16 +795,40 @@ public unsafe class NvmeController
         }
     }
 
-    private void ReleaseSlot(int index)
+    /// <summary>Claim a free slot on <paramref name="queue"/> without waiting; -1 if all are in flight.</summary>
+    private static int TryAcquireSlot(IoQueue queue)
+    {
+        using (queue.SlotLock.AcquireIrqSafe())
+        {
+            return FindFreeSlotLocked(queue);
+        }
+    }
+
+    // Caller holds queue.SlotLock (or is the only execution context).
+    private static int FindFreeSlotLocked(IoQueue queue)
+    {
+        for (int i = 0; i < queue.Slots.Length; i++)
+        {
+            if (!queue.Slots[i].InUse)
+            {
+                queue.Slots[i].InUse = true;
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    private static void ReleaseSlot(IoQueue queue, int index)
     {
         SchedThread? waiter = null;
-        using (_slotLock.AcquireIrqSafe())
+        using (queue.SlotLock.AcquireIrqSafe())
         {
-            _ioSlots![index].InUse = false;
-            if (_slotWaiters.Count > 0)
+            queue.Slots[index].InUse = false;
+            if (queue.SlotWaiters.Count > 0)
             {
-                waiter = _slotWaiters[0];
-                _slotWaiters.RemoveAt(0);
+                waiter = queue.SlotWaiters[0];
+                queue.SlotWaiters.RemoveAt(0);
             }
         }
 
@@ -578,132 +843,180 @@ public unsafe class NvmeController
     /// and wait for the matching CQE. Returns the device's status code
     /// (0 = success). Thread-safe.
     /// </summary>
-    private uint SubmitOnSlot(byte opcode, uint nsid, int slotIndex, ulong lba, ushort numLogicalBlocksMinusOne)
+    private uint SubmitOnSlot(IoQueue queue, byte opcode, uint nsid, int slotIndex, ulong lba, ushort numLogicalBlocksMinusOne)
     {
-        IoSlot slot = _ioSlots![slotIndex];
+        // Submit under the SQ lock, then wait outside it so other threads
+        // can enqueue while this one is parked or polling.
+        queue.SqLock.Acquire();
+        try
+        {
+            WriteSqe(queue, opcode, nsid, slotIndex, lba, numLogicalBlocksMinusOne);
+            RingSubmissionDoorbell(queue);
+        }
+        finally
+        {
+            queue.SqLock.Release();
+        }
+
+        IoSlot slot = queue.Slots[slotIndex];
+        WaitSlot(queue, slot);
+        return slot.Status;
+    }
+
+    /// <summary>
+    /// Write the SQE for <paramref name="slotIndex"/> at the SQ tail and
+    /// advance it. The CID is the slot index. Caller holds queue.SqLock and
+    /// rings the doorbell once it has queued everything it wants to submit.
+    /// </summary>
+    private static void WriteSqe(IoQueue queue, byte opcode, uint nsid, int slotIndex, ulong lba, ushort numLogicalBlocksMinusOne)
+    {
+        IoSlot slot = queue.Slots[slotIndex];
         slot.Status = 0;
-        ushort cid = (ushort)slotIndex;
 
-        if (_msiXEnabled)
+        NvmeSqe sqe = new(queue.SqVirt + (ulong)queue.SqTail * SqeSizeBytes);
+        sqe.SetOpcode(opcode, (ushort)slotIndex);
+        sqe.SetNsid(nsid);
+        sqe.SetPrp1(slot.DmaBufferPhys);
+        sqe.SetPrp2(0);
+        sqe.SetCdw10((uint)(lba & LbaLowDwordMask));
+        sqe.SetCdw11((uint)(lba >> LbaHighDwordShift));
+        sqe.SetCdw12(numLogicalBlocksMinusOne);
+
+        queue.SqTail = (queue.SqTail + 1) % queue.Depth;
+    }
+
+    // Caller holds queue.SqLock.
+    private void RingSubmissionDoorbell(IoQueue queue)
+    {
+        // SQE stores must be visible to the device before the doorbell
+        // store (see SubmitAdmin).
+        PlatformHAL.Initializer?.DmaBarrier();
+        Native.MMIO.Write32(_regs.SubmissionDoorbell(queue.Qid), queue.SqTail);
+    }
+
+    /// <summary>
+    /// Wait until <paramref name="slot"/>'s command has completed and its
+    /// status is in <see cref="IoSlot.Status"/>. Without MSI-X the waiter
+    /// reaps the CQ itself; a <see cref="ThreadFlags.PolledIo"/> thread does
+    /// the same for <see cref="HybridPollSpinCount"/> checks before sleeping
+    /// on the interrupt. Every path consumes the slot's signal, so the event
+    /// is back to unsignaled for the slot's next command.
+    /// </summary>
+    private void WaitSlot(IoQueue queue, IoSlot slot)
+    {
+        if (!_msiXEnabled)
         {
-            // Submit under the SQ lock, then wait outside it so other
-            // threads can enqueue while this one is parked.
-            _submitSqLock.Acquire();
-            try
-            {
-                NvmeSqe sqe = new(_ioSqVirt + (ulong)_ioSqTail * SqeSizeBytes);
-                sqe.SetOpcode(opcode, cid);
-                sqe.SetNsid(nsid);
-                sqe.SetPrp1(slot.DmaBufferPhys);
-                sqe.SetPrp2(0);
-                sqe.SetCdw10((uint)(lba & LbaLowDwordMask));
-                sqe.SetCdw11((uint)(lba >> LbaHighDwordShift));
-                sqe.SetCdw12(numLogicalBlocksMinusOne);
-
-                _ioSqTail = (_ioSqTail + 1) % IoQueueDepth;
-                // SQE stores must be visible to the device before the
-                // doorbell store (see SubmitAdmin).
-                PlatformHAL.Initializer?.DmaBarrier();
-                Native.MMIO.Write32(_regs.SubmissionDoorbell(IoQueueId), _ioSqTail);
-            }
-            finally
+            for (int spin = 0; spin < CommandTimeoutSpinCount; spin++)
             {
-                _submitSqLock.Release();
+                if (slot.Done.IsSignaled || DrainCompletions(queue, slot))
+                {
+                    slot.Done.Wait();
+                    return;
+                }
             }
 
-            // Hang-breaker mirroring the polled fallback's 50M-spin budget:
-            // a lost or misrouted MSI-X message must surface as the same
-            // timeout exception (the caller's catch quarantines the slot)
-            // instead of parking the thread forever with no diagnostic.
-            if (!slot.Done.Wait(CommandTimeoutSpinCount))
+            throw new Exception("[NVMe] Timeout waiting for command completion");
+        }
+
+        if (IsPolledIoThread())
+        {
+            for (int spin = 0; spin < HybridPollSpinCount && !slot.Done.IsSignaled; spin++)
             {
-                throw new Exception("[NVMe] Timeout waiting for command completion");
+                if (DrainCompletions(queue, slot))
+                {
+                    _polledCompletions++;
+                    break;
+                }
             }
-
-            return slot.Status;
         }
 
-        // Polled fallback: the CQ head/phase aren't safe to share, so
-        // serialize the whole submit/wait sequence.
-        _polledIoMutex.Acquire();
-        try
+        // Hang-breaker mirroring the polled fallback's 50M-spin budget:
+        // a lost or misrouted MSI-X message must surface as the same
+        // timeout exception (the caller's catch quarantines the slot)
+        // instead of parking the thread forever with no diagnostic.
+        if (!slot.Done.Wait(CommandTimeoutSpinCount))
         {
-            NvmeSqe sqe = new(_ioSqVirt + (ulong)_ioSqTail * SqeSizeBytes);
-            sqe.SetOpcode(opcode, cid);
-            sqe.SetNsid(nsid);
-            sqe.SetPrp1(slot.DmaBufferPhys);
-            sqe.SetPrp2(0);
-            sqe.SetCdw10((uint)(lba & LbaLowDwordMask));
-            sqe.SetCdw11((uint)(lba >> LbaHighDwordShift));
-            sqe.SetCdw12(numLogicalBlocksMinusOne);
-
-            _ioSqTail = (_ioSqTail + 1) % IoQueueDepth;
-            // SQE stores must be visible to the device before the
-            // doorbell store (see SubmitAdmin).
-            PlatformHAL.Initializer?.DmaBarrier();
-            Native.MMIO.Write32(_regs.SubmissionDoorbell(IoQueueId), _ioSqTail);
-
-            slot.Status = WaitCompletion(_ioCqVirt, ref _ioCqHead, ref _ioCqPhase, IoQueueDepth, qid: IoQueueId, expectCid: cid);
-            return slot.Status;
+            throw new Exception("[NVMe] Timeout waiting for command completion");
         }
-        finally
+    }
+
+    private static bool IsPolledIoThread()
+    {
+        if (!SchedulerManager.IsReady)
         {
-            _polledIoMutex.Release();
+            return false;
         }
+
+        SchedThread? current = SchedulerManager.GetCpuState(SchedulerManager.GetCurrentCpuId())?.CurrentThread;
+        return current != null && (current.Flags & ThreadFlags.PolledIo) != 0;
     }
 
-    /// <summary>
-    /// MSI-X handler for the I/O completion queue. Drains every CQE
-    /// whose phase matches the expected phase, advances the CQ head,
-    /// rings the doorbell, and signals each slot's
-    /// <see cref="InterruptEvent"/>. Performs no allocation and no
-    /// interface dispatch (per the project's ISR-safety rules).
-    /// </summary>
-    private void OnIoCompletion(ref IRQContext context)
+    /// <summary>MSI-X handler body for one I/O completion queue.</summary>
+    private void OnIoCompletion(IoQueue queue)
     {
-        if (_ioSlots == null || _ioCqVirt == 0)
+        if (queue.CqVirt == 0)
         {
             return;
         }
 
-        bool drained = false;
-        while (true)
+        DrainCompletions(queue, null);
+    }
+
+    /// <summary>
+    /// Drain every CQE on <paramref name="queue"/> whose phase matches the
+    /// expected phase, advance the CQ head, ring the doorbell, and signal
+    /// each slot's <see cref="InterruptEvent"/>. Shared by the MSI-X handler
+    /// and polling waiters, so it performs no allocation and no interface
+    /// dispatch (per the project's ISR-safety rules). Returns true if it
+    /// reaped <paramref name="watch"/>'s completion.
+    /// </summary>
+    private bool DrainCompletions(IoQueue queue, IoSlot? watch)
+    {
+        bool reaped = false;
+        using (queue.CqLock.AcquireIrqSafe())
         {
-            NvmeCqe cqe = new(_ioCqVirt + (ulong)_ioCqHead * CqeSizeBytes);
-            if (cqe.Phase != _ioCqPhase)
+            bool drained = false;
+            while (true)
             {
-                break;
-            }
+                NvmeCqe cqe = new(queue.CqVirt + (ulong)queue.CqHead * CqeSizeBytes);
+                if (cqe.Phase != queue.CqPhase)
+                {
+                    break;
+                }
 
-            // Read barrier: don't consume CID/status (or the DMA'd payload
-            // they guard) ahead of the device-written phase bit.
-            PlatformHAL.Initializer?.DmaBarrier();
+                // Read barrier: don't consume CID/status (or the DMA'd payload
+                // they guard) ahead of the device-written phase bit.
+                PlatformHAL.Initializer?.DmaBarrier();
 
-            ushort cid = cqe.CommandIdentifier;
-            uint sc = cqe.StatusCode;
+                ushort cid = cqe.CommandIdentifier;
+                uint sc = cqe.StatusCode;
 
-            _ioCqHead = (_ioCqHead + 1) % IoQueueDepth;
-            if (_ioCqHead == 0)
-            {
-                _ioCqPhase = !_ioCqPhase;
+                queue.CqHead = (queue.CqHead + 1) % queue.Depth;
+                if (queue.CqHead == 0)
+                {
+                    queue.CqPhase = !queue.CqPhase;
+                }
+                drained = true;
+
+                if (cid < queue.Slots.Length)
+                {
+                    IoSlot slot = queue.Slots[cid];
+                    slot.Status = sc;
+                    slot.Done.Signal();
+                    reaped |= ReferenceEquals(slot, watch);
+                }
             }
-            drained = true;
 
-            if (cid < _ioSlots.Length)
+            if (drained)
             {
-                IoSlot slot = _ioSlots[cid];
-                slot.Status = sc;
-                slot.Done.Signal();
+                Native.MMIO.Write32(_regs.CompletionDoorbell(queue.Qid), queue.CqHead);
             }
         }
 
-        if (drained)
-        {
-            Native.MMIO.Write32(_regs.CompletionDoorbell(IoQueueId), _ioCqHead);
-        }
+        return reaped;
     }
 
-    private uint WaitCompletion(ulong cqBase, ref uint head, ref bool expectedPhase, uint depth, uint qid, ushort expectCid)
+    private uint WaitCompletion(ulong cqBase, ref uint head, ref bool expectedPhase, uint depth, uint qid, ushort expectCid, out uint result)
     {
         uint spin = 0;
         while (true)
@@ -718,6 +1031,7 @@ public unsafe class NvmeController
 
                 uint sc = cqe.StatusCode;
                 ushort cid = cqe.CommandIdentifier;
+                result = cqe.CommandSpecific;
 
                 head = (head + 1) % depth;
                 if (head == 0)
@@ -867,38 +1181,48 @@ public unsafe class NvmeController
 
     private void CreateIoQueues()
     {
-        _ioSqVirt = (ulong)PageAllocator.AllocPages(PageType.Unmanaged, 1, true);
-        _ioCqVirt = (ulong)PageAllocator.AllocPages(PageType.Unmanaged, 1, true);
-        _ioSqPhys = PageAllocator.VirtualToPhysical(_ioSqVirt);
-        _ioCqPhys = PageAllocator.VirtualToPhysical(_ioCqVirt);
-        _ioSqTail = 0;
-        _ioCqHead = 0;
-        _ioCqPhase = true;
+        for (int i = 0; i < _ioQueues.Length; i++)
+        {
+            CreateIoQueuePair(_ioQueues[i]);
+        }
+
+        Serial.WriteString("[NVMe] ");
+        Serial.WriteNumber((uint)_ioQueues.Length);
+        Serial.WriteString(" IO queue pair(s) created (depth=");
+        Serial.WriteNumber(IoQueueDepth);
+        Serial.WriteString(")\n");
+    }
+
+    private void CreateIoQueuePair(IoQueue queue)
+    {
+        queue.SqVirt = (ulong)PageAllocator.AllocPages(PageType.Unmanaged, 1, true);
+        queue.CqVirt = (ulong)PageAllocator.AllocPages(PageType.Unmanaged, 1, true);
+        queue.SqPhys = PageAllocator.VirtualToPhysical(queue.SqVirt);
+        queue.CqPhys = PageAllocator.VirtualToPhysical(queue.CqVirt);
+        queue.SqTail = 0;
+        queue.CqHead = 0;
+        queue.CqPhase = true;
 
         // Create IO Completion Queue first — Create IO SQ refers to it.
         // CDW10: bits [31:16] = qsize-1, bits [15:0] = qid
         // CDW11: bits [31:16] = IV (interrupt vector), bit 1 = IEN, bit 0 = PC
-        uint cqCdw10 = ((IoQueueDepth - 1) << CreateQueueCdw10SizeShift) | IoQueueId;
-        uint cqCdw11 = _msiXEnabled ? (((uint)_ioMsiXEntry << Cdw11IvShift) | Cdw11InterruptEnable | Cdw11PhysicallyContiguous) : Cdw11PhysicallyContiguous;
-        uint sc = SubmitAdmin(NvmeAdminOp.CreateIoCq, nsid: 0, prp1: _ioCqPhys, cdw10: cqCdw10, cdw11: cqCdw11, cdw12: 0);
+        uint cqCdw10 = ((queue.Depth - 1) << CreateQueueCdw10SizeShift) | queue.Qid;
+        uint cqCdw11 = _msiXEnabled ? (((uint)queue.MsiXEntry << Cdw11IvShift) | Cdw11InterruptEnable | Cdw11PhysicallyContiguous) : Cdw11PhysicallyContiguous;
+        uint sc = SubmitAdmin(NvmeAdminOp.CreateIoCq, nsid: 0, prp1: queue.CqPhys, cdw10: cqCdw10, cdw11: cqCdw11, cdw12: 0);
         if (sc != 0)
         {
             throw new Exception("[NVMe] Create IO CQ failed");
         }
 
         // Create IO Submission Queue. CDW11: bit 0 = PC, bits [2:1] = QPRIO (0=urgent),
-        // bits [31:16] = CQID.
-        uint sqCdw10 = ((IoQueueDepth - 1) << CreateQueueCdw10SizeShift) | IoQueueId;
-        uint sqCdw11 = (IoQueueId << Cdw11CqidShift) | Cdw11PhysicallyContiguous; // CQID=1, PC=1
-        sc = SubmitAdmin(NvmeAdminOp.CreateIoSq, nsid: 0, prp1: _ioSqPhys, cdw10: sqCdw10, cdw11: sqCdw11, cdw12: 0);
+        // bits [31:16] = CQID (the SQ completes onto the CQ with its own qid).
+        uint sqCdw10 = ((queue.Depth - 1) << CreateQueueCdw10SizeShift) | queue.Qid;
+        uint sqCdw11 = ((uint)queue.Qid << Cdw11CqidShift) | Cdw11PhysicallyContiguous;
+        sc = SubmitAdmin(NvmeAdminOp.CreateIoSq, nsid: 0, prp1: queue.SqPhys, cdw10: sqCdw10, cdw11: sqCdw11, cdw12: 0);
         if (sc != 0)
         {
             throw new Exception("[NVMe] Create IO SQ failed");
         }
-
-        Serial.WriteString("[NVMe] IO queue pair created (qid=1, depth=");
-        Serial.WriteNumber(IoQueueDepth);
-        Serial.WriteString(")\n");
     }
 
     private static void ZeroPage(ulong virtAddr)
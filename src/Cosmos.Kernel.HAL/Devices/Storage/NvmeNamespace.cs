@@ -1,18 +1,24 @@
 // This code is licensed under MIT license (see LICENSE for details)
 
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using Cosmos.Kernel.Core.IO;
 
 namespace Cosmos.Kernel.HAL.Devices.Storage;
 
 /// <summary>
 /// One NVMe namespace exposed as an <see cref="HAL.Interfaces.Devices.IBlockDevice"/>.
-/// Reads and writes are issued one LBA at a time through the parent
-/// controller's per-slot bounce buffers — multiple namespaces (or
-/// concurrent callers on the same namespace) execute in parallel up to
-/// the controller's I/O queue depth minus one (the NVMe queue-full rule).
+/// Every LBA is its own command through one of the parent controller's
+/// per-slot bounce buffers, but multi-block reads/writes and
+/// <see cref="SubmitBatch"/> put as many of those commands in flight at
+/// once as the calling CPU's I/O queue has slots (its depth minus one,
+/// the NVMe queue-full rule), behind a single doorbell write.
 /// </summary>
 public unsafe class NvmeNamespace : BlockDevice
 {
+    /// <summary>Transfers built on the stack per controller batch; bounds stack use, not queue depth.</summary>
+    private const int TransferChunk = 64;
+
     private readonly NvmeController _controller;
     private readonly uint _nsid;
     private readonly string _name;
@@ -45,19 +51,9 @@ public unsafe class NvmeNamespace : BlockDevice
             throw new ArgumentOutOfRangeException(nameof(blockCount), "Span shorter than the requested transfer.");
         }
 
-        for (ulong i = 0; i < blockCount; i++)
+        fixed (byte* p = data)
         {
-            Span<byte> dst = data.Slice((int)((long)i * sector), sector);
-            uint sc = _controller.Read(_nsid, blockNo + i, dst, numLogicalBlocksMinusOne: 0);
-            if (sc != 0)
-            {
-                Serial.WriteString("[NVMe] Read failed lba=");
-                Serial.WriteNumber(blockNo + i);
-                Serial.WriteString(" status=0x");
-                Serial.WriteHex(sc);
-                Serial.WriteString("\n");
-                throw new Exception("NVMe Read error");
-            }
+            Transfer(blockNo, blockCount, p, write: false);
         }
     }
 
@@ -70,20 +66,46 @@ public unsafe class NvmeNamespace : BlockDevice
             throw new ArgumentOutOfRangeException(nameof(blockCount), "Span shorter than the requested transfer.");
         }
 
-        for (ulong i = 0; i < blockCount; i++)
+        fixed (byte* p = data)
+        {
+            Transfer(blockNo, blockCount, p, write: true);
+        }
+    }
+
+    /// <inheritdoc />
+    /// <remarks>
+    /// Requests are split into single-block commands and handed to the
+    /// controller together, so a batch of N single-block reads runs at
+    /// queue depth N (up to the queue's free slots) instead of one.
+    /// </remarks>
+    public override void SubmitBatch(ReadOnlySpan<BlockRequest> requests)
+    {
+        int sector = (int)BlockSize;
+        Span<NvmeBlockTransfer> transfers = stackalloc NvmeBlockTransfer[TransferChunk];
+        int count = 0;
+        for (int r = 0; r < requests.Length; r++)
         {
-            ReadOnlySpan<byte> src = data.Slice((int)((long)i * sector), sector);
-            uint sc = _controller.Write(_nsid, blockNo + i, src, numLogicalBlocksMinusOne: 0);
-            if (sc != 0)
+            BlockRequest request = requests[r];
+            Span<byte> data = RequestData(request);
+            // Not pinned: the GC does not move objects, and `requests`
+            // keeps every buffer reachable until the batch returns.
+            byte* p = (byte*)Unsafe.AsPointer(ref MemoryMarshal.GetReference(data));
+            bool write = request.Operation == BlockOperation.Write;
+            for (ulong i = 0; i < request.BlockCount; i++)
             {
-                Serial.WriteString("[NVMe] Write failed lba=");
-                Serial.WriteNumber(blockNo + i);
-                Serial.WriteString(" status=0x");
-                Serial.WriteHex(sc);
-                Serial.WriteString("\n");
-                throw new Exception("NVMe Write error");
+                transfers[count++] = new NvmeBlockTransfer(request.BlockNo + i, p + (long)i * sector, write);
+                if (count == TransferChunk)
+                {
+                    Run(transfers);
+                    count = 0;
+                }
             }
         }
+
+        if (count > 0)
+        {
+            Run(transfers[..count]);
+        }
     }
 
     /// <inheritdoc />
@@ -98,4 +120,39 @@ public unsafe class NvmeNamespace : BlockDevice
             throw new Exception("NVMe Flush error");
         }
     }
+
+    private void Transfer(ulong blockNo, ulong blockCount, byte* data, bool write)
+    {
+        int sector = (int)BlockSize;
+        Span<NvmeBlockTransfer> transfers = stackalloc NvmeBlockTransfer[TransferChunk];
+        ulong i = 0;
+        while (i < blockCount)
+        {
+            int count = 0;
+            while (count < TransferChunk && i < blockCount)
+            {
+                transfers[count++] = new NvmeBlockTransfer(blockNo + i, data + (long)i * sector, write);
+                i++;
+            }
+
+            Run(transfers[..count]);
+        }
+    }
+
+    private void Run(ReadOnlySpan<NvmeBlockTransfer> transfers)
+    {
+        uint sc = _controller.Transfer(_nsid, transfers, (int)BlockSize, out int failedIndex);
+        if (sc == 0)
+        {
+            return;
+        }
+
+        NvmeBlockTransfer failed = transfers[failedIndex];
+        Serial.WriteString(failed.Write ? "[NVMe] Write failed lba=" : "[NVMe] Read failed lba=");
+        Serial.WriteNumber(failed.Lba);
+        Serial.WriteString(" status=0x");
+        Serial.WriteHex(sc);
+        Serial.WriteString("\n");
+        throw new Exception(failed.Write ? "NVMe Write error" : "NVMe Read error");
+    }
 }
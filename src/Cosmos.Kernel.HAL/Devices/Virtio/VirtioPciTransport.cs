@@ -14,7 +14,9 @@ namespace Cosmos.Kernel.HAL.Devices.Virtio;
 /// common/notify/ISR/device config regions are located through vendor-specific
 /// PCI capabilities pointing into BARs. Interrupts use MSI-X through the
 /// arch-neutral <see cref="MsiX"/>/MsiRouting path (LAPIC on x64, GICv3 ITS on
-/// ARM64); without MSI-X the device runs in polled mode. Legacy-only
+/// ARM64); without MSI-X the device runs in polled mode. MSI-X entry 0 is the
+/// config vector and entry q + 1 belongs to queue q while the table has room;
+/// queues past the end of the table share entry 0. Legacy-only
 /// virtio-pci devices (I/O BAR interface, no vendor capabilities) are not
 /// supported.
 /// </summary>
@@ -74,7 +76,10 @@ public sealed class VirtioPciTransport : VirtioTransport
     private const ushort NoVector = 0xFFFF;
 
     /// <summary>Highest queue index the notify-address cache supports.</summary>
-    private const int MaxQueues = 8;
+    private const int MaxQueues = 64;
+
+    /// <summary>MSI-X entry shared by the config change and by queues without a vector of their own.</summary>
+    private const ushort SharedVector = 0;
 
     private readonly PciDevice _pci;
     private readonly uint _deviceType;
@@ -84,9 +89,11 @@ public sealed class VirtioPciTransport : VirtioTransport
     private readonly ulong _isrStatus;
     private readonly ulong _deviceCfg;
     private readonly ulong[] _notifyAddresses = new ulong[MaxQueues];
+    private readonly bool[] _queueVectorBound = new bool[MaxQueues];
     private MsiXContext _msix;
     private bool _msixActive;
     private VirtioInterruptHandler? _handler;
+    private VirtioQueueInterruptHandler? _queueHandler;
 
     public override uint DeviceType => _deviceType;
     public override string TransportName => "PCI";
@@ -270,9 +277,10 @@ public sealed class VirtioPciTransport : VirtioTransport
 
         _msix = context.Value;
 
-        // One vector serves the whole device: entry 0 gets the config vector
-        // and every queue vector. The drivers drain all rings on any signal.
-        MsiX.SetEntry(_msix, 0, HandleMsiInterrupt);
+        // Entry 0 carries the config vector plus any queue that finds no
+        // entry of its own; drivers drain all rings on a signal there. Queue
+        // entries are bound as the queues are activated.
+        MsiX.SetEntry(_msix, SharedVector, HandleMsiInterrupt);
         _msixActive = true;
     }
 
@@ -282,7 +290,7 @@ public sealed class VirtioPciTransport : VirtioTransport
         // config-change vector on every (re-)initialization.
         if (_msixActive)
         {
-            WriteCommon16(CommonMsixConfig, 0);
+            WriteCommon16(CommonMsixConfig, SharedVector);
             if (ReadCommon16(CommonMsixConfig) == NoVector)
             {
                 Serial.Write("[VirtioPci] Device refused config MSI-X vector\n");
@@ -336,7 +344,15 @@ public sealed class VirtioPciTransport : VirtioTransport
 
         if (_msixActive)
         {
-            WriteCommon16(CommonQueueMsixVector, 0);
+            ushort vector = BindQueueVector(index);
+            WriteCommon16(CommonQueueMsixVector, vector);
+            if (vector != SharedVector && ReadCommon16(CommonQueueMsixVector) == NoVector)
+            {
+                // Out of device-side vector resources: share entry 0.
+                vector = SharedVector;
+                WriteCommon16(CommonQueueMsixVector, vector);
+            }
+
             if (ReadCommon16(CommonQueueMsixVector) == NoVector)
             {
                 Serial.Write("[VirtioPci] Device refused queue MSI-X vector\n");
@@ -358,6 +374,28 @@ public sealed class VirtioPciTransport : VirtioTransport
         return true;
     }
 
+    /// <summary>
+    /// Returns the MSI-X entry for queue <paramref name="index"/>, binding it
+    /// on first use. Bindings survive device reset, so re-initialization
+    /// does not leak vectors.
+    /// </summary>
+    private ushort BindQueueVector(ushort index)
+    {
+        int entry = index + 1;
+        if (entry >= _msix.EntryCount)
+        {
+            return SharedVector;
+        }
+
+        if (!_queueVectorBound[index])
+        {
+            MsiX.SetEntry(_msix, entry, new QueueVector(this, index).Handle);
+            _queueVectorBound[index] = true;
+        }
+
+        return (ushort)entry;
+    }
+
     public override void NotifyQueue(ushort index)
     {
         // Ring/descriptor writes are Normal memory, the doorbell is Device
@@ -390,6 +428,30 @@ public sealed class VirtioPciTransport : VirtioTransport
         return false;
     }
 
+    public override bool EnableQueueInterrupts(VirtioQueueInterruptHandler handler)
+    {
+        if (!_msixActive)
+        {
+            return false;
+        }
+
+        _queueHandler = handler;
+        return true;
+    }
+
+    private void DispatchQueueInterrupt(ushort index)
+    {
+        VirtioQueueInterruptHandler? queueHandler = _queueHandler;
+        if (queueHandler != null)
+        {
+            queueHandler(index);
+        }
+        else
+        {
+            _handler?.Invoke(IsrQueue);
+        }
+    }
+
     private void HandleMsiInterrupt(ref IRQContext context)
     {
         // MSI-X delivery is edge-style and per-device; the ISR register is
@@ -411,6 +473,21 @@ public sealed class VirtioPciTransport : VirtioTransport
         }
     }
 
+    /// <summary>MSI-X target for one queue's vector: IRQ delegates carry no argument.</summary>
+    private sealed class QueueVector
+    {
+        private readonly VirtioPciTransport _transport;
+        private readonly ushort _index;
+
+        public QueueVector(VirtioPciTransport transport, ushort index)
+        {
+            _transport = transport;
+            _index = index;
+        }
+
+        public void Handle(ref IRQContext context) => _transport.DispatchQueueInterrupt(_index);
+    }
+
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     private uint ReadCommon32(uint offset) => Native.MMIO.Read32(_commonCfg + offset);
 
@@ -13,6 +13,12 @@ namespace Cosmos.Kernel.HAL.Devices.Virtio;
 /// </summary>
 public delegate void VirtioInterruptHandler(uint isrStatus);
 
+/// <summary>
+/// Driver callback invoked from interrupt context when virtqueue
+/// <paramref name="queueIndex"/> signals through a vector of its own.
+/// </summary>
+public delegate void VirtioQueueInterruptHandler(ushort queueIndex);
+
 /// <summary>
 /// Wires a platform line interrupt (e.g. a GIC SPI) to a transport dispatch
 /// handler. Supplied by the platform initializer that owns the bus, so the
@@ -52,6 +58,14 @@ public abstract class VirtioTransport
     /// <summary>VIRTIO_F_VERSION_1 (bit 32): device and driver use virtio 1.x semantics.</summary>
     private const ulong FeatureVersion1 = 1UL << 32;
 
+    /// <summary>
+    /// VIRTIO_F_RING_EVENT_IDX (bit 29): notifications are suppressed through
+    /// the used_event/avail_event ring fields. Drivers that request it must
+    /// re-arm their queues with <see cref="Virtqueue.EnableInterrupts"/>
+    /// after draining them, or the device stops interrupting.
+    /// </summary>
+    public const uint FeatureRingEventIdx = 1u << 29;
+
     /// <summary>Virtio device type this transport was probed as.</summary>
     public abstract uint DeviceType { get; }
 
@@ -61,6 +75,9 @@ public abstract class VirtioTransport
     /// <summary>True once VIRTIO_F_VERSION_1 has been negotiated (modern device semantics).</summary>
     public bool Version1Negotiated { get; private set; }
 
+    /// <summary>True once VIRTIO_F_RING_EVENT_IDX has been negotiated; queues created afterwards use it.</summary>
+    public bool EventIdxNegotiated { get; private set; }
+
     /// <summary>
     /// Resets the device and announces the driver (status 0, then ACKNOWLEDGE, then DRIVER).
     /// </summary>
@@ -88,6 +105,7 @@ public abstract class VirtioTransport
 
         WriteDriverFeatures(accepted);
         Version1Negotiated = (accepted & FeatureVersion1) != 0;
+        EventIdxNegotiated = (accepted & FeatureRingEventIdx) != 0;
         negotiatedLow = (uint)accepted;
 
         if (!SupportsFeaturesOk)
@@ -130,6 +148,7 @@ public abstract class VirtioTransport
 
         uint queueSize = maxSize < preferredSize ? maxSize : preferredSize;
         Virtqueue queue = new Virtqueue(queueSize);
+        queue.EventIdx = EventIdxNegotiated;
         if (!ActivateQueue(index, queue))
         {
             return null;
@@ -182,6 +201,14 @@ public abstract class VirtioTransport
     /// </summary>
     public abstract bool EnableInterrupt(VirtioInterruptHandler handler);
 
+    /// <summary>
+    /// Routes queues that have an interrupt vector of their own to
+    /// <paramref name="handler"/>, so a driver only services the queue that
+    /// signaled. Returns false when the transport delivers every queue
+    /// through the <see cref="EnableInterrupt"/> handler instead.
+    /// </summary>
+    public virtual bool EnableQueueInterrupts(VirtioQueueInterruptHandler handler) => false;
+
     public abstract byte ReadDeviceConfig8(uint offset);
     public abstract ushort ReadDeviceConfig16(uint offset);
     public abstract void WriteDeviceConfig8(uint offset, byte value);
@@ -14,6 +14,14 @@ namespace Cosmos.Kernel.HAL.Devices.Virtio;
 /// - Used ring: buffers returned by device
 /// The layout is transport-independent; the same rings work over MMIO and PCI.
 /// </summary>
+/// <remarks>
+/// Notification suppression: publish chains with <see cref="AddAvailable"/>,
+/// then ring the doorbell once per batch and only if <see cref="KickPrepare"/>
+/// says so. With VIRTIO_F_RING_EVENT_IDX (<see cref="EventIdx"/>) both sides
+/// publish the ring index they next want to hear about — avail_event after
+/// the used ring, used_event after the available ring — instead of the
+/// all-or-nothing ring flags (virtio spec 2.7.7, 2.7.10).
+/// </remarks>
 public unsafe class Virtqueue
 {
     // Descriptor flags
@@ -40,6 +48,10 @@ public unsafe class Virtqueue
     private ushort _lastUsedIdx;
     private ushort _numFree;
 
+    // Available index at the last KickPrepare: the device has been told
+    // about every chain before it.
+    private ushort _kickedIdx;
+
     // Free descriptor list
     private ushort* _freeList;
 
@@ -68,6 +80,21 @@ public unsafe class Virtqueue
     /// </summary>
     public ulong QueueBaseAddr => VirtioDma.VirtToPhys(_baseAddress);
 
+    /// <summary>
+    /// True when VIRTIO_F_RING_EVENT_IDX was negotiated for the device. Set
+    /// by <see cref="VirtioTransport.CreateQueue"/> before the queue is used.
+    /// </summary>
+    public bool EventIdx { get; internal set; }
+
+    /// <summary>Number of descriptors on the free list.</summary>
+    public int FreeCount => _numFree;
+
+    // used_event: trails the available ring (avail->ring[N]); the driver
+    // writes it. avail_event: trails the used ring (used->ring[N]); the
+    // device writes it. The constructor's ring sizes already reserve both.
+    private ushort* UsedEvent => (ushort*)((byte*)_available + 4 + _queueSize * sizeof(ushort));
+    private ushort* AvailEvent => (ushort*)((byte*)_used + 4 + _queueSize * (uint)sizeof(VringUsedElem));
+
     /// <summary>
     /// Creates a new virtqueue with the specified size.
     /// Uses page-aligned allocation for legacy virtio MMIO compatibility.
@@ -161,7 +188,8 @@ public unsafe class Virtqueue
     }
 
     /// <summary>
-    /// Adds a buffer chain to the available ring.
+    /// Adds a buffer chain to the available ring. Does not notify the
+    /// device: queue the whole batch, then <see cref="KickPrepare"/>.
     /// </summary>
     public void AddAvailable(ushort headIdx)
     {
@@ -174,6 +202,71 @@ public unsafe class Virtqueue
         _available->Idx++;
     }
 
+    /// <summary>
+    /// Returns true if the device must be notified about the chains added
+    /// since the previous call. Call once per batch, after the last
+    /// <see cref="AddAvailable"/>, and ring the doorbell only when it returns
+    /// true. Callers serialize it with their <see cref="AddAvailable"/> calls.
+    /// </summary>
+    public bool KickPrepare()
+    {
+        // The Idx store must be visible before the device's suppression
+        // state is read, or both sides can decide the other will act.
+        System.Threading.Thread.MemoryBarrier();
+
+        ushort newIdx = _available->Idx;
+        ushort oldIdx = _kickedIdx;
+        _kickedIdx = newIdx;
+
+        if (newIdx == oldIdx)
+        {
+            return false;
+        }
+
+        if (EventIdx)
+        {
+            return NeedEvent(*AvailEvent, newIdx, oldIdx);
+        }
+
+        return (_used->Flags & VRING_USED_F_NO_NOTIFY) == 0;
+    }
+
+    /// <summary>
+    /// Asks the device to interrupt for the next used buffer. Returns false
+    /// if buffers were used meanwhile, in which case the caller must drain
+    /// again: the interrupt for them may already have been suppressed.
+    /// </summary>
+    public bool EnableInterrupts()
+    {
+        if (EventIdx)
+        {
+            *UsedEvent = _lastUsedIdx;
+        }
+        else
+        {
+            _available->Flags = (ushort)(_available->Flags & ~VRING_AVAIL_F_NO_INTERRUPT);
+        }
+
+        System.Threading.Thread.MemoryBarrier();
+        return _lastUsedIdx == _used->Idx;
+    }
+
+    /// <summary>
+    /// Asks the device not to interrupt for used buffers, for queues the
+    /// driver reaps from thread context (e.g. TX completions). Best effort:
+    /// the device may still signal.
+    /// </summary>
+    public void DisableInterrupts()
+    {
+        _available->Flags |= VRING_AVAIL_F_NO_INTERRUPT;
+        if (EventIdx)
+        {
+            // The device ignores the flag under EVENT_IDX. An index it has
+            // already passed keeps it quiet until the 16-bit index wraps.
+            *UsedEvent = (ushort)(_lastUsedIdx - 1);
+        }
+    }
+
     /// <summary>
     /// Checks if there are used buffers to process.
     /// </summary>
@@ -211,6 +304,13 @@ public unsafe class Virtqueue
         return true;
     }
 
+    // vring_need_event (spec 2.7.10): true if the event index lies in the
+    // window of entries published since the last notification, [old, new).
+    private static bool NeedEvent(ushort eventIdx, ushort newIdx, ushort oldIdx)
+    {
+        return (ushort)(newIdx - eventIdx - 1) < (ushort)(newIdx - oldIdx);
+    }
+
     private static uint Align(uint value, uint alignment)
     {
         return (value + alignment - 1) & ~(alignment - 1);
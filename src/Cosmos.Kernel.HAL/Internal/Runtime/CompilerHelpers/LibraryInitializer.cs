@@ -40,27 +40,35 @@ namespace Internal.Runtime.CompilerHelpers
 
             // Initialize platform-specific HAL
             Serial.WriteString("[KERNEL]   - Initializing HAL...\n");
+            uint phase = BootProfile.Begin("startup.hal"u8);
             PlatformHAL.Initialize(initializer);
+            BootProfile.End(phase);
 
             // Initialize interrupts (skipped if CosmosEnableInterrupts=false)
             if (InterruptManager.IsEnabled)
             {
                 Serial.WriteString("[KERNEL]   - Initializing interrupts...\n");
+                phase = BootProfile.Begin("startup.interrupts"u8);
                 InterruptManager.Initialize(initializer.CreateInterruptController());
+                BootProfile.End(phase);
 
                 if (CosmosFeatures.PCIEnabled)
                 {
                     // Initialize PCI (requires interrupts for MSI/MSI-X)
                     Serial.WriteString("[KERNEL]   - Initializing PCI...\n");
+                    phase = BootProfile.Begin("startup.pci"u8);
                     ulong ecamBase = AcpiMcfg.GetEcamBase();
                     initializer.PreparePciMapping(ecamBase);
-                    PciDevice.SetEcamBase(ecamBase);
+                    PciDevice.InitializeEcam();
                     PciManager.Setup();
+                    BootProfile.End(phase);
                 }
 
                 // Initialize platform-specific hardware (ACPI, APIC, GIC, timers, etc.)
                 Serial.WriteString("[KERNEL]   - Initializing platform hardware...\n");
+                phase = BootProfile.Begin("startup.hardware"u8);
                 initializer.InitializeHardware();
+                BootProfile.End(phase);
 
                 // Bind drivers to virtio PCI devices on any architecture.
                 // Must run after InitializeHardware: MSI-X routing needs the
@@ -69,7 +77,9 @@ namespace Internal.Runtime.CompilerHelpers
                     (CosmosFeatures.NetworkEnabled || CosmosFeatures.KeyboardEnabled || CosmosFeatures.MouseEnabled))
                 {
                     Serial.WriteString("[KERNEL]   - Scanning for virtio PCI devices...\n");
+                    phase = BootProfile.Begin("startup.virtio"u8);
                     VirtioDevice.InitializePciBus();
+                    BootProfile.End(phase);
                 }
 
                 // Initialize storage controllers (AHCI for SATA, NVMe for PCIe).
@@ -77,10 +87,14 @@ namespace Internal.Runtime.CompilerHelpers
                 if (CosmosFeatures.StorageEnabled)
                 {
                     Serial.WriteString("[KERNEL]   - Initializing AHCI...\n");
+                    phase = BootProfile.Begin("startup.ahci"u8);
                     Ahci.Initialize();
+                    BootProfile.End(phase);
 
                     Serial.WriteString("[KERNEL]   - Initializing NVMe...\n");
+                    phase = BootProfile.Begin("startup.nvme"u8);
                     Nvme.Initialize();
+                    BootProfile.End(phase);
                 }
             }
         }
@@ -110,7 +110,7 @@ public static class MsiX
         object? deviceCtx;
         try
         {
-            deviceCtx = MsiRouting.PrepareDevice(pci.Bus, pci.Slot, pci.Function, tableSize);
+            deviceCtx = MsiRouting.PrepareDevice(pci.Segment, pci.Bus, pci.Slot, pci.Function, tableSize);
         }
         catch (System.InvalidOperationException)
         {
@@ -3,6 +3,7 @@
 using Cosmos.Kernel.Boot.Limine;
 using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
 using Cosmos.Kernel.HAL.Devices;
 using Cosmos.Kernel.HAL.Pci.Enums;
 
@@ -10,6 +11,7 @@ namespace Cosmos.Kernel.HAL.Pci;
 
 public class PciDevice : Device
 {
+    public readonly uint Segment;
     public readonly uint Bus;
     public readonly uint Slot;
     public readonly uint Function;
@@ -111,9 +113,14 @@ public class PciDevice : Device
     private const int EcamSlotShift = 15;
     /// <summary>Shift placing the function number into ECAM address bits 14:12.</summary>
     private const int EcamFunctionShift = 12;
+    /// <summary>Number of buses a PCI segment can decode (8-bit bus number).</summary>
+    private const int BusesPerSegment = 256;
 
-    // ECAM Base Address (discovered from ACPI MCFG table at runtime)
-    private static ulong s_pciEcamBase;
+    // Per-segment ECAM lookup, built from every ACPI MCFG allocation by
+    // InitializeEcam(): s_ecamBusBase[i][bus] is the HHDM virtual address of
+    // bus `bus` of segment s_ecamSegments[i], or 0 when no allocation decodes it.
+    private static ushort[]? s_ecamSegments;
+    private static ulong[][]? s_ecamBusBase;
 
     public readonly PciBaseAddressBar[]? BaseAddressBar;
 
@@ -130,15 +137,25 @@ public class PciDevice : Device
     /// </summary>
     public bool Claimed { get; set; }
 
-    public PciDevice(uint bus, uint slot, uint function)
+    public PciDevice(uint bus, uint slot, uint function) : this(0, bus, slot, function)
+    {
+    }
+
+    public PciDevice(uint segment, uint bus, uint slot, uint function)
     {
         Serial.WriteString("[PciDevice] Init");
+        if (segment != 0)
+        {
+            Serial.WriteNumber(segment);
+            Serial.WriteString(":");
+        }
         Serial.WriteNumber(bus);
         Serial.WriteString(",");
         Serial.WriteNumber(slot);
         Serial.WriteString(",");
         Serial.WriteNumber(function);
         Serial.WriteString("\n");
+        Segment = segment;
         Bus = bus;
         Slot = slot;
         Function = function;
@@ -270,7 +287,15 @@ public class PciDevice : Device
     /// <returns>ushort value.</returns>
     public static ushort GetHeaderType(ushort bus, ushort slot, ushort function)
     {
-        return ReadConfig8(bus, slot, function, (byte)Config.HeaderType);
+        return GetHeaderType(0, bus, slot, function);
+    }
+
+    /// <summary>
+    /// Get header type of a function in PCI segment <paramref name="segment"/>.
+    /// </summary>
+    public static ushort GetHeaderType(ushort segment, ushort bus, ushort slot, ushort function)
+    {
+        return ReadConfig8(segment, bus, slot, function, (byte)Config.HeaderType);
     }
 
     /// <summary>
@@ -282,139 +307,189 @@ public class PciDevice : Device
     /// <returns>UInt16 value.</returns>
     public static ushort GetVendorId(ushort bus, ushort slot, ushort function)
     {
-        return ReadConfig16(bus, slot, function, (byte)Config.VendorId);
+        return GetVendorId(0, bus, slot, function);
+    }
+
+    /// <summary>
+    /// Get vendor ID of a function in PCI segment <paramref name="segment"/>.
+    /// </summary>
+    public static ushort GetVendorId(ushort segment, ushort bus, ushort slot, ushort function)
+    {
+        return ReadConfig16(segment, bus, slot, function, (byte)Config.VendorId);
     }
 
     #region IOReadWrite
 
     public byte ReadRegister8(byte aRegister)
     {
-        return ReadConfig8((ushort)Bus, (ushort)Slot, (ushort)Function, aRegister);
+        return ReadConfig8((ushort)Segment, (ushort)Bus, (ushort)Slot, (ushort)Function, aRegister);
     }
 
     public void WriteRegister8(byte aRegister, byte value)
     {
-        WriteConfig8((ushort)Bus, (ushort)Slot, (ushort)Function, aRegister, value);
+        WriteConfig8((ushort)Segment, (ushort)Bus, (ushort)Slot, (ushort)Function, aRegister, value);
     }
 
     public ushort ReadRegister16(byte aRegister)
     {
-        return ReadConfig16((ushort)Bus, (ushort)Slot, (ushort)Function, aRegister);
+        return ReadConfig16((ushort)Segment, (ushort)Bus, (ushort)Slot, (ushort)Function, aRegister);
     }
 
     public void WriteRegister16(byte aRegister, ushort value)
     {
-        WriteConfig16((ushort)Bus, (ushort)Slot, (ushort)Function, aRegister, value);
+        WriteConfig16((ushort)Segment, (ushort)Bus, (ushort)Slot, (ushort)Function, aRegister, value);
     }
 
     public uint ReadRegister32(byte aRegister)
     {
-        return ReadConfig32((ushort)Bus, (ushort)Slot, (ushort)Function, aRegister);
+        return ReadConfig32((ushort)Segment, (ushort)Bus, (ushort)Slot, (ushort)Function, aRegister);
     }
 
     public void WriteRegister32(byte aRegister, uint value)
     {
-        WriteConfig32((ushort)Bus, (ushort)Slot, (ushort)Function, aRegister, value);
+        WriteConfig32((ushort)Segment, (ushort)Bus, (ushort)Slot, (ushort)Function, aRegister, value);
     }
 
     #endregion
 
     #region ConfigSpaceAccess
 
-    private static byte ReadConfig8(ushort bus, ushort slot, ushort func, byte offset)
+    // Config space goes through ECAM (one MMIO access) whenever an MCFG
+    // allocation decodes the bus. x64 falls back to configuration mechanism #1
+    // (two port I/Os: CONFIG_ADDRESS then CONFIG_DATA) for segment 0 on
+    // machines without an MCFG, e.g. QEMU's i440fx. Functions no path reaches
+    // read as all ones, like an absent device.
+
+    private static byte ReadConfig8(ushort segment, ushort bus, ushort slot, ushort func, byte offset)
     {
-#if ARCH_ARM64
-        ulong addr = GetEcamAddress(bus, slot, func, offset);
-        return Native.MMIO.Read8(addr);
-#else
-        uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
-        PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
-        return (byte)((PlatformHAL.PortIO.ReadDWord(ConfigDataPort) >> (offset % ConfigDwordSizeBytes * BitsPerByte)) & ConfigByteMask);
+        ulong addr = GetEcamAddress(segment, bus, slot, func, offset);
+        if (addr != 0)
+        {
+            return Native.MMIO.Read8(addr);
+        }
+#if ARCH_X64
+        if (segment == 0)
+        {
+            uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
+            PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
+            return (byte)((PlatformHAL.PortIO.ReadDWord(ConfigDataPort) >> (offset % ConfigDwordSizeBytes * BitsPerByte)) & ConfigByteMask);
+        }
 #endif
+        return (byte)ConfigByteMask;
     }
 
-    private static void WriteConfig8(ushort bus, ushort slot, ushort func, byte offset, byte value)
+    private static void WriteConfig8(ushort segment, ushort bus, ushort slot, ushort func, byte offset, byte value)
     {
-#if ARCH_ARM64
-        ulong addr = GetEcamAddress(bus, slot, func, offset);
-        Native.MMIO.Write8(addr, value);
-#else
-        uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
-        PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
-        // PCI Configuration Mechanism #1 mirrors the 32-bit data port at
-        // 0xCFC..0xCFF. A byte access to offset N within the dword must
-        // hit port 0xCFC + (N & 3), otherwise the byte lands at the wrong
-        // position in the dword.
-        ushort dataPort = (ushort)(ConfigDataPort + (offset & ConfigByteLaneMask));
-        PlatformHAL.PortIO.WriteByte(dataPort, value);
+        ulong addr = GetEcamAddress(segment, bus, slot, func, offset);
+        if (addr != 0)
+        {
+            Native.MMIO.Write8(addr, value);
+            return;
+        }
+#if ARCH_X64
+        if (segment == 0)
+        {
+            uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
+            PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
+            // PCI Configuration Mechanism #1 mirrors the 32-bit data port at
+            // 0xCFC..0xCFF. A byte access to offset N within the dword must
+            // hit port 0xCFC + (N & 3), otherwise the byte lands at the wrong
+            // position in the dword.
+            ushort dataPort = (ushort)(ConfigDataPort + (offset & ConfigByteLaneMask));
+            PlatformHAL.PortIO.WriteByte(dataPort, value);
+        }
 #endif
     }
 
     private static bool _firstAccessLogged = false;
 
-    private static ushort ReadConfig16(ushort bus, ushort slot, ushort func, byte offset)
+    private static ushort ReadConfig16(ushort segment, ushort bus, ushort slot, ushort func, byte offset)
     {
-#if ARCH_ARM64
-        ulong addr = GetEcamAddress(bus, slot, func, offset);
-        if (!_firstAccessLogged)
-        {
-            Serial.WriteString("[PciDevice] First ECAM Read: Bus ");
-            Serial.WriteNumber(bus);
-            Serial.WriteString(" Slot ");
-            Serial.WriteNumber(slot);
-            Serial.WriteString(" Func ");
-            Serial.WriteNumber(func);
-            Serial.WriteString(" Offset ");
-            Serial.WriteNumber(offset);
-            Serial.WriteString(" -> Addr 0x");
-            Serial.WriteHex(addr);
-            Serial.WriteString("\n");
-            _firstAccessLogged = true;
+        ulong addr = GetEcamAddress(segment, bus, slot, func, offset);
+        if (addr != 0)
+        {
+            if (!_firstAccessLogged)
+            {
+                Serial.WriteString("[PciDevice] First ECAM Read: Bus ");
+                Serial.WriteNumber(bus);
+                Serial.WriteString(" Slot ");
+                Serial.WriteNumber(slot);
+                Serial.WriteString(" Func ");
+                Serial.WriteNumber(func);
+                Serial.WriteString(" Offset ");
+                Serial.WriteNumber(offset);
+                Serial.WriteString(" -> Addr 0x");
+                Serial.WriteHex(addr);
+                Serial.WriteString("\n");
+                _firstAccessLogged = true;
+            }
+            return Native.MMIO.Read16(addr);
+        }
+#if ARCH_X64
+        if (segment == 0)
+        {
+            uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
+            PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
+            return (ushort)((PlatformHAL.PortIO.ReadDWord(ConfigDataPort) >> (offset % ConfigDwordSizeBytes * BitsPerByte)) & ConfigWordMask);
         }
-        return Native.MMIO.Read16(addr);
-#else
-        uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
-        PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
-        return (ushort)((PlatformHAL.PortIO.ReadDWord(ConfigDataPort) >> (offset % ConfigDwordSizeBytes * BitsPerByte)) & ConfigWordMask);
 #endif
+        return (ushort)ConfigWordMask;
     }
 
-    private static void WriteConfig16(ushort bus, ushort slot, ushort func, byte offset, ushort value)
+    private static void WriteConfig16(ushort segment, ushort bus, ushort slot, ushort func, byte offset, ushort value)
     {
-#if ARCH_ARM64
-        ulong addr = GetEcamAddress(bus, slot, func, offset);
-        Native.MMIO.Write16(addr, value);
-#else
-        uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
-        PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
-        // 16-bit access at offset 2 within the dword must hit port 0xCFE,
-        // not 0xCFC — see WriteConfig8 for the rationale.
-        ushort dataPort = (ushort)(ConfigDataPort + (offset & ConfigWordLaneMask));
-        PlatformHAL.PortIO.WriteWord(dataPort, value);
+        ulong addr = GetEcamAddress(segment, bus, slot, func, offset);
+        if (addr != 0)
+        {
+            Native.MMIO.Write16(addr, value);
+            return;
+        }
+#if ARCH_X64
+        if (segment == 0)
+        {
+            uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
+            PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
+            // 16-bit access at offset 2 within the dword must hit port 0xCFE,
+            // not 0xCFC — see WriteConfig8 for the rationale.
+            ushort dataPort = (ushort)(ConfigDataPort + (offset & ConfigWordLaneMask));
+            PlatformHAL.PortIO.WriteWord(dataPort, value);
+        }
 #endif
     }
 
-    private static uint ReadConfig32(ushort bus, ushort slot, ushort func, byte offset)
+    private static uint ReadConfig32(ushort segment, ushort bus, ushort slot, ushort func, byte offset)
     {
-#if ARCH_ARM64
-        ulong addr = GetEcamAddress(bus, slot, func, offset);
-        return Native.MMIO.Read32(addr);
-#else
-        uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
-        PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
-        return PlatformHAL.PortIO.ReadDWord(ConfigDataPort);
+        ulong addr = GetEcamAddress(segment, bus, slot, func, offset);
+        if (addr != 0)
+        {
+            return Native.MMIO.Read32(addr);
+        }
+#if ARCH_X64
+        if (segment == 0)
+        {
+            uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
+            PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
+            return PlatformHAL.PortIO.ReadDWord(ConfigDataPort);
+        }
 #endif
+        return uint.MaxValue;
     }
 
-    private static void WriteConfig32(ushort bus, ushort slot, ushort func, byte offset, uint value)
+    private static void WriteConfig32(ushort segment, ushort bus, ushort slot, ushort func, byte offset, uint value)
     {
-#if ARCH_ARM64
-        ulong addr = GetEcamAddress(bus, slot, func, offset);
-        Native.MMIO.Write32(addr, value);
-#else
-        uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
-        PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
-        PlatformHAL.PortIO.WriteDWord(ConfigDataPort, value);
+        ulong addr = GetEcamAddress(segment, bus, slot, func, offset);
+        if (addr != 0)
+        {
+            Native.MMIO.Write32(addr, value);
+            return;
+        }
+#if ARCH_X64
+        if (segment == 0)
+        {
+            uint xAddr = GetAddressBase(bus, slot, func) | (uint)(offset & ConfigDwordAlignMask);
+            PlatformHAL.PortIO.WriteDWord(ConfigAddressPort, xAddr);
+            PlatformHAL.PortIO.WriteDWord(ConfigDataPort, value);
+        }
 #endif
     }
 
@@ -427,28 +502,172 @@ public class PciDevice : Device
         ConfigEnableBit | (aBus << ConfigBusShift) | ((aSlot & ConfigSlotMask) << ConfigSlotShift) | ((aFunction & ConfigFunctionMask) << ConfigFunctionShift);
 
     /// <summary>
-    /// Sets the ECAM base address (physical) discovered from ACPI MCFG.
-    /// Called by LibraryInitializer before PCI scanning.
+    /// Builds the per-segment ECAM lookup from every ACPI MCFG allocation.
+    /// Called by LibraryInitializer before PCI scanning. Bus windows are only
+    /// address-computed here; <see cref="MapBus"/> maps one before it is scanned.
     /// </summary>
-    internal static void SetEcamBase(ulong physBase)
+    internal static unsafe void InitializeEcam()
     {
-        s_pciEcamBase = physBase;
-        if (physBase != 0)
+        int count = AcpiMcfg.AllocationCount;
+        if (count == 0)
         {
-            Serial.WriteString("[PciDevice] ECAM base from ACPI MCFG: 0x");
-            Serial.WriteHex(physBase);
+            s_ecamSegments = null;
+            s_ecamBusBase = null;
+            return;
+        }
+
+        ulong hhdmOffset = Limine.HHDM.Response != null ? Limine.HHDM.Response->Offset : 0;
+        ushort[] segments = new ushort[count];
+        ulong[][] busBase = new ulong[count][];
+        int segmentCount = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            AcpiMcfg.McfgAllocation* alloc = AcpiMcfg.GetAllocation(i);
+            if (alloc->BaseAddress == 0 || alloc->EndBus < alloc->StartBus)
+            {
+                continue;
+            }
+
+            int slot = 0;
+            while (slot < segmentCount && segments[slot] != alloc->Segment)
+            {
+                slot++;
+            }
+
+            if (slot == segmentCount)
+            {
+                segments[slot] = alloc->Segment;
+                busBase[slot] = new ulong[BusesPerSegment];
+                segmentCount++;
+            }
+
+            for (int bus = alloc->StartBus; bus <= alloc->EndBus; bus++)
+            {
+                if (busBase[slot][bus] == 0)
+                {
+                    busBase[slot][bus] = alloc->BaseAddress + ((ulong)bus << EcamBusShift) + hhdmOffset;
+                }
+            }
+
+            Serial.WriteString("[PciDevice] ECAM segment ");
+            Serial.WriteNumber(alloc->Segment);
+            Serial.WriteString(" buses ");
+            Serial.WriteNumber(alloc->StartBus);
+            Serial.WriteString("-");
+            Serial.WriteNumber(alloc->EndBus);
+            Serial.WriteString(" at 0x");
+            Serial.WriteHex(alloc->BaseAddress);
             Serial.WriteString("\n");
         }
+
+        if (segmentCount < count)
+        {
+            Array.Resize(ref segments, segmentCount);
+            Array.Resize(ref busBase, segmentCount);
+        }
+
+        s_ecamSegments = segments;
+        s_ecamBusBase = busBase;
     }
 
     /// <summary>
-    /// Get ECAM address for ARM64 (returns virtual address via HHDM).
+    /// PCI segments with an ECAM window, in MCFG order. Empty when config space
+    /// is only reachable through port I/O (segment 0 on x64).
     /// </summary>
-    private static unsafe ulong GetEcamAddress(ushort bus, ushort slot, ushort func, byte offset)
+    public static ReadOnlySpan<ushort> EcamSegments => s_ecamSegments;
+
+    /// <summary>
+    /// Gets the first and last bus decoded by ECAM in <paramref name="segment"/>.
+    /// Returns false when the segment has no ECAM window.
+    /// </summary>
+    public static bool GetEcamBusRange(ushort segment, out byte startBus, out byte endBus)
     {
-        ulong phys = s_pciEcamBase + ((ulong)bus << EcamBusShift) + ((ulong)slot << EcamSlotShift) + ((ulong)func << EcamFunctionShift) + offset;
-        ulong hhdmOffset = Limine.HHDM.Response != null ? Limine.HHDM.Response->Offset : 0;
-        return phys + hhdmOffset;
+        startBus = 0;
+        endBus = 0;
+
+        ulong[]? buses = GetEcamBuses(segment);
+        if (buses == null)
+        {
+            return false;
+        }
+
+        int first = 0;
+        while (first < BusesPerSegment && buses[first] == 0)
+        {
+            first++;
+        }
+
+        int last = BusesPerSegment - 1;
+        while (last > first && buses[last] == 0)
+        {
+            last--;
+        }
+
+        if (first == BusesPerSegment)
+        {
+            return false;
+        }
+
+        startBus = (byte)first;
+        endBus = (byte)last;
+        return true;
+    }
+
+    /// <summary>
+    /// Maps the ECAM window of one bus as MMIO before it is scanned. A bus
+    /// window is 1 MiB aligned, so it never straddles a 2 MiB mapping block.
+    /// No-op for buses reached through port I/O.
+    /// </summary>
+    internal static void MapBus(ushort segment, ushort bus)
+    {
+        ulong[]? buses = GetEcamBuses(segment);
+        if (buses == null || bus >= BusesPerSegment || buses[bus] == 0)
+        {
+            return;
+        }
+
+        PlatformHAL.Initializer?.EnsureMmioMapped(PageAllocator.VirtualToPhysical(buses[bus]));
+    }
+
+    private static ulong[]? GetEcamBuses(ushort segment)
+    {
+        ushort[]? segments = s_ecamSegments;
+        if (segments == null)
+        {
+            return null;
+        }
+
+        for (int i = 0; i < segments.Length; i++)
+        {
+            if (segments[i] == segment)
+            {
+                return s_ecamBusBase![i];
+            }
+        }
+
+        return null;
+    }
+
+    /// <summary>
+    /// Get the ECAM address (HHDM virtual) of a config register, or 0 when no
+    /// MCFG allocation decodes the bus.
+    /// </summary>
+    private static ulong GetEcamAddress(ushort segment, ushort bus, ushort slot, ushort func, byte offset)
+    {
+        ulong[]? buses = GetEcamBuses(segment);
+        if (buses == null || bus >= BusesPerSegment)
+        {
+            return 0;
+        }
+
+        ulong busBase = buses[bus];
+        if (busBase == 0)
+        {
+            return 0;
+        }
+
+        return busBase + ((ulong)(slot & ConfigSlotMask) << EcamSlotShift) + ((ulong)(func & ConfigFunctionMask) << EcamFunctionShift) + offset;
     }
 
     /// <summary>
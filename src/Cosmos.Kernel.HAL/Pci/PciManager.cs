@@ -39,23 +39,20 @@ public class PciManager
         Serial.WriteString("[PciManager] Setup Clearing List.\n");
         Devices = new PciDevice[MaxDevices];
         Serial.WriteString("[PciManager] Setup Cleared List.\n");
-        if ((PciDevice.GetHeaderType(0x0, 0x0, 0x0) & MultifunctionBit) == 0)
+
+        // Every MCFG segment is scanned through ECAM; without an MCFG only
+        // segment 0 exists, reached through port I/O on x64.
+        ReadOnlySpan<ushort> segments = PciDevice.EcamSegments;
+        if (segments.IsEmpty)
         {
-            CheckBus(0x0);
+            CheckSegment(0, 0);
         }
         else
         {
-            for (ushort fn = 0; fn < MaxFunctionsPerDevice; fn++)
+            for (int i = 0; i < segments.Length; i++)
             {
-                Serial.WriteString("[PciManager] Setup ");
-                Serial.WriteNumber(fn);
-                Serial.WriteString("\n");
-                if (PciDevice.GetVendorId(0x0, 0x0, fn) != InvalidVendorId)
-                {
-                    break;
-                }
-
-                CheckBus(fn);
+                PciDevice.GetEcamBusRange(segments[i], out byte startBus, out _);
+                CheckSegment(segments[i], startBus);
             }
         }
 
@@ -74,20 +71,59 @@ public class PciManager
         Serial.WriteString("\n");
     }
 
+    /// <summary>
+    /// Scan the hierarchy below the host bridge of a segment.
+    /// </summary>
+    /// <param name="segment">PCI segment group.</param>
+    /// <param name="rootBus">First bus of the segment (the host bridge's bus).</param>
+    private static void CheckSegment(ushort segment, ushort rootBus)
+    {
+        Serial.WriteString("[PciManager] Segment ");
+        Serial.WriteNumber(segment);
+        Serial.WriteString(" root bus ");
+        Serial.WriteNumber(rootBus);
+        Serial.WriteString("\n");
+
+        PciDevice.MapBus(segment, rootBus);
+        if ((PciDevice.GetHeaderType(segment, rootBus, 0x0, 0x0) & MultifunctionBit) == 0)
+        {
+            CheckBus(segment, rootBus);
+        }
+        else
+        {
+            // A multi-function host bridge: function N is the host controller
+            // for bus rootBus + N.
+            for (ushort fn = 0; fn < MaxFunctionsPerDevice; fn++)
+            {
+                Serial.WriteString("[PciManager] Setup ");
+                Serial.WriteNumber(fn);
+                Serial.WriteString("\n");
+                if (PciDevice.GetVendorId(segment, rootBus, 0x0, fn) == InvalidVendorId)
+                {
+                    continue;
+                }
+
+                CheckBus(segment, (ushort)(rootBus + fn));
+            }
+        }
+    }
+
     /// <summary>
     /// Check bus.
     /// </summary>
+    /// <param name="segment">PCI segment group of the bus.</param>
     /// <param name="xBus">A bus to check.</param>
-    private static void CheckBus(ushort xBus)
+    private static void CheckBus(ushort segment, ushort xBus)
     {
         Serial.WriteString("[PciManager] CheckBus(");
         Serial.WriteNumber(xBus);
         Serial.WriteString(")\n");
+        PciDevice.MapBus(segment, xBus);
         for (ushort device = 0; device < MaxDevicesPerBus; device++)
         {
             Serial.WriteString("[PciManager] CheckBus - ");
             Serial.WriteNumber(device);
-            ushort vendorId = PciDevice.GetVendorId(xBus, device, 0x0);
+            ushort vendorId = PciDevice.GetVendorId(segment, xBus, device, 0x0);
             Serial.WriteString(" VID: 0x");
             Serial.WriteHex(vendorId);
             Serial.WriteString("\n");
@@ -96,14 +132,14 @@ public class PciManager
                 continue;
             }
 
-            CheckFunction(new PciDevice(xBus, device, 0x0));
-            if ((PciDevice.GetHeaderType(xBus, device, 0x0) & MultifunctionBit) != 0)
+            CheckFunction(new PciDevice(segment, xBus, device, 0x0));
+            if ((PciDevice.GetHeaderType(segment, xBus, device, 0x0) & MultifunctionBit) != 0)
             {
                 for (ushort fn = 1; fn < MaxFunctionsPerDevice; fn++)
                 {
-                    if (PciDevice.GetVendorId(xBus, device, fn) != InvalidVendorId)
+                    if (PciDevice.GetVendorId(segment, xBus, device, fn) != InvalidVendorId)
                     {
-                        CheckFunction(new PciDevice(xBus, device, fn));
+                        CheckFunction(new PciDevice(segment, xBus, device, fn));
                     }
                 }
             }
@@ -121,7 +157,7 @@ public class PciManager
         Serial.WriteString("[PciManager] Cached\n");
         if (xPciDevice.ClassCode == BridgeClassCode && xPciDevice.Subclass == PciToPciBridgeSubclass)
         {
-            CheckBus(xPciDevice.SecondaryBusNumber);
+            CheckBus((ushort)xPciDevice.Segment, xPciDevice.SecondaryBusNumber);
         }
     }
 
@@ -182,14 +218,25 @@ public class PciManager
     /// <param name="slot">Slot position ID.</param>
     /// <param name="function">Function ID.</param>
     /// <returns></returns>
-    public static PciDevice? GetDevice(uint bus, uint slot, uint function)
+    public static PciDevice? GetDevice(uint bus, uint slot, uint function) => GetDevice(0, bus, slot, function);
+
+    /// <summary>
+    /// Get device.
+    /// </summary>
+    /// <param name="segment">PCI segment group.</param>
+    /// <param name="bus">Bus ID.</param>
+    /// <param name="slot">Slot position ID.</param>
+    /// <param name="function">Function ID.</param>
+    /// <returns></returns>
+    public static PciDevice? GetDevice(uint segment, uint bus, uint slot, uint function)
     {
         ThrowIfNotSetup();
 
         for (uint i = 0; i < Count; i++)
         {
             PciDevice xDevice = Devices[i];
-            if (xDevice.Bus == bus &&
+            if (xDevice.Segment == segment &&
+                xDevice.Bus == bus &&
                 xDevice.Slot == slot &&
                 xDevice.Function == function)
             {
@@ -3,6 +3,7 @@
 using Cosmos.Build.API.Enum;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
 using Cosmos.Kernel.Core.Power;
 using Cosmos.Kernel.HAL.Interfaces;
 
@@ -52,7 +53,7 @@ public static class PlatformHAL
     /// Initializes the platform HAL using the provided initializer.
     /// </summary>
     /// <param name="initializer">Platform-specific initializer (X64 or ARM64).</param>
-    public static void Initialize(IPlatformInitializer initializer)
+    public static unsafe void Initialize(IPlatformInitializer initializer)
     {
         _initializer = initializer;
         _platformName = initializer.PlatformName;
@@ -60,5 +61,11 @@ public static class PlatformHAL
         _portIO = initializer.CreatePortIO();
         _cpuOps = initializer.CreateCpuOps();
         _powerOps = initializer.CreatePowerOps();
+        MmioMapping.Register(&EnsureMmioBlockMapped);
+    }
+
+    private static void EnsureMmioBlockMapped(ulong physBase)
+    {
+        _initializer?.EnsureMmioMapped(physBase);
     }
 }
@@ -0,0 +1,28 @@
+.global _native_ap_entry
+
+.extern _native_enable_simd
+.extern cosmos_smp_ap_main
+
+.text
+.align 4
+
+// Application processor entry, written to limine_mp_info.goto_address by
+// cosmos_smp_init() (Bootstrap/smp.c). Limine branches here at EL1 with the
+// MMU on and x0 = limine_mp_info*; extra_argument (offset 32) holds the
+// CPU's cosmos_smp_cpu_t, whose first field is the top of its kernel stack.
+_native_ap_entry:
+    msr     daifset, #0xf           // Mask D, A, I, F
+    ldr     x19, [x0, #32]
+    ldr     x1, [x19]
+    mov     sp, x1                  // Leave Limine's stack: it is bootloader-reclaimable
+    mov     x29, xzr
+    mov     x30, xzr
+
+    // FP/SIMD before any C code, as kmain() does on the BSP
+    bl      _native_enable_simd
+
+    mov     x0, x19
+    bl      cosmos_smp_ap_main      // noreturn
+1:
+    wfi
+    b       1b
@@ -1,5 +1,10 @@
 // SIMD-optimized memory copy operations for ARM64
 // Uses NEON (Q/V registers) for 128-bit transfers
+//
+// Also provides the freestanding libc memory primitives (memcpy, memmove,
+// memset, memcmp, strlen) used by the C objects, ILC-generated block
+// copies/inits and MemoryOp. Unaligned accesses rely on kmain clearing
+// SCTLR_EL1.A.
 
 .global _simd_copy_16
 .global _simd_copy_32
@@ -8,6 +13,16 @@
 .global _simd_copy_128_blocks
 .global _simd_copy_nt_128_blocks
 .global _simd_fill_16_blocks
+.global memcpy
+.global memmove
+.global memset
+.global memcmp
+.global strlen
+
+// Copies/fills at least this large use non-temporal stores (stnp): beyond
+// roughly an L2 worth of data, allocating the destination only evicts the
+// working set.
+.set NT_THRESHOLD, 0x40000
 
 .text
 .align 4
@@ -137,3 +152,309 @@ _simd_fill_16_blocks:
 
 .Lfill_done:
     ret
+
+// ============================================================================
+// libc memory primitives (AAPCS64: x0, x1, x2; result in x0)
+// Size classes: <=64 bytes is handled branch-light with overlapping
+// head/tail moves, larger sizes loop 64 bytes per iteration, and copies/fills
+// of NT_THRESHOLD or more use stnp.
+// ============================================================================
+
+// void* memcpy(void* dest, const void* src, size_t n)
+memcpy:
+    cmp     x2, #64
+    b.ls    .Lmove_le64
+    mov     x3, #NT_THRESHOLD
+    cmp     x2, x3
+    b.lo    .Lmove_fwd
+
+    // Large copy: preload the last 64 bytes, stream the rest with stnp.
+    add     x5, x1, x2
+    add     x6, x0, x2
+    ldp     q4, q5, [x5, #-64]
+    ldp     q6, q7, [x5, #-32]
+    mov     x3, x0
+
+.Lmemcpy_nt_loop:
+    ldp     q0, q1, [x1]
+    ldp     q2, q3, [x1, #32]
+    stnp    q0, q1, [x3]
+    stnp    q2, q3, [x3, #32]
+    add     x1, x1, #64
+    add     x3, x3, #64
+    sub     x2, x2, #64
+    cmp     x2, #64
+    b.hi    .Lmemcpy_nt_loop
+    dmb     ishst
+    b       .Lmove_store_tail
+
+// void* memmove(void* dest, const void* src, size_t n)
+memmove:
+    cmp     x2, #64
+    b.ls    .Lmove_le64
+    sub     x4, x0, x1
+    cmp     x4, x2
+    b.hs    .Lmove_fwd          // dest < src or no overlap: forward is safe
+    cbz     x4, .Lmove_done     // dest == src
+
+    // Overlapping with dest above src: copy 64-byte blocks from the end.
+    // The first 64 bytes are loaded up front and stored last.
+    ldp     q4, q5, [x1]
+    ldp     q6, q7, [x1, #32]
+    add     x5, x1, x2
+    add     x3, x0, x2
+
+.Lmove_bwd_loop:
+    ldp     q0, q1, [x5, #-32]
+    ldp     q2, q3, [x5, #-64]
+    stp     q0, q1, [x3, #-32]
+    stp     q2, q3, [x3, #-64]
+    sub     x5, x5, #64
+    sub     x3, x3, #64
+    sub     x2, x2, #64
+    cmp     x2, #64
+    b.hi    .Lmove_bwd_loop
+
+    stp     q4, q5, [x0]
+    stp     q6, q7, [x0, #32]
+    ret
+
+// Forward copy of n > 64 bytes. Every block is loaded before it is stored
+// and the tail is preloaded, so dest < src overlap is fine too.
+.Lmove_fwd:
+    add     x5, x1, x2
+    add     x6, x0, x2
+    ldp     q4, q5, [x5, #-64]
+    ldp     q6, q7, [x5, #-32]
+    mov     x3, x0
+
+.Lmove_fwd_loop:
+    ldp     q0, q1, [x1]
+    ldp     q2, q3, [x1, #32]
+    stp     q0, q1, [x3]
+    stp     q2, q3, [x3, #32]
+    add     x1, x1, #64
+    add     x3, x3, #64
+    sub     x2, x2, #64
+    cmp     x2, #64
+    b.hi    .Lmove_fwd_loop
+
+.Lmove_store_tail:
+    stp     q4, q5, [x6, #-64]
+    stp     q6, q7, [x6, #-32]
+    ret
+
+// n <= 64: all loads happen before any store, so this is overlap-safe.
+.Lmove_le64:
+    add     x5, x1, x2
+    add     x6, x0, x2
+    cmp     x2, #16
+    b.ls    .Lmove_le16
+    cmp     x2, #32
+    b.hi    .Lmove_33_64
+    ldr     q0, [x1]
+    ldur    q1, [x5, #-16]
+    str     q0, [x0]
+    stur    q1, [x6, #-16]
+    ret
+
+.Lmove_33_64:
+    ldp     q0, q1, [x1]
+    ldp     q2, q3, [x5, #-32]
+    stp     q0, q1, [x0]
+    stp     q2, q3, [x6, #-32]
+    ret
+
+.Lmove_le16:
+    cmp     x2, #8
+    b.lo    .Lmove_lt8
+    ldr     x3, [x1]
+    ldur    x4, [x5, #-8]
+    str     x3, [x0]
+    stur    x4, [x6, #-8]
+    ret
+
+.Lmove_lt8:
+    cmp     x2, #4
+    b.lo    .Lmove_lt4
+    ldr     w3, [x1]
+    ldur    w4, [x5, #-4]
+    str     w3, [x0]
+    stur    w4, [x6, #-4]
+    ret
+
+.Lmove_lt4:
+    cbz     x2, .Lmove_done
+    // 1..3 bytes: first, middle and last byte cover every length.
+    lsr     x7, x2, #1
+    ldrb    w3, [x1]
+    ldrb    w4, [x1, x7]
+    ldurb   w8, [x5, #-1]
+    strb    w3, [x0]
+    strb    w4, [x0, x7]
+    sturb   w8, [x6, #-1]
+
+.Lmove_done:
+    ret
+
+// void* memset(void* dest, int value, size_t n)
+memset:
+    and     w1, w1, #0xFF
+    mov     x4, #0x0101010101010101
+    mul     x1, x1, x4
+    add     x6, x0, x2
+    cmp     x2, #16
+    b.hi    .Lset_gt16
+    cmp     x2, #8
+    b.lo    .Lset_lt8
+    str     x1, [x0]
+    stur    x1, [x6, #-8]
+    ret
+
+.Lset_lt8:
+    cmp     x2, #4
+    b.lo    .Lset_lt4
+    str     w1, [x0]
+    stur    w1, [x6, #-4]
+    ret
+
+.Lset_lt4:
+    cbz     x2, .Lset_done
+    strb    w1, [x0]
+    sturb   w1, [x6, #-1]
+    cmp     x2, #3
+    b.lo    .Lset_done
+    strb    w1, [x0, #1]
+.Lset_done:
+    ret
+
+.Lset_gt16:
+    dup     v0.2d, x1
+    cmp     x2, #32
+    b.hi    .Lset_gt32
+    str     q0, [x0]
+    stur    q0, [x6, #-16]
+    ret
+
+.Lset_gt32:
+    cmp     x2, #64
+    b.hi    .Lset_gt64
+    stp     q0, q0, [x0]
+    stp     q0, q0, [x6, #-32]
+    ret
+
+.Lset_gt64:
+    mov     x3, x0
+    mov     x4, #NT_THRESHOLD
+    cmp     x2, x4
+    b.hs    .Lset_nt_loop
+
+.Lset_loop:
+    stp     q0, q0, [x3]
+    stp     q0, q0, [x3, #32]
+    add     x3, x3, #64
+    sub     x2, x2, #64
+    cmp     x2, #64
+    b.hi    .Lset_loop
+    b       .Lset_tail
+
+.Lset_nt_loop:
+    stnp    q0, q0, [x3]
+    stnp    q0, q0, [x3, #32]
+    add     x3, x3, #64
+    sub     x2, x2, #64
+    cmp     x2, #64
+    b.hi    .Lset_nt_loop
+    dmb     ishst
+
+.Lset_tail:
+    stp     q0, q0, [x6, #-64]
+    stp     q0, q0, [x6, #-32]
+    ret
+
+// int memcmp(const void* s1, const void* s2, size_t n)
+// Returns <0, 0 or >0 by the first mismatching byte (as unsigned char).
+memcmp:
+    cmp     x2, #16
+    b.lo    .Lcmp_lt16
+
+.Lcmp_loop:
+    ldp     x3, x4, [x0], #16
+    ldp     x5, x6, [x1], #16
+    cmp     x3, x5
+    b.ne    .Lcmp_diff
+    mov     x3, x4
+    mov     x5, x6
+    cmp     x3, x5
+    b.ne    .Lcmp_diff
+    sub     x2, x2, #16
+    cmp     x2, #16
+    b.hs    .Lcmp_loop
+
+.Lcmp_lt16:
+    cmp     x2, #8
+    b.lo    .Lcmp_bytes
+    ldr     x3, [x0], #8
+    ldr     x5, [x1], #8
+    sub     x2, x2, #8
+    cmp     x3, x5
+    b.ne    .Lcmp_diff
+
+.Lcmp_bytes:
+    cbz     x2, .Lcmp_equal
+    ldrb    w3, [x0], #1
+    ldrb    w5, [x1], #1
+    subs    w3, w3, w5
+    b.ne    .Lcmp_byte_diff
+    sub     x2, x2, #1
+    b       .Lcmp_bytes
+
+// Little-endian words: byte-reverse so the first differing byte decides.
+.Lcmp_diff:
+    rev     x3, x3
+    rev     x5, x5
+    cmp     x3, x5
+    mov     w0, #1
+    cneg    w0, w0, lo
+    ret
+
+.Lcmp_byte_diff:
+    mov     w0, w3
+    ret
+
+.Lcmp_equal:
+    mov     w0, #0
+    ret
+
+// size_t strlen(const char* s)
+// Scans aligned 16-byte blocks, which never cross into an unmapped page.
+// shrn packs the byte-compare result into a 64-bit mask, 4 bits per byte.
+strlen:
+    bic     x1, x0, #15
+    ld1     {v0.16b}, [x1]
+    cmeq    v0.16b, v0.16b, #0
+    shrn    v0.8b, v0.8h, #4
+    fmov    x2, d0
+    and     x3, x0, #15
+    lsl     x3, x3, #2
+    lsr     x2, x2, x3          // drop matches before the string start
+    cbnz    x2, .Lstrlen_first
+
+.Lstrlen_loop:
+    add     x1, x1, #16
+    ld1     {v0.16b}, [x1]
+    cmeq    v0.16b, v0.16b, #0
+    shrn    v0.8b, v0.8h, #4
+    fmov    x2, d0
+    cbz     x2, .Lstrlen_loop
+    rbit    x2, x2
+    clz     x2, x2
+    add     x1, x1, x2, lsr #2
+    sub     x0, x1, x0
+    ret
+
+.Lstrlen_first:
+    rbit    x2, x2
+    clz     x2, x2
+    lsr     x0, x2, #2
+    ret
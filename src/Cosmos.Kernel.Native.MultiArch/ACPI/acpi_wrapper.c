@@ -2,27 +2,28 @@
 // Shared RSDP/XSDT/RSDT walking code using LAI struct typedefs.
 // x86: parses MADT for Local APIC / IO APIC / ISOs
 // ARM64: parses MADT for GICD / GICR / GICC entries
+// Both: MCFG for PCI ECAM, SRAT / SLIT for NUMA node affinity and distances
 
 #include <stdint.h>
 #include <stddef.h>
 
 #include <lai/core.h>
 #include <lai/helpers/pm.h>
+#include <lai/helpers/pci.h>
 #include <acpispec/tables.h>
 
-#define NULL_PTR ((void*)0)
+#include "cosmos_log.h"
 
-// Serial output (implemented in C#)
-extern void __cosmos_serial_write(const char* message);
-extern void __cosmos_serial_write_hex_u32(uint32_t value);
-extern void __cosmos_serial_write_hex_u64(uint64_t value);
-extern void __cosmos_serial_write_dec_u32(uint32_t value);
-extern void __cosmos_serial_write_dec_u64(uint64_t value);
+#define NULL_PTR ((void*)0)
 
 // Cosmos support
 extern void cosmos_acpi_set_rsdp(void* rsdp);
 extern void* cosmos_acpi_get_rsdp(void);
 
+// Boot profile (Cosmos.Kernel/Bootstrap/boot_profile.c)
+extern uint32_t cosmos_boot_phase_begin(const char* name);
+extern void cosmos_boot_phase_end(uint32_t slot);
+
 // ============================================================================
 // ARM64 GIC structures (MADT subtable types 0x0B-0x0F)
 // ============================================================================
@@ -51,22 +52,48 @@ typedef struct {
 
 static acpi_gic_info_t g_gic_info;
 
+// Enabled GICC entries, one per processor (heap-free, see acpi_get_cpu_count).
+// Their processor UID and MPIDR let a CPU found by MPIDR be matched to its
+// SRAT GICC affinity entry, which is keyed by UID. The early walk only counts
+// them; gicc_materialize() sizes the array from that count once the heap is up.
+#define MADT_GICC_ENABLED 0x1
+#define MADT_GICC_MPIDR_AFFINITY 0xFF00FFFFFFULL   // Aff3..Aff0, without MT/U
+
+typedef struct {
+    uint32_t uid;
+    uint64_t mpidr;
+} acpi_gicc_cpu_t;
+
+static uint32_t g_gicc_cpu_count = 0;
+static acpi_gicc_cpu_t* g_gicc_cpus = NULL_PTR;
+static uint32_t g_gicc_filled = 0;
+static const uint8_t* g_gicc_madt = NULL_PTR;
+static uint8_t g_gicc_materialized = 0;
+
 #endif // __aarch64__
 
 // ============================================================================
-// x86 MADT structures (MADT subtable types 0-2)
+// x86 MADT structures
 // ============================================================================
 
 #ifdef ARCH_X64
 
-#define MAX_CPUS 256
-#define MAX_IOAPICS 16
-#define MAX_ISO_ENTRIES 32
+#define MADT_TYPE_LAPIC         0x00
+#define MADT_TYPE_IOAPIC        0x01
+#define MADT_TYPE_ISO           0x02
+#define MADT_TYPE_LAPIC_NMI     0x04
+#define MADT_TYPE_X2APIC        0x09
+#define MADT_TYPE_X2APIC_NMI    0x0A
+
+#define MADT_CPU_ENABLED        0x1
 
 typedef struct {
-    uint8_t processor_id;
-    uint8_t apic_id;
+    uint32_t processor_uid; // ACPI processor UID (8-bit processor ID for type 0)
+    uint32_t apic_id;       // full 32-bit x2APIC ID (or 8-bit xAPIC ID)
     uint32_t flags;
+    uint32_t package_id;    // decomposed from apic_id, see acpi_cpu_topology_t
+    uint32_t core_id;       // core within the package
+    uint32_t smt_id;        // hardware thread within the core
 } acpi_cpu_t;
 
 typedef struct {
@@ -81,18 +108,60 @@ typedef struct {
     uint16_t flags;
 } acpi_iso_t;
 
+typedef struct {
+    uint32_t processor_uid; // 0xFFFFFFFF = all processors
+    uint16_t flags;         // MPS INTI flags (polarity / trigger mode)
+    uint8_t  lint;          // LINT0 or LINT1
+    uint8_t  _pad;
+} acpi_nmi_t;
+
+// APIC ID layout from CPUID leaf 0x1F/0x0B (or leaves 1/4 on older CPUs):
+// the low smt_bits select the thread in a core, the next core_bits the core
+// in a package, and the remaining bits the package.
+typedef struct {
+    uint32_t smt_bits;
+    uint32_t core_bits;
+    uint32_t package_count;
+} acpi_cpu_topology_t;
+
+// The MADT is only counted in acpi_early_init(), which runs before the
+// managed heap exists. The entry arrays are allocated on the Cosmos heap,
+// sized from those counts, on the first acpi_get_madt_info() call.
 typedef struct {
     uint32_t local_apic_address;
     uint32_t flags;
     uint32_t cpu_count;
-    acpi_cpu_t cpus[MAX_CPUS];
     uint32_t ioapic_count;
-    acpi_ioapic_t ioapics[MAX_IOAPICS];
     uint32_t iso_count;
-    acpi_iso_t isos[MAX_ISO_ENTRIES];
+    uint32_t nmi_count;
+    acpi_cpu_t* cpus;
+    acpi_ioapic_t* ioapics;
+    acpi_iso_t* isos;
+    acpi_nmi_t* nmis;
+    acpi_cpu_topology_t topology;
 } acpi_madt_info_t;
 
 static acpi_madt_info_t g_madt_info;
+static const uint8_t* g_madt_table = NULL_PTR;
+static uint8_t g_madt_materialized = 0;
+
+// HPET (High Precision Event Timer) description table. The event timer block
+// itself is programmed from managed code (Core.X64/Cpu/Hpet.cs); this only
+// records where it lives.
+typedef struct {
+    uint8_t  found;
+    uint8_t  comparator_count;
+    uint8_t  counter_64bit;
+    uint8_t  legacy_replacement;
+    uint16_t vendor_id;
+    uint16_t min_tick;          // minimum periodic tick, in main counter ticks
+    uint8_t  hpet_number;
+    uint8_t  page_protection;
+    uint16_t _pad;
+    uint64_t base_address;      // physical, memory space
+} acpi_hpet_info_t;
+
+static acpi_hpet_info_t g_hpet_info;
 
 #endif // ARCH_X64
 
@@ -100,18 +169,101 @@ static acpi_madt_info_t g_madt_info;
 // PCI MCFG structure (shared across architectures)
 // ============================================================================
 
+#define ACPI_MCFG_MAX_ALLOCS    16
+#define ACPI_MCFG_MAX_SEGMENTS  8
+
+// One MCFG configuration space base address allocation, as laid out in the table.
 typedef struct {
-    uint8_t  found;
+    uint64_t base_address;  // ECAM physical base; bus N lives at base + (N << 20)
+    uint16_t segment;
     uint8_t  start_bus;
     uint8_t  end_bus;
+    uint32_t _reserved;
+} acpi_mcfg_alloc_t;
+
+typedef struct {
+    uint8_t  found;
+    uint8_t  start_bus;     // first allocation (kept for single-segment callers)
+    uint8_t  end_bus;
     uint8_t  _pad1;
     uint16_t segment;
     uint16_t _pad2;
-    uint64_t base_address;  // ECAM physical base
+    uint64_t base_address;
+    uint32_t count;         // valid entries in allocs[]
+    uint32_t dropped;       // allocations beyond ACPI_MCFG_MAX_ALLOCS
+    acpi_mcfg_alloc_t allocs[ACPI_MCFG_MAX_ALLOCS];
 } acpi_mcfg_info_t;
 
 static acpi_mcfg_info_t g_mcfg_info;
 
+// (segment, bus) -> allocation lookup for acpi_pci_config_address(), so LAI's
+// PCI_Config accesses resolve in two array reads.
+typedef struct {
+    uint16_t segment;
+    uint8_t  bus_alloc[256];    // allocs[] index + 1, 0 = bus not decoded
+} acpi_ecam_segment_t;
+
+static acpi_ecam_segment_t g_ecam_segments[ACPI_MCFG_MAX_SEGMENTS];
+static uint32_t g_ecam_segment_count = 0;
+
+// ============================================================================
+// NUMA structures from SRAT / SLIT (shared across architectures)
+// ============================================================================
+//
+// Proximity domains are renumbered to dense node indices 0..node_count-1 in
+// order of first appearance in the SRAT. distances[] is indexed by node index
+// (row = from, column = to) and uses SLIT units: 10 = local. Without a SLIT,
+// every remote node is 20. node_count == 0 means no SRAT: treat RAM as one node.
+// Fixed-size so it can be filled before the Cosmos heap exists; the managed
+// mirror is Cosmos.Kernel.Core/Memory/NumaTopology.cs.
+
+#define ACPI_NUMA_MAX_NODES   16
+#define ACPI_NUMA_MAX_RANGES  64
+
+#define SRAT_TYPE_CPU_AFFINITY     0x00
+#define SRAT_TYPE_MEMORY_AFFINITY  0x01
+#define SRAT_TYPE_X2APIC_AFFINITY  0x02
+#define SRAT_TYPE_GICC_AFFINITY    0x03
+
+#define SRAT_ENABLED               0x1
+
+#define SLIT_LOCAL_DISTANCE        10
+#define SLIT_REMOTE_DISTANCE       20
+
+typedef struct {
+    uint64_t base;          // physical
+    uint64_t length;
+    uint32_t node;
+    uint32_t flags;         // SRAT memory affinity flags (bit 1 hot-pluggable, bit 2 non-volatile)
+} acpi_numa_range_t;
+
+typedef struct {
+    uint32_t id;            // x64: (x2)APIC ID; ARM64: ACPI processor UID
+    uint32_t node;
+} acpi_numa_cpu_t;
+
+typedef struct {
+    uint8_t  srat_found;
+    uint8_t  slit_found;
+    uint16_t node_count;
+    uint16_t range_count;
+    uint16_t cpu_count;     // enabled SRAT CPU affinity entries
+    uint32_t proximity_domains[ACPI_NUMA_MAX_NODES];   // node index -> SRAT proximity domain
+    acpi_numa_range_t ranges[ACPI_NUMA_MAX_RANGES];
+    uint8_t  distances[ACPI_NUMA_MAX_NODES * ACPI_NUMA_MAX_NODES];
+} acpi_numa_info_t;
+
+static acpi_numa_info_t g_numa_info;
+
+// CPU affinity is only needed once the scheduler places CPUs, so unlike the
+// ranges it is not kept in the fixed, pre-heap struct above: parse_srat()
+// counts the entries and numa_materialize_cpus() sizes this array from the
+// count (see acpi_get_numa_cpus).
+static acpi_numa_cpu_t* g_numa_cpus = NULL_PTR;
+static uint32_t g_numa_cpus_filled = 0;
+static const uint8_t* g_srat_table = NULL_PTR;
+static uint8_t g_numa_cpus_materialized = 0;
+
 // ============================================================================
 // Global state
 // ============================================================================
@@ -119,6 +271,20 @@ static acpi_mcfg_info_t g_mcfg_info;
 static uint8_t g_initialized = 0;
 static uint64_t g_hhdm_offset = 0;
 
+extern void* cosmos_malloc(size_t size);
+
+// Heap array for a table the early walk only counted (MADT CPUs and
+// controllers, SRAT CPU affinity, GICC entries). Must not be reached from a
+// SuppressGCTransition import: cosmos_malloc calls into managed code.
+static void* acpi_table_alloc(uint32_t count, size_t size, const char* table) {
+    if (count == 0)
+        return NULL_PTR;
+    void* p = cosmos_malloc((size_t)count * size);
+    if (p == NULL_PTR)
+        COSMOS_LOG_ERROR("[ACPI] %s: out of memory for %u entries\n", table, count);
+    return p;
+}
+
 // Physical-to-virtual address translation via Limine HHDM
 // ACPI tables store physical addresses; the kernel accesses memory via HHDM.
 static inline void* phys_to_virt(uint64_t phys) {
@@ -128,69 +294,220 @@ static inline void* phys_to_virt(uint64_t phys) {
     return (void*)(phys + g_hhdm_offset);
 }
 
+// HHDM offset for the other C objects (laihost_map in lai_host.c).
+uint64_t acpi_get_hhdm_offset(void) {
+    return g_hhdm_offset;
+}
+
 // 4-byte signature compare (ACPI table signatures are exactly 4 ASCII chars).
 static inline int sig_eq(const char* a, const char* b) {
     return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
 }
 
-// Walk XSDT/RSDT looking for the Nth table whose signature matches `signature`.
-// Returns a virtual pointer to the table header, or NULL if not found.
-// Used by laihost_scan() to fulfill LAI's namespace-creation table requests
-// (FACP/DSDT/SSDT/PSDT) and by lai_acpi_reset() for the FADT reset register.
+// ============================================================================
+// ACPI table directory
+// ============================================================================
 //
-// DSDT is special-cased: per ACPI spec it is NOT a top-level XSDT/RSDT entry —
-// its physical address is stored inside the FADT (x_dsdt / dsdt fields), so we
-// must resolve it via FACP before falling back to the XSDT/RSDT walk.
-void* cosmos_acpi_scan_table(const char* signature, size_t index) {
-    if (signature == NULL_PTR) return NULL_PTR;
+// Built once by acpi_early_init() from the XSDT (or RSDT), plus the DSDT,
+// which is not a top-level entry: per ACPI spec its address lives in the
+// FADT (x_dsdt / dsdt). Lookups by (signature, index) then hash straight to
+// the entry instead of re-walking the root table, which matters because LAI
+// calls laihost_scan() for every SSDT/PSDT index during namespace creation.
+// Managed code does not read the directory: the HAL's ACPI views (MCFG, MADT,
+// HPET, SRAT, PM) read the structs the parsers below cache from it.
 
-    acpi_rsdp_t* rsdp = (acpi_rsdp_t*)cosmos_acpi_get_rsdp();
-    if (rsdp == NULL_PTR) return NULL_PTR;
+#define ACPI_MAX_TABLES        64
+#define ACPI_TABLE_HASH_SLOTS  128   // power of two, > ACPI_MAX_TABLES
 
-    if (index == 0 && sig_eq(signature, "DSDT")) {
-        acpi_fadt_t* fadt = (acpi_fadt_t*)cosmos_acpi_scan_table("FACP", 0);
-        if (fadt == NULL_PTR) return NULL_PTR;
-        uint64_t dsdt_phys = 0;
-        if (fadt->header.length >= sizeof(acpi_fadt_t) && fadt->x_dsdt != 0) {
-            dsdt_phys = fadt->x_dsdt;
-        } else if (fadt->dsdt != 0) {
-            dsdt_phys = (uint64_t)fadt->dsdt;
-        }
-        if (dsdt_phys == 0) return NULL_PTR;
-        acpi_header_t* dsdt = (acpi_header_t*)phys_to_virt(dsdt_phys);
-        if (dsdt && sig_eq(dsdt->signature, "DSDT")) return dsdt;
-        return NULL_PTR;
+typedef struct {
+    char     signature[4];
+    uint32_t length;        // header.length
+    uint64_t phys_address;
+    uint64_t virt_address;  // HHDM pointer to the table header
+    uint16_t index;         // Nth table with this signature (0-based)
+    uint8_t  revision;
+    uint8_t  checksum_ok;   // 1 if all `length` bytes sum to zero
+    uint32_t _pad;
+} acpi_table_entry_t;
+
+// `hash` is an open-addressed (linear probing) index keyed on
+// table_hash(signature, index); each slot holds entry index + 1, 0 = empty.
+typedef struct {
+    uint32_t count;
+    uint32_t dropped;       // root-table entries that did not fit
+    acpi_table_entry_t tables[ACPI_MAX_TABLES];
+    uint8_t  hash[ACPI_TABLE_HASH_SLOTS];
+} acpi_table_directory_t;
+
+static acpi_table_directory_t g_table_directory;
+
+static inline uint32_t sig_key(const char* s) {
+    return (uint32_t)(uint8_t)s[0] | (uint32_t)(uint8_t)s[1] << 8 |
+           (uint32_t)(uint8_t)s[2] << 16 | (uint32_t)(uint8_t)s[3] << 24;
+}
+
+static inline uint32_t table_hash(uint32_t key, uint32_t index) {
+    return ((key ^ (index * 0x9E3779B9u)) * 0x85EBCA6Bu) >> 25;   // 7 bits
+}
+
+static int table_checksum_ok(const acpi_header_t* tbl) {
+    const uint8_t* p = (const uint8_t*)tbl;
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < tbl->length; i++)
+        sum += p[i];
+    return sum == 0;
+}
+
+static const acpi_table_entry_t* table_directory_find(const char* signature, size_t index) {
+    uint32_t key = sig_key(signature);
+    uint32_t slot = table_hash(key, (uint32_t)index);
+    for (uint32_t probe = 0; probe < ACPI_TABLE_HASH_SLOTS; probe++) {
+        uint8_t e = g_table_directory.hash[slot];
+        if (e == 0)
+            return NULL_PTR;
+        const acpi_table_entry_t* entry = &g_table_directory.tables[e - 1];
+        if (sig_key(entry->signature) == key && entry->index == index)
+            return entry;
+        slot = (slot + 1) & (ACPI_TABLE_HASH_SLOTS - 1);
     }
+    return NULL_PTR;
+}
 
-    size_t matches = 0;
+static void table_directory_add(uint64_t phys) {
+    acpi_header_t* tbl = (acpi_header_t*)phys_to_virt(phys);
+    if (tbl == NULL_PTR)
+        return;
+
+    acpi_table_directory_t* dir = &g_table_directory;
+    if (dir->count >= ACPI_MAX_TABLES) {
+        dir->dropped++;
+        return;
+    }
+
+    // Index = number of tables with this signature already recorded.
+    uint16_t index = 0;
+    while (table_directory_find(tbl->signature, index) != NULL_PTR)
+        index++;
+
+    acpi_table_entry_t* entry = &dir->tables[dir->count];
+    for (int i = 0; i < 4; i++)
+        entry->signature[i] = tbl->signature[i];
+    entry->length = tbl->length;
+    entry->phys_address = phys;
+    entry->virt_address = (uint64_t)(uintptr_t)tbl;
+    entry->index = index;
+    entry->revision = tbl->revision;
+    entry->checksum_ok = (uint8_t)table_checksum_ok(tbl);
+    dir->count++;
+
+    uint32_t slot = table_hash(sig_key(tbl->signature), index);
+    while (dir->hash[slot] != 0)
+        slot = (slot + 1) & (ACPI_TABLE_HASH_SLOTS - 1);
+    dir->hash[slot] = (uint8_t)dir->count;
+
+    if (!entry->checksum_ok) {
+        COSMOS_LOG_WARN("[ACPI] %c%c%c%c[%u] checksum mismatch (kept)\n",
+                        entry->signature[0], entry->signature[1],
+                        entry->signature[2], entry->signature[3], (uint32_t)index);
+    }
+}
+
+static void table_directory_build(acpi_rsdp_t* rsdp) {
+    for (int i = 0; i < (int)sizeof(g_table_directory); i++)
+        ((uint8_t*)&g_table_directory)[i] = 0;
 
     if (rsdp->revision >= 2 && ((acpi_xsdp_t*)rsdp)->xsdt != 0) {
         acpi_xsdt_t* xsdt = (acpi_xsdt_t*)phys_to_virt(((acpi_xsdp_t*)rsdp)->xsdt);
         uint32_t count = (xsdt->header.length - sizeof(acpi_header_t)) / sizeof(uint64_t);
-        for (uint32_t i = 0; i < count; i++) {
-            acpi_header_t* tbl = (acpi_header_t*)phys_to_virt(xsdt->tables[i]);
-            if (tbl && sig_eq(tbl->signature, signature)) {
-                if (matches++ == index) return tbl;
-            }
-        }
+        for (uint32_t i = 0; i < count; i++)
+            table_directory_add(xsdt->tables[i]);
     } else if (rsdp->rsdt != 0) {
         acpi_rsdt_t* rsdt = (acpi_rsdt_t*)phys_to_virt((uint64_t)rsdp->rsdt);
         uint32_t count = (rsdt->header.length - sizeof(acpi_header_t)) / sizeof(uint32_t);
-        for (uint32_t i = 0; i < count; i++) {
-            acpi_header_t* tbl = (acpi_header_t*)phys_to_virt((uint64_t)rsdt->tables[i]);
-            if (tbl && sig_eq(tbl->signature, signature)) {
-                if (matches++ == index) return tbl;
-            }
+        for (uint32_t i = 0; i < count; i++)
+            table_directory_add((uint64_t)rsdt->tables[i]);
+    }
+
+    const acpi_table_entry_t* facp = table_directory_find("FACP", 0);
+    if (facp != NULL_PTR && table_directory_find("DSDT", 0) == NULL_PTR) {
+        acpi_fadt_t* fadt = (acpi_fadt_t*)(uintptr_t)facp->virt_address;
+        uint64_t dsdt_phys = 0;
+        if (fadt->header.length >= sizeof(acpi_fadt_t) && fadt->x_dsdt != 0) {
+            dsdt_phys = fadt->x_dsdt;
+        } else if (fadt->dsdt != 0) {
+            dsdt_phys = (uint64_t)fadt->dsdt;
         }
+        acpi_header_t* dsdt = (acpi_header_t*)phys_to_virt(dsdt_phys);
+        if (dsdt && sig_eq(dsdt->signature, "DSDT"))
+            table_directory_add(dsdt_phys);
     }
 
-    return NULL_PTR;
+    COSMOS_LOG_DEBUG("[ACPI] Table directory: %u table(s), %u dropped\n",
+                     g_table_directory.count, g_table_directory.dropped);
+#if COSMOS_LOG_LEVEL >= COSMOS_LOG_LEVEL_DEBUG
+    for (uint32_t i = 0; i < g_table_directory.count; i++) {
+        const acpi_table_entry_t* e = &g_table_directory.tables[i];
+        COSMOS_LOG_DEBUG("[ACPI]   %c%c%c%c[%u] phys=0x%lx len=%u rev=%u%s\n",
+                         e->signature[0], e->signature[1], e->signature[2], e->signature[3],
+                         (uint32_t)e->index, e->phys_address, e->length, (uint32_t)e->revision,
+                         e->checksum_ok ? "" : " (bad checksum)");
+    }
+#endif
+}
+
+// Return the Nth table whose signature matches `signature` as a virtual
+// pointer to its header, or NULL if there is none. Used by laihost_scan() to
+// fulfill LAI's namespace-creation table requests (FACP/DSDT/SSDT/PSDT) and
+// by lai_acpi_reset() for the FADT reset register.
+void* cosmos_acpi_scan_table(const char* signature, size_t index) {
+    if (signature == NULL_PTR) return NULL_PTR;
+
+    const acpi_table_entry_t* entry = table_directory_find(signature, index);
+    return entry ? (void*)(uintptr_t)entry->virt_address : NULL_PTR;
 }
 
 // ============================================================================
 // MADT parsing - shared entry point
 // ============================================================================
 
+#ifdef ARCH_X64
+// APIC ID of an enabled LAPIC (type 0) or x2APIC (type 9) entry. Returns 0
+// for any other entry, a short one, or a disabled processor.
+static int madt_enabled_cpu_apic_id(const uint8_t* e, uint32_t* apic_id) {
+    uint8_t entry_len = e[1];
+    switch (e[0]) {
+        case MADT_TYPE_LAPIC:
+            if (entry_len < 8 || !(*(const uint32_t*)(e + 4) & MADT_CPU_ENABLED))
+                return 0;
+            *apic_id = e[3];
+            return 1;
+        case MADT_TYPE_X2APIC:
+            // type(1) length(1) reserved(2) x2apic_id(4) flags(4) uid(4)
+            if (entry_len < 16 || !(*(const uint32_t*)(e + 8) & MADT_CPU_ENABLED))
+                return 0;
+            *apic_id = *(const uint32_t*)(e + 4);
+            return 1;
+    }
+    return 0;
+}
+
+// Firmware may list a CPU both as type 0 and type 9. The early count has no
+// array to check against (madt_add_cpu de-duplicates the materialized one),
+// so it rescans the entries before `end` for an enabled CPU with this ID.
+static int madt_apic_id_listed_before(const uint8_t* madt, uint32_t end, uint32_t apic_id) {
+    uint32_t offset = sizeof(acpi_header_t) + 8;
+    while (offset < end) {
+        uint8_t entry_len = madt[offset + 1];
+        if (entry_len < 2) break;
+        uint32_t id;
+        if (madt_enabled_cpu_apic_id(madt + offset, &id) && id == apic_id)
+            return 1;
+        offset += entry_len;
+    }
+    return 0;
+}
+#endif // ARCH_X64
+
 static void parse_madt(acpi_header_t* madt_header) {
     uint8_t* madt = (uint8_t*)madt_header;
     uint32_t length = madt_header->length;
@@ -199,16 +516,17 @@ static void parse_madt(acpi_header_t* madt_header) {
     uint32_t offset = sizeof(acpi_header_t) + 8;
 
 #ifdef ARCH_X64
-    // x86: Extract Local APIC address from MADT header
+    // x86: Extract Local APIC address and flags (PCAT_COMPAT) from MADT header
     g_madt_info.local_apic_address = *(uint32_t*)(madt + sizeof(acpi_header_t));
-    __cosmos_serial_write("[ACPI] Local APIC at: 0x");
-    __cosmos_serial_write_hex_u32(g_madt_info.local_apic_address);
-    __cosmos_serial_write("\n");
+    g_madt_info.flags = *(uint32_t*)(madt + sizeof(acpi_header_t) + 4);
+    g_madt_table = madt;
+    COSMOS_LOG_INFO("[ACPI] Local APIC at: 0x%x\n", g_madt_info.local_apic_address);
 #endif
 
 #ifdef __aarch64__
     uint8_t found_gicd = 0;
     uint8_t found_gicr = 0;
+    g_gicc_madt = madt;
 #endif
 
     while (offset + 2 <= length) {
@@ -217,49 +535,28 @@ static void parse_madt(acpi_header_t* madt_header) {
         if (entry_len < 2) break;
 
 #ifdef ARCH_X64
+        // Count only; madt_materialize() fills the heap-allocated arrays.
         switch (type) {
-            case 0: { // Processor Local APIC
-                if (g_madt_info.cpu_count < MAX_CPUS) {
-                    uint8_t acpi_id = madt[offset + 2];
-                    uint8_t apic_id = madt[offset + 3];
-                    uint32_t flags = *(uint32_t*)(madt + offset + 4);
-                    if (flags & 1) {
-                        g_madt_info.cpus[g_madt_info.cpu_count].processor_id = acpi_id;
-                        g_madt_info.cpus[g_madt_info.cpu_count].apic_id = apic_id;
-                        g_madt_info.cpus[g_madt_info.cpu_count].flags = flags;
-                        g_madt_info.cpu_count++;
-                        __cosmos_serial_write("[ACPI] CPU (ID=");
-                        __cosmos_serial_write_dec_u32(acpi_id);
-                        __cosmos_serial_write(" APIC=");
-                        __cosmos_serial_write_dec_u32(apic_id);
-                        __cosmos_serial_write(")\n");
-                    }
-                }
+            case MADT_TYPE_LAPIC:
+            case MADT_TYPE_X2APIC: {
+                uint32_t apic_id;
+                if (madt_enabled_cpu_apic_id(madt + offset, &apic_id) &&
+                    !madt_apic_id_listed_before(madt, offset, apic_id))
+                    g_madt_info.cpu_count++;
                 break;
             }
-            case 1: { // I/O APIC
-                if (g_madt_info.ioapic_count < MAX_IOAPICS) {
-                    g_madt_info.ioapics[g_madt_info.ioapic_count].id = madt[offset + 2];
-                    g_madt_info.ioapics[g_madt_info.ioapic_count].address = *(uint32_t*)(madt + offset + 4);
-                    g_madt_info.ioapics[g_madt_info.ioapic_count].gsi_base = *(uint32_t*)(madt + offset + 8);
-                    __cosmos_serial_write("[ACPI] I/O APIC (ID=");
-                    __cosmos_serial_write_dec_u32(madt[offset + 2]);
-                    __cosmos_serial_write(" at 0x");
-                    __cosmos_serial_write_hex_u32(*(uint32_t*)(madt + offset + 4));
-                    __cosmos_serial_write(")\n");
-                    g_madt_info.ioapic_count++;
-                }
+            case MADT_TYPE_IOAPIC:
+                if (entry_len >= 12) g_madt_info.ioapic_count++;
                 break;
-            }
-            case 2: { // Interrupt Source Override
-                if (g_madt_info.iso_count < MAX_ISO_ENTRIES) {
-                    g_madt_info.isos[g_madt_info.iso_count].source = madt[offset + 3];
-                    g_madt_info.isos[g_madt_info.iso_count].gsi = *(uint32_t*)(madt + offset + 4);
-                    g_madt_info.isos[g_madt_info.iso_count].flags = *(uint16_t*)(madt + offset + 8);
-                    g_madt_info.iso_count++;
-                }
+            case MADT_TYPE_ISO:
+                if (entry_len >= 10) g_madt_info.iso_count++;
+                break;
+            case MADT_TYPE_LAPIC_NMI:
+                if (entry_len >= 6) g_madt_info.nmi_count++;
+                break;
+            case MADT_TYPE_X2APIC_NMI:
+                if (entry_len >= 12) g_madt_info.nmi_count++;
                 break;
-            }
         }
 #endif // ARCH_X64
 
@@ -270,12 +567,7 @@ static void parse_madt(acpi_header_t* madt_header) {
                 if (entry_len >= 24) {
                     uint64_t base = *(uint64_t*)(madt + offset + 8);
                     uint8_t ver = madt[offset + 20];
-                    __cosmos_serial_write("[ACPI-GIC] GICD: base=0x");
-                    __cosmos_serial_write_hex_u64(base);
-                    __cosmos_serial_write(" ver=");
-                    char buf[2] = { '0' + ver, 0 };
-                    __cosmos_serial_write(buf);
-                    __cosmos_serial_write("\n");
+                    COSMOS_LOG_DEBUG("[ACPI-GIC] GICD: base=0x%lx ver=%u\n", base, ver);
                     g_gic_info.dist_base = base;
                     if (ver >= 3) g_gic_info.version = 3;
                     else if (ver >= 1) g_gic_info.version = ver;
@@ -288,11 +580,7 @@ static void parse_madt(acpi_header_t* madt_header) {
                 if (entry_len >= 16 && !found_gicr) {
                     uint64_t base = *(uint64_t*)(madt + offset + 4);
                     uint32_t len = *(uint32_t*)(madt + offset + 12);
-                    __cosmos_serial_write("[ACPI-GIC] GICR: base=0x");
-                    __cosmos_serial_write_hex_u64(base);
-                    __cosmos_serial_write(" len=0x");
-                    __cosmos_serial_write_hex_u64(len);
-                    __cosmos_serial_write("\n");
+                    COSMOS_LOG_DEBUG("[ACPI-GIC] GICR: base=0x%lx len=0x%x\n", base, len);
                     g_gic_info.redist_base = base;
                     g_gic_info.redist_length = len;
                     if (g_gic_info.version < 3) g_gic_info.version = 3;
@@ -301,14 +589,14 @@ static void parse_madt(acpi_header_t* madt_header) {
                 break;
             }
             case MADT_TYPE_GICC: {
-                // GICC: offset+32=Physical Base(8)
+                // GICC: offset+12=flags(4), offset+32=Physical Base(8)
+                if (entry_len >= 16 && (*(uint32_t*)(madt + offset + 12) & MADT_GICC_ENABLED))
+                    g_gicc_cpu_count++;
                 if (entry_len >= 40 && g_gic_info.cpu_if_base == 0) {
                     uint64_t base = *(uint64_t*)(madt + offset + 32);
                     if (base != 0) {
                         g_gic_info.cpu_if_base = base;
-                        __cosmos_serial_write("[ACPI-GIC] GICC: base=0x");
-                        __cosmos_serial_write_hex_u64(base);
-                        __cosmos_serial_write("\n");
+                        COSMOS_LOG_DEBUG("[ACPI-GIC] GICC: base=0x%lx\n", base);
                     }
                 }
                 break;
@@ -323,11 +611,7 @@ static void parse_madt(acpi_header_t* madt_header) {
                     g_gic_info.its_base = base;
                     g_gic_info.its_id = id;
                     g_gic_info.its_found = 1;
-                    __cosmos_serial_write("[ACPI-GIC] ITS: id=");
-                    __cosmos_serial_write_dec_u32(id);
-                    __cosmos_serial_write(" base=0x");
-                    __cosmos_serial_write_hex_u64(base);
-                    __cosmos_serial_write("\n");
+                    COSMOS_LOG_DEBUG("[ACPI-GIC] ITS: id=%u base=0x%lx\n", id, base);
                 }
                 break;
             }
@@ -341,28 +625,275 @@ static void parse_madt(acpi_header_t* madt_header) {
     if (found_gicd) {
         g_gic_info.found = 1;
         if (g_gic_info.version == 0) g_gic_info.version = 2;
-        __cosmos_serial_write("[ACPI-GIC] Result: GICv");
-        char buf[2] = { '0' + g_gic_info.version, 0 };
-        __cosmos_serial_write(buf);
-        __cosmos_serial_write(" GICD=0x");
-        __cosmos_serial_write_hex_u64(g_gic_info.dist_base);
         if (found_gicr) {
-            __cosmos_serial_write(" GICR=0x");
-            __cosmos_serial_write_hex_u64(g_gic_info.redist_base);
+            COSMOS_LOG_INFO("[ACPI-GIC] Result: GICv%u GICD=0x%lx GICR=0x%lx\n",
+                            g_gic_info.version, g_gic_info.dist_base, g_gic_info.redist_base);
+        } else {
+            COSMOS_LOG_INFO("[ACPI-GIC] Result: GICv%u GICD=0x%lx\n",
+                            g_gic_info.version, g_gic_info.dist_base);
         }
-        __cosmos_serial_write("\n");
     } else {
-        __cosmos_serial_write("[ACPI-GIC] No GICD found in MADT\n");
+        COSMOS_LOG_WARN("[ACPI-GIC] No GICD found in MADT\n");
     }
 #endif
 
-    __cosmos_serial_write("[ACPI] MADT parsing complete\n");
+#ifdef ARCH_X64
+    COSMOS_LOG_INFO("[ACPI] MADT: %u CPU entr%s, %u I/O APIC(s), %u ISO(s), %u NMI(s)\n",
+                    g_madt_info.cpu_count, g_madt_info.cpu_count == 1 ? "y" : "ies",
+                    g_madt_info.ioapic_count, g_madt_info.iso_count, g_madt_info.nmi_count);
+#endif
+
+    COSMOS_LOG_INFO("[ACPI] MADT parsing complete\n");
+}
+
+#ifdef ARCH_X64
+
+// ============================================================================
+// x86 CPU topology and MADT materialization
+// ============================================================================
+
+static inline void madt_cpuid(uint32_t leaf, uint32_t subleaf,
+                              uint32_t* a, uint32_t* b, uint32_t* c, uint32_t* d) {
+    __asm__ volatile("cpuid" : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d) : "a"(leaf), "c"(subleaf));
+}
+
+static uint32_t ceil_log2(uint32_t v) {
+    uint32_t bits = 0;
+    while ((1u << bits) < v && bits < 31)
+        bits++;
+    return bits;
+}
+
+// Extended topology leaf (0x1F or 0x0B): level type 1 is SMT, the shift of
+// the last level is the package shift. Returns 0 if the leaf is not usable.
+static int topology_from_leaf(uint32_t leaf, acpi_cpu_topology_t* topo) {
+    uint32_t a, b, c, d;
+    uint32_t smt_shift = 0, package_shift = 0;
+    int levels = 0;
+
+    for (uint32_t sub = 0; sub < 8; sub++) {
+        madt_cpuid(leaf, sub, &a, &b, &c, &d);
+        uint32_t level_type = (c >> 8) & 0xFF;
+        if (level_type == 0 || (b & 0xFFFF) == 0)
+            break;
+        if (level_type == 1)
+            smt_shift = a & 0x1F;
+        package_shift = a & 0x1F;
+        levels++;
+    }
+
+    if (levels == 0 || package_shift < smt_shift)
+        return 0;
+    topo->smt_bits = smt_shift;
+    topo->core_bits = package_shift - smt_shift;
+    return 1;
+}
+
+static void madt_detect_topology(acpi_cpu_topology_t* topo) {
+    uint32_t a, b, c, d;
+    madt_cpuid(0, 0, &a, &b, &c, &d);
+    uint32_t max_leaf = a;
+
+    if (max_leaf >= 0x1F && topology_from_leaf(0x1F, topo)) return;
+    if (max_leaf >= 0x0B && topology_from_leaf(0x0B, topo)) return;
+
+    // Legacy: CPUID.1 EBX[23:16] logical CPUs per package (when HTT is set),
+    // CPUID.4 EAX[31:26] + 1 cores per package.
+    uint32_t logical = 1, cores = 1;
+    madt_cpuid(1, 0, &a, &b, &c, &d);
+    if (d & (1u << 28))
+        logical = (b >> 16) & 0xFF;
+    if (max_leaf >= 4) {
+        madt_cpuid(4, 0, &a, &b, &c, &d);
+        cores = ((a >> 26) & 0x3F) + 1;
+    } else {
+        cores = logical;    // unknown: assume no SMT
+    }
+    if (logical < cores) logical = cores;
+
+    topo->core_bits = ceil_log2(cores);
+    topo->smt_bits = ceil_log2(logical) - topo->core_bits;
+}
+
+static void madt_add_cpu(uint32_t uid, uint32_t apic_id, uint32_t flags, uint32_t capacity) {
+    // Firmware may list a CPU both as type 0 and type 9; keep the first.
+    for (uint32_t i = 0; i < g_madt_info.cpu_count; i++) {
+        if (g_madt_info.cpus[i].apic_id == apic_id)
+            return;
+    }
+    if (g_madt_info.cpu_count >= capacity)
+        return;
+
+    const acpi_cpu_topology_t* topo = &g_madt_info.topology;
+    acpi_cpu_t* cpu = &g_madt_info.cpus[g_madt_info.cpu_count++];
+    cpu->processor_uid = uid;
+    cpu->apic_id = apic_id;
+    cpu->flags = flags;
+    cpu->smt_id = apic_id & ((1u << topo->smt_bits) - 1);
+    cpu->core_id = (apic_id >> topo->smt_bits) & ((1u << topo->core_bits) - 1);
+    cpu->package_id = (topo->smt_bits + topo->core_bits) >= 32
+        ? 0 : apic_id >> (topo->smt_bits + topo->core_bits);
+
+    COSMOS_LOG_DEBUG("[ACPI] CPU (UID=%u APIC=%u pkg=%u core=%u smt=%u)\n",
+                     uid, apic_id, cpu->package_id, cpu->core_id, cpu->smt_id);
 }
 
+// Second MADT walk, run once the Cosmos heap is up. Must not be reached from
+// a SuppressGCTransition import: cosmos_malloc calls into managed code.
+static void madt_materialize(void) {
+    if (g_madt_materialized || g_madt_table == NULL_PTR)
+        return;
+    g_madt_materialized = 1;
+
+    madt_detect_topology(&g_madt_info.topology);
+    COSMOS_LOG_INFO("[ACPI] CPU topology: %u SMT bit(s), %u core bit(s)\n",
+                    g_madt_info.topology.smt_bits, g_madt_info.topology.core_bits);
+
+    uint32_t cpu_cap = g_madt_info.cpu_count, ioapic_cap = g_madt_info.ioapic_count;
+    uint32_t iso_cap = g_madt_info.iso_count, nmi_cap = g_madt_info.nmi_count;
+    g_madt_info.cpus = (acpi_cpu_t*)acpi_table_alloc(cpu_cap, sizeof(acpi_cpu_t), "MADT");
+    g_madt_info.ioapics = (acpi_ioapic_t*)acpi_table_alloc(ioapic_cap, sizeof(acpi_ioapic_t), "MADT");
+    g_madt_info.isos = (acpi_iso_t*)acpi_table_alloc(iso_cap, sizeof(acpi_iso_t), "MADT");
+    g_madt_info.nmis = (acpi_nmi_t*)acpi_table_alloc(nmi_cap, sizeof(acpi_nmi_t), "MADT");
+    if (!g_madt_info.cpus) cpu_cap = 0;
+    if (!g_madt_info.ioapics) ioapic_cap = 0;
+    if (!g_madt_info.isos) iso_cap = 0;
+    if (!g_madt_info.nmis) nmi_cap = 0;
+    g_madt_info.cpu_count = g_madt_info.ioapic_count = 0;
+    g_madt_info.iso_count = g_madt_info.nmi_count = 0;
+
+    const uint8_t* madt = g_madt_table;
+    uint32_t length = ((const acpi_header_t*)madt)->length;
+    uint32_t offset = sizeof(acpi_header_t) + 8;
+
+    while (offset + 2 <= length) {
+        uint8_t type = madt[offset];
+        uint8_t entry_len = madt[offset + 1];
+        if (entry_len < 2) break;
+
+        switch (type) {
+            case MADT_TYPE_LAPIC: {
+                uint32_t flags = *(uint32_t*)(madt + offset + 4);
+                if (entry_len >= 8 && (flags & MADT_CPU_ENABLED))
+                    madt_add_cpu(madt[offset + 2], madt[offset + 3], flags, cpu_cap);
+                break;
+            }
+            case MADT_TYPE_X2APIC: {
+                // type(1) length(1) reserved(2) x2apic_id(4) flags(4) uid(4)
+                uint32_t flags = *(uint32_t*)(madt + offset + 8);
+                if (entry_len >= 16 && (flags & MADT_CPU_ENABLED))
+                    madt_add_cpu(*(uint32_t*)(madt + offset + 12),
+                                 *(uint32_t*)(madt + offset + 4), flags, cpu_cap);
+                break;
+            }
+            case MADT_TYPE_IOAPIC: {
+                if (entry_len >= 12 && g_madt_info.ioapic_count < ioapic_cap) {
+                    acpi_ioapic_t* io = &g_madt_info.ioapics[g_madt_info.ioapic_count++];
+                    io->id = madt[offset + 2];
+                    io->address = *(uint32_t*)(madt + offset + 4);
+                    io->gsi_base = *(uint32_t*)(madt + offset + 8);
+                    COSMOS_LOG_DEBUG("[ACPI] I/O APIC (ID=%u at 0x%x)\n", io->id, io->address);
+                }
+                break;
+            }
+            case MADT_TYPE_ISO: {
+                if (entry_len >= 10 && g_madt_info.iso_count < iso_cap) {
+                    acpi_iso_t* iso = &g_madt_info.isos[g_madt_info.iso_count++];
+                    iso->source = madt[offset + 3];
+                    iso->gsi = *(uint32_t*)(madt + offset + 4);
+                    iso->flags = *(uint16_t*)(madt + offset + 8);
+                }
+                break;
+            }
+            case MADT_TYPE_LAPIC_NMI: {
+                // type(1) length(1) processor_id(1) flags(2) lint(1)
+                if (entry_len >= 6 && g_madt_info.nmi_count < nmi_cap) {
+                    acpi_nmi_t* nmi = &g_madt_info.nmis[g_madt_info.nmi_count++];
+                    nmi->processor_uid = madt[offset + 2] == 0xFF ? 0xFFFFFFFFu : madt[offset + 2];
+                    nmi->flags = *(uint16_t*)(madt + offset + 3);
+                    nmi->lint = madt[offset + 5];
+                }
+                break;
+            }
+            case MADT_TYPE_X2APIC_NMI: {
+                // type(1) length(1) flags(2) uid(4) lint(1) reserved(3)
+                if (entry_len >= 12 && g_madt_info.nmi_count < nmi_cap) {
+                    acpi_nmi_t* nmi = &g_madt_info.nmis[g_madt_info.nmi_count++];
+                    nmi->flags = *(uint16_t*)(madt + offset + 2);
+                    nmi->processor_uid = *(uint32_t*)(madt + offset + 4);
+                    nmi->lint = madt[offset + 8];
+                }
+                break;
+            }
+        }
+
+        offset += entry_len;
+    }
+
+    // Distinct packages (APIC IDs are not necessarily dense).
+    uint32_t packages = 0;
+    for (uint32_t i = 0; i < g_madt_info.cpu_count; i++) {
+        uint32_t j = 0;
+        while (j < i && g_madt_info.cpus[j].package_id != g_madt_info.cpus[i].package_id)
+            j++;
+        if (j == i)
+            packages++;
+    }
+    g_madt_info.topology.package_count = packages;
+
+    COSMOS_LOG_INFO("[ACPI] %u CPU(s) in %u package(s)\n", g_madt_info.cpu_count, packages);
+}
+
+// HPET: header(36) + event timer block ID(4) + base address GAS(12)
+//       + HPET number(1) + minimum tick(2) + page protection(1)
+static void parse_hpet(acpi_header_t* hpet_header) {
+    uint8_t* hpet = (uint8_t*)hpet_header;
+    if (hpet_header->length < sizeof(acpi_header_t) + 20) {
+        COSMOS_LOG_WARN("[ACPI-HPET] Table too short (%u bytes)\n", hpet_header->length);
+        return;
+    }
+
+    uint32_t block_id = *(uint32_t*)(hpet + 36);
+    uint8_t address_space = hpet[40];
+    uint64_t address = *(uint64_t*)(hpet + 44);
+    if (address_space != 0 || address == 0) {
+        COSMOS_LOG_WARN("[ACPI-HPET] Unsupported base address (space=%u)\n", address_space);
+        return;
+    }
+
+    g_hpet_info.comparator_count = (uint8_t)(((block_id >> 8) & 0x1F) + 1);
+    g_hpet_info.counter_64bit = (uint8_t)((block_id >> 13) & 1);
+    g_hpet_info.legacy_replacement = (uint8_t)((block_id >> 15) & 1);
+    g_hpet_info.vendor_id = (uint16_t)(block_id >> 16);
+    g_hpet_info.base_address = address;
+    g_hpet_info.hpet_number = hpet[52];
+    g_hpet_info.min_tick = *(uint16_t*)(hpet + 53);
+    g_hpet_info.page_protection = hpet[55];
+    g_hpet_info.found = 1;
+
+    COSMOS_LOG_INFO("[ACPI-HPET] base=0x%lx comparators=%u %s-bit vendor=0x%x\n",
+                    address, g_hpet_info.comparator_count,
+                    g_hpet_info.counter_64bit ? "64" : "32", g_hpet_info.vendor_id);
+}
+
+#endif // ARCH_X64
+
 // ============================================================================
 // MCFG parsing (PCI ECAM base address discovery)
 // ============================================================================
 
+static acpi_ecam_segment_t* ecam_segment(uint16_t segment, int create) {
+    for (uint32_t i = 0; i < g_ecam_segment_count; i++) {
+        if (g_ecam_segments[i].segment == segment)
+            return &g_ecam_segments[i];
+    }
+    if (!create || g_ecam_segment_count >= ACPI_MCFG_MAX_SEGMENTS)
+        return NULL_PTR;
+    acpi_ecam_segment_t* seg = &g_ecam_segments[g_ecam_segment_count++];
+    seg->segment = segment;
+    return seg;
+}
+
 static void parse_mcfg(acpi_header_t* mcfg_header) {
     uint8_t* mcfg = (uint8_t*)mcfg_header;
     uint32_t length = mcfg_header->length;
@@ -371,26 +902,250 @@ static void parse_mcfg(acpi_header_t* mcfg_header) {
     uint32_t offset = sizeof(acpi_header_t) + 8;
 
     if (offset + 16 > length) {
-        __cosmos_serial_write("[ACPI-MCFG] No entries in MCFG table\n");
+        COSMOS_LOG_WARN("[ACPI-MCFG] No entries in MCFG table\n");
         return;
     }
 
-    // Parse first entry (segment 0)
-    g_mcfg_info.base_address = *(uint64_t*)(mcfg + offset);
-    g_mcfg_info.segment = *(uint16_t*)(mcfg + offset + 8);
-    g_mcfg_info.start_bus = mcfg[offset + 10];
-    g_mcfg_info.end_bus = mcfg[offset + 11];
+    for (; offset + 16 <= length; offset += 16) {
+        if (g_mcfg_info.count >= ACPI_MCFG_MAX_ALLOCS) {
+            g_mcfg_info.dropped++;
+            continue;
+        }
+
+        acpi_mcfg_alloc_t* alloc = &g_mcfg_info.allocs[g_mcfg_info.count];
+        alloc->base_address = *(uint64_t*)(mcfg + offset);
+        alloc->segment = *(uint16_t*)(mcfg + offset + 8);
+        alloc->start_bus = mcfg[offset + 10];
+        alloc->end_bus = mcfg[offset + 11];
+        if (alloc->base_address == 0 || alloc->end_bus < alloc->start_bus)
+            continue;
+
+        acpi_ecam_segment_t* seg = ecam_segment(alloc->segment, 1);
+        if (seg == NULL_PTR) {
+            COSMOS_LOG_WARN("[ACPI-MCFG] Too many segments, ignoring segment %u\n", alloc->segment);
+            continue;
+        }
+        for (uint32_t bus = alloc->start_bus; bus <= alloc->end_bus; bus++) {
+            if (seg->bus_alloc[bus] == 0)
+                seg->bus_alloc[bus] = (uint8_t)(g_mcfg_info.count + 1);
+        }
+
+        COSMOS_LOG_INFO("[ACPI-MCFG] ECAM base=0x%lx segment=%u bus=%u-%u\n",
+                        alloc->base_address, alloc->segment,
+                        alloc->start_bus, alloc->end_bus);
+        g_mcfg_info.count++;
+    }
+
+    if (g_mcfg_info.count == 0)
+        return;
+
+    g_mcfg_info.base_address = g_mcfg_info.allocs[0].base_address;
+    g_mcfg_info.segment = g_mcfg_info.allocs[0].segment;
+    g_mcfg_info.start_bus = g_mcfg_info.allocs[0].start_bus;
+    g_mcfg_info.end_bus = g_mcfg_info.allocs[0].end_bus;
     g_mcfg_info.found = 1;
 
-    __cosmos_serial_write("[ACPI-MCFG] ECAM base=0x");
-    __cosmos_serial_write_hex_u64(g_mcfg_info.base_address);
-    __cosmos_serial_write(" segment=");
-    __cosmos_serial_write_dec_u32(g_mcfg_info.segment);
-    __cosmos_serial_write(" bus=");
-    __cosmos_serial_write_dec_u32(g_mcfg_info.start_bus);
-    __cosmos_serial_write("-");
-    __cosmos_serial_write_dec_u32(g_mcfg_info.end_bus);
-    __cosmos_serial_write("\n");
+    if (g_mcfg_info.dropped)
+        COSMOS_LOG_WARN("[ACPI-MCFG] %u allocation(s) beyond the first %u ignored\n",
+                        g_mcfg_info.dropped, ACPI_MCFG_MAX_ALLOCS);
+}
+
+// HHDM pointer to the config-space register (segment, bus, slot, fun, offset)
+// through the MCFG allocation that decodes the bus, or NULL if none does.
+// Used by laihost_pci_read/write (lai_host.c).
+volatile void* acpi_pci_config_address(uint16_t segment, uint8_t bus, uint8_t slot,
+                                       uint8_t fun, uint16_t offset) {
+    acpi_ecam_segment_t* seg = ecam_segment(segment, 0);
+    if (seg == NULL_PTR || seg->bus_alloc[bus] == 0 || slot > 31 || fun > 7 || offset > 0xFFF)
+        return NULL_PTR;
+
+    const acpi_mcfg_alloc_t* alloc = &g_mcfg_info.allocs[seg->bus_alloc[bus] - 1];
+    uint64_t phys = alloc->base_address + ((uint64_t)bus << 20) + ((uint64_t)slot << 15) +
+                    ((uint64_t)fun << 12) + offset;
+    return (volatile void*)phys_to_virt(phys);
+}
+
+// ============================================================================
+// SRAT / SLIT parsing (NUMA affinity and distances)
+// ============================================================================
+
+// SRAT subtables are packed, so multi-byte fields are often unaligned.
+static inline uint32_t acpi_rd32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+static inline uint64_t acpi_rd64(const uint8_t* p) {
+    return (uint64_t)acpi_rd32(p) | (uint64_t)acpi_rd32(p + 4) << 32;
+}
+
+// Dense node index for a proximity domain, allocating one on first sight.
+static uint32_t numa_node_for_domain(uint32_t domain) {
+    for (uint32_t i = 0; i < g_numa_info.node_count; i++) {
+        if (g_numa_info.proximity_domains[i] == domain)
+            return i;
+    }
+    if (g_numa_info.node_count >= ACPI_NUMA_MAX_NODES) {
+        COSMOS_LOG_WARN("[ACPI-SRAT] Too many proximity domains, folding %u into node 0\n", domain);
+        return 0;
+    }
+    g_numa_info.proximity_domains[g_numa_info.node_count] = domain;
+    return g_numa_info.node_count++;
+}
+
+// Hardware ID and proximity domain of an enabled CPU affinity entry (local
+// APIC, x2APIC or GICC). Returns 0 for any other entry, a short one, or a
+// disabled CPU.
+static int srat_enabled_cpu(const uint8_t* e, uint32_t* id, uint32_t* domain) {
+    uint8_t entry_len = e[1];
+    switch (e[0]) {
+        case SRAT_TYPE_CPU_AFFINITY:
+            // type(1) length(1) domain[7:0](1) apic_id(1) flags(4) sapic_eid(1) domain[31:8](3) clock(4)
+            if (entry_len < 16 || !(acpi_rd32(e + 4) & SRAT_ENABLED))
+                return 0;
+            *id = e[3];
+            *domain = e[2] | (uint32_t)e[9] << 8 | (uint32_t)e[10] << 16 | (uint32_t)e[11] << 24;
+            return 1;
+        case SRAT_TYPE_X2APIC_AFFINITY:
+            // type(1) length(1) reserved(2) domain(4) x2apic_id(4) flags(4) clock(4) reserved(4)
+            if (entry_len < 24 || !(acpi_rd32(e + 12) & SRAT_ENABLED))
+                return 0;
+            *id = acpi_rd32(e + 8);
+            *domain = acpi_rd32(e + 4);
+            return 1;
+        case SRAT_TYPE_GICC_AFFINITY:
+            // type(1) length(1) domain(4) uid(4) flags(4) clock(4)
+            if (entry_len < 18 || !(acpi_rd32(e + 10) & SRAT_ENABLED))
+                return 0;
+            *id = acpi_rd32(e + 6);
+            *domain = acpi_rd32(e + 2);
+            return 1;
+    }
+    return 0;
+}
+
+static void parse_srat(acpi_header_t* srat_header) {
+    const uint8_t* srat = (const uint8_t*)srat_header;
+    uint32_t length = srat_header->length;
+
+    // SRAT: header(36) + table revision(4) + reserved(8) + subtables
+    uint32_t offset = sizeof(acpi_header_t) + 12;
+    g_srat_table = srat;
+
+    while (offset + 2 <= length) {
+        const uint8_t* e = srat + offset;
+        uint8_t type = e[0];
+        uint8_t entry_len = e[1];
+        if (entry_len < 2 || offset + entry_len > length) break;
+
+        uint32_t cpu_id, cpu_domain;
+        switch (type) {
+            case SRAT_TYPE_CPU_AFFINITY:
+            case SRAT_TYPE_X2APIC_AFFINITY:
+            case SRAT_TYPE_GICC_AFFINITY:
+                // Count only, but number the domain now so node indices keep
+                // following first appearance in the table.
+                if (srat_enabled_cpu(e, &cpu_id, &cpu_domain) && g_numa_info.cpu_count < 0xFFFF) {
+                    numa_node_for_domain(cpu_domain);
+                    g_numa_info.cpu_count++;
+                }
+                break;
+            case SRAT_TYPE_MEMORY_AFFINITY: {
+                // type(1) length(1) domain(4) reserved(2) base(8) length(8) reserved(4) flags(4) reserved(8)
+                if (entry_len < 40)
+                    break;
+                uint32_t flags = acpi_rd32(e + 28);
+                uint64_t base = acpi_rd64(e + 8);
+                uint64_t size = acpi_rd64(e + 16);
+                if (!(flags & SRAT_ENABLED) || size == 0)
+                    break;
+                if (g_numa_info.range_count >= ACPI_NUMA_MAX_RANGES) {
+                    COSMOS_LOG_WARN("[ACPI-SRAT] Too many memory ranges, ignoring 0x%lx\n", base);
+                    break;
+                }
+                acpi_numa_range_t* range = &g_numa_info.ranges[g_numa_info.range_count++];
+                range->base = base;
+                range->length = size;
+                range->node = numa_node_for_domain(acpi_rd32(e + 2));
+                range->flags = flags;
+                COSMOS_LOG_DEBUG("[ACPI-SRAT] Memory 0x%lx-0x%lx node %u\n",
+                                 base, base + size, range->node);
+                break;
+            }
+        }
+
+        offset += entry_len;
+    }
+
+    for (uint32_t a = 0; a < g_numa_info.node_count; a++) {
+        for (uint32_t b = 0; b < g_numa_info.node_count; b++)
+            g_numa_info.distances[a * ACPI_NUMA_MAX_NODES + b] =
+                a == b ? SLIT_LOCAL_DISTANCE : SLIT_REMOTE_DISTANCE;
+    }
+
+    g_numa_info.srat_found = 1;
+    COSMOS_LOG_INFO("[ACPI-SRAT] %u node(s), %u memory range(s), %u CPU(s)\n",
+                    g_numa_info.node_count, g_numa_info.range_count, g_numa_info.cpu_count);
+}
+
+// Second SRAT walk, run once the Cosmos heap is up: one slot per enabled CPU
+// affinity entry parse_srat() counted. Every domain was numbered then, so the
+// lookups below do not add nodes.
+static void numa_materialize_cpus(void) {
+    if (g_numa_cpus_materialized || g_srat_table == NULL_PTR)
+        return;
+    g_numa_cpus_materialized = 1;
+
+    g_numa_cpus = (acpi_numa_cpu_t*)acpi_table_alloc(g_numa_info.cpu_count, sizeof(acpi_numa_cpu_t), "SRAT");
+    if (g_numa_cpus == NULL_PTR)
+        return;
+
+    const uint8_t* srat = g_srat_table;
+    uint32_t length = ((const acpi_header_t*)srat)->length;
+    uint32_t offset = sizeof(acpi_header_t) + 12;
+    while (offset + 2 <= length && g_numa_cpus_filled < g_numa_info.cpu_count) {
+        const uint8_t* e = srat + offset;
+        uint8_t entry_len = e[1];
+        if (entry_len < 2 || offset + entry_len > length) break;
+        uint32_t id, domain;
+        if (srat_enabled_cpu(e, &id, &domain)) {
+            acpi_numa_cpu_t* cpu = &g_numa_cpus[g_numa_cpus_filled++];
+            cpu->id = id;
+            cpu->node = numa_node_for_domain(domain);
+        }
+        offset += entry_len;
+    }
+}
+
+// Must run after parse_srat(): the SLIT is indexed by proximity domain, which
+// only the SRAT maps to node indices.
+static void parse_slit(acpi_header_t* slit_header) {
+    const uint8_t* slit = (const uint8_t*)slit_header;
+    uint32_t length = slit_header->length;
+
+    // SLIT: header(36) + locality count(8) + count * count distance bytes
+    uint32_t matrix = sizeof(acpi_header_t) + 8;
+    if (matrix > length)
+        return;
+    uint64_t localities = acpi_rd64(slit + sizeof(acpi_header_t));
+    if (localities == 0 || localities > 0xFFFF || matrix + localities * localities > length) {
+        COSMOS_LOG_WARN("[ACPI-SLIT] Malformed SLIT (%lu localities)\n", localities);
+        return;
+    }
+
+    for (uint32_t a = 0; a < g_numa_info.node_count; a++) {
+        uint64_t from = g_numa_info.proximity_domains[a];
+        for (uint32_t b = 0; b < g_numa_info.node_count; b++) {
+            uint64_t to = g_numa_info.proximity_domains[b];
+            if (from >= localities || to >= localities)
+                continue;
+            uint8_t distance = slit[matrix + from * localities + to];
+            // 0xFF = unreachable; keep the default rather than poisoning fallback order
+            if (distance >= SLIT_LOCAL_DISTANCE && distance != 0xFF)
+                g_numa_info.distances[a * ACPI_NUMA_MAX_NODES + b] = distance;
+        }
+    }
+
+    g_numa_info.slit_found = 1;
+    COSMOS_LOG_INFO("[ACPI-SLIT] %lu localities\n", localities);
 }
 
 // ============================================================================
@@ -405,6 +1160,34 @@ static void parse_mcfg(acpi_header_t* mcfg_header) {
 #define IORT_NODE_SMMU_V1V2    0x03
 #define IORT_NODE_SMMU_V3      0x04
 
+// Each ID mapping chain Root Complex -> (optional SMMU) -> ITS Group is
+// flattened once by parse_iort() into RID ranges with a direct DeviceID
+// translation. The table is sorted by (segment, rid_base). That makes
+// acpi_iort_resolve_device_id() a binary search, which matters because
+// MsiRouting resolves every MSI-capable function. It is also exported to
+// C# (Cosmos.Kernel.Core.ARM64/Acpi/Acpi.cs, AcpiIort) so a whole device
+// can be resolved without a native call per function.
+#define IORT_MAX_ID_RANGES     64
+
+// Deepest chain followed: RC -> SMMU -> ITS (two translations).
+#define IORT_MAX_HOPS          2
+
+typedef struct {
+    uint32_t segment;         // PCI segment of the Root Complex
+    uint32_t rid_base;        // first requester ID (BDF) of the range
+    uint32_t count;           // number of requester IDs in the range
+    uint32_t device_id_base;  // ITS DeviceID of rid_base
+    uint32_t its_id;          // first ITS identifier of the target ITS Group
+} acpi_iort_id_range_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t dropped;         // ranges beyond IORT_MAX_ID_RANGES
+    acpi_iort_id_range_t ranges[IORT_MAX_ID_RANGES];
+} acpi_iort_map_t;
+
+static acpi_iort_map_t g_iort_map;
+
 // Cached pointer to the IORT, virtual address. NULL if no IORT was found.
 static uint8_t* g_iort_base = NULL_PTR;
 static uint32_t g_iort_length = 0;
@@ -428,137 +1211,151 @@ static const uint8_t* iort_node_at(uint32_t node_off) {
     return g_iort_base + node_off;
 }
 
-static void parse_iort(acpi_header_t* iort_header) {
-    g_iort_base = (uint8_t*)iort_header;
-    g_iort_length = iort_header->length;
+static void iort_emit(uint32_t segment, uint32_t rid_base, uint32_t count,
+                      uint32_t device_id_base, const uint8_t* its_group) {
+    if (g_iort_map.count >= IORT_MAX_ID_RANGES) {
+        g_iort_map.dropped++;
+        return;
+    }
 
-    uint32_t node_count = iort_rd32(g_iort_base, sizeof(acpi_header_t));
-    uint32_t node_array_off = iort_rd32(g_iort_base, sizeof(acpi_header_t) + 4);
+    uint16_t len = iort_rd16(its_group, 1);
+    uint32_t its_count = len >= 20 ? iort_rd32(its_group, 16) : 0;
+
+    // Insertion keeps the table sorted by (segment, rid_base).
+    uint32_t i = g_iort_map.count++;
+    while (i > 0) {
+        const acpi_iort_id_range_t* prev = &g_iort_map.ranges[i - 1];
+        if (prev->segment < segment || (prev->segment == segment && prev->rid_base <= rid_base))
+            break;
+        g_iort_map.ranges[i] = *prev;
+        i--;
+    }
 
-    __cosmos_serial_write("[ACPI-IORT] nodes=");
-    __cosmos_serial_write_dec_u32(node_count);
-    __cosmos_serial_write(" base=0x");
-    __cosmos_serial_write_hex_u64((uint64_t)(uintptr_t)g_iort_base);
-    __cosmos_serial_write("\n");
+    acpi_iort_id_range_t* r = &g_iort_map.ranges[i];
+    r->segment = segment;
+    r->rid_base = rid_base;
+    r->count = count;
+    r->device_id_base = device_id_base;
+    r->its_id = (its_count > 0 && len >= 24) ? iort_rd32(its_group, 20) : 0;
+}
 
-    // Sanity: walk once for diagnostics.
-    uint32_t off = node_array_off;
-    for (uint32_t i = 0; i < node_count && off + 16 <= g_iort_length; i++) {
-        uint8_t  type = g_iort_base[off];
-        uint16_t len  = iort_rd16(g_iort_base, off + 1);
-        if (len < 16) break;
-        if (type == IORT_NODE_ROOT_COMPLEX && len >= 32) {
-            uint32_t segment = iort_rd32(g_iort_base, off + 28);
-            uint32_t mappings = iort_rd32(g_iort_base, off + 8);
-            __cosmos_serial_write("[ACPI-IORT] Root Complex seg=");
-            __cosmos_serial_write_dec_u32(segment);
-            __cosmos_serial_write(" mappings=");
-            __cosmos_serial_write_dec_u32(mappings);
-            __cosmos_serial_write("\n");
-        } else if (type == IORT_NODE_ITS_GROUP) {
-            uint32_t its_count = (len >= 20) ? iort_rd32(g_iort_base, off + 16) : 0;
-            __cosmos_serial_write("[ACPI-IORT] ITS Group count=");
-            __cosmos_serial_write_dec_u32(its_count);
-            __cosmos_serial_write("\n");
-        }
-        off += len;
+// Requester IDs [rid_base, rid_base + count) of `segment` arrive at `node` as
+// input IDs [in_base, in_base + count). Follow every ID mapping of `node` that
+// overlaps them, splitting the range where mappings split it, until an ITS
+// Group is reached.
+static void iort_flatten(uint32_t segment, uint32_t rid_base, uint64_t count,
+                         uint32_t in_base, const uint8_t* node, int hops) {
+    if (node[0] == IORT_NODE_ITS_GROUP) {
+        iort_emit(segment, rid_base, (uint32_t)count, in_base, node);
+        return;
     }
-}
+    if (hops >= IORT_MAX_HOPS)
+        return;
 
-// Resolve a (segment, bdf) requester ID to an ITS DeviceID by walking IORT
-// Root Complex → ID mappings → ITS Group. Returns 0 on success, nonzero
-// otherwise. SMMU pass-through nodes are followed once (their input is the
-// requester ID, output continues to ITS).
-int acpi_iort_resolve_device_id(uint32_t segment, uint32_t bdf, uint32_t* out_device_id) {
-    if (out_device_id == NULL_PTR) return 1;
-    *out_device_id = bdf;  // identity fallback even on early return
+    uint32_t num_map = iort_rd32(node, 8);
+    uint32_t map_off = iort_rd32(node, 12);
+    uint32_t node_off = (uint32_t)(node - g_iort_base);
+    uint64_t in_last = (uint64_t)in_base + count - 1;
 
-    if (g_iort_base == NULL_PTR) return 1;
+    for (uint32_t i = 0; i < num_map; i++) {
+        // ID mapping: input_base(4) id_count(4) output_base(4) output_ref(4) flags(4) — 20 bytes
+        uint32_t m_off = node_off + map_off + i * 20;
+        if (m_off + 20 > g_iort_length) return;
+        const uint8_t* m = g_iort_base + m_off;
+
+        // Single-mapping entries (flags bit 0) are only architecturally
+        // valid on Named Component / PMCG nodes (ARM DEN 0049), neither
+        // of which appears on this RC → SMMU → ITS walk. On an RC hop a
+        // single-mapping entry would collapse EVERY RID into one
+        // DeviceID (two devices sharing a DeviceID: the second MAPD
+        // re-issues a fresh ITT and destroys the first device's event
+        // mappings); on SMMU nodes it describes the SMMU's own MSI
+        // DeviceID. Linux's iort_id_map rejects the flag on both as a
+        // firmware bug — skip such entries entirely.
+        if (iort_rd32(m, 16) & 1u)
+            continue;
+
+        // "Number of IDs" holds the range size MINUS ONE (ARM DEN 0049),
+        // so the mapping's last input ID is input_base + id_count.
+        uint64_t m_first = iort_rd32(m, 0);
+        uint64_t m_last = m_first + iort_rd32(m, 4);
+        uint64_t first = m_first > in_base ? m_first : in_base;
+        uint64_t last = m_last < in_last ? m_last : in_last;
+        if (first > last)
+            continue;
+
+        const uint8_t* next = iort_node_at(iort_rd32(m, 12));
+        if (next == NULL_PTR)
+            continue;
+
+        iort_flatten(segment, rid_base + (uint32_t)(first - in_base), last - first + 1,
+                     iort_rd32(m, 8) + (uint32_t)(first - m_first), next, hops + 1);
+    }
+}
+
+static void parse_iort(acpi_header_t* iort_header) {
+    g_iort_base = (uint8_t*)iort_header;
+    g_iort_length = iort_header->length;
 
     uint32_t node_count = iort_rd32(g_iort_base, sizeof(acpi_header_t));
     uint32_t node_array_off = iort_rd32(g_iort_base, sizeof(acpi_header_t) + 4);
 
-    // Find Root Complex matching segment.
+    COSMOS_LOG_INFO("[ACPI-IORT] nodes=%u base=%p\n", node_count, (void*)g_iort_base);
+
+    // Every Root Complex covers the full 16-bit RID space of its segment.
     uint32_t off = node_array_off;
-    const uint8_t* rc = NULL_PTR;
     for (uint32_t i = 0; i < node_count; i++) {
         const uint8_t* n = iort_node_at(off);
-        if (n == NULL_PTR) return 1;
+        if (n == NULL_PTR) break;
         uint16_t len = iort_rd16(n, 1);
         if (n[0] == IORT_NODE_ROOT_COMPLEX && len >= 32) {
-            uint32_t seg = iort_rd32(n, 28);
-            if (seg == segment) { rc = n; break; }
+            uint32_t segment = iort_rd32(n, 28);
+            COSMOS_LOG_DEBUG("[ACPI-IORT] Root Complex seg=%u mappings=%u\n", segment, iort_rd32(n, 8));
+            iort_flatten(segment, 0, 0x10000, 0, n, 0);
+        } else if (n[0] == IORT_NODE_ITS_GROUP) {
+            COSMOS_LOG_DEBUG("[ACPI-IORT] ITS Group count=%u\n", len >= 20 ? iort_rd32(n, 16) : 0);
         }
         off += len;
     }
-    if (rc == NULL_PTR) return 1;
 
-    uint32_t cur_id = bdf;
-    const uint8_t* node = rc;
+    for (uint32_t i = 0; i < g_iort_map.count; i++) {
+        const acpi_iort_id_range_t* r = &g_iort_map.ranges[i];
+        COSMOS_LOG_DEBUG("[ACPI-IORT] seg=%u RID 0x%x+%u -> DeviceID 0x%x (ITS %u)\n",
+                         r->segment, r->rid_base, r->count, r->device_id_base, r->its_id);
+    }
+    if (g_iort_map.dropped)
+        COSMOS_LOG_WARN("[ACPI-IORT] %u ID range(s) beyond the first %u ignored\n",
+                        g_iort_map.dropped, IORT_MAX_ID_RANGES);
+    COSMOS_LOG_INFO("[ACPI-IORT] %u RID range(s)\n", g_iort_map.count);
+}
 
-    // Walk up to two hops: RC → (optional) SMMU → ITS.
-    for (int hop = 0; hop < 3; hop++) {
-        uint8_t  ntype = node[0];
-        if (ntype == IORT_NODE_ITS_GROUP) {
-            *out_device_id = cur_id;
-            return 0;
-        }
+// Resolve a (segment, bdf) requester ID to an ITS DeviceID through the
+// flattened IORT. Returns 0 on success, nonzero otherwise (DeviceID = BDF).
+int acpi_iort_resolve_device_id(uint32_t segment, uint32_t bdf, uint32_t* out_device_id) {
+    if (out_device_id == NULL_PTR) return 1;
+    *out_device_id = bdf;  // identity fallback even on early return
 
-        uint32_t num_map = iort_rd32(node, 8);
-        uint32_t map_off = iort_rd32(node, 12);
-        if (num_map == 0) return 1;
+    // Last range starting at or before (segment, bdf).
+    uint32_t lo = 0, hi = g_iort_map.count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        const acpi_iort_id_range_t* r = &g_iort_map.ranges[mid];
+        if (r->segment < segment || (r->segment == segment && r->rid_base <= bdf))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0) return 1;
 
-        uint32_t node_off_in_table = (uint32_t)(node - g_iort_base);
-        const uint8_t* map = node + map_off;
-        // ID mapping: input_base(4) id_count(4) output_base(4) output_ref(4) flags(4) — 20 bytes
-        const uint8_t* hit = NULL_PTR;
-        for (uint32_t i = 0; i < num_map; i++) {
-            const uint8_t* m = map + i * 20;
-            // Bound check: map entry must fit within the IORT.
-            uint32_t m_off = node_off_in_table + map_off + i * 20;
-            if (m_off + 20 > g_iort_length) return 1;
-            uint32_t in_base = iort_rd32(m, 0);
-            uint32_t id_cnt  = iort_rd32(m, 4);
-            uint32_t flags   = iort_rd32(m, 16);
-            // Single-mapping entries (flags bit 0) are only architecturally
-            // valid on Named Component / PMCG nodes (ARM DEN 0049), neither
-            // of which appears on this RC → SMMU → ITS walk. On an RC hop a
-            // single-mapping entry would collapse EVERY RID into one
-            // DeviceID (two devices sharing a DeviceID: the second MAPD
-            // re-issues a fresh ITT and destroys the first device's event
-            // mappings); on SMMU nodes it describes the SMMU's own MSI
-            // DeviceID. Linux's iort_id_map rejects the flag on both as a
-            // firmware bug — skip such entries entirely, and never
-            // range-match them (id_count is 0, so the inclusive check
-            // below could fire on in_base).
-            if (flags & 1u) {
-                continue;
-            }
-            // "Number of IDs" holds the range size MINUS ONE (ARM DEN 0049),
-            // so the match is inclusive. An exclusive `< in_base + id_cnt`
-            // check drops the last ID of every range and never matches
-            // single-ID ranges (id_count == 0) — firmware with a
-            // non-identity mapping would then silently fall back to
-            // DeviceID = BDF and the ITS would discard every MSI.
-            if (cur_id >= in_base && cur_id - in_base <= id_cnt) {
-                hit = m;
-                break;
-            }
-        }
-        if (hit == NULL_PTR) return 1;
+    const acpi_iort_id_range_t* r = &g_iort_map.ranges[lo - 1];
+    if (r->segment != segment || bdf - r->rid_base >= r->count) return 1;
 
-        uint32_t in_base    = iort_rd32(hit, 0);
-        uint32_t out_base   = iort_rd32(hit, 8);
-        uint32_t out_ref    = iort_rd32(hit, 12);
-        // hit is always a range mapping (single-mapping entries are
-        // skipped above), so the output ID is base plus offset.
-        cur_id = out_base + (cur_id - in_base);
+    *out_device_id = r->device_id_base + (bdf - r->rid_base);
+    return 0;
+}
 
-        const uint8_t* next = iort_node_at(out_ref);
-        if (next == NULL_PTR) return 1;
-        node = next;
-    }
-    return 1;
+const acpi_iort_map_t* acpi_get_iort_map(void) {
+    return g_initialized ? &g_iort_map : NULL_PTR;
 }
 
 #else // !__aarch64__
@@ -568,6 +1365,10 @@ int acpi_iort_resolve_device_id(uint32_t segment, uint32_t bdf, uint32_t* out_de
     return 1;
 }
 
+const void* acpi_get_iort_map(void) {
+    return NULL_PTR;
+}
+
 #endif // __aarch64__
 
 // ============================================================================
@@ -575,10 +1376,10 @@ int acpi_iort_resolve_device_id(uint32_t segment, uint32_t bdf, uint32_t* out_de
 // ============================================================================
 
 void acpi_early_init(void* rsdp_address, uint64_t hhdm_offset) {
-    __cosmos_serial_write("[ACPI] acpi_early_init()\n");
+    COSMOS_LOG_DEBUG("[ACPI] acpi_early_init()\n");
 
     if (rsdp_address == NULL_PTR) {
-        __cosmos_serial_write("[ACPI] ERROR: RSDP is NULL\n");
+        COSMOS_LOG_ERROR("[ACPI] ERROR: RSDP is NULL\n");
         return;
     }
 
@@ -588,13 +1389,22 @@ void acpi_early_init(void* rsdp_address, uint64_t hhdm_offset) {
 #ifdef ARCH_X64
     for (int i = 0; i < (int)sizeof(g_madt_info); i++)
         ((uint8_t*)&g_madt_info)[i] = 0;
+    for (int i = 0; i < (int)sizeof(g_hpet_info); i++)
+        ((uint8_t*)&g_hpet_info)[i] = 0;
 #endif
 #ifdef __aarch64__
     for (int i = 0; i < (int)sizeof(g_gic_info); i++)
         ((uint8_t*)&g_gic_info)[i] = 0;
+    for (int i = 0; i < (int)sizeof(g_iort_map); i++)
+        ((uint8_t*)&g_iort_map)[i] = 0;
 #endif
     for (int i = 0; i < (int)sizeof(g_mcfg_info); i++)
         ((uint8_t*)&g_mcfg_info)[i] = 0;
+    for (int i = 0; i < (int)sizeof(g_ecam_segments); i++)
+        ((uint8_t*)g_ecam_segments)[i] = 0;
+    g_ecam_segment_count = 0;
+    for (int i = 0; i < (int)sizeof(g_numa_info); i++)
+        ((uint8_t*)&g_numa_info)[i] = 0;
 
     acpi_rsdp_t* rsdp = (acpi_rsdp_t*)rsdp_address;
 
@@ -603,47 +1413,78 @@ void acpi_early_init(void* rsdp_address, uint64_t hhdm_offset) {
         rsdp->signature[2] != 'D' || rsdp->signature[3] != ' ' ||
         rsdp->signature[4] != 'P' || rsdp->signature[5] != 'T' ||
         rsdp->signature[6] != 'R' || rsdp->signature[7] != ' ') {
-        __cosmos_serial_write("[ACPI] Invalid RSDP signature\n");
+        COSMOS_LOG_ERROR("[ACPI] Invalid RSDP signature\n");
         return;
     }
 
     int acpi_rev = (rsdp->revision == 0) ? 1 : 2;
-    __cosmos_serial_write("[ACPI] ACPI revision: ");
-    if (acpi_rev == 1) __cosmos_serial_write("1.0\n");
-    else __cosmos_serial_write("2.0+\n");
+    COSMOS_LOG_INFO("[ACPI] ACPI revision: %s\n", acpi_rev == 1 ? "1.0" : "2.0+");
 
     lai_set_acpi_revision(acpi_rev);
     cosmos_acpi_set_rsdp(rsdp_address);
 
+    uint32_t dir_phase = cosmos_boot_phase_begin("acpi.tables");
+    table_directory_build(rsdp);
+    cosmos_boot_phase_end(dir_phase);
+
     acpi_header_t* madt = (acpi_header_t*)cosmos_acpi_scan_table("APIC", 0);
     acpi_header_t* mcfg = (acpi_header_t*)cosmos_acpi_scan_table("MCFG", 0);
-    if (madt) __cosmos_serial_write("[ACPI] MADT found\n");
-    if (mcfg) __cosmos_serial_write("[ACPI] MCFG found\n");
+    if (madt) COSMOS_LOG_DEBUG("[ACPI] MADT found\n");
+    if (mcfg) COSMOS_LOG_DEBUG("[ACPI] MCFG found\n");
 
     if (madt) {
-        __cosmos_serial_write("[ACPI] Parsing MADT...\n");
+        COSMOS_LOG_DEBUG("[ACPI] Parsing MADT...\n");
+        uint32_t phase = cosmos_boot_phase_begin("acpi.madt");
         parse_madt(madt);
+        cosmos_boot_phase_end(phase);
     } else {
-        __cosmos_serial_write("[ACPI] WARNING: MADT not found\n");
+        COSMOS_LOG_WARN("[ACPI] WARNING: MADT not found\n");
     }
 
     if (mcfg) {
-        __cosmos_serial_write("[ACPI] Parsing MCFG...\n");
+        COSMOS_LOG_DEBUG("[ACPI] Parsing MCFG...\n");
+        uint32_t phase = cosmos_boot_phase_begin("acpi.mcfg");
         parse_mcfg(mcfg);
+        cosmos_boot_phase_end(phase);
+    }
+
+    acpi_header_t* srat = (acpi_header_t*)cosmos_acpi_scan_table("SRAT", 0);
+    if (srat) {
+        COSMOS_LOG_DEBUG("[ACPI] SRAT found, parsing...\n");
+        uint32_t phase = cosmos_boot_phase_begin("acpi.numa");
+        parse_srat(srat);
+        acpi_header_t* slit = (acpi_header_t*)cosmos_acpi_scan_table("SLIT", 0);
+        if (slit)
+            parse_slit(slit);
+        cosmos_boot_phase_end(phase);
+    }
+
+#ifdef ARCH_X64
+    acpi_header_t* hpet = (acpi_header_t*)cosmos_acpi_scan_table("HPET", 0);
+    if (hpet) {
+        COSMOS_LOG_DEBUG("[ACPI] HPET found, parsing...\n");
+        uint32_t phase = cosmos_boot_phase_begin("acpi.hpet");
+        parse_hpet(hpet);
+        cosmos_boot_phase_end(phase);
+    } else {
+        COSMOS_LOG_INFO("[ACPI] HPET not present\n");
     }
+#endif
 
 #ifdef __aarch64__
     acpi_header_t* iort = (acpi_header_t*)cosmos_acpi_scan_table("IORT", 0);
     if (iort) {
-        __cosmos_serial_write("[ACPI] IORT found, parsing...\n");
+        COSMOS_LOG_DEBUG("[ACPI] IORT found, parsing...\n");
+        uint32_t phase = cosmos_boot_phase_begin("acpi.iort");
         parse_iort(iort);
+        cosmos_boot_phase_end(phase);
     } else {
-        __cosmos_serial_write("[ACPI] IORT not present (DeviceID = BDF)\n");
+        COSMOS_LOG_INFO("[ACPI] IORT not present (DeviceID = BDF)\n");
     }
 #endif
 
     g_initialized = 1;
-    __cosmos_serial_write("[ACPI] Init complete\n");
+    COSMOS_LOG_INFO("[ACPI] Init complete\n");
 }
 
 // ============================================================================
@@ -651,8 +1492,17 @@ void acpi_early_init(void* rsdp_address, uint64_t hhdm_offset) {
 // ============================================================================
 
 #ifdef ARCH_X64
+// The first call allocates the MADT arrays on the Cosmos heap (see
+// madt_materialize), so it must come from managed code after heap init.
 const acpi_madt_info_t* acpi_get_madt_info(void) {
-    return g_initialized ? &g_madt_info : NULL_PTR;
+    if (!g_initialized) return NULL_PTR;
+    madt_materialize();
+    return &g_madt_info;
+}
+
+// Heap-free.
+const acpi_hpet_info_t* acpi_get_hpet_info(void) {
+    return g_initialized && g_hpet_info.found ? &g_hpet_info : NULL_PTR;
 }
 #endif
 
@@ -660,42 +1510,280 @@ const acpi_madt_info_t* acpi_get_madt_info(void) {
 const acpi_gic_info_t* acpi_get_gic_info(void) {
     return g_initialized ? &g_gic_info : NULL_PTR;
 }
+
+// Second walk over the GICC entries, run once the Cosmos heap is up: one
+// slot per enabled processor the early walk counted.
+static void gicc_materialize(void) {
+    if (g_gicc_materialized || g_gicc_madt == NULL_PTR)
+        return;
+    g_gicc_materialized = 1;
+
+    g_gicc_cpus = (acpi_gicc_cpu_t*)acpi_table_alloc(g_gicc_cpu_count, sizeof(acpi_gicc_cpu_t), "MADT GICC");
+    if (g_gicc_cpus == NULL_PTR)
+        return;
+
+    const uint8_t* madt = g_gicc_madt;
+    uint32_t length = ((const acpi_header_t*)madt)->length;
+    uint32_t offset = sizeof(acpi_header_t) + 8;
+    while (offset + 2 <= length && g_gicc_filled < g_gicc_cpu_count) {
+        uint8_t entry_len = madt[offset + 1];
+        if (entry_len < 2) break;
+        // GICC: offset+8=UID(4), offset+12=flags(4), offset+68=MPIDR(8)
+        if (madt[offset] == MADT_TYPE_GICC && entry_len >= 76 &&
+            (*(const uint32_t*)(madt + offset + 12) & MADT_GICC_ENABLED)) {
+            acpi_gicc_cpu_t* cpu = &g_gicc_cpus[g_gicc_filled++];
+            cpu->uid = *(const uint32_t*)(madt + offset + 8);
+            cpu->mpidr = *(const uint64_t*)(madt + offset + 68) & MADT_GICC_MPIDR_AFFINITY;
+        }
+        offset += entry_len;
+    }
+}
+
+// ACPI processor UID of the enabled GICC entry whose MPIDR matches `mpidr`
+// (MT and U bits ignored), or 0xFFFFFFFF when the MADT does not list it.
+// The first call allocates the GICC array on the Cosmos heap (see
+// gicc_materialize), so it must come from managed code after heap init.
+uint32_t acpi_get_gicc_uid(uint64_t mpidr) {
+    if (!g_initialized) return 0xFFFFFFFF;
+    gicc_materialize();
+    mpidr &= MADT_GICC_MPIDR_AFFINITY;
+    for (uint32_t i = 0; i < g_gicc_filled; i++) {
+        if (g_gicc_cpus[i].mpidr == mpidr)
+            return g_gicc_cpus[i].uid;
+    }
+    return 0xFFFFFFFF;
+}
+#endif
+
+// Enabled processors in the MADT (LAPIC/x2APIC or GICC entries), 0 if there
+// is none. Heap-free, so kmain can use it before managed startup.
+uint32_t acpi_get_cpu_count(void) {
+    if (!g_initialized) return 0;
+#ifdef ARCH_X64
+    return g_madt_info.cpu_count;
+#else
+    return g_gicc_cpu_count;
 #endif
+}
 
 const acpi_mcfg_info_t* acpi_get_mcfg_info(void) {
     return g_initialized ? &g_mcfg_info : NULL_PTR;
 }
 
+// Heap-free: safe to call from PageAllocator.InitializeHeap.
+const acpi_numa_info_t* acpi_get_numa_info(void) {
+    return g_initialized ? &g_numa_info : NULL_PTR;
+}
+
+// SRAT CPU affinity entries, *count of them (0 and NULL without an SRAT).
+// The first call allocates the array on the Cosmos heap (see
+// numa_materialize_cpus), so it must come from managed code after heap init.
+const acpi_numa_cpu_t* acpi_get_numa_cpus(uint32_t* count) {
+    *count = 0;
+    if (!g_initialized) return NULL_PTR;
+    numa_materialize_cpus();
+    *count = g_numa_cpus_filled;
+    return g_numa_cpus;
+}
+
 // ============================================================================
 // Power management — ACPI _S5 / FADT reset via LAI (x86 only)
 // ============================================================================
 
 #ifdef ARCH_X64
 
-// Lazily build the AML namespace on first PM call. lai_acpi_reset() reads the
-// FADT directly via laihost_scan and doesn't need the namespace, but
-// lai_enter_sleep(5) must resolve \\_S5_ from the DSDT.
-static int g_namespace_created = 0;
+// Objects the power path and IRQ routing query, resolved once the AML
+// namespace exists so later lookups are table reads instead of AML walks.
+#define ACPI_PM_MAX_PRT_ROUTES 128
 
-int cosmos_acpi_shutdown(void) {
+typedef struct {
+    uint8_t slot;        // device number on the root bus
+    uint8_t pin;         // 1 = INTA# .. 4 = INTD#
+    uint8_t irq_flags;   // LAI acpi_resource_t.irq_flags (trigger / polarity)
+    uint8_t reserved;
+    uint32_t gsi;        // global system interrupt the pin is routed to
+} acpi_prt_route_t;
+
+typedef struct {
+    uint8_t namespace_ready;  // lai_create_namespace() has completed
+    uint8_t s5_valid;         // \_S5_ evaluated to a package of SLP_TYP values
+    uint8_t slp_typa;
+    uint8_t slp_typb;
+    uint8_t pts_present;      // \_PTS exists
+    uint8_t reserved;
+    uint16_t prt_count;       // root-bus _PRT routes in prt[]
+    acpi_prt_route_t prt[ACPI_PM_MAX_PRT_ROUTES];
+} acpi_pm_cache_t;
+
+static acpi_pm_cache_t g_pm_cache;
+
+// 0 = not built, 1 = being built, 2 = ready.
+static uint32_t g_namespace_state = 0;
+
+// \_PTS, evaluated with the target state right before entering it.
+static lai_nsnode_t* g_pts_node = NULL_PTR;
+
+// PM1 control register fields (ACPI 6.x, 4.8.3.2.1).
+#define ACPI_PM1_SLP_TYP_SHIFT 10
+#define ACPI_PM1_SLP_TYP_MASK  (7u << ACPI_PM1_SLP_TYP_SHIFT)
+#define ACPI_PM1_SLP_EN        (1u << 13)
+
+#define ACPI_SLEEP_STATE_S5 5
+
+// \_S5_ sleep types and \_PTS: everything entering S5 needs.
+static void resolve_sleep_objects(void) {
+    lai_state_t state;
+
+    lai_nsnode_t* s5 = lai_resolve_path(NULL_PTR, "\\_S5_");
+    if (s5 != NULL_PTR) {
+        lai_variable_t pkg = LAI_VAR_INITIALIZER;
+        lai_init_state(&state);
+        if (lai_eval(&pkg, s5, &state) == LAI_ERROR_NONE) {
+            lai_variable_t elem = LAI_VAR_INITIALIZER;
+            uint64_t typa = 0, typb = 0;
+            if (lai_obj_get_pkg(&pkg, 0, &elem) == LAI_ERROR_NONE
+                && lai_obj_get_integer(&elem, &typa) == LAI_ERROR_NONE) {
+                lai_var_finalize(&elem);
+                if (lai_obj_get_pkg(&pkg, 1, &elem) == LAI_ERROR_NONE)
+                    lai_obj_get_integer(&elem, &typb);
+                g_pm_cache.slp_typa = (uint8_t)typa;
+                g_pm_cache.slp_typb = (uint8_t)typb;
+                g_pm_cache.s5_valid = 1;
+            }
+            lai_var_finalize(&elem);
+        }
+        lai_finalize_state(&state);
+        lai_var_finalize(&pkg);
+    }
+
+    g_pts_node = lai_resolve_path(NULL_PTR, "\\_PTS");
+    g_pm_cache.pts_present = g_pts_node != NULL_PTR;
+}
+
+// Root-bus legacy INTx routing, including routes through link devices.
+static void resolve_prt_routes(void) {
+    for (uint8_t slot = 0; slot < 32; slot++) {
+        for (uint8_t pin = 1; pin <= 4; pin++) {
+            if (g_pm_cache.prt_count >= ACPI_PM_MAX_PRT_ROUTES)
+                return;
+            acpi_resource_t res;
+            if (lai_pci_route_pin(&res, 0, 0, slot, 0, pin) != LAI_ERROR_NONE)
+                continue;
+            acpi_prt_route_t* r = &g_pm_cache.prt[g_pm_cache.prt_count++];
+            r->slot = slot;
+            r->pin = pin;
+            r->irq_flags = res.irq_flags;
+            r->gsi = (uint32_t)res.base;
+        }
+    }
+}
+
+// Build the namespace and fill the PM cache. The caller has moved
+// g_namespace_state from 0 to 1.
+static void build_namespace(int with_routes) {
+    COSMOS_LOG_INFO("[ACPI-PM] Creating AML namespace...\n");
+    lai_create_namespace();
+    resolve_sleep_objects();
+    if (with_routes)
+        resolve_prt_routes();
+    g_pm_cache.namespace_ready = 1;
+
+    COSMOS_LOG_INFO("[ACPI-PM] Namespace ready: S5=%u (%u/%u) _PTS=%u PRT routes=%u\n",
+                    g_pm_cache.s5_valid, g_pm_cache.slp_typa, g_pm_cache.slp_typb,
+                    g_pm_cache.pts_present, g_pm_cache.prt_count);
+    __atomic_store_n(&g_namespace_state, 2, __ATOMIC_RELEASE);
+}
+
+// Build the AML namespace and the PM cache, _PRT routes included. Runs ahead
+// of time from a background thread (CosmosEnableAcpiEagerNamespace) so
+// shutdown does not pay for parsing the DSDT/SSDTs. Returns 0 once the
+// namespace is ready, 1 when ACPI is absent or another thread is building it.
+int cosmos_acpi_prepare_namespace(void) {
     if (cosmos_acpi_get_rsdp() == NULL_PTR) return 1;
-    if (!g_namespace_created) {
-        __cosmos_serial_write("[ACPI-PM] Creating AML namespace...\n");
-        lai_create_namespace();
-        g_namespace_created = 1;
+
+    uint32_t expected = 0;
+    if (!__atomic_compare_exchange_n(&g_namespace_state, &expected, 1, 0,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+        return expected == 2 ? 0 : 1;
+
+    build_namespace(1);
+    return 0;
+}
+
+// 0 = not built, 1 = being built, 2 = ready (AcpiPmNative.GetNamespaceState).
+uint32_t cosmos_acpi_namespace_state(void) {
+    return __atomic_load_n(&g_namespace_state, __ATOMIC_ACQUIRE);
+}
+
+const acpi_pm_cache_t* acpi_get_pm_cache(void) {
+    return __atomic_load_n(&g_namespace_state, __ATOMIC_ACQUIRE) == 2 ? &g_pm_cache : NULL_PTR;
+}
+
+// Enter S5 from the cache: run \_PTS(5), then write SLP_TYPa/b with SLP_EN
+// to the FADT PM1a/PM1b control blocks (what lai_enter_sleep does, minus
+// re-resolving and re-evaluating \_S5_).
+static int enter_s5(void) {
+    const acpi_table_entry_t* facp = table_directory_find("FACP", 0);
+    if (facp == NULL_PTR || !g_pm_cache.s5_valid) return 1;
+    acpi_fadt_t* fadt = (acpi_fadt_t*)(uintptr_t)facp->virt_address;
+    if (fadt->pm1a_control_block == 0) return 1;
+
+    if (g_pts_node != NULL_PTR) {
+        lai_state_t state;
+        lai_variable_t arg = LAI_VAR_INITIALIZER;
+        arg.type = LAI_INTEGER;
+        arg.integer = ACPI_SLEEP_STATE_S5;
+        lai_init_state(&state);
+        lai_eval_largs(NULL_PTR, g_pts_node, &state, &arg, NULL_PTR);
+        lai_finalize_state(&state);
+    }
+
+    COSMOS_LOG_INFO("[ACPI-PM] Entering S5 (SLP_TYP %u/%u)\n", g_pm_cache.slp_typa, g_pm_cache.slp_typb);
+    cosmos_log_flush();     // nothing queued survives S5
+
+    uint16_t pm1a = laihost_inw((uint16_t)fadt->pm1a_control_block);
+    pm1a = (uint16_t)((pm1a & ~ACPI_PM1_SLP_TYP_MASK) | (g_pm_cache.slp_typa << ACPI_PM1_SLP_TYP_SHIFT) | ACPI_PM1_SLP_EN);
+    laihost_outw((uint16_t)fadt->pm1a_control_block, pm1a);
+    if (fadt->pm1b_control_block != 0) {
+        uint16_t pm1b = laihost_inw((uint16_t)fadt->pm1b_control_block);
+        pm1b = (uint16_t)((pm1b & ~ACPI_PM1_SLP_TYP_MASK) | (g_pm_cache.slp_typb << ACPI_PM1_SLP_TYP_SHIFT) | ACPI_PM1_SLP_EN);
+        laihost_outw((uint16_t)fadt->pm1b_control_block, pm1b);
     }
-    __cosmos_serial_write("[ACPI-PM] lai_enter_sleep(S5)\n");
-    return (int)lai_enter_sleep(5);
+    return 0;
+}
+
+// lai_acpi_reset() reads the FADT directly via laihost_scan and doesn't need the
+// namespace, but S5 needs \_S5_ and \_PTS from it. A namespace the background
+// thread already built is reused as is. Without one, this builds it and
+// resolves only those two objects: the _PRT walk is of no use on the way
+// down. A background build still in progress is waited for by X64PowerOps
+// while interrupts are on; if it outlasts that wait, the caller falls back
+// to its emulator ports.
+int cosmos_acpi_shutdown(void) {
+    if (cosmos_acpi_get_rsdp() == NULL_PTR) return 1;
+
+    uint32_t expected = 0;
+    if (__atomic_compare_exchange_n(&g_namespace_state, &expected, 1, 0,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+        build_namespace(0);
+    else if (expected != 2)
+        return 1;
+
+    return enter_s5();
 }
 
 int cosmos_acpi_reset(void) {
-    __cosmos_serial_write("[ACPI-PM] lai_acpi_reset\n");
+    COSMOS_LOG_INFO("[ACPI-PM] lai_acpi_reset\n");
+    cosmos_log_flush();
     return (int)lai_acpi_reset();
 }
 
 #else
 
 // LAI's PM helpers are x86-only (port I/O via FADT PM1a). ARM64 uses PSCI.
+int cosmos_acpi_prepare_namespace(void) { return 1; }
+uint32_t cosmos_acpi_namespace_state(void) { return 0; }
+const void* acpi_get_pm_cache(void) { return NULL_PTR; }
 int cosmos_acpi_shutdown(void) { return 1; }
 int cosmos_acpi_reset(void) { return 1; }
 
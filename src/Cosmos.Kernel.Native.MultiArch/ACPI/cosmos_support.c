@@ -7,6 +7,8 @@
 // External symbols from Cosmos kernel
 extern void* __cosmos_heap_alloc(size_t size);
 extern void __cosmos_heap_free(void* ptr);
+extern void* __cosmos_heap_realloc(void* ptr, size_t size);
+extern void __cosmos_heap_free_sized(void* ptr, size_t size);
 extern void __cosmos_serial_write(const char* str);
 
 // ============================================================================
@@ -21,6 +23,16 @@ void cosmos_free(void* ptr) {
     __cosmos_heap_free(ptr);
 }
 
+// Grows or shrinks in place when the heap's size class allows, so callers
+// must not assume the old block is still valid after a non-NULL return.
+void* cosmos_realloc(void* ptr, size_t size) {
+    return __cosmos_heap_realloc(ptr, size);
+}
+
+void cosmos_free_sized(void* ptr, size_t size) {
+    __cosmos_heap_free_sized(ptr, size);
+}
+
 // ============================================================================
 // Logging (uses Cosmos serial output)
 // ============================================================================
@@ -6,9 +6,13 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "cosmos_log.h"
+
 // External functions provided by Cosmos kernel
 extern void* cosmos_malloc(size_t size);
 extern void cosmos_free(void* ptr);
+extern void* cosmos_realloc(void* ptr, size_t size);
+extern void cosmos_free_sized(void* ptr, size_t size);
 extern void cosmos_log(const char* msg);
 extern void* cosmos_acpi_get_rsdp(void);
 extern void* cosmos_acpi_scan_table(const char* signature, size_t index);
@@ -22,41 +26,136 @@ void* laihost_malloc(size_t size) {
 }
 
 void laihost_free(void* ptr, size_t size) {
-    (void)size;
-    cosmos_free(ptr);
+    if (!ptr)
+        return;
+    cosmos_free_sized(ptr, size);
 }
 
+// The AML interpreter grows strings, buffers and packages one step at a time
+// during namespace creation; the heap resizes those in place whenever the
+// new size stays in the same size class instead of copying every step.
+// oldsize is not needed: the heap header already records it.
 void* laihost_realloc(void* ptr, size_t newsize, size_t oldsize) {
-    if (!ptr)
-        return laihost_malloc(newsize);
+    (void)oldsize;
+    return cosmos_realloc(ptr, newsize);
+}
 
-    if (newsize == 0) {
-        laihost_free(ptr, oldsize);
-        return (void*)0;
-    }
+// ============================================================================
+// LAI Host Interface - Physical Mapping
+// ============================================================================
 
-    void* new_ptr = laihost_malloc(newsize);
-    if (!new_ptr)
-        return (void*)0;
+// SystemMemory OperationRegions are accessed through the HHDM alias
+// (phys + HHDM offset). Device registers outside the boot-time HHDM are
+// mapped by the kernel's DeviceMapper (Memory/MmioMapping.cs), which works
+// in 2 MiB blocks. Hot AML methods (battery/thermal polling, _PSx) map the same
+// few registers on every field access, so recently mapped blocks are kept in
+// a small LRU and a hit skips the call into the kernel.
+//
+// laihost_unmap drops a reference. Unreferenced entries stay cached until
+// evicted; the block mapping itself is never torn down. The HHDM alias is
+// shared with the rest of the kernel and DeviceMapper mappings are permanent.
 
-    size_t copy_size = (newsize < oldsize) ? newsize : oldsize;
-    uint8_t* dst = (uint8_t*)new_ptr;
-    uint8_t* src = (uint8_t*)ptr;
-    for (size_t i = 0; i < copy_size; i++)
-        dst[i] = src[i];
+#define LAI_MAP_CACHE_SLOTS 8
+#define LAI_MAP_BLOCK_SIZE  0x200000ULL
 
-    laihost_free(ptr, oldsize);
-    return new_ptr;
+typedef struct {
+    uint64_t phys;      // first block, LAI_MAP_BLOCK_SIZE aligned; 0 length = free
+    uint64_t length;    // bytes covered, a multiple of LAI_MAP_BLOCK_SIZE
+    uint32_t refs;      // outstanding laihost_map calls not yet unmapped
+    uint32_t last_use;  // g_lai_map_clock at the latest hit
+} lai_map_entry_t;
+
+static lai_map_entry_t g_lai_map_cache[LAI_MAP_CACHE_SLOTS];
+static uint32_t g_lai_map_clock = 0;
+static uint32_t g_lai_map_lock = 0;
+
+extern uint64_t acpi_get_hhdm_offset(void);
+extern int __cosmos_mmio_map(uint64_t phys, uint64_t length);
+extern uint64_t _native_cpu_save_irq_and_disable(void);
+extern void _native_cpu_restore_irq(uint64_t flags);
+
+// The cache is shared by every CPU and by SCI-time AML, so it is guarded
+// with interrupts off. Nothing inside the lock calls out of this file.
+static uint64_t lai_map_lock(void) {
+    uint64_t flags = _native_cpu_save_irq_and_disable();
+    while (__atomic_exchange_n(&g_lai_map_lock, 1, __ATOMIC_ACQUIRE) != 0) { }
+    return flags;
+}
+
+static void lai_map_unlock(uint64_t flags) {
+    __atomic_store_n(&g_lai_map_lock, 0, __ATOMIC_RELEASE);
+    _native_cpu_restore_irq(flags);
+}
+
+// Entry covering [base, end), or NULL. Caller holds the lock.
+static lai_map_entry_t* lai_map_find(uint64_t base, uint64_t end) {
+    for (int i = 0; i < LAI_MAP_CACHE_SLOTS; i++) {
+        lai_map_entry_t* e = &g_lai_map_cache[i];
+        if (e->length != 0 && e->phys <= base && end <= e->phys + e->length)
+            return e;
+    }
+    return NULL;
 }
 
 void* laihost_map(size_t address, size_t count) {
-    (void)count;
-    return (void*)address;
+    uint64_t hhdm = acpi_get_hhdm_offset();
+    uint64_t base = (uint64_t)address & ~(LAI_MAP_BLOCK_SIZE - 1);
+    uint64_t end = ((uint64_t)address + (count ? count : 1) + LAI_MAP_BLOCK_SIZE - 1)
+                 & ~(LAI_MAP_BLOCK_SIZE - 1);
+
+    uint64_t flags = lai_map_lock();
+    lai_map_entry_t* hit = lai_map_find(base, end);
+    if (hit) {
+        hit->refs++;
+        hit->last_use = ++g_lai_map_clock;
+    }
+    lai_map_unlock(flags);
+    if (hit)
+        return (void*)((uint64_t)address + hhdm);
+
+    // May allocate page tables: done outside the lock. 0 means no platform
+    // mapper is registered yet and only the boot-time HHDM backs the alias;
+    // leave it uncached so the next call asks the mapper again.
+    if (__cosmos_mmio_map(base, end - base) != 1)
+        return (void*)((uint64_t)address + hhdm);
+
+    flags = lai_map_lock();
+    lai_map_entry_t* slot = lai_map_find(base, end);   // another CPU may have won
+    if (!slot) {
+        // Free slot first, else the least recently used unreferenced one.
+        // With every slot referenced the mapping is simply not cached.
+        for (int i = 0; i < LAI_MAP_CACHE_SLOTS; i++) {
+            lai_map_entry_t* e = &g_lai_map_cache[i];
+            if (e->length == 0) { slot = e; break; }
+            if (e->refs == 0 && (!slot || e->last_use < slot->last_use))
+                slot = e;
+        }
+        if (slot) {
+            slot->phys = base;
+            slot->length = end - base;
+            slot->refs = 0;
+        }
+    }
+    if (slot) {
+        slot->refs++;
+        slot->last_use = ++g_lai_map_clock;
+    }
+    lai_map_unlock(flags);
+
+    return (void*)((uint64_t)address + hhdm);
 }
 
 void laihost_unmap(void* pointer, size_t count) {
-    (void)pointer;
-    (void)count;
+    if (!pointer)
+        return;
+    uint64_t phys = (uint64_t)pointer - acpi_get_hhdm_offset();
+    uint64_t end = phys + (count ? count : 1);
+
+    uint64_t flags = lai_map_lock();
+    lai_map_entry_t* e = lai_map_find(phys, end);
+    if (e && e->refs > 0)
+        e->refs--;
+    lai_map_unlock(flags);
 }
 
 // ============================================================================
@@ -74,18 +173,17 @@ void* laihost_scan(const char* signature, size_t index) {
 // LAI Host Interface - Logging
 // ============================================================================
 
+// LAI messages carry no trailing newline.
 void laihost_log(int level, const char* message) {
-    const char* prefix;
     switch (level) {
-        case LAI_DEBUG_LOG: prefix = "[LAI DEBUG] "; break;
-        case LAI_WARN_LOG:  prefix = "[LAI WARN] ";  break;
-        default:            prefix = "[LAI] ";        break;
+        case LAI_DEBUG_LOG: COSMOS_LOG_DEBUG("[LAI DEBUG] %s\n", message); break;
+        case LAI_WARN_LOG:  COSMOS_LOG_WARN("[LAI WARN] %s\n", message);   break;
+        default:            COSMOS_LOG_INFO("[LAI] %s\n", message);        break;
     }
-    cosmos_log(prefix);
-    cosmos_log(message);
 }
 
 void laihost_panic(const char* message) {
+    cosmos_log_flush();
     cosmos_log("[LAI PANIC] ");
     cosmos_log(message);
 #ifdef __aarch64__
@@ -96,30 +194,21 @@ void laihost_panic(const char* message) {
 }
 
 // ============================================================================
-// LAI Host Interface - Synchronization (stubs for single-core)
-// ============================================================================
-
-void* laihost_lock_alloc(void) { return (void*)1; }
-void laihost_lock_free(void* lock) { (void)lock; }
-void laihost_lock_acquire(void* lock) { (void)lock; }
-void laihost_lock_release(void* lock) { (void)lock; }
-
-// ============================================================================
-// LAI Host Interface - PCI Access (stubs)
+// LAI Host Interface - Synchronization
 // ============================================================================
 
-void laihost_pci_write(uint16_t seg, uint8_t bus, uint8_t slot,
-                       uint8_t fun, uint16_t offset, uint32_t value, uint8_t size) {
-    (void)seg; (void)bus; (void)slot; (void)fun;
-    (void)offset; (void)value; (void)size;
-}
+// IRQ-safe ticket locks owned by the kernel (Bridge/Export/LockNative.cs):
+// AML evaluation on one CPU cannot race the others or deadlock against an
+// SCI taken on the holding CPU. Hold times are counted on the managed side.
+extern void* __cosmos_lock_alloc(void);
+extern void __cosmos_lock_free(void* lock);
+extern void __cosmos_lock_acquire(void* lock);
+extern void __cosmos_lock_release(void* lock);
 
-uint32_t laihost_pci_read(uint16_t seg, uint8_t bus, uint8_t slot,
-                          uint8_t fun, uint16_t offset, uint8_t size) {
-    (void)seg; (void)bus; (void)slot; (void)fun;
-    (void)offset; (void)size;
-    return 0;
-}
+void* laihost_lock_alloc(void) { return __cosmos_lock_alloc(); }
+void laihost_lock_free(void* lock) { if (lock) __cosmos_lock_free(lock); }
+void laihost_lock_acquire(void* lock) { __cosmos_lock_acquire(lock); }
+void laihost_lock_release(void* lock) { __cosmos_lock_release(lock); }
 
 // ============================================================================
 // LAI Host Interface - Port I/O (x86 only, stubs for ARM64)
@@ -164,15 +253,216 @@ uint32_t laihost_ind(uint16_t port) {
 #endif
 
 // ============================================================================
-// LAI Host Interface - Sleep/Timing (stubs)
+// LAI Host Interface - PCI Access
 // ============================================================================
+//
+// PCI_Config OperationRegions go straight to ECAM through the HHDM, using the
+// MCFG allocation that decodes (segment, bus) -- see acpi_pci_config_address
+// in acpi_wrapper.c. Without an MCFG entry for the bus, x86 falls back to
+// configuration mechanism #1 (0xCF8/0xCFC) for segment 0; anything else reads
+// as all ones, like an absent device, and writes are dropped.
+
+extern volatile void* acpi_pci_config_address(uint16_t segment, uint8_t bus, uint8_t slot,
+                                              uint8_t fun, uint16_t offset);
+
+#ifndef __aarch64__
+#define LAI_PCI_CONFIG_ADDRESS 0xCF8
+#define LAI_PCI_CONFIG_DATA    0xCFC
+
+static inline uint32_t lai_pci_cf8(uint8_t bus, uint8_t slot, uint8_t fun, uint16_t offset) {
+    return 0x80000000u | ((uint32_t)bus << 16) | ((uint32_t)(slot & 0x1F) << 11) |
+           ((uint32_t)(fun & 0x7) << 8) | (offset & 0xFC);
+}
+#endif
+
+void laihost_pci_write(uint16_t seg, uint8_t bus, uint8_t slot,
+                       uint8_t fun, uint16_t offset, uint32_t value, uint8_t size) {
+    volatile void* reg = acpi_pci_config_address(seg, bus, slot, fun, offset);
+    if (reg) {
+        switch (size) {
+            case 1: *(volatile uint8_t*)reg = (uint8_t)value; break;
+            case 2: *(volatile uint16_t*)reg = (uint16_t)value; break;
+            case 4: *(volatile uint32_t*)reg = value; break;
+            default: COSMOS_LOG_WARN("[LAI] PCI write of %u bytes ignored\n", size); break;
+        }
+        return;
+    }
+
+#ifndef __aarch64__
+    if (seg != 0 || offset > 0xFF)
+        return;
+    laihost_outd(LAI_PCI_CONFIG_ADDRESS, lai_pci_cf8(bus, slot, fun, offset));
+    uint16_t port = (uint16_t)(LAI_PCI_CONFIG_DATA + (offset & 3));
+    switch (size) {
+        case 1: laihost_outb(port, (uint8_t)value); break;
+        case 2: laihost_outw(port, (uint16_t)value); break;
+        case 4: laihost_outd(LAI_PCI_CONFIG_DATA, value); break;
+        default: break;
+    }
+#endif
+}
+
+uint32_t laihost_pci_read(uint16_t seg, uint8_t bus, uint8_t slot,
+                          uint8_t fun, uint16_t offset, uint8_t size) {
+    volatile void* reg = acpi_pci_config_address(seg, bus, slot, fun, offset);
+    if (reg) {
+        switch (size) {
+            case 1: return *(volatile uint8_t*)reg;
+            case 2: return *(volatile uint16_t*)reg;
+            case 4: return *(volatile uint32_t*)reg;
+            default:
+                COSMOS_LOG_WARN("[LAI] PCI read of %u bytes ignored\n", size);
+                return 0xFFFFFFFFu;
+        }
+    }
+
+#ifndef __aarch64__
+    if (seg == 0 && offset <= 0xFF) {
+        laihost_outd(LAI_PCI_CONFIG_ADDRESS, lai_pci_cf8(bus, slot, fun, offset));
+        uint16_t port = (uint16_t)(LAI_PCI_CONFIG_DATA + (offset & 3));
+        switch (size) {
+            case 1: return laihost_inb(port);
+            case 2: return laihost_inw(port);
+            case 4: return laihost_ind(LAI_PCI_CONFIG_DATA);
+            default: break;
+        }
+    }
+#endif
+
+    return size == 1 ? 0xFFu : size == 2 ? 0xFFFFu : 0xFFFFFFFFu;
+}
+
+// ============================================================================
+// LAI Host Interface - Sleep/Timing
+// ============================================================================
+//
+// Monotonic clock: TSC on x86-64, CNTVCT_EL0 on ARM64. The TSC frequency is
+// pushed from managed code once X64CpuOps.CalibrateTsc() has run (LAPIC
+// timer, itself PIT-calibrated); if AML or the SMP bring-up (kmain Phase
+// 2.5) needs it before that, it is measured here against PIT channel 2. The ARM64 generic timer reports its own
+// frequency in CNTFRQ_EL0.
+
+// Cooperative sleep (SchedulerNative.cs). Returns 0 when the scheduler
+// cannot park the caller; the remaining time is then spun.
+extern int __cosmos_scheduler_sleep(uint32_t ms);
+
+// Sleeps at least this long go to the scheduler rather than spinning: about
+// one scheduler tick, the granularity a parked thread is woken at.
+#define LAI_SLEEP_YIELD_MS 10
+
+// 100ns units per second (the AML Timer opcode resolution).
+#define LAI_TIMER_UNITS_PER_SEC 10000000ULL
+
+static uint64_t g_lai_clock_hz = 0;
+
+static inline uint64_t lai_clock_read(void) {
+#ifdef __aarch64__
+    uint64_t value;
+    __asm__ volatile ("isb; mrs %0, cntvct_el0" : "=r"(value) : : "memory");
+    return value;
+#else
+    uint32_t lo, hi;
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+static inline void lai_cpu_relax(void) {
+#ifdef __aarch64__
+    __asm__ volatile ("yield");
+#else
+    __asm__ volatile ("pause");
+#endif
+}
+
+static inline int lai_irqs_enabled(void) {
+#ifdef __aarch64__
+    uint64_t daif;
+    __asm__ volatile ("mrs %0, daif" : "=r"(daif));
+    return (daif & (1u << 7)) == 0;     // DAIF.I clear
+#else
+    uint64_t rflags;
+    __asm__ volatile ("pushfq; popq %0" : "=r"(rflags));
+    return (rflags & (1u << 9)) != 0;   // RFLAGS.IF
+#endif
+}
+
+#ifndef __aarch64__
+// Time a 10 ms one-shot on PIT channel 2 (gate via port 0x61, speaker off).
+// Returns 0 if the PIT never signals terminal count.
+static uint64_t lai_calibrate_tsc_pit(void) {
+    const uint32_t pit_hz = 1193182;
+    const uint32_t window_ms = 10;
+    const uint16_t latch = (uint16_t)(pit_hz * window_ms / 1000);
+
+    uint8_t gate = laihost_inb(0x61);
+    laihost_outb(0x61, (uint8_t)((gate & ~0x02) | 0x01));
+    laihost_outb(0x43, 0xB0);   // channel 2, lobyte/hibyte, mode 0
+    laihost_outb(0x42, (uint8_t)(latch & 0xFF));
+    laihost_outb(0x42, (uint8_t)(latch >> 8));
+
+    uint64_t start = lai_clock_read();
+    uint32_t polls = 0;
+    while ((laihost_inb(0x61) & 0x20) == 0) {
+        if (++polls == 0x01000000u) {
+            laihost_outb(0x61, gate);
+            return 0;
+        }
+    }
+    uint64_t elapsed = lai_clock_read() - start;
+
+    laihost_outb(0x61, gate);
+    return elapsed * (1000 / window_ms);
+}
+#endif
+
+static uint64_t lai_clock_hz(void) {
+    if (g_lai_clock_hz != 0)
+        return g_lai_clock_hz;
+
+#ifdef __aarch64__
+    uint64_t freq;
+    __asm__ volatile ("mrs %0, cntfrq_el0" : "=r"(freq));
+    g_lai_clock_hz = freq;
+#else
+    g_lai_clock_hz = lai_calibrate_tsc_pit();
+    COSMOS_LOG_INFO("[LAI] TSC calibrated against PIT: %lu Hz\n", g_lai_clock_hz);
+#endif
+
+    // Same 1 GHz guess X64CpuOps uses before calibration.
+    if (g_lai_clock_hz == 0)
+        g_lai_clock_hz = 1000000000ULL;
+    return g_lai_clock_hz;
+}
+
+// Boot clock rate for the other C objects (smp.c bring-up timeout).
+uint64_t cosmos_clock_hz(void) {
+    return lai_clock_hz();
+}
+
+// Called from managed code (LaiHostNative) with the calibrated TSC rate.
+void cosmos_lai_set_clock_frequency(uint64_t hz) {
+    if (hz != 0)
+        g_lai_clock_hz = hz;
+}
 
 void laihost_sleep(uint64_t ms) {
-    (void)ms;
-    for (volatile uint64_t i = 0; i < ms * 1000000; i++)
-        ;
+    uint64_t hz = lai_clock_hz();
+    uint64_t start = lai_clock_read();
+    uint64_t span = (ms / 1000) * hz + (ms % 1000) * hz / 1000;
+
+    if (ms >= LAI_SLEEP_YIELD_MS && ms <= 0xFFFFFFFFu && lai_irqs_enabled())
+        __cosmos_scheduler_sleep((uint32_t)ms);
+
+    // Spin out whatever the scheduler did not cover (all of it when it
+    // could not park us, or for short sleeps).
+    while (lai_clock_read() - start < span)
+        lai_cpu_relax();
 }
 
 uint64_t laihost_timer(void) {
-    return 0;
+    uint64_t hz = lai_clock_hz();
+    uint64_t ticks = lai_clock_read();
+    return (ticks / hz) * LAI_TIMER_UNITS_PER_SEC
+         + (ticks % hz) * LAI_TIMER_UNITS_PER_SEC / hz;
 }
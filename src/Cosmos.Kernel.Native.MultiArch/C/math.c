@@ -0,0 +1,344 @@
+// Freestanding libm rounding family: floor, ceil, trunc, round, sqrt (double
+// and float) plus span variants for bulk callers (MathNative.cs).
+//
+// ILC inlines Math.Floor/Ceiling/Truncate/Sqrt when the target ISA has an
+// instruction for them and otherwise calls the C symbols below, which is
+// also what the C layer and Runtime/Math.cs get.
+//
+// ARM64: frintm/frintp/frintz/frinta and fsqrt are ARMv8.0 base, always used.
+// x64: sqrtsd is SSE2 base. roundsd/roundss need SSE4.1, so the rounding
+// functions test a flag cosmos_math_init() sets from g_cpuFeatures (the same
+// way memcpy tests g_cosmos_cpu_fast_rep_movsb) and fall back to the IEEE 754
+// bit manipulation otherwise.
+
+#include <stdint.h>
+
+extern int g_cpuFeatures;
+
+// COSMOS_CPU_X64_SSE42 in Bootstrap/cpu_features.h (x86-64-v2, implies SSE4.1).
+#define MATH_X64_SSE41 (1 << 0)
+
+typedef double v2df __attribute__((vector_size(16), aligned(8), may_alias));
+
+#if defined(__x86_64__)
+static uint8_t s_math_sse41 = 0;
+#endif
+
+// Called by cosmos_cpu_features_init() once g_cpuFeatures is published.
+void cosmos_math_init(void)
+{
+#if defined(__x86_64__)
+    s_math_sse41 = (g_cpuFeatures & MATH_X64_SSE41) != 0;
+#endif
+}
+
+#if defined(__x86_64__)
+
+// =============================================================================
+// Bit-manipulation fallback (x64 without SSE4.1)
+// =============================================================================
+
+enum { MODE_FLOOR, MODE_CEIL, MODE_TRUNC };
+
+static double soft_round_double(double x, int mode)
+{
+    union {
+        double f;
+        uint64_t u;
+    } v = { x };
+
+    uint64_t sign = v.u >> 63;
+    int32_t exp = ((v.u >> 52) & 0x7FF) - 1023;
+
+    // |x| < 1.0
+    if (exp < 0) {
+        if ((v.u << 1) == 0)   // +- 0.0
+            return x;
+        if (mode == MODE_FLOOR)
+            return sign ? -1.0 : 0.0;
+        if (mode == MODE_CEIL)
+            return sign ? -0.0 : 1.0;
+        return sign ? -0.0 : 0.0;
+    }
+
+    // Already integral, or Inf/NaN (exp == 1024)
+    if (exp >= 52)
+        return x;
+
+    uint64_t mask = (1ULL << (52 - exp)) - 1;
+
+    if ((v.u & mask) == 0)
+        return x;
+
+    // Bump the magnitude by one unit when rounding away from zero; a carry
+    // into the exponent is the correct result.
+    if ((mode == MODE_FLOOR && sign) || (mode == MODE_CEIL && !sign))
+        v.u += (1ULL << (52 - exp));
+
+    v.u &= ~mask;
+
+    return v.f;
+}
+
+static float soft_round_float(float x, int mode)
+{
+    union {
+        float f;
+        uint32_t u;
+    } v = { x };
+
+    uint32_t sign = v.u >> 31;
+    int32_t exp = ((v.u >> 23) & 0xFF) - 127;
+
+    // |x| < 1.0
+    if (exp < 0) {
+        if (v.u << 1 == 0)   // +-0.0
+            return x;
+        if (mode == MODE_FLOOR)
+            return sign ? -1.0f : 0.0f;
+        if (mode == MODE_CEIL)
+            return sign ? -0.0f : 1.0f;
+        return sign ? -0.0f : 0.0f;
+    }
+
+    if (exp >= 23)
+        return x;
+
+    uint32_t mask = (1U << (23 - exp)) - 1;
+
+    if ((v.u & mask) == 0)
+        return x;
+
+    if ((mode == MODE_FLOOR && sign) || (mode == MODE_CEIL && !sign))
+        v.u += (1U << (23 - exp));
+
+    v.u &= ~mask;
+
+    return v.f;
+}
+
+// Round half away from zero: add half a unit to the magnitude, then clear
+// the fraction.
+static double soft_round_half_away(double x)
+{
+    union {
+        double f;
+        uint64_t u;
+    } v = { x };
+
+    int32_t exp = ((v.u >> 52) & 0x7FF) - 1023;
+
+    if (exp < 0) {
+        v.u &= 1ULL << 63;                 // +-0.0
+        if (exp == -1)
+            v.u |= 0x3FF0000000000000ULL;  // |x| in [0.5, 1): +-1.0
+        return v.f;
+    }
+
+    if (exp >= 52)
+        return x;
+
+    v.u += 1ULL << (51 - exp);
+    v.u &= ~((1ULL << (52 - exp)) - 1);
+
+    return v.f;
+}
+
+static float soft_round_half_away_f(float x)
+{
+    union {
+        float f;
+        uint32_t u;
+    } v = { x };
+
+    int32_t exp = ((v.u >> 23) & 0xFF) - 127;
+
+    if (exp < 0) {
+        v.u &= 1U << 31;
+        if (exp == -1)
+            v.u |= 0x3F800000U;
+        return v.f;
+    }
+
+    if (exp >= 23)
+        return x;
+
+    v.u += 1U << (22 - exp);
+    v.u &= ~((1U << (23 - exp)) - 1);
+
+    return v.f;
+}
+
+// =============================================================================
+// Scalar functions
+// =============================================================================
+
+// roundsd/roundss/roundpd immediate: rounding mode (1 floor, 2 ceil, 3 trunc)
+// | 0x8, which suppresses the precision exception.
+#define X64_ROUNDSD(x, imm) ({ double _r; __asm__("roundsd $" #imm ", %1, %0" : "=x"(_r) : "x"(x)); _r; })
+#define X64_ROUNDSS(x, imm) ({ float _r; __asm__("roundss $" #imm ", %1, %0" : "=x"(_r) : "x"(x)); _r; })
+
+double floor(double x)
+{
+    return s_math_sse41 ? X64_ROUNDSD(x, 0x9) : soft_round_double(x, MODE_FLOOR);
+}
+
+float floorf(float x)
+{
+    return s_math_sse41 ? X64_ROUNDSS(x, 0x9) : soft_round_float(x, MODE_FLOOR);
+}
+
+double ceil(double x)
+{
+    return s_math_sse41 ? X64_ROUNDSD(x, 0xA) : soft_round_double(x, MODE_CEIL);
+}
+
+float ceilf(float x)
+{
+    return s_math_sse41 ? X64_ROUNDSS(x, 0xA) : soft_round_float(x, MODE_CEIL);
+}
+
+double trunc(double x)
+{
+    return s_math_sse41 ? X64_ROUNDSD(x, 0xB) : soft_round_double(x, MODE_TRUNC);
+}
+
+float truncf(float x)
+{
+    return s_math_sse41 ? X64_ROUNDSS(x, 0xB) : soft_round_float(x, MODE_TRUNC);
+}
+
+// Adding the largest double below 0.5 before truncating rounds halves away
+// from zero without the double rounding x + 0.5 suffers (0.49999999999999994).
+double round(double x)
+{
+    if (!s_math_sse41)
+        return soft_round_half_away(x);
+
+    union {
+        double f;
+        uint64_t u;
+    } half = { 0.49999999999999994 };
+    union {
+        double f;
+        uint64_t u;
+    } v = { x };
+    half.u |= v.u & (1ULL << 63);
+    return X64_ROUNDSD(x + half.f, 0xB);
+}
+
+float roundf(float x)
+{
+    if (!s_math_sse41)
+        return soft_round_half_away_f(x);
+
+    union {
+        float f;
+        uint32_t u;
+    } half = { 0.49999997f };
+    union {
+        float f;
+        uint32_t u;
+    } v = { x };
+    half.u |= v.u & (1U << 31);
+    return X64_ROUNDSS(x + half.f, 0xB);
+}
+
+double sqrt(double x)
+{
+    double r;
+    __asm__("sqrtsd %1, %0" : "=x"(r) : "x"(x));
+    return r;
+}
+
+float sqrtf(float x)
+{
+    float r;
+    __asm__("sqrtss %1, %0" : "=x"(r) : "x"(x));
+    return r;
+}
+
+#elif defined(__aarch64__)
+
+#define A64_UNARY_D(op, x) ({ double _r; __asm__(op " %d0, %d1" : "=w"(_r) : "w"(x)); _r; })
+#define A64_UNARY_S(op, x) ({ float _r; __asm__(op " %s0, %s1" : "=w"(_r) : "w"(x)); _r; })
+
+double floor(double x) { return A64_UNARY_D("frintm", x); }
+float floorf(float x)  { return A64_UNARY_S("frintm", x); }
+double ceil(double x)  { return A64_UNARY_D("frintp", x); }
+float ceilf(float x)   { return A64_UNARY_S("frintp", x); }
+double trunc(double x) { return A64_UNARY_D("frintz", x); }
+float truncf(float x)  { return A64_UNARY_S("frintz", x); }
+double round(double x) { return A64_UNARY_D("frinta", x); }
+float roundf(float x)  { return A64_UNARY_S("frinta", x); }
+double sqrt(double x)  { return A64_UNARY_D("fsqrt", x); }
+float sqrtf(float x)   { return A64_UNARY_S("fsqrt", x); }
+
+#endif
+
+// =============================================================================
+// Span variants: dst[i] = op(src[i]) for i < count. dst may equal src.
+// Two lanes per instruction (roundpd/sqrtpd, frint*/fsqrt .2d), scalar tail.
+// =============================================================================
+
+#if defined(__x86_64__)
+
+#define X64_SPAN(name, vec_insn, scalar)                                          \
+    void name(double* dst, const double* src, uint64_t count)                    \
+    {                                                                             \
+        uint64_t i = 0;                                                           \
+        if (s_math_sse41) {                                                       \
+            for (; i + 2 <= count; i += 2) {                                      \
+                v2df r;                                                           \
+                __asm__(vec_insn " %1, %0" : "=x"(r) : "x"(*(const v2df*)&src[i])); \
+                *(v2df*)&dst[i] = r;                                              \
+            }                                                                     \
+        }                                                                         \
+        for (; i < count; i++)                                                    \
+            dst[i] = scalar(src[i]);                                              \
+    }
+
+X64_SPAN(cosmos_math_floor_span, "roundpd $0x9,", floor)
+X64_SPAN(cosmos_math_ceil_span, "roundpd $0xA,", ceil)
+X64_SPAN(cosmos_math_trunc_span, "roundpd $0xB,", trunc)
+
+void cosmos_math_round_span(double* dst, const double* src, uint64_t count)
+{
+    for (uint64_t i = 0; i < count; i++)
+        dst[i] = round(src[i]);
+}
+
+void cosmos_math_sqrt_span(double* dst, const double* src, uint64_t count)
+{
+    uint64_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        v2df r;
+        __asm__("sqrtpd %1, %0" : "=x"(r) : "x"(*(const v2df*)&src[i]));
+        *(v2df*)&dst[i] = r;
+    }
+    for (; i < count; i++)
+        dst[i] = sqrt(src[i]);
+}
+
+#elif defined(__aarch64__)
+
+#define A64_SPAN(name, insn, scalar)                                              \
+    void name(double* dst, const double* src, uint64_t count)                    \
+    {                                                                             \
+        uint64_t i = 0;                                                           \
+        for (; i + 2 <= count; i += 2) {                                          \
+            v2df r;                                                               \
+            __asm__(insn " %0.2d, %1.2d" : "=w"(r) : "w"(*(const v2df*)&src[i])); \
+            *(v2df*)&dst[i] = r;                                                  \
+        }                                                                         \
+        for (; i < count; i++)                                                    \
+            dst[i] = scalar(src[i]);                                              \
+    }
+
+A64_SPAN(cosmos_math_floor_span, "frintm", floor)
+A64_SPAN(cosmos_math_ceil_span, "frintp", ceil)
+A64_SPAN(cosmos_math_trunc_span, "frintz", trunc)
+A64_SPAN(cosmos_math_round_span, "frinta", round)
+A64_SPAN(cosmos_math_sqrt_span, "fsqrt", sqrt)
+
+#endif
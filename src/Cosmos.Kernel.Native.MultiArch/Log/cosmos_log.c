@@ -0,0 +1,265 @@
+// Native log rings (see cosmos_log.h).
+//
+// Each CPU owns a ring of fixed-size records. Producers reserve a record by
+// CAS on `head`, format into it, then publish it with a release store of
+// `ready` — so an IRQ that logs while its CPU is mid-message simply takes
+// the next record. A single drainer (trylock) copies published records out
+// in order, stopping at the first unpublished one, and hands the record back
+// by clearing `ready` before advancing `tail`.
+//
+// A producer that finds its ring full tries to drain it itself; when that is
+// not possible (another drain in progress) the message is counted and a
+// "[LOG] N message(s) dropped" note is emitted on the next drain.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include "cosmos_log.h"
+
+extern void __cosmos_serial_write(const char* message);
+
+#define COSMOS_LOG_RING_SLOTS 128   // power of two
+#define COSMOS_LOG_SLOT_TEXT  120
+
+// Bytes handed to __cosmos_serial_write per call by cosmos_log_flush().
+#define COSMOS_LOG_FLUSH_CHUNK 512
+
+typedef struct {
+    uint32_t ready;     // 1 once the producer has published the record
+    uint16_t length;
+    uint16_t reserved;
+    char text[COSMOS_LOG_SLOT_TEXT];
+} log_record_t;
+
+typedef struct {
+    uint32_t head __attribute__((aligned(64)));   // next record to reserve
+    uint32_t tail __attribute__((aligned(64)));   // next record to drain
+    log_record_t records[COSMOS_LOG_RING_SLOTS];
+} log_ring_t;
+
+static log_ring_t g_log_rings[COSMOS_LOG_MAX_CPUS];
+static uint32_t g_log_dropped = 0;
+static uint32_t g_log_drain_lock = 0;
+
+// Executing CPU's slot (Bootstrap/smp.c): the index smp.c assigned to its
+// LAPIC ID / MPIDR at bring-up, kept in GS base / TPIDR_EL1. Same index as
+// SchedulerManager.GetCurrentCpuId().
+extern uint32_t cosmos_smp_current_cpu(void);
+
+static inline uint32_t log_cpu_index(void)
+{
+    uint32_t cpu = cosmos_smp_current_cpu();
+    return cpu < COSMOS_LOG_MAX_CPUS ? cpu : COSMOS_LOG_MAX_CPUS - 1;
+}
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+typedef struct {
+    char* buf;
+    size_t capacity;
+    size_t length;
+    int truncated;
+} log_out_t;
+
+static void log_put_char(log_out_t* out, char c)
+{
+    if (out->length < out->capacity)
+        out->buf[out->length++] = c;
+    else
+        out->truncated = 1;
+}
+
+static void log_put_str(log_out_t* out, const char* s)
+{
+    if (!s)
+        s = "(null)";
+    while (*s)
+        log_put_char(out, *s++);
+}
+
+static void log_put_unsigned(log_out_t* out, uint64_t value, uint32_t base)
+{
+    char digits[20];
+    int count = 0;
+    do {
+        uint32_t d = (uint32_t)(value % base);
+        digits[count++] = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+        value /= base;
+    } while (value != 0);
+
+    while (count > 0)
+        log_put_char(out, digits[--count]);
+}
+
+static size_t log_format(char* buf, size_t capacity, const char* fmt, va_list ap)
+{
+    log_out_t out = { buf, capacity, 0, 0 };
+
+    for (const char* p = fmt; *p; p++) {
+        if (*p != '%') {
+            log_put_char(&out, *p);
+            continue;
+        }
+
+        int longs = 0;
+        while (p[1] == 'l') {
+            longs++;
+            p++;
+        }
+
+        switch (*++p) {
+            case 's':
+                log_put_str(&out, va_arg(ap, const char*));
+                break;
+            case 'c':
+                log_put_char(&out, (char)va_arg(ap, int));
+                break;
+            case 'd': {
+                int64_t v = longs == 0 ? va_arg(ap, int)
+                          : longs == 1 ? va_arg(ap, long)
+                          : va_arg(ap, long long);
+                if (v < 0) {
+                    log_put_char(&out, '-');
+                    log_put_unsigned(&out, (uint64_t)0 - (uint64_t)v, 10);
+                } else {
+                    log_put_unsigned(&out, (uint64_t)v, 10);
+                }
+                break;
+            }
+            case 'u':
+            case 'x': {
+                uint64_t v = longs == 0 ? va_arg(ap, unsigned int)
+                           : longs == 1 ? va_arg(ap, unsigned long)
+                           : va_arg(ap, unsigned long long);
+                log_put_unsigned(&out, v, *p == 'x' ? 16 : 10);
+                break;
+            }
+            case 'p':
+                log_put_str(&out, "0x");
+                log_put_unsigned(&out, (uint64_t)(uintptr_t)va_arg(ap, void*), 16);
+                break;
+            case '%':
+                log_put_char(&out, '%');
+                break;
+            case '\0':
+                p--;    // trailing '%': stop at the terminator
+                break;
+            default:
+                log_put_char(&out, '%');
+                log_put_char(&out, *p);
+                break;
+        }
+    }
+
+    // Keep a cut-off line a line so the next record starts on its own.
+    if (out.truncated && out.length > 0)
+        buf[out.length - 1] = '\n';
+
+    return out.length;
+}
+
+// ============================================================================
+// Rings
+// ============================================================================
+
+static log_record_t* log_reserve(log_ring_t* ring)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    for (;;) {
+        uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        if (head - tail >= COSMOS_LOG_RING_SLOTS)
+            return 0;
+        if (__atomic_compare_exchange_n(&ring->head, &head, head + 1, 1,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            return &ring->records[head & (COSMOS_LOG_RING_SLOTS - 1)];
+    }
+}
+
+void cosmos_log_write(int level, const char* fmt, ...)
+{
+    log_ring_t* ring = &g_log_rings[log_cpu_index()];
+
+    log_record_t* record = log_reserve(ring);
+    if (!record) {
+        cosmos_log_flush();
+        record = log_reserve(ring);
+    }
+    if (!record) {
+        __atomic_fetch_add(&g_log_dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    va_list ap;
+    va_start(ap, fmt);
+    record->length = (uint16_t)log_format(record->text, COSMOS_LOG_SLOT_TEXT, fmt, ap);
+    va_end(ap);
+    __atomic_store_n(&record->ready, 1, __ATOMIC_RELEASE);
+
+    if (level <= COSMOS_LOG_LEVEL_ERROR)
+        cosmos_log_flush();
+}
+
+// Copy up to `max_records` queued messages (0 = no limit) into `dst`,
+// oldest first, without splitting a message. Returns the number of bytes
+// written (not NUL-terminated); 0 when the rings are empty or busy.
+// Called from managed code (LogNative.Drain), so it must not call back out.
+size_t cosmos_log_drain(uint8_t* dst, size_t capacity, uint32_t max_records)
+{
+    if (!dst || __atomic_exchange_n(&g_log_drain_lock, 1, __ATOMIC_ACQUIRE) != 0)
+        return 0;
+
+    size_t used = 0;
+    uint32_t drained = 0;
+
+    uint32_t dropped = __atomic_load_n(&g_log_dropped, __ATOMIC_RELAXED);
+    if (dropped != 0 && capacity >= 48) {
+        __atomic_fetch_sub(&g_log_dropped, dropped, __ATOMIC_RELAXED);
+        log_out_t out = { (char*)dst, capacity, 0, 0 };
+        log_put_str(&out, "[LOG] ");
+        log_put_unsigned(&out, dropped, 10);
+        log_put_str(&out, " message(s) dropped\n");
+        used = out.length;
+    }
+
+    for (uint32_t cpu = 0; cpu < COSMOS_LOG_MAX_CPUS; cpu++) {
+        log_ring_t* ring = &g_log_rings[cpu];
+        uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+        while (max_records == 0 || drained < max_records) {
+            if (tail == __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE))
+                break;
+
+            log_record_t* record = &ring->records[tail & (COSMOS_LOG_RING_SLOTS - 1)];
+            if (!__atomic_load_n(&record->ready, __ATOMIC_ACQUIRE))
+                break;  // reserved but not yet published
+
+            if (used + record->length > capacity)
+                goto out;
+
+            for (uint32_t i = 0; i < record->length; i++)
+                dst[used + i] = (uint8_t)record->text[i];
+            used += record->length;
+            drained++;
+
+            __atomic_store_n(&record->ready, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&ring->tail, ++tail, __ATOMIC_RELEASE);
+        }
+    }
+
+out:
+    __atomic_store_n(&g_log_drain_lock, 0, __ATOMIC_RELEASE);
+    return used;
+}
+
+void cosmos_log_flush(void)
+{
+    char chunk[COSMOS_LOG_FLUSH_CHUNK];
+    for (;;) {
+        size_t length = cosmos_log_drain((uint8_t*)chunk, sizeof(chunk) - 1, 0);
+        if (length == 0)
+            return;
+        chunk[length] = '\0';
+        __cosmos_serial_write(chunk);
+    }
+}
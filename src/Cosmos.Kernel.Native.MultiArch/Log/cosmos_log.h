@@ -0,0 +1,53 @@
+#ifndef COSMOS_LOG_H
+#define COSMOS_LOG_H
+
+#include <stdint.h>
+
+// Native log: leveled, printf-style messages from the C layer (kmain, ACPI,
+// LAI) are formatted into a lock-free per-CPU ring instead of being written
+// to the UART byte by byte while the caller waits. The rings are drained by
+// cosmos_log_flush() (kmain phase boundaries, panic) and from managed code
+// through cosmos_log_drain() (NativeLog.cs) on the timer IRQ and before the
+// CPU idles.
+//
+// Messages above COSMOS_LOG_LEVEL compile away entirely. The build passes
+// -DCOSMOS_LOG_LEVEL from $(CosmosNativeLogLevel) (Cosmos.Build.CC.targets):
+// WARN for Release kernels, DEBUG otherwise.
+//
+// Supported conversions: %s %c %d %u %x %lu %lx %llu %llx %p %%.
+// Hex is printed without a prefix; write "0x%x" where one is wanted.
+// uint64_t is unsigned long on both targets, so it takes %lx / %lu.
+
+#define COSMOS_LOG_LEVEL_NONE  0
+#define COSMOS_LOG_LEVEL_ERROR 1
+#define COSMOS_LOG_LEVEL_WARN  2
+#define COSMOS_LOG_LEVEL_INFO  3
+#define COSMOS_LOG_LEVEL_DEBUG 4
+
+#ifndef COSMOS_LOG_LEVEL
+#define COSMOS_LOG_LEVEL COSMOS_LOG_LEVEL_DEBUG
+#endif
+
+// Rings, one per CPU. CPUs past the last ring share it; smp.c brings up every
+// CPU regardless.
+#define COSMOS_LOG_MAX_CPUS 32
+
+// Queue a formatted message at `level`. Errors are flushed synchronously so
+// they are on the wire before whatever failure follows them.
+extern void cosmos_log_write(int level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Drain every ring to serial. No-op when another CPU is already draining.
+extern void cosmos_log_flush(void);
+
+#define COSMOS_LOG_AT(level, ...)                   \
+    do {                                            \
+        if ((level) <= COSMOS_LOG_LEVEL)            \
+            cosmos_log_write((level), __VA_ARGS__); \
+    } while (0)
+
+#define COSMOS_LOG_ERROR(...) COSMOS_LOG_AT(COSMOS_LOG_LEVEL_ERROR, __VA_ARGS__)
+#define COSMOS_LOG_WARN(...)  COSMOS_LOG_AT(COSMOS_LOG_LEVEL_WARN, __VA_ARGS__)
+#define COSMOS_LOG_INFO(...)  COSMOS_LOG_AT(COSMOS_LOG_LEVEL_INFO, __VA_ARGS__)
+#define COSMOS_LOG_DEBUG(...) COSMOS_LOG_AT(COSMOS_LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+#endif // COSMOS_LOG_H
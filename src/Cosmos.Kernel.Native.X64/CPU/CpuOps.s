@@ -8,6 +8,7 @@
 .global _native_cpu_restore_irq
 .global _native_cpu_read_cr3
 .global _native_cpu_invlpg
+.global _native_cpu_wrmsr
 .global RhCpuIdEx
 
 .text
@@ -59,6 +60,16 @@ _native_cpu_invlpg:
     invlpg  [rdi]
     ret
 
+// Write a model-specific register.
+// void _native_cpu_wrmsr(uint32_t msr /*EDI*/, uint64_t value /*RSI*/)
+_native_cpu_wrmsr:
+    mov     ecx, edi
+    mov     eax, esi        // low 32 bits
+    mov     rdx, rsi
+    shr     rdx, 32         // high 32 bits
+    wrmsr
+    ret
+
 // NativeAOT runtime helper backing System.Runtime.Intrinsics.X86.X86Base.CpuId.
 // void RhCpuIdEx(int* cpuInfo /*RDI*/, int functionId /*ESI*/, int subFunctionId /*EDX*/)
 // Mirrors dotnet/runtime nativeaot amd64 MiscStubs; RBX is callee-saved and
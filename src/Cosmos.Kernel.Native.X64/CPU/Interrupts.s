@@ -318,6 +318,34 @@ _native_x64_get_last_error_code:
     mov rax, [rip + _irq_last_error_code]
     ret
 
+// Save the enabled extended-state components (g_cosmos_xstate_mask) to the
+// 64-byte aligned area at the caller's RSP (called by IRQ_STUB with RSP
+// pointing at the area). Clobbers RAX, RDX.
+_native_xstate_save:
+    cmp byte ptr [rip + g_cosmos_xstate_mode], 2    // COSMOS_XSTATE_XSAVEC
+    je 2f
+    // Standard format: XSAVE leaves header bits outside the mask
+    // and the reserved header bytes untouched, and XRSTOR faults on stale
+    // ones, so start from a clean header.
+    xor eax, eax
+    mov [rsp + 8 + 512], rax
+    mov [rsp + 8 + 520], rax
+    mov [rsp + 8 + 528], rax
+    mov [rsp + 8 + 536], rax
+    mov [rsp + 8 + 544], rax
+    mov [rsp + 8 + 552], rax
+    mov [rsp + 8 + 560], rax
+    mov [rsp + 8 + 568], rax
+    mov eax, dword ptr [rip + g_cosmos_xstate_mask]
+    mov edx, dword ptr [rip + g_cosmos_xstate_mask + 4]
+    xsave64 [rsp + 8]
+    ret
+2:
+    mov eax, dword ptr [rip + g_cosmos_xstate_mask]
+    mov edx, dword ptr [rip + g_cosmos_xstate_mask + 4]
+    xsavec64 [rsp + 8]
+    ret
+
 // void _native_set_context_switch_new_thread(int isNew)
 // Sets whether the target thread is NEW (1) or RESUMED (0)
 // rdi = isNew flag
@@ -745,9 +773,21 @@ irq\n\()_stub:
     movdqu [rsp + 224], xmm14
     movdqu [rsp + 240], xmm15
 
+    // === SAVE EXTENDED STATE ===
+    // RBX (already saved, callee-saved across the handler) keeps the XMM
+    // area; the XSAVE area goes right below it (layout in cpu_features.h).
+    mov rbx, rsp
+    cmp byte ptr [rip + g_cosmos_xstate_mode], 0
+    je .Lxsaved\n
+    sub rsp, [rip + g_cosmos_xstate_size]
+    and rsp, -64
+    call _native_xstate_save
+.Lxsaved\n:
+
     // === CALL HANDLER ===
-    lea rdi, [rsp + 256]
+    lea rdi, [rbx + 256]
     call __managed__irq
+    mov rsp, rbx
 
     // === CHECK FOR CONTEXT SWITCH ===
     mov rax, [rip + _context_switch_target_rsp]
@@ -781,6 +821,23 @@ irq\n\()_stub:
     mov rax, [rsp + 256 + 120 + 24]  // Read TempRcx (is_new_thread flag)
     mov [rip + _temp_is_new_thread], rax  // Save it in a global variable
 
+    // Restore extended state from below the XMM area, or the init image for
+    // a NEW thread (its context sits at the bottom of its stack, nothing of
+    // its own lies below). Inline: a call would push into the area.
+    cmp byte ptr [rip + g_cosmos_xstate_mode], 0
+    je .Lxrestored\n
+    lea rcx, [rip + g_cosmos_xstate_init_area]
+    test rax, rax
+    jnz .Lxrstor\n
+    mov rcx, rsp
+    sub rcx, [rip + g_cosmos_xstate_size]
+    and rcx, -64
+.Lxrstor\n:
+    mov eax, dword ptr [rip + g_cosmos_xstate_mask]
+    mov edx, dword ptr [rip + g_cosmos_xstate_mask + 4]
+    xrstor64 [rcx]
+.Lxrestored\n:
+
     // Restore XMM
     movdqu xmm0, [rsp + 0]
     movdqu xmm1, [rsp + 16]
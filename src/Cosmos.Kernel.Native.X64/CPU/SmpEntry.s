@@ -0,0 +1,44 @@
+.intel_syntax noprefix
+
+.global _native_ap_entry
+.global _native_ap_load_gdt
+
+.extern _native_enable_simd
+.extern cosmos_smp_ap_main
+
+.text
+
+// Application processor entry, written to limine_mp_info.goto_address by
+// cosmos_smp_init() (Bootstrap/smp.c). Limine jumps here in long mode with
+// rdi = limine_mp_info*; extra_argument (offset 24) holds the CPU's
+// cosmos_smp_cpu_t, whose first field is the top of its kernel stack.
+_native_ap_entry:
+    cli
+    mov rbx, [rdi + 24]
+    mov rsp, [rbx]              // Leave Limine's stack: it is bootloader-reclaimable
+    xor ebp, ebp
+
+    // SSE before any C code, as kmain() does on the BSP
+    call _native_enable_simd
+
+    mov rdi, rbx
+    call cosmos_smp_ap_main     // noreturn
+1:
+    hlt
+    jmp 1b
+
+// void _native_ap_load_gdt(const struct { u16 limit; u64 base; } __packed* gdtr)
+// Loads a GDT with Limine's layout and reloads the segment registers:
+// CS = 0x28 (64-bit code), DS/ES/SS = 0x30 (64-bit data).
+_native_ap_load_gdt:
+    lgdt [rdi]
+    mov ax, 0x30
+    mov ds, ax
+    mov es, ax
+    mov ss, ax
+
+    // Far return to reload CS: [rsp] = return RIP, [rsp+8] = CS
+    pop rax
+    push 0x28
+    push rax
+    retfq
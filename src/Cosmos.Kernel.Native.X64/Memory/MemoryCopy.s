@@ -1,5 +1,10 @@
 // SIMD-optimized memory copy operations for x64
 // Uses SSE (XMM registers) for 128-bit transfers
+//
+// Also provides the freestanding libc memory primitives (memcpy, memmove,
+// memset, memcmp, strlen) used by the C objects, ILC-generated block
+// copies/inits and MemoryOp. Only SSE2 is assumed: AVX state is enabled
+// only on CPUs with XSAVE (cosmos_cpu_features_init), so no VEX encodings.
 
 .intel_syntax noprefix
 
@@ -10,6 +15,20 @@
 .global _simd_copy_128_blocks
 .global _simd_copy_nt_128_blocks
 .global _simd_fill_16_blocks
+.global memcpy
+.global memmove
+.global memset
+.global memcmp
+.global strlen
+
+// Copies/fills at least this large use non-temporal stores: beyond roughly
+// an L2 worth of data, write-allocating the destination only evicts the
+// working set.
+.set NT_THRESHOLD, 0x40000
+
+// With ERMS, `rep movsb` beats the 64-byte loop from about this size up
+// (microcode switches to cache-line moves); below it the startup cost wins.
+.set REP_MOVSB_THRESHOLD, 0x800
 
 .text
 
@@ -179,3 +198,356 @@ _simd_fill_16_blocks:
 
 .Lfill_done:
     ret
+
+// ============================================================================
+// libc memory primitives (System V: rdi, rsi, rdx; result in rax)
+// Size classes: <=64 bytes is handled branch-light with overlapping
+// head/tail moves, larger sizes loop 64 bytes per iteration, and copies/fills
+// of NT_THRESHOLD or more go through movntdq.
+// ============================================================================
+
+// void* memcpy(void* dest, const void* src, size_t n)
+memcpy:
+    mov     rax, rdi
+    cmp     rdx, 64
+    jbe     .Lmove_le64
+    cmp     rdx, NT_THRESHOLD
+    jae     .Lmemcpy_nt
+    cmp     rdx, REP_MOVSB_THRESHOLD
+    jb      .Lmove_fwd
+    cmp     byte ptr [rip + g_cosmos_cpu_fast_rep_movsb], 0
+    je      .Lmove_fwd
+    mov     rcx, rdx
+    rep movsb
+    ret
+
+.Lmemcpy_nt:
+    // Large copy: preload the last 64 bytes, then stream 16-byte aligned
+    // destination blocks with non-temporal stores.
+    movdqu  xmm4, [rsi + rdx - 64]
+    movdqu  xmm5, [rsi + rdx - 48]
+    movdqu  xmm6, [rsi + rdx - 32]
+    movdqu  xmm7, [rsi + rdx - 16]
+    lea     r8, [rdi + rdx - 64]
+
+    movdqu  xmm0, [rsi]
+    movdqu  [rdi], xmm0
+    mov     rcx, rdi
+    neg     rcx
+    and     rcx, 15
+    add     rdi, rcx
+    add     rsi, rcx
+    sub     rdx, rcx
+
+.Lmemcpy_nt_loop:
+    movdqu  xmm0, [rsi]
+    movdqu  xmm1, [rsi + 16]
+    movdqu  xmm2, [rsi + 32]
+    movdqu  xmm3, [rsi + 48]
+    movntdq [rdi], xmm0
+    movntdq [rdi + 16], xmm1
+    movntdq [rdi + 32], xmm2
+    movntdq [rdi + 48], xmm3
+    add     rsi, 64
+    add     rdi, 64
+    sub     rdx, 64
+    cmp     rdx, 64
+    ja      .Lmemcpy_nt_loop
+    sfence
+    jmp     .Lmove_store_tail
+
+// void* memmove(void* dest, const void* src, size_t n)
+memmove:
+    mov     rax, rdi
+    cmp     rdx, 64
+    jbe     .Lmove_le64
+    mov     rcx, rdi
+    sub     rcx, rsi
+    cmp     rcx, rdx
+    jae     .Lmove_fwd          // dest < src or no overlap: forward is safe
+    test    rcx, rcx
+    jz      .Lmove_done         // dest == src
+
+    // Overlapping with dest above src: copy 64-byte blocks from the end.
+    // The first 64 bytes are loaded up front and stored last.
+    movdqu  xmm4, [rsi]
+    movdqu  xmm5, [rsi + 16]
+    movdqu  xmm6, [rsi + 32]
+    movdqu  xmm7, [rsi + 48]
+    mov     r8, rdi
+    add     rsi, rdx
+    add     rdi, rdx
+
+.Lmove_bwd_loop:
+    movdqu  xmm0, [rsi - 16]
+    movdqu  xmm1, [rsi - 32]
+    movdqu  xmm2, [rsi - 48]
+    movdqu  xmm3, [rsi - 64]
+    movdqu  [rdi - 16], xmm0
+    movdqu  [rdi - 32], xmm1
+    movdqu  [rdi - 48], xmm2
+    movdqu  [rdi - 64], xmm3
+    sub     rsi, 64
+    sub     rdi, 64
+    sub     rdx, 64
+    cmp     rdx, 64
+    ja      .Lmove_bwd_loop
+
+    movdqu  [r8], xmm4
+    movdqu  [r8 + 16], xmm5
+    movdqu  [r8 + 32], xmm6
+    movdqu  [r8 + 48], xmm7
+    ret
+
+// Forward copy of n > 64 bytes. Every block is loaded before it is stored
+// and the tail is preloaded, so dest < src overlap is fine too.
+.Lmove_fwd:
+    movdqu  xmm4, [rsi + rdx - 64]
+    movdqu  xmm5, [rsi + rdx - 48]
+    movdqu  xmm6, [rsi + rdx - 32]
+    movdqu  xmm7, [rsi + rdx - 16]
+    lea     r8, [rdi + rdx - 64]
+
+.Lmove_fwd_loop:
+    movdqu  xmm0, [rsi]
+    movdqu  xmm1, [rsi + 16]
+    movdqu  xmm2, [rsi + 32]
+    movdqu  xmm3, [rsi + 48]
+    movdqu  [rdi], xmm0
+    movdqu  [rdi + 16], xmm1
+    movdqu  [rdi + 32], xmm2
+    movdqu  [rdi + 48], xmm3
+    add     rsi, 64
+    add     rdi, 64
+    sub     rdx, 64
+    cmp     rdx, 64
+    ja      .Lmove_fwd_loop
+
+.Lmove_store_tail:
+    movdqu  [r8], xmm4
+    movdqu  [r8 + 16], xmm5
+    movdqu  [r8 + 32], xmm6
+    movdqu  [r8 + 48], xmm7
+    ret
+
+// n <= 64: all loads happen before any store, so this is overlap-safe.
+.Lmove_le64:
+    cmp     rdx, 16
+    jbe     .Lmove_le16
+    cmp     rdx, 32
+    ja      .Lmove_33_64
+    movdqu  xmm0, [rsi]
+    movdqu  xmm1, [rsi + rdx - 16]
+    movdqu  [rdi], xmm0
+    movdqu  [rdi + rdx - 16], xmm1
+    ret
+
+.Lmove_33_64:
+    movdqu  xmm0, [rsi]
+    movdqu  xmm1, [rsi + 16]
+    movdqu  xmm2, [rsi + rdx - 32]
+    movdqu  xmm3, [rsi + rdx - 16]
+    movdqu  [rdi], xmm0
+    movdqu  [rdi + 16], xmm1
+    movdqu  [rdi + rdx - 32], xmm2
+    movdqu  [rdi + rdx - 16], xmm3
+    ret
+
+.Lmove_le16:
+    cmp     rdx, 8
+    jb      .Lmove_lt8
+    mov     rcx, [rsi]
+    mov     r8, [rsi + rdx - 8]
+    mov     [rdi], rcx
+    mov     [rdi + rdx - 8], r8
+    ret
+
+.Lmove_lt8:
+    cmp     rdx, 4
+    jb      .Lmove_lt4
+    mov     ecx, [rsi]
+    mov     r8d, [rsi + rdx - 4]
+    mov     [rdi], ecx
+    mov     [rdi + rdx - 4], r8d
+    ret
+
+.Lmove_lt4:
+    test    rdx, rdx
+    jz      .Lmove_done
+    // 1..3 bytes: first, middle and last byte cover every length.
+    mov     r9, rdx
+    shr     r9, 1
+    movzx   ecx, byte ptr [rsi]
+    movzx   r8d, byte ptr [rsi + r9]
+    movzx   r10d, byte ptr [rsi + rdx - 1]
+    mov     [rdi], cl
+    mov     [rdi + r9], r8b
+    mov     [rdi + rdx - 1], r10b
+
+.Lmove_done:
+    ret
+
+// void* memset(void* dest, int value, size_t n)
+memset:
+    mov     rax, rdi
+    movzx   ecx, sil
+    mov     r8, 0x0101010101010101
+    imul    rcx, r8
+    cmp     rdx, 16
+    ja      .Lset_gt16
+    cmp     rdx, 8
+    jb      .Lset_lt8
+    mov     [rdi], rcx
+    mov     [rdi + rdx - 8], rcx
+    ret
+
+.Lset_lt8:
+    cmp     rdx, 4
+    jb      .Lset_lt4
+    mov     [rdi], ecx
+    mov     [rdi + rdx - 4], ecx
+    ret
+
+.Lset_lt4:
+    test    rdx, rdx
+    jz      .Lset_done
+    mov     [rdi], cl
+    mov     [rdi + rdx - 1], cl
+    cmp     rdx, 3
+    jb      .Lset_done
+    mov     [rdi + 1], cl
+.Lset_done:
+    ret
+
+.Lset_gt16:
+    movq    xmm0, rcx
+    punpcklqdq xmm0, xmm0
+    cmp     rdx, 32
+    ja      .Lset_gt32
+    movdqu  [rdi], xmm0
+    movdqu  [rdi + rdx - 16], xmm0
+    ret
+
+.Lset_gt32:
+    cmp     rdx, 64
+    ja      .Lset_gt64
+    movdqu  [rdi], xmm0
+    movdqu  [rdi + 16], xmm0
+    movdqu  [rdi + rdx - 32], xmm0
+    movdqu  [rdi + rdx - 16], xmm0
+    ret
+
+.Lset_gt64:
+    // Unaligned head and tail, aligned 64-byte blocks in between.
+    lea     r8, [rdi + rdx - 64]
+    movdqu  [rdi], xmm0
+    mov     rcx, rdi
+    neg     rcx
+    and     rcx, 15
+    add     rdi, rcx
+    sub     rdx, rcx
+    cmp     rdx, NT_THRESHOLD
+    jae     .Lset_nt_loop
+    cmp     rdx, 64
+    jbe     .Lset_tail
+
+.Lset_loop:
+    movdqa  [rdi], xmm0
+    movdqa  [rdi + 16], xmm0
+    movdqa  [rdi + 32], xmm0
+    movdqa  [rdi + 48], xmm0
+    add     rdi, 64
+    sub     rdx, 64
+    cmp     rdx, 64
+    ja      .Lset_loop
+    jmp     .Lset_tail
+
+.Lset_nt_loop:
+    movntdq [rdi], xmm0
+    movntdq [rdi + 16], xmm0
+    movntdq [rdi + 32], xmm0
+    movntdq [rdi + 48], xmm0
+    add     rdi, 64
+    sub     rdx, 64
+    cmp     rdx, 64
+    ja      .Lset_nt_loop
+    sfence
+
+.Lset_tail:
+    movdqu  [r8], xmm0
+    movdqu  [r8 + 16], xmm0
+    movdqu  [r8 + 32], xmm0
+    movdqu  [r8 + 48], xmm0
+    ret
+
+// int memcmp(const void* s1, const void* s2, size_t n)
+// Returns the difference of the first mismatching bytes (as unsigned char).
+memcmp:
+    xor     ecx, ecx
+    cmp     rdx, 16
+    jb      .Lcmp_tail
+
+.Lcmp_loop:
+    movdqu  xmm0, [rdi + rcx]
+    movdqu  xmm1, [rsi + rcx]
+    pcmpeqb xmm0, xmm1
+    pmovmskb r8d, xmm0
+    xor     r8d, 0xFFFF
+    jnz     .Lcmp_found
+    add     rcx, 16
+    lea     r9, [rcx + 16]
+    cmp     r9, rdx
+    jbe     .Lcmp_loop
+
+.Lcmp_tail:
+    cmp     rcx, rdx
+    jae     .Lcmp_equal
+    movzx   eax, byte ptr [rdi + rcx]
+    movzx   r8d, byte ptr [rsi + rcx]
+    inc     rcx
+    sub     eax, r8d
+    jz      .Lcmp_tail
+    ret
+
+.Lcmp_found:
+    bsf     r8d, r8d
+    add     rcx, r8
+    movzx   eax, byte ptr [rdi + rcx]
+    movzx   r8d, byte ptr [rsi + rcx]
+    sub     eax, r8d
+    ret
+
+.Lcmp_equal:
+    xor     eax, eax
+    ret
+
+// size_t strlen(const char* s)
+// Scans aligned 16-byte blocks, which never cross into an unmapped page.
+strlen:
+    mov     rax, rdi
+    and     rax, -16
+    pxor    xmm0, xmm0
+    movdqa  xmm1, [rax]
+    pcmpeqb xmm1, xmm0
+    pmovmskb edx, xmm1
+    mov     ecx, edi
+    and     ecx, 15
+    shr     edx, cl             // drop matches before the string start
+    test    edx, edx
+    jnz     .Lstrlen_first
+
+.Lstrlen_loop:
+    add     rax, 16
+    movdqa  xmm1, [rax]
+    pcmpeqb xmm1, xmm0
+    pmovmskb edx, xmm1
+    test    edx, edx
+    jz      .Lstrlen_loop
+    bsf     edx, edx
+    add     rax, rdx
+    sub     rax, rdi
+    ret
+
+.Lstrlen_first:
+    bsf     eax, edx
+    ret
@@ -1,7 +1,6 @@
 using System.Text.Unicode;
 using Cosmos.Build.API.Attributes;
 using Cosmos.Kernel.Core.Bridge;
-using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Utilities;
 
 namespace Cosmos.Kernel.Plugs.System;
@@ -10,6 +9,8 @@ namespace Cosmos.Kernel.Plugs.System;
 public static class AppContextPlug
 {
     // Native import lives in Cosmos.Kernel.Core/Bridge/Import/KnobsNative.cs.
+    // Runtime knobs stay in the native hashed table and are decoded on first
+    // use; dataStore caches those and holds whatever SetData stores.
     private static SimpleDictionary<string, object?>? dataStore;
     private static SimpleDictionary<string, bool>? switches;
 
@@ -21,37 +22,10 @@ public static class AppContextPlug
             return;
         }
 
-        unsafe
-        {
-            uint count = KnobsNative.GetKnobValues(out byte** knobKeys, out byte** knobValues);
-
-            dataStore = new(capacity: (int)count);
-            switches = new();
-
-            for (int i = 0; i < count; i++)
-            {
-                byte* ptrKey = knobKeys[i];
-                byte* ptrVal = knobValues[i];
-
-                string key = Utf8Decode(new(ptrKey, Strlen(ptrKey)));
-                string value = Utf8Decode(new(ptrVal, Strlen(ptrVal)));
-
-                Serial.WriteString(key);
-                Serial.WriteString(" = ");
-                Serial.WriteString(value + "\n");
-
-                dataStore[key] = value;
-
-                if (bool.TryParse(value, out bool result))
-                {
-                    switches.Add(key, result);
-                }
-            }
-        }
+        dataStore = new();
+        switches = new();
     }
 
-
-
     [PlugMember]
     public static bool TryGetSwitch(string switchName, out bool isEnabled)
     {
@@ -59,17 +33,20 @@ public static class AppContextPlug
 
         ArgumentException.ThrowIfNullOrEmpty(switchName);
 
-        if (switches != null)
+        if (switches!.TryGetValue(switchName, out isEnabled))
         {
-            if (switches.TryGetValue(switchName, out isEnabled))
-            {
-                return true;
-            }
+            return true;
         }
 
         object? data = GetData(switchName);
 
-        if (GetData(switchName) is string value && bool.TryParse(value, out isEnabled))
+        if (data is bool flag)
+        {
+            isEnabled = flag;
+            return true;
+        }
+
+        if (data is string value && bool.TryParse(value, out isEnabled))
         {
             return true;
         }
@@ -83,16 +60,28 @@ public static class AppContextPlug
     {
         EnsureInitialized();
 
-        dataStore!.TryGetValue(name, out object? data);
+        if (dataStore!.TryGetValue(name, out object? data))
+        {
+            return data;
+        }
+
+        string? knob = GetKnob(name);
+
+        if (knob is not null)
+        {
+            dataStore.Add(name, knob);
+        }
 
-        return data;
+        return knob;
     }
+
     [PlugMember]
     public static void SetData(string switchName, object? data)
     {
         EnsureInitialized();
 
-        dataStore![switchName] = data;
+        dataStore!.Remove(switchName);
+        dataStore.Add(switchName, data);
     }
 
     [PlugMember]
@@ -100,9 +89,34 @@ public static class AppContextPlug
     {
         EnsureInitialized();
 
-        dataStore![switchName] = isEnabled;
+        switches!.Remove(switchName);
+        switches.Add(switchName, isEnabled);
     }
 
+    private static unsafe string? GetKnob(string name)
+    {
+        int maxBytes = name.Length * 3 + 1;
+        Span<byte> key = stackalloc byte[maxBytes];
+
+        if (Utf8.FromUtf16(name, key, out _, out int bytesWritten) != global::System.Buffers.OperationStatus.Done)
+        {
+            return null;
+        }
+
+        key[bytesWritten] = 0;
+
+        fixed (byte* ptrKey = key)
+        {
+            byte* ptrVal = KnobsNative.GetKnobValue(ptrKey);
+
+            if (ptrVal == null)
+            {
+                return null;
+            }
+
+            return Utf8Decode(new(ptrVal, Strlen(ptrVal)));
+        }
+    }
 
     internal unsafe static int Strlen(byte* str, int max = int.MaxValue)
     {
@@ -1,7 +1,6 @@
 using System.Diagnostics;
 using Cosmos.Build.API.Attributes;
 #if ARCH_X64
-using Cosmos.Kernel.Core.X64.Bridge;
 using Cosmos.Kernel.Core.X64.Cpu;
 #elif ARCH_ARM64
 using Cosmos.Kernel.Core.ARM64.Bridge;
@@ -11,7 +10,8 @@ namespace Cosmos.Kernel.Plugs.System.Diagnostics;
 
 /// <summary>
 /// Plug for System.Diagnostics.Stopwatch to provide timestamp functionality.
-/// Uses TSC (Time Stamp Counter) on x64 and the ARM64 generic timer on ARM64.
+/// Uses the x64 ClockSource timestamp clock (the TSC, or the HPET when the TSC
+/// is not invariant) and the ARM64 generic timer on ARM64.
 /// Native imports live in Cosmos.Kernel.Core.X64/Bridge/Import/X64CpuNative.cs and
 /// Cosmos.Kernel.Core.ARM64/Bridge/Import/GenericTimerNative.cs.
 /// </summary>
@@ -20,35 +20,35 @@ public static class StopwatchPlug
 {
 #if ARCH_X64
     /// <summary>
-    /// Gets the current timestamp using TSC.
+    /// Gets the current timestamp from the ClockSource timestamp clock.
     /// </summary>
     [PlugMember]
     public static long GetTimestamp()
     {
-        return (long)X64CpuNative.ReadTsc();
+        return (long)ClockSource.ReadTimestamp();
     }
 
     /// <summary>
-    /// Gets the TSC frequency in ticks per second.
+    /// Gets the timestamp clock frequency in ticks per second.
     /// Called during Stopwatch class static initialization.
     /// </summary>
     [PlugMember]
     public static long GetFrequency()
     {
-        return X64CpuOps.TscFrequency;
+        return ClockSource.TimestampFrequency;
     }
 
     /// <summary>
-    /// Gets the TSC frequency in ticks per second (field access plug).
+    /// Gets the timestamp clock frequency in ticks per second (field access plug).
     /// </summary>
     [PlugMember("get_Frequency")]
     public static long get_Frequency()
     {
-        return X64CpuOps.TscFrequency;
+        return ClockSource.TimestampFrequency;
     }
 
     /// <summary>
-    /// Gets whether the timer is high resolution (TSC is high resolution).
+    /// Gets whether the timer is high resolution (TSC and HPET both are).
     /// </summary>
     [PlugMember("get_IsHighResolution")]
     public static bool get_IsHighResolution()
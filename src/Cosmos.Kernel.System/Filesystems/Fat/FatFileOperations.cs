@@ -6,6 +6,9 @@ namespace Cosmos.Kernel.System.Filesystems.Fat;
 
 internal sealed class FatFileOperations : IFileOperations
 {
+    /// <summary>How far ahead of a sequential reader the next clusters of the chain are prefetched.</summary>
+    private const long ReadAheadBytes = 64 * 1024;
+
     private readonly FatSuperblock _superblock;
 
     public FatFileOperations(FatSuperblock superblock)
@@ -44,6 +47,12 @@ internal sealed class FatFileOperations : IFileOperations
         long intraOffset = position % clusterSize;
         long copied = 0;
 
+        // Load every cluster this read covers in one go and, for a reader
+        // continuing where it left off, the next window along the chain.
+        long lastIndex = (position + toRead - 1) / clusterSize;
+        long window = position == inode.ReadAheadCursor ? Math.Max(1, ReadAheadBytes / clusterSize) : 0;
+        _superblock.ReadAhead(chain, (int)clusterIndex, (int)(lastIndex - clusterIndex + 1 + window));
+
         Span<byte> clusterBuffer = new byte[clusterSize];
 
         while (copied < toRead && clusterIndex < chain.Count)
@@ -61,6 +70,8 @@ internal sealed class FatFileOperations : IFileOperations
             clusterIndex++;
         }
 
+        inode.ReadAheadCursor = position + copied;
+
         // Position advancement is the caller's responsibility (matches the
         // Linux VFS convention; VfsFileHandle re-applies it on top of this
         // return value).
@@ -1,6 +1,7 @@
 // This code is licensed under MIT license (see LICENSE for details)
 
 using System.Diagnostics.CodeAnalysis;
+using Cosmos.Kernel.HAL.Devices.Storage;
 using Cosmos.Kernel.HAL.Interfaces.Devices;
 using Cosmos.Kernel.HAL.Vfs;
 using Cosmos.Kernel.System.Storage;
@@ -71,7 +72,19 @@ public sealed class FatFilesystemType : IVfsFilesystemType
             return false;
         }
 
-        superblock = new FatSuperblock(device, boot);
+        // Storage-stack devices get a write-back block cache. Injected
+        // devices (RAM disks, test seams) stay uncached: their owner may
+        // rewrite them behind the mount, which a write-back cache would
+        // later clobber. Such callers can inject a BlockCache themselves and
+        // dispose it after unmount; only the cache made here is the mount's.
+        if (device is BlockDevice)
+        {
+            superblock = new FatSuperblock(new BlockCache(device), boot, ownsCache: true);
+        }
+        else
+        {
+            superblock = new FatSuperblock(device, boot);
+        }
         return true;
     }
 
@@ -29,6 +29,9 @@ internal sealed class FatInode : IVfsInode
 
     public List<uint>? CachedChain { get; internal set; }
 
+    /// <summary>File position just past the last read; a read starting there is sequential and triggers read-ahead.</summary>
+    public long ReadAheadCursor { get; internal set; }
+
     internal FatInode(
         FatSuperblock superblock,
         string name,
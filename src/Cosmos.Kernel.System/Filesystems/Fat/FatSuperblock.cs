@@ -2,6 +2,7 @@
 
 using Cosmos.Kernel.HAL.Interfaces.Devices;
 using Cosmos.Kernel.HAL.Vfs;
+using Cosmos.Kernel.System.Storage;
 
 namespace Cosmos.Kernel.System.Filesystems.Fat;
 
@@ -11,6 +12,8 @@ internal sealed class FatSuperblock : IVfsSuperblock
     private const int ShortEntrySlotCount = 1;
 
     private readonly IBlockDevice _device;
+    private readonly BlockCache? _cache;
+    private readonly bool _ownsCache;
     private readonly Dictionary<uint, FatInode> _inodeCache = new();
 
     public FatBootSector Boot { get; }
@@ -24,9 +27,15 @@ internal sealed class FatSuperblock : IVfsSuperblock
     public long BlockSize => Boot.BytesPerSector;
     public ulong MaxNameLength => FatDirectory.MaxLfnNameLength;
 
-    public FatSuperblock(IBlockDevice device, FatBootSector boot)
+    /// <param name="ownsCache">
+    /// True when <paramref name="device"/> is a <see cref="BlockCache"/> the mount created,
+    /// so <see cref="Drop"/> disposes it; a cache the caller injected stays theirs.
+    /// </param>
+    public FatSuperblock(IBlockDevice device, FatBootSector boot, bool ownsCache = false)
     {
         _device = device;
+        _cache = device as BlockCache;
+        _ownsCache = ownsCache && _cache != null;
         Boot = boot;
         Fat = new FatTable(device, boot);
         InodeOps = new FatInodeOperations(this);
@@ -41,6 +50,13 @@ internal sealed class FatSuperblock : IVfsSuperblock
     public void Drop()
     {
         _inodeCache.Clear();
+        // Writes back what is left and stops background write-back to a
+        // device that is no longer mounted. An injected cache is only
+        // flushed (by the caller's Flush); its owner disposes it.
+        if (_ownsCache)
+        {
+            _cache!.Dispose();
+        }
     }
 
     /// <summary>Flush the device's volatile write cache — the durability point for sync and unmount.</summary>
@@ -55,6 +71,33 @@ internal sealed class FatSuperblock : IVfsSuperblock
         _device.ReadBlock(lba, Boot.SectorsPerCluster, data);
     }
 
+    /// <summary>
+    /// Ask the block cache (if the volume has one) to load
+    /// <paramref name="count"/> clusters of <paramref name="chain"/> from
+    /// <paramref name="first"/> on, merging clusters that are adjacent on
+    /// disk into one request.
+    /// </summary>
+    public void ReadAhead(List<uint> chain, int first, int count)
+    {
+        if (_cache == null)
+        {
+            return;
+        }
+
+        int end = Math.Min(chain.Count, first + count);
+        int run = first;
+        for (int i = first + 1; i <= end; i++)
+        {
+            if (i < end && chain[i] == chain[i - 1] + 1)
+            {
+                continue;
+            }
+
+            _cache.ReadAhead(Boot.ClusterToLba(chain[run]), (ulong)(i - run) * Boot.SectorsPerCluster);
+            run = i;
+        }
+    }
+
     public void WriteCluster(uint cluster, ReadOnlySpan<byte> data)
     {
         ulong lba = Boot.ClusterToLba(cluster);
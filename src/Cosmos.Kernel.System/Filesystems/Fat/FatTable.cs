@@ -1,5 +1,6 @@
 // This code is licensed under MIT license (see LICENSE for details)
 
+using System.Numerics;
 using Cosmos.Kernel.HAL.Interfaces.Devices;
 
 namespace Cosmos.Kernel.System.Filesystems.Fat;
@@ -10,6 +11,9 @@ namespace Cosmos.Kernel.System.Filesystems.Fat;
 /// using <see cref="FatBootSector"/> geometry. Cluster numbers coming from
 /// on-disk metadata are untrusted: accessors treat anything outside the
 /// volume's data clusters as end-of-chain and never let it drive I/O.
+/// Free clusters are tracked in an in-memory bitmap built by one sweep of
+/// the table on first allocation (or free count), so neither has to scan
+/// the FAT afterwards.
 /// </summary>
 public sealed class FatTable
 {
@@ -85,6 +89,12 @@ public sealed class FatTable
     /// <summary>Mask isolating the low byte of a 16-bit FAT12 pair word.</summary>
     private const int LowByteMask = 0xFF;
 
+    /// <summary>Clusters tracked per word of the free-cluster bitmap.</summary>
+    private const int FreeMapWordBits = 64;
+
+    /// <summary>log2 of <see cref="FreeMapWordBits"/>, for cluster-to-word indexing.</summary>
+    private const int FreeMapWordShift = 6;
+
     private readonly IBlockDevice _device;
     private readonly FatBootSector _boot;
 
@@ -106,6 +116,12 @@ public sealed class FatTable
 
     private uint _nextFreeHint = FirstDataCluster;
 
+    /// <summary>One bit per cluster below <see cref="_clusterLimit"/>, set when the cluster is free; null until first needed.</summary>
+    private ulong[]? _freeMap;
+
+    /// <summary>Set bits in <see cref="_freeMap"/>.</summary>
+    private uint _freeCount;
+
     public FatTable(IBlockDevice device, FatBootSector boot)
     {
         _device = device;
@@ -176,6 +192,8 @@ public sealed class FatTable
                 break;
         }
 
+        UpdateFreeMap(cluster, value == FreeCluster);
+
         if (value == FreeCluster && cluster >= FirstDataCluster && cluster < _nextFreeHint)
         {
             _nextFreeHint = cluster;
@@ -317,76 +335,148 @@ public sealed class FatTable
 
     public uint FindFree()
     {
-        uint upper = _clusterLimit;
-        uint start = _nextFreeHint < FirstDataCluster ? FirstDataCluster : _nextFreeHint;
+        ulong[] map = EnsureFreeMap();
+        if (_freeCount == 0)
+        {
+            return 0;
+        }
 
-        for (uint i = start; i < upper; i++)
+        uint start = _nextFreeHint < FirstDataCluster || _nextFreeHint >= _clusterLimit ? FirstDataCluster : _nextFreeHint;
+        uint cluster = FindSetBit(map, start, _clusterLimit);
+        if (cluster == 0)
         {
-            if (Get(i) == FreeCluster)
-            {
-                _nextFreeHint = i + 1;
-                return i;
-            }
+            // Wrap and search from the beginning in case earlier clusters were freed.
+            cluster = FindSetBit(map, FirstDataCluster, start);
         }
 
-        // Wrap and search from the beginning in case earlier clusters were freed.
-        for (uint i = FirstDataCluster; i < start; i++)
+        if (cluster != 0)
         {
-            if (Get(i) == FreeCluster)
+            _nextFreeHint = cluster + 1;
+        }
+        return cluster;
+    }
+
+    public uint CountFree()
+    {
+        EnsureFreeMap();
+        return _freeCount;
+    }
+
+    /// <summary>First set bit in [<paramref name="from"/>, <paramref name="to"/>), or 0 if none.</summary>
+    private static uint FindSetBit(ulong[] map, uint from, uint to)
+    {
+        uint word = from >> FreeMapWordShift;
+        uint lastWord = (to + FreeMapWordBits - 1) >> FreeMapWordShift;
+        // Mask off the bits below `from` in its word.
+        ulong bits = word < lastWord ? map[word] & (ulong.MaxValue << (int)(from & (FreeMapWordBits - 1))) : 0;
+        while (word < lastWord)
+        {
+            if (bits != 0)
+            {
+                uint cluster = (word << FreeMapWordShift) + (uint)BitOperations.TrailingZeroCount(bits);
+                return cluster < to ? cluster : 0;
+            }
+
+            word++;
+            if (word < lastWord)
             {
-                _nextFreeHint = i + 1;
-                return i;
+                bits = map[word];
             }
         }
 
         return 0;
     }
 
-    public uint CountFree()
+    private void UpdateFreeMap(uint cluster, bool free)
     {
+        ulong[]? map = _freeMap;
+        if (map == null)
+        {
+            return;
+        }
+
+        ulong bit = 1UL << (int)(cluster & (FreeMapWordBits - 1));
+        ref ulong word = ref map[cluster >> FreeMapWordShift];
+        bool wasFree = (word & bit) != 0;
+        if (free == wasFree)
+        {
+            return;
+        }
+
+        if (free)
+        {
+            word |= bit;
+            _freeCount++;
+        }
+        else
+        {
+            word &= ~bit;
+            _freeCount--;
+        }
+    }
+
+    /// <summary>
+    /// Returns the free-cluster bitmap, building it on first use with one
+    /// sweep of the first FAT copy. <see cref="Set"/> keeps it current
+    /// from then on.
+    /// </summary>
+    private ulong[] EnsureFreeMap()
+    {
+        if (_freeMap != null)
+        {
+            return _freeMap;
+        }
+
+        ulong[] map = new ulong[(_clusterLimit + FreeMapWordBits - 1) >> FreeMapWordShift];
+        uint freeCount = 0;
+
         // Per-entry reads through Get() cost one cached-sector lookup per
         // entry; the FAT12 entry straddling makes a sector sweep fiddly,
         // so FAT12 keeps the per-entry path (the sector cache makes it one
         // read per FAT sector anyway).
         if (_boot.Type == FatType.Fat12)
         {
-            uint count = 0;
             for (uint i = FirstDataCluster; i < _clusterLimit; i++)
             {
                 if (Get(i) == FreeCluster)
                 {
-                    count++;
+                    map[i >> FreeMapWordShift] |= 1UL << (int)(i & (FreeMapWordBits - 1));
+                    freeCount++;
                 }
             }
-            return count;
         }
-
-        uint entrySize = _boot.Type == FatType.Fat32 ? Fat32EntrySize : Fat16EntrySize;
-        uint entriesPerSector = _boot.BytesPerSector / entrySize;
-        uint freeCount = 0;
-        Span<byte> buffer = _fatSpill;
-
-        for (uint sectorIdx = 0; sectorIdx < _boot.FatSectorCount; sectorIdx++)
+        else
         {
-            _device.ReadBlock(_boot.FatStartLba + sectorIdx, 1, buffer);
-            for (uint j = 0; j < entriesPerSector; j++)
-            {
-                uint cluster = sectorIdx * entriesPerSector + j;
-                if (!IsDataCluster(cluster))
-                {
-                    continue;
-                }
+            uint entrySize = _boot.Type == FatType.Fat32 ? Fat32EntrySize : Fat16EntrySize;
+            uint entriesPerSector = _boot.BytesPerSector / entrySize;
+            Span<byte> buffer = _fatSpill;
 
-                uint entry = entrySize == Fat32EntrySize
-                    ? BitConverter.ToUInt32(buffer.Slice((int)(j * Fat32EntrySize), (int)Fat32EntrySize)) & Fat32EntryMask
-                    : BitConverter.ToUInt16(buffer.Slice((int)(j * Fat16EntrySize), (int)Fat16EntrySize));
-                if (entry == FreeCluster)
+            for (uint sectorIdx = 0; sectorIdx < _boot.FatSectorCount; sectorIdx++)
+            {
+                _device.ReadBlock(_boot.FatStartLba + sectorIdx, 1, buffer);
+                for (uint j = 0; j < entriesPerSector; j++)
                 {
-                    freeCount++;
+                    uint cluster = sectorIdx * entriesPerSector + j;
+                    if (!IsDataCluster(cluster))
+                    {
+                        continue;
+                    }
+
+                    uint entry = entrySize == Fat32EntrySize
+                        ? BitConverter.ToUInt32(buffer.Slice((int)(j * Fat32EntrySize), (int)Fat32EntrySize)) & Fat32EntryMask
+                        : BitConverter.ToUInt16(buffer.Slice((int)(j * Fat16EntrySize), (int)Fat16EntrySize));
+                    if (entry == FreeCluster)
+                    {
+                        map[cluster >> FreeMapWordShift] |= 1UL << (int)(cluster & (FreeMapWordBits - 1));
+                        freeCount++;
+                    }
                 }
             }
         }
-        return freeCount;
+
+        _freeMap = map;
+        _freeCount = freeCount;
+        return map;
     }
 
     /// <summary>
@@ -1,3 +1,4 @@
+using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.HAL.Cpu;
@@ -40,6 +41,11 @@ public abstract partial class Kernel
 
         EarlyGop.Enabled = false;
 
+        if (CosmosFeatures.AcpiEagerNamespaceEnabled)
+        {
+            Power.PrepareInBackground();
+        }
+
         Serial.WriteString("[Kernel] Calling BeforeRun()...\n");
         BeforeRun();
 
@@ -23,6 +23,27 @@ public static class Power
         }
     }
 
+    /// <summary>
+    /// Run the platform's power-transition preparation (<c>IPowerOps.Prepare</c>)
+    /// on a background thread, so a later <see cref="Shutdown"/> skips it.
+    /// Called by <c>Kernel.Start</c> when CosmosEnableAcpiEagerNamespace is set.
+    /// </summary>
+    public static void PrepareInBackground()
+    {
+        if (PlatformHAL.PowerOps == null)
+        {
+            return;
+        }
+
+        global::System.Threading.Thread worker = new(PrepareWorker);
+        worker.Start();
+    }
+
+    private static void PrepareWorker()
+    {
+        PlatformHAL.PowerOps?.Prepare();
+    }
+
     /// <summary>
     /// Restart the machine. Does not return on success; falls back to <see cref="Halt"/>
     /// if power ops are unavailable.
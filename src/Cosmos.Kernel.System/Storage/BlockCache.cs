@@ -0,0 +1,688 @@
+// This code is licensed under MIT license (see LICENSE for details)
+
+using System.Diagnostics;
+using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.Core.Scheduler;
+using Cosmos.Kernel.HAL.Devices.Storage;
+using Cosmos.Kernel.HAL.Interfaces.Devices;
+using SchedMutex = Cosmos.Kernel.Core.Scheduler.Mutex;
+using SysThread = System.Threading.Thread;
+
+namespace Cosmos.Kernel.System.Storage;
+
+/// <summary>
+/// Write-back cache in front of one block device, used by filesystems for
+/// their metadata and file data. Holds an LRU of page-sized buffers, each
+/// covering the page-aligned run of blocks it maps; reads fill whole
+/// pages, writes dirty them, and dirty pages reach the device on eviction,
+/// on <see cref="Flush"/>, or from the background flusher once they have
+/// been dirty for <see cref="DirtyExpireMs"/>.
+///
+/// <para>The cache assumes it is the only writer of the device while it
+/// is in use: raw writes that bypass it are not seen by cached readers,
+/// and dirty pages written back later overwrite them. Filesystem drivers
+/// therefore only put it in front of devices the storage stack owns.</para>
+///
+/// <para>When the device is a <see cref="BlockDevice"/>, page fills and
+/// write-backs go out as one <see cref="BlockDevice.SubmitBatch"/> per
+/// call, so a device with a hardware queue sees them in parallel.</para>
+/// </summary>
+public sealed class BlockCache : IBlockDevice, IDisposable
+{
+    /// <summary>Pages cached when the caller doesn't choose: 1 MiB of 4 KiB pages.</summary>
+    public const int DefaultCapacityPages = 256;
+
+    /// <summary>How often the background flusher wakes up.</summary>
+    private const int FlushIntervalMs = 1000;
+
+    /// <summary>Age at which the background flusher writes a dirty page back.</summary>
+    private const int DirtyExpireMs = 5000;
+
+    /// <summary>Milliseconds per second, for converting <see cref="Stopwatch"/> ticks.</summary>
+    private const long MillisecondsPerSecond = 1000;
+
+    /// <summary>Read-ahead is capped at this fraction of the capacity so one prefetch can't flush the whole cache.</summary>
+    private const int ReadAheadCapacityDivisor = 4;
+
+    private sealed class CachePage
+    {
+        public ulong Index;
+        public ulong FirstBlock;
+        public ulong Blocks;
+        public byte[] Data = [];
+        public bool Dirty;
+        public long DirtySince;
+        public CachePage? Prev;
+        public CachePage? Next;
+    }
+
+    private static readonly List<BlockCache> s_flushed = [];
+    private static readonly SchedMutex s_flushedLock = new();
+    private static SysThread? s_flusher;
+
+    private readonly IBlockDevice _device;
+    private readonly BlockDevice? _batchDevice;
+    private readonly int _capacity;
+    private readonly ulong _blocksPerPage;
+    private readonly int _pageBytes;
+    private readonly Dictionary<ulong, CachePage> _pages = new();
+    private readonly SchedMutex _lock = new();
+    private readonly List<CachePage> _batch = [];
+
+    // Most recently used at the head, eviction candidates at the tail.
+    private CachePage? _head;
+    private CachePage? _tail;
+    private bool _registered;
+
+    /// <summary>The device the cache sits in front of.</summary>
+    public IBlockDevice Device => _device;
+
+    /// <inheritdoc />
+    public ulong BlockCount => _device.BlockCount;
+
+    /// <inheritdoc />
+    public ulong BlockSize => _device.BlockSize;
+
+    /// <inheritdoc />
+    public string Name => _device.Name;
+
+    /// <summary>Maximum number of pages held.</summary>
+    public int CapacityPages => _capacity;
+
+    /// <summary>Bytes of device data one page holds: a memory page, or one block if blocks are larger.</summary>
+    public int PageBytes => _pageBytes;
+
+    /// <summary>Page lookups served from memory.</summary>
+    public ulong Hits { get; private set; }
+
+    /// <summary>Page lookups that had to be filled from the device (or that overwrote a whole page).</summary>
+    public ulong Misses { get; private set; }
+
+    /// <summary>Pages loaded by <see cref="ReadAhead"/> before anyone asked for them.</summary>
+    public ulong ReadAheadPages { get; private set; }
+
+    /// <summary>Dirty pages written back to the device.</summary>
+    public ulong WriteBacks { get; private set; }
+
+    /// <summary>Pages currently dirty.</summary>
+    public int DirtyPages { get; private set; }
+
+    /// <summary>
+    /// Creates a cache of <paramref name="capacityPages"/> pages over
+    /// <paramref name="device"/>. With <paramref name="backgroundFlush"/>
+    /// the cache joins the shared flusher thread (started on first use once
+    /// the scheduler runs); without it, dirty pages only leave on eviction
+    /// and <see cref="Flush"/>.
+    /// </summary>
+    public BlockCache(IBlockDevice device, int capacityPages = DefaultCapacityPages, bool backgroundFlush = true)
+    {
+        if (device.BlockSize == 0)
+        {
+            throw new ArgumentException("Block size must be non-zero.", nameof(device));
+        }
+        if (capacityPages < 1)
+        {
+            throw new ArgumentOutOfRangeException(nameof(capacityPages));
+        }
+
+        _device = device;
+        _batchDevice = device as BlockDevice;
+        _capacity = capacityPages;
+        _blocksPerPage = device.BlockSize >= PageAllocator.PageSize ? 1 : PageAllocator.PageSize / device.BlockSize;
+        _pageBytes = (int)(_blocksPerPage * device.BlockSize);
+
+        if (backgroundFlush)
+        {
+            Register(this);
+        }
+    }
+
+    /// <inheritdoc />
+    public void ReadBlock(ulong blockNo, ulong blockCount, Span<byte> data)
+    {
+        CheckRequest(blockNo, blockCount, data.Length);
+        if (blockCount == 0)
+        {
+            return;
+        }
+
+        _lock.Acquire();
+        try
+        {
+            // Fill every page the read touches in one batch first, so a
+            // multi-page miss costs one round trip instead of one per page.
+            Populate(blockNo / _blocksPerPage, (blockNo + blockCount - 1) / _blocksPerPage, countAsReadAhead: false);
+
+            ulong block = blockNo;
+            ulong end = blockNo + blockCount;
+            int copied = 0;
+            while (block < end)
+            {
+                CachePage page = GetResident(block / _blocksPerPage);
+                ulong inPage = block - page.FirstBlock;
+                ulong blocks = Math.Min(page.FirstBlock + page.Blocks, end) - block;
+                int bytes = (int)(blocks * BlockSize);
+                page.Data.AsSpan((int)(inPage * BlockSize), bytes).CopyTo(data.Slice(copied, bytes));
+                copied += bytes;
+                block += blocks;
+            }
+        }
+        finally
+        {
+            _lock.Release();
+        }
+    }
+
+    /// <inheritdoc />
+    /// <remarks>Completes into the cache; the data is on the device after <see cref="Flush"/>.</remarks>
+    public void WriteBlock(ulong blockNo, ulong blockCount, ReadOnlySpan<byte> data)
+    {
+        CheckRequest(blockNo, blockCount, data.Length);
+        if (blockCount == 0)
+        {
+            return;
+        }
+
+        _lock.Acquire();
+        try
+        {
+            ulong block = blockNo;
+            ulong end = blockNo + blockCount;
+            int copied = 0;
+            while (block < end)
+            {
+                ulong index = block / _blocksPerPage;
+                ulong first = index * _blocksPerPage;
+                ulong pageBlocks = Math.Min(_blocksPerPage, BlockCount - first);
+                ulong inPage = block - first;
+                ulong blocks = Math.Min(first + pageBlocks, end) - block;
+
+                // A write covering the whole page needn't read it first.
+                CachePage page = inPage == 0 && blocks == pageBlocks ? GetForOverwrite(index) : GetLoaded(index);
+                int bytes = (int)(blocks * BlockSize);
+                data.Slice(copied, bytes).CopyTo(page.Data.AsSpan((int)(inPage * BlockSize), bytes));
+                MarkDirty(page);
+
+                copied += bytes;
+                block += blocks;
+            }
+        }
+        finally
+        {
+            _lock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Writes every dirty page back, then flushes the device's own write
+    /// cache — the durability point filesystems call on sync and unmount.
+    /// </summary>
+    public void Flush()
+    {
+        _lock.Acquire();
+        try
+        {
+            WriteBackDirty(long.MaxValue);
+        }
+        finally
+        {
+            _lock.Release();
+        }
+
+        _device.Flush();
+    }
+
+    /// <summary>
+    /// Loads the pages covering <paramref name="blockCount"/> blocks at
+    /// <paramref name="blockNo"/> that aren't cached yet, so a later read
+    /// hits memory. Filesystems call it with the blocks they predict come
+    /// next (e.g. the following clusters of a file read sequentially).
+    /// Requests past the device end are clipped; at most a quarter of the
+    /// cache is loaded per call.
+    /// </summary>
+    public void ReadAhead(ulong blockNo, ulong blockCount)
+    {
+        if (blockCount == 0 || blockNo >= BlockCount)
+        {
+            return;
+        }
+
+        blockCount = Math.Min(blockCount, BlockCount - blockNo);
+        ulong firstPage = blockNo / _blocksPerPage;
+        ulong lastPage = (blockNo + blockCount - 1) / _blocksPerPage;
+        ulong maxPages = (ulong)Math.Max(1, _capacity / ReadAheadCapacityDivisor);
+        if (lastPage - firstPage + 1 > maxPages)
+        {
+            lastPage = firstPage + maxPages - 1;
+        }
+
+        _lock.Acquire();
+        try
+        {
+            Populate(firstPage, lastPage, countAsReadAhead: true);
+        }
+        finally
+        {
+            _lock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Writes every dirty page back and leaves the background flusher.
+    /// The cache stays usable; from then on dirty pages only leave on
+    /// eviction and <see cref="Flush"/>.
+    /// </summary>
+    public void Dispose()
+    {
+        Flush();
+        Unregister(this);
+    }
+
+    private void CheckRequest(ulong blockNo, ulong blockCount, int length)
+    {
+        // Divide form and overflow-safe bound, as in the device drivers.
+        if (blockNo > BlockCount || blockCount > BlockCount - blockNo)
+        {
+            throw new ArgumentOutOfRangeException(nameof(blockNo), "Cached I/O extends beyond device end.");
+        }
+        if (blockCount > (ulong)length / BlockSize)
+        {
+            throw new ArgumentOutOfRangeException(nameof(blockCount), "Span shorter than the requested transfer.");
+        }
+    }
+
+    // Caller holds _lock. Loads every uncached page in [firstPage, lastPage].
+    private void Populate(ulong firstPage, ulong lastPage, bool countAsReadAhead)
+    {
+        _batch.Clear();
+        for (ulong index = firstPage; index <= lastPage; index++)
+        {
+            if (_pages.TryGetValue(index, out CachePage? page))
+            {
+                // Keep pages of this batch off the LRU tail while the rest
+                // of the batch is being allocated.
+                Touch(page);
+                if (!countAsReadAhead)
+                {
+                    Hits++;
+                }
+                continue;
+            }
+
+            // Bounded by capacity: a batch larger than the cache would evict
+            // its own pages before they are read.
+            if (_batch.Count == _capacity)
+            {
+                break;
+            }
+
+            try
+            {
+                page = Allocate(index);
+            }
+            catch
+            {
+                DiscardBatch();
+                throw;
+            }
+            _batch.Add(page);
+        }
+
+        if (_batch.Count == 0)
+        {
+            return;
+        }
+
+        try
+        {
+            Transfer(_batch, BlockOperation.Read);
+        }
+        catch
+        {
+            DiscardBatch();
+            throw;
+        }
+
+        if (countAsReadAhead)
+        {
+            ReadAheadPages += (ulong)_batch.Count;
+        }
+        else
+        {
+            Misses += (ulong)_batch.Count;
+        }
+        _batch.Clear();
+    }
+
+    // Caller holds _lock. Pages of a failed fill hold no valid data; unmap
+    // them so no later read returns their contents.
+    private void DiscardBatch()
+    {
+        for (int i = 0; i < _batch.Count; i++)
+        {
+            CachePage page = _batch[i];
+            Unlink(page);
+            _pages.Remove(page.Index);
+        }
+        _batch.Clear();
+    }
+
+    // Caller holds _lock. A page the caller just populated (already counted),
+    // or — if a batch larger than the cache pushed it out again — reloaded.
+    private CachePage GetResident(ulong index)
+    {
+        if (_pages.TryGetValue(index, out CachePage? page))
+        {
+            Touch(page);
+            return page;
+        }
+
+        return GetLoaded(index);
+    }
+
+    // Caller holds _lock.
+    private CachePage GetLoaded(ulong index)
+    {
+        if (_pages.TryGetValue(index, out CachePage? page))
+        {
+            Hits++;
+            Touch(page);
+            return page;
+        }
+
+        page = Allocate(index);
+        _batch.Clear();
+        _batch.Add(page);
+        try
+        {
+            Transfer(_batch, BlockOperation.Read);
+        }
+        catch
+        {
+            DiscardBatch();
+            throw;
+        }
+
+        _batch.Clear();
+        Misses++;
+        return page;
+    }
+
+    // Caller holds _lock. The returned page's contents are about to be
+    // fully overwritten, so an uncached page is not read first.
+    private CachePage GetForOverwrite(ulong index)
+    {
+        if (_pages.TryGetValue(index, out CachePage? page))
+        {
+            Hits++;
+            Touch(page);
+            return page;
+        }
+
+        Misses++;
+        return Allocate(index);
+    }
+
+    // Caller holds _lock. Maps a page for `index`, recycling the LRU tail
+    // (written back first if dirty) once the cache is full. The page goes
+    // in at the head with unspecified contents.
+    private CachePage Allocate(ulong index)
+    {
+        CachePage page;
+        if (_pages.Count < _capacity)
+        {
+            page = new CachePage { Data = new byte[_pageBytes] };
+        }
+        else
+        {
+            page = _tail!;
+            if (page.Dirty)
+            {
+                // Throws before the page is unmapped, so its data survives
+                // a failed write-back.
+                _device.WriteBlock(page.FirstBlock, page.Blocks, page.Data.AsSpan(0, (int)(page.Blocks * BlockSize)));
+                ClearDirty(page);
+                WriteBacks++;
+            }
+            Unlink(page);
+            _pages.Remove(page.Index);
+        }
+
+        page.Index = index;
+        page.FirstBlock = index * _blocksPerPage;
+        page.Blocks = Math.Min(_blocksPerPage, BlockCount - page.FirstBlock);
+        _pages[index] = page;
+        PushHead(page);
+        return page;
+    }
+
+    private void MarkDirty(CachePage page)
+    {
+        if (!page.Dirty)
+        {
+            page.Dirty = true;
+            page.DirtySince = Stopwatch.GetTimestamp();
+            DirtyPages++;
+        }
+    }
+
+    private void ClearDirty(CachePage page)
+    {
+        if (page.Dirty)
+        {
+            page.Dirty = false;
+            DirtyPages--;
+        }
+    }
+
+    // Caller holds _lock. Writes back, in one batch, every dirty page that
+    // became dirty before `dirtyBefore` (a Stopwatch timestamp).
+    private void WriteBackDirty(long dirtyBefore)
+    {
+        if (DirtyPages == 0)
+        {
+            return;
+        }
+
+        List<CachePage> dirty = new(DirtyPages);
+        for (CachePage? page = _head; page != null; page = page.Next)
+        {
+            if (page.Dirty && page.DirtySince < dirtyBefore)
+            {
+                dirty.Add(page);
+            }
+        }
+
+        if (dirty.Count == 0)
+        {
+            return;
+        }
+
+        Transfer(dirty, BlockOperation.Write);
+        for (int i = 0; i < dirty.Count; i++)
+        {
+            ClearDirty(dirty[i]);
+        }
+        WriteBacks += (ulong)dirty.Count;
+    }
+
+    // Moves every page in `pages` between memory and the device: one
+    // SubmitBatch on a BlockDevice, one call per page otherwise.
+    private void Transfer(List<CachePage> pages, BlockOperation operation)
+    {
+        if (_batchDevice != null && pages.Count > 1)
+        {
+            BlockRequest[] requests = new BlockRequest[pages.Count];
+            for (int i = 0; i < pages.Count; i++)
+            {
+                CachePage page = pages[i];
+                requests[i] = new BlockRequest(operation, page.FirstBlock, page.Blocks, page.Data, 0);
+            }
+            _batchDevice.SubmitBatch(requests);
+            return;
+        }
+
+        for (int i = 0; i < pages.Count; i++)
+        {
+            CachePage page = pages[i];
+            Span<byte> data = page.Data.AsSpan(0, (int)(page.Blocks * BlockSize));
+            if (operation == BlockOperation.Read)
+            {
+                _device.ReadBlock(page.FirstBlock, page.Blocks, data);
+            }
+            else
+            {
+                _device.WriteBlock(page.FirstBlock, page.Blocks, data);
+            }
+        }
+    }
+
+    private void Touch(CachePage page)
+    {
+        if (_head != page)
+        {
+            Unlink(page);
+            PushHead(page);
+        }
+    }
+
+    private void PushHead(CachePage page)
+    {
+        page.Prev = null;
+        page.Next = _head;
+        if (_head != null)
+        {
+            _head.Prev = page;
+        }
+        _head = page;
+        _tail ??= page;
+    }
+
+    private void Unlink(CachePage page)
+    {
+        if (page.Prev != null)
+        {
+            page.Prev.Next = page.Next;
+        }
+        else
+        {
+            _head = page.Next;
+        }
+
+        if (page.Next != null)
+        {
+            page.Next.Prev = page.Prev;
+        }
+        else
+        {
+            _tail = page.Prev;
+        }
+
+        page.Prev = null;
+        page.Next = null;
+    }
+
+    // ==================== Background flusher ====================
+
+    private static void Register(BlockCache cache)
+    {
+        s_flushedLock.Acquire();
+        try
+        {
+            if (cache._registered)
+            {
+                return;
+            }
+
+            s_flushed.Add(cache);
+            cache._registered = true;
+
+            // The flusher is a scheduler thread; before the scheduler runs
+            // (or with it disabled) caches just rely on eviction and Flush.
+            if (s_flusher == null && SchedulerManager.IsReady)
+            {
+                s_flusher = new SysThread(FlushLoop);
+                s_flusher.Start();
+            }
+        }
+        finally
+        {
+            s_flushedLock.Release();
+        }
+    }
+
+    private static void Unregister(BlockCache cache)
+    {
+        s_flushedLock.Acquire();
+        try
+        {
+            if (!cache._registered)
+            {
+                return;
+            }
+
+            // ReferenceEquals scan: List<T>.Remove routes through
+            // EqualityComparer<T>.Default, which kernel paths avoid.
+            for (int i = 0; i < s_flushed.Count; i++)
+            {
+                if (ReferenceEquals(s_flushed[i], cache))
+                {
+                    s_flushed.RemoveAt(i);
+                    break;
+                }
+            }
+            cache._registered = false;
+        }
+        finally
+        {
+            s_flushedLock.Release();
+        }
+    }
+
+    /// <summary>
+    /// Flusher thread: every <see cref="FlushIntervalMs"/>, writes back the
+    /// pages of every registered cache that have been dirty for longer
+    /// than <see cref="DirtyExpireMs"/>. It does not flush the devices'
+    /// own write caches; durability still comes from <see cref="Flush"/>.
+    /// </summary>
+    private static void FlushLoop()
+    {
+        long expireTicks = Stopwatch.Frequency * DirtyExpireMs / MillisecondsPerSecond;
+        while (true)
+        {
+            SysThread.Sleep(FlushIntervalMs);
+
+            long dirtyBefore = Stopwatch.GetTimestamp() - expireTicks;
+            s_flushedLock.Acquire();
+            try
+            {
+                for (int i = 0; i < s_flushed.Count; i++)
+                {
+                    BlockCache cache = s_flushed[i];
+                    cache._lock.Acquire();
+                    try
+                    {
+                        cache.WriteBackDirty(dirtyBefore);
+                    }
+                    catch (Exception)
+                    {
+                        // Leave the pages dirty: the next pass, an eviction
+                        // or Flush retries and surfaces the error to a caller.
+                        Serial.WriteString("[BlockCache] Background write-back failed on ");
+                        Serial.WriteString(cache.Name);
+                        Serial.WriteString("\n");
+                    }
+                    finally
+                    {
+                        cache._lock.Release();
+                    }
+                }
+            }
+            finally
+            {
+                s_flushedLock.Release();
+            }
+        }
+    }
+}
@@ -61,6 +61,27 @@ public sealed class Partition : BlockDevice
         _host.WriteBlock(StartSector + blockNo, blockCount, data);
     }
 
+    /// <inheritdoc />
+    /// <remarks>Forwarded as one batch when the host is a <see cref="BlockDevice"/>, so it keeps the host's queue depth.</remarks>
+    public override void SubmitBatch(ReadOnlySpan<BlockRequest> requests)
+    {
+        if (_host is not BlockDevice host)
+        {
+            base.SubmitBatch(requests);
+            return;
+        }
+
+        BlockRequest[] translated = new BlockRequest[requests.Length];
+        for (int i = 0; i < requests.Length; i++)
+        {
+            BlockRequest request = requests[i];
+            CheckBounds(request.BlockNo, request.BlockCount);
+            translated[i] = request.WithBlockNo(StartSector + request.BlockNo);
+        }
+
+        host.SubmitBatch(translated);
+    }
+
     /// <inheritdoc />
     public override void Flush()
     {
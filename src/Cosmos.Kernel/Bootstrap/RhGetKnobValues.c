@@ -1,6 +1,15 @@
-typedef unsigned int uint32_t;
-typedef int int32_t;
-typedef unsigned long long uint64_t;
+// Runtime knobs. ILC embeds the --runtimeknob values (RuntimeHostConfigurationOption
+// items) as g_compilerEmbeddedKnobsBlob; kmain() merges them with
+// `knob:Name=Value` arguments from the kernel command line before managed
+// startup, so GC/heap knobs can be tuned per deployment without a rebuild.
+//
+// The merged table is sorted by key (what RhGetKnobValues hands out) and
+// indexed by an FNV-1a open-addressing hash, so cosmos_knob_get() is O(1).
+// Everything lives in static storage: the table is built before the heap
+// exists and its lookups are safe from SuppressGCTransition imports.
+
+#include <stdint.h>
+#include "cosmos_log.h"
 
 // Security cookie for buffer overflow protection
 uint64_t __security_cookie = 0x2B992DDFA23249D6ULL;
@@ -12,9 +21,211 @@ typedef struct {
 
 extern Config g_compilerEmbeddedKnobsBlob;
 
+#define KNOB_MAX            256
+#define KNOB_HASH_SLOTS     512                 // power of two, >= 2 * KNOB_MAX
+#define KNOB_CMDLINE_MAX    4096
+#define KNOB_CMDLINE_PREFIX "knob:"
+
+#define FNV1A_OFFSET_BASIS  0x811C9DC5u
+#define FNV1A_PRIME         0x01000193u
+
+// keys[0..count) then values[0..count), the layout RhGetKnobValues returns.
+static char* g_knob_table[2 * KNOB_MAX];
+static uint16_t g_knob_hash[KNOB_HASH_SLOTS];  // table index + 1, 0 = empty
+static uint32_t g_knob_count = 0;
+static uint8_t g_knobs_ready = 0;
+static uint8_t g_knobs_merged = 0;             // 0: embedded blob too large, handed out as is
+static char g_knob_cmdline[KNOB_CMDLINE_MAX];
+
+static int knob_strcmp(const char* a, const char* b)
+{
+    while (*a && *a == *b) {
+        a++;
+        b++;
+    }
+    return (unsigned char)*a - (unsigned char)*b;
+}
+
+static uint32_t knob_hash(const char* key)
+{
+    uint32_t h = FNV1A_OFFSET_BASIS;
+    while (*key)
+        h = (h ^ (uint8_t)*key++) * FNV1A_PRIME;
+    return h;
+}
+
+static inline int knob_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Set `key` to `value`, replacing an existing entry. Called while the table
+// is still unsorted, so a linear scan is fine here.
+static void knob_set(char* key, char* value)
+{
+    for (uint32_t i = 0; i < g_knob_count; i++) {
+        if (knob_strcmp(g_knob_table[i], key) == 0) {
+            g_knob_table[KNOB_MAX + i] = value;
+            return;
+        }
+    }
+
+    if (g_knob_count == KNOB_MAX) {
+        COSMOS_LOG_WARN("[KNOBS] WARNING: table full, ignoring %s\n", key);
+        return;
+    }
+
+    g_knob_table[g_knob_count] = key;
+    g_knob_table[KNOB_MAX + g_knob_count] = value;
+    g_knob_count++;
+}
+
+// Split a copy of the command line into whitespace-separated tokens (double
+// quotes group spaces and are removed) and apply every knob:Name=Value one.
+static uint32_t knob_parse_cmdline(const char* cmdline)
+{
+    uint32_t len = 0;
+    while (cmdline[len] && len < KNOB_CMDLINE_MAX - 1) {
+        g_knob_cmdline[len] = cmdline[len];
+        len++;
+    }
+    g_knob_cmdline[len] = 0;
+
+    uint32_t applied = 0;
+    char* p = g_knob_cmdline;
+    while (*p) {
+        while (knob_is_space(*p))
+            p++;
+        if (!*p)
+            break;
+
+        char* token = p;
+        char* out = p;
+        int quoted = 0;
+        while (*p && (quoted || !knob_is_space(*p))) {
+            if (*p == '"')
+                quoted = !quoted;
+            else
+                *out++ = *p;
+            p++;
+        }
+        if (*p)
+            p++;
+        *out = 0;
+
+        const char* prefix = KNOB_CMDLINE_PREFIX;
+        char* name = token;
+        while (*prefix && *name == *prefix) {
+            prefix++;
+            name++;
+        }
+        if (*prefix)
+            continue;
+
+        char* eq = name;
+        while (*eq && *eq != '=')
+            eq++;
+        if (*eq != '=' || eq == name) {
+            COSMOS_LOG_WARN("[KNOBS] WARNING: expected knob:Name=Value, got %s\n", token);
+            continue;
+        }
+
+        *eq = 0;
+        knob_set(name, eq + 1);
+        COSMOS_LOG_DEBUG("[KNOBS] %s = %s (cmdline)\n", name, eq + 1);
+        applied++;
+    }
+
+    return applied;
+}
+
+void cosmos_knobs_init(const char* cmdline)
+{
+    if (g_knobs_ready)
+        return;
+    g_knobs_ready = 1;
+
+    uint32_t embedded = g_compilerEmbeddedKnobsBlob.m_count;
+    if (embedded > KNOB_MAX) {
+        COSMOS_LOG_WARN("[KNOBS] WARNING: %u embedded knobs exceed the table, cmdline overrides ignored\n", embedded);
+        return;
+    }
+
+    for (uint32_t i = 0; i < embedded; i++) {
+        g_knob_table[i] = g_compilerEmbeddedKnobsBlob.m_first[i];
+        g_knob_table[KNOB_MAX + i] = g_compilerEmbeddedKnobsBlob.m_first[embedded + i];
+    }
+    g_knob_count = embedded;
+
+    uint32_t applied = cmdline != 0 ? knob_parse_cmdline(cmdline) : 0;
+
+    // Insertion sort; a few dozen entries, once per boot.
+    for (uint32_t i = 1; i < g_knob_count; i++) {
+        char* key = g_knob_table[i];
+        char* value = g_knob_table[KNOB_MAX + i];
+        uint32_t j = i;
+        while (j > 0 && knob_strcmp(g_knob_table[j - 1], key) > 0) {
+            g_knob_table[j] = g_knob_table[j - 1];
+            g_knob_table[KNOB_MAX + j] = g_knob_table[KNOB_MAX + j - 1];
+            j--;
+        }
+        g_knob_table[j] = key;
+        g_knob_table[KNOB_MAX + j] = value;
+    }
+
+    for (uint32_t i = 0; i < g_knob_count; i++) {
+        uint32_t slot = knob_hash(g_knob_table[i]) & (KNOB_HASH_SLOTS - 1);
+        while (g_knob_hash[slot] != 0)
+            slot = (slot + 1) & (KNOB_HASH_SLOTS - 1);
+        g_knob_hash[slot] = (uint16_t)(i + 1);
+    }
+
+    // Sorted keys/values are contiguous from [0] and [KNOB_MAX]; close the gap
+    // so RhGetKnobValues can return values right after the keys.
+    for (uint32_t i = 0; i < g_knob_count; i++)
+        g_knob_table[g_knob_count + i] = g_knob_table[KNOB_MAX + i];
+
+    g_knobs_merged = 1;
+    COSMOS_LOG_INFO("[KNOBS] %u knob(s), %u from the command line\n", g_knob_count, applied);
+}
+
+// Value of runtime knob `key`, or NULL when it is not set.
+const char* cosmos_knob_get(const char* key)
+{
+    if (!g_knobs_ready)
+        cosmos_knobs_init(0);
+
+    if (!g_knobs_merged) {
+        uint32_t count = g_compilerEmbeddedKnobsBlob.m_count;
+        for (uint32_t i = 0; i < count; i++) {
+            if (knob_strcmp(g_compilerEmbeddedKnobsBlob.m_first[i], key) == 0)
+                return g_compilerEmbeddedKnobsBlob.m_first[count + i];
+        }
+        return 0;
+    }
+
+    uint32_t slot = knob_hash(key) & (KNOB_HASH_SLOTS - 1);
+    while (g_knob_hash[slot] != 0) {
+        uint32_t i = g_knob_hash[slot] - 1u;
+        if (knob_strcmp(g_knob_table[i], key) == 0)
+            return g_knob_table[g_knob_count + i];
+        slot = (slot + 1) & (KNOB_HASH_SLOTS - 1);
+    }
+    return 0;
+}
+
 extern uint32_t RhGetKnobValues(char *** pResultKeys, char *** pResultValues)
 {
-    *pResultKeys = g_compilerEmbeddedKnobsBlob.m_first;
-    *pResultValues = &g_compilerEmbeddedKnobsBlob.m_first[g_compilerEmbeddedKnobsBlob.m_count];
-    return g_compilerEmbeddedKnobsBlob.m_count;
-}
\ No newline at end of file
+    if (!g_knobs_ready)
+        cosmos_knobs_init(0);
+
+    if (!g_knobs_merged) {
+        *pResultKeys = g_compilerEmbeddedKnobsBlob.m_first;
+        *pResultValues = &g_compilerEmbeddedKnobsBlob.m_first[g_compilerEmbeddedKnobsBlob.m_count];
+        return g_compilerEmbeddedKnobsBlob.m_count;
+    }
+
+    *pResultKeys = g_knob_table;
+    *pResultValues = &g_knob_table[g_knob_count];
+    return g_knob_count;
+}
@@ -0,0 +1,131 @@
+// Boot profile table and serial dump (see boot_profile.h).
+//
+// Dump format, one record per line so partial captures stay parseable:
+//   [BOOTPROF] begin v=1 arch=<x64|arm64> clock=<tsc|cntvct> hz=<ticks/s or 0> entries=<n> dropped=<n>
+//   [BOOTPROF] phase <depth> <name> <start> <ticks>
+//   [BOOTPROF] end total=<ticks>
+// <start> is relative to the origin passed to cosmos_boot_profile_init().
+// An unclosed phase reports <ticks> up to the dump.
+
+#include "boot_profile.h"
+
+extern void __cosmos_serial_write(const char* message);
+extern void __cosmos_serial_write_dec_u32(uint32_t value);
+extern void __cosmos_serial_write_dec_u64(uint64_t value);
+
+typedef struct {
+    const char* name;
+    uint64_t start;
+    uint64_t end;     // 0 while the phase is still open
+    uint32_t depth;
+} boot_phase_t;
+
+static boot_phase_t g_boot_phases[BOOT_PROFILE_MAX_ENTRIES];
+static uint32_t g_boot_phase_count = 0;
+static uint32_t g_boot_phase_dropped = 0;
+static uint32_t g_boot_phase_depth = 0;
+static uint64_t g_boot_origin = 0;
+
+// Counter frequency, or 0 when the platform does not report it (the runner
+// then compares raw ticks).
+static uint64_t boot_profile_clock_hz(void)
+{
+#ifdef __aarch64__
+    uint64_t freq;
+    __asm__ volatile ("mrs %0, cntfrq_el0" : "=r"(freq));
+    return freq;
+#else
+    uint32_t a, b, c, d;
+    __asm__ volatile ("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0), "c"(0));
+    uint32_t max_leaf = a;
+
+    // Leaf 0x15: TSC/crystal ratio (EBX/EAX) and crystal frequency (ECX).
+    if (max_leaf >= 0x15) {
+        __asm__ volatile ("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0x15), "c"(0));
+        if (a != 0 && b != 0 && c != 0)
+            return (uint64_t)c * b / a;
+    }
+
+    // Leaf 0x16: processor base frequency in MHz (approximates invariant TSC).
+    if (max_leaf >= 0x16) {
+        __asm__ volatile ("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0x16), "c"(0));
+        if ((a & 0xFFFF) != 0)
+            return (uint64_t)(a & 0xFFFF) * 1000000ULL;
+    }
+
+    return 0;
+#endif
+}
+
+void cosmos_boot_profile_init(uint64_t origin)
+{
+    g_boot_origin = origin;
+}
+
+uint32_t cosmos_boot_phase_begin_at(const char* name, uint64_t start)
+{
+    if (g_boot_phase_count >= BOOT_PROFILE_MAX_ENTRIES) {
+        g_boot_phase_dropped++;
+        return BOOT_PROFILE_INVALID_SLOT;
+    }
+
+    uint32_t slot = g_boot_phase_count++;
+    g_boot_phases[slot].name = name;
+    g_boot_phases[slot].start = start;
+    g_boot_phases[slot].end = 0;
+    g_boot_phases[slot].depth = g_boot_phase_depth++;
+    return slot;
+}
+
+uint32_t cosmos_boot_phase_begin(const char* name)
+{
+    return cosmos_boot_phase_begin_at(name, cosmos_boot_timestamp());
+}
+
+void cosmos_boot_phase_end(uint32_t slot)
+{
+    uint64_t now = cosmos_boot_timestamp();
+    if (slot >= g_boot_phase_count || g_boot_phases[slot].end != 0)
+        return;
+
+    g_boot_phases[slot].end = now;
+    // Depth follows the slot being closed so a phase that was never ended
+    // does not shift every later entry one level deeper.
+    g_boot_phase_depth = g_boot_phases[slot].depth;
+}
+
+void cosmos_boot_profile_dump(void)
+{
+    uint64_t now = cosmos_boot_timestamp();
+
+    __cosmos_serial_write("[BOOTPROF] begin v=1");
+#ifdef __aarch64__
+    __cosmos_serial_write(" arch=arm64 clock=cntvct hz=");
+#else
+    __cosmos_serial_write(" arch=x64 clock=tsc hz=");
+#endif
+    __cosmos_serial_write_dec_u64(boot_profile_clock_hz());
+    __cosmos_serial_write(" entries=");
+    __cosmos_serial_write_dec_u32(g_boot_phase_count);
+    __cosmos_serial_write(" dropped=");
+    __cosmos_serial_write_dec_u32(g_boot_phase_dropped);
+    __cosmos_serial_write("\n");
+
+    for (uint32_t i = 0; i < g_boot_phase_count; i++) {
+        const boot_phase_t* p = &g_boot_phases[i];
+        uint64_t end = p->end != 0 ? p->end : now;
+        __cosmos_serial_write("[BOOTPROF] phase ");
+        __cosmos_serial_write_dec_u32(p->depth);
+        __cosmos_serial_write(" ");
+        __cosmos_serial_write(p->name != 0 ? p->name : "?");
+        __cosmos_serial_write(" ");
+        __cosmos_serial_write_dec_u64(p->start - g_boot_origin);
+        __cosmos_serial_write(" ");
+        __cosmos_serial_write_dec_u64(end - p->start);
+        __cosmos_serial_write("\n");
+    }
+
+    __cosmos_serial_write("[BOOTPROF] end total=");
+    __cosmos_serial_write_dec_u64(now - g_boot_origin);
+    __cosmos_serial_write("\n");
+}
@@ -0,0 +1,45 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+
+// Boot profile: timestamps for every kmain() phase and sub-step (including
+// the ones recorded from managed Startup through BootProfileNative), dumped
+// as "[BOOTPROF]" serial lines right before __managed__Main so the test
+// runner can scrape them and diff boot latency between builds.
+//
+// Timestamps are raw counter ticks: TSC on x86-64, CNTVCT_EL0 on ARM64.
+
+#define BOOT_PROFILE_MAX_ENTRIES 64
+#define BOOT_PROFILE_INVALID_SLOT 0xFFFFFFFFu
+
+// Read the boot clock. Integer-only so it is safe before _native_enable_simd().
+static inline uint64_t cosmos_boot_timestamp(void)
+{
+#ifdef __aarch64__
+    uint64_t value;
+    __asm__ volatile ("isb; mrs %0, cntvct_el0" : "=r"(value) : : "memory");
+    return value;
+#else
+    uint32_t lo, hi;
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+    return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+// Set the time origin for all recorded phases (normally the kmain() entry stamp).
+extern void cosmos_boot_profile_init(uint64_t origin);
+
+// Open a phase starting now / at `start`. `name` must have static storage
+// duration. Returns a slot for cosmos_boot_phase_end(), or
+// BOOT_PROFILE_INVALID_SLOT when the table is full.
+extern uint32_t cosmos_boot_phase_begin(const char* name);
+extern uint32_t cosmos_boot_phase_begin_at(const char* name, uint64_t start);
+
+// Close a phase previously opened with cosmos_boot_phase_begin*().
+extern void cosmos_boot_phase_end(uint32_t slot);
+
+// Write the recorded profile to serial.
+extern void cosmos_boot_profile_dump(void);
+
+#endif // BOOT_PROFILE_H
@@ -0,0 +1,286 @@
+// CPU feature detection (see cpu_features.h).
+
+#include "cpu_features.h"
+#include "cosmos_log.h"
+
+// Defined in kmain.c (read by generated code) and by ILC respectively. Weak
+// so a kernel compiled without an instruction-set baseline still links.
+extern int g_cpuFeatures;
+extern int g_requiredCpuFeatures __attribute__((weak));
+
+// Native.MultiArch/C/math.c: picks the libm rounding paths from g_cpuFeatures.
+extern void cosmos_math_init(void);
+
+uint8_t g_cosmos_cpu_fast_rep_movsb = 0;
+
+static uint32_t g_cpu_detected = 0;
+
+#ifdef __aarch64__
+
+// ID_AA64ISAR0_EL1 / ID_AA64ISAR1_EL1 / ID_AA64PFR0_EL1 4-bit fields.
+#define ID_FIELD(reg, shift) ((uint32_t)((reg) >> (shift)) & 0xF)
+
+static uint32_t cpu_detect(void)
+{
+    uint64_t isar0, isar1, pfr0;
+    __asm__ volatile ("mrs %0, id_aa64isar0_el1" : "=r"(isar0));
+    __asm__ volatile ("mrs %0, id_aa64isar1_el1" : "=r"(isar1));
+    __asm__ volatile ("mrs %0, id_aa64pfr0_el1" : "=r"(pfr0));
+
+    uint32_t features = 0;
+    if (ID_FIELD(isar0, 4) >= 2)  features |= COSMOS_CPU_ARM64_AES;      // AES + PMULL
+    if (ID_FIELD(isar0, 8) >= 1)  features |= COSMOS_CPU_ARM64_SHA1;
+    if (ID_FIELD(isar0, 12) >= 1) features |= COSMOS_CPU_ARM64_SHA256;
+    if (ID_FIELD(isar0, 16) >= 1) features |= COSMOS_CPU_ARM64_CRC32;
+    if (ID_FIELD(isar0, 20) >= 2) features |= COSMOS_CPU_ARM64_ATOMICS;  // LSE
+    if (ID_FIELD(isar0, 28) >= 1) features |= COSMOS_CPU_ARM64_RDM;
+    if (ID_FIELD(isar0, 44) >= 1) features |= COSMOS_CPU_ARM64_DP;
+    if (ID_FIELD(isar1, 20) >= 1) features |= COSMOS_CPU_ARM64_RCPC;
+    if (ID_FIELD(isar1, 20) >= 2) features |= COSMOS_CPU_ARM64_RCPC2;
+    if (ID_FIELD(pfr0, 32) >= 1)  features |= COSMOS_CPU_ARM64_SVE;
+    return features;
+}
+
+// Everything but SVE lives in the general and V registers, which the
+// exception frame saves in full. SVE also needs CPACR_EL1.ZEN, left off.
+#define CPU_PUBLISHABLE (~(uint32_t)COSMOS_CPU_ARM64_SVE)
+
+static void cpu_enable_state(void)
+{
+}
+
+static void cpu_enable_state_ap(void)
+{
+}
+
+#else
+
+#define CPUID1_ECX_SSE3      (1u << 0)
+#define CPUID1_ECX_PCLMULQDQ (1u << 1)
+#define CPUID1_ECX_SSSE3     (1u << 9)
+#define CPUID1_ECX_FMA       (1u << 12)
+#define CPUID1_ECX_SSE41     (1u << 19)
+#define CPUID1_ECX_SSE42     (1u << 20)
+#define CPUID1_ECX_MOVBE     (1u << 22)
+#define CPUID1_ECX_POPCNT    (1u << 23)
+#define CPUID1_ECX_AES       (1u << 25)
+#define CPUID1_ECX_XSAVE     (1u << 26)
+#define CPUID1_ECX_AVX       (1u << 28)
+#define CPUID7_EBX_BMI1      (1u << 3)
+#define CPUID7_EBX_AVX2      (1u << 5)
+#define CPUID7_EBX_BMI2      (1u << 8)
+#define CPUID7_EBX_ERMS      (1u << 9)
+#define CPUID7_EBX_AVX512F   (1u << 16)
+#define CPUID7_EBX_AVX512DQ  (1u << 17)
+#define CPUID7_EBX_AVX512CD  (1u << 28)
+#define CPUID7_EBX_SHA       (1u << 29)
+#define CPUID7_EBX_AVX512BW  (1u << 30)
+#define CPUID7_EBX_AVX512VL  (1u << 31)
+#define CPUID7_ECX_GFNI      (1u << 8)
+#define CPUID7_ECX_VAES      (1u << 9)
+#define CPUIDX1_ECX_LZCNT    (1u << 5)
+
+#define CPUIDD1_EAX_XSAVEC   (1u << 1)
+
+#define CR4_OSXSAVE          (1ull << 18)
+#define XCR0_X87_SSE         0x3ull
+#define XCR0_AVX             (1ull << 2)
+#define XCR0_AVX512          (7ull << 5)   // opmask, ZMM_Hi256, Hi16_ZMM
+
+// Legacy region (512) + XSAVE header (64): all an init-state image needs.
+#define XSTATE_INIT_AREA_SIZE 576
+#define XSTATE_MXCSR_OFFSET   24
+#define MXCSR_DEFAULT         0x1F80       // all exceptions masked, round to nearest
+
+uint8_t g_cosmos_xstate_mode = COSMOS_XSTATE_OFF;
+uint64_t g_cosmos_xstate_mask = 0;
+uint64_t g_cosmos_xstate_size = 0;
+uint8_t g_cosmos_xstate_init_area[XSTATE_INIT_AREA_SIZE] __attribute__((aligned(64)));
+
+#define ALL_SET(value, mask) (((value) & (mask)) == (mask))
+
+static inline void cpu_cpuid(uint32_t leaf, uint32_t subleaf,
+                             uint32_t* a, uint32_t* b, uint32_t* c, uint32_t* d)
+{
+    __asm__ volatile ("cpuid" : "=a"(*a), "=b"(*b), "=c"(*c), "=d"(*d) : "a"(leaf), "c"(subleaf));
+}
+
+static uint32_t g_cpu_has_xsave = 0;
+static uint32_t g_cpu_max_leaf = 0;
+
+static uint32_t cpu_detect(void)
+{
+    uint32_t a, b, c, d;
+    cpu_cpuid(0, 0, &a, &b, &c, &d);
+    uint32_t max_leaf = a;
+    g_cpu_max_leaf = max_leaf;
+
+    cpu_cpuid(1, 0, &a, &b, &c, &d);
+    uint32_t ecx1 = c;
+
+    uint32_t ebx7 = 0, ecx7 = 0;
+    if (max_leaf >= 7) {
+        cpu_cpuid(7, 0, &a, &b, &c, &d);
+        ebx7 = b;
+        ecx7 = c;
+    }
+
+    uint32_t ecx_ext = 0;
+    cpu_cpuid(0x80000000, 0, &a, &b, &c, &d);
+    if (a >= 0x80000001) {
+        cpu_cpuid(0x80000001, 0, &a, &b, &c, &d);
+        ecx_ext = c;
+    }
+
+    g_cpu_has_xsave = (ecx1 & CPUID1_ECX_XSAVE) != 0;
+    g_cosmos_cpu_fast_rep_movsb = (ebx7 & CPUID7_EBX_ERMS) != 0;
+
+    uint32_t features = 0;
+    if (ALL_SET(ecx1, CPUID1_ECX_SSE3 | CPUID1_ECX_SSSE3 | CPUID1_ECX_SSE41 |
+                      CPUID1_ECX_SSE42 | CPUID1_ECX_POPCNT))
+        features |= COSMOS_CPU_X64_SSE42;
+    if (ALL_SET(ecx1, CPUID1_ECX_AES | CPUID1_ECX_PCLMULQDQ))
+        features |= COSMOS_CPU_X64_AES;
+    if (ebx7 & CPUID7_EBX_SHA)
+        features |= COSMOS_CPU_X64_SHA;
+    if (ecx7 & CPUID7_ECX_GFNI)
+        features |= COSMOS_CPU_X64_GFNI;
+
+    if (ecx1 & CPUID1_ECX_AVX) {
+        features |= COSMOS_CPU_X64_AVX;
+        if (ALL_SET(ebx7, CPUID7_EBX_AVX2 | CPUID7_EBX_BMI1 | CPUID7_EBX_BMI2) &&
+            ALL_SET(ecx1, CPUID1_ECX_FMA | CPUID1_ECX_MOVBE) &&
+            (ecx_ext & CPUIDX1_ECX_LZCNT))
+            features |= COSMOS_CPU_X64_AVX2;
+        if ((features & COSMOS_CPU_X64_AVX2) &&
+            ALL_SET(ebx7, CPUID7_EBX_AVX512F | CPUID7_EBX_AVX512BW | CPUID7_EBX_AVX512CD |
+                          CPUID7_EBX_AVX512DQ | CPUID7_EBX_AVX512VL))
+            features |= COSMOS_CPU_X64_AVX512;
+        if (ecx7 & CPUID7_ECX_VAES)
+            features |= COSMOS_CPU_X64_VAES;
+    }
+
+    return features;
+}
+
+// XMM0-15 are always preserved by the interrupt frame. The VEX/EVEX ISAs
+// also need their YMM/ZMM/opmask state saved, so they are publishable only
+// once cpu_enable_state() has XSAVE covering it.
+#define CPU_PUBLISHABLE_SSE ((uint32_t)(COSMOS_CPU_X64_SSE42 | COSMOS_CPU_X64_AES | \
+                                        COSMOS_CPU_X64_SHA | COSMOS_CPU_X64_GFNI))
+#define CPU_PUBLISHABLE_AVX ((uint32_t)(COSMOS_CPU_X64_AVX | COSMOS_CPU_X64_AVX2 | COSMOS_CPU_X64_VAES))
+
+static uint32_t g_cpu_publishable = CPU_PUBLISHABLE_SSE;
+#define CPU_PUBLISHABLE g_cpu_publishable
+
+static uint64_t g_cpu_xcr0 = 0;
+
+static inline void cpu_xsetbv(uint64_t value)
+{
+    __asm__ volatile ("xsetbv" : : "c"(0), "a"((uint32_t)value), "d"((uint32_t)(value >> 32)));
+}
+
+// Enable CR4.OSXSAVE and the XCR0 components the detected ISAs use, then
+// pick the save instruction and area size for the interrupt stubs. Without
+// XSAVE leaf 0xD (or without AVX) only x87/SSE state is enabled and the
+// AVX family stays unpublished.
+static void cpu_enable_state(void)
+{
+    if (!g_cpu_has_xsave)
+        return;
+
+    uint64_t cr4;
+    __asm__ volatile ("mov %%cr4, %0" : "=r"(cr4));
+    __asm__ volatile ("mov %0, %%cr4" : : "r"(cr4 | CR4_OSXSAVE));
+
+    uint64_t xcr0 = XCR0_X87_SSE;
+    if ((g_cpu_detected & COSMOS_CPU_X64_AVX) && g_cpu_max_leaf >= 0xD) {
+        uint32_t a, b, c, d;
+        cpu_cpuid(0xD, 0, &a, &b, &c, &d);
+        uint64_t supported = ((uint64_t)d << 32) | a;
+
+        uint64_t wanted = XCR0_X87_SSE | XCR0_AVX;
+        if (g_cpu_detected & COSMOS_CPU_X64_AVX512)
+            wanted |= XCR0_AVX512;
+        if ((supported & wanted & XCR0_AVX512) != XCR0_AVX512)
+            wanted &= ~XCR0_AVX512;
+        if (supported & XCR0_AVX)
+            xcr0 = wanted;
+    }
+    cpu_xsetbv(xcr0);
+    g_cpu_xcr0 = xcr0;
+
+    if (xcr0 == XCR0_X87_SSE)
+        return;
+
+    uint32_t a, b, c, d;
+    cpu_cpuid(0xD, 0, &a, &b, &c, &d);
+    uint64_t standard_size = b;         // standard format, current XCR0
+    cpu_cpuid(0xD, 1, &a, &b, &c, &d);
+
+    if (a & CPUIDD1_EAX_XSAVEC) {
+        g_cosmos_xstate_mode = COSMOS_XSTATE_XSAVEC;
+        g_cosmos_xstate_size = b;       // compacted format, XCR0 | IA32_XSS
+    } else {
+        g_cosmos_xstate_mode = COSMOS_XSTATE_XSAVE;
+        g_cosmos_xstate_size = standard_size;
+    }
+    g_cosmos_xstate_mask = xcr0 & ~XCR0_X87_SSE;
+
+    for (uint32_t i = 0; i < XSTATE_INIT_AREA_SIZE; i++)
+        g_cosmos_xstate_init_area[i] = 0;
+    *(uint32_t*)(g_cosmos_xstate_init_area + XSTATE_MXCSR_OFFSET) = MXCSR_DEFAULT;
+
+    g_cpu_publishable |= CPU_PUBLISHABLE_AVX;
+    if (xcr0 & XCR0_AVX512)
+        g_cpu_publishable |= COSMOS_CPU_X64_AVX512;
+
+    static const char* const modes[] = { "off", "xsave", "xsavec" };
+    COSMOS_LOG_INFO("[CPU] Extended state: XCR0=0x%lx, %s, %lu-byte area\n",
+                    xcr0, modes[g_cosmos_xstate_mode], g_cosmos_xstate_size);
+}
+
+// Application processors enable the same state the BSP chose, so a thread
+// saved on one CPU can be restored on another.
+static void cpu_enable_state_ap(void)
+{
+    if (g_cpu_xcr0 == 0)
+        return;
+
+    uint64_t cr4;
+    __asm__ volatile ("mov %%cr4, %0" : "=r"(cr4));
+    __asm__ volatile ("mov %0, %%cr4" : : "r"(cr4 | CR4_OSXSAVE));
+    cpu_xsetbv(g_cpu_xcr0);
+}
+
+#endif
+
+uint32_t cosmos_cpu_features_init(void)
+{
+    g_cpu_detected = cpu_detect();
+
+    cpu_enable_state();
+    uint32_t published = g_cpu_detected & CPU_PUBLISHABLE;
+    g_cpuFeatures = (int)published;
+    cosmos_math_init();
+
+    uint32_t required = &g_requiredCpuFeatures != 0 ? (uint32_t)g_requiredCpuFeatures : 0;
+    uint32_t missing = required & ~published;
+
+    COSMOS_LOG_INFO("[CPU] Features: detected=0x%x published=0x%x required=0x%x\n",
+                    g_cpu_detected, published, required);
+    if (missing)
+        COSMOS_LOG_ERROR("[CPU] ERROR: kernel was compiled for unavailable ISA bits 0x%x\n", missing);
+
+    return missing;
+}
+
+void cosmos_cpu_features_init_ap(void)
+{
+    cpu_enable_state_ap();
+}
+
+uint32_t cosmos_cpu_features_detected(void)
+{
+    return g_cpu_detected;
+}
@@ -0,0 +1,83 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <stdint.h>
+
+// CPU feature detection for ILC-generated code. NativeAOT code compiled for
+// a baseline ISA tests g_cpuFeatures before taking an opportunistic path
+// (wider vectors, AES, atomics, ...); ILC emits g_requiredCpuFeatures with
+// the ISAs it compiled in unconditionally. Normally the runtime's
+// DetectCPUFeatures() fills the former and checks the latter; the kernel
+// never runs that startup path, so kmain() does it here.
+//
+// Bit values mirror minipal/cpufeatures.h of the .NET 10 runtime ILC ships
+// with. Keep them in sync when the SDK moves to a new runtime.
+
+#if defined(__x86_64__)
+#define COSMOS_CPU_X64_SSE42            (1 << 0)   // x86-64-v2: SSE3, SSSE3, SSE4.1/4.2, POPCNT
+#define COSMOS_CPU_X64_AVX              (1 << 1)
+#define COSMOS_CPU_X64_AVX2             (1 << 2)   // x86-64-v3: AVX2, BMI1/2, LZCNT, FMA, MOVBE
+#define COSMOS_CPU_X64_AVX512           (1 << 3)   // x86-64-v4: F, BW, CD, DQ, VL
+#define COSMOS_CPU_X64_AES              (1 << 9)   // AES-NI and PCLMULQDQ
+#define COSMOS_CPU_X64_GFNI             (1 << 14)
+#define COSMOS_CPU_X64_SHA              (1 << 15)
+#define COSMOS_CPU_X64_VAES             (1 << 16)
+#endif
+
+#if defined(__aarch64__)
+#define COSMOS_CPU_ARM64_AES            (1 << 0)   // AES and PMULL
+#define COSMOS_CPU_ARM64_CRC32          (1 << 1)
+#define COSMOS_CPU_ARM64_DP             (1 << 2)
+#define COSMOS_CPU_ARM64_RDM            (1 << 3)
+#define COSMOS_CPU_ARM64_SHA1           (1 << 4)
+#define COSMOS_CPU_ARM64_SHA256         (1 << 5)
+#define COSMOS_CPU_ARM64_ATOMICS        (1 << 6)   // LSE
+#define COSMOS_CPU_ARM64_RCPC           (1 << 7)
+#define COSMOS_CPU_ARM64_RCPC2          (1 << 8)
+#define COSMOS_CPU_ARM64_SVE            (1 << 9)
+#endif
+
+// Probe the CPU, publish g_cpuFeatures and enable the register state the
+// published ISAs need. Only ISAs whose registers the interrupt/thread-switch
+// frame preserves are published. The x64 frame always saves XMM0-15; the AVX
+// family is published only when XSAVE can keep the extended state (YMM/ZMM
+// upper halves, ZMM16-31, opmasks) as well (see "Extended state" below). On
+// ARM64, SVE is detected and logged but left off: the frame saves V0-V31 only.
+//
+// Returns the g_requiredCpuFeatures bits left unpublished (0 = OK). Call after
+// _native_enable_simd() and before RhpRegisterOsModule().
+uint32_t cosmos_cpu_features_init(void);
+
+// Enable on an application processor the register state the BSP enabled in
+// cosmos_cpu_features_init() (CR4.OSXSAVE and the same XCR0 on x64).
+void cosmos_cpu_features_init_ap(void);
+
+// Every ISA bit the hardware reports, published or not (diagnostics).
+uint32_t cosmos_cpu_features_detected(void);
+
+// Nonzero when `rep movsb` is the fast bulk copy (x64 ERMS); read by memcpy.
+extern uint8_t g_cosmos_cpu_fast_rep_movsb;
+
+#if defined(__x86_64__)
+// Extended state. Every interrupt stub (CPU/Interrupts.s) saves the XSAVE
+// components above SSE into an area carved out of the interrupted stack
+// right below its XMM save area, and restores them from the same place when
+// it returns or switches to that thread, so each preempted thread carries
+// its own area. The area size comes from CPUID leaf 0xD for the enabled XCR0.
+// XSAVEC (compacted) is preferred and skips components still in their init
+// state, so threads that never touch YMM/ZMM pay for the 64-byte header only;
+// plain XSAVE is the fallback. XSAVEOPT is never used: its modified
+// optimisation keys on the linear address of the last XRSTOR, and a
+// stack-carved area is reused at the same address by unrelated threads, so it
+// could skip components that changed since that restore.
+#define COSMOS_XSTATE_OFF      0
+#define COSMOS_XSTATE_XSAVE    1
+#define COSMOS_XSTATE_XSAVEC   2
+
+extern uint8_t g_cosmos_xstate_mode;       // COSMOS_XSTATE_*
+extern uint64_t g_cosmos_xstate_mask;      // XCR0 without x87/SSE (the stub saves XMM itself)
+extern uint64_t g_cosmos_xstate_size;      // bytes per area, before 64-byte alignment
+extern uint8_t g_cosmos_xstate_init_area[];  // init-state image restored into new threads
+#endif
+
+#endif // CPU_FEATURES_H
@@ -1,4 +1,8 @@
 #include "kmain.h"
+#include "boot_profile.h"
+#include "cosmos_log.h"
+#include "cpu_features.h"
+#include "smp.h"
 
 // CPU features definition
 int g_cpuFeatures = 0;
@@ -6,12 +10,21 @@ int g_cpuFeatures = 0;
 // Entry point
 void kmain()
 {
+    // Boot profile origin. rdtsc / mrs only, so it is safe ahead of SIMD enable.
+    uint64_t boot_start = cosmos_boot_timestamp();
+
     // Enable SIMD/XMM FIRST before ANY code execution
     // Without optimizations (-O), ILC generates XMM instructions even in simple functions
     _native_enable_simd();
 
+    cosmos_boot_profile_init(boot_start);
+    uint32_t boot_phase = cosmos_boot_phase_begin_at("kmain", boot_start);
+    cosmos_boot_phase_end(cosmos_boot_phase_begin_at("phase1.simd", boot_start));
+
     // Initialize serial port (115200 baud, 8N1)
+    uint32_t serial_phase = cosmos_boot_phase_begin("phase1.serial");
     __cosmos_serial_init();
+    cosmos_boot_phase_end(serial_phase);
 
     // === Boot Banner ===
     __cosmos_serial_write("\n");
@@ -27,44 +40,81 @@ void kmain()
 
     // === Phase 1: CPU Initialization ===
     __cosmos_serial_write("[KMAIN] Phase 1: CPU initialization\n");
+    uint32_t phase = cosmos_boot_phase_begin("phase1.cpu");
 
 #ifdef __aarch64__
-    __cosmos_serial_write("[KMAIN]   - Disabling alignment check (SCTLR_EL1.A)...\n");
+    COSMOS_LOG_DEBUG("[KMAIN]   - Disabling alignment check (SCTLR_EL1.A)...\n");
     _native_arm64_disable_alignment_check();
-    __cosmos_serial_write("[KMAIN]   - Alignment check disabled\n");
+    COSMOS_LOG_DEBUG("[KMAIN]   - Alignment check disabled\n");
 #endif
 
+    // Publish g_cpuFeatures before managed startup (Phase 3) runs any code
+    // that picks an ISA path; the serial driver above only uses baseline ones.
+    if (cosmos_cpu_features_init() != 0)
+    {
+        __cosmos_serial_write("[KMAIN] ERROR: CPU does not support the kernel's instruction set\n");
+        while(1) {}
+    }
+
+    cosmos_boot_phase_end(phase);
+
     // === Phase 2: Platform-specific early init ===
     __cosmos_serial_write("\n");
     __cosmos_serial_write("[KMAIN] Phase 2: Platform initialization\n");
+    phase = cosmos_boot_phase_begin("phase2.platform");
 
-    __cosmos_serial_write("[KMAIN]   - Querying Limine for RSDP...\n");
+    COSMOS_LOG_DEBUG("[KMAIN]   - Querying Limine for RSDP...\n");
     void* rsdp_address = __get_limine_rsdp_address();
     uint64_t hhdm_offset = __get_limine_hhdm_offset();
 
     if (rsdp_address != 0)
     {
-        __cosmos_serial_write("[KMAIN]   - RSDP found at: 0x");
-        __cosmos_serial_write_hex_u64((uint64_t)rsdp_address);
-        __cosmos_serial_write("\n");
-        __cosmos_serial_write("[KMAIN]   - HHDM offset: 0x");
-        __cosmos_serial_write_hex_u64(hhdm_offset);
-        __cosmos_serial_write("\n");
-
-        __cosmos_serial_write("[KMAIN]   - Initializing ACPI...\n");
+        COSMOS_LOG_INFO("[KMAIN]   - RSDP found at: %p\n", rsdp_address);
+        COSMOS_LOG_INFO("[KMAIN]   - HHDM offset: 0x%lx\n", hhdm_offset);
+
+        COSMOS_LOG_DEBUG("[KMAIN]   - Initializing ACPI...\n");
+        uint32_t acpi_phase = cosmos_boot_phase_begin("phase2.acpi");
         acpi_early_init(rsdp_address, hhdm_offset);
-        __cosmos_serial_write("[KMAIN]   - ACPI initialized\n");
+        cosmos_boot_phase_end(acpi_phase);
+        COSMOS_LOG_INFO("[KMAIN]   - ACPI initialized\n");
     }
     else
     {
-        __cosmos_serial_write("[KMAIN]   - WARNING: RSDP not found!\n");
+        COSMOS_LOG_WARN("[KMAIN]   - WARNING: RSDP not found!\n");
     }
 
+    // Before Phase 3, so heap and GC knobs are in place when managed startup
+    // first reads them.
+    uint32_t knobs_phase = cosmos_boot_phase_begin("phase2.knobs");
+    cosmos_knobs_init(__get_limine_cmd_line());
+    cosmos_boot_phase_end(knobs_phase);
+
+    cosmos_boot_phase_end(phase);
+
+    // === Phase 2.5: Application processors ===
+    // All APs are released at once and run their per-CPU setup in parallel,
+    // then park until SchedulerManager hands them work (smp.h).
+    __cosmos_serial_write("\n");
+    __cosmos_serial_write("[KMAIN] Phase 2.5: Application processors\n");
+    phase = cosmos_boot_phase_begin("phase2.smp");
+    cosmos_smp_init();
+    cosmos_boot_phase_end(phase);
+
+    // Managed startup writes to the UART directly from here on; put the
+    // queued native messages out ahead of it so boot output stays in order.
+    cosmos_log_flush();
+
     // === Phase 3: Managed Kernel Initialization ===
     __cosmos_serial_write("\n");
     __cosmos_serial_write("[KMAIN] Phase 3: Managed kernel initialization\n");
+    phase = cosmos_boot_phase_begin("phase3.managed");
+    uint32_t sub_phase = cosmos_boot_phase_begin("phase3.register_module");
     RhpRegisterOsModule(__kernel_start);
+    cosmos_boot_phase_end(sub_phase);
+    sub_phase = cosmos_boot_phase_begin("phase3.startup");
     __managed__Startup();
+    cosmos_boot_phase_end(sub_phase);
+    cosmos_boot_phase_end(phase);
 
     // === Phase 4: User Kernel ===
     __cosmos_serial_write("\n");
@@ -73,7 +123,14 @@ void kmain()
     int argc;
     char **argv;
 
+    phase = cosmos_boot_phase_begin("phase4.argv");
     argv = __build_argv(__get_limine_cmd_line(), &argc);
+    cosmos_boot_phase_end(phase);
+
+    // Boot-to-Main latency ends here; emit the profile before handing over.
+    cosmos_boot_phase_end(boot_phase);
+    cosmos_boot_profile_dump();
+
     __managed__Main(argc, argv);
 
     // Should never reach here
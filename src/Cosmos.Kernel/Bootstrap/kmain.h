@@ -20,7 +20,7 @@ extern void __managed__Startup(void);
 extern int __managed__Main(int argc, char* argv[]);
 extern void* RhpRegisterOsModule(void* osmodule);
 
-// CPU features (inspected by generated code)
+// CPU features (inspected by generated code, filled by cosmos_cpu_features_init)
 extern int g_cpuFeatures;
 extern int g_requiredCpuFeatures;
 
@@ -39,6 +39,10 @@ extern uint64_t __get_limine_hhdm_offset(void);
 extern char* __get_limine_cmd_line(void);
 extern char** __build_argv(char* input, int* argc);
 
+// Runtime knobs: merge kernel cmdline `knob:Name=Value` overrides into the
+// ILC-embedded table (RhGetKnobValues.c)
+extern void cosmos_knobs_init(const char* cmdline);
+
 // Serial logging (C# functions)
 extern void __cosmos_serial_init(void);
 extern void __cosmos_serial_write(const char* message);
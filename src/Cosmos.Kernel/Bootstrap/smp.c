@@ -0,0 +1,422 @@
+// Application processor bring-up (see smp.h).
+
+#include <stddef.h>
+#include "smp.h"
+#include "boot_profile.h"
+#include "cpu_features.h"
+#include "cosmos_log.h"
+
+// Limine MP response (limine.h). goto_address is the only field the BSP
+// writes after boot; an atomic store to it releases the parked CPU.
+#if defined(__x86_64__)
+typedef struct {
+    uint32_t processor_id;
+    uint32_t lapic_id;
+    uint64_t reserved;
+    void* volatile goto_address;
+    uint64_t extra_argument;        // offset 24, read by _native_ap_entry
+} limine_mp_info_t;
+
+typedef struct {
+    uint64_t revision;
+    uint32_t flags;
+    uint32_t bsp_lapic_id;
+    uint64_t cpu_count;
+    limine_mp_info_t** cpus;
+} limine_mp_response_t;
+#elif defined(__aarch64__)
+typedef struct {
+    uint32_t processor_id;
+    uint32_t reserved1;
+    uint64_t mpidr;
+    uint64_t reserved;
+    void* volatile goto_address;
+    uint64_t extra_argument;        // offset 32, read by _native_ap_entry
+} limine_mp_info_t;
+
+typedef struct {
+    uint64_t revision;
+    uint64_t flags;
+    uint64_t bsp_mpidr;
+    uint64_t cpu_count;
+    limine_mp_info_t** cpus;
+} limine_mp_response_t;
+#endif
+
+// Limine memory map response (limine.h). The bring-up block is carved off the
+// top of a usable entry by shrinking its length in place.
+#define LIMINE_MEMMAP_USABLE 0
+
+typedef struct {
+    uint64_t base;
+    uint64_t length;
+    uint64_t type;
+} limine_memmap_entry_t;
+
+typedef struct {
+    uint64_t revision;
+    uint64_t entry_count;
+    limine_memmap_entry_t** entries;
+} limine_memmap_response_t;
+
+// LimineNative.cs. Only called on the BSP: APs never enter managed code here.
+extern void* __get_limine_mp_response(void);
+extern void* __get_limine_memmap_response(void);
+extern uint64_t __get_limine_hhdm_offset(void);
+
+// ACPI processor count (acpi_wrapper.c): enabled MADT entries on x64, GICC
+// entries on ARM64. Heap-free, so usable before Phase 3.
+extern uint32_t acpi_get_cpu_count(void);
+
+// Boot clock rate in Hz (lai_host.c): the TSC calibrated against the PIT on
+// x64, CNTFRQ_EL0 on ARM64.
+extern uint64_t cosmos_clock_hz(void);
+
+// CPU/SmpEntry.s: switches to cosmos_smp_cpu_t.stack_top, enables SIMD and
+// calls cosmos_smp_ap_main().
+extern void _native_ap_entry(limine_mp_info_t* info);
+
+#if defined(__x86_64__)
+// CPU/SmpEntry.s: lgdt, then reload CS with 0x28 and DS/ES/SS with 0x30.
+extern void _native_ap_load_gdt(const void* gdtr);
+#else
+extern void _native_arm64_disable_alignment_check(void);
+#endif
+
+void cosmos_smp_ap_main(cosmos_smp_cpu_t* cpu) __attribute__((noreturn));
+
+#define SMP_PAGE_SIZE 4096
+
+// Slot 0 until cosmos_smp_init() has sized the table, and the only slot when
+// there are no APs or no memory to bring them up with.
+static cosmos_smp_cpu_t g_smp_bsp;
+static cosmos_smp_cpu_t* g_smp_cpus = &g_smp_bsp;
+static uint32_t g_smp_cpu_count = 1;
+static uint32_t g_smp_online = 1;
+static uint64_t g_smp_hhdm_offset = 0;
+static uint32_t g_smp_percpu_ready = 0;
+
+static inline void smp_cpu_relax(void)
+{
+#if defined(__x86_64__)
+    __asm__ volatile ("pause" ::: "memory");
+#else
+    __asm__ volatile ("wfe" ::: "memory");
+#endif
+}
+
+// Wake APs waiting in smp_cpu_relax() (WFE on ARM64; x64 spins).
+static inline void smp_cpu_wake(void)
+{
+#if defined(__aarch64__)
+    __asm__ volatile ("dsb ish; sev" ::: "memory");
+#endif
+}
+
+// How long the BSP waits for the released APs to park, in boot clock ticks.
+static uint64_t smp_online_timeout_ticks(void)
+{
+    return cosmos_clock_hz();       // 1 s
+}
+
+#if defined(__x86_64__)
+#define IA32_GS_BASE            0xC0000101
+#endif
+
+// Record `cpu` in this CPU's per-CPU register (see cosmos_smp_current_cpu()).
+// Runs before anything on the CPU can log.
+static void smp_set_current_cpu(cosmos_smp_cpu_t* cpu)
+{
+#if defined(__x86_64__)
+    uint64_t base = (uint64_t)cpu;
+    __asm__ volatile ("wrmsr" : : "c"(IA32_GS_BASE), "a"((uint32_t)base), "d"((uint32_t)(base >> 32)));
+#else
+    __asm__ volatile ("msr tpidr_el1, %0" : : "r"((uint64_t)cpu->cpu_index));
+#endif
+}
+
+// =============================================================================
+// Per-AP platform setup
+// =============================================================================
+
+#if defined(__x86_64__)
+
+#define IA32_APIC_BASE          0x1B
+#define APIC_BASE_ADDR_MASK     0x000FFFFFFFFFF000ULL
+
+#define LAPIC_TPR               0x80
+#define LAPIC_SVR               0xF0
+#define LAPIC_TIMER_LVT         0x320
+#define LAPIC_LVT_MASKED        0x10000
+#define LAPIC_SVR_ENABLE        0x100
+#define LAPIC_SPURIOUS_VECTOR   0xFF    // LocalApic.SPURIOUS_VECTOR
+
+// Same descriptors and selectors as the GDT Limine loads (null, 16/32/64-bit
+// code and data), so the IDT gates built for the BSP (CS 0x28) work here.
+static const uint64_t g_smp_gdt_template[7] = {
+    0x0000000000000000ULL,
+    0x00009A000000FFFFULL,          // 0x08 16-bit code
+    0x000092000000FFFFULL,          // 0x10 16-bit data
+    0x00CF9A000000FFFFULL,          // 0x18 32-bit code
+    0x00CF92000000FFFFULL,          // 0x20 32-bit data
+    0x00209A0000000000ULL,          // 0x28 64-bit code
+    0x0000920000000000ULL,          // 0x30 64-bit data
+};
+
+static void smp_ap_platform_init(cosmos_smp_cpu_t* cpu)
+{
+    // Per-CPU GDT in kernel memory: Limine's lives in bootloader-reclaimable
+    // pages, and each CPU will need its own TSS descriptor.
+    for (uint32_t i = 0; i < 7; i++)
+        cpu->gdt[i] = g_smp_gdt_template[i];
+
+    struct __attribute__((packed)) {
+        uint16_t limit;
+        uint64_t base;
+    } gdtr = { sizeof(cpu->gdt) - 1, (uint64_t)cpu->gdt };
+    _native_ap_load_gdt(&gdtr);
+
+    uint32_t lo, hi;
+    __asm__ volatile ("rdmsr" : "=a"(lo), "=d"(hi) : "c"(IA32_APIC_BASE));
+    uint64_t apic_base = ((((uint64_t)hi << 32) | lo) & APIC_BASE_ADDR_MASK) + g_smp_hhdm_offset;
+    volatile uint32_t* lapic = (volatile uint32_t*)apic_base;
+
+    // Accept every priority, keep the timer quiet until it is calibrated for
+    // this CPU, and software-enable the APIC so it can receive IPIs.
+    lapic[LAPIC_TPR / 4] = 0;
+    lapic[LAPIC_TIMER_LVT / 4] = LAPIC_LVT_MASKED;
+    lapic[LAPIC_SVR / 4] = LAPIC_SVR_ENABLE | LAPIC_SPURIOUS_VECTOR;
+}
+
+#elif defined(__aarch64__)
+
+#define ID_AA64PFR0_GIC_SHIFT   24
+#define ICC_SRE_EL1_SRE         0x1
+
+static void smp_ap_platform_init(cosmos_smp_cpu_t* cpu)
+{
+    (void)cpu;
+    _native_arm64_disable_alignment_check();
+
+    // GICv3 CPU interface via system registers (no MMIO, so safe before the
+    // GIC driver maps anything). The redistributor is woken on adoption.
+    uint64_t pfr0;
+    __asm__ volatile ("mrs %0, id_aa64pfr0_el1" : "=r"(pfr0));
+    if (((pfr0 >> ID_AA64PFR0_GIC_SHIFT) & 0xF) != 0) {
+        uint64_t sre;
+        __asm__ volatile ("mrs %0, icc_sre_el1" : "=r"(sre));
+        __asm__ volatile ("msr icc_sre_el1, %0; isb" : : "r"(sre | ICC_SRE_EL1_SRE));
+    }
+
+    // EL1 physical and virtual timers off until the scheduler arms them.
+    __asm__ volatile ("msr cntp_ctl_el0, xzr; msr cntv_ctl_el0, xzr; isb");
+}
+
+#endif
+
+// =============================================================================
+// AP side
+// =============================================================================
+
+void cosmos_smp_ap_main(cosmos_smp_cpu_t* cpu)
+{
+    smp_set_current_cpu(cpu);
+    cosmos_cpu_features_init_ap();
+    smp_ap_platform_init(cpu);
+
+    __atomic_fetch_add(&g_smp_online, 1, __ATOMIC_RELEASE);
+
+    for (;;) {
+        __atomic_store_n(&cpu->state, COSMOS_SMP_CPU_PARKED, __ATOMIC_RELEASE);
+
+        cosmos_smp_entry_t entry;
+        while ((entry = __atomic_load_n(&cpu->entry, __ATOMIC_ACQUIRE)) == 0)
+            smp_cpu_relax();
+
+        entry(cpu->cpu_index, cpu->entry_arg);
+
+        __atomic_store_n(&cpu->entry, (cosmos_smp_entry_t)0, __ATOMIC_RELAXED);
+    }
+}
+
+// =============================================================================
+// BSP side
+// =============================================================================
+
+// Carve `slots` zeroed records and `aps` AP stacks off the top of the largest
+// usable memory map entry. This runs before the heap exists; shrinking the
+// entry keeps PageAllocator.InitializeHeap() from handing the pages out again
+// when it reads the map in Phase 3. Returns 0 when no entry is large enough.
+static cosmos_smp_cpu_t* smp_alloc_cpus(uint32_t slots, uint32_t aps)
+{
+    limine_memmap_response_t* map = (limine_memmap_response_t*)__get_limine_memmap_response();
+    if (map == 0)
+        return 0;
+
+    // Stacks first: the block is page aligned and the stack size a multiple
+    // of 16, so the records that follow keep the GDT alignment.
+    uint64_t stacks = (uint64_t)aps * COSMOS_SMP_AP_STACK_SIZE;
+    uint64_t size = stacks + (uint64_t)slots * sizeof(cosmos_smp_cpu_t);
+    size = (size + SMP_PAGE_SIZE - 1) & ~(uint64_t)(SMP_PAGE_SIZE - 1);
+
+    limine_memmap_entry_t* best = 0;
+    for (uint64_t i = 0; i < map->entry_count; i++) {
+        limine_memmap_entry_t* entry = map->entries[i];
+        if (entry->type == LIMINE_MEMMAP_USABLE && entry->length >= size &&
+            (best == 0 || entry->length > best->length))
+            best = entry;
+    }
+    if (best == 0)
+        return 0;
+
+    best->length -= size;
+    uint64_t phys = best->base + best->length;
+#if defined(__x86_64__)
+    uint8_t* block = (uint8_t*)(phys + g_smp_hhdm_offset);
+#else
+    uint8_t* block = (uint8_t*)phys;    // identity mapped, as PageAllocator uses it
+#endif
+
+    cosmos_smp_cpu_t* cpus = (cosmos_smp_cpu_t*)(block + stacks);
+    uint8_t* bytes = (uint8_t*)cpus;
+    for (uint64_t i = 0; i < (uint64_t)slots * sizeof(cosmos_smp_cpu_t); i++)
+        bytes[i] = 0;
+
+    // AP n (slot n) runs on the n-th stack from the bottom of the block.
+    for (uint32_t slot = 1; slot <= aps; slot++)
+        cpus[slot].stack_top = (uint64_t)(block + (uint64_t)slot * COSMOS_SMP_AP_STACK_SIZE);
+    return cpus;
+}
+
+uint32_t cosmos_smp_init(void)
+{
+    g_smp_hhdm_offset = __get_limine_hhdm_offset();
+    limine_mp_response_t* mp = (limine_mp_response_t*)__get_limine_mp_response();
+
+    // One record per CPU the firmware lists or Limine started, whichever is
+    // more, and a stack for every AP Limine can release.
+    uint32_t aps = (mp != 0 && mp->cpu_count > 1) ? (uint32_t)(mp->cpu_count - 1) : 0;
+    uint32_t slots = acpi_get_cpu_count();
+    if (slots < aps + 1)
+        slots = aps + 1;
+
+    if (aps != 0) {
+        cosmos_smp_cpu_t* cpus = smp_alloc_cpus(slots, aps);
+        if (cpus != 0) {
+            g_smp_cpus = cpus;
+        } else {
+            COSMOS_LOG_WARN("[SMP] WARNING: no usable memory for %u AP stack(s), running on the BSP only\n", aps);
+            aps = 0;
+        }
+    }
+
+    cosmos_smp_cpu_t* bsp = &g_smp_cpus[0];
+    bsp->cpu_index = 0;
+    bsp->state = COSMOS_SMP_CPU_RUNNING;
+    smp_set_current_cpu(bsp);
+    __atomic_store_n(&g_smp_percpu_ready, 1, __ATOMIC_RELEASE);
+
+    if (mp == 0 || mp->cpu_count == 0) {
+        COSMOS_LOG_INFO("[SMP] No MP response from Limine, running on the BSP only\n");
+        return 1;
+    }
+
+#if defined(__x86_64__)
+    bsp->hw_id = mp->bsp_lapic_id;
+#else
+    bsp->hw_id = mp->bsp_mpidr;
+#endif
+
+    // Release every AP before waiting on any of them.
+    uint32_t slot = 1;
+    uint32_t skipped = 0;
+    for (uint64_t i = 0; i < mp->cpu_count; i++) {
+        limine_mp_info_t* info = mp->cpus[i];
+#if defined(__x86_64__)
+        uint64_t hw_id = info->lapic_id;
+#else
+        uint64_t hw_id = info->mpidr;
+#endif
+        if (hw_id == bsp->hw_id)
+            continue;
+        // No stack: the block could not be carved, or Limine's list lacks
+        // the BSP's ID.
+        if (slot > aps) {
+            skipped++;
+            continue;
+        }
+
+        cosmos_smp_cpu_t* cpu = &g_smp_cpus[slot];
+        cpu->hw_id = hw_id;
+        cpu->cpu_index = slot;
+        cpu->state = COSMOS_SMP_CPU_STARTING;
+
+        info->extra_argument = (uint64_t)cpu;
+        __atomic_store_n(&info->goto_address, (void*)_native_ap_entry, __ATOMIC_SEQ_CST);
+        slot++;
+    }
+    g_smp_cpu_count = slot;
+    smp_cpu_wake();
+
+    uint64_t start = cosmos_boot_timestamp();
+    uint64_t timeout = smp_online_timeout_ticks();
+    while (__atomic_load_n(&g_smp_online, __ATOMIC_ACQUIRE) < slot &&
+           cosmos_boot_timestamp() - start < timeout)
+        __asm__ volatile ("" ::: "memory");
+
+    uint32_t online = __atomic_load_n(&g_smp_online, __ATOMIC_ACQUIRE);
+    COSMOS_LOG_INFO("[SMP] %u of %u CPU(s) online (MADT lists %u), %lu ticks\n",
+                    online, slot, acpi_get_cpu_count(), cosmos_boot_timestamp() - start);
+    if (online < slot)
+        COSMOS_LOG_WARN("[SMP] WARNING: %u AP(s) did not come online\n", slot - online);
+    if (skipped)
+        COSMOS_LOG_WARN("[SMP] WARNING: %u CPU(s) without a stack left in Limine\n", skipped);
+
+    return online;
+}
+
+uint32_t cosmos_smp_cpu_count(void)
+{
+    return g_smp_cpu_count;
+}
+
+uint32_t cosmos_smp_current_cpu(void)
+{
+    // The BSP's register is set just before the flag, and every AP sets its
+    // own before it can run anything else.
+    if (!__atomic_load_n(&g_smp_percpu_ready, __ATOMIC_ACQUIRE))
+        return 0;
+#if defined(__x86_64__)
+    uint32_t index;
+    __asm__ volatile ("movl %%gs:%c1, %0" : "=r"(index) : "i"(offsetof(cosmos_smp_cpu_t, cpu_index)));
+    return index;
+#else
+    uint64_t index;
+    __asm__ volatile ("mrs %0, tpidr_el1" : "=r"(index));
+    return (uint32_t)index;
+#endif
+}
+
+uint64_t cosmos_smp_hw_id(uint32_t cpu_index)
+{
+    if (cpu_index >= g_smp_cpu_count)
+        return ~0ULL;
+    return g_smp_cpus[cpu_index].hw_id;
+}
+
+int cosmos_smp_ap_start(uint32_t cpu_index, cosmos_smp_entry_t entry, void* arg)
+{
+    if (cpu_index == 0 || cpu_index >= g_smp_cpu_count || entry == 0)
+        return -1;
+
+    cosmos_smp_cpu_t* cpu = &g_smp_cpus[cpu_index];
+    uint32_t expected = COSMOS_SMP_CPU_PARKED;
+    if (!__atomic_compare_exchange_n(&cpu->state, &expected, COSMOS_SMP_CPU_RUNNING,
+                                     0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return -1;
+
+    cpu->entry_arg = arg;
+    __atomic_store_n(&cpu->entry, entry, __ATOMIC_RELEASE);
+    smp_cpu_wake();
+    return 0;
+}
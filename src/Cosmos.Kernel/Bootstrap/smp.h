@@ -0,0 +1,79 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+
+// Application processor bring-up (kmain Phase 2.5). Limine starts every CPU
+// listed by the MP request and parks it in bootloader memory; the BSP
+// releases all of them in one pass by writing each goto_address, so the
+// per-CPU setup below runs on every AP concurrently instead of one INIT-SIPI
+// (or PSCI CPU_ON) round trip after another.
+//
+// Each AP switches to its own kernel stack and then, without touching
+// shared state:
+//   x64:   enables SSE/XSAVE as on the BSP, loads its own GDT (Limine's
+//          selector layout), software-enables its Local APIC and masks the
+//          LAPIC timer;
+//   ARM64: enables FP/SIMD, clears SCTLR_EL1.A, enables the GICv3 system
+//          register interface and disables the EL1 physical timer.
+// It then marks itself online and parks in cosmos_smp_ap_start()'s idle
+// loop with interrupts masked. The IDT/VBAR, the GIC redistributor and a
+// calibrated timer depend on managed state (built in Phase 3), so loading
+// them is left to whatever entry is handed to the CPU later.
+//
+// Nothing hands one over yet: SchedulerManager does not adopt APs (the GC,
+// heap and scheduler locks assume a single CPU runs managed code), so every
+// AP stays parked and only the BSP runs the kernel. cosmos_smp_ap_start() is
+// the hook that adoption will use.
+
+// The per-CPU records and AP stacks have no fixed cap: cosmos_smp_init()
+// sizes them from the MADT/GICC and Limine CPU counts and carves them out of
+// usable memory before the heap exists. The native log rings keep their own
+// limit (COSMOS_LOG_MAX_CPUS); CPUs past it share the last ring.
+#define COSMOS_SMP_AP_STACK_SIZE   (16 * 1024)
+
+#define COSMOS_SMP_CPU_ABSENT  0
+#define COSMOS_SMP_CPU_STARTING 1
+#define COSMOS_SMP_CPU_PARKED  2   // idle loop, waiting for cosmos_smp_ap_start()
+#define COSMOS_SMP_CPU_RUNNING 3   // running the entry handed to it
+
+typedef void (*cosmos_smp_entry_t)(uint32_t cpu_index, void* arg);
+
+// Per-CPU bring-up record. stack_top must stay first: the AP entry stub
+// (CPU/SmpEntry.s) loads it before any C code runs.
+typedef struct {
+    uint64_t stack_top;
+    uint64_t hw_id;                       // x64: LAPIC ID, ARM64: MPIDR_EL1
+    uint32_t cpu_index;                   // 0 = BSP, APs 1..n in Limine order
+    volatile uint32_t state;              // COSMOS_SMP_CPU_*
+    volatile cosmos_smp_entry_t entry;
+    void* volatile entry_arg;
+#if defined(__x86_64__)
+    uint64_t gdt[7] __attribute__((aligned(16)));
+#endif
+} cosmos_smp_cpu_t;
+
+// Release every AP Limine reports and wait (bounded) for them to park.
+// Returns the number of online CPUs, BSP included.
+uint32_t cosmos_smp_init(void);
+
+// CPU slots, BSP included (1 until cosmos_smp_init() has run). An AP that
+// missed the bring-up timeout keeps its slot but cannot be started until it
+// parks.
+uint32_t cosmos_smp_cpu_count(void);
+
+// Hardware ID of CPU `cpu_index` (LAPIC ID / MPIDR_EL1), or ~0 past the last slot.
+uint64_t cosmos_smp_hw_id(uint32_t cpu_index);
+
+// Index of the executing CPU (0 = BSP). Each CPU stores its index in a
+// per-CPU register when it comes up (x64: IA32_GS_BASE points at its
+// cosmos_smp_cpu_t, ARM64: TPIDR_EL1 holds the index); 0 before
+// cosmos_smp_init() has set the BSP's.
+uint32_t cosmos_smp_current_cpu(void);
+
+// Hand a parked AP `entry(cpu_index, arg)`. Returns 0 when the AP accepted
+// it, -1 when `cpu_index` is not a parked AP. If entry returns, the AP
+// parks again.
+int cosmos_smp_ap_start(uint32_t cpu_index, cosmos_smp_entry_t entry, void* arg);
+
+#endif // SMP_H
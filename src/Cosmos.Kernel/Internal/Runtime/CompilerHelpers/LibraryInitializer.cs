@@ -1,4 +1,5 @@
 using Cosmos.Kernel;
+using Cosmos.Kernel.Core;
 using Cosmos.Kernel.Core.CPU;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.Core.Memory;
@@ -7,6 +8,7 @@ using Cosmos.Kernel.Core.Runtime;
 using Cosmos.Kernel.Core.Scheduler;
 using Cosmos.Kernel.Core.Scheduler.Stride;
 using Cosmos.Kernel.HAL;
+using Cosmos.Kernel.HAL.Interfaces;
 
 namespace Internal.Runtime.CompilerHelpers
 {
@@ -33,14 +35,18 @@ namespace Internal.Runtime.CompilerHelpers
             if (InterruptManager.IsEnabled)
             {
                 Serial.WriteString("[KERNEL]   - Initializing exception handlers...\n");
+                uint phase = BootProfile.Begin("startup.exceptions"u8);
                 ExceptionHandler.Initialize();
+                BootProfile.End(phase);
             }
 
             // Initialize Scheduler
             if (SchedulerManager.IsEnabled)
             {
                 Serial.WriteString("[KERNEL]   - Initializing scheduler...\n");
-                InitializeScheduler(initializer.GetCpuCount());
+                uint phase = BootProfile.Begin("startup.scheduler"u8);
+                InitializeScheduler(initializer);
+                BootProfile.End(phase);
             }
 
             // Start scheduler timer for preemptive scheduling (after all init is complete)
@@ -54,8 +60,9 @@ namespace Internal.Runtime.CompilerHelpers
         /// <summary>
         /// Initializes the scheduler subsystem with idle threads for each CPU.
         /// </summary>
-        private static void InitializeScheduler(uint cpuCount)
+        private static void InitializeScheduler(IPlatformInitializer initializer)
         {
+            uint cpuCount = initializer.GetCpuCount();
             Serial.WriteString("[SCHED] Detected ");
             Serial.WriteNumber(cpuCount);
             Serial.WriteString(" CPU(s)\n");
@@ -63,6 +70,14 @@ namespace Internal.Runtime.CompilerHelpers
             // Initialize scheduler manager
             SchedulerManager.Initialize(cpuCount);
 
+            // Record package / core / thread placement for cache-aware load balancing,
+            // and the NUMA node for node-local page allocation
+            for (uint cpu = 0; cpu < cpuCount; cpu++)
+            {
+                initializer.GetCpuTopology(cpu, out uint packageId, out uint coreId, out uint threadId);
+                SchedulerManager.SetCpuTopology(cpu, initializer.GetCpuNode(cpu), packageId, coreId, threadId);
+            }
+
             // Set up stride scheduler
             var scheduler = new StrideScheduler();
             SchedulerManager.SetScheduler(scheduler);
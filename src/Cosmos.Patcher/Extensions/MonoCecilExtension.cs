@@ -1,4 +1,5 @@
 ﻿#if (UNITY_2017_1_OR_NEWER && UNITY_EDITOR) || !UNITY_2017_1_OR_NEWER
+using System.Collections.Concurrent;
 using Cosmos.Patcher.Logging;
 using Mono.Cecil;
 using Mono.Cecil.Cil;
@@ -58,8 +59,9 @@ public static class MonoCecilExtensions
     /// <summary>
     /// A dictionary mapping from AssemblyDefinition objects to their corresponding UpdateInfo objects.
     /// Used to keep track of the updates made to each assembly.
+    /// Concurrent because independent assemblies are patched in parallel.
     /// </summary>
-    public static readonly Dictionary<AssemblyDefinition, UpdateInfo> assemblyUpdateInfo = [];
+    public static readonly ConcurrentDictionary<AssemblyDefinition, UpdateInfo> assemblyUpdateInfo = new();
 
     /// <summary>
     /// Additional search directories for resolving assembly types.
@@ -399,10 +401,7 @@ public static class MonoCecilExtensions
         }
 
         // Add updated attributes, interfaces, fields, properties and methods to the update info
-        if (!assemblyUpdateInfo.TryGetValue(dest.Module.Assembly, out UpdateInfo? updateInfo))
-        {
-            updateInfo = assemblyUpdateInfo[dest.Module.Assembly] = new UpdateInfo();
-        }
+        UpdateInfo updateInfo = assemblyUpdateInfo.GetOrAdd(dest.Module.Assembly, _ => new UpdateInfo());
 
         foreach (CustomAttribute? attribute in clonedAttributes)
         {
@@ -551,7 +550,7 @@ public static class MonoCecilExtensions
             }
 
             // Remove the assembly from the update information collection
-            _ = assemblyUpdateInfo.Remove(assembly);
+            _ = assemblyUpdateInfo.TryRemove(assembly, out _);
         }
     }
 
@@ -1,4 +1,5 @@
 ﻿using System.ComponentModel;
+using System.Diagnostics;
 using Cosmos.Build.API.Enum;
 using Cosmos.Patcher.Logging;
 using Cosmos.Patcher.Patching;
@@ -13,7 +14,7 @@ public sealed class PatchCommand : Command<PatchCommand.Settings>
     {
         [CommandOption("--target <TARGET>")]
         [Description("Path to the target assembly.")]
-        public required string TargetAssembly { get; set; }
+        public string? TargetAssembly { get; set; }
 
         [CommandOption("--target-platform <TARGET-PLATFORM>")]
         [Description("Target platform for the patching process.")]
@@ -26,7 +27,25 @@ public sealed class PatchCommand : Command<PatchCommand.Settings>
 
         [CommandOption("--output <OUTPUT>")]
         [Description("Output path for the patched dll")]
-        public required string OutputPath { get; set; }
+        public string? OutputPath { get; set; }
+
+        [CommandOption("--manifest <MANIFEST>")]
+        [Description("File of '<target>|<output>' lines, one assembly per line, patched in parallel. Replaces --target/--output.")]
+        public string? ManifestPath { get; set; }
+
+        [CommandOption("--jobs <JOBS>")]
+        [Description("Assemblies patched at once (default: processor count).")]
+        [DefaultValue(0)]
+        public int Jobs { get; set; }
+
+        [CommandOption("--no-cache")]
+        [Description("Repatch every assembly even when its inputs are unchanged.")]
+        [DefaultValue(false)]
+        public bool NoCache { get; set; }
+
+        [CommandOption("--timing-report <PATH>")]
+        [Description("Write per-assembly and per-plug patch timings to this file.")]
+        public string? TimingReportPath { get; set; }
 
         [CommandOption("--coverage")]
         [Description("Enable plug-map generation for coverage tracking.")]
@@ -34,14 +53,19 @@ public sealed class PatchCommand : Command<PatchCommand.Settings>
         public bool Coverage { get; set; }
     }
 
+    /// <summary>
+    /// One target assembly and where its patched copy goes.
+    /// </summary>
+    private readonly record struct PatchJob(string Target, string Output);
+
     public override int Execute(CommandContext context, Settings settings)
     {
         ConsoleBuildLogger logger = new();
         logger.Info("Running PatchCommand...");
 
-        if (!File.Exists(settings.TargetAssembly))
+        List<PatchJob>? jobs = ResolveJobs(settings, logger);
+        if (jobs == null)
         {
-            logger.Error($"Error: Target assembly '{settings.TargetAssembly}' not found.");
             return -1;
         }
 
@@ -65,75 +89,224 @@ public sealed class PatchCommand : Command<PatchCommand.Settings>
 
         try
         {
+            PlatformArchitecture targetPlatform = Enum.Parse<PlatformArchitecture>(settings.TargetPlatform.ToUpperInvariant());
+
+            logger.Info("Loaded plug assemblies:");
+            foreach (string plug in plugPaths)
+            {
+                logger.Info($" - {plug}");
+            }
+
+            // Plug hashes are shared by every job's cache key, so hash them once.
+            byte[][]? plugHashes = settings.NoCache ? null : [.. plugPaths.Select(PatchCache.HashFile)];
+
+            long start = Stopwatch.GetTimestamp();
+            AssemblyPatchTiming[] timings = new AssemblyPatchTiming[jobs.Count];
+            ParallelOptions options = new()
+            {
+                MaxDegreeOfParallelism = settings.Jobs > 0 ? settings.Jobs : Environment.ProcessorCount
+            };
+            Parallel.For(0, jobs.Count, options, i =>
+                timings[i] = PatchOne(jobs[i], plugPaths, plugHashes, targetPlatform, settings, logger));
+
+            PatchTimingReport.Log(logger, timings, Stopwatch.GetElapsedTime(start));
+            if (settings.TimingReportPath != null)
+            {
+                PatchTimingReport.Write(settings.TimingReportPath, timings);
+                logger.Info($"Timing report written to {settings.TimingReportPath}");
+            }
+
+            int failed = timings.Count(t => t.Outcome == PatchOutcome.Failed);
+            if (failed > 0)
+            {
+                logger.Error($"Error: {failed} of {jobs.Count} assemblies failed to patch.");
+                return -1;
+            }
+
+            logger.Info("Patching completed successfully.");
+            return 0;
+        }
+        catch (Exception ex)
+        {
+            logger.Error($"Error during patching: {ex}");
+            return -1;
+        }
+    }
+
+    /// <summary>
+    /// Builds the job list from either --manifest or --target/--output, or
+    /// returns null after logging why the arguments are unusable.
+    /// </summary>
+    private static List<PatchJob>? ResolveJobs(Settings settings, ConsoleBuildLogger logger)
+    {
+        if (settings.ManifestPath == null)
+        {
+            if (settings.TargetAssembly == null)
+            {
+                logger.Error("Error: No target specified. Use --target <dll> or --manifest <file>.");
+                return null;
+            }
+
+            if (!File.Exists(settings.TargetAssembly))
+            {
+                logger.Error($"Error: Target assembly '{settings.TargetAssembly}' not found.");
+                return null;
+            }
+
+            string output = settings.OutputPath ??
+                            Path.Combine(
+                                Path.GetDirectoryName(settings.TargetAssembly)!,
+                                Path.GetFileNameWithoutExtension(settings.TargetAssembly) + "_patched.dll");
+            return [new PatchJob(settings.TargetAssembly, output)];
+        }
+
+        if (!File.Exists(settings.ManifestPath))
+        {
+            logger.Error($"Error: Manifest '{settings.ManifestPath}' not found.");
+            return null;
+        }
+
+        List<PatchJob> jobs = [];
+        foreach (string line in File.ReadLines(settings.ManifestPath))
+        {
+            if (string.IsNullOrWhiteSpace(line) || line.TrimStart().StartsWith('#'))
+            {
+                continue;
+            }
+
+            string[] parts = line.Split('|', StringSplitOptions.TrimEntries);
+            if (parts.Length != 2 || parts[0].Length == 0 || parts[1].Length == 0)
+            {
+                logger.Error($"Error: Malformed manifest line '{line}' (expected '<target>|<output>').");
+                return null;
+            }
+
+            if (!File.Exists(parts[0]))
+            {
+                logger.Error($"Error: Target assembly '{parts[0]}' not found.");
+                return null;
+            }
+
+            jobs.Add(new PatchJob(parts[0], parts[1]));
+        }
+
+        if (jobs.Count == 0)
+        {
+            logger.Error($"Error: Manifest '{settings.ManifestPath}' lists no assemblies.");
+            return null;
+        }
+
+        return jobs;
+    }
+
+    /// <summary>
+    /// Patches one target, or skips it when the cache says its output is
+    /// current. Never throws: failures are logged and reported as
+    /// <see cref="PatchOutcome.Failed"/> so the other jobs still finish.
+    /// </summary>
+    private static AssemblyPatchTiming PatchOne(PatchJob job, string[] plugPaths, byte[][]? plugHashes,
+        PlatformArchitecture targetPlatform, Settings settings, ConsoleBuildLogger logger)
+    {
+        string? cacheKey = null;
+        AssemblyDefinition? targetAssembly = null;
+        AssemblyDefinition[] plugAssemblies = [];
+        try
+        {
+            if (plugHashes != null)
+            {
+                cacheKey = PatchCache.ComputeKey(PatchCache.HashFile(job.Target), plugHashes, settings.TargetPlatform, settings.Coverage);
+                if (PatchCache.IsUpToDate(job.Output, cacheKey))
+                {
+                    logger.Info($"Patch cache hit, skipping: {job.Target}");
+                    return new AssemblyPatchTiming(job.Target, PatchOutcome.Cached, TimeSpan.Zero, TimeSpan.Zero, TimeSpan.Zero, []);
+                }
+            }
+
+            long phase = Stopwatch.GetTimestamp();
+
             // Read with symbols to preserve debug info
             var readerParams = new Mono.Cecil.ReaderParameters { ReadSymbols = true };
-            AssemblyDefinition targetAssembly;
             bool hasSymbols = false;
             try
             {
-                targetAssembly = AssemblyDefinition.ReadAssembly(settings.TargetAssembly, readerParams);
+                targetAssembly = AssemblyDefinition.ReadAssembly(job.Target, readerParams);
                 hasSymbols = true;
-                logger.Info($"Loaded target assembly with symbols: {settings.TargetAssembly}");
+                logger.Info($"Loaded target assembly with symbols: {job.Target}");
             }
             catch
             {
                 // Fallback without symbols if PDB not found
-                targetAssembly = AssemblyDefinition.ReadAssembly(settings.TargetAssembly);
-                logger.Info($"Loaded target assembly (no symbols): {settings.TargetAssembly}");
+                targetAssembly = AssemblyDefinition.ReadAssembly(job.Target);
+                logger.Info($"Loaded target assembly (no symbols): {job.Target}");
             }
 
-            AssemblyDefinition[] plugAssemblies = [.. plugPaths.Select(AssemblyDefinition.ReadAssembly)];
-            PlatformArchitecture targetPlatform = Enum.Parse<PlatformArchitecture>(settings.TargetPlatform.ToUpperInvariant());
-
-            logger.Info("Loaded plug assemblies:");
-            foreach (string plug in plugPaths)
-            {
-                logger.Info($" - {plug}");
-            }
+            // Each job reads its own plug definitions: patching edits plug
+            // types (platform-mismatched members are removed) and Cecil's
+            // lazy loading is not thread-safe, so they can't be shared.
+            plugAssemblies = [.. plugPaths.Select(AssemblyDefinition.ReadAssembly)];
+            TimeSpan read = Stopwatch.GetElapsedTime(phase);
 
+            phase = Stopwatch.GetTimestamp();
             PlugPatcher plugPatcher = new(new PlugScanner(logger))
             {
                 CoverageEnabled = settings.Coverage
             };
-
             plugPatcher.PatchAssembly(targetAssembly, targetPlatform, plugAssemblies);
-            string finalPath = settings.OutputPath ??
-                               Path.Combine(
-                                   Path.GetDirectoryName(settings.TargetAssembly)!,
-                                   Path.GetFileNameWithoutExtension(settings.TargetAssembly) + "_patched.dll");
+            TimeSpan patch = Stopwatch.GetElapsedTime(phase);
+
+            phase = Stopwatch.GetTimestamp();
 
             // Write plug map for coverage tracking (plug method → target method)
-            // Only generated when --coverage is passed; uses assembly-specific filename to
-            // avoid overwrites (MSBuild batches one assembly per invocation)
+            // Only generated when --coverage is passed; uses assembly-specific filename so
+            // targets patched in the same run (or in parallel) don't overwrite each other
             if (settings.Coverage && plugPatcher.PlugMappings.Count > 0)
             {
-                string assemblyName = Path.GetFileNameWithoutExtension(settings.TargetAssembly);
+                string assemblyName = Path.GetFileNameWithoutExtension(job.Target);
                 string plugMapPath = Path.Combine(
-                    Path.GetDirectoryName(finalPath) ?? ".",
+                    Path.GetDirectoryName(job.Output) ?? ".",
                     $"plug-map-{assemblyName}.txt");
                 WritePlugMap(plugMapPath, plugPatcher.PlugMappings);
                 logger.Info($"Plug map written: {plugPatcher.PlugMappings.Count} mappings to {plugMapPath}");
             }
 
+            if (cacheKey != null)
+            {
+                PatchCache.Invalidate(job.Output);
+            }
+
             // Write with symbols if we read them
             if (hasSymbols)
             {
                 var writerParams = new Mono.Cecil.WriterParameters { WriteSymbols = true };
-                targetAssembly.Write(finalPath, writerParams);
+                targetAssembly.Write(job.Output, writerParams);
             }
             else
             {
-                targetAssembly.Write(finalPath);
+                targetAssembly.Write(job.Output);
             }
 
-            logger.Info($"Patched assembly saved to: {finalPath}");
-            logger.Info("Patching completed successfully.");
-            return 0;
+            if (cacheKey != null)
+            {
+                PatchCache.Store(job.Output, cacheKey);
+            }
+
+            TimeSpan write = Stopwatch.GetElapsedTime(phase);
+
+            logger.Info($"Patched assembly saved to: {job.Output}");
+            return new AssemblyPatchTiming(job.Target, PatchOutcome.Patched, read, patch, write, plugPatcher.PlugTimings);
         }
         catch (Exception ex)
         {
-            logger.Error($"Error during patching: {ex}");
-            return -1;
+            logger.Error($"Error during patching of '{job.Target}': {ex}");
+            return new AssemblyPatchTiming(job.Target, PatchOutcome.Failed, TimeSpan.Zero, TimeSpan.Zero, TimeSpan.Zero, []);
+        }
+        finally
+        {
+            targetAssembly?.Dispose();
+            foreach (AssemblyDefinition plug in plugAssemblies)
+            {
+                plug.Dispose();
+            }
         }
     }
 
@@ -0,0 +1,83 @@
+using System.Security.Cryptography;
+using System.Text;
+
+namespace Cosmos.Patcher.Patching;
+
+/// <summary>
+/// Persistent per-assembly patch cache. Next to every patched output sits a
+/// <c>.patchhash</c> file holding a SHA-256 over the content of the target and
+/// plug assemblies and the options that shape the output. A target whose key
+/// matches that file, and whose output still exists, is not patched again.
+/// </summary>
+/// <remarks>
+/// Keys are content-based rather than timestamp-based because the patcher's
+/// output is not deterministic (Mono.Cecil writes a fresh MVID), and because
+/// <c>dotnet publish</c> touches timestamps of unchanged inputs.
+/// </remarks>
+public static class PatchCache
+{
+    /// <summary>
+    /// Extension appended to the output path to name its key file.
+    /// </summary>
+    public const string KeyFileExtension = ".patchhash";
+
+    /// <summary>
+    /// Identifies the patcher build itself, so a patcher update invalidates every entry.
+    /// </summary>
+    private static readonly Guid s_patcherVersion = typeof(PatchCache).Assembly.ManifestModule.ModuleVersionId;
+
+    /// <summary>
+    /// Hashes the content of one file.
+    /// </summary>
+    public static byte[] HashFile(string path)
+    {
+        using FileStream stream = File.OpenRead(path);
+        return SHA256.HashData(stream);
+    }
+
+    /// <summary>
+    /// Combines the content hashes of a target and its plugs, plus the patch
+    /// options, into the key its output is cached under. Plug order is kept:
+    /// it decides which plug wins when two patch the same member.
+    /// </summary>
+    public static string ComputeKey(byte[] targetHash, IEnumerable<byte[]> plugHashes, string targetPlatform, bool coverage)
+    {
+        using IncrementalHash hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+        hash.AppendData(s_patcherVersion.ToByteArray());
+        hash.AppendData(Encoding.UTF8.GetBytes(targetPlatform.ToUpperInvariant()));
+        hash.AppendData([coverage ? (byte)1 : (byte)0]);
+        hash.AppendData(targetHash);
+        foreach (byte[] plugHash in plugHashes)
+        {
+            hash.AppendData(plugHash);
+        }
+
+        return Convert.ToHexString(hash.GetHashAndReset());
+    }
+
+    /// <summary>
+    /// True when <paramref name="outputPath"/> exists and was written for <paramref name="key"/>.
+    /// </summary>
+    public static bool IsUpToDate(string outputPath, string key)
+    {
+        string keyPath = outputPath + KeyFileExtension;
+        return File.Exists(outputPath) && File.Exists(keyPath) && File.ReadAllText(keyPath).Trim() == key;
+    }
+
+    /// <summary>
+    /// Drops the entry for <paramref name="outputPath"/>. Call before rewriting the
+    /// output so a write that fails halfway is never mistaken for a cache hit.
+    /// </summary>
+    public static void Invalidate(string outputPath)
+    {
+        File.Delete(outputPath + KeyFileExtension);
+    }
+
+    /// <summary>
+    /// Records that <paramref name="outputPath"/> now holds the output for <paramref name="key"/>.
+    /// </summary>
+    public static void Store(string outputPath, string key)
+    {
+        File.WriteAllText(outputPath + KeyFileExtension, key);
+    }
+}
@@ -0,0 +1,85 @@
+using System.Globalization;
+using Cosmos.Patcher.Logging;
+
+namespace Cosmos.Patcher.Patching;
+
+/// <summary>
+/// What happened to one target assembly during a patch run.
+/// </summary>
+public enum PatchOutcome
+{
+    Patched,
+    Cached,
+    Failed
+}
+
+/// <summary>
+/// Timing of one target assembly: reading it and its plugs, applying the plugs,
+/// and writing the output, plus the per-plug breakdown of the apply step.
+/// </summary>
+public record AssemblyPatchTiming(
+    string TargetAssembly,
+    PatchOutcome Outcome,
+    TimeSpan Read,
+    TimeSpan Patch,
+    TimeSpan Write,
+    IReadOnlyList<PlugTiming> Plugs)
+{
+    public TimeSpan Total => Read + Patch + Write;
+}
+
+/// <summary>
+/// Summarises a patch run in the build log and, on request, as a
+/// tab-separated file listing every assembly and every applied plug.
+/// </summary>
+public static class PatchTimingReport
+{
+    /// <summary>
+    /// How many of the most expensive plugs the log summary lists.
+    /// </summary>
+    public const int SlowestPlugsLogged = 10;
+
+    public static void Log(IBuildLogger log, IReadOnlyList<AssemblyPatchTiming> assemblies, TimeSpan wallTime)
+    {
+        int cached = assemblies.Count(a => a.Outcome == PatchOutcome.Cached);
+        int failed = assemblies.Count(a => a.Outcome == PatchOutcome.Failed);
+        log.Info($"Patch run: {assemblies.Count} assemblies ({cached} cached, {failed} failed) in {FormatMs(wallTime)} ms");
+
+        foreach (AssemblyPatchTiming a in assemblies.OrderByDescending(a => a.Total))
+        {
+            log.Info($" - {Path.GetFileName(a.TargetAssembly)}: {a.Outcome}, {FormatMs(a.Total)} ms " +
+                     $"(read {FormatMs(a.Read)}, patch {FormatMs(a.Patch)}, write {FormatMs(a.Write)})");
+        }
+
+        List<PlugTiming> slowest = [.. assemblies.SelectMany(a => a.Plugs).OrderByDescending(p => p.Elapsed).Take(SlowestPlugsLogged)];
+        if (slowest.Count == 0)
+        {
+            return;
+        }
+
+        log.Info("Most expensive plugs:");
+        foreach (PlugTiming p in slowest)
+        {
+            log.Info($" - {p.PlugType} -> {p.TargetType}: {FormatMs(p.Elapsed)} ms");
+        }
+    }
+
+    public static void Write(string path, IReadOnlyList<AssemblyPatchTiming> assemblies)
+    {
+        using var writer = new StreamWriter(path);
+        writer.WriteLine("# Patch timing report - generated by cosmos.patcher patch");
+        writer.WriteLine("# assembly\tTargetAssembly\tOutcome\tReadMs\tPatchMs\tWriteMs\tTotalMs");
+        writer.WriteLine("# plug\tTargetAssembly\tPlugType\tTargetType\tElapsedMs");
+        foreach (AssemblyPatchTiming a in assemblies)
+        {
+            writer.WriteLine($"assembly\t{a.TargetAssembly}\t{a.Outcome}\t{FormatMs(a.Read)}\t{FormatMs(a.Patch)}\t{FormatMs(a.Write)}\t{FormatMs(a.Total)}");
+            foreach (PlugTiming p in a.Plugs)
+            {
+                writer.WriteLine($"plug\t{a.TargetAssembly}\t{p.PlugType}\t{p.TargetType}\t{FormatMs(p.Elapsed)}");
+            }
+        }
+    }
+
+    private static string FormatMs(TimeSpan elapsed) =>
+        elapsed.TotalMilliseconds.ToString("F2", CultureInfo.InvariantCulture);
+}
@@ -1,3 +1,4 @@
+using System.Diagnostics;
 using Cosmos.Build.API.Enum;
 using Cosmos.Patcher.Debug;
 using Cosmos.Patcher.Extensions;
@@ -18,6 +19,14 @@ public record PlugMapping(
     string TargetType,
     string TargetMethod);
 
+/// <summary>
+/// Records how long applying one plug type to its target type took.
+/// </summary>
+public record PlugTiming(
+    string PlugType,
+    string TargetType,
+    TimeSpan Elapsed);
+
 /// <summary>
 /// The PlugPatcher class is responsible for applying plugs to methods, types, and assemblies.
 /// Orchestrates the patching process using specialized components.
@@ -39,6 +48,11 @@ public sealed partial class PlugPatcher
     /// </summary>
     public bool CoverageEnabled { get; set; }
 
+    /// <summary>
+    /// Time spent applying each plug type during patching, in application order.
+    /// </summary>
+    public List<PlugTiming> PlugTimings { get; } = [];
+
     public PlugPatcher(PlugScanner scanner)
     {
         _log = new ConsoleBuildLogger();
@@ -196,6 +210,7 @@ public sealed partial class PlugPatcher
 
             foreach (TypeDefinition plugType in plugTypes)
             {
+                long start = Stopwatch.GetTimestamp();
                 try
                 {
                     ProcessPlugMembers(targetType, plugType, platformArchitecture);
@@ -205,6 +220,8 @@ public sealed partial class PlugPatcher
                 {
                     _log.Error($"ERROR processing type {targetType.FullName} with plug {plugType.FullName}: {ex}");
                 }
+
+                PlugTimings.Add(new PlugTiming(plugType.FullName, targetType.FullName, Stopwatch.GetElapsedTime(start)));
             }
         }
     }
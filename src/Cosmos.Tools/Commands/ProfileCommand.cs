@@ -0,0 +1,119 @@
+using System.ComponentModel;
+using Cosmos.Tools.Profiling;
+using Spectre.Console;
+using Spectre.Console.Cli;
+
+namespace Cosmos.Tools.Commands;
+
+public class ProfileSettings : CommandSettings
+{
+    [CommandArgument(0, "<capture>")]
+    [Description("Serial capture holding one or more SamplingProfiler.Dump() streams (e.g. `cosmos run --headless > serial.log`)")]
+    public string Capture { get; set; } = string.Empty;
+
+    [CommandOption("-e|--elf")]
+    [Description("Kernel ELF the samples were taken on (output-<arch>/<Kernel>.elf)")]
+    public string? Elf { get; set; }
+
+    [CommandOption("-o|--output")]
+    [Description("Write folded stacks here instead of stdout (input for flamegraph.pl, inferno or speedscope)")]
+    public string? Output { get; set; }
+
+    [CommandOption("--flat")]
+    [Description("Print a flat self/total table instead of folded stacks")]
+    public bool Flat { get; set; }
+
+    [CommandOption("--top <COUNT>")]
+    [Description("Rows of the flat table. Default: 30.")]
+    [DefaultValue(30)]
+    public int Top { get; set; } = 30;
+}
+
+public class ProfileCommand : Command<ProfileSettings>
+{
+    public override int Execute(CommandContext context, ProfileSettings settings)
+    {
+        if (!File.Exists(settings.Capture))
+        {
+            AnsiConsole.MarkupLine($"  [red]Capture not found:[/] {Markup.Escape(settings.Capture)}");
+            return 1;
+        }
+
+        if (settings.Elf is null || !File.Exists(settings.Elf))
+        {
+            AnsiConsole.MarkupLine("  [red]Kernel ELF not found.[/] Pass the image the samples came from with --elf PATH.");
+            return 1;
+        }
+
+        List<ProfileDump> dumps;
+        ElfSymbolTable symbols;
+        try
+        {
+            dumps = ProfileStreamReader.ReadAll(File.ReadAllBytes(settings.Capture));
+            symbols = ElfSymbolTable.Load(settings.Elf);
+        }
+        catch (InvalidDataException ex)
+        {
+            AnsiConsole.MarkupLine($"  [red]{Markup.Escape(ex.Message)}[/]");
+            return 1;
+        }
+
+        if (dumps.Count == 0)
+        {
+            AnsiConsole.MarkupLine("  [red]No profiler stream in the capture.[/] Build with CosmosEnableProfiler=true and call SamplingProfiler.Dump().");
+            return 1;
+        }
+
+        List<ProfileSample> samples = dumps.SelectMany(dump => dump.Samples).ToList();
+        long dropped = dumps.Sum(dump => (long)dump.Dropped);
+
+        if (settings.Flat)
+        {
+            PrintFlat(ProfileReport.Flat(samples, symbols), samples.Count, settings.Top);
+        }
+        else
+        {
+            List<string> folded = ProfileReport.Fold(samples, symbols);
+            if (settings.Output is null)
+            {
+                foreach (string line in folded)
+                {
+                    Console.WriteLine(line);
+                }
+            }
+            else
+            {
+                File.WriteAllLines(settings.Output, folded);
+            }
+        }
+
+        // Keep stdout clean for piping folded stacks; the summary goes to stderr.
+        Console.Error.WriteLine($"{samples.Count} samples from {dumps.Count} dump(s), {dropped} dropped, {symbols.Count} symbols");
+        return 0;
+    }
+
+    private static void PrintFlat(List<FlatProfileEntry> entries, int sampleCount, int top)
+    {
+        var table = new Table().Border(TableBorder.Simple);
+        table.AddColumn(new TableColumn("Self").RightAligned());
+        table.AddColumn(new TableColumn("Self %").RightAligned());
+        table.AddColumn(new TableColumn("Total").RightAligned());
+        table.AddColumn(new TableColumn("Total %").RightAligned());
+        table.AddColumn("Function");
+
+        foreach (FlatProfileEntry entry in entries.Take(top))
+        {
+            table.AddRow(
+                entry.Self.ToString(),
+                Percent(entry.Self, sampleCount),
+                entry.Total.ToString(),
+                Percent(entry.Total, sampleCount),
+                Markup.Escape(entry.Function));
+        }
+
+        AnsiConsole.Write(table);
+    }
+
+    private static string Percent(int count, int total) =>
+        total == 0 ? "-" : $"{100.0 * count / total:0.0}%";
+}
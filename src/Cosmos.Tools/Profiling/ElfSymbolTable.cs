@@ -0,0 +1,149 @@
+using System.Buffers.Binary;
+using System.Text;
+
+namespace Cosmos.Tools.Profiling;
+
+/// <summary>
+/// Function symbols of a linked kernel ELF, for address-to-name lookups.
+/// ILC's map file lists nodes by offset inside its object file, so the
+/// linked image's .symtab, which carries the same ILC symbol names at their
+/// final addresses, is what profiler samples are resolved against.
+/// </summary>
+public sealed class ElfSymbolTable
+{
+    private const uint SectionSymtab = 2;
+    private const int SymbolFunc = 2;
+    private const int SymbolSize = 24;
+
+    private readonly ulong[] _addresses;
+    private readonly ulong[] _ends;
+    private readonly string[] _names;
+
+    public ElfSymbolTable(IEnumerable<(ulong Address, ulong Size, string Name)> symbols)
+    {
+        var sorted = symbols
+            .Where(s => s.Address != 0 && s.Name.Length > 0)
+            .OrderBy(s => s.Address)
+            .ToArray();
+
+        _addresses = new ulong[sorted.Length];
+        _ends = new ulong[sorted.Length];
+        _names = new string[sorted.Length];
+
+        for (int i = 0; i < sorted.Length; i++)
+        {
+            _addresses[i] = sorted[i].Address;
+            _names[i] = sorted[i].Name;
+
+            // A size-less symbol (assembly stubs) extends to the next one.
+            ulong next = i + 1 < sorted.Length ? sorted[i + 1].Address : ulong.MaxValue;
+            _ends[i] = sorted[i].Size != 0 ? sorted[i].Address + sorted[i].Size : next;
+        }
+    }
+
+    public int Count => _names.Length;
+
+    /// <summary>
+    /// Reads the STT_FUNC symbols of a little-endian ELF64 file.
+    /// </summary>
+    /// <exception cref="InvalidDataException">The file is not a little-endian ELF64 image or has no symbol table.</exception>
+    public static ElfSymbolTable Load(string path) => Parse(File.ReadAllBytes(path));
+
+    public static ElfSymbolTable Parse(ReadOnlySpan<byte> elf)
+    {
+        if (elf.Length < 64 || elf[0] != 0x7F || elf[1] != (byte)'E' || elf[2] != (byte)'L' || elf[3] != (byte)'F')
+        {
+            throw new InvalidDataException("Not an ELF file.");
+        }
+
+        if (elf[4] != 2 || elf[5] != 1)
+        {
+            throw new InvalidDataException("Only little-endian ELF64 kernels are supported.");
+        }
+
+        ulong sectionOffset = BinaryPrimitives.ReadUInt64LittleEndian(elf[0x28..]);
+        int sectionEntrySize = BinaryPrimitives.ReadUInt16LittleEndian(elf[0x3A..]);
+        int sectionCount = BinaryPrimitives.ReadUInt16LittleEndian(elf[0x3C..]);
+
+        for (int i = 0; i < sectionCount; i++)
+        {
+            ReadOnlySpan<byte> section = SectionHeader(elf, sectionOffset, sectionEntrySize, i);
+            if (BinaryPrimitives.ReadUInt32LittleEndian(section[4..]) != SectionSymtab)
+            {
+                continue;
+            }
+
+            ReadOnlySpan<byte> symtab = SectionData(elf, section);
+            int stringsIndex = (int)BinaryPrimitives.ReadUInt32LittleEndian(section[0x28..]);
+            ReadOnlySpan<byte> strings = SectionData(elf, SectionHeader(elf, sectionOffset, sectionEntrySize, stringsIndex));
+
+            var symbols = new List<(ulong, ulong, string)>();
+            for (int offset = 0; offset + SymbolSize <= symtab.Length; offset += SymbolSize)
+            {
+                ReadOnlySpan<byte> symbol = symtab.Slice(offset, SymbolSize);
+                if ((symbol[4] & 0xF) != SymbolFunc)
+                {
+                    continue;
+                }
+
+                int nameOffset = (int)BinaryPrimitives.ReadUInt32LittleEndian(symbol);
+                ulong value = BinaryPrimitives.ReadUInt64LittleEndian(symbol[8..]);
+                ulong size = BinaryPrimitives.ReadUInt64LittleEndian(symbol[16..]);
+                symbols.Add((value, size, ReadString(strings, nameOffset)));
+            }
+
+            return new ElfSymbolTable(symbols);
+        }
+
+        throw new InvalidDataException("ELF has no symbol table (stripped kernel?).");
+    }
+
+    /// <summary>
+    /// Name of the function containing <paramref name="address"/>, or null when none does.
+    /// </summary>
+    public string? Lookup(ulong address)
+    {
+        int index = Array.BinarySearch(_addresses, address);
+        if (index < 0)
+        {
+            index = ~index - 1;
+        }
+
+        return index >= 0 && address < _ends[index] ? _names[index] : null;
+    }
+
+    private static ReadOnlySpan<byte> SectionHeader(ReadOnlySpan<byte> elf, ulong tableOffset, int entrySize, int index)
+    {
+        ulong offset = tableOffset + (ulong)index * (ulong)entrySize;
+        if (entrySize < 0x40 || offset + (ulong)entrySize > (ulong)elf.Length)
+        {
+            throw new InvalidDataException($"ELF section header {index} is out of bounds.");
+        }
+
+        return elf.Slice((int)offset, entrySize);
+    }
+
+    private static ReadOnlySpan<byte> SectionData(ReadOnlySpan<byte> elf, ReadOnlySpan<byte> section)
+    {
+        ulong offset = BinaryPrimitives.ReadUInt64LittleEndian(section[0x18..]);
+        ulong size = BinaryPrimitives.ReadUInt64LittleEndian(section[0x20..]);
+        if (offset + size > (ulong)elf.Length)
+        {
+            throw new InvalidDataException("ELF section data is out of bounds.");
+        }
+
+        return elf.Slice((int)offset, (int)size);
+    }
+
+    private static string ReadString(ReadOnlySpan<byte> strings, int offset)
+    {
+        if (offset >= strings.Length)
+        {
+            return string.Empty;
+        }
+
+        ReadOnlySpan<byte> tail = strings[offset..];
+        int length = tail.IndexOf((byte)0);
+        return Encoding.UTF8.GetString(length < 0 ? tail : tail[..length]);
+    }
+}
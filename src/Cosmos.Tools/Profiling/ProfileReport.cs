@@ -0,0 +1,91 @@
+namespace Cosmos.Tools.Profiling;
+
+/// <summary>
+/// One row of a flat profile: samples with the function on top of the stack
+/// (self) and anywhere on it (total).
+/// </summary>
+public sealed record FlatProfileEntry(string Function, int Self, int Total);
+
+/// <summary>
+/// Turns decoded profiler samples into folded stacks (the input format of
+/// flamegraph.pl / speedscope / inferno) and flat self/total tables.
+/// </summary>
+public static class ProfileReport
+{
+    /// <summary>
+    /// Symbolized stack of one sample, outermost caller first. Return addresses
+    /// are looked up one byte back so a call that ends its function (a noreturn
+    /// throw helper, for example) still resolves to the caller.
+    /// </summary>
+    public static string[] Symbolize(ProfileSample sample, ElfSymbolTable symbols)
+    {
+        var stack = new string[sample.Frames.Length];
+        for (int i = 0; i < sample.Frames.Length; i++)
+        {
+            ulong address = sample.Frames[i];
+            ulong lookup = i == 0 ? address : address - 1;
+            stack[sample.Frames.Length - 1 - i] = symbols.Lookup(lookup) ?? $"0x{address:x16}";
+        }
+
+        return stack;
+    }
+
+    /// <summary>
+    /// Folded stacks, one "caller;...;callee count" line per distinct stack,
+    /// most frequent first.
+    /// </summary>
+    public static List<string> Fold(IEnumerable<ProfileSample> samples, ElfSymbolTable symbols)
+    {
+        var counts = new Dictionary<string, int>(StringComparer.Ordinal);
+        foreach (ProfileSample sample in samples)
+        {
+            string key = string.Join(';', Symbolize(sample, symbols));
+            counts[key] = counts.GetValueOrDefault(key) + 1;
+        }
+
+        return counts
+            .OrderByDescending(pair => pair.Value)
+            .ThenBy(pair => pair.Key, StringComparer.Ordinal)
+            .Select(pair => $"{pair.Key} {pair.Value}")
+            .ToList();
+    }
+
+    /// <summary>
+    /// Flat profile sorted by self samples. A function that recurses is counted
+    /// once per sample in its total.
+    /// </summary>
+    public static List<FlatProfileEntry> Flat(IEnumerable<ProfileSample> samples, ElfSymbolTable symbols)
+    {
+        var self = new Dictionary<string, int>(StringComparer.Ordinal);
+        var total = new Dictionary<string, int>(StringComparer.Ordinal);
+        var seen = new HashSet<string>(StringComparer.Ordinal);
+
+        foreach (ProfileSample sample in samples)
+        {
+            string[] stack = Symbolize(sample, symbols);
+            if (stack.Length == 0)
+            {
+                continue;
+            }
+
+            string leaf = stack[^1];
+            self[leaf] = self.GetValueOrDefault(leaf) + 1;
+
+            seen.Clear();
+            foreach (string function in stack)
+            {
+                if (seen.Add(function))
+                {
+                    total[function] = total.GetValueOrDefault(function) + 1;
+                }
+            }
+        }
+
+        return total
+            .Select(pair => new FlatProfileEntry(pair.Key, self.GetValueOrDefault(pair.Key), pair.Value))
+            .OrderByDescending(entry => entry.Self)
+            .ThenByDescending(entry => entry.Total)
+            .ThenBy(entry => entry.Function, StringComparer.Ordinal)
+            .ToList();
+    }
+}
@@ -0,0 +1,163 @@
+namespace Cosmos.Tools.Profiling;
+
+/// <summary>
+/// One profiler sample: the CPU and thread it was taken on and its frames,
+/// interrupted IP first.
+/// </summary>
+public sealed record ProfileSample(int Cpu, uint ThreadId, ulong[] Frames);
+
+/// <summary>
+/// One decoded <c>SamplingProfiler.Dump</c> stream.
+/// </summary>
+public sealed record ProfileDump(string Arch, uint Dropped, IReadOnlyList<ProfileSample> Samples);
+
+/// <summary>
+/// Decodes the binary streams the kernel's SamplingProfiler writes to serial
+/// (layout documented on the kernel side). A serial capture mixes them with
+/// text log lines, so the reader scans for the stream magic and decodes every
+/// dump it finds in order.
+/// </summary>
+public static class ProfileStreamReader
+{
+    public const uint Magic = 0xC05D0F01u;
+    public const uint Trailer = 0xC05D0FFFu;
+    public const ushort Version = 2;
+
+    private const int HeaderSize = 24;
+
+    /// <summary>
+    /// Decodes every dump in <paramref name="capture"/>. A dump cut off before its
+    /// trailer (QEMU killed mid-stream) is returned with the samples read so far.
+    /// </summary>
+    /// <exception cref="InvalidDataException">A dump has an unsupported version or is corrupt.</exception>
+    public static List<ProfileDump> ReadAll(ReadOnlySpan<byte> capture)
+    {
+        var dumps = new List<ProfileDump>();
+        int offset = 0;
+
+        while (true)
+        {
+            int start = IndexOfMagic(capture, offset);
+            if (start < 0 || capture.Length - start < HeaderSize)
+            {
+                return dumps;
+            }
+
+            dumps.Add(ReadDump(capture, start, out offset));
+        }
+    }
+
+    private static ProfileDump ReadDump(ReadOnlySpan<byte> capture, int start, out int end)
+    {
+        int pos = start + 4;
+        ushort version = ReadUInt16(capture, ref pos);
+        if (version != Version)
+        {
+            throw new InvalidDataException($"Unsupported profile stream version {version} at offset {start}.");
+        }
+
+        string arch = ReadUInt16(capture, ref pos) switch
+        {
+            1 => "x64",
+            2 => "arm64",
+            ushort other => throw new InvalidDataException($"Unknown profile stream architecture {other} at offset {start}."),
+        };
+        ulong addressBase = ReadUInt64(capture, ref pos);
+        uint count = ReadUInt32(capture, ref pos);
+        uint dropped = ReadUInt32(capture, ref pos);
+
+        var samples = new List<ProfileSample>((int)Math.Min(count, 1u << 16));
+        for (uint i = 0; i < count; i++)
+        {
+            if (capture.Length - pos < 2)
+            {
+                end = capture.Length;
+                return new ProfileDump(arch, dropped, samples);
+            }
+
+            int cpu = capture[pos++];
+            int depth = capture[pos++];
+            if (!TryReadVarint(capture, ref pos, out ulong threadId))
+            {
+                end = capture.Length;
+                return new ProfileDump(arch, dropped, samples);
+            }
+
+            var frames = new ulong[depth];
+            for (int f = 0; f < depth; f++)
+            {
+                if (!TryReadVarint(capture, ref pos, out ulong zigzag))
+                {
+                    end = capture.Length;
+                    return new ProfileDump(arch, dropped, samples);
+                }
+
+                long offset = (long)(zigzag >> 1) ^ -(long)(zigzag & 1);
+                frames[f] = unchecked(addressBase + (ulong)offset);
+            }
+
+            samples.Add(new ProfileSample(cpu, (uint)threadId, frames));
+        }
+
+        if (capture.Length - pos >= 4)
+        {
+            int trailerPos = pos;
+            if (ReadUInt32(capture, ref trailerPos) != Trailer)
+            {
+                throw new InvalidDataException($"Profile stream at offset {start} is corrupt: trailer missing after {count} samples.");
+            }
+
+            pos = trailerPos;
+        }
+
+        end = pos;
+        return new ProfileDump(arch, dropped, samples);
+    }
+
+    private static int IndexOfMagic(ReadOnlySpan<byte> capture, int offset)
+    {
+        ReadOnlySpan<byte> magic = [0x01, 0x0F, 0x5D, 0xC0];
+        int index = capture[offset..].IndexOf(magic);
+        return index < 0 ? -1 : offset + index;
+    }
+
+    private static bool TryReadVarint(ReadOnlySpan<byte> data, ref int pos, out ulong value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos >= data.Length)
+            {
+                return false;
+            }
+
+            byte b = data[pos++];
+            value |= (ulong)(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+
+        throw new InvalidDataException($"Profile stream varint at offset {pos} is longer than 64 bits.");
+    }
+
+    private static ushort ReadUInt16(ReadOnlySpan<byte> data, ref int pos)
+    {
+        ushort value = (ushort)(data[pos] | data[pos + 1] << 8);
+        pos += 2;
+        return value;
+    }
+
+    private static uint ReadUInt32(ReadOnlySpan<byte> data, ref int pos)
+    {
+        uint value = ReadUInt16(data, ref pos);
+        return value | (uint)ReadUInt16(data, ref pos) << 16;
+    }
+
+    private static ulong ReadUInt64(ReadOnlySpan<byte> data, ref int pos)
+    {
+        ulong value = ReadUInt32(data, ref pos);
+        return value | (ulong)ReadUInt32(data, ref pos) << 32;
+    }
+}
@@ -33,6 +33,9 @@ class Program
             config.AddCommand<RunCommand>("run")
                 .WithDescription("Boot a built kernel ISO in QEMU");
 
+            config.AddCommand<ProfileCommand>("profile")
+                .WithDescription("Symbolize a kernel profiler capture into folded stacks or a flat profile");
+
             config.AddCommand<InfoCommand>("info")
                 .WithDescription("Show platform and environment information");
 
@@ -0,0 +1,119 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text.Json;
+
+namespace Cosmos.TestRunner.Engine;
+
+/// <summary>
+/// One benchmark the kernel reported through a <c>BenchmarkResult</c> frame
+/// (see Cosmos.TestRunner.Framework/Benchmark.cs). Statistics are clock ticks
+/// per sample; a sample covers <see cref="OpsPerSample"/> operations.
+/// </summary>
+public sealed record BenchmarkRecord(
+    string Name,
+    uint Samples,
+    uint OpsPerSample,
+    ulong ClockHz,
+    ulong Min,
+    ulong P50,
+    ulong P90,
+    ulong P99,
+    ulong Max,
+    ulong Mean)
+{
+    /// <summary>
+    /// Converts a per-sample statistic to nanoseconds per operation, or returns
+    /// null when the clock frequency is unknown.
+    /// </summary>
+    public double? NsPerOp(ulong ticks) => ClockHz == 0 || OpsPerSample == 0
+        ? null
+        : ticks * 1e9 / ClockHz / OpsPerSample;
+
+    /// <summary>Operations per second at the median, or null when the clock frequency is unknown.</summary>
+    public double? OpsPerSecond => NsPerOp(P50) is double ns && ns > 0 ? 1e9 / ns : null;
+}
+
+/// <summary>
+/// Median cost of one benchmark in a baseline and the current run, normalized
+/// to nanoseconds per operation so baselines survive a different clock rate.
+/// </summary>
+public record BenchmarkDelta(string Name, double? BaselineNs, double? CurrentNs)
+{
+    /// <summary>Relative change in percent, or null when either side is missing or the baseline is zero.</summary>
+    public double? ChangePercent => BaselineNs is double b && CurrentNs is double c && b > 0
+        ? (c - b) * 100.0 / b
+        : null;
+
+    /// <summary>True when the benchmark got slower than the baseline by more than <paramref name="thresholdPercent"/>.</summary>
+    public bool IsRegression(double thresholdPercent) => ChangePercent is double pct && pct > thresholdPercent;
+}
+
+/// <summary>
+/// Saves benchmark runs as JSON and diffs a run against a saved one.
+/// </summary>
+public static class BenchmarkBaseline
+{
+    private static readonly JsonSerializerOptions JsonOpts = new()
+    {
+        WriteIndented = true,
+        PropertyNamingPolicy = JsonNamingPolicy.CamelCase
+    };
+
+    public static void Save(string path, IReadOnlyList<BenchmarkRecord> records)
+    {
+        File.WriteAllText(path, JsonSerializer.Serialize(records, JsonOpts));
+    }
+
+    /// <exception cref="InvalidDataException">The file is not a saved benchmark run.</exception>
+    public static List<BenchmarkRecord> Load(string path)
+    {
+        try
+        {
+            return JsonSerializer.Deserialize<List<BenchmarkRecord>>(File.ReadAllText(path), JsonOpts)
+                ?? new List<BenchmarkRecord>();
+        }
+        catch (JsonException ex)
+        {
+            throw new InvalidDataException($"{path} is not a saved benchmark run: {ex.Message}", ex);
+        }
+    }
+
+    /// <summary>
+    /// Per-benchmark comparison of medians. The median rather than the mean is
+    /// compared because a timer tick or a host hiccup landing in one sample
+    /// moves the mean but not the median. Benchmarks missing from either side
+    /// are reported with a null counterpart.
+    /// </summary>
+    public static List<BenchmarkDelta> Compare(IReadOnlyList<BenchmarkRecord> current, IReadOnlyList<BenchmarkRecord> baseline)
+    {
+        var baselineByName = new Dictionary<string, BenchmarkRecord>(StringComparer.Ordinal);
+        foreach (BenchmarkRecord record in baseline)
+        {
+            baselineByName[record.Name] = record;
+        }
+
+        List<BenchmarkDelta> deltas = new();
+        HashSet<string> seen = new(StringComparer.Ordinal);
+        foreach (BenchmarkRecord record in current)
+        {
+            if (!seen.Add(record.Name))
+            {
+                continue;
+            }
+
+            double? baselineNs = baselineByName.TryGetValue(record.Name, out BenchmarkRecord? b) ? b.NsPerOp(b.P50) : null;
+            deltas.Add(new BenchmarkDelta(record.Name, baselineNs, record.NsPerOp(record.P50)));
+        }
+
+        foreach (BenchmarkRecord record in baseline)
+        {
+            if (seen.Add(record.Name))
+            {
+                deltas.Add(new BenchmarkDelta(record.Name, record.NsPerOp(record.P50), null));
+            }
+        }
+
+        return deltas;
+    }
+}
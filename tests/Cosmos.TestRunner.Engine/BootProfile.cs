@@ -0,0 +1,104 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text;
+
+namespace Cosmos.TestRunner.Engine;
+
+/// <summary>
+/// Boot timing profile the kernel dumps as <c>[BOOTPROF]</c> lines right before
+/// <c>Main</c> (see Cosmos.Kernel/Bootstrap/boot_profile.c).
+/// </summary>
+public class BootProfile
+{
+    /// <summary>Line prefix every boot profile record starts with.</summary>
+    public const string LinePrefix = "[BOOTPROF]";
+
+    public string Architecture { get; set; } = string.Empty;
+
+    /// <summary>Counter source: <c>tsc</c> (x64) or <c>cntvct</c> (ARM64).</summary>
+    public string Clock { get; set; } = string.Empty;
+
+    /// <summary>Counter frequency in ticks per second, or 0 when the kernel could not determine it.</summary>
+    public ulong ClockHz { get; set; }
+
+    /// <summary>Ticks from kmain entry to the dump (boot-to-Main latency).</summary>
+    public ulong TotalTicks { get; set; }
+
+    /// <summary>Phases the kernel could not record because its table was full.</summary>
+    public int Dropped { get; set; }
+
+    public List<BootProfileEntry> Entries { get; set; } = new();
+
+    /// <summary>True once the closing <c>end</c> record was seen.</summary>
+    public bool Complete { get; set; }
+
+    /// <summary>
+    /// Converts ticks to milliseconds, or returns null when the clock frequency is unknown.
+    /// </summary>
+    public double? TicksToMs(ulong ticks) => ClockHz == 0 ? null : ticks * 1000.0 / ClockHz;
+
+    public BootProfileEntry? Find(string name) => Entries.Find(e => e.Name == name);
+
+    /// <summary>
+    /// Serializes back to the kernel's wire format so a saved profile can be
+    /// reloaded with <see cref="Protocol.BootProfileParser"/> as a baseline.
+    /// </summary>
+    public string ToText()
+    {
+        StringBuilder sb = new();
+        sb.Append(CultureInfo.InvariantCulture,
+            $"{LinePrefix} begin v=1 arch={Architecture} clock={Clock} hz={ClockHz} entries={Entries.Count} dropped={Dropped}\n");
+        foreach (BootProfileEntry e in Entries)
+        {
+            sb.Append(CultureInfo.InvariantCulture, $"{LinePrefix} phase {e.Depth} {e.Name} {e.StartTicks} {e.DurationTicks}\n");
+        }
+        sb.Append(CultureInfo.InvariantCulture, $"{LinePrefix} end total={TotalTicks}\n");
+        return sb.ToString();
+    }
+
+    /// <summary>
+    /// Per-phase comparison against a baseline profile. Phases missing from
+    /// either side are reported with a null counterpart.
+    /// </summary>
+    public List<BootProfileDelta> CompareTo(BootProfile baseline)
+    {
+        List<BootProfileDelta> deltas = new();
+        HashSet<string> seen = new();
+
+        deltas.Add(new BootProfileDelta("total", baseline.TotalTicks, TotalTicks));
+        foreach (BootProfileEntry e in Entries)
+        {
+            if (!seen.Add(e.Name))
+            {
+                continue;
+            }
+            deltas.Add(new BootProfileDelta(e.Name, baseline.Find(e.Name)?.DurationTicks, e.DurationTicks));
+        }
+        foreach (BootProfileEntry e in baseline.Entries)
+        {
+            if (seen.Add(e.Name))
+            {
+                deltas.Add(new BootProfileDelta(e.Name, e.DurationTicks, null));
+            }
+        }
+
+        return deltas;
+    }
+}
+
+/// <summary>
+/// One recorded boot phase. Start is relative to kmain entry; depth is the nesting level.
+/// </summary>
+public record BootProfileEntry(int Depth, string Name, ulong StartTicks, ulong DurationTicks);
+
+/// <summary>
+/// Phase duration in a baseline and the current profile.
+/// </summary>
+public record BootProfileDelta(string Name, ulong? BaselineTicks, ulong? CurrentTicks)
+{
+    /// <summary>Relative change in percent, or null when either side is missing or the baseline is zero.</summary>
+    public double? ChangePercent => BaselineTicks is ulong b && CurrentTicks is ulong c && b != 0
+        ? ((double)c - b) * 100.0 / b
+        : null;
+}
@@ -150,6 +150,16 @@ public partial class Engine
                 ReportCoverage(results);
             }
 
+            if (results.BootProfile != null)
+            {
+                ReportBootProfile(results.BootProfile);
+            }
+
+            if (results.Benchmarks.Count > 0)
+            {
+                ReportBenchmarks(results);
+            }
+
             // Notify individual test results
             foreach (var test in results.Tests)
             {
@@ -398,6 +408,13 @@ public partial class Engine
         aggregate.ExpectedTestCount += profileResults.ExpectedTestCount;
         aggregate.UartLog += profileResults.UartLog;
         aggregate.CoverageHitMethodIds.AddRange(profileResults.CoverageHitMethodIds);
+        // Boot timing is only comparable between identical QEMU setups, so the
+        // first profile's measurement stands for the suite.
+        aggregate.BootProfile ??= profileResults.BootProfile;
+        foreach (BenchmarkRecord record in profileResults.Benchmarks)
+        {
+            aggregate.Benchmarks.Add(prefix.Length > 0 ? record with { Name = prefix + record.Name } : record);
+        }
 
         if (profileResults.TimedOut)
         {
@@ -548,6 +565,7 @@ public partial class Engine
         results.TimedOut = qemuResult.TimedOut;
         results.UartLog = qemuResult.UartLog ?? string.Empty;
         results.ErrorMessage = qemuResult.ErrorMessage ?? string.Empty;
+        results.BootProfile = BootProfileParser.Parse(results.UartLog);
 
         // If the suite completed normally (TestSuiteEnd received and validated), all tests ran —
         // no need to synthesise failures for missing tests.
@@ -582,6 +600,131 @@ public partial class Engine
         return results;
     }
 
+    private void ReportBootProfile(BootProfile profile)
+    {
+        double? totalMs = profile.TicksToMs(profile.TotalTicks);
+        Console.WriteLine(totalMs is double ms
+            ? $"[BootProfile] Boot-to-Main: {ms:F3} ms ({profile.TotalTicks} {profile.Clock} ticks, {profile.Entries.Count} phases)"
+            : $"[BootProfile] Boot-to-Main: {profile.TotalTicks} {profile.Clock} ticks ({profile.Entries.Count} phases)");
+        if (!profile.Complete)
+        {
+            Console.WriteLine("[BootProfile] Warning: profile is truncated (no end record)");
+        }
+
+        if (!string.IsNullOrEmpty(_config.BootProfileOutputPath))
+        {
+            File.WriteAllText(_config.BootProfileOutputPath, profile.ToText());
+            Console.WriteLine($"[BootProfile] Saved to {_config.BootProfileOutputPath}");
+        }
+
+        if (string.IsNullOrEmpty(_config.BootProfileBaselinePath))
+        {
+            return;
+        }
+
+        if (!File.Exists(_config.BootProfileBaselinePath))
+        {
+            Console.WriteLine($"[BootProfile] Baseline not found: {_config.BootProfileBaselinePath}");
+            return;
+        }
+
+        BootProfile? baseline = BootProfileParser.Parse(File.ReadAllText(_config.BootProfileBaselinePath));
+        if (baseline == null)
+        {
+            Console.WriteLine($"[BootProfile] Baseline has no [BOOTPROF] records: {_config.BootProfileBaselinePath}");
+            return;
+        }
+
+        if (baseline.Clock != profile.Clock)
+        {
+            Console.WriteLine($"[BootProfile] Baseline clock '{baseline.Clock}' differs from '{profile.Clock}'; skipping comparison");
+            return;
+        }
+
+        Console.WriteLine($"[BootProfile] Comparison against {_config.BootProfileBaselinePath}:");
+        foreach (BootProfileDelta delta in profile.CompareTo(baseline))
+        {
+            string baselineText = delta.BaselineTicks?.ToString() ?? "-";
+            string currentText = delta.CurrentTicks?.ToString() ?? "-";
+            string changeText = delta.ChangePercent is double pct ? $"{pct:+0.0;-0.0;0.0}%" : "n/a";
+            Console.WriteLine($"[BootProfile]   {delta.Name,-28} {baselineText,14} -> {currentText,14}  {changeText}");
+        }
+    }
+
+    private void ReportBenchmarks(TestResults results)
+    {
+        Console.WriteLine($"[Benchmark] {results.Benchmarks.Count} benchmarks (ns/op):");
+        Console.WriteLine($"[Benchmark]   {"name",-36} {"min",12} {"p50",12} {"p90",12} {"p99",12} {"max",12} {"ops/s",14}");
+        foreach (BenchmarkRecord r in results.Benchmarks)
+        {
+            Console.WriteLine($"[Benchmark]   {r.Name,-36} {FormatNs(r.NsPerOp(r.Min)),12} {FormatNs(r.NsPerOp(r.P50)),12} " +
+                              $"{FormatNs(r.NsPerOp(r.P90)),12} {FormatNs(r.NsPerOp(r.P99)),12} {FormatNs(r.NsPerOp(r.Max)),12} " +
+                              $"{(r.OpsPerSecond is double ops ? ops.ToString("F0") : "-"),14}");
+        }
+
+        if (!string.IsNullOrEmpty(_config.BenchmarkOutputPath))
+        {
+            BenchmarkBaseline.Save(_config.BenchmarkOutputPath, results.Benchmarks);
+            Console.WriteLine($"[Benchmark] Saved to {_config.BenchmarkOutputPath}");
+        }
+
+        if (string.IsNullOrEmpty(_config.BenchmarkBaselinePath))
+        {
+            return;
+        }
+
+        if (!File.Exists(_config.BenchmarkBaselinePath))
+        {
+            Console.WriteLine($"[Benchmark] Baseline not found: {_config.BenchmarkBaselinePath}");
+            return;
+        }
+
+        List<BenchmarkRecord> baseline;
+        try
+        {
+            baseline = BenchmarkBaseline.Load(_config.BenchmarkBaselinePath);
+        }
+        catch (InvalidDataException ex)
+        {
+            Console.WriteLine($"[Benchmark] {ex.Message}");
+            return;
+        }
+
+        double threshold = _config.BenchmarkRegressionThresholdPercent;
+        Console.WriteLine($"[Benchmark] Comparison against {_config.BenchmarkBaselinePath} (threshold +{threshold:0.#}%):");
+        foreach (BenchmarkDelta delta in BenchmarkBaseline.Compare(results.Benchmarks, baseline))
+        {
+            string changeText = delta.ChangePercent is double pct ? $"{pct:+0.0;-0.0;0.0}%" : "n/a";
+            bool regressed = delta.IsRegression(threshold);
+            Console.WriteLine($"[Benchmark]   {delta.Name,-36} {FormatNs(delta.BaselineNs),12} -> {FormatNs(delta.CurrentNs),12}  {changeText}{(regressed ? "  REGRESSION" : "")}");
+
+            // A regression is reported as a failed test so it reddens the run
+            // and lands in the JUnit output next to the functional results.
+            if (regressed)
+            {
+                results.Tests.Add(new TestResult
+                {
+                    TestNumber = results.Tests.Count + 1,
+                    TestName = $"Benchmark_Regression: {delta.Name}",
+                    Status = TestStatus.Failed,
+                    ErrorMessage = $"median {FormatNs(delta.CurrentNs)} ns/op vs baseline {FormatNs(delta.BaselineNs)} ns/op ({changeText}, threshold +{threshold:0.#}%)"
+                });
+                if (results.ExpectedTestCount > 0)
+                {
+                    results.ExpectedTestCount++;
+                }
+            }
+        }
+    }
+
+    private static string FormatNs(double? ns) => ns switch
+    {
+        null => "-",
+        < 10 => ns.Value.ToString("F2"),
+        < 1000 => ns.Value.ToString("F1"),
+        _ => ns.Value.ToString("F0")
+    };
+
     private void ReportCoverage(TestResults results)
     {
         string? mapPath = FindCoverageMap();
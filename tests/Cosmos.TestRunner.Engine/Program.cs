@@ -1,4 +1,5 @@
 using System;
+using System.Globalization;
 using System.IO;
 using System.Threading.Tasks;
 using Cosmos.TestRunner.Engine;
@@ -23,6 +24,11 @@ class Program
             Console.WriteLine("        ci  = headless, automated, fast");
             Console.WriteLine("        dev = visual display, interactive, debugging");
             Console.WriteLine("  --coverage: Enable code coverage instrumentation");
+            Console.WriteLine("  --boot-profile=<path>: Save the kernel boot profile ([BOOTPROF] records)");
+            Console.WriteLine("  --boot-profile-baseline=<path>: Compare the boot profile against a saved one");
+            Console.WriteLine("  --benchmarks=<path>: Save the benchmark results as JSON");
+            Console.WriteLine("  --benchmark-baseline=<path>: Fail on benchmarks slower than a saved run");
+            Console.WriteLine("  --benchmark-threshold=<percent>: Allowed slowdown against the baseline (default: 10)");
             Console.WriteLine("\nExamples:");
             Console.WriteLine("  Cosmos.TestRunner.Engine tests/Kernels/Cosmos.Kernel.Tests.HelloWorld x64 30");
             Console.WriteLine("  Cosmos.TestRunner.Engine tests/Kernels/Cosmos.Kernel.Tests.HelloWorld x64 30 results.xml ci --coverage");
@@ -31,6 +37,11 @@ class Program
 
         // Check for --coverage flag anywhere in args
         bool coverageEnabled = args.Any(a => a == "--coverage");
+        string bootProfileOutput = GetOptionValue(args, "--boot-profile=");
+        string bootProfileBaseline = GetOptionValue(args, "--boot-profile-baseline=");
+        string benchmarkOutput = GetOptionValue(args, "--benchmarks=");
+        string benchmarkBaseline = GetOptionValue(args, "--benchmark-baseline=");
+        string benchmarkThreshold = GetOptionValue(args, "--benchmark-threshold=");
         var positionalArgs = args.Where(a => !a.StartsWith("--")).ToArray();
 
         string kernelPath = positionalArgs[0];
@@ -60,9 +71,18 @@ class Program
             KeepBuildArtifacts = true, // Keep artifacts for debugging
             XmlOutputPath = xmlOutput,
             Mode = mode,
-            CoverageEnabled = coverageEnabled
+            CoverageEnabled = coverageEnabled,
+            BootProfileOutputPath = bootProfileOutput,
+            BootProfileBaselinePath = bootProfileBaseline,
+            BenchmarkOutputPath = benchmarkOutput,
+            BenchmarkBaselinePath = benchmarkBaseline
         };
 
+        if (!string.IsNullOrEmpty(benchmarkThreshold))
+        {
+            config.BenchmarkRegressionThresholdPercent = double.Parse(benchmarkThreshold, CultureInfo.InvariantCulture);
+        }
+
         if (coverageEnabled)
         {
             Console.WriteLine("📊 Code coverage instrumentation enabled");
@@ -100,4 +120,10 @@ class Program
             return 1;
         }
     }
+
+    private static string GetOptionValue(string[] args, string prefix)
+    {
+        string? arg = args.FirstOrDefault(a => a.StartsWith(prefix, StringComparison.Ordinal));
+        return arg == null ? string.Empty : arg.Substring(prefix.Length);
+    }
 }
@@ -0,0 +1,117 @@
+using System;
+using System.Globalization;
+
+namespace Cosmos.TestRunner.Engine.Protocol;
+
+/// <summary>
+/// Extracts the <c>[BOOTPROF]</c> boot timing records from UART output.
+/// </summary>
+public static class BootProfileParser
+{
+    /// <summary>Number of space-separated fields in a phase record: prefix, "phase", depth, name, start, ticks.</summary>
+    private const int PhaseRecordFields = 6;
+
+    /// <summary>
+    /// Parse the last complete boot profile in <paramref name="uartLog"/>, or the
+    /// last partial one if the kernel never reached the <c>end</c> record.
+    /// Returns null when the log has no profile at all.
+    /// </summary>
+    public static BootProfile? Parse(string uartLog)
+    {
+        if (string.IsNullOrEmpty(uartLog))
+        {
+            return null;
+        }
+
+        BootProfile? current = null;
+        BootProfile? lastComplete = null;
+
+        foreach (string rawLine in uartLog.Split('\n'))
+        {
+            // Protocol frames and IRQ chatter can share a line with the record;
+            // anchor on the prefix rather than the start of the line.
+            int start = rawLine.IndexOf(BootProfile.LinePrefix, StringComparison.Ordinal);
+            if (start < 0)
+            {
+                continue;
+            }
+
+            string[] fields = rawLine.Substring(start).TrimEnd('\r').Split(' ', StringSplitOptions.RemoveEmptyEntries);
+            if (fields.Length < 2)
+            {
+                continue;
+            }
+
+            switch (fields[1])
+            {
+                case "begin":
+                    current = new BootProfile();
+                    ParseHeader(fields, current);
+                    break;
+
+                case "phase":
+                    if (current != null && TryParsePhase(fields, out BootProfileEntry? entry))
+                    {
+                        current.Entries.Add(entry!);
+                    }
+                    break;
+
+                case "end":
+                    if (current != null)
+                    {
+                        current.TotalTicks = ParseULong(GetValue(fields, "total"));
+                        current.Complete = true;
+                        lastComplete = current;
+                        current = null;
+                    }
+                    break;
+            }
+        }
+
+        return lastComplete ?? current;
+    }
+
+    private static void ParseHeader(string[] fields, BootProfile profile)
+    {
+        profile.Architecture = GetValue(fields, "arch") ?? string.Empty;
+        profile.Clock = GetValue(fields, "clock") ?? string.Empty;
+        profile.ClockHz = ParseULong(GetValue(fields, "hz"));
+        profile.Dropped = (int)ParseULong(GetValue(fields, "dropped"));
+    }
+
+    private static bool TryParsePhase(string[] fields, out BootProfileEntry? entry)
+    {
+        entry = null;
+        if (fields.Length < PhaseRecordFields)
+        {
+            return false;
+        }
+
+        if (!int.TryParse(fields[2], NumberStyles.None, CultureInfo.InvariantCulture, out int depth) ||
+            !ulong.TryParse(fields[4], NumberStyles.None, CultureInfo.InvariantCulture, out ulong startTicks) ||
+            !ulong.TryParse(fields[5], NumberStyles.None, CultureInfo.InvariantCulture, out ulong durationTicks))
+        {
+            return false;
+        }
+
+        entry = new BootProfileEntry(depth, fields[3], startTicks, durationTicks);
+        return true;
+    }
+
+    private static string? GetValue(string[] fields, string key)
+    {
+        string prefix = key + "=";
+        foreach (string field in fields)
+        {
+            if (field.StartsWith(prefix, StringComparison.Ordinal))
+            {
+                return field.Substring(prefix.Length);
+            }
+        }
+
+        return null;
+    }
+
+    private static ulong ParseULong(string? value)
+        => ulong.TryParse(value, NumberStyles.None, CultureInfo.InvariantCulture, out ulong result) ? result : 0;
+}
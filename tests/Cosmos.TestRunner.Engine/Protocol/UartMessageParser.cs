@@ -110,7 +110,7 @@ public class UartMessageParser
         byte command = data[offset + CommandOffset];
 
         // Only proceed if this looks like a valid protocol command
-        if (command < Ds2Vs.TestSuiteStart || command > Ds2Vs.TestDestructiveReached)
+        if (command < Ds2Vs.TestSuiteStart || command > Ds2Vs.BenchmarkResult)
         {
             return false;
         }
@@ -177,6 +177,10 @@ public class UartMessageParser
                 // consumed as a valid message; no parsing into TestResults needed.
                 return true;
 
+            case Ds2Vs.BenchmarkResult:
+                ParseBenchmarkResult(payload, results);
+                return true;
+
             default:
                 return false;
         }
@@ -381,6 +385,31 @@ public class UartMessageParser
         }
     }
 
+    private static void ParseBenchmarkResult(byte[] payload, TestResults results)
+    {
+        // Payload: [Samples:4][OpsPerSample:4][ClockHz:8][Min..Mean:8 each][Name:string]
+        if (payload.Length < BenchmarkResultMessage.FixedPayloadBytes)
+        {
+            return;
+        }
+
+        BenchmarkResultMessage message = BenchmarkResultMessage.Deserialize(payload);
+
+        // A name carrying control characters, or statistics out of order, means
+        // the frame was stitched together from interleaved UART bytes; a bogus
+        // record would poison the baseline it gets saved into.
+        if (message.Name.Length == 0 || HasControlChars(message.Name) || message.Samples == 0 ||
+            message.OpsPerSample == 0 || message.Min > message.P50 || message.P50 > message.P90 ||
+            message.P90 > message.P99 || message.P99 > message.Max)
+        {
+            return;
+        }
+
+        results.Benchmarks.Add(new BenchmarkRecord(
+            message.Name, message.Samples, message.OpsPerSample, message.ClockHz,
+            message.Min, message.P50, message.P90, message.P99, message.Max, message.Mean));
+    }
+
     private static TestResult? FindTestResult(TestResults results, int testNumber)
         => results.Tests.Find(t => t.TestNumber == testNumber);
 
@@ -90,4 +90,31 @@ public class TestConfiguration
     /// Passes -p:CosmosCoverage=true to dotnet publish.
     /// </summary>
     public bool CoverageEnabled { get; set; } = false;
+
+    /// <summary>
+    /// Optional path to save the scraped boot profile ([BOOTPROF] records).
+    /// </summary>
+    public string BootProfileOutputPath { get; set; } = string.Empty;
+
+    /// <summary>
+    /// Optional path to a previously saved boot profile to compare against.
+    /// </summary>
+    public string BootProfileBaselinePath { get; set; } = string.Empty;
+
+    /// <summary>
+    /// Optional path to save the benchmark records as JSON.
+    /// </summary>
+    public string BenchmarkOutputPath { get; set; } = string.Empty;
+
+    /// <summary>
+    /// Optional path to a previously saved benchmark run to compare against.
+    /// A benchmark whose median got slower by more than
+    /// <see cref="BenchmarkRegressionThresholdPercent"/> fails the run.
+    /// </summary>
+    public string BenchmarkBaselinePath { get; set; } = string.Empty;
+
+    /// <summary>
+    /// Allowed slowdown of a benchmark median against the baseline, in percent.
+    /// </summary>
+    public double BenchmarkRegressionThresholdPercent { get; set; } = 10.0;
 }
@@ -25,6 +25,18 @@ public class TestResults
     /// </summary>
     public List<ushort> CoverageHitMethodIds { get; set; } = new();
 
+    /// <summary>
+    /// Boot timing profile scraped from the <c>[BOOTPROF]</c> UART records.
+    /// Null if the kernel did not reach Main or predates the boot profile.
+    /// </summary>
+    public BootProfile? BootProfile { get; set; }
+
+    /// <summary>
+    /// Benchmarks the kernel reported through <c>BenchmarkResult</c> frames, in
+    /// the order they ran. Empty for suites that run no benchmarks.
+    /// </summary>
+    public List<BenchmarkRecord> Benchmarks { get; set; } = new();
+
     public int TotalTests => ExpectedTestCount > 0 ? ExpectedTestCount : Tests.Count;
     public int PassedTests => Tests.Count(t => t.Status == TestStatus.Passed);
     public int FailedTests => Tests.Count(t => t.Status == TestStatus.Failed);
@@ -0,0 +1,163 @@
+using System;
+using System.Diagnostics;
+using Cosmos.Kernel.Core.IO;
+
+namespace Cosmos.TestRunner.Framework;
+
+/// <summary>
+/// Distribution of one benchmark's samples, in clock ticks per sample.
+/// </summary>
+public readonly struct BenchmarkStats
+{
+    public uint Samples { get; init; }
+    public uint OpsPerSample { get; init; }
+    public ulong ClockHz { get; init; }
+    public ulong Min { get; init; }
+    public ulong P50 { get; init; }
+    public ulong P90 { get; init; }
+    public ulong P99 { get; init; }
+    public ulong Max { get; init; }
+    public ulong Mean { get; init; }
+}
+
+/// <summary>
+/// Kernel-side micro-benchmark harness. Times samples with the Stopwatch
+/// counter (the TSC on x64, or the HPET when the TSC is not invariant; CNTVCT
+/// on ARM64), sorts them and reports min/p50/p90/p99/max/mean to the engine as
+/// one <c>BenchmarkResult</c> frame, which it can diff against a stored
+/// baseline. Call from inside <see cref="TestRunner.Run"/> so the record is
+/// attributed to a test.
+/// </summary>
+public static class Benchmark
+{
+    /// <summary>Samples run and discarded before measuring, to warm caches, the TLB and lazy allocations.</summary>
+    public const int DefaultWarmup = 8;
+
+    /// <summary>Back-to-back counter reads used to estimate the cost of reading the counter.</summary>
+    private const int OverheadProbes = 16;
+
+    private static ulong s_clockOverhead = ulong.MaxValue;
+
+    /// <summary>Counter frequency in ticks per second.</summary>
+    public static ulong ClockHz => (ulong)Stopwatch.Frequency;
+
+    /// <summary>
+    /// Cost of one counter read pair in ticks, subtracted from every sample
+    /// <see cref="Run"/> takes so short samples are not dominated by it.
+    /// </summary>
+    public static ulong ClockOverhead
+    {
+        get
+        {
+            if (s_clockOverhead == ulong.MaxValue)
+            {
+                ulong best = ulong.MaxValue;
+                for (int i = 0; i < OverheadProbes; i++)
+                {
+                    long t0 = Stopwatch.GetTimestamp();
+                    long t1 = Stopwatch.GetTimestamp();
+                    ulong delta = (ulong)(t1 - t0);
+                    if (delta < best)
+                    {
+                        best = delta;
+                    }
+                }
+                s_clockOverhead = best;
+            }
+            return s_clockOverhead;
+        }
+    }
+
+    /// <summary>
+    /// Runs <paramref name="sample"/> <paramref name="warmup"/> times untimed,
+    /// then <paramref name="samples"/> times timed, and reports the result.
+    /// One call of <paramref name="sample"/> must perform
+    /// <paramref name="opsPerSample"/> operations: batching short operations
+    /// keeps the counter resolution and the delegate call out of the result.
+    /// </summary>
+    public static BenchmarkStats Run(string name, int samples, uint opsPerSample, Action sample, int warmup = DefaultWarmup)
+    {
+        for (int i = 0; i < warmup; i++)
+        {
+            sample();
+        }
+
+        ulong overhead = ClockOverhead;
+        ulong[] ticks = new ulong[samples];
+        for (int i = 0; i < samples; i++)
+        {
+            long t0 = Stopwatch.GetTimestamp();
+            sample();
+            long t1 = Stopwatch.GetTimestamp();
+            ulong delta = (ulong)(t1 - t0);
+            ticks[i] = delta > overhead ? delta - overhead : 0;
+        }
+
+        return Report(name, ticks, samples, opsPerSample);
+    }
+
+    /// <summary>
+    /// Reports samples the caller timed itself, for latencies that start and
+    /// end on different threads or in an interrupt handler. Sorts the first
+    /// <paramref name="count"/> entries of <paramref name="ticks"/> in place.
+    /// </summary>
+    public static BenchmarkStats Report(string name, ulong[] ticks, int count, uint opsPerSample)
+    {
+        if (count <= 0)
+        {
+            Assert.Fail("Benchmark recorded no samples");
+            return default;
+        }
+
+        // Insertion sort: sample counts are small, and it needs no comparer
+        // delegate or generic sort instantiation in the kernel image.
+        ulong sum = 0;
+        for (int i = 0; i < count; i++)
+        {
+            ulong value = ticks[i];
+            sum += value;
+            int j = i - 1;
+            while (j >= 0 && ticks[j] > value)
+            {
+                ticks[j + 1] = ticks[j];
+                j--;
+            }
+            ticks[j + 1] = value;
+        }
+
+        var stats = new BenchmarkStats
+        {
+            Samples = (uint)count,
+            OpsPerSample = opsPerSample,
+            ClockHz = ClockHz,
+            Min = ticks[0],
+            P50 = ticks[PercentileIndex(count, 50)],
+            P90 = ticks[PercentileIndex(count, 90)],
+            P99 = ticks[PercentileIndex(count, 99)],
+            Max = ticks[count - 1],
+            Mean = sum / (ulong)count
+        };
+
+        TestRunner.SendBenchmarkResult(name, stats);
+
+        // Text fallback for reading the UART log by hand.
+        Serial.WriteString("[Benchmark] ");
+        Serial.WriteString(name);
+        Serial.WriteString(" p50=");
+        Serial.WriteNumber(stats.P50);
+        Serial.WriteString(" p99=");
+        Serial.WriteNumber(stats.P99);
+        Serial.WriteString(" ticks/");
+        Serial.WriteNumber(opsPerSample);
+        Serial.WriteString(" ops\n");
+
+        return stats;
+    }
+
+    // Nearest-rank percentile over a sorted sample of `count` entries.
+    private static int PercentileIndex(int count, int percentile)
+    {
+        int rank = (count * percentile + 99) / 100;
+        return rank <= 0 ? 0 : rank - 1;
+    }
+}
@@ -431,6 +431,7 @@ namespace Cosmos.TestRunner.Framework
         private const byte TestSkip = 104;
         private const byte TestSuiteEnd = 105;
         private const byte TestDestructiveReached = 108;
+        private const byte BenchmarkResult = 109;
 
         /// <summary>Byte 0 (least significant) of the protocol magic signature 0x19740807 (SerialSignature from Consts.cs), sent little-endian.</summary>
         private const byte SerialSignatureByte0 = 0x07;
@@ -456,6 +457,8 @@ namespace Cosmos.TestRunner.Framework
         private const int TestPassPayloadSizeBytes = 6;
         /// <summary>Payload size of a TestSuiteEnd message: four little-endian ushort counters (total, passed, failed, skipped).</summary>
         private const int SuiteEndPayloadSizeBytes = 8;
+        /// <summary>Fixed part of a BenchmarkResult payload: two uint counts and seven ulong fields (clock rate, min, p50, p90, p99, max, mean).</summary>
+        private const int BenchmarkFixedPayloadSizeBytes = 4 + 4 + 8 * 7;
 
         /// <summary>
         /// Send a protocol message with format: [MAGIC:4][Command:1][Length:2][Payload:N]
@@ -566,6 +569,37 @@ namespace Cosmos.TestRunner.Framework
             SendMessage(TestDestructiveReached, payload);
         }
 
+        internal static void SendBenchmarkResult(string name, in BenchmarkStats stats)
+        {
+            var nameBytes = EncodeString(name);
+            var payload = new byte[BenchmarkFixedPayloadSizeBytes + nameBytes.Length];
+            WriteUInt32(payload, 0, stats.Samples);
+            WriteUInt32(payload, 4, stats.OpsPerSample);
+            WriteUInt64(payload, 8, stats.ClockHz);
+            WriteUInt64(payload, 16, stats.Min);
+            WriteUInt64(payload, 24, stats.P50);
+            WriteUInt64(payload, 32, stats.P90);
+            WriteUInt64(payload, 40, stats.P99);
+            WriteUInt64(payload, 48, stats.Max);
+            WriteUInt64(payload, 56, stats.Mean);
+            Array.Copy(nameBytes, 0, payload, BenchmarkFixedPayloadSizeBytes, nameBytes.Length);
+            SendMessage(BenchmarkResult, payload);
+        }
+
+        private static void WriteUInt32(byte[] buffer, int offset, uint value)
+        {
+            buffer[offset] = (byte)(value & ByteMask);
+            buffer[offset + 1] = (byte)((value >> Byte1Shift) & ByteMask);
+            buffer[offset + 2] = (byte)((value >> Byte2Shift) & ByteMask);
+            buffer[offset + 3] = (byte)((value >> Byte3Shift) & ByteMask);
+        }
+
+        private static void WriteUInt64(byte[] buffer, int offset, ulong value)
+        {
+            WriteUInt32(buffer, offset, (uint)value);
+            WriteUInt32(buffer, offset + 4, (uint)(value >> 32));
+        }
+
         private static void SendTestSuiteEnd(ushort total, ushort passed, ushort failed, ushort skipped)
         {
             var payload = new byte[SuiteEndPayloadSizeBytes];
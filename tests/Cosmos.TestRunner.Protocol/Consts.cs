@@ -127,6 +127,15 @@ namespace Cosmos.TestRunner.Protocol
         /// (test number).
         /// </summary>
         public const byte TestDestructiveReached = 108;
+
+        /// <summary>
+        /// Sent once per benchmark by the kernel-side Benchmark helper, while the
+        /// test that ran it is still open. Payload: [Samples:4][OpsPerSample:4]
+        /// [ClockHz:8][Min:8][P50:8][P90:8][P99:8][Max:8][Mean:8][Name:string].
+        /// The statistics are clock ticks per sample; divide by OpsPerSample for
+        /// the cost of one operation.
+        /// </summary>
+        public const byte BenchmarkResult = 109;
     }
 
     /// <summary>
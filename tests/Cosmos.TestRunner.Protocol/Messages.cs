@@ -349,6 +349,66 @@ namespace Cosmos.TestRunner.Protocol
         }
     }
 
+    /// <summary>
+    /// Distribution of one benchmark's samples, in clock ticks per sample.
+    /// </summary>
+    public class BenchmarkResultMessage : ProtocolMessage
+    {
+        /// <summary>Size of the fixed fields ahead of the name.</summary>
+        public const int FixedPayloadBytes = 4 + 4 + 8 * 7;
+
+        public override byte Command => Ds2Vs.BenchmarkResult;
+        public string Name { get; set; } = "";
+        public uint Samples { get; set; }
+        public uint OpsPerSample { get; set; }
+        public ulong ClockHz { get; set; }
+        public ulong Min { get; set; }
+        public ulong P50 { get; set; }
+        public ulong P90 { get; set; }
+        public ulong P99 { get; set; }
+        public ulong Max { get; set; }
+        public ulong Mean { get; set; }
+
+        public override byte[] GetPayload()
+        {
+            var nameBytes = Encoding.UTF8.GetBytes(Name);
+            var result = new byte[FixedPayloadBytes + nameBytes.Length];
+            BitConverter.TryWriteBytes(result.AsSpan(0), Samples);
+            BitConverter.TryWriteBytes(result.AsSpan(4), OpsPerSample);
+            BitConverter.TryWriteBytes(result.AsSpan(8), ClockHz);
+            BitConverter.TryWriteBytes(result.AsSpan(16), Min);
+            BitConverter.TryWriteBytes(result.AsSpan(24), P50);
+            BitConverter.TryWriteBytes(result.AsSpan(32), P90);
+            BitConverter.TryWriteBytes(result.AsSpan(40), P99);
+            BitConverter.TryWriteBytes(result.AsSpan(48), Max);
+            BitConverter.TryWriteBytes(result.AsSpan(56), Mean);
+            Array.Copy(nameBytes, 0, result, FixedPayloadBytes, nameBytes.Length);
+            return result;
+        }
+
+        public static BenchmarkResultMessage Deserialize(byte[] payload)
+        {
+            if (payload.Length < FixedPayloadBytes)
+            {
+                throw new ArgumentException("Invalid BenchmarkResult payload length");
+            }
+
+            return new BenchmarkResultMessage
+            {
+                Samples = BitConverter.ToUInt32(payload, 0),
+                OpsPerSample = BitConverter.ToUInt32(payload, 4),
+                ClockHz = BitConverter.ToUInt64(payload, 8),
+                Min = BitConverter.ToUInt64(payload, 16),
+                P50 = BitConverter.ToUInt64(payload, 24),
+                P90 = BitConverter.ToUInt64(payload, 32),
+                P99 = BitConverter.ToUInt64(payload, 40),
+                Max = BitConverter.ToUInt64(payload, 48),
+                Mean = BitConverter.ToUInt64(payload, 56),
+                Name = Encoding.UTF8.GetString(payload, FixedPayloadBytes, payload.Length - FixedPayloadBytes)
+            };
+        }
+    }
+
     /// <summary>
     /// Simple text message (from original CosmosOS protocol)
     /// </summary>
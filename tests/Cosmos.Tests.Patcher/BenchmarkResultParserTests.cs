@@ -0,0 +1,105 @@
+using System.Collections.Generic;
+using System.Text;
+using Cosmos.TestRunner.Engine;
+using Cosmos.TestRunner.Engine.Protocol;
+using Cosmos.TestRunner.Protocol;
+
+namespace Cosmos.Tests.Patcher;
+
+[Collection("PatcherTests")]
+public class BenchmarkResultParserTests
+{
+    /// <summary>Ds2Vs UART frame magic signature.</summary>
+    private static readonly byte[] FrameMagic = [0x07, 0x08, 0x74, 0x19];
+
+    [Fact]
+    public void ParseUartLog_ReadsBenchmarkRecords()
+    {
+        List<byte> stream = new();
+        stream.AddRange(CreateFrame(Ds2Vs.TestSuiteStart, [1, 0, (byte)'B']));
+        stream.AddRange(CreateBenchmarkFrame("MemCopy_4KiB", p50: 2000));
+        stream.AddRange(CreateBenchmarkFrame("GC_Pause", p50: 500000));
+
+        TestResults results = UartMessageParser.ParseUartLog(Encoding.Latin1.GetString(stream.ToArray()), "x64");
+
+        Assert.Equal(2, results.Benchmarks.Count);
+        BenchmarkRecord record = results.Benchmarks[0];
+        Assert.Equal("MemCopy_4KiB", record.Name);
+        Assert.Equal(64u, record.Samples);
+        Assert.Equal(2000UL, record.P50);
+        // 2000 ticks at 1 GHz over 4 ops per sample
+        Assert.Equal(500.0, record.NsPerOp(record.P50));
+        Assert.Equal(2_000_000.0, record.OpsPerSecond);
+    }
+
+    [Fact]
+    public void ParseUartLog_DropsCorruptBenchmarkFrames()
+    {
+        List<byte> stream = new();
+        stream.AddRange(CreateBenchmarkFrame("Bad\u0001Name", p50: 2000));
+        stream.AddRange(CreateBenchmarkFrame("Unordered", p50: 2000, p90: 1000));
+        stream.AddRange(CreateBenchmarkFrame("NoSamples", p50: 2000, samples: 0));
+        stream.AddRange(CreateFrame(Ds2Vs.BenchmarkResult, [1, 2, 3]));
+
+        TestResults results = UartMessageParser.ParseUartLog(Encoding.Latin1.GetString(stream.ToArray()), "x64");
+
+        Assert.Empty(results.Benchmarks);
+    }
+
+    [Fact]
+    public void Compare_FlagsRegressionsAndMissingBenchmarks()
+    {
+        List<BenchmarkRecord> baseline =
+        [
+            Record("MemCopy_4KiB", p50: 2000),
+            Record("Heap_AllocFree_32B", p50: 4000),
+            Record("Removed", p50: 100)
+        ];
+        List<BenchmarkRecord> current =
+        [
+            Record("MemCopy_4KiB", p50: 2100),
+            Record("Heap_AllocFree_32B", p50: 6000),
+            Record("Added", p50: 100)
+        ];
+
+        List<BenchmarkDelta> deltas = BenchmarkBaseline.Compare(current, baseline);
+
+        BenchmarkDelta copy = deltas.Find(d => d.Name == "MemCopy_4KiB")!;
+        Assert.Equal(5.0, copy.ChangePercent!.Value, 6);
+        Assert.False(copy.IsRegression(10.0));
+        Assert.True(deltas.Find(d => d.Name == "Heap_AllocFree_32B")!.IsRegression(10.0));
+        Assert.Null(deltas.Find(d => d.Name == "Removed")!.CurrentNs);
+        Assert.Null(deltas.Find(d => d.Name == "Added")!.BaselineNs);
+    }
+
+    private static BenchmarkRecord Record(string name, ulong p50) =>
+        new(name, 64, 4, 1_000_000_000, p50, p50, p50, p50, p50, p50);
+
+    private static byte[] CreateBenchmarkFrame(string name, ulong p50, ulong? p90 = null, uint samples = 64)
+    {
+        var message = new BenchmarkResultMessage
+        {
+            Name = name,
+            Samples = samples,
+            OpsPerSample = 4,
+            ClockHz = 1_000_000_000,
+            Min = p50 / 2,
+            P50 = p50,
+            P90 = p90 ?? p50,
+            P99 = p50 * 2,
+            Max = p50 * 3,
+            Mean = p50
+        };
+        return CreateFrame(Ds2Vs.BenchmarkResult, message.GetPayload());
+    }
+
+    private static byte[] CreateFrame(byte command, byte[] payload)
+    {
+        List<byte> bytes = new(FrameMagic);
+        bytes.Add(command);
+        bytes.Add((byte)(payload.Length & 0xFF));
+        bytes.Add((byte)((payload.Length >> 8) & 0xFF));
+        bytes.AddRange(payload);
+        return bytes.ToArray();
+    }
+}
@@ -0,0 +1,65 @@
+using System.Collections.Generic;
+using Cosmos.TestRunner.Engine;
+using Cosmos.TestRunner.Engine.Protocol;
+
+namespace Cosmos.Tests.Patcher;
+
+[Collection("PatcherTests")]
+public class BootProfileParserTests
+{
+    private const string SampleProfile =
+        "[KMAIN] Phase 4: User kernel\n" +
+        "[BOOTPROF] begin v=1 arch=x64 clock=tsc hz=2000000000 entries=3 dropped=0\n" +
+        "[BOOTPROF] phase 0 kmain 0 4000000\n" +
+        "[BOOTPROF] phase 1 phase2.acpi 1000 2000000\n" +
+        "[BOOTPROF] phase 2 acpi.madt 2000 500000\n" +
+        "[BOOTPROF] end total=4100000\n" +
+        "Hello from Main\n";
+
+    [Fact]
+    public void Parse_ReadsHeaderPhasesAndTotal()
+    {
+        BootProfile? profile = BootProfileParser.Parse(SampleProfile);
+
+        Assert.NotNull(profile);
+        Assert.True(profile!.Complete);
+        Assert.Equal("x64", profile.Architecture);
+        Assert.Equal("tsc", profile.Clock);
+        Assert.Equal(2000000000UL, profile.ClockHz);
+        Assert.Equal(4100000UL, profile.TotalTicks);
+        Assert.Equal(3, profile.Entries.Count);
+        Assert.Equal(new BootProfileEntry(2, "acpi.madt", 2000, 500000), profile.Entries[2]);
+        Assert.Equal(0.25, profile.TicksToMs(500000));
+    }
+
+    [Fact]
+    public void Parse_SkipsMalformedPhaseLinesAndReturnsNullWithoutProfile()
+    {
+        string log = "[BOOTPROF] begin v=1 arch=arm64 clock=cntvct hz=62500000 entries=2 dropped=0\n" +
+                     "[BOOTPROF] phase 0 kmain 0\n" +
+                     "garbage[BOOTPROF] phase 1 acpi.iort 10 20\r\n" +
+                     "[BOOTPROF] end total=30\n";
+
+        BootProfile? profile = BootProfileParser.Parse(log);
+
+        Assert.NotNull(profile);
+        Assert.Single(profile!.Entries);
+        Assert.Equal("acpi.iort", profile.Entries[0].Name);
+        Assert.Null(BootProfileParser.Parse("no profile here\n"));
+    }
+
+    [Fact]
+    public void ToText_RoundTripsAndCompareToReportsChanges()
+    {
+        BootProfile baseline = BootProfileParser.Parse(SampleProfile)!;
+        BootProfile current = BootProfileParser.Parse(baseline.ToText())!;
+        current.Entries[2] = current.Entries[2] with { DurationTicks = 750000 };
+        current.Entries.Add(new BootProfileEntry(1, "startup.gc", 3000, 100));
+
+        List<BootProfileDelta> deltas = current.CompareTo(baseline);
+
+        Assert.Equal(0.0, deltas.Find(d => d.Name == "total")!.ChangePercent);
+        Assert.Equal(50.0, deltas.Find(d => d.Name == "acpi.madt")!.ChangePercent);
+        Assert.Null(deltas.Find(d => d.Name == "startup.gc")!.BaselineTicks);
+    }
+}
@@ -0,0 +1,66 @@
+using Cosmos.Patcher;
+using Cosmos.Patcher.Patching;
+using Cosmos.Tests.NativeWrapper;
+using Mono.Cecil;
+
+namespace Cosmos.Tests.Patcher;
+
+[Collection("PatcherTests")]
+public class PatchCacheTests
+{
+    private static readonly byte[] TargetHash = [1, 2, 3];
+    private static readonly byte[] PlugAHash = [4, 5];
+    private static readonly byte[] PlugBHash = [6, 7];
+
+    [Fact]
+    public void ComputeKey_ChangesWithEveryInput()
+    {
+        string key = PatchCache.ComputeKey(TargetHash, [PlugAHash, PlugBHash], "X64", coverage: false);
+
+        Assert.Equal(key, PatchCache.ComputeKey(TargetHash, [PlugAHash, PlugBHash], "x64", coverage: false));
+        Assert.NotEqual(key, PatchCache.ComputeKey([1, 2, 4], [PlugAHash, PlugBHash], "X64", coverage: false));
+        Assert.NotEqual(key, PatchCache.ComputeKey(TargetHash, [PlugAHash, [6, 8]], "X64", coverage: false));
+        Assert.NotEqual(key, PatchCache.ComputeKey(TargetHash, [PlugBHash, PlugAHash], "X64", coverage: false));
+        Assert.NotEqual(key, PatchCache.ComputeKey(TargetHash, [PlugAHash, PlugBHash], "ARM64", coverage: false));
+        Assert.NotEqual(key, PatchCache.ComputeKey(TargetHash, [PlugAHash, PlugBHash], "X64", coverage: true));
+    }
+
+    [Fact]
+    public void IsUpToDate_RequiresOutputAndMatchingKey()
+    {
+        string dir = Directory.CreateTempSubdirectory("cosmos-patchcache-").FullName;
+        try
+        {
+            string output = Path.Combine(dir, "Target.dll");
+            string key = PatchCache.ComputeKey(TargetHash, [PlugAHash], "X64", coverage: false);
+
+            PatchCache.Store(output, key);
+            Assert.False(PatchCache.IsUpToDate(output, key)); // key without an output
+
+            File.WriteAllBytes(output, [0]);
+            Assert.True(PatchCache.IsUpToDate(output, key));
+            Assert.False(PatchCache.IsUpToDate(output, PatchCache.ComputeKey(TargetHash, [PlugBHash], "X64", coverage: false)));
+
+            PatchCache.Invalidate(output);
+            Assert.False(PatchCache.IsUpToDate(output, key));
+        }
+        finally
+        {
+            Directory.Delete(dir, recursive: true);
+        }
+    }
+
+    [Fact]
+    public void PatchAssembly_RecordsTimingPerAppliedPlug()
+    {
+        PlugPatcher patcher = new(new PlugScanner());
+        AssemblyDefinition targetAssembly = AssemblyDefinition.ReadAssembly(typeof(TestClass).Assembly.Location);
+        AssemblyDefinition plugAssembly = AssemblyDefinition.ReadAssembly(typeof(TestClassPlug).Assembly.Location);
+
+        patcher.PatchAssembly(targetAssembly, plugAssembly);
+
+        PlugTiming timing = Assert.Single(patcher.PlugTimings, t => t.PlugType == typeof(TestClassPlug).FullName);
+        Assert.Equal(typeof(TestClass).FullName, timing.TargetType);
+        Assert.True(timing.Elapsed >= TimeSpan.Zero);
+    }
+}
@@ -0,0 +1,242 @@
+using System.Buffers.Binary;
+using System.Text;
+using Cosmos.Tools.Profiling;
+
+namespace Cosmos.Tests.Tools;
+
+public class ProfilerTests
+{
+    private const ulong ImageBase = 0xFFFFFFFF80000000UL;
+    private const ulong MainAddress = ImageBase + 0x1000;
+    private const ulong WorkAddress = ImageBase + 0x2000;
+    private const ulong SpinAddress = ImageBase + 0x3000;
+    private const ulong FunctionSize = 0x100;
+
+    private static readonly ElfSymbolTable Symbols = new(
+    [
+        (MainAddress, FunctionSize, "Kernel_Main"),
+        (WorkAddress, FunctionSize, "Kernel_Work"),
+        (SpinAddress, FunctionSize, "Kernel_Spin"),
+    ]);
+
+    // Encodes samples exactly as SamplingProfiler.Dump writes them.
+    private static byte[] EncodeDump(ushort arch, uint dropped, params (int Cpu, uint Thread, ulong[] Frames)[] samples)
+    {
+        var bytes = new List<byte>();
+        void U16(ushort v) { bytes.Add((byte)v); bytes.Add((byte)(v >> 8)); }
+        void U32(uint v) { U16((ushort)v); U16((ushort)(v >> 16)); }
+        void U64(ulong v) { U32((uint)v); U32((uint)(v >> 32)); }
+        void Varint(ulong v)
+        {
+            while (v >= 0x80)
+            {
+                bytes.Add((byte)(v | 0x80));
+                v >>= 7;
+            }
+
+            bytes.Add((byte)v);
+        }
+
+        U32(ProfileStreamReader.Magic);
+        U16(ProfileStreamReader.Version);
+        U16(arch);
+        U64(ImageBase);
+        U32((uint)samples.Length);
+        U32(dropped);
+        foreach ((int cpu, uint thread, ulong[] frames) in samples)
+        {
+            bytes.Add((byte)cpu);
+            bytes.Add((byte)frames.Length);
+            Varint(thread);
+            foreach (ulong frame in frames)
+            {
+                long offset = (long)(frame - ImageBase);
+                Varint((ulong)((offset << 1) ^ (offset >> 63)));
+            }
+        }
+
+        U32(ProfileStreamReader.Trailer);
+        return bytes.ToArray();
+    }
+
+    private static byte[] WithSerialLog(byte[] stream) =>
+        [.. Encoding.ASCII.GetBytes("[SCHED] Tick 50 enabled=1\n[PROFILER] Streaming 2 samples\n"),
+         .. stream,
+         .. Encoding.ASCII.GetBytes("\n[PROFILER] Stream end\n")];
+
+    [Fact]
+    public void ReadAll_FindsStreamInsideSerialLog()
+    {
+        byte[] capture = WithSerialLog(EncodeDump(1, 3,
+            (0, 7, [SpinAddress + 0x10, WorkAddress + 0x20, MainAddress + 0x30]),
+            (1, 9, [MainAddress + 0x40])));
+
+        ProfileDump dump = Assert.Single(ProfileStreamReader.ReadAll(capture));
+
+        Assert.Equal("x64", dump.Arch);
+        Assert.Equal(3u, dump.Dropped);
+        Assert.Equal(2, dump.Samples.Count);
+        Assert.Equal(7u, dump.Samples[0].ThreadId);
+        Assert.Equal(new[] { SpinAddress + 0x10, WorkAddress + 0x20, MainAddress + 0x30 }, dump.Samples[0].Frames);
+        Assert.Equal(1, dump.Samples[1].Cpu);
+    }
+
+    [Fact]
+    public void ReadAll_DecodesConsecutiveDumps()
+    {
+        byte[] capture = [.. WithSerialLog(EncodeDump(2, 0, (0, 1, [MainAddress]))),
+                          .. WithSerialLog(EncodeDump(2, 0, (0, 1, [WorkAddress])))];
+
+        List<ProfileDump> dumps = ProfileStreamReader.ReadAll(capture);
+
+        Assert.Equal(2, dumps.Count);
+        Assert.Equal("arm64", dumps[1].Arch);
+        Assert.Equal(WorkAddress, dumps[1].Samples[0].Frames[0]);
+    }
+
+    [Fact]
+    public void ReadAll_DecodesFramesBelowImageBase()
+    {
+        const ulong HhdmAddress = 0xFFFF800000001234UL;
+        byte[] stream = EncodeDump(1, 0, (0, 1, [ImageBase - 0x10, WorkAddress]), (0, 1, [HhdmAddress]));
+
+        ProfileDump dump = Assert.Single(ProfileStreamReader.ReadAll(stream));
+
+        Assert.Equal(new[] { ImageBase - 0x10, WorkAddress }, dump.Samples[0].Frames);
+        Assert.Equal(HhdmAddress, dump.Samples[1].Frames[0]);
+    }
+
+    [Fact]
+    public void ReadAll_KeepsSamplesOfTruncatedDump()
+    {
+        byte[] stream = EncodeDump(1, 0, (0, 1, [MainAddress]), (0, 1, [WorkAddress]));
+
+        ProfileDump dump = Assert.Single(ProfileStreamReader.ReadAll(stream.AsSpan(0, stream.Length - 6)));
+
+        Assert.Single(dump.Samples);
+    }
+
+    [Fact]
+    public void ReadAll_RejectsMissingTrailer()
+    {
+        byte[] stream = EncodeDump(1, 0, (0, 1, [MainAddress]));
+        stream[^1] ^= 0xFF;
+
+        Assert.Throws<InvalidDataException>(() => ProfileStreamReader.ReadAll(stream));
+    }
+
+    [Fact]
+    public void Lookup_ResolvesInsideFunctionOnly()
+    {
+        Assert.Equal("Kernel_Work", Symbols.Lookup(WorkAddress));
+        Assert.Equal("Kernel_Work", Symbols.Lookup(WorkAddress + FunctionSize - 1));
+        Assert.Null(Symbols.Lookup(WorkAddress + FunctionSize));
+        Assert.Null(Symbols.Lookup(MainAddress - 1));
+    }
+
+    [Fact]
+    public void Fold_EmitsCallerFirstStacksByFrequency()
+    {
+        ProfileSample hot = new(0, 1, [SpinAddress + 0x10, WorkAddress + 0x20, MainAddress + 0x30]);
+        ProfileSample cold = new(0, 1, [MainAddress + 0x40]);
+
+        List<string> folded = ProfileReport.Fold([cold, hot, hot], Symbols);
+
+        Assert.Equal(new[] { "Kernel_Main;Kernel_Work;Kernel_Spin 2", "Kernel_Main 1" }, folded);
+    }
+
+    [Fact]
+    public void Fold_ResolvesReturnAddressAtFunctionEndToCaller()
+    {
+        // A call that ends its function leaves a return address one past the
+        // caller's last byte; it must still fold into the caller.
+        ProfileSample sample = new(0, 1, [SpinAddress, WorkAddress + FunctionSize]);
+
+        Assert.Equal(new[] { "Kernel_Work;Kernel_Spin 1" }, ProfileReport.Fold([sample], Symbols));
+    }
+
+    [Fact]
+    public void Fold_KeepsUnknownFramesAsAddresses()
+    {
+        ProfileSample sample = new(0, 1, [ImageBase + 0x9000]);
+
+        Assert.Equal(new[] { "0xffffffff80009000 1" }, ProfileReport.Fold([sample], Symbols));
+    }
+
+    [Fact]
+    public void Flat_CountsSelfAtLeafAndTotalOncePerSample()
+    {
+        ProfileSample recursive = new(0, 1, [WorkAddress + 0x8, WorkAddress + 0x10, MainAddress + 0x10]);
+        ProfileSample leaf = new(0, 1, [MainAddress + 0x20]);
+
+        List<FlatProfileEntry> flat = ProfileReport.Flat([recursive, leaf], Symbols);
+
+        Assert.Equal(new FlatProfileEntry("Kernel_Main", 1, 2), flat.Single(e => e.Function == "Kernel_Main"));
+        Assert.Equal(new FlatProfileEntry("Kernel_Work", 1, 1), flat.Single(e => e.Function == "Kernel_Work"));
+    }
+
+    [Fact]
+    public void Parse_ReadsFunctionSymbolsFromElf()
+    {
+        ElfSymbolTable table = ElfSymbolTable.Parse(BuildElf(
+            ("Kernel_Main", MainAddress, FunctionSize, 2),
+            ("s_data", WorkAddress, FunctionSize, 1)));
+
+        Assert.Equal(1, table.Count);
+        Assert.Equal("Kernel_Main", table.Lookup(MainAddress + 1));
+        Assert.Null(table.Lookup(WorkAddress));
+    }
+
+    [Fact]
+    public void Parse_RejectsNonElf()
+    {
+        Assert.Throws<InvalidDataException>(() => ElfSymbolTable.Parse(new byte[128]));
+    }
+
+    // Minimal ELF64: null section, .symtab and its .strtab, no program headers.
+    private static byte[] BuildElf(params (string Name, ulong Value, ulong Size, byte Type)[] symbols)
+    {
+        var strtab = new List<byte> { 0 };
+        var symtab = new byte[24 * (symbols.Length + 1)];
+        for (int i = 0; i < symbols.Length; i++)
+        {
+            Span<byte> entry = symtab.AsSpan(24 * (i + 1), 24);
+            BinaryPrimitives.WriteUInt32LittleEndian(entry, (uint)strtab.Count);
+            entry[4] = symbols[i].Type;
+            BinaryPrimitives.WriteUInt64LittleEndian(entry[8..], symbols[i].Value);
+            BinaryPrimitives.WriteUInt64LittleEndian(entry[16..], symbols[i].Size);
+            strtab.AddRange(Encoding.ASCII.GetBytes(symbols[i].Name));
+            strtab.Add(0);
+        }
+
+        const int headerSize = 64;
+        const int sectionHeaderSize = 64;
+        int symtabOffset = headerSize;
+        int strtabOffset = symtabOffset + symtab.Length;
+        int sectionsOffset = strtabOffset + strtab.Count;
+        var elf = new byte[sectionsOffset + 3 * sectionHeaderSize];
+
+        "\u007fELF"u8.CopyTo(elf);
+        elf[4] = 2;
+        elf[5] = 1;
+        BinaryPrimitives.WriteUInt64LittleEndian(elf.AsSpan(0x28), (ulong)sectionsOffset);
+        BinaryPrimitives.WriteUInt16LittleEndian(elf.AsSpan(0x3A), sectionHeaderSize);
+        BinaryPrimitives.WriteUInt16LittleEndian(elf.AsSpan(0x3C), 3);
+
+        symtab.CopyTo(elf, symtabOffset);
+        strtab.CopyTo(elf, strtabOffset);
+
+        Span<byte> symtabHeader = elf.AsSpan(sectionsOffset + sectionHeaderSize, sectionHeaderSize);
+        BinaryPrimitives.WriteUInt32LittleEndian(symtabHeader[4..], 2);
+        BinaryPrimitives.WriteUInt64LittleEndian(symtabHeader[0x18..], (ulong)symtabOffset);
+        BinaryPrimitives.WriteUInt64LittleEndian(symtabHeader[0x20..], (ulong)symtab.Length);
+        BinaryPrimitives.WriteUInt32LittleEndian(symtabHeader[0x28..], 2);
+
+        Span<byte> strtabHeader = elf.AsSpan(sectionsOffset + 2 * sectionHeaderSize, sectionHeaderSize);
+        BinaryPrimitives.WriteUInt32LittleEndian(strtabHeader[4..], 3);
+        BinaryPrimitives.WriteUInt64LittleEndian(strtabHeader[0x18..], (ulong)strtabOffset);
+        BinaryPrimitives.WriteUInt64LittleEndian(strtabHeader[0x20..], (ulong)strtab.Count);
+
+        return elf;
+    }
+}
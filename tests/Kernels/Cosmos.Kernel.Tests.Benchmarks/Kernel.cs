@@ -0,0 +1,665 @@
+using System;
+using System.Diagnostics;
+using System.Threading;
+using Cosmos.Kernel.Core.CPU;
+using Cosmos.Kernel.Core.IO;
+using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.HAL.Devices.Storage;
+using Cosmos.Kernel.HAL.Interfaces.Devices;
+using Cosmos.Kernel.System.Network;
+using Cosmos.Kernel.System.Storage;
+using Cosmos.Kernel.System.Timer;
+using Cosmos.TestRunner.Framework;
+using CoreGC = Cosmos.Kernel.Core.Memory.GarbageCollector.GarbageCollector;
+using InterruptEvent = Cosmos.Kernel.Core.Scheduler.InterruptEvent;
+using SchedMutex = Cosmos.Kernel.Core.Scheduler.Mutex;
+using Sys = Cosmos.Kernel.System;
+using SysThread = System.Threading.Thread;
+using TR = Cosmos.TestRunner.Framework.TestRunner;
+#if ARCH_X64
+using Cosmos.Kernel.Core.X64.Cpu;
+using Cosmos.Kernel.HAL.X64.Devices.Network;
+#endif
+
+namespace Cosmos.Kernel.Tests.Benchmarks;
+
+/// <summary>
+/// Performance suite. Every test runs one benchmark and reports it as a
+/// BenchmarkResult record; the assertions only check that the measured code
+/// did its job, so a slow run still passes here and is caught by the
+/// engine's --benchmark-baseline diff instead.
+/// </summary>
+public unsafe class Kernel : Sys.Kernel
+{
+    // 6 memory + 3 heap + GC + 3 scheduler + IRQ + 2 storage + 2 network = 18
+    private const ushort ExpectedTestCount = 18;
+
+    private const int KiB = 1024;
+
+    /// <summary>Samples per CPU-bound benchmark.</summary>
+    private const int CpuSamples = 64;
+
+    /// <summary>Largest copy/set size; the buffers are allocated once at this size.</summary>
+    private const int MaxMemorySize = 64 * KiB;
+
+    /// <summary>Blocks allocated and then freed per heap sample, sized to drain a magazine.</summary>
+    private const int HeapBlocksPerSample = 64;
+
+    /// <summary>Collections timed for the GC pause distribution.</summary>
+    private const int GcSamples = 32;
+    /// <summary>Objects kept reachable across every collection so mark has a graph to walk.</summary>
+    private const int GcLiveObjects = 512;
+    /// <summary>Short-lived arrays allocated before each collection so sweep has garbage to free.</summary>
+    private const int GcGarbageObjects = 1024;
+    private const int GcObjectBytes = 48;
+
+    /// <summary>Ping-pong round trips per context-switch sample; each is two switches.</summary>
+    private const int RoundTripsPerSample = 16;
+
+    /// <summary>Timed handoffs per lock benchmark (each parks the contender for a few ticks).</summary>
+    private const int HandoffSamples = 32;
+    private const int HandoffWarmup = 4;
+    /// <summary>Sleep that lets the contender reach and park in its acquire before the holder releases.</summary>
+    private const int ContenderParkMs = 20;
+
+    /// <summary>Self-IPIs timed for IRQ entry latency.</summary>
+    private const int IrqSamples = 256;
+    private const int IrqWarmup = 16;
+    /// <summary>Spin bound waiting for a self-IPI to land; far beyond any real delivery latency.</summary>
+    private const int IrqSpinLimit = 10_000_000;
+
+    /// <summary>Random 4 KiB reads timed for storage IOPS.</summary>
+    private const int StorageSamples = 128;
+    private const int StorageWarmup = 16;
+    private const int StorageIoBytes = 4 * KiB;
+    /// <summary>Disk region the random reads are spread over (first 64 MiB, or the whole disk if smaller).</summary>
+    private const ulong StorageSpanBytes = 64UL * KiB * KiB;
+    /// <summary>Random 4 KiB reads submitted per batch for the queue-depth benchmark.</summary>
+    private const int StorageQueueDepth = 8;
+
+    /// <summary>Minimum-size Ethernet frames sent per network sample.</summary>
+    private const int NetFramesPerSample = 32;
+    private const int NetFrameBytes = 64;
+    /// <summary>EtherType for local experiments (IEEE 802 "local experimental 1"), so the frames are dropped by every stack they reach.</summary>
+    private const ushort NetEtherType = 0x88B5;
+    /// <summary>Send retries while the TX ring is full before the NIC counts as stalled.</summary>
+    private const int NetSendSpinLimit = 1_000_000;
+    private const int LinkPollRetries = 20;
+    private const int LinkPollMs = 100;
+
+    /// <summary>Main-thread polling for worker-driven benchmarks: 100 ms x 300 = 30 s cap.</summary>
+    private const int WorkerPollMs = 100;
+    private const int WorkerPollRetries = 300;
+
+    protected override void BeforeRun()
+    {
+        Serial.WriteString("[Benchmarks] Starting benchmark suite\n");
+
+        TR.Start("Benchmarks", expectedTests: ExpectedTestCount);
+
+        s_memSrc = (byte*)MemoryOp.Alloc(MaxMemorySize);
+        s_memDst = (byte*)MemoryOp.Alloc(MaxMemorySize);
+        for (int i = 0; i < MaxMemorySize; i++)
+        {
+            s_memSrc[i] = (byte)(i * 7 + 3);
+        }
+
+        // Memory operations: one small, one page, one larger than L1.
+        TR.Run("MemCopy_64B", () => TestMemCopy("MemCopy_64B", 64, 1024));
+        TR.Run("MemCopy_4KiB", () => TestMemCopy("MemCopy_4KiB", 4 * KiB, 64));
+        TR.Run("MemCopy_64KiB", () => TestMemCopy("MemCopy_64KiB", 64 * KiB, 4));
+        TR.Run("MemSet_64B", () => TestMemSet("MemSet_64B", 64, 1024));
+        TR.Run("MemSet_4KiB", () => TestMemSet("MemSet_4KiB", 4 * KiB, 64));
+        TR.Run("MemSet_64KiB", () => TestMemSet("MemSet_64KiB", 64 * KiB, 4));
+
+        MemoryOp.Free(s_memSrc);
+        MemoryOp.Free(s_memDst);
+
+        // Heap: one size per backing heap (small / medium / large).
+        TR.Run("Heap_AllocFree_32B", () => TestHeapAllocFree("Heap_AllocFree_32B", 32));
+        TR.Run("Heap_AllocFree_4KiB", () => TestHeapAllocFree("Heap_AllocFree_4KiB", 4 * KiB));
+        TR.Run("Heap_AllocFree_64KiB", () => TestHeapAllocFree("Heap_AllocFree_64KiB", 64 * KiB));
+
+        TR.Run("GC_Pause", TestGcPause);
+
+        // Scheduler
+        TR.Run("Sched_ContextSwitch", TestContextSwitch);
+        TR.Run("Mutex_Handoff", TestMutexHandoff);
+        TR.Run("Monitor_Handoff", TestMonitorHandoff);
+
+#if ARCH_X64
+        TR.Run("Irq_EntryLatency", TestIrqEntryLatency);
+#else
+        TR.Skip("Irq_EntryLatency", "no self-IPI helper on ARM64 yet");
+#endif
+
+        // Devices
+        TR.RunIf(StorageManager.DeviceCount > 0, "Storage_RandomRead4KiB", TestStorageRandomRead, "no block device in this profile");
+        TR.RunIf(StorageManager.GetDevice(0) is BlockDevice, "Storage_RandomRead4KiB_QD8", TestStorageRandomReadBatch, "no block device in this profile");
+        TR.RunIf(NetworkManager.PrimaryDevice != null, "Net_Tx64B", TestNetTx, "no network device in this profile");
+#if ARCH_X64
+        TR.RunIf(E1000E.Instance?.Ready == true, "Net_Tx64B_Batch", TestNetTxBatch, "no E1000E in this profile");
+#else
+        TR.Skip("Net_Tx64B_Batch", "batched TX is E1000E-only");
+#endif
+
+        Serial.WriteString("[Benchmarks] All benchmarks completed\n");
+        TR.Finish();
+    }
+
+    protected override void Run()
+    {
+        // All benchmarks ran in BeforeRun; stop the main loop after one iteration
+        Stop();
+    }
+
+    protected override void AfterRun()
+    {
+        TR.Complete();
+        Cosmos.Kernel.System.Power.Halt();
+    }
+
+    // ==================== Memory ====================
+
+    private static byte* s_memSrc;
+    private static byte* s_memDst;
+    private static int s_memSize;
+    private static int s_memOps;
+
+    private static void TestMemCopy(string name, int size, int opsPerSample)
+    {
+        s_memSize = size;
+        s_memOps = opsPerSample;
+        Benchmark.Run(name, CpuSamples, (uint)opsPerSample, MemCopySample);
+
+        Assert.Equal(0, MemoryOp.MemCmp(s_memDst, s_memSrc, size), "MemCopy: destination must match source");
+    }
+
+    private static void MemCopySample()
+    {
+        for (int i = 0; i < s_memOps; i++)
+        {
+            MemoryOp.MemCopy(s_memDst, s_memSrc, s_memSize);
+        }
+    }
+
+    private static void TestMemSet(string name, int size, int opsPerSample)
+    {
+        s_memSize = size;
+        s_memOps = opsPerSample;
+        Benchmark.Run(name, CpuSamples, (uint)opsPerSample, MemSetSample);
+
+        Assert.True(s_memDst[0] == 0xA5 && s_memDst[size - 1] == 0xA5, "MemSet: buffer must hold the fill value");
+    }
+
+    private static void MemSetSample()
+    {
+        for (int i = 0; i < s_memOps; i++)
+        {
+            MemoryOp.MemSet(s_memDst, 0xA5, s_memSize);
+        }
+    }
+
+    // ==================== Heap ====================
+
+    private static readonly nint[] s_heapBlocks = new nint[HeapBlocksPerSample];
+    private static uint s_heapSize;
+    private static bool s_heapAllocFailed;
+
+    private static void TestHeapAllocFree(string name, uint size)
+    {
+        s_heapSize = size;
+        s_heapAllocFailed = false;
+        Benchmark.Run(name, CpuSamples, HeapBlocksPerSample, HeapAllocFreeSample);
+
+        Assert.False(s_heapAllocFailed, "Heap: Alloc must not return null");
+    }
+
+    // Allocate a batch, then free it: the free half refills what the alloc
+    // half drained, so both the fast path and the refill/drain path run.
+    private static void HeapAllocFreeSample()
+    {
+        for (int i = 0; i < HeapBlocksPerSample; i++)
+        {
+            s_heapBlocks[i] = (nint)MemoryOp.Alloc(s_heapSize);
+        }
+
+        for (int i = 0; i < HeapBlocksPerSample; i++)
+        {
+            if (s_heapBlocks[i] == 0)
+            {
+                s_heapAllocFailed = true;
+                continue;
+            }
+            MemoryOp.Free((void*)s_heapBlocks[i]);
+        }
+    }
+
+    // ==================== GC ====================
+
+    private static object[]? s_gcLive;
+    private static byte[]? s_gcSink;
+
+    private static void TestGcPause()
+    {
+        s_gcLive = new object[GcLiveObjects];
+        for (int i = 0; i < GcLiveObjects; i++)
+        {
+            s_gcLive[i] = new byte[GcObjectBytes];
+        }
+
+        ulong[] ticks = new ulong[GcSamples];
+        for (int round = 0; round < Benchmark.DefaultWarmup + GcSamples; round++)
+        {
+            for (int i = 0; i < GcGarbageObjects; i++)
+            {
+                s_gcSink = new byte[GcObjectBytes];
+            }
+
+            long t0 = Stopwatch.GetTimestamp();
+            CoreGC.Collect();
+            long t1 = Stopwatch.GetTimestamp();
+
+            if (round >= Benchmark.DefaultWarmup)
+            {
+                ticks[round - Benchmark.DefaultWarmup] = (ulong)(t1 - t0);
+            }
+        }
+
+        Benchmark.Report("GC_Pause", ticks, GcSamples, 1);
+
+        bool liveIntact = true;
+        for (int i = 0; i < GcLiveObjects; i++)
+        {
+            liveIntact &= s_gcLive[i] is byte[] { Length: GcObjectBytes };
+        }
+        Assert.True(liveIntact, "GC: reachable objects must survive every collection");
+        s_gcLive = null;
+    }
+
+    // ==================== Scheduler ====================
+    // The main thread is the idle thread, and a blocked idle thread is only
+    // resurrected on a timer tick, so it must not be one side of a handoff:
+    // two workers do the measuring while main sleeps and polls for them.
+
+    private static volatile bool s_driverDone;
+    private static volatile bool s_partnerDone;
+    private static volatile bool s_stopPartner;
+
+    private static void StartWorkers(ThreadStart driver, ThreadStart partner)
+    {
+        s_driverDone = false;
+        s_partnerDone = false;
+        s_stopPartner = false;
+
+        new SysThread(partner).Start();
+        new SysThread(driver).Start();
+    }
+
+    private static bool WaitForWorkers()
+    {
+        for (int i = 0; i < WorkerPollRetries && !(s_driverDone && s_partnerDone); i++)
+        {
+            SysThread.Sleep(WorkerPollMs);
+        }
+        return s_driverDone && s_partnerDone;
+    }
+
+    private static InterruptEvent? s_ping;
+    private static InterruptEvent? s_pong;
+
+    private static void TestContextSwitch()
+    {
+        s_ping = new InterruptEvent();
+        s_pong = new InterruptEvent();
+        StartWorkers(ContextSwitchDriver, ContextSwitchPartner);
+
+        Assert.True(WaitForWorkers(), "Context switch: ping-pong threads must finish");
+    }
+
+    private static void ContextSwitchDriver()
+    {
+        Benchmark.Run("Sched_ContextSwitch", CpuSamples, 2 * RoundTripsPerSample, ContextSwitchSample);
+        s_stopPartner = true;
+        s_ping!.Signal();
+        s_driverDone = true;
+    }
+
+    // Each wait blocks the caller, so every signal/wait pair is one switch.
+    private static void ContextSwitchSample()
+    {
+        for (int i = 0; i < RoundTripsPerSample; i++)
+        {
+            s_ping!.Signal();
+            s_pong!.Wait();
+        }
+    }
+
+    private static void ContextSwitchPartner()
+    {
+        while (true)
+        {
+            s_ping!.Wait();
+            if (s_stopPartner)
+            {
+                break;
+            }
+            s_pong!.Signal();
+        }
+        s_partnerDone = true;
+    }
+
+    // Handoff: the driver holds the lock while the partner parks in its
+    // acquire, then releases and blocks; the sample runs from the release to
+    // the partner returning from acquire on the CPU the driver gave up.
+    private static Action? s_lockAcquire;
+    private static Action? s_lockRelease;
+    private static string s_handoffName = string.Empty;
+    private static InterruptEvent? s_handoffGo;
+    private static InterruptEvent? s_handoffAcquired;
+    private static volatile bool s_partnerContending;
+    private static long s_acquiredAt;
+
+    private static SchedMutex? s_mutex;
+    private static readonly object s_monitorObj = new();
+
+    private static void TestMutexHandoff()
+    {
+        s_mutex = new SchedMutex();
+        RunHandoff("Mutex_Handoff", () => s_mutex.Acquire(), () => s_mutex.Release());
+    }
+
+    private static void TestMonitorHandoff()
+    {
+        RunHandoff("Monitor_Handoff", () => Monitor.Enter(s_monitorObj), () => Monitor.Exit(s_monitorObj));
+    }
+
+    private static void RunHandoff(string name, Action acquire, Action release)
+    {
+        s_handoffName = name;
+        s_lockAcquire = acquire;
+        s_lockRelease = release;
+        s_handoffGo = new InterruptEvent();
+        s_handoffAcquired = new InterruptEvent();
+        StartWorkers(HandoffDriver, HandoffPartner);
+
+        Assert.True(WaitForWorkers(), "Handoff: lock holder and contender must finish");
+    }
+
+    private static void HandoffDriver()
+    {
+        ulong[] ticks = new ulong[HandoffSamples];
+        for (int round = 0; round < HandoffWarmup + HandoffSamples; round++)
+        {
+            s_lockAcquire!();
+            s_partnerContending = false;
+            s_handoffGo!.Signal();
+            while (!s_partnerContending)
+            {
+                SysThread.Sleep(0);
+            }
+            SysThread.Sleep(ContenderParkMs);
+
+            long released = Stopwatch.GetTimestamp();
+            s_lockRelease!();
+            s_handoffAcquired!.Wait();
+
+            if (round >= HandoffWarmup)
+            {
+                ticks[round - HandoffWarmup] = (ulong)(s_acquiredAt - released);
+            }
+        }
+
+        s_stopPartner = true;
+        s_handoffGo!.Signal();
+        Benchmark.Report(s_handoffName, ticks, HandoffSamples, 1);
+        s_driverDone = true;
+    }
+
+    private static void HandoffPartner()
+    {
+        while (true)
+        {
+            s_handoffGo!.Wait();
+            if (s_stopPartner)
+            {
+                break;
+            }
+
+            s_partnerContending = true;
+            s_lockAcquire!();
+            s_acquiredAt = Stopwatch.GetTimestamp();
+            s_lockRelease!();
+            s_handoffAcquired!.Signal();
+        }
+        s_partnerDone = true;
+    }
+
+    // ==================== Interrupts ====================
+
+#if ARCH_X64
+    private static volatile bool s_irqFired;
+    private static long s_irqAt;
+
+    private static void IrqLatencyHandler(ref IRQContext context)
+    {
+        s_irqAt = Stopwatch.GetTimestamp();
+        s_irqFired = true;
+    }
+
+    // Self-IPI send to handler entry: IDT stub, register save and dispatch.
+    private static void TestIrqEntryLatency()
+    {
+        byte vector = InterruptManager.AllocateVector(IrqLatencyHandler);
+        ulong[] ticks = new ulong[IrqSamples];
+        int count = 0;
+
+        for (int round = 0; round < IrqWarmup + IrqSamples; round++)
+        {
+            s_irqFired = false;
+            long sent = Stopwatch.GetTimestamp();
+            LocalApic.SendSelfIpi(vector);
+
+            int spins = 0;
+            while (!s_irqFired && spins < IrqSpinLimit)
+            {
+                spins++;
+            }
+            if (!s_irqFired)
+            {
+                break;
+            }
+
+            if (round >= IrqWarmup)
+            {
+                ticks[count++] = (ulong)(s_irqAt - sent);
+            }
+        }
+
+        InterruptManager.FreeVector(vector);
+
+        Assert.Equal(IrqSamples, count, "IRQ: every self-IPI must reach its handler");
+        if (count > 0)
+        {
+            Benchmark.Report("Irq_EntryLatency", ticks, count, 1);
+        }
+    }
+#endif
+
+    // ==================== Storage ====================
+
+    private static IBlockDevice? s_disk;
+    private static byte[]? s_ioBuffer;
+    private static ulong s_ioBlocks;
+    private static ulong s_ioSlots;
+    private static ulong s_ioRandom;
+
+    // QD1 random reads: the drive's latency per command, so IOPS = 1 / p50.
+    private static void TestStorageRandomRead()
+    {
+        s_disk = StorageManager.GetDevice(0)!;
+        ulong blockSize = s_disk.BlockSize;
+        s_ioBlocks = blockSize >= StorageIoBytes ? 1 : StorageIoBytes / blockSize;
+        ulong spanBlocks = Math.Min(s_disk.BlockCount, StorageSpanBytes / blockSize);
+        s_ioSlots = spanBlocks / s_ioBlocks;
+        s_ioBuffer = new byte[s_ioBlocks * blockSize];
+        s_ioRandom = 0x9E3779B97F4A7C15UL;
+
+        if (s_ioSlots == 0)
+        {
+            Assert.Fail("Storage: disk is smaller than one 4 KiB read");
+            return;
+        }
+
+        Benchmark.Run("Storage_RandomRead4KiB", StorageSamples, 1, StorageReadSample, StorageWarmup);
+    }
+
+    private static void StorageReadSample()
+    {
+        // 64-bit LCG (Knuth MMIX constants); the high bits are the random ones.
+        s_ioRandom = s_ioRandom * 6364136223846793005UL + 1442695040888963407UL;
+        ulong slot = (s_ioRandom >> 33) % s_ioSlots;
+        s_disk!.ReadBlock(slot * s_ioBlocks, s_ioBlocks, s_ioBuffer!);
+    }
+
+    private static BlockRequest[]? s_ioBatch;
+
+    // The same random 4 KiB reads, StorageQueueDepth per SubmitBatch, so
+    // the device sees several commands in flight; an op is one 4 KiB read.
+    private static void TestStorageRandomReadBatch()
+    {
+        BlockDevice disk = (BlockDevice)StorageManager.GetDevice(0)!;
+        s_disk = disk;
+        ulong blockSize = disk.BlockSize;
+        s_ioBlocks = blockSize >= StorageIoBytes ? 1 : StorageIoBytes / blockSize;
+        ulong spanBlocks = Math.Min(disk.BlockCount, StorageSpanBytes / blockSize);
+        s_ioSlots = spanBlocks / s_ioBlocks;
+        s_ioBuffer = new byte[(ulong)StorageQueueDepth * s_ioBlocks * blockSize];
+        s_ioBatch = new BlockRequest[StorageQueueDepth];
+        s_ioRandom = 0x9E3779B97F4A7C15UL;
+
+        if (s_ioSlots == 0)
+        {
+            Assert.Fail("Storage: disk is smaller than one 4 KiB read");
+            return;
+        }
+
+        Benchmark.Run("Storage_RandomRead4KiB_QD8", StorageSamples, StorageQueueDepth, StorageReadBatchSample, StorageWarmup);
+    }
+
+    private static void StorageReadBatchSample()
+    {
+        int ioBytes = (int)(s_ioBlocks * s_disk!.BlockSize);
+        for (int i = 0; i < StorageQueueDepth; i++)
+        {
+            s_ioRandom = s_ioRandom * 6364136223846793005UL + 1442695040888963407UL;
+            ulong slot = (s_ioRandom >> 33) % s_ioSlots;
+            s_ioBatch![i] = BlockRequest.Read(slot * s_ioBlocks, s_ioBlocks, s_ioBuffer!, i * ioBytes);
+        }
+
+        ((BlockDevice)s_disk).SubmitBatch(s_ioBatch);
+    }
+
+    // ==================== Network ====================
+
+    private static INetworkDevice? s_nic;
+    private static byte[]? s_frame;
+    private static bool s_nicStalled;
+
+    // Minimum-size frames back to back: TX descriptor setup, doorbell and ring
+    // recycling, i.e. the packets-per-second ceiling of the driver.
+    private static void TestNetTx()
+    {
+        s_nic = NetworkManager.PrimaryDevice!;
+        if (!NicReady(s_nic))
+        {
+            Assert.Fail("Network: device did not become ready");
+            return;
+        }
+
+        s_frame = BuildTestFrame(s_nic);
+        s_nicStalled = false;
+
+        Benchmark.Run("Net_Tx64B", CpuSamples, NetFramesPerSample, NetTxSample);
+
+        Assert.False(s_nicStalled, "Network: TX ring must keep draining");
+    }
+
+    private static bool NicReady(INetworkDevice nic)
+    {
+        for (int i = 0; i < LinkPollRetries && !nic.Ready; i++)
+        {
+            TimerManager.Wait(LinkPollMs);
+        }
+        return nic.Ready;
+    }
+
+    private static byte[] BuildTestFrame(INetworkDevice nic)
+    {
+        byte[] frame = new byte[NetFrameBytes];
+        for (int i = 0; i < 6; i++)
+        {
+            frame[i] = 0xFF;
+            frame[6 + i] = nic.MacAddress.bytes[i];
+        }
+        frame[12] = NetEtherType >> 8;
+        frame[13] = NetEtherType & 0xFF;
+        return frame;
+    }
+
+    private static void NetTxSample()
+    {
+        for (int i = 0; i < NetFramesPerSample; i++)
+        {
+            int spins = 0;
+            while (!s_nic!.Send(s_frame!, NetFrameBytes))
+            {
+                if (++spins > NetSendSpinLimit)
+                {
+                    s_nicStalled = true;
+                    return;
+                }
+            }
+        }
+    }
+
+#if ARCH_X64
+    private static E1000E? s_e1000e;
+    private static byte[][]? s_frameBatch;
+
+    // Same frames as Net_Tx64B, queued with one tail-register write per
+    // batch; the gap between the two is the per-frame doorbell cost.
+    private static void TestNetTxBatch()
+    {
+        s_e1000e = E1000E.Instance!;
+        s_frameBatch = new byte[NetFramesPerSample][];
+        byte[] frame = BuildTestFrame(s_e1000e);
+        for (int i = 0; i < NetFramesPerSample; i++)
+        {
+            s_frameBatch[i] = frame;
+        }
+        s_nicStalled = false;
+
+        Benchmark.Run("Net_Tx64B_Batch", CpuSamples, NetFramesPerSample, NetTxBatchSample);
+
+        Assert.False(s_nicStalled, "Network: TX ring must keep draining");
+    }
+
+    private static void NetTxBatchSample()
+    {
+        byte[][] frames = s_frameBatch!;
+        int sent = 0;
+        int spins = 0;
+        while (sent < NetFramesPerSample)
+        {
+            int queued = s_e1000e!.SendBatch(frames.AsSpan(sent));
+            sent += queued;
+            if (queued == 0 && ++spins > NetSendSpinLimit)
+            {
+                s_nicStalled = true;
+                return;
+            }
+        }
+    }
+#endif
+}
@@ -2,6 +2,7 @@ using System;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.Kernel.HAL.Vfs;
 using Cosmos.Kernel.System.Filesystems.Fat;
+using Cosmos.Kernel.System.Storage;
 using Cosmos.Kernel.System.Vfs;
 using Cosmos.TestRunner.Framework;
 using Sys = Cosmos.Kernel.System;
@@ -13,7 +14,7 @@ public class Kernel : Sys.Kernel
 {
     /// <summary>Exact TR.Run cell count — the harness synthesizes failures
     /// for missing tests, so a mid-suite hang can't report ALL TESTS PASSED.</summary>
-    private const ushort ExpectedTestCount = 41;
+    private const ushort ExpectedTestCount = 44;
 
     private const string Fat16Mount = "/fat";
     private const string Fat32Mount = "/fat32";
@@ -372,6 +373,27 @@ public class Kernel : Sys.Kernel
     /// <summary>Bytes probed inside the gap, all of which must read as zero.</summary>
     private const int HoleGapProbeBytes = 64;
 
+    /// <summary>First block of the sector run the write-back cell writes through the cache — mid-page, so the page fill is partial.</summary>
+    private const ulong CacheProbeBlock = 3;
+
+    /// <summary>Blocks in the write-back cell's sector run.</summary>
+    private const int CacheProbeBlocks = 2;
+
+    /// <summary>Pattern salt of the write-back cell's sectors.</summary>
+    private const byte CacheProbeSalt = 0x3C;
+
+    /// <summary>Cache size of the eviction cell: three page-strided writes overflow it by one.</summary>
+    private const int EvictionCapacityPages = 2;
+
+    /// <summary>Pages the eviction cell writes, one sector each.</summary>
+    private const int EvictionWritePages = 3;
+
+    /// <summary>Bytes of the file the cached-mount cell streams — 16 clusters at SPC=4, several read-ahead windows' worth of pages.</summary>
+    private const int CachedMountPayloadBytes = 32 * 1024;
+
+    /// <summary>Pattern salt of the cached-mount cell's file.</summary>
+    private const byte CachedMountSalt = 0xB7;
+
     /// <summary>Shift bringing the next-higher byte of the index into the payload pattern (bits per byte).</summary>
     private const int BitsPerByte = 8;
 
@@ -1390,6 +1412,92 @@ public class Kernel : Sys.Kernel
             AssertAllZero(sector, "backup boot sector must be wiped by Destroy");
         });
 
+        // ---------- Block cache ----------
+
+        // Writes stay in the cache until Flush, which writes them back and
+        // then flushes the device itself.
+        TR.Run("Test_BlockCache_WriteBackAndFlush", () =>
+        {
+            MemoryBlockDevice disk = scratchDisk.Reconfigure("BCWB", FatTestVolume.BlockSize, RangeCheckDiskBlockCount);
+            BlockCache cache = new(disk, backgroundFlush: false);
+            byte[] payload = MakePayload(CacheProbeBlocks * SectorSizeBytes, CacheProbeSalt);
+            cache.WriteBlock(CacheProbeBlock, CacheProbeBlocks, payload);
+            Assert.Equal<int>(1, cache.DirtyPages);
+
+            byte[] raw = new byte[payload.Length];
+            disk.ReadBlock(CacheProbeBlock, CacheProbeBlocks, raw);
+            AssertAllZero(raw, "a write-back cache must not reach the device before Flush");
+            byte[] cached = new byte[payload.Length];
+            cache.ReadBlock(CacheProbeBlock, CacheProbeBlocks, cached);
+            AssertBytesEqual(payload, cached);
+
+            cache.Flush();
+            Assert.Equal<int>(0, cache.DirtyPages);
+            Assert.Equal<int>(1, disk.FlushCount);
+            disk.ReadBlock(CacheProbeBlock, CacheProbeBlocks, raw);
+            AssertBytesEqual(payload, raw);
+            cache.Dispose();
+        });
+
+        // Evicting a dirty page writes it back first; reading it again
+        // misses and reloads the written data.
+        TR.Run("Test_BlockCache_EvictsLruWritesBackDirty", () =>
+        {
+            MemoryBlockDevice disk = scratchDisk.Reconfigure("BCLRU", FatTestVolume.BlockSize, RangeCheckDiskBlockCount);
+            BlockCache cache = new(disk, EvictionCapacityPages, backgroundFlush: false);
+            ulong pageBlocks = (ulong)cache.PageBytes / FatTestVolume.BlockSize;
+            for (int i = 0; i < EvictionWritePages; i++)
+            {
+                cache.WriteBlock((ulong)i * pageBlocks, 1, MakePayload(SectorSizeBytes, (byte)(CacheProbeSalt + i)));
+            }
+
+            Assert.Equal<ulong>(1, cache.WriteBacks);
+            Assert.Equal<int>(EvictionCapacityPages, cache.DirtyPages);
+            byte[] expected = MakePayload(SectorSizeBytes, CacheProbeSalt);
+            byte[] sector = new byte[SectorSizeBytes];
+            disk.ReadBlock(0, 1, sector);
+            AssertBytesEqual(expected, sector);
+
+            ulong misses = cache.Misses;
+            cache.ReadBlock(0, 1, sector);
+            AssertBytesEqual(expected, sector);
+            Assert.True(cache.Misses > misses, "the evicted page must be reloaded from the device");
+            cache.Dispose();
+        });
+
+        // A volume mounted on a cache: allocation goes through the free
+        // bitmap, a sequential read is served by read-ahead, and Drop
+        // leaves everything on the device.
+        TR.Run("Test_Fat_MountOnCache_ReadAheadAndFreeMap", () =>
+        {
+            MemoryBlockDevice disk = scratchDisk.Reconfigure("BCMOUNT", FatTestVolume.BlockSize, Fat16ScratchBlockCount);
+            Assert.True(new FatFilesystemType(disk).TryFormat(default, new FatFormatOptions { Type = FatType.Fat16, SectorsPerCluster = Fat16ScratchSectorsPerCluster }));
+            byte[] payload = MakePayload(CachedMountPayloadBytes, CachedMountSalt);
+
+            BlockCache writeCache = new(disk, backgroundFlush: false);
+            Assert.True(new FatFilesystemType(writeCache).TryMount(default, MountFlags.None, out IVfsSuperblock? sb));
+            Assert.True(sb!.SuperOperations.StatFs(sb, out VfsStatFs before));
+            IVfsInode root = sb.Root;
+            Assert.True(root.InodeOperations.Create(root, "STREAM.BIN", ModeEnum.RegularFile, out IVfsInode? created));
+            WriteAll(created!, payload);
+            Assert.True(sb.SuperOperations.StatFs(sb, out VfsStatFs after));
+            Assert.Equal<ulong>(before.Bfree - (ulong)(CachedMountPayloadBytes / (SectorSizeBytes * Fat16ScratchSectorsPerCluster)), after.Bfree);
+            sb.SuperOperations.Drop(sb);
+            Assert.Equal<int>(0, writeCache.DirtyPages);
+            // Drop flushes an injected cache but leaves disposing it to its owner.
+            writeCache.Dispose();
+
+            // A cold cache: the read must come from read-ahead batches.
+            BlockCache readCache = new(disk, backgroundFlush: false);
+            Assert.True(new FatFilesystemType(readCache).TryMount(default, MountFlags.None, out IVfsSuperblock? sb2));
+            IVfsInode root2 = sb2!.Root;
+            Assert.True(root2.InodeOperations.Lookup(root2, "STREAM.BIN", out IVfsInode? stream));
+            AssertBytesEqual(payload, ReadAll(stream!, payload.Length));
+            Assert.True(readCache.ReadAheadPages > 0, "a sequential read must be served by read-ahead");
+            sb2.SuperOperations.Drop(sb2);
+            readCache.Dispose();
+        });
+
         TR.Finish();
 
         Serial.WriteString("\n[Tests Complete - System Halting]\n");
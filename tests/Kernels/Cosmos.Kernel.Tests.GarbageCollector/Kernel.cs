@@ -24,7 +24,7 @@ public class Kernel : Sys.Kernel
         Serial.WriteString("[GarbageCollector] BeforeRun() reached!\n");
         Serial.WriteString("[GarbageCollector] Starting tests...\n");
 
-        TR.Start("GarbageCollector Tests", expectedTests: 44);
+        TR.Start("GarbageCollector Tests", expectedTests: 45);
 
         // Garbage Collection Tests
         TR.Run("GC_IsEnabled", TestGCIsEnabled);
@@ -38,6 +38,7 @@ public class Kernel : Sys.Kernel
         TR.Run("GC_ListSurvival", TestGCListSurvival);
         TR.Run("GC_UnreachableExactCount", TestGCUnreachableExactCount);
         TR.Run("GC_ObjectGraphSurvival", TestGCObjectGraphSurvival);
+        TR.Run("GC_WideGraphSurvival", TestGCWideGraphSurvival);
         TR.Run("GC_MixedTypeSurvival", TestGCMixedTypeSurvival);
         TR.Run("GC_AllocAfterCollect", TestGCAllocAfterCollect);
         TR.Run("GC_WeakReference", TestGCWeakReference);
@@ -268,6 +269,44 @@ public class Kernel : Sys.Kernel
         Assert.True(strings[2] == "Gamma", "GC: object graph last element survives");
     }
 
+    private static void TestGCWideGraphSurvival()
+    {
+        // Fan-out far wider than the mark prefetch FIFO, each entry heading a short
+        // chain: marking must still reach every node once the popped entries are
+        // delayed behind the prefetched ones.
+        const int fanout = 64;
+        const int chainLength = 4;
+
+        TestNode[] heads = new TestNode[fanout];
+        for (int i = 0; i < fanout; i++)
+        {
+            TestNode? node = null;
+            for (int depth = chainLength - 1; depth >= 0; depth--)
+            {
+                node = new TestNode { Value = i * chainLength + depth, Next = node };
+            }
+
+            heads[i] = node!;
+        }
+
+        CoreGC.Collect();
+        AllocateGarbage(fanout, 64);
+        CoreGC.Collect();
+
+        bool intact = true;
+        for (int i = 0; i < fanout; i++)
+        {
+            TestNode? node = heads[i];
+            for (int depth = 0; depth < chainLength; depth++)
+            {
+                intact &= node != null && node.Value == i * chainLength + depth;
+                node = node?.Next;
+            }
+        }
+
+        Assert.True(intact, "GC: every node of a wide object graph survives collection");
+    }
+
     private static void TestGCMixedTypeSurvival()
     {
         // Various types allocated and kept alive across GC
@@ -1403,6 +1442,13 @@ public class Kernel : Sys.Kernel
     }
 }
 
+// Linked node for object graph tests
+internal sealed class TestNode
+{
+    public int Value;
+    public TestNode? Next;
+}
+
 // Test struct for boxing and collection tests
 internal struct TestPoint
 {
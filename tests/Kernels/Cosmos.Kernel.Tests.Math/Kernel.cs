@@ -4,6 +4,7 @@
 // desktop .NET 10 produces; any deviation is a Cosmos bug.
 // -----------------------------------------------------------------------------
 
+using Cosmos.Kernel.Core.Bridge;
 using Cosmos.Kernel.Core.IO;
 using Cosmos.TestRunner.Framework;
 using Sys = Cosmos.Kernel.System;
@@ -65,7 +66,7 @@ public class Kernel : Sys.Kernel
         Serial.WriteString("[Math] BeforeRun() reached!\n");
         Serial.WriteString("[Math] Starting System.Math tests...\n");
 
-        TR.Start("Math Tests", expectedTests: 30);
+        TR.Start("Math Tests", expectedTests: 32);
 
         // Abs
         TR.Run("Math_Abs_Double", Test_Abs_Double);
@@ -80,6 +81,8 @@ public class Kernel : Sys.Kernel
         TR.Run("Math_Floor", Test_Floor);
         TR.Run("Math_Truncate", Test_Truncate);
         TR.Run("Math_Round", Test_Round);
+        TR.Run("Math_Rounding_EdgeCases", Test_Rounding_EdgeCases);
+        TR.Run("Math_Rounding_Spans", Test_Rounding_Spans);
 
         // Sqrt
         TR.Run("Math_Sqrt", Test_Sqrt);
@@ -218,6 +221,53 @@ public class Kernel : Sys.Kernel
         Assert.True(SysMath.Round(-2.5) == -2.0, "Round(-2.5) == -2 (banker's)");
     }
 
+    private static void Test_Rounding_EdgeCases()
+    {
+        // Beyond the long range and at the 2^52 integral boundary
+        Assert.True(SysMath.Ceiling(1e19) == 1e19, "Ceiling(1e19) == 1e19");
+        Assert.True(SysMath.Truncate(-1e19) == -1e19, "Truncate(-1e19) == -1e19");
+        Assert.True(SysMath.Floor(4503599627370495.5) == 4503599627370495.0, "Floor(2^52 - 0.5)");
+        Assert.True(SysMath.Ceiling(4503599627370495.5) == 4503599627370496.0, "Ceiling(2^52 - 0.5)");
+
+        // Signed zero is preserved
+        Assert.True(double.IsNegative(SysMath.Ceiling(-0.5)), "Ceiling(-0.5) == -0");
+        Assert.True(double.IsNegative(SysMath.Truncate(-0.9)), "Truncate(-0.9) == -0");
+        Assert.True(!double.IsNegative(SysMath.Floor(0.5)), "Floor(0.5) == +0");
+
+        Assert.True(SysMath.Round(0.49999999999999994, MidpointRounding.AwayFromZero) == 0.0, "Round(pred(0.5), AwayFromZero) == 0");
+        Assert.True(SysMath.Round(-2.5, MidpointRounding.AwayFromZero) == -3.0, "Round(-2.5, AwayFromZero) == -3");
+        Assert.True(SysMathF.Floor(-1.5f) == -2.0f, "MathF.Floor(-1.5) == -2");
+        Assert.True(SysMathF.Ceiling(1.25f) == 2.0f, "MathF.Ceiling(1.25) == 2");
+        Assert.True(SysMath.Sqrt(1e-300) == 1e-150, "Sqrt(1e-300) == 1e-150 (correctly rounded)");
+    }
+
+    private static unsafe void Test_Rounding_Spans()
+    {
+        // Odd length exercises the scalar tail after the two-lane loop.
+        double* src = stackalloc double[] { 1.5, -1.5, 2.5, -0.25, 1e19, 9.0, 0.49999999999999994 };
+        double* dst = stackalloc double[7];
+        const ulong count = 7;
+
+        MathNative.FloorSpan(dst, src, count);
+        Assert.True(dst[0] == 1.0 && dst[1] == -2.0 && dst[2] == 2.0 && dst[3] == -1.0 && dst[4] == 1e19 && dst[6] == 0.0, "FloorSpan");
+
+        MathNative.CeilingSpan(dst, src, count);
+        Assert.True(dst[0] == 2.0 && dst[1] == -1.0 && dst[2] == 3.0 && double.IsNegative(dst[3]) && dst[6] == 1.0, "CeilingSpan");
+
+        MathNative.TruncateSpan(dst, src, count);
+        Assert.True(dst[0] == 1.0 && dst[1] == -1.0 && dst[2] == 2.0 && dst[3] == 0.0 && dst[6] == 0.0, "TruncateSpan");
+
+        MathNative.RoundSpan(dst, src, count);
+        Assert.True(dst[0] == 2.0 && dst[1] == -2.0 && dst[2] == 3.0 && dst[3] == 0.0 && dst[6] == 0.0, "RoundSpan (away from zero)");
+
+        MathNative.SqrtSpan(dst, src, count);
+        Assert.True(dst[5] == 3.0 && double.IsNaN(dst[1]) && ApproxEqual(dst[0], 1.2247448713915890), "SqrtSpan");
+
+        // In place
+        MathNative.FloorSpan(src, src, count);
+        Assert.True(src[0] == 1.0 && src[1] == -2.0, "FloorSpan in place");
+    }
+
     // =========================================================================
     // Sqrt
     // =========================================================================
@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Runtime.CompilerServices;
 using System.Text;
 using Cosmos.Kernel.Core.Memory;
+using Cosmos.Kernel.Core.Memory.Heap;
 using Cosmos.TestRunner.Framework;
 using Sys = Cosmos.Kernel.System;
 using TR = Cosmos.TestRunner.Framework.TestRunner;
@@ -12,7 +13,7 @@ namespace Cosmos.Kernel.Tests.Memory;
 public unsafe class Kernel : Sys.Kernel
 {
     /// <summary>Number of test cases registered with the TestRunner in BeforeRun.</summary>
-    private const int ExpectedTestCount = 71;
+    private const int ExpectedTestCount = 73;
 
     /// <summary>Expected argv length: argv[0] ("cosmos") plus the 3 args passed by limine.conf.</summary>
     private const int ExpectedArgvLength = 4;
@@ -89,6 +90,15 @@ public unsafe class Kernel : Sys.Kernel
     /// <summary>Base of the top-2GiB kernel image window where NativeAOT places code and statics.</summary>
     private const ulong KernelImageWindowBase = 0xFFFF_FFFF_8000_0000;
 
+    /// <summary>Block size served by the 64-byte magazine class.</summary>
+    private const uint MagazineBlockSize = 64;
+
+    /// <summary>Block size used to push a magazine through refills and drains.</summary>
+    private const uint MagazineBatchBlockSize = 128;
+
+    /// <summary>Fill byte written into a block before it goes back to its magazine.</summary>
+    private const byte MagazineFillValue = 0xCD;
+
     protected override void BeforeRun()
     {
         TR.Start("Memory Tests", expectedTests: ExpectedTestCount);
@@ -186,6 +196,10 @@ public unsafe class Kernel : Sys.Kernel
         TR.Run("V2P_PhysicalValue_PassesThrough", TestV2PPhysicalPassesThrough);
         TR.Run("V2P_KernelImageAddress_Rejected", TestV2PKernelImageRejected);
 
+        // Per-CPU heap magazines in front of SmallHeap
+        TR.Run("Heap_Magazine_ReusesFreedBlock", TestHeapMagazineReusesFreedBlock);
+        TR.Run("Heap_Magazine_CountersTrackRefillAndDrain", TestHeapMagazineCountersTrackRefillAndDrain);
+
         TR.Finish();
     }
 
@@ -1253,6 +1267,66 @@ public unsafe class Kernel : Sys.Kernel
             return true;
         }
     }
+
+    // ==================== Heap magazines ====================
+
+    // A freed small block parks in the current CPU's magazine, which is a
+    // LIFO: the next allocation of the same class gets it straight back,
+    // zeroed, without touching the shared SMT.
+    private static unsafe void TestHeapMagazineReusesFreedBlock()
+    {
+        int sizeClass = HeapMagazines.ClassOf(MagazineBlockSize);
+        Assert.True(sizeClass >= 0, "64-byte blocks must have a magazine");
+
+        byte* first = Heap.Alloc(MagazineBlockSize);
+        Assert.True(first != null, "small allocation must succeed");
+        MemoryOp.MemSet(first, MagazineFillValue, (int)MagazineBlockSize);
+        Heap.Free(first);
+
+        ulong hitsBefore = HeapMagazines.GetStats(sizeClass).Hits;
+        byte* second = Heap.Alloc(MagazineBlockSize);
+        ulong hitsAfter = HeapMagazines.GetStats(sizeClass).Hits;
+
+        Assert.True(second == first, "magazine must hand back the block freed last");
+        Assert.True(hitsAfter == hitsBefore + 1, "reuse must be counted as a magazine hit");
+
+        bool zeroed = true;
+        for (int i = 0; i < MagazineBlockSize; i++)
+        {
+            zeroed &= second[i] == 0;
+        }
+        Assert.True(zeroed, "block from a magazine must be zero-filled");
+
+        Heap.Free(second);
+    }
+
+    // More live blocks than a magazine holds forces refills from SmallHeap;
+    // freeing them all overflows it and forces drains back.
+    private static unsafe void TestHeapMagazineCountersTrackRefillAndDrain()
+    {
+        const int BlockCount = HeapMagazines.Capacity * 2;
+        int sizeClass = HeapMagazines.ClassOf(MagazineBatchBlockSize);
+        HeapMagazineStats before = HeapMagazines.GetStats(sizeClass);
+
+        byte** blocks = stackalloc byte*[BlockCount];
+        for (int i = 0; i < BlockCount; i++)
+        {
+            blocks[i] = Heap.Alloc(MagazineBatchBlockSize);
+        }
+
+        HeapMagazineStats allocated = HeapMagazines.GetStats(sizeClass);
+
+        for (int i = 0; i < BlockCount; i++)
+        {
+            Heap.Free(blocks[i]);
+        }
+
+        HeapMagazineStats freed = HeapMagazines.GetStats(sizeClass);
+
+        Assert.True(allocated.Refills > before.Refills, "allocating past a magazine must refill it");
+        Assert.True(freed.Drains > allocated.Drains, "freeing past a magazine's capacity must drain it");
+        Assert.True(freed.Cached <= (ulong)HeapMagazines.Capacity, "a magazine never holds more than its capacity");
+    }
 }
 
 internal enum TestEnum
@@ -21,7 +21,7 @@ public class Kernel : Sys.Kernel
     private const string SkipNoDevice = "no PCI devices enumerated — host bridge / ECAM not discovered";
 
     /// <summary>Number of tests announced to the runner in TR.Start.</summary>
-    private const int ExpectedTestCount = 6;
+    private const int ExpectedTestCount = 7;
 
     /// <summary>All-ones vendor/device id returned by an unmapped or empty config-space read (PCI spec: 0xFFFF = no device).</summary>
     private const ushort AllOnesId = 0xFFFF;
@@ -60,6 +60,7 @@ public class Kernel : Sys.Kernel
         TR.RunIf(anyDevice, "ConfigSpace_DeviceId_NotAllOnes",     TestConfigSpace_DeviceIdNotAllOnes,     SkipNoDevice);
         TR.RunIf(anyDevice, "ConfigSpace_ClassCode_InRange",       TestConfigSpace_ClassCodeInRange,       SkipNoDevice);
         TR.RunIf(anyDevice, "ConfigSpace_VendorRead_StableAcrossCalls", TestConfigSpace_VendorReadStable,  SkipNoDevice);
+        TR.RunIf(anyDevice, "Manager_GetDevice_BySegmentAddress",  TestManager_GetDeviceBySegmentAddress,  SkipNoDevice);
 
         TR.Finish();
 
@@ -126,4 +127,15 @@ public class Kernel : Sys.Kernel
         ushort second = s_firstDevice.ReadRegister16(VendorIdRegisterOffset);
         Assert.Equal(first, second);
     }
+
+    private static void TestManager_GetDeviceBySegmentAddress()
+    {
+        // Every segment from the MCFG is enumerated, so a cached device must
+        // be found again by its full (segment, bus, slot, function) address,
+        // and the static config read for that address must agree with it.
+        PciDevice device = s_firstDevice!;
+        Assert.True(PciManager.GetDevice(device.Segment, device.Bus, device.Slot, device.Function) == device);
+        Assert.Equal(device.VendorId, PciDevice.GetVendorId((ushort)device.Segment, (ushort)device.Bus,
+            (ushort)device.Slot, (ushort)device.Function));
+    }
 }
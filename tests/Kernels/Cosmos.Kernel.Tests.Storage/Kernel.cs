@@ -11,6 +11,7 @@ using Cosmos.Kernel.System.Storage;
 using Cosmos.TestRunner.Framework;
 using Sys = Cosmos.Kernel.System;
 using TR = Cosmos.TestRunner.Framework.TestRunner;
+using Sched = Cosmos.Kernel.Core.Scheduler;
 
 namespace Cosmos.Kernel.Tests.Storage;
 
@@ -33,7 +34,7 @@ public class Kernel : Sys.Kernel
     private const string SkipNoHost = "no block device bound for partition-table tests";
 
     /// <summary>Total tests this suite reports per profile; the breakdown is at the TR.Start call site.</summary>
-    private const ushort ExpectedTestCount = 67;
+    private const ushort ExpectedTestCount = 70;
 
     /// <summary>Block devices the engine attaches per QEMU profile; any other count is a bind or double-registration regression.</summary>
     private const int AttachedDisksPerProfile = 1;
@@ -179,6 +180,24 @@ public class Kernel : Sys.Kernel
     /// <summary>Fill byte of the short-span payload.</summary>
     private const byte ShortSpanFill = 0x5B;
 
+    /// <summary>First scratch LBA of the scatter-gather batch cell; the batch touches the next <see cref="BatchSpanBlocks"/> blocks.</summary>
+    private const ulong BatchBaseLba = 4300;
+
+    /// <summary>Blocks spanned by the scatter-gather cell's LBA window (requests leave holes in it).</summary>
+    private const int BatchSpanBlocks = 8;
+
+    /// <summary>Fill byte of the window blocks the scatter-gather batch skips.</summary>
+    private const byte BatchHoleFill = 0x77;
+
+    /// <summary>XOR seed of the scatter-gather pattern, so each block's content encodes its LBA.</summary>
+    private const byte BatchXorSeed = 0x3C;
+
+    /// <summary>Scratch LBA of the hybrid-polling cell, clear of the batch window.</summary>
+    private const ulong HybridPollLba = 4320;
+
+    /// <summary>Single-block commands the hybrid-polling cell issues back to back.</summary>
+    private const int HybridPollBlocks = 8;
+
     /// <summary>XOR seed decorrelating the single-block round-trip pattern from a plain index ramp.</summary>
     private const byte SingleBlockXorSeed = 0xA5;
 
@@ -398,7 +417,10 @@ public class Kernel : Sys.Kernel
         TR.RunIf(dev, "Device_LBA_Stride_Sweep",           TestDevice_LBAStrideSweep,           SkipNoDevice);
         TR.RunIf(dev, "Device_RandomOrder_ReadAfterWrite", TestDevice_RandomOrderReadAfterWrite, SkipNoDevice);
         TR.RunIf(dev, "Device_Multiblock_TailBoundary",    TestDevice_MultiblockTailBoundary,   SkipNoDevice);
+        TR.RunIf(s_dev is BlockDevice, "Device_SubmitBatch_ScatterGather", TestDevice_SubmitBatchScatterGather, SkipNoDevice);
         TR.RunIf(dev && TR.ProfileHasPrefix("nvme"), "Nvme_ShortSpanWritesDeterministicTail", TestNvme_ShortSpanTail, "NVMe controller API is nvme-profile only");
+        TR.RunIf(dev && TR.ProfileHasPrefix("nvme"), "Nvme_IoQueuesPerCpu", TestNvme_IoQueuesPerCpu, "NVMe controller API is nvme-profile only");
+        TR.RunIf(dev && TR.ProfileHasPrefix("nvme") && CurrentThread() != null, "Nvme_HybridPolledCompletion", TestNvme_HybridPolledCompletion, "needs an NVMe profile and a scheduler thread");
 
         // ==================== Partition (MBR/GPT, partition translation) ====================
         // These run last because they overwrite LBA 0..33, which the device
@@ -670,6 +692,66 @@ public class Kernel : Sys.Kernel
         }
     }
 
+    private static void TestNvme_IoQueuesPerCpu()
+    {
+        NvmeController controller = Nvme.Controllers[0];
+        uint cpus = PlatformHAL.Initializer?.GetCpuCount() ?? 1;
+
+        Assert.True(controller.IoQueueCount >= 1, "at least one I/O queue pair");
+        Assert.True((uint)controller.IoQueueCount <= cpus, "no more I/O queue pairs than CPUs");
+        Assert.True(controller.IoQueueDepth >= 2, "queue depth holds at least one command");
+    }
+
+    // Flags the test thread PolledIo so its commands spin on the CQ phase
+    // bit. With MSI-X the interrupt may still win the race for a given
+    // command, so the counter is only required to move across a batch;
+    // without MSI-X every completion is reaped by polling regardless.
+    private static void TestNvme_HybridPolledCompletion()
+    {
+        NvmeController controller = Nvme.Controllers[0];
+        Sched.Thread thread = CurrentThread()!;
+        int sector = (int)s_dev!.BlockSize;
+        Sched.ThreadFlags saved = thread.Flags;
+        ulong before = controller.PolledCompletions;
+
+        thread.Flags = saved | Sched.ThreadFlags.PolledIo;
+        try
+        {
+            byte[] block = new byte[sector];
+            for (int n = 0; n < HybridPollBlocks; n++)
+            {
+                for (int i = 0; i < sector; i++)
+                {
+                    block[i] = (byte)(i ^ n);
+                }
+                controller.Write(NvmeNamespaceId, HybridPollLba + (ulong)n, block, NvmeSingleBlockNlb);
+            }
+
+            for (int n = 0; n < HybridPollBlocks; n++)
+            {
+                controller.Read(NvmeNamespaceId, HybridPollLba + (ulong)n, block, NvmeSingleBlockNlb);
+                for (int i = 0; i < sector; i++)
+                {
+                    Assert.Equal((byte)(i ^ n), block[i], "polled read-back");
+                }
+            }
+        }
+        finally
+        {
+            thread.Flags = saved;
+        }
+
+        if (controller.IsMsiXEnabled)
+        {
+            Assert.True(controller.PolledCompletions > before, "hybrid poll reaped at least one completion");
+        }
+    }
+
+    private static Sched.Thread? CurrentThread() =>
+        Sched.SchedulerManager.IsReady
+            ? Sched.SchedulerManager.GetCpuState(Sched.SchedulerManager.GetCurrentCpuId())?.CurrentThread
+            : null;
+
     // ==================== Manager ====================
 
     private static void TestManager_StorageInitialized()
@@ -997,6 +1079,73 @@ public class Kernel : Sys.Kernel
         }
     }
 
+    // Writes three requests with holes between them (one of them two
+    // blocks long, sharing a buffer at an offset), then reads them back as
+    // one batch and through ReadBlock. The holes must keep their old data.
+    private static void TestDevice_SubmitBatchScatterGather()
+    {
+        BlockDevice device = (BlockDevice)s_dev!;
+        int sector = (int)device.BlockSize;
+
+        byte[] hole = new byte[sector];
+        for (int i = 0; i < sector; i++)
+        {
+            hole[i] = BatchHoleFill;
+        }
+        for (int n = 0; n < BatchSpanBlocks; n++)
+        {
+            device.WriteBlock(BatchBaseLba + (ulong)n, 1, hole);
+        }
+
+        // Blocks 0, 2-3 and 6 of the window; blocks 2-3 sit at an offset
+        // in a buffer shared with block 0.
+        byte[] first = new byte[sector * 3];
+        byte[] last = new byte[sector];
+        FillBatchBlock(first, 0, 0);
+        FillBatchBlock(first, sector, 2);
+        FillBatchBlock(first, sector * 2, 3);
+        FillBatchBlock(last, 0, 6);
+
+        BlockRequest[] writes =
+        [
+            BlockRequest.Write(BatchBaseLba, 1, first),
+            BlockRequest.Write(BatchBaseLba + 2, 2, first, sector),
+            BlockRequest.Write(BatchBaseLba + 6, 1, last),
+        ];
+        device.SubmitBatch(writes);
+
+        byte[] readBack = new byte[sector * BatchSpanBlocks];
+        BlockRequest[] reads = new BlockRequest[BatchSpanBlocks];
+        for (int n = 0; n < BatchSpanBlocks; n++)
+        {
+            reads[n] = BlockRequest.Read(BatchBaseLba + (ulong)n, 1, readBack, n * sector);
+        }
+        device.SubmitBatch(reads);
+
+        byte[] single = new byte[sector * BatchSpanBlocks];
+        device.ReadBlock(BatchBaseLba, BatchSpanBlocks, single);
+
+        for (int n = 0; n < BatchSpanBlocks; n++)
+        {
+            bool written = n == 0 || n == 2 || n == 3 || n == 6;
+            for (int i = 0; i < sector; i++)
+            {
+                byte expected = written ? (byte)(i ^ n ^ BatchXorSeed) : BatchHoleFill;
+                Assert.Equal(expected, readBack[n * sector + i], "batched read-back");
+                Assert.Equal(expected, single[n * sector + i], "ReadBlock read-back");
+            }
+        }
+    }
+
+    private static void FillBatchBlock(byte[] buffer, int offset, int block)
+    {
+        int sector = (int)s_dev!.BlockSize;
+        for (int i = 0; i < sector; i++)
+        {
+            buffer[offset + i] = (byte)(i ^ block ^ BatchXorSeed);
+        }
+    }
+
     // ==================== Partition ====================
 
     private static void TestPartition_MBRRoundTrip()
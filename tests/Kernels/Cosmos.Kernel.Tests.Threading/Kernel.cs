@@ -15,7 +15,7 @@ namespace Cosmos.Kernel.Tests.Threading;
 public class Kernel : Sys.Kernel
 {
     /// <summary>Total number of tests announced to the test runner for this suite.</summary>
-    private const int ExpectedTestCount = 53;
+    private const int ExpectedTestCount = 56;
 
     /// <summary>Lock/unlock increment iterations each worker thread performs in the lock and spinlock contention tests.</summary>
     private const int LockIterationsPerThread = 100;
@@ -25,6 +25,12 @@ public class Kernel : Sys.Kernel
     private const int WorkerIterationCount = 5;
     /// <summary>Number of contender threads racing for the mutex in the three-contenders test.</summary>
     private const int ContenderCount = 3;
+    /// <summary>Threads queued in the stride run-queue ordering tests.</summary>
+    private const int RunQueueThreadCount = 64;
+    /// <summary>Every n-th queued thread is removed out of order in the run-queue removal test.</summary>
+    private const int RunQueueRemoveEvery = 3;
+    /// <summary>Threads queued on the busy CPU in the work-stealing test.</summary>
+    private const int BalanceVictimThreadCount = 3;
 
     /// <summary>Initial wait (ms) for a freshly started thread to be scheduled and run.</summary>
     private const int ThreadStartupWaitMs = 1000;
@@ -120,6 +126,9 @@ public class Kernel : Sys.Kernel
         TR.Run("InterruptEvent_TwoWaiters_BothWake", TestInterruptEventTwoWaiters);
         TR.Run("Mutex_ThreeContenders_AllAcquire", TestMutexThreeContenders);
         TR.Run("Mutex_ReleaseHandsOffToParkedWaiter", TestMutexReleaseHandsOff);
+        TR.Run("StrideRunQueue_PopMin_ReturnsPassOrder", TestStrideRunQueuePassOrder);
+        TR.Run("StrideRunQueue_Remove_KeepsPassOrder", TestStrideRunQueueRemove);
+        TR.Run("StrideScheduler_Balance_StealsFromBusierCpu", TestStrideBalanceSteal);
 
         // ThreadPool / Task / async-await tests (validate fix for #245, #246)
         TR.Run("ThreadPool_QueueUserWorkItem_ExecutesCallback", TestThreadPoolQueueUserWorkItem);
@@ -624,6 +633,123 @@ public class Kernel : Sys.Kernel
         _handoffMutex.Release();
     }
 
+    // ===== Stride run queue (pairing heap) =====
+    // Scheduler Threads that never run: only their StrideThreadData is
+    // queued, so the heap can be exercised without touching the live CPU.
+
+    private static Cosmos.Kernel.Core.Scheduler.Stride.StrideThreadData[] CreateRunQueueEntries()
+    {
+        var entries = new Cosmos.Kernel.Core.Scheduler.Stride.StrideThreadData[RunQueueThreadCount];
+        uint seed = 12345;
+        for (int i = 0; i < entries.Length; i++)
+        {
+            // LCG passes with deliberate duplicates (mod 50) and negatives
+            seed = seed * 1103515245 + 12345;
+            entries[i] = new Cosmos.Kernel.Core.Scheduler.Stride.StrideThreadData
+            {
+                Pass = (long)(seed >> 16) % 50 - 10,
+                Owner = new Cosmos.Kernel.Core.Scheduler.Thread { Id = (uint)i }
+            };
+        }
+
+        return entries;
+    }
+
+    private static void TestStrideRunQueuePassOrder()
+    {
+        var queue = new Cosmos.Kernel.Core.Scheduler.Stride.StrideRunQueue();
+        var entries = CreateRunQueueEntries();
+        foreach (var entry in entries)
+        {
+            queue.Insert(entry);
+        }
+
+        // Re-inserting a queued thread re-keys it instead of duplicating it
+        queue.Insert(entries[0]);
+        Assert.Equal(RunQueueThreadCount, queue.Count, "queue should hold every thread once");
+
+        long previous = long.MinValue;
+        int popped = 0;
+        while (queue.PopMin() is Cosmos.Kernel.Core.Scheduler.Thread thread)
+        {
+            long pass = entries[thread.Id].Pass;
+            Assert.True(pass >= previous, "PopMin must return threads in ascending pass order");
+            Assert.True(!queue.Contains(entries[thread.Id]), "popped thread must leave the queue");
+            previous = pass;
+            popped++;
+        }
+
+        Assert.Equal(RunQueueThreadCount, popped, "every queued thread should be popped");
+        Assert.Equal(0, queue.Count, "queue should be empty");
+    }
+
+    private static void TestStrideRunQueueRemove()
+    {
+        var queue = new Cosmos.Kernel.Core.Scheduler.Stride.StrideRunQueue();
+        var entries = CreateRunQueueEntries();
+        foreach (var entry in entries)
+        {
+            queue.Insert(entry);
+        }
+
+        // Pop once so the heap has internal structure, then remove from the middle
+        var first = queue.PopMin();
+        Assert.True(first != null, "queue should not be empty");
+
+        int removed = 0;
+        for (int i = 0; i < entries.Length; i += RunQueueRemoveEvery)
+        {
+            if (queue.Remove(entries[i]))
+            {
+                removed++;
+            }
+        }
+
+        Assert.True(!queue.Remove(entries[0]), "removing an unqueued thread should fail");
+        Assert.Equal(RunQueueThreadCount - 1 - removed, queue.Count, "count should track removals");
+
+        long previous = long.MinValue;
+        while (queue.PopMin() is Cosmos.Kernel.Core.Scheduler.Thread thread)
+        {
+            Assert.True(thread.Id % RunQueueRemoveEvery != 0, "removed threads must not be popped");
+            long pass = entries[thread.Id].Pass;
+            Assert.True(pass >= previous, "removal must keep ascending pass order");
+            previous = pass;
+        }
+    }
+
+    private static void TestStrideBalanceSteal()
+    {
+        // A standalone scheduler over two CPUs, so the live run queues are untouched
+        var scheduler = new Cosmos.Kernel.Core.Scheduler.Stride.StrideScheduler();
+        var idle = new Cosmos.Kernel.Core.Scheduler.PerCpuState { CpuId = 0 };
+        var busy = new Cosmos.Kernel.Core.Scheduler.PerCpuState { CpuId = 1 };
+        var cpus = new[] { idle, busy };
+        scheduler.InitializeCpu(idle);
+        scheduler.InitializeCpu(busy);
+
+        for (uint i = 0; i < BalanceVictimThreadCount; i++)
+        {
+            var thread = new Cosmos.Kernel.Core.Scheduler.Thread { Id = i, CpuId = busy.CpuId };
+            scheduler.OnThreadCreate(busy, thread);
+            scheduler.OnThreadReady(busy, thread);
+        }
+
+        Assert.Equal(BalanceVictimThreadCount, scheduler.GetRunQueueCount(busy), "busy CPU should hold every thread");
+
+        scheduler.Balance(idle, cpus);
+
+        Assert.Equal(1, scheduler.GetRunQueueCount(idle), "idle CPU should steal one thread");
+        Assert.Equal(BalanceVictimThreadCount - 1, scheduler.GetRunQueueCount(busy), "busy CPU should lose the stolen thread");
+        var stolen = scheduler.PickNext(idle);
+        Assert.True(stolen != null, "stolen thread should be runnable on the idle CPU");
+        Assert.Equal(idle.CpuId, stolen!.CpuId, "stolen thread should be re-homed to the idle CPU");
+
+        // A CPU with work of its own does not steal
+        scheduler.Balance(busy, cpus);
+        Assert.Equal(BalanceVictimThreadCount - 1, scheduler.GetRunQueueCount(busy), "busy CPU should not steal");
+    }
+
     private static void TestMultipleThreads()
     {
         Serial.WriteString("[Test] Testing multiple threads...\n");
@@ -25,8 +25,8 @@ public class Kernel : Sys.Kernel
         Serial.WriteString("[Timer Tests] Starting test suite\n");
 
 #if ARCH_X64
-        // x64: Stopwatch (2) + PIT (3) + TimerManager (5) + LAPIC (3) + DateTime (4) + AlarmSystem (3) + BCL Timer (4) = 24
-        TR.Start("Timer Tests", expectedTests: 24);
+        // x64: Stopwatch (2) + PIT (3) + TimerManager (5) + LAPIC (4) + DateTime (4) + AlarmSystem (3) + BCL Timer (4) = 25
+        TR.Start("Timer Tests", expectedTests: 25);
 
         // PIT Tests (using Stopwatch for verification)
         TR.Run("PIT_Initialized", TestPITInitialized);
@@ -37,6 +37,7 @@ public class Kernel : Sys.Kernel
         TR.Run("LAPIC_Initialized", TestLAPICInitialized);
         TR.Run("LAPIC_Wait_100ms", TestLAPICWait100ms);
         TR.Run("LAPIC_Wait_Proportional", TestLAPICWaitProportional);
+        TR.Run("ClockSource_Selected", TestClockSourceSelected);
 
 #else
         // ARM64: No PIT or LAPIC, just basic timer manager tests
@@ -196,9 +197,17 @@ public class Kernel : Sys.Kernel
         Serial.WriteNumber((ulong)freq);
         Serial.WriteString(" Hz\n");
 
-        // TSC frequency should be at least 100 MHz on x64; ARM64 generic timer is typically 62.5 MHz
+        // TSC frequency should be at least 100 MHz on x64 (the HPET, used without an
+        // invariant TSC, can be as slow as 10 MHz); ARM64 generic timer is typically 62.5 MHz
 #if ARCH_X64
-        Assert.True(freq >= 100_000_000, "Stopwatch: Frequency should be >= 100 MHz");
+        if (ClockSource.Timestamp == ClockSourceKind.Hpet)
+        {
+            Assert.True(freq >= 10_000_000, "Stopwatch: HPET frequency should be >= 10 MHz");
+        }
+        else
+        {
+            Assert.True(freq >= 100_000_000, "Stopwatch: Frequency should be >= 100 MHz");
+        }
 #else
         Assert.True(freq >= 1_000_000, "Stopwatch: Frequency should be >= 1 MHz");
 #endif
@@ -534,5 +543,22 @@ public class Kernel : Sys.Kernel
         Assert.True(proportional, "LAPIC: 200ms should take ~2x ticks of 100ms");
     }
 
+    private static void TestClockSourceSelected()
+    {
+        bool hasHpet = Hpet.IsAvailable;
+
+        Serial.WriteString("[Timer Tests] HPET: ");
+        Serial.WriteString(hasHpet ? "present" : "absent");
+        Serial.WriteString(", TSC-deadline tick: ");
+        Serial.WriteString(LocalApic.IsTscDeadlineMode ? "yes" : "no");
+        Serial.WriteString("\n");
+
+        // A working HPET always outranks the PIT as the calibration reference
+        Assert.True(!hasHpet || ClockSource.Reference == ClockSourceKind.Hpet,
+                    "ClockSource: HPET should be the reference when present");
+        Assert.True(Stopwatch.Frequency == ClockSource.TimestampFrequency,
+                    "ClockSource: Stopwatch should run on the timestamp clock");
+    }
+
 #endif
 }